@@ -0,0 +1,60 @@
+"""Compare DFT energies and gradients with and without the ordering of the orbital basis centers."""
+
+import math, os.path
+
+from Definitions        import dataPath
+from pBabel             import ImportSystem
+from pCore              import Clone               , \
+                               logFile             , \
+                               TestScriptExit_Fail
+from pMolecule.QCModel  import DIISSCFConverger    , \
+                               QCModelDFT
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_Molecules      = ( "glycine", "pyridine" )
+_QCModelOptions = ( ( "HF:SV(P)"  , { "fitBasis" : None               , "functional" : "hf"  , "orbitalBasis" : "def2-sv(p)" } ) ,
+                    ( "BLYP:SV(P)", { "fitBasis" : "def2-sv(p)-rifit" , "functional" : "blyp", "orbitalBasis" : "def2-sv(p)" } ) )
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance   = 1.0e-6
+_GradientTolerance = 1.0e-4
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over molecules and models.
+energyDeviation   = 0.0
+gradientDeviation = 0.0
+for label in _Molecules:
+    system = ImportSystem ( os.path.join ( dataPath, "xyz", label + ".xyz" ) )
+    for ( modelLabel, options ) in _QCModelOptions:
+        energies  = []
+        gradients = []
+        for orderBasisCenters in ( False, True ):
+            system.DefineQCModel ( QCModelDFT.WithOptions ( converger         = DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-10, maximumIterations = 250 ) ,
+                                                            orderBasisCenters = orderBasisCenters                                                                     ,
+                                                            **options                                                                                                 ) )
+            system.Summary ( )
+            energies.append  ( system.Energy ( doGradients = True, log = None ) )
+            gradients.append ( Clone ( system.scratch.gradients3 ) )
+        gradients[1].Add ( gradients[0], scale = -1.0 )
+        eDeviation        = math.fabs ( energies[1] - energies[0] )
+        gDeviation        = gradients[1].iterator.AbsoluteMaximum ( )
+        energyDeviation   = max ( energyDeviation  , eDeviation )
+        gradientDeviation = max ( gradientDeviation, gDeviation )
+        logFile.Paragraph ( "{:s} {:s}: energy deviation = {:.3e}, maximum gradient deviation = {:.3e}.".format ( label, modelLabel, eDeviation, gDeviation ) )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation           = {:.3e}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.3e}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
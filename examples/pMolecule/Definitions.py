@@ -1,9 +1,11 @@
 """Some definitions."""
 
-import os, os.path
+import os, os.path, subprocess, sys, tempfile
 
-from pCore import TestScript_InputDataPath  , \
-                  TestScript_OutputDataPath
+from pCore import Pickle                    , \
+                  TestScript_InputDataPath  , \
+                  TestScript_OutputDataPath , \
+                  Unpickle
 
 # . Local name.
 _name = "pMolecule"
@@ -16,3 +18,30 @@ yamlPath       = os.path.join ( dataPath, "yaml" )
 
 # . Other options.
 _FullVerificationSummary = False
+
+# . The environment variable that holds the results path of a single-threaded rerun.
+_SingleThreadResultsVariable = "PDYNAMO3_SINGLE_THREAD_RESULTS"
+
+#===================================================================================================================================
+# . Functions.
+#===================================================================================================================================
+def SingleThreadResults ( scriptPath, results ):
+    """Rerun a script with a single OpenMP thread and return its results.
+
+    In the rerun itself the results are saved for the calling script and None is returned.
+    """
+    path = os.getenv ( _SingleThreadResultsVariable )
+    if path is None:
+        ( fd, path ) = tempfile.mkstemp ( suffix = ".pkl" )
+        os.close ( fd )
+        environment = dict ( os.environ )
+        environment["OMP_NUM_THREADS"            ] = "1"
+        environment[_SingleThreadResultsVariable] = path
+        try:
+            subprocess.run ( [ sys.executable, scriptPath ], check = True, env = environment, stdout = subprocess.DEVNULL )
+            return Unpickle ( path )
+        finally:
+            os.remove ( path )
+    else:
+        Pickle ( path, results )
+        return None
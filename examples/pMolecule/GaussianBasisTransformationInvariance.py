@@ -0,0 +1,82 @@
+"""Check the rotational invariance of HF energies and gradients with spherical basis sets containing high angular momentum shells.
+
+The Cartesian to spherical transformations of the integrals are only rotationally invariant if they are done correctly.
+"""
+
+import math, os.path
+
+from Definitions               import dataPath
+from pBabel                    import ImportSystem
+from pCore                     import Clone                           , \
+                                      logFile                         , \
+                                      TestScriptExit_Fail
+from pMolecule                 import SystemGeometryObjectiveFunction
+from pMolecule.QCModel         import DIISSCFConverger                , \
+                                      QCModelDFT
+from pScientific.Geometry3     import Matrix33
+from pScientific.RandomNumbers import RandomNumberGenerator
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_Molecules      = ( "formaldehyde", "water" )
+# . Only HF is used as the numerical grids of DFT functionals are not rotationally invariant.
+_QCModelOptions = ( ( "HF/def2-tzvp"         , { "fitBasis" : None              , "functional" : "hf", "orbitalBasis" : "def2-tzvp" } ) ,
+                    ( "HF/def2-tzvp (Fitted)", { "fitBasis" : "def2-tzvp-rifit" , "functional" : "hf", "orbitalBasis" : "def2-tzvp" } ) )
+_Seed           = 957131
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance    = 1.0e-4
+_GradientTolerance  = 1.0e-3
+_NumericalTolerance = 1.0e-2
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over molecules and models.
+energyDeviation       = 0.0
+gradientDeviation     = 0.0
+numericalDeviation    = 0.0
+randomNumberGenerator = RandomNumberGenerator.WithSeed ( _Seed )
+for label in _Molecules:
+    system = ImportSystem ( os.path.join ( dataPath, "xyz", label + ".xyz" ) )
+    for ( modelLabel, options ) in _QCModelOptions:
+        system.DefineQCModel ( QCModelDFT.WithOptions ( converger = DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-10, maximumIterations = 250 ), **options ) )
+        system.Summary ( )
+
+        # . Energies and gradients before and after a random rotation.
+        coordinates3 = Clone ( system.coordinates3 )
+        rotation     = Matrix33.MakeRandomRotation ( randomNumberGenerator )
+        energies     = [ system.Energy ( doGradients = True, log = None ) ]
+        gradients    = [ Clone ( system.scratch.gradients3 ) ]
+        gradients[0].Rotate ( rotation )
+        system.coordinates3.Rotate ( rotation )
+        energies.append  ( system.Energy ( doGradients = True, log = None ) )
+        gradients.append ( Clone ( system.scratch.gradients3 ) )
+        gradients[1].Add ( gradients[0], scale = -1.0 )
+        eDeviation        = math.fabs ( energies[1] - energies[0] )
+        gDeviation        = gradients[1].iterator.AbsoluteMaximum ( )
+        energyDeviation   = max ( energyDeviation  , eDeviation )
+        gradientDeviation = max ( gradientDeviation, gDeviation )
+
+        # . Numerical gradients.
+        of                  = SystemGeometryObjectiveFunction.FromSystem ( system )
+        nDeviation          = of.TestGradients ( )
+        numericalDeviation  = max ( numericalDeviation, nDeviation )
+        system.coordinates3 = coordinates3
+        logFile.Paragraph ( "{:s} {:s}: rotated energy deviation = {:.3e}, rotated gradient deviation = {:.3e}, numerical gradient deviation = {:.3e}.".format ( label, modelLabel, eDeviation, gDeviation, nDeviation ) )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation            = {:.5f}".format ( energyDeviation    ) )
+logFile.Paragraph ( "Maximum gradient deviation  = {:.5f}".format ( gradientDeviation  ) )
+logFile.Paragraph ( "Maximum numerical deviation = {:.5f}".format ( numericalDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation    > _EnergyTolerance    ) or \
+   ( gradientDeviation  > _GradientTolerance  ) or \
+   ( numericalDeviation > _NumericalTolerance ): TestScriptExit_Fail ( )
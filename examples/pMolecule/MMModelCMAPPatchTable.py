@@ -0,0 +1,86 @@
+"""Compare CMAP dihedral energies and gradients from the patch table with those from spline evaluation.
+
+The patch table is only made when all the parameters of a container have uniform periodic grids. A copy of each container
+with an extra unused parameter on a nonuniform grid is therefore evaluated with the splines directly.
+"""
+
+import math, os.path
+
+from Definitions           import dataPath
+from pBabel                import ImportSystem
+from pCore                 import logFile                , \
+                                  Selection              , \
+                                  TestScriptExit_Fail
+from pMolecule             import SystemGeometryObjectiveFunction
+from pMolecule.MMModel     import CMAPDihedralContainer  , \
+                                  MMModelCHARMM
+from pScientific.Geometry3 import Coordinates3
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_NonUniformGrid     = [ -180.0, -90.0, 30.0, 180.0 ]
+_NumberOfFreeTerms  = 3
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance    = 1.0e-6
+_GradientTolerance  = 1.0e-6
+_NumericalTolerance = 1.0e-2
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Set up the system without an NB model so that only the bonded terms contribute.
+system = ImportSystem ( os.path.join ( dataPath, "pdb", "2E4E_folded_solvated.pdb" ), useComponentLibrary = True )
+system.DefineMMModel ( MMModelCHARMM.WithParameterSet ( "c36a2" ) )
+system.Summary ( )
+
+# . Loop over the CMAP containers.
+energyDeviation   = 0.0
+freeAtoms         = set ( )
+gradientDeviation = 0.0
+for container in system.mmState.mmTerms:
+    if isinstance ( container, CMAPDihedralContainer ):
+        # . Make the copy without a patch table.
+        state = container.__getstate__ ( )
+        state["parameters"].append ( [ _NonUniformGrid, _NonUniformGrid, [ 0.0 for i in range ( len ( _NonUniformGrid )**2 ) ] ] )
+        splineContainer = CMAPDihedralContainer.Raw ( )
+        splineContainer.__setstate__ ( state )
+        # . Energies and gradients.
+        energies  = []
+        gradients = []
+        for term in ( splineContainer, container ):
+            g = Coordinates3.WithExtent ( len ( system.atoms ) )
+            g.Set ( 0.0 )
+            energies.append  ( term.Energy ( system.coordinates3, g ) )
+            gradients.append ( g )
+        gradients[1].Add ( gradients[0], scale = -1.0 )
+        eDeviation        = math.fabs ( energies[1] - energies[0] )
+        gDeviation        = gradients[1].iterator.AbsoluteMaximum ( )
+        energyDeviation   = max ( energyDeviation  , eDeviation )
+        gradientDeviation = max ( gradientDeviation, gDeviation )
+        logFile.Paragraph ( "{:s}: energy = {:.6f}, energy deviation = {:.3e}, maximum gradient deviation = {:.3e}.".format ( container.label, energies[1], eDeviation, gDeviation ) )
+        # . Free atoms for the numerical gradients.
+        for term in state["terms"][0:_NumberOfFreeTerms]: freeAtoms.update ( term[0:8] )
+
+# . Numerical gradients of the atoms in the first few CMAP terms.
+system.freeAtoms   = Selection.FromIterable ( sorted ( freeAtoms ) )
+of                 = SystemGeometryObjectiveFunction.FromSystem ( system )
+numericalDeviation = of.TestGradients ( )
+system.freeAtoms   = None
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation            = {:.3e}".format ( energyDeviation    ) )
+logFile.Paragraph ( "Maximum gradient deviation  = {:.3e}".format ( gradientDeviation  ) )
+logFile.Paragraph ( "Maximum numerical deviation = {:.3e}".format ( numericalDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( len ( freeAtoms ) == 0                     ) or \
+   ( energyDeviation    > _EnergyTolerance    ) or \
+   ( gradientDeviation  > _GradientTolerance  ) or \
+   ( numericalDeviation > _NumericalTolerance ): TestScriptExit_Fail ( )
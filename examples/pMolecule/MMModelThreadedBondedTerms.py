@@ -0,0 +1,58 @@
+"""Compare threaded MM bonded energies and gradients with those from a single thread.
+
+A solvated protein is used so that the larger bonded term containers are evaluated with multiple threads.
+"""
+
+import math, os.path
+
+from Definitions        import dataPath            , \
+                               SingleThreadResults
+from pBabel             import ImportSystem
+from pCore              import Clone               , \
+                               logFile             , \
+                               TestScriptExit_Fail
+from pMolecule.MMModel  import MMModelCHARMM
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance   = 1.0e-6
+_GradientTolerance = 1.0e-6
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Set up the system without an NB model so that only the bonded terms contribute.
+system = ImportSystem ( os.path.join ( dataPath, "pdb", "2E4E_folded_solvated.pdb" ), useComponentLibrary = True )
+system.DefineMMModel ( MMModelCHARMM.WithParameterSet ( "c36a2" ) )
+system.Summary ( )
+
+# . Energies and gradients.
+system.Energy ( doGradients = True )
+results = { "Energies" : dict ( system.scratch.energyTerms ), "Gradients" : Clone ( system.scratch.gradients3 ) }
+
+# . Compare with the results from a single thread.
+energyDeviation   = 0.0
+gradientDeviation = 0.0
+reference         = SingleThreadResults ( __file__, results )
+if reference is not None:
+    for ( key, value ) in sorted ( results["Energies"].items ( ) ):
+        deviation       = math.fabs ( value - reference["Energies"][key] )
+        energyDeviation = max ( energyDeviation, deviation )
+        logFile.Paragraph ( "{:s}: energy deviation = {:.3e}.".format ( key, deviation ) )
+    gradients = results["Gradients"]
+    gradients.Add ( reference["Gradients"], scale = -1.0 )
+    gradientDeviation = gradients.iterator.AbsoluteMaximum ( )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation           = {:.3e}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.3e}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
@@ -0,0 +1,91 @@
+"""Compare MNDO CI energies and gradients from block sparse diagonalizations with those from dense diagonalization."""
+
+import math, os.path
+
+from Definitions        import dataPath            , \
+                               SingleThreadResults
+from pBabel             import ImportSystem
+from pCore              import Clone               , \
+                               logFile             , \
+                               TestScriptExit_Fail
+from pMolecule.QCModel  import CIDiagonalization   , \
+                               CIMethod            , \
+                               DIISSCFConverger    , \
+                               ElectronicState     , \
+                               OccupancyType       , \
+                               QCModelMNDOCI
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_BlockSizes          = ( 1, 4 )
+_Diagonalizations    = ( CIDiagonalization.Direct, CIDiagonalization.Sparse )
+_ElectronicStateKeys = ( "charge", "numberFractionalHOOs", "numberFractionalLUOs", "occupancyType" )
+_QCModelKeys         = ( "ciMethod", "activeElectrons", "activeOrbitals", "multiplicity", "minimalMultiplicity" )
+_MoleculeData        = ( ( "allyl"    , "radicals", ( 0, 1, 0, OccupancyType.FractionalFixed ), ( CIMethod.Full           , 7, 7, 2, 2 ) ) ,
+                         ( "methylene", "radicals", ( 0, 1, 1, OccupancyType.FractionalFixed ), ( CIMethod.Full           , 6, 6, 3, 1 ) ) )
+_NumberOfStates      = 4
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance   = 1.0e-4
+_GradientTolerance = 1.0e-3
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over systems.
+energyDeviation   = 0.0
+gradientDeviation = 0.0
+results           = {}
+for ( label, directory, esValues, qcValues ) in _MoleculeData:
+
+    # . Set up the system.
+    system                 = ImportSystem ( os.path.join ( dataPath, directory, label + ".xyz" ) )
+    system.label           = label
+    system.electronicState = ElectronicState.WithOptions ( **dict ( zip ( _ElectronicStateKeys, esValues ) ) )
+    qcOptions              = dict ( zip ( _QCModelKeys, qcValues ) )
+    qcOptions.update ( { "converger"      : DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-12, maximumIterations = 250 ) ,
+                         "hamiltonian"    : "am1"                                                                                 ,
+                         "numberOfStates" : _NumberOfStates                                                                       } )
+
+    # . The dense reference.
+    system.DefineQCModel ( QCModelMNDOCI.WithOptions ( ciDiagonalization = CIDiagonalization.Dense, **qcOptions ) )
+    system.Summary ( )
+    energy0    = system.Energy ( doGradients = True, log = None )
+    gradients0 = Clone ( system.scratch.gradients3 )
+
+    # . The sparse diagonalizations.
+    for ciDiagonalization in _Diagonalizations:
+        for ciBlockSize in _BlockSizes:
+            system.DefineQCModel ( QCModelMNDOCI.WithOptions ( ciBlockSize = ciBlockSize, ciDiagonalization = ciDiagonalization, **qcOptions ) )
+            energy    = system.Energy ( doGradients = True, log = None )
+            gradients = Clone ( system.scratch.gradients3 )
+            results[( label, ciDiagonalization.name, ciBlockSize )] = ( energy, Clone ( gradients ) )
+            gradients.Add ( gradients0, scale = -1.0 )
+            eDeviation        = math.fabs ( energy - energy0 )
+            gDeviation        = gradients.iterator.AbsoluteMaximum ( )
+            energyDeviation   = max ( energyDeviation  , eDeviation )
+            gradientDeviation = max ( gradientDeviation, gDeviation )
+            logFile.Paragraph ( "{:s} {:s} with block size {:d}: energy deviation = {:.3e}, maximum gradient deviation = {:.3e}.".format ( label, ciDiagonalization.name, ciBlockSize, eDeviation, gDeviation ) )
+
+# . Compare with the results from a single thread.
+reference = SingleThreadResults ( __file__, results )
+if reference is not None:
+    for ( key, ( energy, gradients ) ) in sorted ( results.items ( ) ):
+        ( energy0, gradients0 ) = reference[key]
+        gradients.Add ( gradients0, scale = -1.0 )
+        energyDeviation   = max ( energyDeviation  , math.fabs ( energy - energy0 ) )
+        gradientDeviation = max ( gradientDeviation, gradients.iterator.AbsoluteMaximum ( ) )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation           = {:.5f}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.5f}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
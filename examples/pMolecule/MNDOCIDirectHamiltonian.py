@@ -0,0 +1,81 @@
+"""Compare MNDO CI state energies from the direct CI Hamiltonian with those from explicit CI matrices."""
+
+import math, os.path
+
+from Definitions        import dataPath            , \
+                               _FullVerificationSummary
+from pBabel             import ImportSystem
+from pCore              import logFile             , \
+                               TestDataSet         , \
+                               TestReal            , \
+                               TestScriptExit_Fail
+from pMolecule.QCModel  import CIDiagonalization   , \
+                               CIMethod            , \
+                               DIISSCFConverger    , \
+                               ElectronicState     , \
+                               OccupancyType       , \
+                               QCModelMNDOCI
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Molecule data (label, directory, electronic state and CI options).
+_ElectronicStateKeys = ( "charge", "numberFractionalHOOs", "numberFractionalLUOs", "occupancyType" )
+_QCModelKeys         = ( "ciMethod", "activeElectrons", "activeOrbitals", "multiplicity", "minimalMultiplicity" )
+_MoleculeData        = ( ( "allyl"    , "radicals", ( 0, 1, 0, OccupancyType.FractionalFixed ), ( CIMethod.Full           , 7, 7, 2, 2 ) ) ,
+                         ( "methylene", "radicals", ( 0, 1, 1, OccupancyType.FractionalFixed ), ( CIMethod.Full           , 6, 6, 3, 1 ) ) ,
+                         ( "water"    , "xyz"     , ( 0, 0, 0, OccupancyType.Cardinal        ), ( CIMethod.SinglesDoubles , 8, 6, 1, 1 ) ) )
+
+# . Options.
+_NumberOfStates = 6
+
+# . Tolerances (kJ mol^-1).
+_EnergyTolerance = 1.0e-4
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over systems.
+observed      = {}
+referenceData = TestDataSet.WithOptions ( label = "Direct CI Hamiltonian" )
+for ( label, directory, esValues, qcValues ) in _MoleculeData:
+
+    # . Set up the system.
+    system                 = ImportSystem ( os.path.join ( dataPath, directory, label + ".xyz" ) )
+    system.label           = label
+    system.electronicState = ElectronicState.WithOptions ( **dict ( zip ( _ElectronicStateKeys, esValues ) ) )
+    qcOptions              = dict ( zip ( _QCModelKeys, qcValues ) )
+    qcOptions.update ( { "converger"      : DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-12, maximumIterations = 250 ) ,
+                         "hamiltonian"    : "am1"                                                                                 ,
+                         "numberOfStates" : _NumberOfStates                                                                       } )
+
+    # . State energies with the direct Hamiltonian and with the dense and sparse CI matrices.
+    energies = {}
+    for ciDiagonalization in ( CIDiagonalization.Direct, CIDiagonalization.Dense, CIDiagonalization.Sparse ):
+        system.DefineQCModel ( QCModelMNDOCI.WithOptions ( ciDiagonalization = ciDiagonalization, **qcOptions ) )
+        if ciDiagonalization == CIDiagonalization.Direct: system.Summary ( )
+        system.Energy ( )
+        energies[ciDiagonalization] = [ system.scratch.ci.ciEnergies[i] for i in range ( _NumberOfStates ) ]
+
+    # . Deviations.
+    direct = energies[CIDiagonalization.Direct]
+    for ciDiagonalization in ( CIDiagonalization.Dense, CIDiagonalization.Sparse ):
+        tag = "{:s} {:s} Error".format ( label, ciDiagonalization.name )
+        observed[tag] = max ( [ math.fabs ( a - b ) for ( a, b ) in zip ( direct, energies[ciDiagonalization] ) ] )
+        referenceData.AddDatum ( TestReal.WithOptions ( absoluteErrorTolerance = _EnergyTolerance ,
+                                                        label                  = tag              ,
+                                                        parent                 = referenceData    ,
+                                                        toleranceFormat        = "{:.3g}"         ,
+                                                        value                  = 0.0              ,
+                                                        valueFormat            = "{:.6g}"         ) )
+    logFile.Paragraph ( "{:s} direct CI state energies (kJ/mol): {:s}.".format ( label, ", ".join ( [ "{:.6f}".format ( e ) for e in direct ] ) ) )
+
+# . Footer.
+results = referenceData.VerifyAgainst ( observed )
+results.Summary ( fullSummary = _FullVerificationSummary )
+isOK = results.WasSuccessful ( )
+logFile.Footer ( )
+if not isOK: TestScriptExit_Fail ( )
@@ -0,0 +1,111 @@
+"""Check the MNDO CI four-index transformation against a straightforward transformation and a single-threaded run."""
+
+import math, os.path
+
+from Definitions        import dataPath            , \
+                               SingleThreadResults
+from pBabel             import ImportSystem
+from pCore              import Clone               , \
+                               logFile             , \
+                               TestScriptExit_Fail
+from pMolecule.QCModel  import CIMethod            , \
+                               DIISSCFConverger    , \
+                               ElectronicState     , \
+                               OccupancyType       , \
+                               QCModelMNDOCI
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Molecule data (label, directory, electronic state and CI options).
+_ElectronicStateKeys = ( "charge", "numberFractionalHOOs", "numberFractionalLUOs", "occupancyType" )
+_QCModelKeys         = ( "ciMethod", "activeElectrons", "activeOrbitals", "multiplicity", "minimalMultiplicity" )
+_MoleculeData        = ( ( "formaldehyde", "xyz"     , ( 0, 0, 0, OccupancyType.Cardinal        ), ( CIMethod.Full           , 6, 6, 1, 1 ) ) ,
+                         ( "methylene"   , "radicals", ( 0, 1, 1, OccupancyType.FractionalFixed ), ( CIMethod.Full           , 6, 6, 3, 1 ) ) ,
+                         ( "water"       , "xyz"     , ( 0, 0, 0, OccupancyType.Cardinal        ), ( CIMethod.SinglesDoubles , 8, 6, 1, 1 ) ) )
+
+# . Tolerances (atomic units for the integrals, kJ mol^-1 and kJ mol^-1 A^-1 otherwise).
+_EnergyTolerance   = 1.0e-5
+_GradientTolerance = 1.0e-5
+_IntegralTolerance = 1.0e-10
+
+#===================================================================================================================================
+# . Functions.
+#===================================================================================================================================
+def ReferenceTransformation ( activeMOs, twoElectronIntegrals ):
+    """Transform the AO two-electron integrals one index at a time with dense arrays."""
+    ( nBasis, nActive ) = activeMOs.shape
+    # . The full AO integrals.
+    canonical = {}
+    for ( i, j, k, l, value ) in twoElectronIntegrals.__getstate__ ( )["Records"]:
+        canonical[( i, j, k, l )] = canonical.get ( ( i, j, k, l ), 0.0 ) + value
+    integrals = [ [ [ [ 0.0 for l in range ( nBasis ) ] for k in range ( nBasis ) ] for j in range ( nBasis ) ] for i in range ( nBasis ) ]
+    for ( ( i, j, k, l ), value ) in canonical.items ( ):
+        for ( a, b ) in ( ( i, j ), ( j, i ) ):
+            for ( c, d ) in ( ( k, l ), ( l, k ) ):
+                integrals[a][b][c][d] = value
+                integrals[c][d][a][b] = value
+    # . Transform each index in turn, moving the transformed index to the end.
+    c = [ [ activeMOs[i,r] for r in range ( nActive ) ] for i in range ( nBasis ) ]
+    def TransformFirst ( source, n1, n2, n3 ):
+        return [ [ [ [ sum ( c[i][r] * source[i][j][k][l] for i in range ( nBasis ) ) for r in range ( nActive ) ] for l in range ( n3 ) ] for k in range ( n2 ) ] for j in range ( n1 ) ]
+    integrals = TransformFirst ( integrals, nBasis , nBasis , nBasis  )
+    integrals = TransformFirst ( integrals, nBasis , nBasis , nActive )
+    integrals = TransformFirst ( integrals, nBasis , nActive, nActive )
+    integrals = TransformFirst ( integrals, nActive, nActive, nActive )
+    return integrals
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over systems.
+integralDeviation = 0.0
+results           = {}
+for ( label, directory, esValues, qcValues ) in _MoleculeData:
+
+    # . Set up the system.
+    system                 = ImportSystem ( os.path.join ( dataPath, directory, label + ".xyz" ) )
+    system.label           = label
+    system.electronicState = ElectronicState.WithOptions ( **dict ( zip ( _ElectronicStateKeys, esValues ) ) )
+    qcOptions              = dict ( zip ( _QCModelKeys, qcValues ) )
+    qcOptions.update ( { "converger"   : DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-12, maximumIterations = 250 ) ,
+                         "hamiltonian" : "am1"                                                                                 } )
+    system.DefineQCModel ( QCModelMNDOCI.WithOptions ( **qcOptions ) )
+    system.Summary ( )
+    energy = system.Energy ( doGradients = True, log = None )
+    results[label] = ( energy, Clone ( system.scratch.gradients3 ) )
+
+    # . Compare the transformed integrals.
+    node      = system.scratch.ci
+    moTEIs    = node.moTwoElectronIntegrals
+    reference = ReferenceTransformation ( node.activeMOs, system.scratch.twoElectronIntegrals )
+    nActive   = len ( reference )
+    deviation = max ( [ math.fabs ( moTEIs[r,s,t,u] - reference[r][s][t][u] ) for r in range ( nActive ) for s in range ( r+1 )
+                                                                               for t in range ( r+1 ) for u in range ( t+1 ) ] )
+    integralDeviation = max ( integralDeviation, deviation )
+    logFile.Paragraph ( "{:s}: maximum MO integral deviation = {:.3e}.".format ( label, deviation ) )
+
+# . Compare with the results from a single thread.
+energyDeviation   = 0.0
+gradientDeviation = 0.0
+reference         = SingleThreadResults ( __file__, results )
+if reference is not None:
+    for ( key, ( energy, gradients ) ) in sorted ( results.items ( ) ):
+        ( energy0, gradients0 ) = reference[key]
+        gradients.Add ( gradients0, scale = -1.0 )
+        energyDeviation   = max ( energyDeviation  , math.fabs ( energy - energy0 ) )
+        gradientDeviation = max ( gradientDeviation, gradients.iterator.AbsoluteMaximum ( ) )
+
+# . Summary of results.
+logFile.Paragraph ( "Maximum integral deviation = {:.3e}".format ( integralDeviation ) )
+logFile.Paragraph ( "Energy deviation           = {:.5f}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.5f}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( integralDeviation > _IntegralTolerance ) or \
+   ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
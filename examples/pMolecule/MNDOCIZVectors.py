@@ -0,0 +1,68 @@
+"""Compare CPHF Z-vectors for several MNDO CI states solved together and one at a time."""
+
+import os.path
+
+from Definitions        import dataPath
+from pBabel             import ImportSystem
+from pCore              import logFile             , \
+                               TestScriptExit_Fail
+from pMolecule.QCModel  import CIMethod            , \
+                               DIISSCFConverger    , \
+                               ElectronicState     , \
+                               OccupancyType       , \
+                               QCModelMNDOCI
+from pScientific.Arrays import Array
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Molecule data (label, directory, electronic state and CI options).
+_ElectronicStateKeys = ( "charge", "numberFractionalHOOs", "numberFractionalLUOs", "occupancyType" )
+_QCModelKeys         = ( "ciMethod", "activeElectrons", "activeOrbitals", "multiplicity", "minimalMultiplicity", "numberOfStates" )
+_MoleculeData        = ( ( "methylene", "radicals", ( 0, 1, 1, OccupancyType.FractionalFixed ), ( CIMethod.Full           , 6, 6, 3, 1, 5 ) ) ,
+                         ( "water"    , "xyz"     , ( 0, 0, 0, OccupancyType.Cardinal        ), ( CIMethod.SinglesDoubles , 8, 6, 1, 1, 5 ) ) )
+
+# . Tolerances.
+_ZVectorTolerance = 1.0e-6
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over systems.
+maximumDeviation = 0.0
+for ( label, directory, esValues, qcValues ) in _MoleculeData:
+
+    # . Set up the system.
+    system                 = ImportSystem ( os.path.join ( dataPath, directory, label + ".xyz" ) )
+    system.label           = label
+    system.electronicState = ElectronicState.WithOptions ( **dict ( zip ( _ElectronicStateKeys, esValues ) ) )
+    qcOptions              = dict ( zip ( _QCModelKeys, qcValues ) )
+    qcOptions.update ( { "converger"   : DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-12, maximumIterations = 250 ) ,
+                         "hamiltonian" : "am1"                                                                                 } )
+    system.DefineQCModel ( QCModelMNDOCI.WithOptions ( **qcOptions ) )
+    system.Summary ( )
+    system.Energy  ( doGradients = True )
+
+    # . Z-vectors for all states together and then one at a time.
+    roots                 = range ( qcOptions["numberOfStates"] )
+    ( zBlock, report )    = system.qcModel.CPHFZVectors ( system, roots )
+    blockProducts         = report["Matrix Products"]
+    sequentialProducts    = 0
+    zSequential           = Array.WithExtents ( *zBlock.shape )
+    for ( i, root ) in enumerate ( roots ):
+        ( z, report ) = system.qcModel.CPHFZVectors ( system, [ root ] )
+        z[0,:].CopyTo ( zSequential[i,:] )
+        sequentialProducts += report["Matrix Products"]
+
+    # . Check deviations.
+    zSequential.Add ( zBlock, scale = -1.0 )
+    deviation        = zSequential.iterator.AbsoluteMaximum ( )
+    maximumDeviation = max ( maximumDeviation, deviation )
+    logFile.Paragraph ( "{:s}: maximum Z-vector deviation = {:.3e} with {:d} block and {:d} sequential matrix products.".format ( label, deviation, blockProducts, sequentialProducts ) )
+
+# . Footer.
+logFile.Footer ( )
+if maximumDeviation > _ZVectorTolerance: TestScriptExit_Fail ( )
@@ -0,0 +1,59 @@
+"""Compare MNDO energies and gradients with tabulated and analytic local-frame two-center integrals."""
+
+import math, os.path
+
+from Definitions       import dataPath
+from pBabel            import ImportSystem
+from pCore             import Clone               , \
+                              logFile             , \
+                              TestScriptExit_Fail
+from pMolecule.QCModel import DIISSCFConverger    , \
+                              QCModelMNDO
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_Hamiltonians = ( "am1", "mndo" )
+_Molecules    = ( "formaldehyde", "glycine", "hydrogenFluoride" )
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance   = 1.0e-2
+_GradientTolerance = 1.0e-2
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over molecules and Hamiltonians.
+energyDeviation   = 0.0
+gradientDeviation = 0.0
+for label in _Molecules:
+    system = ImportSystem ( os.path.join ( dataPath, "xyz", label + ".xyz" ) )
+    for hamiltonian in _Hamiltonians:
+        energies  = []
+        gradients = []
+        for useIntegralTable in ( False, True ):
+            qcModel = QCModelMNDO.WithOptions ( converger        = DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-10, maximumIterations = 250 ) ,
+                                                hamiltonian      = hamiltonian                                                                          ,
+                                                useIntegralTable = useIntegralTable                                                                     )
+            system.DefineQCModel ( qcModel )
+            energies.append  ( system.Energy ( doGradients = True, log = None ) )
+            gradients.append ( Clone ( system.scratch.gradients3 ) )
+        gradients[1].Add ( gradients[0], scale = -1.0 )
+        eDeviation        = math.fabs ( energies[1] - energies[0] )
+        gDeviation        = gradients[1].iterator.AbsoluteMaximum ( )
+        energyDeviation   = max ( energyDeviation  , eDeviation )
+        gradientDeviation = max ( gradientDeviation, gDeviation )
+        logFile.Paragraph ( "{:s}/{:s}: energy deviation = {:.3e}, maximum gradient deviation = {:.3e}.".format ( label, hamiltonian.upper ( ), eDeviation, gDeviation ) )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation           = {:.5f}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.5f}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
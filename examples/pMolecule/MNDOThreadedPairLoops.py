@@ -0,0 +1,62 @@
+"""Compare MNDO energies and gradients from the threaded atom-pair loops with those from a single thread."""
+
+import math, os.path
+
+from Definitions       import dataPath            , \
+                              SingleThreadResults
+from pBabel            import ImportSystem
+from pCore             import Clone               , \
+                              logFile             , \
+                              TestScriptExit_Fail
+from pMolecule.QCModel import DIISSCFConverger    , \
+                              QCModelMNDO
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_Hamiltonians = ( "am1", "mndo", "pm6" )
+_Molecules    = ( "glycine", "tyrosineDipeptide" )
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance   = 1.0e-5
+_GradientTolerance = 1.0e-5
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Energies and gradients.
+results = {}
+for label in _Molecules:
+    system = ImportSystem ( os.path.join ( dataPath, "xyz", label + ".xyz" ) )
+    for hamiltonian in _Hamiltonians:
+        system.DefineQCModel ( QCModelMNDO.WithOptions ( converger   = DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-10, maximumIterations = 250 ) ,
+                                                         hamiltonian = hamiltonian                                                                          ) )
+        energy = system.Energy ( doGradients = True, log = None )
+        results[( label, hamiltonian )] = ( energy, Clone ( system.scratch.gradients3 ) )
+
+# . Compare with the results from a single thread.
+reference = SingleThreadResults ( __file__, results )
+if reference is not None:
+    energyDeviation   = 0.0
+    gradientDeviation = 0.0
+    for ( key, ( energy, gradients ) ) in sorted ( results.items ( ) ):
+        ( energy0, gradients0 ) = reference[key]
+        gradients.Add ( gradients0, scale = -1.0 )
+        eDeviation        = math.fabs ( energy - energy0 )
+        gDeviation        = gradients.iterator.AbsoluteMaximum ( )
+        energyDeviation   = max ( energyDeviation  , eDeviation )
+        gradientDeviation = max ( gradientDeviation, gDeviation )
+        logFile.Paragraph ( "{:s}/{:s}: energy deviation = {:.3e}, maximum gradient deviation = {:.3e}.".format ( key[0], key[1].upper ( ), eDeviation, gDeviation ) )
+    logFile.Paragraph ( "Energy deviation           = {:.5f}".format ( energyDeviation   ) )
+    logFile.Paragraph ( "Maximum gradient deviation = {:.5f}".format ( gradientDeviation ) )
+    isOK = ( energyDeviation <= _EnergyTolerance ) and ( gradientDeviation <= _GradientTolerance )
+else:
+    isOK = True
+
+# . Footer.
+logFile.Footer ( )
+if not isOK: TestScriptExit_Fail ( )
@@ -0,0 +1,70 @@
+"""Compare MM/MM energies and gradients with and without atom ordering for the cutoff NB model."""
+
+import math, os, os.path
+
+from Definitions               import dataPath
+from pBabel                    import ImportSystem
+from pCore                     import Clone                           , \
+                                      logFile                         , \
+                                      TestScriptExit_Fail
+from pMolecule.MMModel         import MMModelOPLS
+from pMolecule.NBModel         import NBModelCutOff                   , \
+                                      PairwiseInteractionABFS         , \
+                                      PairwiseInteractionSplineABFS
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_InteractionOptions = { "dampingCutOff" :  0.5 ,
+                        "innerCutOff"   :  8.0 ,
+                        "outerCutOff"   : 12.0 }
+
+# . The atom ordering is only used for spline interactions or when the cluster pairlist is off.
+_ModelOptions = ( ( "ABFS"  , PairwiseInteractionABFS       , False ) ,
+                  ( "Spline", PairwiseInteractionSplineABFS , True  ) )
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance   = 1.0e-4
+_GradientTolerance = 1.0e-4
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Set up the system.
+system = ImportSystem ( os.path.join ( dataPath, "mol2", "waterBox.mol2" ) )
+system.DefineMMModel ( MMModelOPLS.WithParameterSet ( "bookSmallExamples" ) )
+system.Summary ( )
+
+# . Energies and gradients with and without atom ordering.
+energyDeviation   = 0.0
+gradientDeviation = 0.0
+for ( label, interactionClass, useClusterPairList ) in _ModelOptions:
+    energies  = []
+    gradients = []
+    for useAtomOrdering in ( False, True ):
+        nbModel = NBModelCutOff.WithOptions ( pairwiseInteraction = interactionClass.WithOptions ( **_InteractionOptions ) ,
+                                              useAtomOrdering     = useAtomOrdering                                        ,
+                                              useClusterPairList  = useClusterPairList                                     )
+        system.DefineNBModel ( nbModel )
+        system.nbModel.Summary ( )
+        energies.append  ( system.Energy ( doGradients = True, log = None ) )
+        gradients.append ( Clone ( system.scratch.gradients3 ) )
+    gradients[1].Add ( gradients[0], scale = -1.0 )
+    eDeviation        = math.fabs ( energies[1] - energies[0] )
+    gDeviation        = gradients[1].iterator.AbsoluteMaximum ( )
+    energyDeviation   = max ( energyDeviation  , eDeviation )
+    gradientDeviation = max ( gradientDeviation, gDeviation )
+    logFile.Paragraph ( "{:s}: energy deviation = {:.3e}, maximum gradient deviation = {:.3e}.".format ( label, eDeviation, gDeviation ) )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation           = {:.5f}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.5f}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
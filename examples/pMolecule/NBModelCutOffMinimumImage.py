@@ -0,0 +1,77 @@
+"""Compare minimum image and image MM/MM interactions for the cutoff NB model."""
+
+import math, os, os.path
+
+from Definitions               import dataPath
+from pBabel                    import ImportSystem
+from pCore                     import Clone                           , \
+                                      logFile                         , \
+                                      TestScriptExit_Fail
+from pMolecule.MMModel         import MMModelOPLS
+from pMolecule.NBModel         import NBModelCutOff
+from pScientific.RandomNumbers import NormalDeviateGenerator          , \
+                                      RandomNumberGenerator
+from pSimulation               import LangevinDynamics_SystemGeometry
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_NLog              =  100
+_NSteps            = 1000
+_EnergyTolerance   = 0.001
+_GradientTolerance = 0.001
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Paths.
+dataPath = os.path.join ( dataPath, "mol2" )
+
+# . Set up the system.
+system = ImportSystem ( os.path.join ( dataPath, "waterBox.mol2" ) )
+system.DefineMMModel ( MMModelOPLS.WithParameterSet ( "bookSmallExamples" ) )
+system.DefineNBModel ( NBModelCutOff.WithDefaults ( ) )
+system.Summary ( )
+system.Energy  ( )
+
+# . Do a short dynamics so that atoms leave the box.
+normalDeviateGenerator = NormalDeviateGenerator.WithRandomNumberGenerator ( RandomNumberGenerator.WithSeed ( 614108 ) )
+LangevinDynamics_SystemGeometry ( system                                          ,
+                                  collisionFrequency     =                   25.0 ,
+                                  logFrequency           =                  _NLog ,
+                                  normalDeviateGenerator = normalDeviateGenerator ,
+                                  steps                  =                _NSteps ,
+                                  temperature            =                  300.0 ,
+                                  timeStep               =                  0.001 )
+coordinates3 = Clone ( system.coordinates3 )
+
+# . Energies and gradients with and without the minimum image evaluation.
+energies  = []
+gradients = []
+for useMinimumImage in ( False, True ):
+    nbModel = NBModelCutOff.WithDefaults ( )
+    nbModel.useMinimumImage = useMinimumImage
+    system.DefineNBModel ( nbModel )
+    system.nbModel.Summary ( )
+    system.coordinates3 = Clone ( coordinates3 )
+    energies.append  ( system.Energy ( doGradients = True, log = None ) )
+    gradients.append ( Clone ( system.scratch.gradients3 ) )
+    system.nbModel.StatisticsSummary ( system )
+
+# . Check deviations.
+gradients[1].Add ( gradients[0], scale = -1.0 )
+energyDeviation   = math.fabs ( energies[1] - energies[0] )
+gradientDeviation = gradients[1].iterator.AbsoluteMaximum ( )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation           = {:.5f}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.5f}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
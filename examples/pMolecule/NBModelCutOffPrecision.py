@@ -0,0 +1,102 @@
+"""Compare single and double precision MM/MM interactions for the cutoff NB model."""
+
+import math, os, os.path
+
+from Definitions               import dataPath                        , \
+                                      outPath
+from pBabel                    import ImportSystem
+from pCore                     import Clone                           , \
+                                      logFile                         , \
+                                      TestScriptExit_Fail
+from pMolecule                 import SystemGeometryObjectiveFunction
+from pMolecule.MMModel         import MMModelOPLS
+from pMolecule.NBModel         import NBModelCutOff
+from pScientific.RandomNumbers import NormalDeviateGenerator          , \
+                                      RandomNumberGenerator
+from pSimulation               import LangevinDynamics_SystemGeometry , \
+                                      VelocityVerletDynamics_SystemGeometry
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_NLog              =  100
+_NSteps            = 1000
+_DriftTolerance    = 1.0
+_EnergyTolerance   = 0.1
+_GradientTolerance = 0.05
+
+#===================================================================================================================================
+# . Functions.
+#===================================================================================================================================
+def TotalEnergy ( system ):
+    """Return the total energy of the system given its current coordinates and velocities."""
+    of = SystemGeometryObjectiveFunction.FromSystem ( system )
+    of.DefineWeights ( )
+    ( kineticEnergy, temperature ) = of.Temperature ( system.scratch.velocities )
+    return ( system.Energy ( log = None ) + kineticEnergy )
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Paths.
+dataPath = os.path.join ( dataPath, "mol2" )
+
+# . Set up the system.
+system = ImportSystem ( os.path.join ( dataPath, "waterBox.mol2" ) )
+system.DefineMMModel ( MMModelOPLS.WithParameterSet ( "bookSmallExamples" ) )
+system.DefineNBModel ( NBModelCutOff.WithDefaults ( ) )
+system.Summary ( )
+system.Energy  ( )
+
+# . Equilibrate to get a starting point for the comparisons.
+normalDeviateGenerator = NormalDeviateGenerator.WithRandomNumberGenerator ( RandomNumberGenerator.WithSeed ( 614108 ) )
+LangevinDynamics_SystemGeometry ( system                                          ,
+                                  collisionFrequency     =                   25.0 ,
+                                  logFrequency           =                  _NLog ,
+                                  normalDeviateGenerator = normalDeviateGenerator ,
+                                  steps                  =                _NSteps ,
+                                  temperature            =                  300.0 ,
+                                  timeStep               =                  0.001 )
+coordinates3 = Clone ( system.coordinates3       )
+velocities   = Clone ( system.scratch.velocities )
+
+# . Energies, gradients and constant energy dynamics starting from the same point with each precision.
+drifts    = []
+energies  = []
+gradients = []
+for useSinglePrecision in ( False, True ):
+    nbModel = NBModelCutOff.WithDefaults ( )
+    nbModel.useSinglePrecision = useSinglePrecision
+    system.DefineNBModel ( nbModel )
+    system.nbModel.Summary ( )
+    system.coordinates3 = Clone ( coordinates3 )
+    energies.append  ( system.Energy ( doGradients = True, log = None ) )
+    gradients.append ( Clone ( system.scratch.gradients3 ) )
+    system.scratch.velocities = Clone ( velocities )
+    e0 = TotalEnergy ( system )
+    VelocityVerletDynamics_SystemGeometry ( system                 ,
+                                            logFrequency =   _NLog ,
+                                            steps        = _NSteps ,
+                                            timeStep     =   0.001 )
+    drifts.append ( TotalEnergy ( system ) - e0 )
+
+# . Check deviations.
+gradients[1].Add ( gradients[0], scale = -1.0 )
+energyDeviation   = math.fabs ( energies[1] - energies[0] )
+gradientDeviation = gradients[1].iterator.AbsoluteMaximum ( )
+driftDeviation    = math.fabs ( drifts[1] - drifts[0] )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation              = {:.5f}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation    = {:.5f}".format ( gradientDeviation ) )
+logFile.Paragraph ( "Energy drifts (double/single) = {:.5f} {:.5f}".format ( drifts[0], drifts[1] ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ) or \
+   ( driftDeviation    > _DriftTolerance    ): TestScriptExit_Fail ( )
@@ -0,0 +1,76 @@
+"""Compare MM/MM energies and gradients from the tabulated spline and analytic pairwise interactions for the cutoff NB model."""
+
+import math, os, os.path
+
+from Definitions               import dataPath
+from pBabel                    import ImportSystem
+from pCore                     import Clone                           , \
+                                      logFile                         , \
+                                      Selection                       , \
+                                      TestScriptExit_Fail
+from pMolecule                 import SystemGeometryObjectiveFunction
+from pMolecule.MMModel         import MMModelOPLS
+from pMolecule.NBModel         import NBModelCutOff                   , \
+                                      PairwiseInteractionABFS         , \
+                                      PairwiseInteractionSplineABFS
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_FreeAtoms          = range ( 12 )
+_InteractionOptions = { "dampingCutOff" :  0.5 ,
+                        "innerCutOff"   :  8.0 ,
+                        "outerCutOff"   : 12.0 }
+
+# . Tolerances (kJ mol^-1 and kJ mol^-1 A^-1).
+_EnergyTolerance    = 0.1
+_GradientTolerance  = 0.05
+_NumericalTolerance = 1.0e-2
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Set up the system.
+system = ImportSystem ( os.path.join ( dataPath, "mol2", "waterBox.mol2" ) )
+system.DefineMMModel ( MMModelOPLS.WithParameterSet ( "bookSmallExamples" ) )
+system.Summary ( )
+
+# . Energies and gradients with analytic and spline interactions in double and single precision.
+energyDeviation    = 0.0
+gradientDeviation  = 0.0
+numericalDeviation = 0.0
+for useSinglePrecision in ( False, True ):
+    energies  = []
+    gradients = []
+    for interactionClass in ( PairwiseInteractionABFS, PairwiseInteractionSplineABFS ):
+        pairwiseInteraction = interactionClass.WithOptions ( **_InteractionOptions )
+        nbModel             = NBModelCutOff.WithOptions ( pairwiseInteraction = pairwiseInteraction, useSinglePrecision = useSinglePrecision )
+        system.DefineNBModel ( nbModel )
+        system.nbModel.Summary ( )
+        energies.append  ( system.Energy ( doGradients = True, log = None ) )
+        gradients.append ( Clone ( system.scratch.gradients3 ) )
+    gradients[1].Add ( gradients[0], scale = -1.0 )
+    energyDeviation   = max ( energyDeviation  , math.fabs ( energies[1] - energies[0] ) )
+    gradientDeviation = max ( gradientDeviation, gradients[1].iterator.AbsoluteMaximum ( ) )
+
+    # . Numerical gradients of the spline interactions in double precision.
+    if not useSinglePrecision:
+        system.freeAtoms   = Selection.FromIterable ( _FreeAtoms )
+        of                 = SystemGeometryObjectiveFunction.FromSystem ( system )
+        numericalDeviation = of.TestGradients ( )
+        system.freeAtoms   = None
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation            = {:.5f}".format ( energyDeviation    ) )
+logFile.Paragraph ( "Maximum gradient deviation  = {:.5f}".format ( gradientDeviation  ) )
+logFile.Paragraph ( "Maximum numerical deviation = {:.5f}".format ( numericalDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation    > _EnergyTolerance    ) or \
+   ( gradientDeviation  > _GradientTolerance  ) or \
+   ( numericalDeviation > _NumericalTolerance ): TestScriptExit_Fail ( )
@@ -0,0 +1,72 @@
+"""Compare fast multipole and direct evaluations of the full NB model."""
+
+import math, os, os.path
+
+from Definitions           import dataPath
+from pBabel                import ImportSystem
+from pCore                 import Clone               , \
+                                  logFile             , \
+                                  Selection           , \
+                                  TestScriptExit_Fail
+from pMolecule.MMModel     import MMModelOPLS
+from pMolecule.NBModel     import FMMTree             , \
+                                  NBModelFull         , \
+                                  PairwiseInteractionABFS
+from pScientific.Geometry3 import PairListGenerator
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_EnergyTolerance    =    0.5
+_GradientTolerance  =    0.5
+_InnerCutOff        =  980.0
+_ListCutOff         = 1000.0
+_NumberOfLeafPoints =   32
+_OuterCutOff        =  990.0
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Set up the system.
+system = ImportSystem ( os.path.join ( dataPath, "gridUpdating", "crambin.mol" ) )
+system.DefineMMModel ( MMModelOPLS.WithParameterSet ( "protein" ) )
+system.DefineNBModel ( NBModelFull.WithDefaults ( ) )
+system.Summary ( )
+
+# . The models.
+# . Small leaves are used so that the expansions are exercised for this system and large cut-offs so that all Lennard-Jones
+#   interactions are included and their smoothing is negligible.
+fmmModel = NBModelFull.WithOptions ( fmmTree                 = FMMTree.WithOptions                 ( numberOfLeafPoints = _NumberOfLeafPoints ) ,
+                                     generator               = PairListGenerator.WithOptions       ( cutOff             = _ListCutOff         ) ,
+                                     lennardJonesInteraction = PairwiseInteractionABFS.WithOptions ( innerCutOff        = _InnerCutOff        ,
+                                                                                                     outerCutOff        = _OuterCutOff        ) ,
+                                     useFMM                  = True                                                                             )
+fmmModel.Summary ( )
+
+# . Compare energies and gradients with all atoms free and with half of them fixed.
+energyDeviation   = 0.0
+gradientDeviation = 0.0
+for freeAtoms in ( None, Selection.FromIterable ( range ( len ( system.atoms ) // 2 ) ) ):
+    energies  = []
+    gradients = []
+    for nbModel in ( NBModelFull.WithDefaults ( ), fmmModel ):
+        system.DefineNBModel ( nbModel )
+        system.freeAtoms = freeAtoms
+        energies.append  ( system.Energy ( doGradients = True ) )
+        gradients.append ( Clone ( system.scratch.gradients3 ) )
+    gradients[1].Add ( gradients[0], scale = -1.0 )
+    energyDeviation   = max ( energyDeviation  , math.fabs ( energies[1] - energies[0] ) )
+    gradientDeviation = max ( gradientDeviation, gradients[1].iterator.AbsoluteMaximum ( ) )
+
+# . Summary of results.
+logFile.Paragraph ( "Energy deviation           = {:.5f}".format ( energyDeviation   ) )
+logFile.Paragraph ( "Maximum gradient deviation = {:.5f}".format ( gradientDeviation ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( energyDeviation   > _EnergyTolerance   ) or \
+   ( gradientDeviation > _GradientTolerance ): TestScriptExit_Fail ( )
@@ -0,0 +1,102 @@
+"""Check the energies and gradients of the SPME NB model for periodic MM and QC/MM water boxes."""
+
+import math, os, os.path
+
+from Definitions          import dataPath                        , \
+                                 _FullVerificationSummary
+from pBabel               import ImportSystem
+from pCore                import logFile                         , \
+                                 Selection                       , \
+                                 TestDataSet                     , \
+                                 TestReal                        , \
+                                 TestScriptExit_Fail
+from pMolecule            import SystemGeometryObjectiveFunction
+from pMolecule.MMModel    import MMModelOPLS
+from pMolecule.NBModel    import NBModelSPME
+from pMolecule.QCModel    import DIISSCFConverger                , \
+                                 QCModelMNDO
+from pScientific.Symmetry import CrystalSystemCubic              , \
+                                 PeriodicBoundaryConditions
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_BoxExpansion  = 1.1
+_BoxSize       = 28.0
+_FreeAtoms     = range ( 12 )
+_QCAtoms       = range (  3 )
+
+# . The reference model has a much smaller Ewald tolerance and a finer and smoother grid than the default.
+_ReferenceOptions = { "ewaldTolerance" : 1.0e-8 ,
+                      "gridSpacing"    : 0.4    ,
+                      "splineOrder"    : 8      }
+
+# . Tolerances.
+_EnergyTolerance   = 0.5
+_GradientTolerance = 1.0e-2
+_RemakeTolerance   = 1.0e-6
+
+#===================================================================================================================================
+# . Functions.
+#===================================================================================================================================
+def GetSystem ( doQCMM, nbOptions = {} ):
+    """Get a water box with a SPME NB model."""
+    system = ImportSystem ( os.path.join ( dataPath, "mol2", "waterBox.mol2" ) )
+    system.symmetry           = PeriodicBoundaryConditions.WithCrystalSystem ( CrystalSystemCubic ( ) )
+    system.symmetryParameters = system.symmetry.MakeSymmetryParameters ( a = _BoxSize )
+    system.DefineMMModel ( MMModelOPLS.WithParameterSet ( "bookSmallExamples" ) )
+    if doQCMM:
+        qcModel = QCModelMNDO.WithOptions ( converger = DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-10, maximumIterations = 250 ), hamiltonian = "am1" )
+        system.DefineQCModel ( qcModel, qcSelection = Selection.FromIterable ( _QCAtoms ) )
+    system.DefineNBModel ( NBModelSPME.WithOptions ( **nbOptions ) )
+    system.Summary ( )
+    return system
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Loop over the MM and QC/MM systems.
+observed      = {}
+referenceData = TestDataSet.WithOptions ( label = "SPME NB Model" )
+for ( doQCMM, tag ) in ( ( False, "MM" ), ( True, "QC/MM" ) ):
+
+    # . Energies with the reference and default models.
+    energies = []
+    for nbOptions in ( _ReferenceOptions, {} ):
+        system = GetSystem ( doQCMM, nbOptions = nbOptions )
+        energies.append ( system.Energy ( ) )
+    observed[tag + " Energy Error"] = math.fabs ( energies[1] - energies[0] )
+
+    # . Gradients with respect to the coordinates of some atoms and the box size.
+    system.freeAtoms = Selection.FromIterable ( _FreeAtoms )
+    of = SystemGeometryObjectiveFunction.FromSystem ( system )
+    of.IncludeSymmetryParameters ( )
+    observed[tag + " Gradient Error"] = of.TestGradients ( )
+    system.freeAtoms = None
+
+    # . An expanded box with the grid from the previous box in the scratch area and with a grid made from scratch.
+    system.symmetryParameters = system.symmetry.MakeSymmetryParameters ( a = _BoxExpansion * _BoxSize )
+    energies = [ system.Energy ( ) ]
+    system.scratch.Clear ( )
+    energies.append ( system.Energy ( ) )
+    observed[tag + " Remake Error"] = math.fabs ( energies[1] - energies[0] )
+
+    # . Reference data.
+    for ( label, tolerance ) in ( ( "Energy Error", _EnergyTolerance ), ( "Gradient Error", _GradientTolerance ), ( "Remake Error", _RemakeTolerance ) ):
+        referenceData.AddDatum ( TestReal.WithOptions ( absoluteErrorTolerance = tolerance         ,
+                                                        label                  = tag + " " + label ,
+                                                        parent                 = referenceData     ,
+                                                        toleranceFormat        = "{:.3g}"          ,
+                                                        value                  = 0.0               ,
+                                                        valueFormat            = "{:.6f}"          ) )
+
+# . Footer.
+results = referenceData.VerifyAgainst ( observed )
+results.Summary ( fullSummary = _FullVerificationSummary )
+isOK = results.WasSuccessful ( )
+logFile.Footer ( )
+if not isOK: TestScriptExit_Fail ( )
@@ -0,0 +1,123 @@
+"""Check the energies and gradients of the DFT-D2 QC dispersion model for isolated and periodic systems."""
+
+import math, os.path
+
+from Definitions           import dataPath                        , \
+                                  _FullVerificationSummary
+from pBabel                import ImportSystem
+from pCore                 import logFile                         , \
+                                  TestDataSet                     , \
+                                  TestReal                        , \
+                                  TestScriptExit_Fail
+from pMolecule             import EnergyModelPriority             , \
+                                  System                          , \
+                                  SystemGeometryObjectiveFunction
+from pMolecule.QCModel     import DIISSCFConverger                , \
+                                  QCDispersionModelDFTD2          , \
+                                  QCModelMNDO
+from pScientific.Geometry3 import Coordinates3                    , \
+                                  PairListGenerator
+from pScientific.Symmetry  import CrystalSystemCubic              , \
+                                  PeriodicBoundaryConditions
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_BoxSize   = 5.0
+_CutOff    = 8.0
+_Molecules = ( "glycine", "waterDimer_Cs" )
+
+# . Tolerances.
+_ClusterTolerance  = 1.0e-6
+_GradientTolerance = 1.0e-2
+
+#===================================================================================================================================
+# . Functions.
+#===================================================================================================================================
+def DefineModels ( system ):
+    """Define the QC and dispersion models."""
+    qcModel                   = QCModelMNDO.WithOptions ( converger = DIISSCFConverger.WithOptions ( densityTolerance = 1.0e-10, maximumIterations = 250 ), hamiltonian = "am1" )
+    dispersionModel           = QCDispersionModelDFTD2.FromYAMLFile ( )
+    dispersionModel.generator = PairListGenerator.WithOptions ( cutOff = _CutOff )
+    system.DefineQCModel  ( qcModel )
+    system.AddEnergyModel ( "qcDispersionModel", dispersionModel, priority = EnergyModelPriority.QCAddOns, valueClass = QCDispersionModelDFTD2 )
+
+def DispersionEnergy ( system ):
+    """The dispersion energy of a system without a QC calculation."""
+    system.EnergyInitialize ( False, None )
+    system.qcModel.EnergyInitialize ( system )
+    return system.qcDispersionModel.Energy ( system )["DFT-D2 Dispersion"]
+
+def ReplicatedCluster ( system, n, includeCentral = True ):
+    """Replicate a system in a cubic box out to +/- n cells in each direction."""
+    atomicNumbers = [ atom.atomicNumber for atom in system.atoms ]
+    translations  = [ ( i, j, k ) for i in range ( -n, n+1 ) for j in range ( -n, n+1 ) for k in range ( -n, n+1 ) if includeCentral or ( ( i, j, k ) != ( 0, 0, 0 ) ) ]
+    cluster       = System.FromAtoms ( len ( translations ) * atomicNumbers )
+    coordinates3  = Coordinates3.WithExtent ( len ( cluster.atoms ) )
+    a             = 0
+    for translation in translations:
+        for r in range ( len ( atomicNumbers ) ):
+            for c in range ( 3 ):
+                coordinates3[a,c] = system.coordinates3[r,c] + translation[c] * _BoxSize
+            a += 1
+    cluster.coordinates3 = coordinates3
+    DefineModels ( cluster )
+    return cluster
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Gradients of isolated molecules.
+observed      = {}
+referenceData = TestDataSet.WithOptions ( label = "DFT-D2 Dispersion" )
+tests         = []
+for label in _Molecules:
+    molecule = ImportSystem ( os.path.join ( dataPath, "xyz", label + ".xyz" ) )
+    DefineModels ( molecule )
+    molecule.Summary ( )
+    of = SystemGeometryObjectiveFunction.FromSystem ( molecule )
+    observed[label + " Gradient Error"] = of.TestGradients ( )
+    tests.append ( ( label + " Gradient Error", _GradientTolerance ) )
+
+# . A periodic water molecule.
+water                    = ImportSystem ( os.path.join ( dataPath, "xyz", "water.xyz" ) )
+water.symmetry           = PeriodicBoundaryConditions.WithCrystalSystem ( CrystalSystemCubic ( ) )
+water.symmetryParameters = water.symmetry.MakeSymmetryParameters ( a = _BoxSize )
+DefineModels ( water )
+water.Summary ( )
+
+# . Gradients with respect to the coordinates and the box size.
+of = SystemGeometryObjectiveFunction.FromSystem ( water )
+of.IncludeSymmetryParameters ( )
+observed["Periodic Gradient Error"] = of.TestGradients ( )
+tests.append ( ( "Periodic Gradient Error", _GradientTolerance ) )
+
+# . The periodic energy compared to that from an explicitly replicated cluster.
+# . The energy per cell is E(C) + 1/2 E(C,I) where C is the central cell and I the images within the cut-off.
+# . As E(C,I) = E(C+I) - E(C) - E(I) this is 1/2 ( E(C+I) + E(C) - E(I) ).
+n                = int ( math.ceil ( _CutOff / _BoxSize ) ) + 1
+periodicEnergy   = DispersionEnergy ( water )
+clusterEnergy    = 0.5 * ( DispersionEnergy ( ReplicatedCluster ( water, n ) ) + DispersionEnergy ( ReplicatedCluster ( water, 0 ) ) - DispersionEnergy ( ReplicatedCluster ( water, n, includeCentral = False ) ) )
+observed["Cluster Energy Error"] = math.fabs ( periodicEnergy - clusterEnergy )
+tests.append ( ( "Cluster Energy Error", _ClusterTolerance ) )
+logFile.Paragraph ( "Periodic and replicated cluster dispersion energies = {:.10f} and {:.10f} kJ/mol.".format ( periodicEnergy, clusterEnergy ) )
+
+# . Reference data.
+for ( label, tolerance ) in tests:
+    referenceData.AddDatum ( TestReal.WithOptions ( absoluteErrorTolerance = tolerance     ,
+                                                    label                  = label         ,
+                                                    parent                 = referenceData ,
+                                                    toleranceFormat        = "{:.3g}"      ,
+                                                    value                  = 0.0           ,
+                                                    valueFormat            = "{:.6g}"      ) )
+
+# . Footer.
+results = referenceData.VerifyAgainst ( observed )
+results.Summary ( fullSummary = _FullVerificationSummary )
+isOK = results.WasSuccessful ( )
+logFile.Footer ( )
+if not isOK: TestScriptExit_Fail ( )
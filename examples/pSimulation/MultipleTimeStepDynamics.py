@@ -0,0 +1,98 @@
+"""Compare multiple-time-step dynamics with velocity Verlet dynamics."""
+
+import math, os
+
+from Definitions               import dataPathM
+from pBabel                    import ImportSystem
+from pCore                     import Clone                                   , \
+                                      logFile                                 , \
+                                      TestScriptExit_Fail
+from pMolecule                 import SystemGeometryObjectiveFunction
+from pMolecule.MMModel         import MMModelOPLS
+from pMolecule.NBModel         import NBModelFull
+from pScientific.RandomNumbers import NormalDeviateGenerator                  , \
+                                      RandomNumberGenerator
+from pSimulation               import LBFGSMinimize_SystemGeometry            , \
+                                      MultipleTimeStepDynamics_SystemGeometry , \
+                                      VelocityVerletDynamics_SystemGeometry
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . Options.
+_InnerSteps  = ( 2, 4 )
+_NLog        =  100
+_NSteps      = 1000
+_NStepsShort =  100
+_Seed        = 517093
+_Temperature = 300.0
+_TimeStep    = 0.001
+
+# . Tolerances.
+_DriftTolerance        = 0.5
+_RMSDeviationTolerance = 1.0e-04
+
+#===================================================================================================================================
+# . Functions.
+#===================================================================================================================================
+def TotalEnergy ( system ):
+    """Return the total energy of the system given its current coordinates and velocities."""
+    of = SystemGeometryObjectiveFunction.FromSystem ( system )
+    of.DefineWeights ( )
+    ( kineticEnergy, temperature ) = of.Temperature ( system.scratch.velocities )
+    return ( system.Energy ( log = None ) + kineticEnergy )
+
+#===================================================================================================================================
+# . Script.
+#===================================================================================================================================
+# . Header.
+logFile.Header ( )
+
+# . Set up the system - the full MM/MM nonbonded interactions are slow whereas the other terms are fast.
+system = ImportSystem ( os.path.join ( dataPathM, "mol", "cyclohexane.mol" ) )
+system.DefineMMModel ( MMModelOPLS.WithParameterSet ( "protein" ) )
+system.DefineNBModel ( NBModelFull.WithDefaults ( )               )
+system.Summary ( )
+LBFGSMinimize_SystemGeometry ( system, logFrequency = _NLog, maximumIterations = 1000, rmsGradientTolerance = 1.0e-03 )
+
+# . Starting coordinates and velocities.
+of = SystemGeometryObjectiveFunction.FromSystem ( system )
+of.DefineWeights ( )
+of.RemoveRotationTranslation ( )
+of.VelocitiesAssign ( _Temperature, normalDeviateGenerator = NormalDeviateGenerator.WithRandomNumberGenerator ( RandomNumberGenerator.WithSeed ( _Seed ) ) )
+coordinates3 = Clone ( system.coordinates3       )
+velocities   = Clone ( system.scratch.velocities )
+
+# . With one inner step the multiple-time-step integrator should reproduce velocity Verlet.
+results = []
+for ( function, options ) in ( ( VelocityVerletDynamics_SystemGeometry  , {                         } ) ,
+                               ( MultipleTimeStepDynamics_SystemGeometry, { "numberOfInnerSteps" : 1 } ) ):
+    system.coordinates3       = Clone ( coordinates3 )
+    system.scratch.velocities = Clone ( velocities   )
+    function ( system, logFrequency = _NLog, steps = _NStepsShort, temperatureStart = None, timeStep = _TimeStep, **options )
+    results.append ( Clone ( system.coordinates3 ) )
+rmsDeviation = results[1].RootMeanSquareDeviation ( results[0] )
+
+# . Energy conservation with several inner steps and correspondingly longer time steps.
+drifts = []
+for numberOfInnerSteps in _InnerSteps:
+    system.coordinates3       = Clone ( coordinates3 )
+    system.scratch.velocities = Clone ( velocities   )
+    e0 = TotalEnergy ( system )
+    MultipleTimeStepDynamics_SystemGeometry ( system                                                      ,
+                                              logFrequency       = _NLog                                  ,
+                                              numberOfInnerSteps = numberOfInnerSteps                     ,
+                                              steps              = _NSteps                                ,
+                                              temperatureStart   = None                                   ,
+                                              timeStep           = _TimeStep * float ( numberOfInnerSteps ) )
+    drifts.append ( TotalEnergy ( system ) - e0 )
+
+# . Summary of results.
+logFile.Paragraph ( "RMS coordinate deviation (one inner step) = {:.3g}".format ( rmsDeviation ) )
+for ( numberOfInnerSteps, drift ) in zip ( _InnerSteps, drifts ):
+    logFile.Paragraph ( "Energy drift ({:d} inner steps)           = {:.5f}".format ( numberOfInnerSteps, drift ) )
+
+# . Footer.
+logFile.Footer ( )
+if ( rmsDeviation > _RMSDeviationTolerance ) or \
+   any ( math.fabs ( drift ) > _DriftTolerance for drift in drifts ): TestScriptExit_Fail ( )
@@ -30,27 +30,40 @@ typedef struct {
     Integer     capacity ;
     Integer    *indices  ;
     Integer    *work     ;
-    PairRecord  record   ;
 } PairExcluded ;
 
 /* . The pair list type. */
+/* . The records are stored contiguously in compressed sparse row form. Record r has index indices[r] and partners
+!    partners[offsets[r]] to partners[offsets[r+1]-1]. For excluded lists the partners are the exclusions. */
 typedef struct {
-    Boolean           isSelf        ;
-    Boolean           isSorted      ;
-    Integer           capacity      ;
-    Integer           count         ;
-    Integer           numberOfPairs ;
-    PairConnections  *connections   ;
-    PairExcluded     *excluded      ;
-    PairRecord      **records       ;
+    Boolean           isSelf          ;
+    Boolean           isSorted        ;
+    Integer           capacity        ;
+    Integer           count           ;
+    Integer           numberOfPairs   ;
+    Integer           partnerCapacity ;
+    Integer          *indices         ;
+    Integer          *offsets         ;
+    Integer          *partners        ;
+    PairConnections  *connections     ;
+    PairExcluded     *excluded        ;
 } PairList ;
 
 /* . The pair list iterator type. */
+/* . The record is a view onto the current record of the target. */
 typedef struct {
-    Integer   current ;
-    PairList *target  ;
+    Integer     current ;
+    PairList   *target  ;
+    PairRecord  record  ;
 } PairListIterator ;
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Macros.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . Direct access to the records of lists that are not excluded. There is no checking. */
+# define PairList_RecordCapacity( self, r ) ( (self)->offsets[(r)+1] - (self)->offsets[(r)] )
+# define PairList_RecordIndex(    self, r ) ( (self)->indices[(r)] )
+# define PairList_RecordPartners( self, r ) ( &((self)->partners[(self)->offsets[(r)]]) )
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Functions.
@@ -71,13 +84,22 @@ extern PairExcluded       *PairExcluded_FromIndices             ( const Integer
 /* . General pair-list functions. */
 extern PairList           *PairList_Allocate                    ( const Integer           capacity      ,
                                                                         Status           *status        ) ;
+extern Integer            *PairList_AllocateThreadWork          ( const PairList         *self          ,
+                                                                        Integer          *numberOfThreads ) ;
 extern void                PairList_Append                      (       PairList         *self          ,
-                                                                        PairRecord       *record        ,
+                                                                  const Integer           index         ,
+                                                                  const Integer           capacity      ,
+                                                                  const Integer          *partners      ,
                                                                         Status           *status        ) ;
 extern void                PairList_ClearRepresentations        (       PairList         *self          ) ;
 extern void                PairList_Deallocate                  (       PairList        **self          ) ;
 extern PairRecord         *PairList_GetRecord                   (       PairList         *self          ,
-                                                                  const Integer           index         ) ;
+                                                                  const Integer           index         ,
+                                                                        PairRecord       *record        ) ;
+extern PairRecord         *PairList_GetRecordWithWork           (       PairList         *self          ,
+                                                                  const Integer           index         ,
+                                                                        Integer          *work          ,
+                                                                        PairRecord       *record        ) ;
 extern void                PairList_Initialize                  (       PairList         *self          ) ;
 extern Integer             PairList_MaximumRecordSize           ( const PairList         *self          ) ;
 extern Integer             PairList_NumberOfPairs               ( const PairList         *self          ) ;
@@ -85,7 +107,12 @@ extern Integer             PairList_NumberOfRecords             ( const PairList
 extern Boolean             PairList_Reallocate                  (       PairList         *self          ,
                                                                   const Integer           capacity      ,
                                                                         Status           *status        ) ;
+extern Boolean             PairList_ReallocatePartners          (       PairList         *self          ,
+                                                                  const Integer           capacity      ,
+                                                                        Status           *status        ) ;
 extern void                PairList_Sort                        (       PairList         *self          ) ;
+extern Integer            *PairList_ThreadWork                  (       PairList         *self          ,
+                                                                        Integer          *work          ) ;
 extern Integer             PairList_UpperBound                  ( const PairList         *self          ,
                                                                   const Boolean           isSelf        ) ;
 
@@ -140,13 +167,6 @@ extern void                PairListIterator_Initialize          (       PairList
 extern PairRecord         *PairListIterator_Next                (       PairListIterator *self          ) ;
 
 /* . Pair record functions. */
-extern PairRecord         *PairRecord_Allocate                  ( const Integer           capacity      ,
-                                                                        Status           *status        ) ;
-extern void                PairRecord_Deallocate                (       PairRecord      **self          ) ;
-extern PairRecord         *PairRecord_FromIndices               ( const Integer           index         ,
-                                                                  const Integer           capacity      ,
-                                                                  const Integer          *indices       ,
-                                                                        Status           *status        ) ;
 extern void                PairRecord_Initialize                (       PairRecord       *self          ) ;
 extern void                PairRecord_Sort                      (       PairRecord       *self          ) ;
 
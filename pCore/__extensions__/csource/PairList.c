@@ -10,13 +10,18 @@
 # include "NumericalMacros.h"
 # include "PairList.h"
 
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
 /* . Add checks in Make/To PairList functions for actual versus analytic number of pairs? */
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Parameters.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-# define _GrowthFactor    1.1e+00
-# define _MinimumCapacity 32
+# define _GrowthFactor        1.1e+00
+# define _MinimumCapacity     32
+# define _PartnerGrowthFactor 1.5e+00
 
 /*==================================================================================================================================
 ! . Utility functions.
@@ -182,36 +187,63 @@ PairList *PairList_Allocate ( const Integer capacity, Status *status )
         auto Integer n ;
         n = Maximum ( capacity, _MinimumCapacity ) ;
         PairList_Initialize ( self ) ;
-        self->records = Memory_AllocateArrayOfReferences ( n, PairRecord ) ;
-        if ( self->records == NULL ) PairList_Deallocate ( &self ) ;
+        self->indices  = Integer_Allocate ( n    , NULL ) ;
+        self->offsets  = Integer_Allocate ( n + 1, NULL ) ;
+        self->partners = Integer_Allocate ( n    , NULL ) ;
+        if ( ( self->indices == NULL ) || ( self->offsets == NULL ) || ( self->partners == NULL ) ) PairList_Deallocate ( &self ) ;
         else
         {
-            auto Integer i ;
-            for ( i = 0 ; i < n ; i++ ) self->records[i] = NULL ;
-            self->capacity = n ;
+            self->capacity        = n ;
+            self->partnerCapacity = n ;
+            self->offsets[0]      = 0 ;
         }
     }
     if ( self == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
     return self ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocate per-thread work arrays for getting the records of an excluded list in parallel.
+! . On entry numberOfThreads holds the number of threads to be used and on exit the number that can be used.
+! . NULL is returned if the list is not excluded, there is only one thread or the allocation fails. In the last case one thread
+! . is used.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Integer *PairList_AllocateThreadWork ( const PairList *self, Integer *numberOfThreads )
+{
+    Integer *work = NULL ;
+    if ( ( self != NULL ) && ( self->excluded != NULL ) && ( numberOfThreads != NULL ) && ( (*numberOfThreads) > 1 ) )
+    {
+        work = Integer_Allocate ( (*numberOfThreads) * self->excluded->capacity, NULL ) ;
+        if ( work == NULL ) (*numberOfThreads) = 1 ;
+    }
+    return work ;
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Append a record.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-void PairList_Append ( PairList *self, PairRecord *record, Status *status )
+/* . The partners are copied. */
+void PairList_Append ( PairList *self, const Integer index, const Integer capacity, const Integer *partners, Status *status )
 {
-    if ( ( self != NULL ) && ( record != NULL ) && Status_IsOK ( status ) )
+    if ( ( self != NULL ) && ( capacity >= 0 ) && ( ( capacity == 0 ) || ( partners != NULL ) ) && Status_IsOK ( status ) )
     {
-        auto Boolean isOK = True ;
+        auto Boolean isOK  = True ;
+        auto Integer start = self->offsets[self->count] ;
         if ( self->count >= self->capacity )
         {
             isOK = PairList_Reallocate ( self, ( Integer ) ( self->capacity * _GrowthFactor ), status ) ;
         }
+        if ( isOK && ( start + capacity > self->partnerCapacity ) )
+        {
+            isOK = PairList_ReallocatePartners ( self, Maximum ( start + capacity, ( Integer ) ( self->partnerCapacity * _PartnerGrowthFactor ) ), status ) ;
+        }
         if ( isOK )
         {
-            self->records[self->count] = record ;
-            self->count               += 1 ;
-            self->numberOfPairs       += record->capacity ;
+            if ( capacity > 0 ) Integer_CopyTo ( partners, capacity, &(self->partners[start]), NULL ) ;
+            self->indices[self->count]   = index ;
+            self->offsets[self->count+1] = start + capacity ;
+            self->count                 += 1 ;
+            self->numberOfPairs         += capacity ;
         }
     }
 }
@@ -231,29 +263,45 @@ void PairList_Deallocate ( PairList **self )
 {
     if ( (*self) != NULL )
     {
-        auto Integer i ;
         PairExcluded_Deallocate       ( &((*self)->excluded) ) ;
         PairList_ClearRepresentations (   (*self) ) ;
-        for ( i = 0 ; i < (*self)->count ; i++ ) PairRecord_Deallocate ( &((*self)->records[i]) ) ;
-        Memory_Deallocate ( (*self)->records ) ;
-        Memory_Deallocate ( (*self)          ) ;
+        Integer_Deallocate ( &((*self)->indices ) ) ;
+        Integer_Deallocate ( &((*self)->offsets ) ) ;
+        Integer_Deallocate ( &((*self)->partners) ) ;
+        Memory_Deallocate  (   (*self)            ) ;
     }
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Get a record.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-/* . No checking and excluded pair-lists must be sorted. */
-PairRecord *PairList_GetRecord ( PairList *self, const Integer index )
+/* . The input record is filled as a view onto the list and returned.
+!  . For excluded lists the record's indices are those of the excluded work array which is overwritten by each call.
+!  . No checking and excluded pair-lists must be sorted. */
+PairRecord *PairList_GetRecord ( PairList *self, const Integer index, PairRecord *record )
 {
-    PairRecord *record = self->records[index] ;
-    if ( self->excluded != NULL )
+    return PairList_GetRecordWithWork ( self, index, ( self->excluded == NULL ) ? NULL : self->excluded->work, record ) ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Get a record using a given work array.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . As PairList_GetRecord except that the indices of excluded records are put in work which must be at least as large as the
+!    excluded capacity. This makes the function reentrant when each thread has its own work array. */
+PairRecord *PairList_GetRecordWithWork ( PairList *self, const Integer index, Integer *work, PairRecord *record )
+{
+    auto Integer  eCapacity = PairList_RecordCapacity ( self, index ) ;
+    auto Integer *eIndices  = PairList_RecordPartners ( self, index ) ;
+    record->index = self->indices[index] ;
+    if ( self->excluded == NULL )
+    {
+        record->capacity = eCapacity ;
+        record->indices  = eIndices  ;
+    }
+    else
     {
-        auto PairExcluded *excluded   = self->excluded ;
-        auto PairRecord   *exclusions = record ;
-        record        = &(excluded->record) ;
-        record->index = exclusions->index ;
-        if ( exclusions->capacity == 0 )
+        auto PairExcluded *excluded = self->excluded ;
+        if ( eCapacity == 0 )
         {
             if ( self->isSelf )
             {
@@ -270,20 +318,20 @@ PairRecord *PairList_GetRecord ( PairList *self, const Integer index )
             eMaximum = excluded->indices[excluded->capacity-1] + 1 ;
             if ( self->isSelf ) jMaximum = record->index ;
             else                jMaximum = eMaximum ;
-            e = 1 ; eNext = exclusions->indices[0] ;
+            e = 1 ; eNext = eIndices[0] ;
             for ( c = n = 0 ; c < excluded->capacity ; c++ )
             {
                 j = excluded->indices[c] ;
                 if ( j >= jMaximum ) break ;
-                else if ( j <  eNext ) { excluded->work[n] = j ; n++ ; }
+                else if ( j <  eNext ) { work[n] = j ; n++ ; }
                 else if ( j == eNext )
                 {
-                    if ( e < exclusions->capacity ) { eNext = exclusions->indices[e] ; e++ ; }
+                    if ( e < eCapacity ) { eNext = eIndices[e] ; e++ ; }
                     else { eNext = eMaximum ; }
                 }
             }
             record->capacity = n ;
-            record->indices  = excluded->work ;
+            record->indices  = work ;
         }
     }
     return record ;
@@ -296,14 +344,17 @@ void PairList_Initialize ( PairList *self )
 {
     if ( self != NULL )
     {
-        self->isSelf        = False ;
-        self->isSorted      = False ;
-        self->capacity      = 0 ;
-        self->count         = 0 ;
-        self->numberOfPairs = 0 ;
-        self->connections   = NULL ;
-        self->excluded      = NULL ;
-        self->records       = NULL ;
+        self->isSelf          = False ;
+        self->isSorted        = False ;
+        self->capacity        = 0 ;
+        self->count           = 0 ;
+        self->numberOfPairs   = 0 ;
+        self->partnerCapacity = 0 ;
+        self->indices         = NULL ;
+        self->offsets         = NULL ;
+        self->partners        = NULL ;
+        self->connections     = NULL ;
+        self->excluded        = NULL ;
     }
 }
 
@@ -318,50 +369,16 @@ Integer PairList_MaximumRecordSize ( const PairList *self )
         auto Integer r ;
         if ( self->excluded )
         {
-            auto PairExcluded *excluded   = self->excluded ;
-            auto PairRecord   *exclusions = NULL ;
+            auto PairRecord record ;
             for ( r = 0 ; r < self->count ; r++ )
             {
-                exclusions = self->records[r] ;
-                if ( exclusions->capacity == 0 )
-                {
-                    if ( self->isSelf )
-                    {
-                        auto Integer i = exclusions->index, j, m ;
-                        for ( m = 0 ; m < excluded->capacity ; m++ ) { j = excluded->indices[m] ; if ( j >= i ) break ; }
-                        n = Maximum ( n, m ) ;
-                    }
-                    else
-                    {
-                        n = Maximum ( n, excluded->capacity ) ;
-                    }
-                }
-                else
-                {
-                    auto Integer     c, e, eMaximum, eNext, j, jMaximum, m ;
-                    auto PairRecord *record = &(excluded->record) ;
-                    eMaximum = excluded->indices[excluded->capacity-1] + 1 ;
-                    if ( self->isSelf ) jMaximum = record->index ;
-                    else                jMaximum = eMaximum ;
-                    e = 1 ; eNext = exclusions->indices[0] ;
-                    for ( c = m = 0 ; c < excluded->capacity ; c++ )
-                    {
-                        j = excluded->indices[c] ;
-                        if ( j >= jMaximum ) break ;
-                        else if ( j <  eNext ) { excluded->work[m] = j ; m++ ; }
-                        else if ( j == eNext )
-                        {
-                            if ( e < exclusions->capacity ) { eNext = exclusions->indices[e] ; e++ ; }
-                            else { eNext = eMaximum ; }
-                        }
-                    }
-                    n = Maximum ( n, m ) ;
-                }
+                PairList_GetRecord ( ( PairList * ) self, r, &record ) ;
+                n = Maximum ( n, record.capacity ) ;
             }
         }
         else
         {
-            for ( r = 0 ; r < self->count ; r++ ) n = Maximum ( n, self->records[r]->capacity ) ;
+            for ( r = 0 ; r < self->count ; r++ ) n = Maximum ( n, PairList_RecordCapacity ( self, r ) ) ;
         }
     }
     return n ;
@@ -387,48 +404,116 @@ Boolean PairList_Reallocate ( PairList *self, const Integer capacity, Status *st
     if ( ( self != NULL ) && Status_IsOK ( status ) )
     {
         auto Integer n ;
-             if ( capacity > self->capacity ) n = capacity    ;
-        else if ( capacity < self->count    ) n = self->count ;
-        n = Maximum ( capacity, _MinimumCapacity ) ;
+        n = Maximum ( Maximum ( capacity, self->count ), _MinimumCapacity ) ;
         if ( n != self->capacity )
         {
-            auto PairRecord **records  ;
-            records = Memory_ReallocateArrayOfReferences ( self->records, n, PairRecord ) ;
-            if ( records != NULL )
+            auto Integer *indices, *offsets ;
+            indices = Memory_ReallocateArrayOfTypes ( self->indices, n    , Integer ) ;
+            if ( indices != NULL ) self->indices = indices ;
+            offsets = Memory_ReallocateArrayOfTypes ( self->offsets, n + 1, Integer ) ;
+            if ( offsets != NULL ) self->offsets = offsets ;
+            if ( ( indices != NULL ) && ( offsets != NULL ) ) self->capacity = n ;
+            else isOK = False ;
+        }
+    }
+    if ( ! isOK ) Status_Set ( status, Status_OutOfMemory ) ;
+    return isOK ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Reallocate partners.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The partners can never be shortened below the current number stored. */
+Boolean PairList_ReallocatePartners ( PairList *self, const Integer capacity, Status *status )
+{
+    Boolean isOK = True ;
+    if ( ( self != NULL ) && Status_IsOK ( status ) )
+    {
+        auto Integer n ;
+        n = Maximum ( Maximum ( capacity, self->offsets[self->count] ), _MinimumCapacity ) ;
+        if ( n != self->partnerCapacity )
+        {
+            auto Integer *partners ;
+            partners = Memory_ReallocateArrayOfTypes ( self->partners, n, Integer ) ;
+            if ( partners != NULL )
             {
-                if ( n > self->count ) { auto Integer i ; for ( i = self->count ; i < n ; i++ ) records[i] = NULL ; }
-                self->capacity = n ;
-                self->records  = records ;
+                self->partnerCapacity = n        ;
+                self->partners        = partners ;
             }
             else isOK = False ;
         }
     }
+    if ( ! isOK ) Status_Set ( status, Status_OutOfMemory ) ;
     return isOK ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Sorting.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The records are sorted by index and then the partners of each record. */
 static Integer _RecordCompare ( const void *vSelf, const void *vOther )
 {
     Integer result ;
-    PairRecord **self, **other ;
-    self  = ( PairRecord ** ) vSelf  ;
-    other = ( PairRecord ** ) vOther ;
-         if ( (*self)->index < (*other)->index ) result = -1 ;
-    else if ( (*self)->index > (*other)->index ) result =  1 ;
+    PairRecord *self, *other ;
+    self  = ( PairRecord * ) vSelf  ;
+    other = ( PairRecord * ) vOther ;
+         if ( self->index < other->index ) result = -1 ;
+    else if ( self->index > other->index ) result =  1 ;
     else result = 0 ;
     return result ;
 }
 
 void PairList_Sort ( PairList *self )
 {
-    if ( ( self != NULL ) && ( self->count > 1 ) && ( ! self->isSorted ) )
+    if ( ( self != NULL ) && ( self->count > 0 ) && ( ! self->isSorted ) )
     {
-        auto Integer i ;
-        qsort ( ( void * ) self, ( Size ) self->count, SizeOf ( PairRecord * ), ( void * ) _RecordCompare ) ;
-        for ( i = 0 ; i < self->count ; i++ ) Integer_Sort ( self->records[i]->indices, self->capacity ) ;
-        self->isSorted = True ;
+        auto Integer     n = self->offsets[self->count], r ;
+        auto Integer    *partners ;
+        auto PairRecord *records  ;
+        partners = Integer_Allocate ( Maximum ( n, 1 ), NULL ) ;
+        records  = Memory_AllocateArrayOfTypes ( self->count, PairRecord ) ;
+        if ( ( partners != NULL ) && ( records != NULL ) )
+        {
+            for ( r = 0 ; r < self->count ; r++ )
+            {
+                records[r].index    = self->indices[r] ;
+                records[r].capacity = PairList_RecordCapacity ( self, r ) ;
+                records[r].indices  = PairList_RecordPartners ( self, r ) ;
+            }
+            qsort ( ( void * ) records, ( Size ) self->count, SizeOf ( PairRecord ), ( void * ) _RecordCompare ) ;
+            for ( n = r = 0 ; r < self->count ; r++ )
+            {
+                Integer_CopyTo ( records[r].indices, records[r].capacity, &(partners[n]), NULL ) ;
+                Integer_Sort   ( &(partners[n]), records[r].capacity ) ;
+                self->indices[r] = records[r].index ;
+                n += records[r].capacity ;
+                self->offsets[r+1] = n ;
+            }
+            Integer_Deallocate ( &(self->partners) ) ;
+            self->partners        = partners ;
+            self->partnerCapacity = Maximum ( n, 1 ) ;
+            self->isSorted        = True ;
+        }
+        else Integer_Deallocate ( &partners ) ;
+        Memory_Deallocate ( records ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Return the work array of the calling thread for use with PairList_GetRecordWithWork.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The list's own work array is returned if there are no per-thread arrays and NULL if the list is not excluded. */
+Integer *PairList_ThreadWork ( PairList *self, Integer *work )
+{
+    if ( ( self == NULL ) || ( self->excluded == NULL ) ) return NULL ;
+    else if ( work == NULL ) return self->excluded->work ;
+    else
+    {
+        auto Integer t = 0 ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        return &work[t*self->excluded->capacity] ;
     }
 }
 
@@ -439,7 +524,7 @@ void PairList_Sort ( PairList *self )
 Integer PairList_UpperBound ( const PairList *self, const Boolean isSelf )
 {
     Integer upperBound = 0 ;
-    if ( ( self != NULL ) && ( self->count > 0 ) && ( self->isSelf == isSelf ) && ( self->isSorted ) ) upperBound = self->records[self->count-1]->index + 1 ;
+    if ( ( self != NULL ) && ( self->count > 0 ) && ( self->isSelf == isSelf ) && ( self->isSorted ) ) upperBound = self->indices[self->count-1] + 1 ;
     return upperBound ;
 }
 
@@ -462,16 +547,14 @@ PairConnections *CrossPairList_MakeConnections ( PairList *self, const Integer u
             connections = PairConnections_Allocate ( Maximum ( upper, upperBound ), self->numberOfPairs, status ) ;
             if ( connections != NULL )
             {
-                auto Integer    i, m, n, r ;
-                auto PairRecord *pairRecord ;
+                auto Integer i, m, n, r ;
                 Integer_Set ( connections->itemsI, connections->capacityI + 1, 0 ) ;
                 for ( n = r = 0 ; r < self->count ; r++ )
                 {
-                    pairRecord = self->records[r] ;
-                    i = pairRecord->index    ;
-                    m = pairRecord->capacity ;
+                    i = PairList_RecordIndex    ( self, r ) ;
+                    m = PairList_RecordCapacity ( self, r ) ;
                     connections->itemsI[i] = m ;
-                    Integer_CopyTo ( pairRecord->indices, m, &(connections->itemsJ[n]), NULL ) ;
+                    Integer_CopyTo ( PairList_RecordPartners ( self, r ), m, &(connections->itemsJ[n]), NULL ) ;
                     n += m ;
                 }
                 for ( i = n = 0 ; i < connections->capacityI ; i++ )
@@ -507,12 +590,11 @@ extern PairList *CrossPairList_MakeFull ( const Integer    capacity1     ,
         isOK     = ( indices1 != NULL ) && ( indices2 != NULL ) ;
         if ( isOK )
         {
-            auto PairRecord *record ;
-            auto Status      localStatus = Status_OK ;
+            auto Status localStatus = Status_OK ;
+            PairList_ReallocatePartners ( self, capacity1 * capacity2, &localStatus ) ;
             for ( s = 0 ; s < capacity1 ; s++ )
             {
-                record = PairRecord_FromIndices ( indices1[s], capacity2, indices2, &localStatus ) ;
-                PairList_Append ( self, record, &localStatus ) ;
+                PairList_Append ( self, indices1[s], capacity2, indices2, &localStatus ) ;
                 isOK = Status_IsValueOK ( localStatus ) ;
                 if ( ! isOK ) break ;
             }
@@ -546,12 +628,10 @@ extern PairList *CrossPairList_MakeFullExcluded ( const Integer    capacity1
         isOK = ( indices1 != NULL ) && ( indices2 != NULL ) && ( self->excluded != NULL ) ;
         if ( isOK )
         {
-            auto PairRecord *record ;
-            auto Status      localStatus = Status_OK ;
+            auto Status localStatus = Status_OK ;
             for ( s = 0 ; s < capacity1 ; s++ )
             {
-                record = PairRecord_FromIndices ( indices1[s], 0, NULL, &localStatus ) ;
-                PairList_Append ( self, record, &localStatus ) ;
+                PairList_Append ( self, indices1[s], 0, NULL, &localStatus ) ;
                 isOK = Status_IsValueOK ( localStatus ) ;
                 if ( ! isOK ) break ;
             }
@@ -670,17 +750,15 @@ PairConnections *SelfPairList_MakeConnections ( PairList *self, const Integer up
             itemsN      = Integer_Allocate        ( upper,                          status ) ;
             if ( ( connections != NULL ) && ( itemsN != NULL ) )
             {
-                auto Integer     i, j, m, n, r ;
-                auto PairRecord *pairRecord ;
+                auto Integer i, j, m, n, r ;
                 Integer_Set ( connections->itemsI, connections->capacityI + 1, 0 ) ;
                 Integer_Set (              itemsN, connections->capacityI    , 0 ) ;
                 for ( r = 0 ; r < self->count ; r++ )
                 {
-                    pairRecord = self->records[r]  ;
-                    i          = pairRecord->index ;
-       	            for ( m = 0 ; m < pairRecord->capacity ; m++ )
+                    i = PairList_RecordIndex ( self, r ) ;
+       	            for ( m = self->offsets[r] ; m < self->offsets[r+1] ; m++ )
 	            {
-	                j          = pairRecord->indices[m] ;
+	                j          = self->partners[m] ;
                         itemsN[i] += 1 ;
                         itemsN[j] += 1 ;
                     }
@@ -693,11 +771,10 @@ PairConnections *SelfPairList_MakeConnections ( PairList *self, const Integer up
                 }
                 for ( r = 0 ; r < self->count ; r++ )
                 {
-                    pairRecord = self->records[r]  ;
-                    i          = pairRecord->index ;
-       	            for ( m = 0 ; m < pairRecord->capacity ; m++ )
+                    i = PairList_RecordIndex ( self, r ) ;
+       	            for ( m = self->offsets[r] ; m < self->offsets[r+1] ; m++ )
 	            {
-	                j = pairRecord->indices[m] ;
+	                j = self->partners[m] ;
                         connections->itemsJ[connections->itemsI[i]+itemsN[i]] = j ;
                         connections->itemsJ[connections->itemsI[j]+itemsN[j]] = i ;
                         itemsN[i] += 1 ;
@@ -725,21 +802,11 @@ void SelfPairList_Renumber ( PairList  *self    ,
         IntegerBlock *positions = Selection_MakePositions ( mapping, upper, status ) ;
         if ( positions != NULL )
         {
-            auto Integer     i, j, m, r ;
-            auto Integer    *indices ;
-            auto PairRecord *record  ;
+            auto Integer  m, r ;
+            auto Integer *indices ;
             indices = Block_Items ( positions ) ;
-            for ( r = 0 ; r < self->count ; r++ )
-            {
-                record = self->records[r]  ;
-                i      = record->index ;
-                record->index = indices[i] ;
-       	        for ( m = 0 ; m < record->capacity ; m++ )
-	        {
-	            j = record->indices[m] ;
-                    record->indices[m] = indices[j] ;
-                }
-            }
+            for ( r = 0 ; r < self->count                 ; r++ ) self->indices [r] = indices[self->indices [r]] ;
+            for ( m = 0 ; m < self->offsets[self->count] ; m++ ) self->partners[m] = indices[self->partners[m]] ;
         }
     }
 }
@@ -773,9 +840,8 @@ PairList *SelfPairList_ToCrossPairList ( PairList  *self          ,
         isOK = ( and1 != NULL ) && ( and2 != NULL ) && ( indices != NULL ) && ( new != NULL ) && ( ( ! orTest ) || ( orTest && ( or != NULL ) ) ) ;
         if ( isOK )
         {
-            auto Integer     count, i, j, m, n ;
-            auto PairRecord *record ;
-            auto Status      localStatus = Status_OK ;
+            auto Integer count, i, j, m, n ;
+            auto Status  localStatus = Status_OK ;
             /* . Iterate over the list. */
             for ( i = 0 ; i < Minimum ( connections->capacityI, upper ) ; i++ )
             {
@@ -802,9 +868,8 @@ PairList *SelfPairList_ToCrossPairList ( PairList  *self          ,
                     /* . Save the data. */
                     if ( count > 0 )
                     {
-                        record = PairRecord_FromIndices ( i, count, indices, &localStatus ) ;
-                        PairRecord_Sort ( record ) ;
-                        PairList_Append ( new, record, &localStatus ) ;
+                        Integer_Sort    ( indices, count ) ;
+                        PairList_Append ( new, i, count, indices, &localStatus ) ;
                         isOK = Status_IsValueOK ( localStatus ) ;
                         if ( ! isOK ) break ;
                     }
@@ -856,9 +921,8 @@ PairList *SelfPairList_ToCrossPairListExcluded ( PairList  *self          ,
                ( ( ! orTest ) || ( orTest && ( or != NULL ) ) ) ;
         if ( isOK )
         {
-            auto Integer     count, i, j, m, n, r ;
-            auto PairRecord *record ;
-            auto Status      localStatus = Status_OK ;
+            auto Integer count, i, j, m, n, r ;
+            auto Status  localStatus = Status_OK ;
             for ( r = 0 ; r < capacity1 ; r++ )
             {
                 i = indices1[r] ;
@@ -882,8 +946,7 @@ PairList *SelfPairList_ToCrossPairListExcluded ( PairList  *self          ,
                 count = Integer_SortUnique ( indices, n ) ;
                 if ( count < capacity2 )
                 {
-                    record = PairRecord_FromIndices ( i, count, indices, &localStatus ) ;
-                    PairList_Append ( new, record, &localStatus ) ;
+                    PairList_Append ( new, i, count, indices, &localStatus ) ;
                     isOK = Status_IsValueOK ( localStatus ) ;
                     if ( ! isOK ) break ;
                 }
@@ -925,20 +988,18 @@ PairList *SelfPairList_ToSelfPairList ( PairList  *self         ,
         isOK = ( and != NULL ) && ( indices != NULL ) && ( new != NULL ) && ( ( ! orTest ) || ( orTest && ( or != NULL ) ) ) ;
         if ( isOK )
         {
-            auto Integer     count, i, j, m, n, r ;
-            auto PairRecord *newRecord, *oldRecord ;
-            auto Status      localStatus = Status_OK ;
+            auto Integer count, i, j, m, n, r ;
+            auto Status  localStatus = Status_OK ;
             /* . Iterate over the list. */
             for ( r = 0 ; r < self->count ; r++ )
             {
-                oldRecord = self->records[r] ;
-                i = oldRecord->index ;
+                i = PairList_RecordIndex ( self, r ) ;
                 if ( and[i] )
                 {
                     /* . Loop over the indices. */
-       	            for ( m = n = 0 ; m < oldRecord->capacity ; m++ )
+       	            for ( m = self->offsets[r], n = 0 ; m < self->offsets[r+1] ; m++ )
 	            {
-                        j = oldRecord->indices[m] ;
+                        j = self->partners[m] ;
                         if ( and[j] ) { indices[n] = j ; n++ ; }
                     }
                     count = n ;
@@ -956,9 +1017,8 @@ PairList *SelfPairList_ToSelfPairList ( PairList  *self         ,
                     /* . Save the data. */
                     if ( count > 0 )
                     {
-                        newRecord = PairRecord_FromIndices ( i, count, indices, &localStatus ) ;
-                        PairRecord_Sort ( newRecord ) ;
-                        PairList_Append ( new, newRecord, &localStatus ) ;
+                        Integer_Sort    ( indices, count ) ;
+                        PairList_Append ( new, i, count, indices, &localStatus ) ;
                         isOK = Status_IsValueOK ( localStatus ) ;
                         if ( ! isOK ) break ;
                    }
@@ -1007,9 +1067,8 @@ PairList *SelfPairList_ToSelfPairListExcluded ( PairList  *self         ,
                ( ( ! orTest ) || ( orTest && ( or != NULL ) ) ) ;
         if ( isOK )
         {
-            auto Integer     count, i, j, m, n, p = 0, r ;
-            auto PairRecord *record ;
-            auto Status      localStatus = Status_OK ;
+            auto Integer count, i, j, m, n, p = 0, r ;
+            auto Status  localStatus = Status_OK ;
             for ( r = 0 ; r < capacity ; r++ )
             {
                 i = indices[r] ;
@@ -1034,8 +1093,7 @@ PairList *SelfPairList_ToSelfPairListExcluded ( PairList  *self         ,
                 if ( count < r ) /* . The maximum number of interactions for i is r. */
                 {
                     p     += r ;
-                    record = PairRecord_FromIndices ( i, count, indicesE, &localStatus ) ;
-                    PairList_Append ( new, record, &localStatus ) ;
+                    PairList_Append ( new, i, count, indicesE, &localStatus ) ;
                     isOK = Status_IsValueOK ( localStatus ) ;
                     if ( ! isOK ) break ;
                 }
@@ -1066,6 +1124,7 @@ void PairListIterator_Initialize ( PairListIterator *self, PairList *target )
     {
         self->current = 0    ;
         self->target  = NULL ;
+        PairRecord_Initialize ( &(self->record) ) ;
         if ( ( target != NULL ) && ( target->count > 0 ) ) self->target = target ;
     }
 }
@@ -1073,6 +1132,7 @@ void PairListIterator_Initialize ( PairListIterator *self, PairList *target )
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Next iteration.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The returned record is a view that is valid until the next call. */
 PairRecord *PairListIterator_Next ( PairListIterator *self )
 {
     PairRecord *next = NULL ;
@@ -1080,7 +1140,7 @@ PairRecord *PairListIterator_Next ( PairListIterator *self )
     {
         if ( self->current < self->target->count )
         {
-            next = PairList_GetRecord ( self->target, self->current ) ; /* self->target->records[self->current] ; */
+            next = PairList_GetRecord ( self->target, self->current, &(self->record) ) ;
             self->current += 1 ;
         }
     }
@@ -1090,56 +1150,6 @@ PairRecord *PairListIterator_Next ( PairListIterator *self )
 /*==================================================================================================================================
 ! . Pair record functions.
 !=================================================================================================================================*/
-/*----------------------------------------------------------------------------------------------------------------------------------
-! . Allocation.
-!---------------------------------------------------------------------------------------------------------------------------------*/
-PairRecord *PairRecord_Allocate ( const Integer capacity, Status *status )
-{
-    PairRecord *self = NULL ;
-    if ( Status_IsOK ( status ) )
-    {
-        self = Memory_AllocateType ( PairRecord ) ;
-        if ( self != NULL )
-        {
-            PairRecord_Initialize ( self ) ;
-            if ( capacity > 0 )
-            {
-                self->indices = Integer_Allocate ( capacity, status ) ;
-                if ( self->indices == NULL ) PairRecord_Deallocate ( &self ) ;
-                else self->capacity = capacity ;
-            }
-            if ( self == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
-        }
-    }
-    return self ;
-}
-
-/*----------------------------------------------------------------------------------------------------------------------------------
-! . Deallocation.
-!---------------------------------------------------------------------------------------------------------------------------------*/
-void PairRecord_Deallocate ( PairRecord **self )
-{
-    if ( (*self) != NULL )
-    {
-        Integer_Deallocate ( &((*self)->indices) ) ;
-        Memory_Deallocate   (   (*self)           ) ;
-    }
-}
-
-/*----------------------------------------------------------------------------------------------------------------------------------
-! . Constructor from indices.
-!---------------------------------------------------------------------------------------------------------------------------------*/
-PairRecord *PairRecord_FromIndices ( const Integer index, const Integer capacity, const Integer *indices, Status *status )
-{
-    PairRecord *self = PairRecord_Allocate ( capacity, status ) ;
-    if ( self != NULL )
-    {
-        Integer_CopyTo ( indices, capacity, self->indices, NULL ) ;
-        self->index = index ;
-    }
-    return self ;
-}
-
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Initialization.
 !---------------------------------------------------------------------------------------------------------------------------------*/
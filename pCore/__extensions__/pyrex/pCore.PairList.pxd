@@ -24,7 +24,9 @@ cdef extern from "PairList.h":
     cdef CPairList           *PairList_Allocate                    ( CInteger           capacity      ,
                                                                      CStatus           *status        )
     cdef void                 PairList_Append                      ( CPairList         *self          ,
-                                                                     CPairRecord       *record        ,
+                                                                     CInteger           index         ,
+                                                                     CInteger           capacity      ,
+                                                                     CInteger          *partners      ,
                                                                      CStatus           *status        )
     cdef void                 PairList_Deallocate                  ( CPairList        **self          )
     cdef CInteger             PairList_NumberOfPairs               ( CPairList         *self          )
@@ -70,11 +72,6 @@ cdef extern from "PairList.h":
                                                                      CPairList         *target        )
     cdef CPairRecord         *PairListIterator_Next                ( CPairListIterator *self          )
 
-    cdef CPairRecord         *PairRecord_FromIndices               ( CInteger           index         ,
-                                                                     CInteger           capacity      ,
-                                                                     CInteger          *indices       ,
-                                                                     CStatus           *status        )
-
 #===================================================================================================================================
 # . Class and subclasses.
 #===================================================================================================================================
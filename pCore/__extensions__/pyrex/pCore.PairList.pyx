@@ -62,10 +62,9 @@ cdef class PairList:
 
     def _CObjectFromIndexPairs ( self, indices ):
         """Make a list from a list of index pairs."""
-        cdef CInteger     i, m, maximumJ, n, numberI
-        cdef CInteger    *cIndices
-        cdef CPairRecord *cRecord
-        cdef CStatus      cStatus = CStatus_OK
+        cdef CInteger  i, m, maximumJ, n, numberI
+        cdef CInteger *cIndices
+        cdef CStatus   cStatus = CStatus_OK
         PairList_Deallocate ( &self.cObject )
         if len ( indices ) > 0:
             if len ( indices ) % 2 != 0: raise CoreError ( "Odd number of items in index pair-list." )
@@ -78,8 +77,7 @@ cdef class PairList:
                     js = records[i]
                     n  = len ( js )
                     for m from 0 <= m < n: cIndices[m] = js[m]
-                    cRecord = PairRecord_FromIndices ( i, n, cIndices, &cStatus )
-                    PairList_Append ( self.cObject, cRecord, &cStatus )
+                    PairList_Append ( self.cObject, i, n, cIndices, &cStatus )
                     if cStatus != CStatus_OK: break
                 Integer_Deallocate ( &cIndices )
             if cStatus != CStatus_OK:
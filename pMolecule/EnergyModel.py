@@ -89,6 +89,13 @@ class EnergyModel ( SummarizableObject ):
         """Return energy closures."""
         return []
 
+    def FastEnergyClosureLabels ( self, target ):
+        """Return the labels of the energy closures that are cheap to evaluate and that vary rapidly.
+
+        These closures are evaluated on each inner step of a multiple-time-step integrator.
+        """
+        return set ( )
+
     def UnbuildModel ( self, target ):
         """Unbuild the model."""
         self.ClearScratch ( target.scratch )
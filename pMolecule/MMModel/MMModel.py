@@ -354,6 +354,10 @@ class MMModel ( EnergyModel ):
             closures.extend ( mmTerm.EnergyClosures ( target ) )
         return closures
 
+    def FastEnergyClosureLabels ( self, target ):
+        """Return the labels of the fast energy closures (all MM terms)."""
+        return set ( label for ( priority, closure, label ) in self.EnergyClosures ( target ) )
+
     @classmethod
     def Merge ( selfClass, entries, information = {} ):
         """Merging."""
@@ -29,12 +29,27 @@ typedef struct {
     Integer type     ;
 } CMAPDihedral ;
 
+/* . The patch table holds the bicubic coefficients of all parameters in a single flat array with 16 coefficients per patch.
+!    Each parameter's grid is periodic and uniform so that the patch containing a point is found by direct indexing. */
+typedef struct {
+    Integer  nParameters  ;
+    Integer *lengthX      ; /* . Number of patches along each axis. */
+    Integer *lengthY      ;
+    Integer *offsets      ; /* . The index of the first coefficient of each parameter. */
+    Real    *lowerX       ;
+    Real    *lowerY       ;
+    Real    *widthX       ; /* . Patch widths. */
+    Real    *widthY       ;
+    Real    *coefficients ;
+} CMAPPatchTable ;
+
 typedef struct {
     Boolean         isSorted    ;
     Integer         nParameters ;
     Integer         nTerms      ;
     CMAPDihedral   *terms       ;
     BicubicSpline **parameters  ;
+    CMAPPatchTable *patchTable  ;
 } CMAPDihedralContainer ;
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -46,6 +61,7 @@ extern CMAPDihedralContainer *CMAPDihedralContainer_Clone                 ( cons
 extern void                   CMAPDihedralContainer_DeactivateTerms       (       CMAPDihedralContainer  *self, Selection *selection ) ;
 extern void                   CMAPDihedralContainer_Deallocate            (       CMAPDihedralContainer **self ) ;
 extern Real                   CMAPDihedralContainer_Energy                ( const CMAPDihedralContainer  *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
+extern void                   CMAPDihedralContainer_MakePatchTable        (       CMAPDihedralContainer  *self ) ;
 extern CMAPDihedralContainer *CMAPDihedralContainer_Merge                 ( const CMAPDihedralContainer  *self, const CMAPDihedralContainer *other, const int atomincrement ) ;
 extern Integer                CMAPDihedralContainer_NumberOfInactiveTerms ( const CMAPDihedralContainer  *self ) ;
 extern CMAPDihedralContainer *CMAPDihedralContainer_Prune                 (       CMAPDihedralContainer  *self, Selection *selection ) ;
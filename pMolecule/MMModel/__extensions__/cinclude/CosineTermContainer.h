@@ -9,12 +9,23 @@
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Definitions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The execution plan holds the active terms only, ordered by their largest index and with their parameters gathered. */
+/* . The indices are stored term by term with nIndices per term. */
+typedef struct {
+    Integer   nIndices          ;
+    Integer   nTerms            ;
+    Integer  *indices           ;
+    Integer  *nPowers           ;
+    Real    **powerCoefficients ;
+} CosineTermPlan ;
+
 typedef struct {
     Integer          nIndices    ;
     Integer          nParameters ;
     Integer          nTerms      ;
     CosineParameter *parameters  ;
     CosineTerm      *terms       ;
+    CosineTermPlan  *plan        ;
 } CosineTermContainer ;
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -29,10 +40,13 @@ extern void                 CosineTermContainer_DeactivateTerms       (       Co
                                                                               Selection            *selection     ) ;
 extern void                 CosineTermContainer_Deallocate            (       CosineTermContainer **self          ) ;
 extern Integer              CosineTermContainer_FindMaximumPeriod     (       CosineTermContainer  *self          ) ;
+extern void                 CosineTermContainer_MakePlan              (       CosineTermContainer  *self          ) ;
 extern void                 CosineTermContainer_MakePowers            (       CosineTermContainer  *self          ) ;
 extern Integer              CosineTermContainer_NumberOfInactiveTerms ( const CosineTermContainer  *self          ) ;
 extern CosineTermContainer *CosineTermContainer_Prune                 (       CosineTermContainer  *self          ,
                                                                               Selection            *selection     ) ;
 extern Integer              CosineTermContainer_UpperBound            (       CosineTermContainer  *self          ) ;
+extern void                 CosineTermPlan_Deallocate                 (       CosineTermPlan      **self          ) ;
+extern CosineTermPlan      *CosineTermPlan_Make                       ( const CosineTermContainer  *self          ) ;
 
 # endif
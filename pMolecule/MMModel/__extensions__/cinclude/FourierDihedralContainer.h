@@ -34,12 +34,26 @@ typedef struct {
     Real    sinphase ;
 } FourierDihedralParameter ;
 
+/* . The execution plan holds the active terms only, in sorted order and with their parameters gathered. */
+typedef struct {
+    Integer  nTerms   ;
+    Integer *atom1    ;
+    Integer *atom2    ;
+    Integer *atom3    ;
+    Integer *atom4    ;
+    Integer *period   ;
+    Real    *fc       ;
+    Real    *cosphase ;
+    Real    *sinphase ;
+} FourierDihedralPlan ;
+
 typedef struct {
     Boolean                   isSorted    ;
     Integer                   nParameters ;
     Integer                   nTerms      ;
     FourierDihedral          *terms       ;
     FourierDihedralParameter *parameters  ;
+    FourierDihedralPlan      *plan        ;
 } FourierDihedralContainer ;
 
 /*------------------------------------------------------------------------------
@@ -52,6 +66,7 @@ extern void                      FourierDihedralContainer_DeactivateTerms
 extern void                      FourierDihedralContainer_Deallocate            (       FourierDihedralContainer **self ) ;
 extern Real                      FourierDihedralContainer_Energy                ( const FourierDihedralContainer  *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
 extern void                      FourierDihedralContainer_FillCosSinPhases      (       FourierDihedralContainer  *self ) ;
+extern void                      FourierDihedralContainer_MakePlan              (       FourierDihedralContainer  *self ) ;
 extern FourierDihedralContainer *FourierDihedralContainer_Merge                 ( const FourierDihedralContainer  *self, const FourierDihedralContainer *other, const Integer atomincrement ) ;
 extern Integer                   FourierDihedralContainer_NumberOfInactiveTerms ( const FourierDihedralContainer  *self ) ;
 extern FourierDihedralContainer *FourierDihedralContainer_Prune                 (       FourierDihedralContainer  *self, Selection *selection ) ;
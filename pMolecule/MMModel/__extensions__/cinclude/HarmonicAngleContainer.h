@@ -23,12 +23,23 @@ typedef struct {
     Real fc ;
 } HarmonicAngleParameter ;
 
+/* . The execution plan holds the active terms only, in sorted order and with their parameters gathered. */
+typedef struct {
+    Integer  nTerms ;
+    Integer *atom1  ;
+    Integer *atom2  ;
+    Integer *atom3  ;
+    Real    *eq     ;
+    Real    *fc     ;
+} HarmonicAnglePlan ;
+
 typedef struct {
     Boolean                 isSorted    ;
     Integer                 nParameters ;
     Integer                 nTerms      ;
     HarmonicAngle          *terms       ;
     HarmonicAngleParameter *parameters  ;
+    HarmonicAnglePlan      *plan        ;
 } HarmonicAngleContainer ;
 
 /*------------------------------------------------------------------------------
@@ -40,6 +51,7 @@ extern HarmonicAngleContainer *HarmonicAngleContainer_Clone                 ( co
 extern void                    HarmonicAngleContainer_DeactivateTerms       (       HarmonicAngleContainer  *self, Selection *selection ) ;
 extern void                    HarmonicAngleContainer_Deallocate            (       HarmonicAngleContainer **self ) ;
 extern Real                    HarmonicAngleContainer_Energy                ( const HarmonicAngleContainer  *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
+extern void                    HarmonicAngleContainer_MakePlan              (       HarmonicAngleContainer  *self ) ;
 extern HarmonicAngleContainer *HarmonicAngleContainer_Merge                 ( const HarmonicAngleContainer  *self, const HarmonicAngleContainer *other, const Integer atomincrement ) ;
 extern Integer                 HarmonicAngleContainer_NumberOfInactiveTerms ( const HarmonicAngleContainer  *self ) ;
 extern HarmonicAngleContainer *HarmonicAngleContainer_Prune                 (       HarmonicAngleContainer  *self, Selection *selection ) ;
@@ -22,12 +22,22 @@ typedef struct {
     Real fc ;
 } HarmonicBondParameter ;
 
+/* . The execution plan holds the active terms only, in sorted order and with their parameters gathered. */
+typedef struct {
+    Integer  nTerms ;
+    Integer *atom1  ;
+    Integer *atom2  ;
+    Real    *eq     ;
+    Real    *fc     ;
+} HarmonicBondPlan ;
+
 typedef struct {
     Boolean                isSorted    ;
     Integer                nParameters ;
     Integer                nTerms      ;
     HarmonicBond          *terms       ;
     HarmonicBondParameter *parameters  ;
+    HarmonicBondPlan      *plan        ;
 } HarmonicBondContainer ;
 
 /*------------------------------------------------------------------------------
@@ -40,6 +50,7 @@ extern void                   HarmonicBondContainer_DeactivateTerms       (
 extern void                   HarmonicBondContainer_Deallocate            (       HarmonicBondContainer **self ) ;
 extern Real                   HarmonicBondContainer_Energy                ( const HarmonicBondContainer  *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
 extern Integer                HarmonicBondContainer_IdentifyBoundaryAtoms (       HarmonicBondContainer  *self, Selection *qcAtoms, Integer **mmboundary, Integer **qcpartners ) ;
+extern void                   HarmonicBondContainer_MakePlan              (       HarmonicBondContainer  *self ) ;
 extern HarmonicBondContainer *HarmonicBondContainer_Merge                 ( const HarmonicBondContainer  *self, const HarmonicBondContainer *other, const Integer atomincrement ) ;
 extern Integer                HarmonicBondContainer_NumberOfInactiveTerms ( const HarmonicBondContainer  *self ) ;
 extern HarmonicBondContainer *HarmonicBondContainer_Prune                 (       HarmonicBondContainer  *self, Selection *selection ) ;
@@ -33,12 +33,25 @@ typedef struct {
     Real sineq ;
 } HarmonicImproperParameter ;
 
+/* . The execution plan holds the active terms only, in sorted order and with their parameters gathered. */
+typedef struct {
+    Integer  nTerms ;
+    Integer *atom1  ;
+    Integer *atom2  ;
+    Integer *atom3  ;
+    Integer *atom4  ;
+    Real    *fc     ;
+    Real    *coseq  ;
+    Real    *sineq  ;
+} HarmonicImproperPlan ;
+
 typedef struct {
     Boolean                    isSorted    ;
     Integer                    nParameters ;
     Integer                    nTerms      ;
     HarmonicImproper          *terms       ;
     HarmonicImproperParameter *parameters  ;
+    HarmonicImproperPlan      *plan        ;
 } HarmonicImproperContainer ;
 
 /*------------------------------------------------------------------------------
@@ -51,6 +64,7 @@ extern void                       HarmonicImproperContainer_DeactivateTerms
 extern void                       HarmonicImproperContainer_Deallocate            (       HarmonicImproperContainer **self ) ;
 extern Real                       HarmonicImproperContainer_Energy                ( const HarmonicImproperContainer  *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
 extern void                       HarmonicImproperContainer_FillCosSinValues      (       HarmonicImproperContainer  *self ) ;
+extern void                       HarmonicImproperContainer_MakePlan              (       HarmonicImproperContainer  *self ) ;
 extern HarmonicImproperContainer *HarmonicImproperContainer_Merge                 ( const HarmonicImproperContainer  *self, const HarmonicImproperContainer *other, const Integer atomincrement ) ;
 extern Integer                    HarmonicImproperContainer_NumberOfInactiveTerms ( const HarmonicImproperContainer  *self ) ;
 extern HarmonicImproperContainer *HarmonicImproperContainer_Prune                 (       HarmonicImproperContainer  *self, Selection *selection ) ;
@@ -12,7 +12,12 @@
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Local procedures.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static Integer CMAPDihedralTerm_Compare ( const void *vTerm1, const void *vTerm2 ) ;
+static CMAPPatchTable *CMAPPatchTable_Allocate   ( const Integer nParameters, const Integer nPatches ) ;
+static void            CMAPPatchTable_Deallocate ( CMAPPatchTable **self ) ;
+static void            CMAPPatchTable_Evaluate   ( const CMAPPatchTable *self, const Integer t, const Real x, const Real y, Real *f, Real *g1, Real *g2 ) ;
+static Boolean         CMAPPatchTable_IsUniform  ( const RealArray1D *abscissa ) ;
+static CMAPPatchTable *CMAPPatchTable_Make       ( const CMAPDihedralContainer *self ) ;
+static Integer         CMAPDihedralTerm_Compare  ( const void *vTerm1, const void *vTerm2 ) ;
 
 /*==================================================================================================================================
 ! . Procedures.
@@ -48,6 +53,7 @@ CMAPDihedralContainer *CMAPDihedralContainer_Allocate ( const Integer nTerms, co
 	for ( i = 0 ; i < nTerms ; i++ ) self->terms[i].isActive = False ;
         /* . Nullify parameters. */
         for ( i = 0 ; i < nParameters ; i++ ) self->parameters[i] = NULL ;
+        self->patchTable = NULL ;
     }
     return self ;
 }
@@ -77,6 +83,7 @@ CMAPDihedralContainer *CMAPDihedralContainer_Clone ( const CMAPDihedralContainer
         }
         for ( i = 0 ; i < self->nParameters ; i++ ) new->parameters[i] = BicubicSpline_Clone ( self->parameters[i], NULL ) ;
         new->isSorted = self->isSorted ;
+        CMAPDihedralContainer_MakePatchTable ( new ) ;
     }
     return new ;
 }
@@ -119,6 +126,7 @@ void CMAPDihedralContainer_Deallocate ( CMAPDihedralContainer **self )
     {
         auto Integer i ;
         for ( i = 0 ; i < (*self)->nParameters ; i++ ) BicubicSpline_Deallocate ( &((*self)->parameters[i]) ) ;
+        CMAPPatchTable_Deallocate ( &((*self)->patchTable) ) ;
         Memory_Deallocate ( (*self)->terms      ) ;
         Memory_Deallocate ( (*self)->parameters ) ;
         Memory_Deallocate ( (*self) ) ;
@@ -128,6 +136,8 @@ void CMAPDihedralContainer_Deallocate ( CMAPDihedralContainer **self )
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Energy and gradients.
 ! . Following Becker, Berendsen and van Gunsteren, JCC 16 p527 (1995).
+! . The gradients of each thread are accumulated in separate buffers.
+! . The splines are evaluated from the patch table when there is one.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 # define LOWCOSPHI 0.5e+00
 Real CMAPDihedralContainer_Energy ( const CMAPDihedralContainer *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
@@ -135,99 +145,112 @@ Real CMAPDihedralContainer_Energy ( const CMAPDihedralContainer *self, const Coo
     Real energy = 0.0e+00 ;
     if ( ( self != NULL ) && ( coordinates3 != NULL ) )
     {
-	auto Boolean doGradients ;
-        auto Integer i1, i2, j1, j2, k1, k2, l1, l2, n, t ;
-        auto Real    cosPhi, dotij, dotlk, dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, e, mn, sinPhi, sx, sy, sz ;
-        auto Real    df1, m21, mx1, my1, mz1, n21, nx1, ny1, nz1, phi1, rkj1, rkj21, xij1, yij1, zij1, xkj1, ykj1, zkj1, xlk1, ylk1, zlk1 ;
-        auto Real    df2, m22, mx2, my2, mz2, n22, nx2, ny2, nz2, phi2, rkj2, rkj22, xij2, yij2, zij2, xkj2, ykj2, zkj2, xlk2, ylk2, zlk2 ;
-	doGradients = ( gradients3 != NULL ) ;
-	for ( n = 0 ; n < self->nTerms ; n++ )
-	{
-	    if ( self->terms[n].isActive )
-	    {
-                /* . Local data. */
-	        i1 = self->terms[n].atom1 ;
-	        j1 = self->terms[n].atom2 ;
-	        k1 = self->terms[n].atom3 ;
-	        l1 = self->terms[n].atom4 ;
-	        i2 = self->terms[n].atom5 ;
-	        j2 = self->terms[n].atom6 ;
-	        k2 = self->terms[n].atom7 ;
-	        l2 = self->terms[n].atom8 ;
-	        t  = self->terms[n].type  ;
-                /* . First dihedral. */
-	        /* . Coordinate displacements. */
-	        Coordinates3_DifferenceRow ( coordinates3, i1, j1, xij1, yij1, zij1 ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, k1, j1, xkj1, ykj1, zkj1 ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, l1, k1, xlk1, ylk1, zlk1 ) ;
-	        rkj21 = xkj1 * xkj1 + ykj1 * ykj1 + zkj1 * zkj1 ;
-	        rkj1  = sqrt ( rkj21 ) ;
-                /* . m and n. */
-                mx1 = yij1 * zkj1 - zij1 * ykj1 ;
-	        my1 = zij1 * xkj1 - xij1 * zkj1 ;
-	        mz1 = xij1 * ykj1 - yij1 * xkj1 ;
-	        nx1 = ylk1 * zkj1 - zlk1 * ykj1 ;
-	        ny1 = zlk1 * xkj1 - xlk1 * zkj1 ;
-	        nz1 = xlk1 * ykj1 - ylk1 * xkj1 ;
-                m21 = mx1 * mx1 + my1 * my1 + mz1 * mz1 ;
-	        n21 = nx1 * nx1 + ny1 * ny1 + nz1 * nz1 ;
-	        mn  = sqrt ( m21 * n21 ) ;
-                /* . Cosine and sine of the dihedral. */
-                cosPhi =        (  mx1 * nx1 +  my1 * ny1 +  mz1 * nz1 ) / mn ;
-                sinPhi = rkj1 * ( xij1 * nx1 + yij1 * ny1 + zij1 * nz1 ) / mn ;
-                /* . Dihedral - follow CHARMM. */
-                if ( ( cosPhi < -LOWCOSPHI ) || ( cosPhi > LOWCOSPHI ) )
+        auto Boolean  doGradients ;
+        auto Integer  numberOfThreads ;
+        auto Real    *buffers ;
+        doGradients = ( gradients3 != NULL ) ;
+        buffers     = Coordinates3_AllocateThreadBuffersForWork ( gradients3, self->nTerms, &numberOfThreads ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
+        {
+            auto Coordinates3 view, *threadGradients3 ;
+            auto Integer i1, i2, j1, j2, k1, k2, l1, l2, n, t ;
+            auto Real    cosPhi, dotij, dotlk, dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, e, mn, sinPhi, sx, sy, sz ;
+            auto Real    df1, m21, mx1, my1, mz1, n21, nx1, ny1, nz1, phi1, rkj1, rkj21, xij1, yij1, zij1, xkj1, ykj1, zkj1, xlk1, ylk1, zlk1 ;
+            auto Real    df2, m22, mx2, my2, mz2, n22, nx2, ny2, nz2, phi2, rkj2, rkj22, xij2, yij2, zij2, xkj2, ykj2, zkj2, xlk2, ylk2, zlk2 ;
+            threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, buffers, &view ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( static )
+# endif
+            for ( n = 0 ; n < self->nTerms ; n++ )
+            {
+                if ( self->terms[n].isActive )
                 {
-                    phi1 = asin ( sinPhi ) ;
-                    if ( cosPhi < 0.0e+00 )
+                    /* . Local data. */
+                    i1 = self->terms[n].atom1 ;
+                    j1 = self->terms[n].atom2 ;
+                    k1 = self->terms[n].atom3 ;
+                    l1 = self->terms[n].atom4 ;
+                    i2 = self->terms[n].atom5 ;
+                    j2 = self->terms[n].atom6 ;
+                    k2 = self->terms[n].atom7 ;
+                    l2 = self->terms[n].atom8 ;
+                    t  = self->terms[n].type  ;
+                    /* . First dihedral. */
+                    /* . Coordinate displacements. */
+                    Coordinates3_DifferenceRow ( coordinates3, i1, j1, xij1, yij1, zij1 ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, k1, j1, xkj1, ykj1, zkj1 ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, l1, k1, xlk1, ylk1, zlk1 ) ;
+                    rkj21 = xkj1 * xkj1 + ykj1 * ykj1 + zkj1 * zkj1 ;
+                    rkj1  = sqrt ( rkj21 ) ;
+                    /* . m and n. */
+                    mx1 = yij1 * zkj1 - zij1 * ykj1 ;
+                    my1 = zij1 * xkj1 - xij1 * zkj1 ;
+                    mz1 = xij1 * ykj1 - yij1 * xkj1 ;
+                    nx1 = ylk1 * zkj1 - zlk1 * ykj1 ;
+                    ny1 = zlk1 * xkj1 - xlk1 * zkj1 ;
+                    nz1 = xlk1 * ykj1 - ylk1 * xkj1 ;
+                    m21 = mx1 * mx1 + my1 * my1 + mz1 * mz1 ;
+                    n21 = nx1 * nx1 + ny1 * ny1 + nz1 * nz1 ;
+                    mn  = sqrt ( m21 * n21 ) ;
+                    /* . Cosine and sine of the dihedral. */
+                    cosPhi =        (  mx1 * nx1 +  my1 * ny1 +  mz1 * nz1 ) / mn ;
+                    sinPhi = rkj1 * ( xij1 * nx1 + yij1 * ny1 + zij1 * nz1 ) / mn ;
+                    /* . Dihedral - follow CHARMM. */
+                    if ( ( cosPhi < -LOWCOSPHI ) || ( cosPhi > LOWCOSPHI ) )
                     {
-                        if ( phi1 > 0.0e+00 ) phi1 =     M_PI - phi1 ;
-                        else                  phi1 = - ( M_PI + phi1 ) ;
+                        phi1 = asin ( sinPhi ) ;
+                        if ( cosPhi < 0.0e+00 )
+                        {
+                            if ( phi1 > 0.0e+00 ) phi1 =     M_PI - phi1 ;
+                            else                  phi1 = - ( M_PI + phi1 ) ;
+                        }
                     }
-                }
-                else
-                {
-                    phi1 = acos ( cosPhi ) ;
-                    if ( sinPhi < 0.0e+00 ) phi1 *= -1.e+00 ;
-                }
-                /* . Second dihedral. */
-	        /* . Coordinate displacements. */
-	        Coordinates3_DifferenceRow ( coordinates3, i2, j2, xij2, yij2, zij2 ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, k2, j2, xkj2, ykj2, zkj2 ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, l2, k2, xlk2, ylk2, zlk2 ) ;
-	        rkj22 = xkj2 * xkj2 + ykj2 * ykj2 + zkj2 * zkj2 ;
-	        rkj2  = sqrt ( rkj22 ) ;
-                /* . m and n. */
-                mx2 = yij2 * zkj2 - zij2 * ykj2 ;
-	        my2 = zij2 * xkj2 - xij2 * zkj2 ;
-	        mz2 = xij2 * ykj2 - yij2 * xkj2 ;
-	        nx2 = ylk2 * zkj2 - zlk2 * ykj2 ;
-	        ny2 = zlk2 * xkj2 - xlk2 * zkj2 ;
-	        nz2 = xlk2 * ykj2 - ylk2 * xkj2 ;
-                m22 = mx2 * mx2 + my2 * my2 + mz2 * mz2 ;
-	        n22 = nx2 * nx2 + ny2 * ny2 + nz2 * nz2 ;
-	        mn  = sqrt ( m22 * n22 ) ;
-                /* . Cosine and sine of the dihedral. */
-                cosPhi =        (  mx2 * nx2 +  my2 * ny2 +  mz2 * nz2 ) / mn ;
-                sinPhi = rkj2 * ( xij2 * nx2 + yij2 * ny2 + zij2 * nz2 ) / mn ;
-                /* . Dihedral - follow CHARMM. */
-                if ( ( cosPhi < -LOWCOSPHI ) || ( cosPhi > LOWCOSPHI ) )
-                {
-                    phi2 = asin ( sinPhi ) ;
-                    if ( cosPhi < 0.0e+00 )
+                    else
                     {
-                        if ( phi2 > 0.0e+00 ) phi2 =     M_PI - phi2 ;
-                        else                  phi2 = - ( M_PI + phi2 ) ;
+                        phi1 = acos ( cosPhi ) ;
+                        if ( sinPhi < 0.0e+00 ) phi1 *= -1.e+00 ;
                     }
-                }
-                else
-                {
-                    phi2 = acos ( cosPhi ) ;
-                    if ( sinPhi < 0.0e+00 ) phi2 *= -1.e+00 ;
-                }
-                /* . The energy term. */
-                BicubicSpline_Evaluate ( self->parameters[t], phi1, phi2, &e, &df1, &df2, NULL ) ;
-                energy += e ;
+                    /* . Second dihedral. */
+                    /* . Coordinate displacements. */
+                    Coordinates3_DifferenceRow ( coordinates3, i2, j2, xij2, yij2, zij2 ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, k2, j2, xkj2, ykj2, zkj2 ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, l2, k2, xlk2, ylk2, zlk2 ) ;
+                    rkj22 = xkj2 * xkj2 + ykj2 * ykj2 + zkj2 * zkj2 ;
+                    rkj2  = sqrt ( rkj22 ) ;
+                    /* . m and n. */
+                    mx2 = yij2 * zkj2 - zij2 * ykj2 ;
+                    my2 = zij2 * xkj2 - xij2 * zkj2 ;
+                    mz2 = xij2 * ykj2 - yij2 * xkj2 ;
+                    nx2 = ylk2 * zkj2 - zlk2 * ykj2 ;
+                    ny2 = zlk2 * xkj2 - xlk2 * zkj2 ;
+                    nz2 = xlk2 * ykj2 - ylk2 * xkj2 ;
+                    m22 = mx2 * mx2 + my2 * my2 + mz2 * mz2 ;
+                    n22 = nx2 * nx2 + ny2 * ny2 + nz2 * nz2 ;
+                    mn  = sqrt ( m22 * n22 ) ;
+                    /* . Cosine and sine of the dihedral. */
+                    cosPhi =        (  mx2 * nx2 +  my2 * ny2 +  mz2 * nz2 ) / mn ;
+                    sinPhi = rkj2 * ( xij2 * nx2 + yij2 * ny2 + zij2 * nz2 ) / mn ;
+                    /* . Dihedral - follow CHARMM. */
+                    if ( ( cosPhi < -LOWCOSPHI ) || ( cosPhi > LOWCOSPHI ) )
+                    {
+                        phi2 = asin ( sinPhi ) ;
+                        if ( cosPhi < 0.0e+00 )
+                        {
+                            if ( phi2 > 0.0e+00 ) phi2 =     M_PI - phi2 ;
+                            else                  phi2 = - ( M_PI + phi2 ) ;
+                        }
+                    }
+                    else
+                    {
+                        phi2 = acos ( cosPhi ) ;
+                        if ( sinPhi < 0.0e+00 ) phi2 *= -1.e+00 ;
+                    }
+                    /* . The energy term. */
+                    if ( self->patchTable != NULL ) CMAPPatchTable_Evaluate ( self->patchTable, t, phi1, phi2, &e, &df1, &df2 ) ;
+                    else                            BicubicSpline_Evaluate  ( self->parameters[t], phi1, phi2, &e, &df1, &df2, NULL ) ;
+                    energy += e ;
 /*
 {
 auto Real em1, em2, ep1, ep2 ;
@@ -241,65 +264,80 @@ printf ( "\nDerivative 1 = %20.5f %20.5f %20.5f\n", df1, (ep1-em1)/(2.0e+00 * _S
 printf ( "\nDerivative 2 = %20.5f %20.5f %20.5f\n", df2, (ep2-em2)/(2.0e+00 * _STEP),fabs ( df2 - (ep2-em2)/(2.0e+00 * _STEP) ) ) ;
 }
 */
-                if ( doGradients )
-                {
-	            /* . The derivatives - first dihedral. */
-                    /* . i and l. */
-                    dtxi =   df1 * rkj1 * mx1 / m21 ;
-                    dtyi =   df1 * rkj1 * my1 / m21 ;
-                    dtzi =   df1 * rkj1 * mz1 / m21 ;
-                    dtxl = - df1 * rkj1 * nx1 / n21 ;
-                    dtyl = - df1 * rkj1 * ny1 / n21 ;
-                    dtzl = - df1 * rkj1 * nz1 / n21 ;
-                    /* . j and k. */
-                    dotij = xij1 * xkj1 + yij1 * ykj1 + zij1 * zkj1 ;
-                    dotlk = xlk1 * xkj1 + ylk1 * ykj1 + zlk1 * zkj1 ;
-	            sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj21 ;
-	            sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj21 ;
-	            sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj21 ;
-	            dtxj  =   sx - dtxi ;
-	            dtyj  =   sy - dtyi ;
-	            dtzj  =   sz - dtzi ;
-	            dtxk  = - sx - dtxl ;
-	            dtyk  = - sy - dtyl ;
-	            dtzk  = - sz - dtzl ;
-                    /* . Add in the contributions. */
-	            Coordinates3_IncrementRow ( gradients3, i1, dtxi, dtyi, dtzi ) ;
-	            Coordinates3_IncrementRow ( gradients3, j1, dtxj, dtyj, dtzj ) ;
-	            Coordinates3_IncrementRow ( gradients3, k1, dtxk, dtyk, dtzk ) ;
-	            Coordinates3_IncrementRow ( gradients3, l1, dtxl, dtyl, dtzl ) ;
-	            /* . The derivatives - second dihedral. */
-                    /* . i and l. */
-                    dtxi =   df2 * rkj2 * mx2 / m22 ;
-                    dtyi =   df2 * rkj2 * my2 / m22 ;
-                    dtzi =   df2 * rkj2 * mz2 / m22 ;
-                    dtxl = - df2 * rkj2 * nx2 / n22 ;
-                    dtyl = - df2 * rkj2 * ny2 / n22 ;
-                    dtzl = - df2 * rkj2 * nz2 / n22 ;
-                    /* . j and k. */
-                    dotij = xij2 * xkj2 + yij2 * ykj2 + zij2 * zkj2 ;
-                    dotlk = xlk2 * xkj2 + ylk2 * ykj2 + zlk2 * zkj2 ;
-	            sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj22 ;
-	            sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj22 ;
-	            sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj22 ;
-	            dtxj  =   sx - dtxi ;
-	            dtyj  =   sy - dtyi ;
-	            dtzj  =   sz - dtzi ;
-	            dtxk  = - sx - dtxl ;
-	            dtyk  = - sy - dtyl ;
-	            dtzk  = - sz - dtzl ;
-                    /* . Add in the contributions. */
-	            Coordinates3_IncrementRow ( gradients3, i2, dtxi, dtyi, dtzi ) ;
-	            Coordinates3_IncrementRow ( gradients3, j2, dtxj, dtyj, dtzj ) ;
-	            Coordinates3_IncrementRow ( gradients3, k2, dtxk, dtyk, dtzk ) ;
-	            Coordinates3_IncrementRow ( gradients3, l2, dtxl, dtyl, dtzl ) ;
-        	}
-	    }
-	}
+                    if ( doGradients )
+                    {
+                        /* . The derivatives - first dihedral. */
+                        /* . i and l. */
+                        dtxi =   df1 * rkj1 * mx1 / m21 ;
+                        dtyi =   df1 * rkj1 * my1 / m21 ;
+                        dtzi =   df1 * rkj1 * mz1 / m21 ;
+                        dtxl = - df1 * rkj1 * nx1 / n21 ;
+                        dtyl = - df1 * rkj1 * ny1 / n21 ;
+                        dtzl = - df1 * rkj1 * nz1 / n21 ;
+                        /* . j and k. */
+                        dotij = xij1 * xkj1 + yij1 * ykj1 + zij1 * zkj1 ;
+                        dotlk = xlk1 * xkj1 + ylk1 * ykj1 + zlk1 * zkj1 ;
+                        sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj21 ;
+                        sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj21 ;
+                        sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj21 ;
+                        dtxj  =   sx - dtxi ;
+                        dtyj  =   sy - dtyi ;
+                        dtzj  =   sz - dtzi ;
+                        dtxk  = - sx - dtxl ;
+                        dtyk  = - sy - dtyl ;
+                        dtzk  = - sz - dtzl ;
+                        /* . Add in the contributions. */
+                        Coordinates3_IncrementRow ( threadGradients3, i1, dtxi, dtyi, dtzi ) ;
+                        Coordinates3_IncrementRow ( threadGradients3, j1, dtxj, dtyj, dtzj ) ;
+                        Coordinates3_IncrementRow ( threadGradients3, k1, dtxk, dtyk, dtzk ) ;
+                        Coordinates3_IncrementRow ( threadGradients3, l1, dtxl, dtyl, dtzl ) ;
+                        /* . The derivatives - second dihedral. */
+                        /* . i and l. */
+                        dtxi =   df2 * rkj2 * mx2 / m22 ;
+                        dtyi =   df2 * rkj2 * my2 / m22 ;
+                        dtzi =   df2 * rkj2 * mz2 / m22 ;
+                        dtxl = - df2 * rkj2 * nx2 / n22 ;
+                        dtyl = - df2 * rkj2 * ny2 / n22 ;
+                        dtzl = - df2 * rkj2 * nz2 / n22 ;
+                        /* . j and k. */
+                        dotij = xij2 * xkj2 + yij2 * ykj2 + zij2 * zkj2 ;
+                        dotlk = xlk2 * xkj2 + ylk2 * ykj2 + zlk2 * zkj2 ;
+                        sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj22 ;
+                        sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj22 ;
+                        sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj22 ;
+                        dtxj  =   sx - dtxi ;
+                        dtyj  =   sy - dtyi ;
+                        dtzj  =   sz - dtzi ;
+                        dtxk  = - sx - dtxl ;
+                        dtyk  = - sy - dtyl ;
+                        dtzk  = - sz - dtzl ;
+                        /* . Add in the contributions. */
+                        Coordinates3_IncrementRow ( threadGradients3, i2, dtxi, dtyi, dtzi ) ;
+                        Coordinates3_IncrementRow ( threadGradients3, j2, dtxj, dtyj, dtzj ) ;
+                        Coordinates3_IncrementRow ( threadGradients3, k2, dtxk, dtyk, dtzk ) ;
+                        Coordinates3_IncrementRow ( threadGradients3, l2, dtxl, dtyl, dtzl ) ;
+                    }
+                }
+            }
+        }
+        Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &buffers ) ;
     }
     return energy ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make the patch table.
+! . There is no table if any of the parameters is not periodic with a uniform grid.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CMAPDihedralContainer_MakePatchTable ( CMAPDihedralContainer *self )
+{
+    if ( self != NULL )
+    {
+        CMAPPatchTable_Deallocate ( &(self->patchTable) ) ;
+        self->patchTable = CMAPPatchTable_Make ( self ) ;
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Merging.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -339,6 +377,7 @@ CMAPDihedralContainer *CMAPDihedralContainer_Merge ( const CMAPDihedralContainer
         for ( i = 0 ; i < self->nParameters  ; i++ ) new->parameters[i]                   = BicubicSpline_Clone ( self->parameters [i], NULL ) ;
         for ( i = 0 ; i < other->nParameters ; i++ ) new->parameters[i+self->nParameters] = BicubicSpline_Clone ( other->parameters[i], NULL ) ;
         new->isSorted = ( self->isSorted && other->isSorted ) ;
+        CMAPDihedralContainer_MakePatchTable ( new ) ;
     }
     return new ;
 }
@@ -408,6 +447,7 @@ CMAPDihedralContainer *CMAPDihedralContainer_Prune ( CMAPDihedralContainer *self
                 }
             }
             new->isSorted = self->isSorted ;
+            CMAPDihedralContainer_MakePatchTable ( new ) ;
 	}
 	Boolean_Deallocate ( &toKeep ) ;
     }
@@ -481,6 +521,167 @@ int CMAPDihedralContainer_UpperBound ( CMAPDihedralContainer *self )
 /*==================================================================================================================================
 ! . Private procedures.
 !=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Patch table allocation.
+! . NULL is returned if the table is empty or the allocation fails.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static CMAPPatchTable *CMAPPatchTable_Allocate ( const Integer nParameters, const Integer nPatches )
+{
+    CMAPPatchTable *self = NULL ;
+    if ( ( nParameters > 0 ) && ( nPatches > 0 ) )
+    {
+        self = Memory_AllocateType ( CMAPPatchTable ) ;
+        if ( self != NULL )
+        {
+            self->nParameters  = nParameters ;
+            self->lengthX      = Memory_AllocateArrayOfTypes ( nParameters, Integer ) ;
+            self->lengthY      = Memory_AllocateArrayOfTypes ( nParameters, Integer ) ;
+            self->offsets      = Memory_AllocateArrayOfTypes ( nParameters, Integer ) ;
+            self->lowerX       = Memory_AllocateArrayOfTypes ( nParameters, Real    ) ;
+            self->lowerY       = Memory_AllocateArrayOfTypes ( nParameters, Real    ) ;
+            self->widthX       = Memory_AllocateArrayOfTypes ( nParameters, Real    ) ;
+            self->widthY       = Memory_AllocateArrayOfTypes ( nParameters, Real    ) ;
+            self->coefficients = Memory_AllocateArrayOfTypes ( 16 * nPatches, Real  ) ;
+            if ( ( self->lengthX == NULL ) || ( self->lengthY      == NULL ) ||
+                 ( self->offsets == NULL ) || ( self->lowerX       == NULL ) ||
+                 ( self->lowerY  == NULL ) || ( self->widthX       == NULL ) ||
+                 ( self->widthY  == NULL ) || ( self->coefficients == NULL ) ) CMAPPatchTable_Deallocate ( &self ) ;
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Patch table deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void CMAPPatchTable_Deallocate ( CMAPPatchTable **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->lengthX      ) ;
+        Memory_Deallocate ( (*self)->lengthY      ) ;
+        Memory_Deallocate ( (*self)->offsets      ) ;
+        Memory_Deallocate ( (*self)->lowerX       ) ;
+        Memory_Deallocate ( (*self)->lowerY       ) ;
+        Memory_Deallocate ( (*self)->widthX       ) ;
+        Memory_Deallocate ( (*self)->widthY       ) ;
+        Memory_Deallocate ( (*self)->coefficients ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Patch table evaluation (function and first derivatives only).
+! . The points are first wrapped into the periodic range of the grid.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void CMAPPatchTable_Evaluate ( const CMAPPatchTable *self, const Integer t, const Real x, const Real y, Real *f, Real *g1, Real *g2 )
+{
+    auto Integer  i, ix, iy, nx, ny ;
+    auto Real     dudx, dudy, dx, dy, u, wx, wy ;
+    auto Real    *C ;
+    /* . Locate the patch. */
+    nx = self->lengthX[t] ;
+    ny = self->lengthY[t] ;
+    wx = self->widthX [t] ;
+    wy = self->widthY [t] ;
+    dx = x - self->lowerX[t] ;
+    dy = y - self->lowerY[t] ;
+    dx -= ( Real ) nx * wx * floor ( dx / ( ( Real ) nx * wx ) ) ;
+    dy -= ( Real ) ny * wy * floor ( dy / ( ( Real ) ny * wy ) ) ;
+    ix  = ( Integer ) ( dx / wx ) ;
+    iy  = ( Integer ) ( dy / wy ) ;
+    if ( ix < 0 ) ix = 0 ; else if ( ix >= nx ) ix = nx - 1 ;
+    if ( iy < 0 ) iy = 0 ; else if ( iy >= ny ) iy = ny - 1 ;
+    dx -= ( Real ) ix * wx ;
+    dy -= ( Real ) iy * wy ;
+    C   = &(self->coefficients[self->offsets[t]+16*(ix*ny+iy)]) ;
+    /* . Evaluation. */
+    u    = 0.0e+00 ;
+    dudx = 0.0e+00 ;
+    dudy = 0.0e+00 ;
+    for ( i = 3 ; i >= 0 ; i-- )
+    {
+        u    = C[4*i] + dy * ( C[4*i+1] + dy * ( C[4*i+2] + dy * C[4*i+3] ) ) + u * dx ;
+        dudx = C[4+i] + dx * ( 2.0e+00 * C[8+i] + 3.0e+00 * dx * C[12+i] ) + dudx * dy ;
+        dudy = C[4*i+1] + dy * ( 2.0e+00 * C[4*i+2] + 3.0e+00 * dy * C[4*i+3] ) + dudy * dx ;
+    }
+    (*f)  = u    ;
+    (*g1) = dudx ;
+    (*g2) = dudy ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Check whether the points of an abscissa are evenly spaced.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+# define UNIFORMGRIDTOLERANCE 1.0e-10
+static Boolean CMAPPatchTable_IsUniform ( const RealArray1D *abscissa )
+{
+    auto Boolean isUniform = True ;
+    auto Integer i, n ;
+    auto Real    lower, width ;
+    n     = View1D_Extent ( abscissa ) - 1 ;
+    lower = Array1D_Item ( abscissa, 0 ) ;
+    width = ( Array1D_Item ( abscissa, n ) - lower ) / ( Real ) n ;
+    for ( i = 1 ; i < n ; i++ )
+    {
+        if ( fabs ( Array1D_Item ( abscissa, i ) - lower - ( Real ) i * width ) > UNIFORMGRIDTOLERANCE * fabs ( width ) ) { isUniform = False ; break ; }
+    }
+    return isUniform ;
+}
+# undef UNIFORMGRIDTOLERANCE
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make a patch table from the parameters of a container.
+! . The coefficients of each patch are stored contiguously in row-major order.
+! . NULL is returned if the parameters are unsuitable or the table cannot be allocated, in which case the splines are used.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static CMAPPatchTable *CMAPPatchTable_Make ( const CMAPDihedralContainer *self )
+{
+    CMAPPatchTable *table = NULL ;
+    auto Boolean        isOK = True ;
+    auto Integer        i, ix, iy, j, indices[2], n, nPatches, p ;
+    auto RealArray2D    C ;
+    auto BicubicSpline *spline ;
+    /* . Check the parameters. */
+    for ( p = nPatches = 0 ; ( p < self->nParameters ) && isOK ; p++ )
+    {
+        spline = self->parameters[p] ;
+        isOK   = ( spline != NULL ) && ( spline->type == BicubicSplineType_Periodic ) &&
+                 CMAPPatchTable_IsUniform ( spline->x ) && CMAPPatchTable_IsUniform ( spline->y ) ;
+        if ( isOK ) nPatches += ( spline->lengthX - 1 ) * ( spline->lengthY - 1 ) ;
+    }
+    if ( ! isOK ) return NULL ;
+    /* . Fill the table. */
+    table = CMAPPatchTable_Allocate ( self->nParameters, nPatches ) ;
+    if ( table != NULL )
+    {
+        for ( p = n = 0 ; p < self->nParameters ; p++ )
+        {
+            spline = self->parameters[p] ;
+            table->lengthX[p] = spline->lengthX - 1 ;
+            table->lengthY[p] = spline->lengthY - 1 ;
+            table->offsets[p] = n ;
+            table->lowerX [p] = Array1D_Item ( spline->x, 0 ) ;
+            table->lowerY [p] = Array1D_Item ( spline->y, 0 ) ;
+            table->widthX [p] = ( Array1D_Item ( spline->x, spline->lengthX - 1 ) - table->lowerX[p] ) / ( Real ) table->lengthX[p] ;
+            table->widthY [p] = ( Array1D_Item ( spline->y, spline->lengthY - 1 ) - table->lowerY[p] ) / ( Real ) table->lengthY[p] ;
+            for ( ix = 0 ; ix < table->lengthX[p] ; ix++ )
+            {
+                for ( iy = 0 ; iy < table->lengthY[p] ; iy++ )
+                {
+                    indices[0] = ix ; indices[1] = iy ;
+                    RealArrayND_ViewTail2D ( spline->coefficients, indices, False, &C, NULL ) ;
+                    for ( i = 0 ; i < 4 ; i++ )
+                    {
+                        for ( j = 0 ; j < 4 ; j++, n++ ) table->coefficients[n] = Array2D_Item ( &C, i, j ) ;
+                    }
+                }
+            }
+        }
+    }
+    return table ;
+}
+
 static Integer CMAPDihedralTerm_Compare ( const void *vTerm1, const void *vTerm2 )
 {
     CMAPDihedral *term1, *term2 ;
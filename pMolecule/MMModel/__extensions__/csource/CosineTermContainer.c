@@ -12,6 +12,12 @@
 # include "Memory.h"
 # include "NumericalMacros.h"
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local procedures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static CosineTermPlan *CosineTermPlan_Allocate ( const Integer nIndices, const Integer nTerms ) ;
+static Integer         CosineTermPlan_Compare  ( const void *vTerm1, const void *vTerm2 ) ;
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Activate terms.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -21,6 +27,7 @@ void CosineTermContainer_ActivateTerms ( CosineTermContainer *self )
     {
         auto Integer i ;
 	for ( i = 0 ; i < self->nTerms ; i++ ) self->terms[i].isActive = True ;
+        CosineTermContainer_MakePlan ( self ) ;
     }
 }
 
@@ -37,6 +44,7 @@ CosineTermContainer *CosineTermContainer_Allocate ( const Integer nIndices, cons
         self->nIndices    = nIndices    ;
 	self->nParameters = nParameters ;
  	self->nTerms      = nTerms      ;
+	self->plan        = NULL        ;
 	self->parameters  = Memory_AllocateArrayOfTypes ( nParameters, CosineParameter ) ;
 	self->terms	  = Memory_AllocateArrayOfTypes ( nTerms     , CosineTerm      ) ;
         for ( i = 0 ; i < nParameters ; i++ ) CosineParameter_Initialize ( &(self->parameters[i])           ) ;
@@ -57,6 +65,7 @@ CosineTermContainer *CosineTermContainer_Clone ( const CosineTermContainer *self
         new = CosineTermContainer_Allocate ( self->nIndices, self->nTerms, self->nParameters ) ;
         for ( i = 0 ; i < self->nParameters ; i++ ) CosineParameter_Clone ( &(new->parameters[i]), &(self->parameters[i]) ) ;
         for ( i = 0 ; i < self->nTerms      ; i++ ) CosineTerm_Clone      ( &(new->terms     [i]), &(self->terms     [i]) , self->nIndices ) ;
+        CosineTermContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -86,6 +95,7 @@ void CosineTermContainer_DeactivateTerms ( CosineTermContainer *self, Selection
                 self->terms[t].isActive = isActive ;
             }
 	}
+        CosineTermContainer_MakePlan ( self ) ;
     }
 }
 
@@ -97,6 +107,7 @@ void CosineTermContainer_Deallocate ( CosineTermContainer **self )
     if ( (*self) != NULL )
     {
         auto Integer i ;
+        CosineTermPlan_Deallocate ( &((*self)->plan) ) ;
         for ( i = 0 ; i < (*self)->nParameters ; i++ ) CosineParameter_Deallocate ( &((*self)->parameters[i]) ) ;
         for ( i = 0 ; i < (*self)->nTerms      ; i++ ) CosineTerm_Deallocate      ( &((*self)->terms     [i]) ) ;
         Memory_Deallocate ( (*self)->parameters ) ;
@@ -125,6 +136,19 @@ Integer CosineTermContainer_FindMaximumPeriod ( CosineTermContainer *self )
     return p ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make the execution plan.
+! . This must be called whenever the terms or parameters are changed.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CosineTermContainer_MakePlan ( CosineTermContainer *self )
+{
+    if ( self != NULL )
+    {
+        CosineTermPlan_Deallocate ( &(self->plan) ) ;
+        self->plan = CosineTermPlan_Make ( self ) ;
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Make the powers representation of the parameters.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -134,6 +158,7 @@ void CosineTermContainer_MakePowers ( CosineTermContainer *self )
     {
         auto Integer i ;
         for ( i = 0 ; i < self->nParameters ; i++ ) CosineParameter_MakePowers ( &(self->parameters[i]) ) ;
+        CosineTermContainer_MakePlan ( self ) ;
     }
 }
 
@@ -195,6 +220,7 @@ CosineTermContainer *CosineTermContainer_Prune ( CosineTermContainer *self, Sele
         	    n++ ;
                 }
             }
+            CosineTermContainer_MakePlan ( new ) ;
 	}
 	Boolean_Deallocate ( &toKeep ) ;
     }
@@ -219,3 +245,111 @@ int CosineTermContainer_UpperBound ( CosineTermContainer *self )
     }
     return upperBound ;
 }
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Plan deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CosineTermPlan_Deallocate ( CosineTermPlan **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->indices           ) ;
+        Memory_Deallocate ( (*self)->nPowers           ) ;
+        Memory_Deallocate ( (*self)->powerCoefficients ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make a plan from the active terms of a container.
+! . The power coefficients are referenced and not copied so the plan must be remade if they change.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+CosineTermPlan *CosineTermPlan_Make ( const CosineTermContainer *self )
+{
+    CosineTermPlan *plan = NULL ;
+    if ( self != NULL )
+    {
+        auto Integer  i, m, n, p, t ;
+        auto Integer *records = NULL ;
+        /* . Gather the active terms and their keys. */
+        n = self->nTerms - CosineTermContainer_NumberOfInactiveTerms ( self ) ;
+        if ( n > 0 ) records = Memory_AllocateArrayOfTypes ( 2 * n, Integer ) ;
+        if ( records != NULL )
+        {
+            for ( m = t = 0 ; t < self->nTerms ; t++ )
+            {
+                if ( self->terms[t].isActive )
+                {
+                    p = -1 ;
+                    for ( i = 0 ; i < self->nIndices ; i++ ) p = Maximum ( p, self->terms[t].indices[i] ) ;
+                    records[2*m  ] = p ;
+                    records[2*m+1] = t ;
+                    m++ ;
+                }
+            }
+            /* . Order the terms. */
+            qsort ( ( void * ) records, ( size_t ) n, 2 * sizeof ( Integer ), ( void * ) CosineTermPlan_Compare ) ;
+            /* . Fill the plan. */
+            plan = CosineTermPlan_Allocate ( self->nIndices, n ) ;
+            if ( plan != NULL )
+            {
+                for ( m = 0 ; m < n ; m++ )
+                {
+                    t = records[2*m+1] ;
+                    p = self->terms[t].type ;
+                    for ( i = 0 ; i < self->nIndices ; i++ ) plan->indices[self->nIndices*m+i] = self->terms[t].indices[i] ;
+                    plan->nPowers          [m] = self->parameters[p].nPowers           ;
+                    plan->powerCoefficients[m] = self->parameters[p].powerCoefficients ;
+                }
+            }
+            Memory_Deallocate ( records ) ;
+        }
+    }
+    return plan ;
+}
+
+/*==================================================================================================================================
+! . Private procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Plan allocation.
+! . NULL is returned if there are no terms or the allocation fails.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static CosineTermPlan *CosineTermPlan_Allocate ( const Integer nIndices, const Integer nTerms )
+{
+    CosineTermPlan *self = NULL ;
+    if ( ( nIndices > 0 ) && ( nTerms > 0 ) )
+    {
+        self = Memory_AllocateType ( CosineTermPlan ) ;
+        if ( self != NULL )
+        {
+            self->nIndices          = nIndices ;
+            self->nTerms            = nTerms   ;
+            self->indices           = Memory_AllocateArrayOfTypes      ( nIndices * nTerms, Integer ) ;
+            self->nPowers           = Memory_AllocateArrayOfTypes      (            nTerms, Integer ) ;
+            self->powerCoefficients = Memory_AllocateArrayOfReferences (            nTerms, Real    ) ;
+            if ( ( self->indices           == NULL ) ||
+                 ( self->nPowers           == NULL ) ||
+                 ( self->powerCoefficients == NULL ) ) CosineTermPlan_Deallocate ( &self ) ;
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Plan term comparison.
+! . Terms are ordered by key and then by their position in the container.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer CosineTermPlan_Compare ( const void *vTerm1, const void *vTerm2 )
+{
+    Integer *term1, *term2 ;
+    Integer i ;
+    term1 = ( Integer * ) vTerm1 ;
+    term2 = ( Integer * ) vTerm2 ;
+         if ( term1[0] < term2[0] ) i = -1 ;
+    else if ( term1[0] > term2[0] ) i =  1 ;
+    else if ( term1[1] < term2[1] ) i = -1 ;
+    else if ( term1[1] > term2[1] ) i =  1 ;
+    else i = 0 ;
+    return i ;
+}
@@ -12,7 +12,11 @@
 /*------------------------------------------------------------------------------
 ! . Local procedures.
 !-----------------------------------------------------------------------------*/
-static Integer FourierDihedralTerm_Compare ( const void *vTerm1, const void *vTerm2 ) ;
+static FourierDihedralPlan *FourierDihedralPlan_Allocate   ( const Integer nTerms ) ;
+static void                 FourierDihedralPlan_Deallocate ( FourierDihedralPlan **self ) ;
+static Real                 FourierDihedralPlan_Energy     ( const FourierDihedralPlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
+static FourierDihedralPlan *FourierDihedralPlan_Make       ( const FourierDihedralContainer *self ) ;
+static Integer              FourierDihedralTerm_Compare    ( const void *vTerm1, const void *vTerm2 ) ;
 
 /*==============================================================================
 ! . Procedures.
@@ -26,6 +30,7 @@ void FourierDihedralContainer_ActivateTerms ( FourierDihedralContainer *self )
     {
         auto Integer i ;
 	for ( i = 0 ; i < self->nTerms ; i++ ) self->terms[i].isActive = True ;
+        FourierDihedralContainer_MakePlan ( self ) ;
     }
 }
 
@@ -42,6 +47,7 @@ FourierDihedralContainer *FourierDihedralContainer_Allocate ( const Integer nTer
         self->isSorted     = False       ;
 	self->nTerms      = nTerms      ;
 	self->nParameters = nParameters ;
+	self->plan        = NULL        ;
 	self->terms	  = Memory_AllocateArrayOfTypes ( nTerms      , FourierDihedral           ) ;
 	self->parameters  = Memory_AllocateArrayOfTypes ( nParameters , FourierDihedralParameter  ) ;
 	/* . Make all terms inactive. */
@@ -78,6 +84,7 @@ FourierDihedralContainer *FourierDihedralContainer_Clone ( const FourierDihedral
             new->parameters[i].sinphase = self->parameters[i].sinphase ;
         }
         new->isSorted = self->isSorted ;
+        FourierDihedralContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -104,6 +111,7 @@ void FourierDihedralContainer_DeactivateTerms ( FourierDihedralContainer *self,
                                             Block_Item ( flags, self->terms[i].atom4 ) ) ;
             }
 	}
+        FourierDihedralContainer_MakePlan ( self ) ;
     }
 }
 
@@ -114,6 +122,7 @@ void FourierDihedralContainer_Deallocate ( FourierDihedralContainer **self )
 {
     if ( (*self) != NULL )
     {
+        FourierDihedralPlan_Deallocate ( &((*self)->plan) ) ;
         Memory_Deallocate ( (*self)->terms      ) ;
         Memory_Deallocate ( (*self)->parameters ) ;
         Memory_Deallocate ( (*self) ) ;
@@ -123,90 +132,96 @@ void FourierDihedralContainer_Deallocate ( FourierDihedralContainer **self )
 /*------------------------------------------------------------------------------
 ! . Energy and gradients.
 ! . Following Becker, Berendsen and van Gunsteren, JCC 16 p527 (1995).
+! . The plan is used if there is one and the active terms of the container
+! . otherwise (for example, if the plan could not be allocated).
 !-----------------------------------------------------------------------------*/
 double FourierDihedralContainer_Energy ( const FourierDihedralContainer *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
 {
     Real energy = 0.0e+00 ;
     if ( ( self != NULL ) && ( coordinates3 != NULL ) )
     {
-	auto Boolean   QGRADIENTS ;
-        auto Real cosnphi, cosPhi, df, dotij, dotlk, mn, rkj, rkj2, sinnphi, sinPhi, temp ;
-        auto Real dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, m2, mx, my, mz, n2, nx, ny, nz, sx, sy, sz,
-                    xij, yij, zij, xkj, ykj, zkj, xlk, ylk, zlk ;
-        auto Integer    i, j, k, l, n, p, t ;
-	QGRADIENTS = ( gradients3 != NULL ) ;
-	for ( n = 0 ; n < self->nTerms ; n++ )
-	{
-	    if ( self->terms[n].isActive )
-	    {
-                /* . Local data. */
-	        i = self->terms[n].atom1 ;
-	        j = self->terms[n].atom2 ;
-	        k = self->terms[n].atom3 ;
-	        l = self->terms[n].atom4 ;
-	        t = self->terms[n].type  ;
-	        /* . Coordinate displacements. */
-	        Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, l, k, xlk, ylk, zlk ) ;
-	        rkj2 = xkj * xkj + ykj * ykj + zkj * zkj ;
-	        rkj  = sqrt ( rkj2 ) ;
-                /* . m and n. */
-                mx = yij * zkj - zij * ykj ;
-	        my = zij * xkj - xij * zkj ;
-	        mz = xij * ykj - yij * xkj ;
-	        nx = ylk * zkj - zlk * ykj ;
-	        ny = zlk * xkj - xlk * zkj ;
-	        nz = xlk * ykj - ylk * xkj ;
-                m2 = mx * mx + my * my + mz * mz ;
-	        n2 = nx * nx + ny * ny + nz * nz ;
-	        mn = sqrt ( m2 * n2 ) ;
-                /* . Cosine and sine of the dihedral. */
-                cosPhi =       (  mx * nx +  my * ny +  mz * nz ) / mn ;
-                sinPhi = rkj * ( xij * nx + yij * ny + zij * nz ) / mn ;
-                /* . Cos ( n phi ) and sin ( n phi ). */
-                cosnphi = 1.0e+00 ;
-                sinnphi = 0.0e+00 ;
-                for ( p = 1 ; p <= self->parameters[t].period ; p++ )
-	        {
-	            temp    = cosnphi * cosPhi - sinnphi * sinPhi ;
-	            sinnphi = cosnphi * sinPhi + sinnphi * cosPhi ;
-                    cosnphi = temp ;
-	        }
-                /* . The energy term. */
-                energy += self->parameters[t].fc * ( 1.0e+00 + cosnphi * self->parameters[t].cosphase + sinnphi * self->parameters[t].sinphase ) ;
-                if ( QGRADIENTS )
+        if ( self->plan != NULL ) energy = FourierDihedralPlan_Energy ( self->plan, coordinates3, gradients3 ) ;
+        else
+        {
+            auto Boolean   QGRADIENTS ;
+            auto Real cosnphi, cosPhi, df, dotij, dotlk, mn, rkj, rkj2, sinnphi, sinPhi, temp ;
+            auto Real dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, m2, mx, my, mz, n2, nx, ny, nz, sx, sy, sz,
+                        xij, yij, zij, xkj, ykj, zkj, xlk, ylk, zlk ;
+            auto Integer    i, j, k, l, n, p, t ;
+            QGRADIENTS = ( gradients3 != NULL ) ;
+            for ( n = 0 ; n < self->nTerms ; n++ )
+            {
+                if ( self->terms[n].isActive )
                 {
-	            /* . The derivatives. */
-	            df = self->parameters[t].fc * ( ( Real ) self->parameters[t].period ) * ( cosnphi * self->parameters[t].sinphase -
-	                                                                                        sinnphi * self->parameters[t].cosphase ) ;
-                    /* . i and l. */
-                    dtxi =   df * rkj * mx / m2 ;
-                    dtyi =   df * rkj * my / m2 ;
-                    dtzi =   df * rkj * mz / m2 ;
-                    dtxl = - df * rkj * nx / n2 ;
-                    dtyl = - df * rkj * ny / n2 ;
-                    dtzl = - df * rkj * nz / n2 ;
-                    /* . j and k. */
-                    dotij = xij * xkj + yij * ykj + zij * zkj ;
-                    dotlk = xlk * xkj + ylk * ykj + zlk * zkj ;
-	            sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj2 ;
-	            sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj2 ;
-	            sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj2 ;
-	            dtxj  =   sx - dtxi ;
-	            dtyj  =   sy - dtyi ;
-	            dtzj  =   sz - dtzi ;
-	            dtxk  = - sx - dtxl ;
-	            dtyk  = - sy - dtyl ;
-	            dtzk  = - sz - dtzl ;
-                    /* . Add in the contributions. */
-	            Coordinates3_IncrementRow ( gradients3, i, dtxi, dtyi, dtzi ) ;
-	            Coordinates3_IncrementRow ( gradients3, j, dtxj, dtyj, dtzj ) ;
-	            Coordinates3_IncrementRow ( gradients3, k, dtxk, dtyk, dtzk ) ;
-	            Coordinates3_IncrementRow ( gradients3, l, dtxl, dtyl, dtzl ) ;
-        	}
-	    }
-	}
+                    /* . Local data. */
+                    i = self->terms[n].atom1 ;
+                    j = self->terms[n].atom2 ;
+                    k = self->terms[n].atom3 ;
+                    l = self->terms[n].atom4 ;
+                    t = self->terms[n].type  ;
+                    /* . Coordinate displacements. */
+                    Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, l, k, xlk, ylk, zlk ) ;
+                    rkj2 = xkj * xkj + ykj * ykj + zkj * zkj ;
+                    rkj  = sqrt ( rkj2 ) ;
+                    /* . m and n. */
+                    mx = yij * zkj - zij * ykj ;
+                    my = zij * xkj - xij * zkj ;
+                    mz = xij * ykj - yij * xkj ;
+                    nx = ylk * zkj - zlk * ykj ;
+                    ny = zlk * xkj - xlk * zkj ;
+                    nz = xlk * ykj - ylk * xkj ;
+                    m2 = mx * mx + my * my + mz * mz ;
+                    n2 = nx * nx + ny * ny + nz * nz ;
+                    mn = sqrt ( m2 * n2 ) ;
+                    /* . Cosine and sine of the dihedral. */
+                    cosPhi =       (  mx * nx +  my * ny +  mz * nz ) / mn ;
+                    sinPhi = rkj * ( xij * nx + yij * ny + zij * nz ) / mn ;
+                    /* . Cos ( n phi ) and sin ( n phi ). */
+                    cosnphi = 1.0e+00 ;
+                    sinnphi = 0.0e+00 ;
+                    for ( p = 1 ; p <= self->parameters[t].period ; p++ )
+                    {
+                        temp    = cosnphi * cosPhi - sinnphi * sinPhi ;
+                        sinnphi = cosnphi * sinPhi + sinnphi * cosPhi ;
+                        cosnphi = temp ;
+                    }
+                    /* . The energy term. */
+                    energy += self->parameters[t].fc * ( 1.0e+00 + cosnphi * self->parameters[t].cosphase + sinnphi * self->parameters[t].sinphase ) ;
+                    if ( QGRADIENTS )
+                    {
+                        /* . The derivatives. */
+                        df = self->parameters[t].fc * ( ( Real ) self->parameters[t].period ) * ( cosnphi * self->parameters[t].sinphase -
+                                                                                                    sinnphi * self->parameters[t].cosphase ) ;
+                        /* . i and l. */
+                        dtxi =   df * rkj * mx / m2 ;
+                        dtyi =   df * rkj * my / m2 ;
+                        dtzi =   df * rkj * mz / m2 ;
+                        dtxl = - df * rkj * nx / n2 ;
+                        dtyl = - df * rkj * ny / n2 ;
+                        dtzl = - df * rkj * nz / n2 ;
+                        /* . j and k. */
+                        dotij = xij * xkj + yij * ykj + zij * zkj ;
+                        dotlk = xlk * xkj + ylk * ykj + zlk * zkj ;
+                        sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj2 ;
+                        sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj2 ;
+                        sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj2 ;
+                        dtxj  =   sx - dtxi ;
+                        dtyj  =   sy - dtyi ;
+                        dtzj  =   sz - dtzi ;
+                        dtxk  = - sx - dtxl ;
+                        dtyk  = - sy - dtyl ;
+                        dtzk  = - sz - dtzl ;
+                        /* . Add in the contributions. */
+                        Coordinates3_IncrementRow ( gradients3, i, dtxi, dtyi, dtzi ) ;
+                        Coordinates3_IncrementRow ( gradients3, j, dtxj, dtyj, dtzj ) ;
+                        Coordinates3_IncrementRow ( gradients3, k, dtxk, dtyk, dtzk ) ;
+                        Coordinates3_IncrementRow ( gradients3, l, dtxl, dtyl, dtzl ) ;
+                    }
+                }
+            }
+        }
     }
     return energy ;
 }
@@ -224,6 +239,21 @@ void FourierDihedralContainer_FillCosSinPhases ( FourierDihedralContainer *self
             self->parameters[i].cosphase = cos ( self->parameters[i].phase ) ;
             self->parameters[i].sinphase = sin ( self->parameters[i].phase ) ;
         }
+        FourierDihedralContainer_MakePlan ( self ) ;
+    }
+}
+
+/*------------------------------------------------------------------------------
+! . Make the execution plan.
+! . This must be called whenever the terms or parameters are changed.
+!-----------------------------------------------------------------------------*/
+void FourierDihedralContainer_MakePlan ( FourierDihedralContainer *self )
+{
+    if ( self != NULL )
+    {
+        FourierDihedralContainer_Sort  ( self ) ;
+        FourierDihedralPlan_Deallocate ( &(self->plan) ) ;
+        self->plan = FourierDihedralPlan_Make ( self ) ;
     }
 }
 
@@ -272,6 +302,7 @@ FourierDihedralContainer *FourierDihedralContainer_Merge ( const FourierDihedral
             new->parameters[i+self->nParameters].sinphase = other->parameters[i].sinphase ;
         }
         new->isSorted = ( self->isSorted && other->isSorted ) ;
+        FourierDihedralContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -340,6 +371,7 @@ FourierDihedralContainer *FourierDihedralContainer_Prune ( FourierDihedralContai
                 }
             }
             new->isSorted = self->isSorted ;
+            FourierDihedralContainer_MakePlan ( new ) ;
 	}
 	Boolean_Deallocate ( &toKeep ) ;
     }
@@ -399,6 +431,183 @@ int FourierDihedralContainer_UpperBound ( FourierDihedralContainer *self )
 /*==============================================================================
 ! . Private procedures.
 !============================================================================*/
+/*------------------------------------------------------------------------------
+! . Plan allocation.
+! . NULL is returned if there are no terms or the allocation fails.
+!-----------------------------------------------------------------------------*/
+static FourierDihedralPlan *FourierDihedralPlan_Allocate ( const Integer nTerms )
+{
+    FourierDihedralPlan *self = NULL ;
+    if ( nTerms > 0 )
+    {
+        self = Memory_AllocateType ( FourierDihedralPlan ) ;
+        if ( self != NULL )
+        {
+            self->nTerms   = nTerms ;
+            self->atom1    = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom2    = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom3    = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom4    = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->period   = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->fc       = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            self->cosphase = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            self->sinphase = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            if ( ( self->atom1    == NULL ) || ( self->atom2    == NULL ) ||
+                 ( self->atom3    == NULL ) || ( self->atom4    == NULL ) ||
+                 ( self->period   == NULL ) || ( self->fc       == NULL ) ||
+                 ( self->cosphase == NULL ) || ( self->sinphase == NULL ) ) FourierDihedralPlan_Deallocate ( &self ) ;
+        }
+    }
+    return self ;
+}
+
+/*------------------------------------------------------------------------------
+! . Plan deallocation.
+!-----------------------------------------------------------------------------*/
+static void FourierDihedralPlan_Deallocate ( FourierDihedralPlan **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->atom1    ) ;
+        Memory_Deallocate ( (*self)->atom2    ) ;
+        Memory_Deallocate ( (*self)->atom3    ) ;
+        Memory_Deallocate ( (*self)->atom4    ) ;
+        Memory_Deallocate ( (*self)->period   ) ;
+        Memory_Deallocate ( (*self)->fc       ) ;
+        Memory_Deallocate ( (*self)->cosphase ) ;
+        Memory_Deallocate ( (*self)->sinphase ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*------------------------------------------------------------------------------
+! . Plan energy and gradients.
+! . There are no inactive terms or parameter look-ups in the loop.
+! . The gradients of each thread are accumulated in separate buffers.
+!-----------------------------------------------------------------------------*/
+static Real FourierDihedralPlan_Energy ( const FourierDihedralPlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
+{
+    Real energy = 0.0e+00 ;
+    auto Boolean  QGRADIENTS ;
+    auto Integer  numberOfThreads ;
+    auto Real    *buffers ;
+    QGRADIENTS = ( gradients3 != NULL ) ;
+    buffers    = Coordinates3_AllocateThreadBuffersForWork ( gradients3, self->nTerms, &numberOfThreads ) ;
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
+    {
+        auto Coordinates3 view, *threadGradients3 ;
+        auto Real cosnphi, cosPhi, df, dotij, dotlk, mn, rkj, rkj2, sinnphi, sinPhi, temp ;
+        auto Real dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, m2, mx, my, mz, n2, nx, ny, nz, sx, sy, sz,
+                  xij, yij, zij, xkj, ykj, zkj, xlk, ylk, zlk ;
+        auto Integer i, j, k, l, n, p ;
+        threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, buffers, &view ) ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( static )
+# endif
+        for ( n = 0 ; n < self->nTerms ; n++ )
+        {
+            /* . Local data. */
+            i = self->atom1[n] ;
+            j = self->atom2[n] ;
+            k = self->atom3[n] ;
+            l = self->atom4[n] ;
+            /* . Coordinate displacements. */
+            Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+            Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
+            Coordinates3_DifferenceRow ( coordinates3, l, k, xlk, ylk, zlk ) ;
+            rkj2 = xkj * xkj + ykj * ykj + zkj * zkj ;
+            rkj  = sqrt ( rkj2 ) ;
+            /* . m and n. */
+            mx = yij * zkj - zij * ykj ;
+            my = zij * xkj - xij * zkj ;
+            mz = xij * ykj - yij * xkj ;
+            nx = ylk * zkj - zlk * ykj ;
+            ny = zlk * xkj - xlk * zkj ;
+            nz = xlk * ykj - ylk * xkj ;
+            m2 = mx * mx + my * my + mz * mz ;
+            n2 = nx * nx + ny * ny + nz * nz ;
+            mn = sqrt ( m2 * n2 ) ;
+            /* . Cosine and sine of the dihedral. */
+            cosPhi =       (  mx * nx +  my * ny +  mz * nz ) / mn ;
+            sinPhi = rkj * ( xij * nx + yij * ny + zij * nz ) / mn ;
+            /* . Cos ( n phi ) and sin ( n phi ). */
+            cosnphi = 1.0e+00 ;
+            sinnphi = 0.0e+00 ;
+            for ( p = 1 ; p <= self->period[n] ; p++ )
+            {
+                temp    = cosnphi * cosPhi - sinnphi * sinPhi ;
+                sinnphi = cosnphi * sinPhi + sinnphi * cosPhi ;
+                cosnphi = temp ;
+            }
+            /* . The energy term. */
+            energy += self->fc[n] * ( 1.0e+00 + cosnphi * self->cosphase[n] + sinnphi * self->sinphase[n] ) ;
+            if ( QGRADIENTS )
+            {
+                /* . The derivatives. */
+                df = self->fc[n] * ( ( Real ) self->period[n] ) * ( cosnphi * self->sinphase[n] - sinnphi * self->cosphase[n] ) ;
+                /* . i and l. */
+                dtxi =   df * rkj * mx / m2 ;
+                dtyi =   df * rkj * my / m2 ;
+                dtzi =   df * rkj * mz / m2 ;
+                dtxl = - df * rkj * nx / n2 ;
+                dtyl = - df * rkj * ny / n2 ;
+                dtzl = - df * rkj * nz / n2 ;
+                /* . j and k. */
+                dotij = xij * xkj + yij * ykj + zij * zkj ;
+                dotlk = xlk * xkj + ylk * ykj + zlk * zkj ;
+                sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj2 ;
+                sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj2 ;
+                sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj2 ;
+                dtxj  =   sx - dtxi ;
+                dtyj  =   sy - dtyi ;
+                dtzj  =   sz - dtzi ;
+                dtxk  = - sx - dtxl ;
+                dtyk  = - sy - dtyl ;
+                dtzk  = - sz - dtzl ;
+                /* . Add in the contributions. */
+                Coordinates3_IncrementRow ( threadGradients3, i, dtxi, dtyi, dtzi ) ;
+                Coordinates3_IncrementRow ( threadGradients3, j, dtxj, dtyj, dtzj ) ;
+                Coordinates3_IncrementRow ( threadGradients3, k, dtxk, dtyk, dtzk ) ;
+                Coordinates3_IncrementRow ( threadGradients3, l, dtxl, dtyl, dtzl ) ;
+            }
+        }
+    }
+    Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &buffers ) ;
+    return energy ;
+}
+
+/*------------------------------------------------------------------------------
+! . Make a plan from the active terms of a container.
+!-----------------------------------------------------------------------------*/
+static FourierDihedralPlan *FourierDihedralPlan_Make ( const FourierDihedralContainer *self )
+{
+    FourierDihedralPlan *plan ;
+    plan = FourierDihedralPlan_Allocate ( self->nTerms - FourierDihedralContainer_NumberOfInactiveTerms ( self ) ) ;
+    if ( plan != NULL )
+    {
+        auto Integer m, n, t ;
+        for ( m = n = 0 ; n < self->nTerms ; n++ )
+        {
+            if ( self->terms[n].isActive )
+            {
+                t = self->terms[n].type ;
+                plan->atom1   [m] = self->terms[n].atom1 ;
+                plan->atom2   [m] = self->terms[n].atom2 ;
+                plan->atom3   [m] = self->terms[n].atom3 ;
+                plan->atom4   [m] = self->terms[n].atom4 ;
+                plan->period  [m] = self->parameters[t].period ;
+                plan->fc      [m] = self->parameters[t].fc ;
+                plan->cosphase[m] = self->parameters[t].cosphase ;
+                plan->sinphase[m] = self->parameters[t].sinphase ;
+                m++ ;
+            }
+        }
+    }
+    return plan ;
+}
+
 static Integer FourierDihedralTerm_Compare ( const void *vTerm1, const void *vTerm2 )
 {
     FourierDihedral *term1, *term2 ;
@@ -14,7 +14,11 @@
 /*------------------------------------------------------------------------------
 ! . Local procedures.
 !-----------------------------------------------------------------------------*/
-static Integer HarmonicAngleTerm_Compare ( const void *vTerm1, const void *vTerm2 ) ;
+static HarmonicAnglePlan *HarmonicAnglePlan_Allocate   ( const Integer nTerms ) ;
+static void               HarmonicAnglePlan_Deallocate ( HarmonicAnglePlan **self ) ;
+static Real               HarmonicAnglePlan_Energy     ( const HarmonicAnglePlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
+static HarmonicAnglePlan *HarmonicAnglePlan_Make       ( const HarmonicAngleContainer *self ) ;
+static Integer            HarmonicAngleTerm_Compare    ( const void *vTerm1, const void *vTerm2 ) ;
 
 /*------------------------------------------------------------------------------
 ! . Definitions.
@@ -34,6 +38,7 @@ void HarmonicAngleContainer_ActivateTerms ( HarmonicAngleContainer *self )
     {
         auto Integer i ;
 	for ( i = 0 ; i < self->nTerms ; i++ ) self->terms[i].isActive = True ;
+        HarmonicAngleContainer_MakePlan ( self ) ;
     }
 }
 
@@ -50,6 +55,7 @@ HarmonicAngleContainer *HarmonicAngleContainer_Allocate ( const Integer nTerms,
         self->isSorted     = False       ;
 	self->nTerms      = nTerms      ;
 	self->nParameters = nParameters ;
+	self->plan        = NULL        ;
 	self->terms	  = Memory_AllocateArrayOfTypes ( nTerms     , HarmonicAngle          ) ;
 	self->parameters  = Memory_AllocateArrayOfTypes ( nParameters, HarmonicAngleParameter ) ;
 	/* . Make all terms inactive. */
@@ -82,6 +88,7 @@ HarmonicAngleContainer *HarmonicAngleContainer_Clone ( const HarmonicAngleContai
             new->parameters[i].fc = self->parameters[i].fc ;
         }
         new->isSorted = self->isSorted ;
+        HarmonicAngleContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -107,6 +114,7 @@ void HarmonicAngleContainer_DeactivateTerms ( HarmonicAngleContainer *self, Sele
                                             Block_Item ( flags, self->terms[i].atom3 ) ) ;
             }
 	}
+        HarmonicAngleContainer_MakePlan ( self ) ;
     }
 }
 
@@ -117,6 +125,7 @@ void HarmonicAngleContainer_Deallocate ( HarmonicAngleContainer **self )
 {
     if ( (*self) != NULL )
     {
+        HarmonicAnglePlan_Deallocate ( &((*self)->plan) ) ;
         Memory_Deallocate ( (*self)->terms      ) ;
         Memory_Deallocate ( (*self)->parameters ) ;
         Memory_Deallocate ( (*self) ) ;
@@ -125,57 +134,77 @@ void HarmonicAngleContainer_Deallocate ( HarmonicAngleContainer **self )
 
 /*------------------------------------------------------------------------------
 ! . Energy and gradients.
+! . The plan is used if there is one and the active terms of the container
+! . otherwise (for example, if the plan could not be allocated).
 !-----------------------------------------------------------------------------*/
 double HarmonicAngleContainer_Energy ( const HarmonicAngleContainer *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
 {
     Real energy = 0.0e+00 ;
     if ( ( self != NULL ) && ( coordinates3 != NULL ) )
     {
-	auto Boolean   QGRADIENTS ;
-        auto Real df, disp, dot, dtdx, dtxi, dtxk, dtyi, dtyk, dtzi, dtzk, rij, rkj, theta, xij, yij, zij, xkj, ykj, zkj ;
-        auto Integer    i, j, k, n, t ;
-	QGRADIENTS = ( gradients3 != NULL ) ;
-	for ( n = 0 ; n < self->nTerms ; n++ )
-	{
-	    if ( self->terms[n].isActive )
-	    {
-		i = self->terms[n].atom1 ;
-		j = self->terms[n].atom2 ;
-	        k = self->terms[n].atom3 ;
-		t = self->terms[n].type  ;
-	        Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
-	        rij = sqrt ( xij * xij + yij * yij + zij * zij ) ;
-	        rkj = sqrt ( xkj * xkj + ykj * ykj + zkj * zkj ) ;
-	        xij /= rij ; yij /= rij ; zij /= rij ;
-	        xkj /= rkj ; ykj /= rkj ; zkj /= rkj ;
-	        dot   = xij * xkj + yij * ykj + zij * zkj ;
-                dot   = Maximum ( - DOT_LIMIT, dot ) ;
-	        dot   = Minimum (   DOT_LIMIT, dot ) ;
-                theta = acos ( dot ) ;
-	        disp  = theta - self->parameters[t].eq ;
-	        df    = self->parameters[t].fc * disp  ;
-	        energy += ( df * disp ) ;
-                if ( QGRADIENTS )
+        if ( self->plan != NULL ) energy = HarmonicAnglePlan_Energy ( self->plan, coordinates3, gradients3 ) ;
+        else
+        {
+            auto Boolean   QGRADIENTS ;
+            auto Real df, disp, dot, dtdx, dtxi, dtxk, dtyi, dtyk, dtzi, dtzk, rij, rkj, theta, xij, yij, zij, xkj, ykj, zkj ;
+            auto Integer    i, j, k, n, t ;
+            QGRADIENTS = ( gradients3 != NULL ) ;
+            for ( n = 0 ; n < self->nTerms ; n++ )
+            {
+                if ( self->terms[n].isActive )
                 {
-	            dtdx = - 1.0 / sqrt ( 1.0 - dot * dot ) ;
-                    df  *= ( 2.0e+00 * dtdx ) ;
-                    dtxi = df * ( xkj - dot * xij ) / rij ;
-                    dtyi = df * ( ykj - dot * yij ) / rij ;
-                    dtzi = df * ( zkj - dot * zij ) / rij ;
-                    dtxk = df * ( xij - dot * xkj ) / rkj ;
-                    dtyk = df * ( yij - dot * ykj ) / rkj ;
-                    dtzk = df * ( zij - dot * zkj ) / rkj ;
-	            Coordinates3_IncrementRow ( gradients3, i,   dtxi,            dtyi,            dtzi          ) ;
-	            Coordinates3_IncrementRow ( gradients3, k,          dtxk,            dtyk,            dtzk   ) ;
-	            Coordinates3_DecrementRow ( gradients3, j, ( dtxi + dtxk ), ( dtyi + dtyk ), ( dtzi + dtzk ) ) ;
-        	}
-	    }
-	}
+                    i = self->terms[n].atom1 ;
+                    j = self->terms[n].atom2 ;
+                    k = self->terms[n].atom3 ;
+                    t = self->terms[n].type  ;
+                    Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
+                    rij = sqrt ( xij * xij + yij * yij + zij * zij ) ;
+                    rkj = sqrt ( xkj * xkj + ykj * ykj + zkj * zkj ) ;
+                    xij /= rij ; yij /= rij ; zij /= rij ;
+                    xkj /= rkj ; ykj /= rkj ; zkj /= rkj ;
+                    dot   = xij * xkj + yij * ykj + zij * zkj ;
+                    dot   = Maximum ( - DOT_LIMIT, dot ) ;
+                    dot   = Minimum (   DOT_LIMIT, dot ) ;
+                    theta = acos ( dot ) ;
+                    disp  = theta - self->parameters[t].eq ;
+                    df    = self->parameters[t].fc * disp  ;
+                    energy += ( df * disp ) ;
+                    if ( QGRADIENTS )
+                    {
+                        dtdx = - 1.0 / sqrt ( 1.0 - dot * dot ) ;
+                        df  *= ( 2.0e+00 * dtdx ) ;
+                        dtxi = df * ( xkj - dot * xij ) / rij ;
+                        dtyi = df * ( ykj - dot * yij ) / rij ;
+                        dtzi = df * ( zkj - dot * zij ) / rij ;
+                        dtxk = df * ( xij - dot * xkj ) / rkj ;
+                        dtyk = df * ( yij - dot * ykj ) / rkj ;
+                        dtzk = df * ( zij - dot * zkj ) / rkj ;
+                        Coordinates3_IncrementRow ( gradients3, i,   dtxi,            dtyi,            dtzi          ) ;
+                        Coordinates3_IncrementRow ( gradients3, k,          dtxk,            dtyk,            dtzk   ) ;
+                        Coordinates3_DecrementRow ( gradients3, j, ( dtxi + dtxk ), ( dtyi + dtyk ), ( dtzi + dtzk ) ) ;
+                    }
+                }
+            }
+        }
     }
     return energy ;
 }
 
+/*------------------------------------------------------------------------------
+! . Make the execution plan.
+! . This must be called whenever the terms or parameters are changed.
+!-----------------------------------------------------------------------------*/
+void HarmonicAngleContainer_MakePlan ( HarmonicAngleContainer *self )
+{
+    if ( self != NULL )
+    {
+        HarmonicAngleContainer_Sort  ( self ) ;
+        HarmonicAnglePlan_Deallocate ( &(self->plan) ) ;
+        self->plan = HarmonicAnglePlan_Make ( self ) ;
+    }
+}
+
 /*------------------------------------------------------------------------------
 ! . Merging.
 !-----------------------------------------------------------------------------*/
@@ -213,6 +242,7 @@ HarmonicAngleContainer *HarmonicAngleContainer_Merge ( const HarmonicAngleContai
             new->parameters[i+self->nParameters].fc = other->parameters[i].fc ;
         }
         new->isSorted = ( self->isSorted && other->isSorted ) ;
+        HarmonicAngleContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -276,6 +306,7 @@ HarmonicAngleContainer *HarmonicAngleContainer_Prune ( HarmonicAngleContainer *s
                 }
             }
             new->isSorted = self->isSorted ;
+            HarmonicAngleContainer_MakePlan ( new ) ;
 	}
 	Boolean_Deallocate ( &toKeep ) ;
     }
@@ -329,6 +360,137 @@ int HarmonicAngleContainer_UpperBound ( HarmonicAngleContainer *self )
 /*==============================================================================
 ! . Private procedures.
 !============================================================================*/
+/*------------------------------------------------------------------------------
+! . Plan allocation.
+! . NULL is returned if there are no terms or the allocation fails.
+!-----------------------------------------------------------------------------*/
+static HarmonicAnglePlan *HarmonicAnglePlan_Allocate ( const Integer nTerms )
+{
+    HarmonicAnglePlan *self = NULL ;
+    if ( nTerms > 0 )
+    {
+        self = Memory_AllocateType ( HarmonicAnglePlan ) ;
+        if ( self != NULL )
+        {
+            self->nTerms = nTerms ;
+            self->atom1  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom2  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom3  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->eq     = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            self->fc     = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            if ( ( self->atom1 == NULL ) || ( self->atom2 == NULL ) ||
+                 ( self->atom3 == NULL ) || ( self->eq    == NULL ) ||
+                 ( self->fc    == NULL ) ) HarmonicAnglePlan_Deallocate ( &self ) ;
+        }
+    }
+    return self ;
+}
+
+/*------------------------------------------------------------------------------
+! . Plan deallocation.
+!-----------------------------------------------------------------------------*/
+static void HarmonicAnglePlan_Deallocate ( HarmonicAnglePlan **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->atom1 ) ;
+        Memory_Deallocate ( (*self)->atom2 ) ;
+        Memory_Deallocate ( (*self)->atom3 ) ;
+        Memory_Deallocate ( (*self)->eq    ) ;
+        Memory_Deallocate ( (*self)->fc    ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*------------------------------------------------------------------------------
+! . Plan energy and gradients.
+! . There are no inactive terms or parameter look-ups in the loop.
+! . The gradients of each thread are accumulated in separate buffers.
+!-----------------------------------------------------------------------------*/
+static Real HarmonicAnglePlan_Energy ( const HarmonicAnglePlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
+{
+    Real energy = 0.0e+00 ;
+    auto Boolean  QGRADIENTS ;
+    auto Integer  numberOfThreads ;
+    auto Real    *buffers ;
+    QGRADIENTS = ( gradients3 != NULL ) ;
+    buffers    = Coordinates3_AllocateThreadBuffersForWork ( gradients3, self->nTerms, &numberOfThreads ) ;
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
+    {
+        auto Coordinates3 view, *threadGradients3 ;
+        auto Real df, disp, dot, dtdx, dtxi, dtxk, dtyi, dtyk, dtzi, dtzk, rij, rkj, theta, xij, yij, zij, xkj, ykj, zkj ;
+        auto Integer i, j, k, n ;
+        threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, buffers, &view ) ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( static )
+# endif
+        for ( n = 0 ; n < self->nTerms ; n++ )
+        {
+            i = self->atom1[n] ;
+            j = self->atom2[n] ;
+            k = self->atom3[n] ;
+            Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+            Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
+            rij = sqrt ( xij * xij + yij * yij + zij * zij ) ;
+            rkj = sqrt ( xkj * xkj + ykj * ykj + zkj * zkj ) ;
+            xij /= rij ; yij /= rij ; zij /= rij ;
+            xkj /= rkj ; ykj /= rkj ; zkj /= rkj ;
+            dot   = xij * xkj + yij * ykj + zij * zkj ;
+            dot   = Maximum ( - DOT_LIMIT, dot ) ;
+            dot   = Minimum (   DOT_LIMIT, dot ) ;
+            theta = acos ( dot ) ;
+            disp  = theta - self->eq[n] ;
+            df    = self->fc[n] * disp  ;
+            energy += ( df * disp ) ;
+            if ( QGRADIENTS )
+            {
+                dtdx = - 1.0 / sqrt ( 1.0 - dot * dot ) ;
+                df  *= ( 2.0e+00 * dtdx ) ;
+                dtxi = df * ( xkj - dot * xij ) / rij ;
+                dtyi = df * ( ykj - dot * yij ) / rij ;
+                dtzi = df * ( zkj - dot * zij ) / rij ;
+                dtxk = df * ( xij - dot * xkj ) / rkj ;
+                dtyk = df * ( yij - dot * ykj ) / rkj ;
+                dtzk = df * ( zij - dot * zkj ) / rkj ;
+                Coordinates3_IncrementRow ( threadGradients3, i,   dtxi,            dtyi,            dtzi          ) ;
+                Coordinates3_IncrementRow ( threadGradients3, k,          dtxk,            dtyk,            dtzk   ) ;
+                Coordinates3_DecrementRow ( threadGradients3, j, ( dtxi + dtxk ), ( dtyi + dtyk ), ( dtzi + dtzk ) ) ;
+            }
+        }
+    }
+    Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &buffers ) ;
+    return energy ;
+}
+
+/*------------------------------------------------------------------------------
+! . Make a plan from the active terms of a container.
+!-----------------------------------------------------------------------------*/
+static HarmonicAnglePlan *HarmonicAnglePlan_Make ( const HarmonicAngleContainer *self )
+{
+    HarmonicAnglePlan *plan ;
+    plan = HarmonicAnglePlan_Allocate ( self->nTerms - HarmonicAngleContainer_NumberOfInactiveTerms ( self ) ) ;
+    if ( plan != NULL )
+    {
+        auto Integer m, n, t ;
+        for ( m = n = 0 ; n < self->nTerms ; n++ )
+        {
+            if ( self->terms[n].isActive )
+            {
+                t = self->terms[n].type ;
+                plan->atom1[m] = self->terms[n].atom1 ;
+                plan->atom2[m] = self->terms[n].atom2 ;
+                plan->atom3[m] = self->terms[n].atom3 ;
+                plan->eq   [m] = self->parameters[t].eq ;
+                plan->fc   [m] = self->parameters[t].fc ;
+                m++ ;
+            }
+        }
+    }
+    return plan ;
+}
+
 static Integer HarmonicAngleTerm_Compare ( const void *vTerm1, const void *vTerm2 )
 {
     HarmonicAngle *term1, *term2 ;
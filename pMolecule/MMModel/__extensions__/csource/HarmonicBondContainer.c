@@ -12,7 +12,11 @@
 /*------------------------------------------------------------------------------
 ! . Local procedures.
 !-----------------------------------------------------------------------------*/
-static Integer HarmonicBondTerm_Compare ( const void *vTerm1, const void *vTerm2 ) ;
+static HarmonicBondPlan *HarmonicBondPlan_Allocate   ( const Integer nTerms ) ;
+static void              HarmonicBondPlan_Deallocate ( HarmonicBondPlan **self ) ;
+static Real              HarmonicBondPlan_Energy     ( const HarmonicBondPlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
+static HarmonicBondPlan *HarmonicBondPlan_Make       ( const HarmonicBondContainer *self ) ;
+static Integer           HarmonicBondTerm_Compare    ( const void *vTerm1, const void *vTerm2 ) ;
 
 /*==============================================================================
 ! . Standard procedures.
@@ -26,6 +30,7 @@ void HarmonicBondContainer_ActivateTerms ( HarmonicBondContainer *self )
     {
         auto Integer i ;
 	for ( i = 0 ; i < self->nTerms ; i++ ) self->terms[i].isActive = True ;
+        HarmonicBondContainer_MakePlan ( self ) ;
     }
 }
 
@@ -42,6 +47,7 @@ HarmonicBondContainer *HarmonicBondContainer_Allocate ( const Integer nTerms, co
         self->isSorted     = False       ;
 	self->nTerms      = nTerms      ;
 	self->nParameters = nParameters ;
+	self->plan        = NULL        ;
 	self->terms	  = Memory_AllocateArrayOfTypes ( nTerms     , HarmonicBond          ) ;
 	self->parameters  = Memory_AllocateArrayOfTypes ( nParameters, HarmonicBondParameter ) ;
 	/* . Make all terms inactive. */
@@ -73,6 +79,7 @@ HarmonicBondContainer *HarmonicBondContainer_Clone ( const HarmonicBondContainer
             new->parameters[i].fc = self->parameters[i].fc ;
         }
         new->isSorted = self->isSorted ;
+        HarmonicBondContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -96,6 +103,7 @@ void HarmonicBondContainer_DeactivateTerms ( HarmonicBondContainer *self, Select
                 self->terms[i].isActive = ( Block_Item ( flags, self->terms[i].atom1 ) || Block_Item ( flags, self->terms[i].atom2 ) ) ;
             }
 	}
+        HarmonicBondContainer_MakePlan ( self ) ;
     }
 }
 
@@ -106,6 +114,7 @@ void HarmonicBondContainer_Deallocate ( HarmonicBondContainer **self )
 {
     if ( (*self) != NULL )
     {
+        HarmonicBondPlan_Deallocate ( &((*self)->plan) ) ;
         Memory_Deallocate ( (*self)->terms      ) ;
         Memory_Deallocate ( (*self)->parameters ) ;
         Memory_Deallocate ( (*self) ) ;
@@ -114,39 +123,45 @@ void HarmonicBondContainer_Deallocate ( HarmonicBondContainer **self )
 
 /*------------------------------------------------------------------------------
 ! . Energy and gradients.
+! . The plan is used if there is one and the active terms of the container
+! . otherwise (for example, if the plan could not be allocated).
 !-----------------------------------------------------------------------------*/
 double HarmonicBondContainer_Energy ( const HarmonicBondContainer *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
 {
     Real energy = 0.0e+00 ;
     if ( ( self != NULL ) && ( coordinates3 != NULL ) )
     {
-	auto Boolean   QGRADIENTS ;
-	auto Real df, disp, rij, xij, yij, zij ;
-	auto Integer    i, j, n, t ;
-	QGRADIENTS = ( gradients3 != NULL ) ;
-	for ( n = 0 ; n < self->nTerms ; n++ )
-	{
-	    if ( self->terms[n].isActive )
-	    {
-		i = self->terms[n].atom1 ;
-		j = self->terms[n].atom2 ;
-		t = self->terms[n].type  ;
-		Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
-		rij  = sqrt ( xij * xij + yij * yij + zij * zij ) ;
-		disp = rij - self->parameters[t].eq ;
-		df   = self->parameters[t].fc * disp ;
-		energy += ( df * disp ) ;
-        	if ( QGRADIENTS )
-        	{
-        	    df  *= ( 2.0e+00 / rij ) ;
-		    xij *= df ;
-		    yij *= df ;
-		    zij *= df ;
-		    Coordinates3_IncrementRow ( gradients3, i, xij, yij, zij ) ;
-		    Coordinates3_DecrementRow ( gradients3, j, xij, yij, zij ) ;
-        	}
-	    }
-	}
+        if ( self->plan != NULL ) energy = HarmonicBondPlan_Energy ( self->plan, coordinates3, gradients3 ) ;
+        else
+        {
+            auto Boolean   QGRADIENTS ;
+            auto Real df, disp, rij, xij, yij, zij ;
+            auto Integer    i, j, n, t ;
+            QGRADIENTS = ( gradients3 != NULL ) ;
+            for ( n = 0 ; n < self->nTerms ; n++ )
+            {
+                if ( self->terms[n].isActive )
+                {
+                    i = self->terms[n].atom1 ;
+                    j = self->terms[n].atom2 ;
+                    t = self->terms[n].type  ;
+                    Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+                    rij  = sqrt ( xij * xij + yij * yij + zij * zij ) ;
+                    disp = rij - self->parameters[t].eq ;
+                    df   = self->parameters[t].fc * disp ;
+                    energy += ( df * disp ) ;
+                    if ( QGRADIENTS )
+                    {
+                        df  *= ( 2.0e+00 / rij ) ;
+                        xij *= df ;
+                        yij *= df ;
+                        zij *= df ;
+                        Coordinates3_IncrementRow ( gradients3, i, xij, yij, zij ) ;
+                        Coordinates3_DecrementRow ( gradients3, j, xij, yij, zij ) ;
+                    }
+                }
+            }
+        }
     }
     return energy ;
 }
@@ -196,6 +211,20 @@ int HarmonicBondContainer_IdentifyBoundaryAtoms ( HarmonicBondContainer *self, S
     return n ;
 }
 
+/*------------------------------------------------------------------------------
+! . Make the execution plan.
+! . This must be called whenever the terms or parameters are changed.
+!-----------------------------------------------------------------------------*/
+void HarmonicBondContainer_MakePlan ( HarmonicBondContainer *self )
+{
+    if ( self != NULL )
+    {
+        HarmonicBondContainer_Sort  ( self ) ;
+        HarmonicBondPlan_Deallocate ( &(self->plan) ) ;
+        self->plan = HarmonicBondPlan_Make ( self ) ;
+    }
+}
+
 /*------------------------------------------------------------------------------
 ! . Merging.
 !-----------------------------------------------------------------------------*/
@@ -231,6 +260,7 @@ HarmonicBondContainer *HarmonicBondContainer_Merge ( const HarmonicBondContainer
             new->parameters[i+self->nParameters].fc = other->parameters[i].fc ;
         }
         new->isSorted = ( self->isSorted && other->isSorted ) ;
+        HarmonicBondContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -292,6 +322,7 @@ HarmonicBondContainer *HarmonicBondContainer_Prune ( HarmonicBondContainer *self
                 }
             }
             new->isSorted = self->isSorted ;
+            HarmonicBondContainer_MakePlan ( new ) ;
 	}
 	Boolean_Deallocate ( &toKeep ) ;
     }
@@ -345,6 +376,119 @@ int HarmonicBondContainer_UpperBound ( HarmonicBondContainer *self )
 /*==============================================================================
 ! . Private procedures.
 !============================================================================*/
+/*------------------------------------------------------------------------------
+! . Plan allocation.
+! . NULL is returned if there are no terms or the allocation fails.
+!-----------------------------------------------------------------------------*/
+static HarmonicBondPlan *HarmonicBondPlan_Allocate ( const Integer nTerms )
+{
+    HarmonicBondPlan *self = NULL ;
+    if ( nTerms > 0 )
+    {
+        self = Memory_AllocateType ( HarmonicBondPlan ) ;
+        if ( self != NULL )
+        {
+            self->nTerms = nTerms ;
+            self->atom1  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom2  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->eq     = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            self->fc     = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            if ( ( self->atom1 == NULL ) || ( self->atom2 == NULL ) ||
+                 ( self->eq    == NULL ) || ( self->fc    == NULL ) ) HarmonicBondPlan_Deallocate ( &self ) ;
+        }
+    }
+    return self ;
+}
+
+/*------------------------------------------------------------------------------
+! . Plan deallocation.
+!-----------------------------------------------------------------------------*/
+static void HarmonicBondPlan_Deallocate ( HarmonicBondPlan **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->atom1 ) ;
+        Memory_Deallocate ( (*self)->atom2 ) ;
+        Memory_Deallocate ( (*self)->eq    ) ;
+        Memory_Deallocate ( (*self)->fc    ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*------------------------------------------------------------------------------
+! . Plan energy and gradients.
+! . There are no inactive terms or parameter look-ups in the loop.
+! . The gradients of each thread are accumulated in separate buffers.
+!-----------------------------------------------------------------------------*/
+static Real HarmonicBondPlan_Energy ( const HarmonicBondPlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
+{
+    Real energy = 0.0e+00 ;
+    auto Boolean  QGRADIENTS ;
+    auto Integer  numberOfThreads ;
+    auto Real    *buffers ;
+    QGRADIENTS = ( gradients3 != NULL ) ;
+    buffers    = Coordinates3_AllocateThreadBuffersForWork ( gradients3, self->nTerms, &numberOfThreads ) ;
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
+    {
+        auto Coordinates3 view, *threadGradients3 ;
+        auto Real df, disp, rij, xij, yij, zij ;
+        auto Integer i, j, n ;
+        threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, buffers, &view ) ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( static )
+# endif
+        for ( n = 0 ; n < self->nTerms ; n++ )
+        {
+            i = self->atom1[n] ;
+            j = self->atom2[n] ;
+            Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+            rij  = sqrt ( xij * xij + yij * yij + zij * zij ) ;
+            disp = rij - self->eq[n] ;
+            df   = self->fc[n] * disp ;
+            energy += ( df * disp ) ;
+            if ( QGRADIENTS )
+            {
+                df  *= ( 2.0e+00 / rij ) ;
+                xij *= df ;
+                yij *= df ;
+                zij *= df ;
+                Coordinates3_IncrementRow ( threadGradients3, i, xij, yij, zij ) ;
+                Coordinates3_DecrementRow ( threadGradients3, j, xij, yij, zij ) ;
+            }
+        }
+    }
+    Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &buffers ) ;
+    return energy ;
+}
+
+/*------------------------------------------------------------------------------
+! . Make a plan from the active terms of a container.
+!-----------------------------------------------------------------------------*/
+static HarmonicBondPlan *HarmonicBondPlan_Make ( const HarmonicBondContainer *self )
+{
+    HarmonicBondPlan *plan ;
+    plan = HarmonicBondPlan_Allocate ( self->nTerms - HarmonicBondContainer_NumberOfInactiveTerms ( self ) ) ;
+    if ( plan != NULL )
+    {
+        auto Integer m, n, t ;
+        for ( m = n = 0 ; n < self->nTerms ; n++ )
+        {
+            if ( self->terms[n].isActive )
+            {
+                t = self->terms[n].type ;
+                plan->atom1[m] = self->terms[n].atom1 ;
+                plan->atom2[m] = self->terms[n].atom2 ;
+                plan->eq   [m] = self->parameters[t].eq ;
+                plan->fc   [m] = self->parameters[t].fc ;
+                m++ ;
+            }
+        }
+    }
+    return plan ;
+}
+
 static Integer HarmonicBondTerm_Compare ( const void *vTerm1, const void *vTerm2 )
 {
     HarmonicBond *term1, *term2 ;
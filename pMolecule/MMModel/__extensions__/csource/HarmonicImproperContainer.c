@@ -12,7 +12,11 @@
 /*------------------------------------------------------------------------------
 ! . Local procedures.
 !-----------------------------------------------------------------------------*/
-static Integer HarmonicImproperTerm_Compare ( const void *vTerm1, const void *vTerm2 ) ;
+static HarmonicImproperPlan *HarmonicImproperPlan_Allocate   ( const Integer nTerms ) ;
+static void                  HarmonicImproperPlan_Deallocate ( HarmonicImproperPlan **self ) ;
+static Real                  HarmonicImproperPlan_Energy     ( const HarmonicImproperPlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 ) ;
+static HarmonicImproperPlan *HarmonicImproperPlan_Make       ( const HarmonicImproperContainer *self ) ;
+static Integer               HarmonicImproperTerm_Compare    ( const void *vTerm1, const void *vTerm2 ) ;
 
 /*==============================================================================
 ! . Procedures.
@@ -26,6 +30,7 @@ void HarmonicImproperContainer_ActivateTerms ( HarmonicImproperContainer *self )
     {
         auto Integer i ;
 	for ( i = 0 ; i < self->nTerms ; i++ ) self->terms[i].isActive = True ;
+        HarmonicImproperContainer_MakePlan ( self ) ;
     }
 }
 
@@ -42,6 +47,7 @@ HarmonicImproperContainer *HarmonicImproperContainer_Allocate ( const Integer nT
         self->isSorted     = False       ;
 	self->nTerms      = nTerms      ;
 	self->nParameters = nParameters ;
+	self->plan        = NULL        ;
 	self->terms	  = Memory_AllocateArrayOfTypes ( nTerms     , HarmonicImproper          ) ;
 	self->parameters  = Memory_AllocateArrayOfTypes ( nParameters, HarmonicImproperParameter ) ;
 	/* . Make all terms inactive. */
@@ -77,6 +83,7 @@ HarmonicImproperContainer *HarmonicImproperContainer_Clone ( const HarmonicImpro
             new->parameters[i].sineq = self->parameters[i].sineq ;
         }
         new->isSorted = self->isSorted ;
+        HarmonicImproperContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -103,6 +110,7 @@ void HarmonicImproperContainer_DeactivateTerms ( HarmonicImproperContainer *self
                                             Block_Item ( flags, self->terms[i].atom4 ) ) ;
             }
 	}
+        HarmonicImproperContainer_MakePlan ( self ) ;
     }
 }
 
@@ -113,6 +121,7 @@ void HarmonicImproperContainer_Deallocate ( HarmonicImproperContainer **self )
 {
     if ( (*self) != NULL )
     {
+        HarmonicImproperPlan_Deallocate ( &((*self)->plan) ) ;
         Memory_Deallocate ( (*self)->terms      ) ;
         Memory_Deallocate ( (*self)->parameters ) ;
         Memory_Deallocate ( (*self) ) ;
@@ -132,12 +141,15 @@ void HarmonicImproperContainer_FillCosSinValues ( HarmonicImproperContainer *sel
             self->parameters[i].coseq = cos ( self->parameters[i].eq ) ;
             self->parameters[i].sineq = sin ( self->parameters[i].eq ) ;
         }
+        HarmonicImproperContainer_MakePlan ( self ) ;
     }
 }
 
 /*------------------------------------------------------------------------------
 ! . Energy and gradients.
 ! . Following Becker, Berendsen and van Gunsteren, JCC 16 p527 (1995).
+! . The plan is used if there is one and the active terms of the container
+! . otherwise (for example, if the plan could not be allocated).
 !-----------------------------------------------------------------------------*/
 # define LOWCOSPHI 0.1e+00
 double HarmonicImproperContainer_Energy ( const HarmonicImproperContainer *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
@@ -145,89 +157,107 @@ double HarmonicImproperContainer_Energy ( const HarmonicImproperContainer *self,
     Real energy = 0.0e+00 ;
     if ( ( self != NULL ) && ( coordinates3 != NULL ) )
     {
-	auto Boolean   QGRADIENTS ;
-        auto Real cosdphi, cosPhi, df, dotij, dotlk, dphi, mn, rkj, rkj2, sindphi, sinPhi ;
-        auto Real dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, m2, mx, my, mz, n2, nx, ny, nz, sx, sy, sz,
-                    xij, yij, zij, xkj, ykj, zkj, xlk, ylk, zlk ;
-        auto Integer    i, j, k, l, n, t ;
-	QGRADIENTS = ( gradients3 != NULL ) ;
-	for ( n = 0 ; n < self->nTerms ; n++ )
-	{
-	    if ( self->terms[n].isActive )
-	    {
-                /* . Local data. */
-	        i = self->terms[n].atom1 ;
-	        j = self->terms[n].atom2 ;
-	        k = self->terms[n].atom3 ;
-	        l = self->terms[n].atom4 ;
-	        t = self->terms[n].type  ;
-	        /* . Coordinate displacements. */
-	        Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
-	        Coordinates3_DifferenceRow ( coordinates3, l, k, xlk, ylk, zlk ) ;
-	        rkj2 = xkj * xkj + ykj * ykj + zkj * zkj ;
-	        rkj  = sqrt ( rkj2 ) ;
-                /* . m and n. */
-                mx = yij * zkj - zij * ykj ;
-	        my = zij * xkj - xij * zkj ;
-	        mz = xij * ykj - yij * xkj ;
-	        nx = ylk * zkj - zlk * ykj ;
-	        ny = zlk * xkj - xlk * zkj ;
-	        nz = xlk * ykj - ylk * xkj ;
-                m2 = mx * mx + my * my + mz * mz ;
-	        n2 = nx * nx + ny * ny + nz * nz ;
-	        mn = sqrt ( m2 * n2 ) ;
-                /* . Cosine and sine of the dihedral. */
-                cosPhi =       (  mx * nx +  my * ny +  mz * nz ) / mn ;
-                sinPhi = rkj * ( xij * nx + yij * ny + zij * nz ) / mn ;
-                /* . Cosine and sine of (phi - phi0). */
-                cosdphi = cosPhi * self->parameters[t].coseq + sinPhi * self->parameters[t].sineq ;
-                sindphi = sinPhi * self->parameters[t].coseq - cosPhi * self->parameters[t].sineq ;
-                /* . Follow CHARMM here. */
-                if ( cosdphi > LOWCOSPHI ) dphi = asin ( sindphi ) ;
-                else
+        if ( self->plan != NULL ) energy = HarmonicImproperPlan_Energy ( self->plan, coordinates3, gradients3 ) ;
+        else
+        {
+            auto Boolean   QGRADIENTS ;
+            auto Real cosdphi, cosPhi, df, dotij, dotlk, dphi, mn, rkj, rkj2, sindphi, sinPhi ;
+            auto Real dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, m2, mx, my, mz, n2, nx, ny, nz, sx, sy, sz,
+                        xij, yij, zij, xkj, ykj, zkj, xlk, ylk, zlk ;
+            auto Integer    i, j, k, l, n, t ;
+            QGRADIENTS = ( gradients3 != NULL ) ;
+            for ( n = 0 ; n < self->nTerms ; n++ )
+            {
+                if ( self->terms[n].isActive )
                 {
-                    dphi = fabs ( acos ( Maximum ( cosdphi, -1.0e+00 ) ) ) ;
-                    if ( sindphi < 0.0e+00 ) dphi *= -1.0e+00 ;
+                    /* . Local data. */
+                    i = self->terms[n].atom1 ;
+                    j = self->terms[n].atom2 ;
+                    k = self->terms[n].atom3 ;
+                    l = self->terms[n].atom4 ;
+                    t = self->terms[n].type  ;
+                    /* . Coordinate displacements. */
+                    Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
+                    Coordinates3_DifferenceRow ( coordinates3, l, k, xlk, ylk, zlk ) ;
+                    rkj2 = xkj * xkj + ykj * ykj + zkj * zkj ;
+                    rkj  = sqrt ( rkj2 ) ;
+                    /* . m and n. */
+                    mx = yij * zkj - zij * ykj ;
+                    my = zij * xkj - xij * zkj ;
+                    mz = xij * ykj - yij * xkj ;
+                    nx = ylk * zkj - zlk * ykj ;
+                    ny = zlk * xkj - xlk * zkj ;
+                    nz = xlk * ykj - ylk * xkj ;
+                    m2 = mx * mx + my * my + mz * mz ;
+                    n2 = nx * nx + ny * ny + nz * nz ;
+                    mn = sqrt ( m2 * n2 ) ;
+                    /* . Cosine and sine of the dihedral. */
+                    cosPhi =       (  mx * nx +  my * ny +  mz * nz ) / mn ;
+                    sinPhi = rkj * ( xij * nx + yij * ny + zij * nz ) / mn ;
+                    /* . Cosine and sine of (phi - phi0). */
+                    cosdphi = cosPhi * self->parameters[t].coseq + sinPhi * self->parameters[t].sineq ;
+                    sindphi = sinPhi * self->parameters[t].coseq - cosPhi * self->parameters[t].sineq ;
+                    /* . Follow CHARMM here. */
+                    if ( cosdphi > LOWCOSPHI ) dphi = asin ( sindphi ) ;
+                    else
+                    {
+                        dphi = fabs ( acos ( Maximum ( cosdphi, -1.0e+00 ) ) ) ;
+                        if ( sindphi < 0.0e+00 ) dphi *= -1.0e+00 ;
+                    }
+                    /* . The energy term. */
+                    df      = self->parameters[t].fc * dphi ;
+                    energy += df * dphi ;
+                    if ( QGRADIENTS )
+                    {
+                        /* . The derivatives. */
+                        df *= 2.0e+00 ;
+                        /* . i and l. */
+                        dtxi =   df * rkj * mx / m2 ;
+                        dtyi =   df * rkj * my / m2 ;
+                        dtzi =   df * rkj * mz / m2 ;
+                        dtxl = - df * rkj * nx / n2 ;
+                        dtyl = - df * rkj * ny / n2 ;
+                        dtzl = - df * rkj * nz / n2 ;
+                        /* . j and k. */
+                        dotij = xij * xkj + yij * ykj + zij * zkj ;
+                        dotlk = xlk * xkj + ylk * ykj + zlk * zkj ;
+                        sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj2 ;
+                        sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj2 ;
+                        sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj2 ;
+                        dtxj  =   sx - dtxi ;
+                        dtyj  =   sy - dtyi ;
+                        dtzj  =   sz - dtzi ;
+                        dtxk  = - sx - dtxl ;
+                        dtyk  = - sy - dtyl ;
+                        dtzk  = - sz - dtzl ;
+                        /* . Add in the contributions. */
+                        Coordinates3_IncrementRow ( gradients3, i, dtxi, dtyi, dtzi ) ;
+                        Coordinates3_IncrementRow ( gradients3, j, dtxj, dtyj, dtzj ) ;
+                        Coordinates3_IncrementRow ( gradients3, k, dtxk, dtyk, dtzk ) ;
+                        Coordinates3_IncrementRow ( gradients3, l, dtxl, dtyl, dtzl ) ;
+                    }
                 }
-                /* . The energy term. */
-                df      = self->parameters[t].fc * dphi ;
-                energy += df * dphi ;
-                if ( QGRADIENTS )
-                {
-	            /* . The derivatives. */
-	            df *= 2.0e+00 ;
-                    /* . i and l. */
-                    dtxi =   df * rkj * mx / m2 ;
-                    dtyi =   df * rkj * my / m2 ;
-                    dtzi =   df * rkj * mz / m2 ;
-                    dtxl = - df * rkj * nx / n2 ;
-                    dtyl = - df * rkj * ny / n2 ;
-                    dtzl = - df * rkj * nz / n2 ;
-                    /* . j and k. */
-                    dotij = xij * xkj + yij * ykj + zij * zkj ;
-                    dotlk = xlk * xkj + ylk * ykj + zlk * zkj ;
-	            sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj2 ;
-	            sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj2 ;
-	            sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj2 ;
-	            dtxj  =   sx - dtxi ;
-	            dtyj  =   sy - dtyi ;
-	            dtzj  =   sz - dtzi ;
-	            dtxk  = - sx - dtxl ;
-	            dtyk  = - sy - dtyl ;
-	            dtzk  = - sz - dtzl ;
-                    /* . Add in the contributions. */
-	            Coordinates3_IncrementRow ( gradients3, i, dtxi, dtyi, dtzi ) ;
-	            Coordinates3_IncrementRow ( gradients3, j, dtxj, dtyj, dtzj ) ;
-	            Coordinates3_IncrementRow ( gradients3, k, dtxk, dtyk, dtzk ) ;
-	            Coordinates3_IncrementRow ( gradients3, l, dtxl, dtyl, dtzl ) ;
-        	}
-	    }
-	}
+            }
+        }
     }
     return energy ;
 }
 
+/*------------------------------------------------------------------------------
+! . Make the execution plan.
+! . This must be called whenever the terms or parameters are changed.
+!-----------------------------------------------------------------------------*/
+void HarmonicImproperContainer_MakePlan ( HarmonicImproperContainer *self )
+{
+    if ( self != NULL )
+    {
+        HarmonicImproperContainer_Sort  ( self ) ;
+        HarmonicImproperPlan_Deallocate ( &(self->plan) ) ;
+        self->plan = HarmonicImproperPlan_Make ( self ) ;
+    }
+}
+
 /*------------------------------------------------------------------------------
 ! . Merging.
 !-----------------------------------------------------------------------------*/
@@ -271,6 +301,7 @@ HarmonicImproperContainer *HarmonicImproperContainer_Merge ( const HarmonicImpro
             new->parameters[i+self->nParameters].sineq = other->parameters[i].sineq ;
         }
         new->isSorted = ( self->isSorted && other->isSorted ) ;
+        HarmonicImproperContainer_MakePlan ( new ) ;
     }
     return new ;
 }
@@ -338,6 +369,7 @@ HarmonicImproperContainer *HarmonicImproperContainer_Prune ( HarmonicImproperCon
                 }
             }
             new->isSorted = self->isSorted ;
+            HarmonicImproperContainer_MakePlan ( new ) ;
 	}
 	Boolean_Deallocate ( &toKeep ) ;
     }
@@ -397,6 +429,182 @@ int HarmonicImproperContainer_UpperBound ( HarmonicImproperContainer *self )
 /*==============================================================================
 ! . Private procedures.
 !============================================================================*/
+/*------------------------------------------------------------------------------
+! . Plan allocation.
+! . NULL is returned if there are no terms or the allocation fails.
+!-----------------------------------------------------------------------------*/
+static HarmonicImproperPlan *HarmonicImproperPlan_Allocate ( const Integer nTerms )
+{
+    HarmonicImproperPlan *self = NULL ;
+    if ( nTerms > 0 )
+    {
+        self = Memory_AllocateType ( HarmonicImproperPlan ) ;
+        if ( self != NULL )
+        {
+            self->nTerms = nTerms ;
+            self->atom1  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom2  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom3  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->atom4  = Memory_AllocateArrayOfTypes ( nTerms, Integer ) ;
+            self->fc     = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            self->coseq  = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            self->sineq  = Memory_AllocateArrayOfTypes ( nTerms, Real    ) ;
+            if ( ( self->atom1 == NULL ) || ( self->atom2 == NULL ) ||
+                 ( self->atom3 == NULL ) || ( self->atom4 == NULL ) ||
+                 ( self->fc    == NULL ) || ( self->coseq == NULL ) ||
+                 ( self->sineq == NULL ) ) HarmonicImproperPlan_Deallocate ( &self ) ;
+        }
+    }
+    return self ;
+}
+
+/*------------------------------------------------------------------------------
+! . Plan deallocation.
+!-----------------------------------------------------------------------------*/
+static void HarmonicImproperPlan_Deallocate ( HarmonicImproperPlan **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->atom1 ) ;
+        Memory_Deallocate ( (*self)->atom2 ) ;
+        Memory_Deallocate ( (*self)->atom3 ) ;
+        Memory_Deallocate ( (*self)->atom4 ) ;
+        Memory_Deallocate ( (*self)->fc    ) ;
+        Memory_Deallocate ( (*self)->coseq ) ;
+        Memory_Deallocate ( (*self)->sineq ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*------------------------------------------------------------------------------
+! . Plan energy and gradients.
+! . There are no inactive terms or parameter look-ups in the loop.
+! . The gradients of each thread are accumulated in separate buffers.
+!-----------------------------------------------------------------------------*/
+static Real HarmonicImproperPlan_Energy ( const HarmonicImproperPlan *self, const Coordinates3 *coordinates3, Coordinates3 *gradients3 )
+{
+    Real energy = 0.0e+00 ;
+    auto Boolean  QGRADIENTS ;
+    auto Integer  numberOfThreads ;
+    auto Real    *buffers ;
+    QGRADIENTS = ( gradients3 != NULL ) ;
+    buffers    = Coordinates3_AllocateThreadBuffersForWork ( gradients3, self->nTerms, &numberOfThreads ) ;
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
+    {
+        auto Coordinates3 view, *threadGradients3 ;
+        auto Real cosdphi, cosPhi, df, dotij, dotlk, dphi, mn, rkj, rkj2, sindphi, sinPhi ;
+        auto Real dtxi, dtyi, dtzi, dtxj, dtyj, dtzj, dtxk, dtyk, dtzk, dtxl, dtyl, dtzl, m2, mx, my, mz, n2, nx, ny, nz, sx, sy, sz,
+                  xij, yij, zij, xkj, ykj, zkj, xlk, ylk, zlk ;
+        auto Integer i, j, k, l, n ;
+        threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, buffers, &view ) ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( static )
+# endif
+        for ( n = 0 ; n < self->nTerms ; n++ )
+        {
+            /* . Local data. */
+            i = self->atom1[n] ;
+            j = self->atom2[n] ;
+            k = self->atom3[n] ;
+            l = self->atom4[n] ;
+            /* . Coordinate displacements. */
+            Coordinates3_DifferenceRow ( coordinates3, i, j, xij, yij, zij ) ;
+            Coordinates3_DifferenceRow ( coordinates3, k, j, xkj, ykj, zkj ) ;
+            Coordinates3_DifferenceRow ( coordinates3, l, k, xlk, ylk, zlk ) ;
+            rkj2 = xkj * xkj + ykj * ykj + zkj * zkj ;
+            rkj  = sqrt ( rkj2 ) ;
+            /* . m and n. */
+            mx = yij * zkj - zij * ykj ;
+            my = zij * xkj - xij * zkj ;
+            mz = xij * ykj - yij * xkj ;
+            nx = ylk * zkj - zlk * ykj ;
+            ny = zlk * xkj - xlk * zkj ;
+            nz = xlk * ykj - ylk * xkj ;
+            m2 = mx * mx + my * my + mz * mz ;
+            n2 = nx * nx + ny * ny + nz * nz ;
+            mn = sqrt ( m2 * n2 ) ;
+            /* . Cosine and sine of the dihedral. */
+            cosPhi =       (  mx * nx +  my * ny +  mz * nz ) / mn ;
+            sinPhi = rkj * ( xij * nx + yij * ny + zij * nz ) / mn ;
+            /* . Cosine and sine of (phi - phi0). */
+            cosdphi = cosPhi * self->coseq[n] + sinPhi * self->sineq[n] ;
+            sindphi = sinPhi * self->coseq[n] - cosPhi * self->sineq[n] ;
+            /* . Follow CHARMM here. */
+            if ( cosdphi > LOWCOSPHI ) dphi = asin ( sindphi ) ;
+            else
+            {
+                dphi = fabs ( acos ( Maximum ( cosdphi, -1.0e+00 ) ) ) ;
+                if ( sindphi < 0.0e+00 ) dphi *= -1.0e+00 ;
+            }
+            /* . The energy term. */
+            df      = self->fc[n] * dphi ;
+            energy += df * dphi ;
+            if ( QGRADIENTS )
+            {
+                /* . The derivatives. */
+                df *= 2.0e+00 ;
+                /* . i and l. */
+                dtxi =   df * rkj * mx / m2 ;
+                dtyi =   df * rkj * my / m2 ;
+                dtzi =   df * rkj * mz / m2 ;
+                dtxl = - df * rkj * nx / n2 ;
+                dtyl = - df * rkj * ny / n2 ;
+                dtzl = - df * rkj * nz / n2 ;
+                /* . j and k. */
+                dotij = xij * xkj + yij * ykj + zij * zkj ;
+                dotlk = xlk * xkj + ylk * ykj + zlk * zkj ;
+                sx    = ( dotij * dtxi + dotlk * dtxl ) / rkj2 ;
+                sy    = ( dotij * dtyi + dotlk * dtyl ) / rkj2 ;
+                sz    = ( dotij * dtzi + dotlk * dtzl ) / rkj2 ;
+                dtxj  =   sx - dtxi ;
+                dtyj  =   sy - dtyi ;
+                dtzj  =   sz - dtzi ;
+                dtxk  = - sx - dtxl ;
+                dtyk  = - sy - dtyl ;
+                dtzk  = - sz - dtzl ;
+                /* . Add in the contributions. */
+                Coordinates3_IncrementRow ( threadGradients3, i, dtxi, dtyi, dtzi ) ;
+                Coordinates3_IncrementRow ( threadGradients3, j, dtxj, dtyj, dtzj ) ;
+                Coordinates3_IncrementRow ( threadGradients3, k, dtxk, dtyk, dtzk ) ;
+                Coordinates3_IncrementRow ( threadGradients3, l, dtxl, dtyl, dtzl ) ;
+            }
+        }
+    }
+    Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &buffers ) ;
+    return energy ;
+}
+
+/*------------------------------------------------------------------------------
+! . Make a plan from the active terms of a container.
+!-----------------------------------------------------------------------------*/
+static HarmonicImproperPlan *HarmonicImproperPlan_Make ( const HarmonicImproperContainer *self )
+{
+    HarmonicImproperPlan *plan ;
+    plan = HarmonicImproperPlan_Allocate ( self->nTerms - HarmonicImproperContainer_NumberOfInactiveTerms ( self ) ) ;
+    if ( plan != NULL )
+    {
+        auto Integer m, n, t ;
+        for ( m = n = 0 ; n < self->nTerms ; n++ )
+        {
+            if ( self->terms[n].isActive )
+            {
+                t = self->terms[n].type ;
+                plan->atom1[m] = self->terms[n].atom1 ;
+                plan->atom2[m] = self->terms[n].atom2 ;
+                plan->atom3[m] = self->terms[n].atom3 ;
+                plan->atom4[m] = self->terms[n].atom4 ;
+                plan->fc   [m] = self->parameters[t].fc ;
+                plan->coseq[m] = self->parameters[t].coseq ;
+                plan->sineq[m] = self->parameters[t].sineq ;
+                m++ ;
+            }
+        }
+    }
+    return plan ;
+}
+
 static Integer HarmonicImproperTerm_Compare ( const void *vTerm1, const void *vTerm2 )
 {
     HarmonicImproper *term1, *term2 ;
@@ -36,6 +36,7 @@ cdef extern from "CMAPDihedralContainer.h":
     cdef void                    CMAPDihedralContainer_DeactivateTerms       ( CCMAPDihedralContainer  *self, CSelection *selection )
     cdef void                    CMAPDihedralContainer_Deallocate            ( CCMAPDihedralContainer **self )
     cdef CReal                   CMAPDihedralContainer_Energy                ( CCMAPDihedralContainer  *self, CRealArray2D *coordinates3, CRealArray2D *gradients3 )
+    cdef void                    CMAPDihedralContainer_MakePatchTable        ( CCMAPDihedralContainer  *self )
     cdef CCMAPDihedralContainer *CMAPDihedralContainer_Merge                 ( CCMAPDihedralContainer  *self, CCMAPDihedralContainer *other, CInteger atomincrement )
     cdef CInteger                CMAPDihedralContainer_NumberOfInactiveTerms ( CCMAPDihedralContainer  *self )
     cdef CCMAPDihedralContainer *CMAPDihedralContainer_Prune                 ( CCMAPDihedralContainer  *self, CSelection *selection )
@@ -120,6 +120,8 @@ cdef class CMAPDihedralContainer ( MMTerm ):
             self.cObject.terms[i].type  = p
             if q: self.cObject.terms[i].isActive = CTrue
             else: self.cObject.terms[i].isActive = CFalse
+        # . Patch table.
+        CMAPDihedralContainer_MakePatchTable ( self.cObject )
 
     def _Allocate ( self, numberOfParameters, numberOfTerms ):
         """Allocation."""
@@ -57,6 +57,7 @@ cdef extern from "CosineTermContainer.h":
                                                                            CSelection            *selection     )
     cdef void                  CosineTermContainer_Deallocate            ( CCosineTermContainer **self          )
     cdef CInteger              CosineTermContainer_FindMaximumPeriod     ( CCosineTermContainer  *self          )
+    cdef void                  CosineTermContainer_MakePlan              ( CCosineTermContainer  *self          )
     cdef void                  CosineTermContainer_MakePowers            ( CCosineTermContainer  *self          )
     cdef CInteger              CosineTermContainer_NumberOfInactiveTerms ( CCosineTermContainer  *self          )
     cdef CCosineTermContainer *CosineTermContainer_Prune                 ( CCosineTermContainer  *self          ,
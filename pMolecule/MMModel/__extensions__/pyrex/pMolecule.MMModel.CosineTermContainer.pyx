@@ -192,6 +192,7 @@ cdef class CosineTermContainer ( MMTerm ):
         for i from 0 <= i < self.cObject.nTerms:
             iOld = self.cObject.terms[i].type
             self.cObject.terms[i].type = mapping[iOld]
+        CosineTermContainer_MakePlan ( self.cObject )
 
     def SummaryItems ( self ):
         """Summary entry."""
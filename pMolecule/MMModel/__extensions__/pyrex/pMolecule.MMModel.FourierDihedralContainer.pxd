@@ -37,6 +37,7 @@ cdef extern from "FourierDihedralContainer.h":
     cdef void                       FourierDihedralContainer_Deallocate            ( CFourierDihedralContainer **self )
     cdef void                       FourierDihedralContainer_FillCosSinPhases      ( CFourierDihedralContainer  *self )
     cdef CReal                      FourierDihedralContainer_Energy                ( CFourierDihedralContainer  *self, CRealArray2D *coordinates3, CRealArray2D *gradients3 )
+    cdef void                       FourierDihedralContainer_MakePlan              ( CFourierDihedralContainer  *self )
     cdef CFourierDihedralContainer *FourierDihedralContainer_Merge                 ( CFourierDihedralContainer  *self, CFourierDihedralContainer *other, CInteger atomincrement )
     cdef CInteger                   FourierDihedralContainer_NumberOfInactiveTerms ( CFourierDihedralContainer  *self )
     cdef CFourierDihedralContainer *FourierDihedralContainer_Prune                 ( CFourierDihedralContainer  *self, CSelection *selection )
@@ -211,6 +211,7 @@ cdef class FourierDihedralContainer ( MMTerm ):
         for i from 0 <= i < self.cObject.nTerms:
             iOld = self.cObject.terms[i].type
             self.cObject.terms[i].type = mapping[iOld]
+        FourierDihedralContainer_MakePlan ( self.cObject )
 
     def Sort ( self ):
         """Sorting."""
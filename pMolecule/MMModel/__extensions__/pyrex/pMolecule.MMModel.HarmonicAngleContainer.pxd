@@ -32,6 +32,7 @@ cdef extern from "HarmonicAngleContainer.h":
     cdef void                     HarmonicAngleContainer_DeactivateTerms       ( CHarmonicAngleContainer  *self, CSelection *selection )
     cdef void                     HarmonicAngleContainer_Deallocate            ( CHarmonicAngleContainer **self )
     cdef CReal                    HarmonicAngleContainer_Energy                ( CHarmonicAngleContainer  *self, CRealArray2D *coordinates3, CRealArray2D *gradients3 )
+    cdef void                     HarmonicAngleContainer_MakePlan              ( CHarmonicAngleContainer  *self )
     cdef CHarmonicAngleContainer *HarmonicAngleContainer_Merge                 ( CHarmonicAngleContainer  *self, CHarmonicAngleContainer *other, CInteger atomincrement )
     cdef CInteger                 HarmonicAngleContainer_NumberOfInactiveTerms ( CHarmonicAngleContainer  *self )
     cdef CHarmonicAngleContainer *HarmonicAngleContainer_Prune                 ( CHarmonicAngleContainer  *self, CSelection *selection )
@@ -83,6 +83,8 @@ cdef class HarmonicAngleContainer ( MMTerm ):
             self.cObject.terms[i].type  = p
             if q: self.cObject.terms[i].isActive = CTrue
             else: self.cObject.terms[i].isActive = CFalse
+        # . Finish processing.
+        HarmonicAngleContainer_MakePlan ( self.cObject )
 
     def _Allocate ( self, numberOfParameters, numberOfTerms ):
         """Allocation."""
@@ -194,6 +196,7 @@ cdef class HarmonicAngleContainer ( MMTerm ):
         for i from 0 <= i < self.cObject.nTerms:
             iOld = self.cObject.terms[i].type
             self.cObject.terms[i].type = mapping[iOld]
+        HarmonicAngleContainer_MakePlan ( self.cObject )
 
     def Sort ( self ):
         """Sorting."""
@@ -33,6 +33,7 @@ cdef extern from "HarmonicBondContainer.h":
     cdef void                    HarmonicBondContainer_Deallocate            ( CHarmonicBondContainer **self )
     cdef CReal                   HarmonicBondContainer_Energy                ( CHarmonicBondContainer  *self, CRealArray2D *coordinates3, CRealArray2D *gradients3 )
     cdef CInteger                HarmonicBondContainer_IdentifyBoundaryAtoms ( CHarmonicBondContainer  *self, CSelection *qcAtoms, CInteger **mmboundary, CInteger **qcpartners )
+    cdef void                    HarmonicBondContainer_MakePlan              ( CHarmonicBondContainer  *self )
     cdef CHarmonicBondContainer *HarmonicBondContainer_Merge                 ( CHarmonicBondContainer  *self, CHarmonicBondContainer *other, CInteger atomincrement )
     cdef CInteger                HarmonicBondContainer_NumberOfInactiveTerms ( CHarmonicBondContainer  *self )
     cdef CHarmonicBondContainer *HarmonicBondContainer_Prune                 ( CHarmonicBondContainer  *self, CSelection *selection )
@@ -93,6 +93,8 @@ cdef class HarmonicBondContainer ( MMTerm ):
             self.cObject.terms[i].type  = p
             if q: self.cObject.terms[i].isActive = CTrue
             else: self.cObject.terms[i].isActive = CFalse
+        # . Finish processing.
+        HarmonicBondContainer_MakePlan ( self.cObject )
 
     def _Allocate ( self, numberOfParameters, numberOfTerms ):
         """Allocation."""
@@ -280,6 +282,7 @@ cdef class HarmonicBondContainer ( MMTerm ):
         for i from 0 <= i < self.cObject.nTerms:
             iOld = self.cObject.terms[i].type
             self.cObject.terms[i].type = mapping[iOld]
+        HarmonicBondContainer_MakePlan ( self.cObject )
 
     def Sort ( self ):
         """Sorting."""
@@ -36,6 +36,7 @@ cdef extern from "HarmonicImproperContainer.h":
     cdef void                        HarmonicImproperContainer_Deallocate            ( CHarmonicImproperContainer **self )
     cdef void                        HarmonicImproperContainer_FillCosSinValues      ( CHarmonicImproperContainer  *self )
     cdef CReal                       HarmonicImproperContainer_Energy                ( CHarmonicImproperContainer  *self, CRealArray2D *coordinates3, CRealArray2D *gradients3 )
+    cdef void                        HarmonicImproperContainer_MakePlan              ( CHarmonicImproperContainer  *self )
     cdef CHarmonicImproperContainer *HarmonicImproperContainer_Merge                 ( CHarmonicImproperContainer  *self, CHarmonicImproperContainer *other, CInteger atomincrement )
     cdef CInteger                    HarmonicImproperContainer_NumberOfInactiveTerms ( CHarmonicImproperContainer  *self )
     cdef CHarmonicImproperContainer *HarmonicImproperContainer_Prune                 ( CHarmonicImproperContainer  *self, CSelection *selection )
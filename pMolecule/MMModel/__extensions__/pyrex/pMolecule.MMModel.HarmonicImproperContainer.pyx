@@ -204,6 +204,7 @@ cdef class HarmonicImproperContainer ( MMTerm ):
         for i from 0 <= i < self.cObject.nTerms:
             iOld = self.cObject.terms[i].type
             self.cObject.terms[i].type = mapping[iOld]
+        HarmonicImproperContainer_MakePlan ( self.cObject )
 
     def Sort ( self ):
         """Sorting."""
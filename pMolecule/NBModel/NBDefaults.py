@@ -70,12 +70,14 @@ def _DefaultPairwiseInteractionSplineABFSQCQC ( ):
 # . Attribute names in scratch.
 _CenteringTranslation3 = "centeringTranslation3"
 _ImageScanData         = "imageScanData"
+_IncrementalPairList   = "incrementalPairList"
 _MMGrid                = "mmGrid"
 _MMOccupancy           = "mmOccupancy"
 _NonUpdatablePairLists = "nonUpdatablePairLists"
 _PairListStatistics    = "pairListStatistics"
 _QCGrid                = "qcGrid"
 _QCOccupancy           = "qcOccupancy"
+_SPMEGrid              = "spmeGrid"
 _UpdatablePairLists    = "updatablePairLists"
 _UpdateChecker         = "updateChecker"
 
@@ -57,6 +57,10 @@ class NBModel ( EnergyModel ):
         def a ( ): self.EnergyInitialize ( target )
         return [ ( EnergyClosurePriority.NBInitialization, a, "NB Initialization" ) ]
 
+    def FastEnergyClosureLabels ( self, target ):
+        """Return the labels of the fast energy closures."""
+        return { "NB Initialization" }
+
     def EnergyInitialize ( self, target ):
         """Energy initialization."""
         target.scratch.GetSet ( _PairListStatistics, defaultdict, float )
@@ -3,20 +3,28 @@
 from   pCore                                 import logFile                         , \
                                                     LogFileActive                   , \
                                                     SelfPairList
+from   pScientific.Arrays                    import IntegerArray1D                  , \
+                                                    RealArray1D
 from   pScientific.Geometry3                 import Coordinates3                    , \
                                                     PairListGenerator
+from  .AtomOrdering                          import AtomOrdering
+from  .ClusterPairList                       import ClusterPairList
 from  .ImagePairListContainer                import ImagePairListContainer
 from  .ImageScanContainer                    import ImageScanContainer
+from  .IncrementalPairList                   import IncrementalPairList
+from  .MinimumImagePairList                  import MinimumImagePairList_SelfFromCoordinates3
 from  .NBDefaults                            import _CenteringTranslation3          , \
                                                     _CheckCutOffs                   , \
                                                     _DefaultGeneratorCutOff         , \
                                                     _DefaultPairwiseInteractionABFS , \
                                                     _ImageScanData                  , \
+                                                    _IncrementalPairList            , \
                                                     _MMGrid                         , \
                                                     _MMOccupancy                    , \
                                                     _NonUpdatablePairLists          , \
                                                     _PairListStatistics             , \
-                                                    _UpdatablePairLists
+                                                    _UpdatablePairLists             , \
+                                                    _UpdateChecker
 from  .NBModel                               import NBModel
 from  .PairwiseInteractionABFS               import PairwiseInteractionABFS
 from  .PairwiseInteractionSplineABFS         import PairwiseInteractionSplineABFS
@@ -41,13 +49,23 @@ class NBModelCutOff ( NBModel ):
     _classLabel               = "CutOff NB Model"
     _pairwiseInteractionClass = ( PairwiseInteractionABFS, PairwiseInteractionSplineABFS )
     _summarizable             = dict ( NBModel._summarizable )
-    _attributable.update ( { "checkForInverses"  : True ,
-                             "generator"         : None ,
-                             "imageExpandFactor" : 0    ,
-                             "useCentering"      : True ,
-                             "updateChecker"     : None } )
-    _summarizable.update ( { "generator"         : None            ,
-                             "useCentering"      : "Use Centering" } )
+    _attributable.update ( { "checkForInverses"      : True  ,
+                             "generator"             : None  ,
+                             "imageExpandFactor"     : 0     ,
+                             "useAtomOrdering"       : True  ,
+                             "useCentering"          : True  ,
+                             "useClusterPairList"    : True  ,
+                             "useIncrementalUpdates" : True  ,
+                             "useMinimumImage"       : True  ,
+                             "useSinglePrecision"    : False ,
+                             "updateChecker"         : None  } )
+    _summarizable.update ( { "generator"             : None                      ,
+                             "useAtomOrdering"       : "Use Atom Ordering"       ,
+                             "useCentering"          : "Use Centering"           ,
+                             "useClusterPairList"    : "Use Cluster Pair List"   ,
+                             "useIncrementalUpdates" : "Use Incremental Updates" ,
+                             "useMinimumImage"       : "Use Minimum Image"       ,
+                             "useSinglePrecision"    : "Use Single Precision"    } )
 
     def _CheckOptions ( self ):
         """Check options."""
@@ -93,23 +111,37 @@ class NBModelCutOff ( NBModel ):
         if self.updateChecker is None:
             buffer = self.generator.cutOff - self.pairwiseInteraction.range
             self.updateChecker = UpdateChecker.WithOptions ( buffer = buffer )
-        self.updateChecker.Check ( target )
+        self.updateChecker.Check ( target, isIncremental = self.UseIncrementalUpdates ( target ) )
 
     def Energy ( self, target ):
         """Energy 1-5+."""
+        if self.UseMinimumImage ( target ): return self.EnergyMinimumImage ( target )
         energies     = {}
         scratch      = target.scratch
         coordinates3 = scratch.Get ( "coordinates3NB", target.coordinates3 )
         pNode        = scratch.GetSetNode ( _UpdatablePairLists )
         pairList     = pNode.Get ( "mmmm", None )
         if pairList is None:
-            pairList = self.generator.SelfPairListFromCoordinates3 ( coordinates3                       ,
-                                                                     None                               ,
-                                                                     target.mmState.mmAtoms             ,
-                                                                     target.freeAtoms                   ,
-                                                                     target.mmState.exclusions          ,
-                                                                     pNode.Get ( _MMGrid       , None ) ,
-                                                                     pNode.Get ( _MMOccupancy  , None ) )
+            # . Incremental lists are made from the update checker's reference coordinates which are only changed for moved atoms.
+            if self.UseIncrementalUpdates ( target ):
+                uNode       = scratch.Get ( _UpdateChecker )
+                incremental = uNode.Get ( _IncrementalPairList, None )
+                if incremental is None:
+                    incremental = IncrementalPairList.WithOptions ( cellSize = self.generator.cellSize ,
+                                                                    cutOff   = self.generator.cutOff   )
+                    uNode.Set ( _IncrementalPairList, incremental )
+                pairList = incremental.Update ( uNode.coordinates3        ,
+                                                target.mmState.mmAtoms    ,
+                                                target.freeAtoms          ,
+                                                target.mmState.exclusions )
+            else:
+                pairList = self.generator.SelfPairListFromCoordinates3 ( coordinates3                       ,
+                                                                         None                               ,
+                                                                         target.mmState.mmAtoms             ,
+                                                                         target.freeAtoms                   ,
+                                                                         target.mmState.exclusions          ,
+                                                                         pNode.Get ( _MMGrid       , None ) ,
+                                                                         pNode.Get ( _MMOccupancy  , None ) )
             pNode.mmmm = pairList
             sNode      = scratch.Get ( _PairListStatistics )
             n          = float ( len ( pairList ) )
@@ -117,18 +149,69 @@ class NBModelCutOff ( NBModel ):
             sNode["<MM/MM Pairs>"] += n
         if len ( pairList ) > 0:
             gradients3 = scratch.Get ( "gradients3", None )
-            ( eElectrostatic, eLennardJones ) = self.pairwiseInteraction.MMMMEnergy ( target.mmState.charges       ,
-                                                                                      target.mmState.charges       ,
-                                                                                      target.mmState.ljTypeIndices ,
-                                                                                      target.mmState.ljTypeIndices ,
-                                                                                      target.mmState.ljParameters  ,
-                                                                                      ( 1.0 / self.dielectric )    ,
-                                                                                        1.0                        ,
-                                                                                      coordinates3                 ,
-                                                                                      coordinates3                 ,
-                                                                                      pairList                     ,
-                                                                                      gradients3                   ,
-                                                                                      gradients3                   )
+            # . The cluster pair list is only used with analytic ABFS interactions and is made with the pairlist.
+            # . Single precision, if requested, is only used for these interactions as the remaining terms are far fewer.
+            if self.useClusterPairList and isinstance ( self.pairwiseInteraction, PairwiseInteractionABFS ):
+                clusterPairList = pNode.Get ( "mmmmClusters", None )
+                if clusterPairList is None:
+                    clusterPairList    = ClusterPairList.FromSelfPairList ( pairList, coordinates3 )
+                    pNode.mmmmClusters = clusterPairList
+                ( eElectrostatic, eLennardJones ) = self.pairwiseInteraction.MMMMEnergyCluster ( target.mmState.charges       ,
+                                                                                                 target.mmState.ljTypeIndices ,
+                                                                                                 target.mmState.ljParameters  ,
+                                                                                                 ( 1.0 / self.dielectric )    ,
+                                                                                                   1.0                        ,
+                                                                                                 coordinates3                 ,
+                                                                                                 clusterPairList              ,
+                                                                                                 gradients3                   ,
+                                                                                                 useSinglePrecision = self.useSinglePrecision )
+            # . Otherwise the atoms can be ordered along a space-filling curve, made with the pairlist, for better memory locality.
+            # . The ordered data are gathered for each evaluation and the gradients mapped back.
+            elif self.useAtomOrdering:
+                ordering = pNode.Get ( "mmmmOrdering", None )
+                if ordering is None:
+                    ordering                  = AtomOrdering.FromSelfPairList ( pairList, coordinates3 )
+                    pNode.mmmmOrdering        = ordering
+                    pNode.mmmmOrderedPairList = ordering.OrderSelfPairList ( pairList )
+                    n                         = len ( ordering )
+                    pNode.mmmmOrderedData     = ( Coordinates3.WithExtent   ( n ) ,
+                                                  Coordinates3.WithExtent   ( n ) ,
+                                                  RealArray1D.WithExtent    ( n ) ,
+                                                  IntegerArray1D.WithExtent ( n ) )
+                ( oCoordinates3, oGradients3, oCharges, oLJTypeIndices ) = pNode.mmmmOrderedData
+                ordering.GatherCoordinates3   ( coordinates3                 , oCoordinates3  )
+                ordering.GatherRealArray1D    ( target.mmState.charges       , oCharges       )
+                ordering.GatherIntegerArray1D ( target.mmState.ljTypeIndices , oLJTypeIndices )
+                if gradients3 is None: oGradients3 = None
+                else:                  oGradients3.Set ( 0.0 )
+                ( eElectrostatic, eLennardJones ) = self.pairwiseInteraction.MMMMEnergy ( oCharges                    ,
+                                                                                          oCharges                    ,
+                                                                                          oLJTypeIndices              ,
+                                                                                          oLJTypeIndices              ,
+                                                                                          target.mmState.ljParameters ,
+                                                                                          ( 1.0 / self.dielectric )   ,
+                                                                                            1.0                       ,
+                                                                                          oCoordinates3               ,
+                                                                                          oCoordinates3               ,
+                                                                                          pNode.mmmmOrderedPairList   ,
+                                                                                          oGradients3                 ,
+                                                                                          oGradients3                 ,
+                                                                                          useSinglePrecision = self.useSinglePrecision )
+                if gradients3 is not None: ordering.ScatterAddCoordinates3 ( oGradients3, gradients3 )
+            else:
+                ( eElectrostatic, eLennardJones ) = self.pairwiseInteraction.MMMMEnergy ( target.mmState.charges       ,
+                                                                                          target.mmState.charges       ,
+                                                                                          target.mmState.ljTypeIndices ,
+                                                                                          target.mmState.ljTypeIndices ,
+                                                                                          target.mmState.ljParameters  ,
+                                                                                          ( 1.0 / self.dielectric )    ,
+                                                                                            1.0                        ,
+                                                                                          coordinates3                 ,
+                                                                                          coordinates3                 ,
+                                                                                          pairList                     ,
+                                                                                          gradients3                   ,
+                                                                                          gradients3                   ,
+                                                                                          useSinglePrecision = self.useSinglePrecision )
             energies.update ( { "MM/MM Electrostatic" : eElectrostatic ,
                                 "MM/MM Lennard-Jones" : eLennardJones  } )
         return energies
@@ -179,11 +262,17 @@ class NBModelCutOff ( NBModel ):
                             ( EnergyClosurePriority.IndependentEnergyTerm, c, "MM/MM Image NB Evaluation" ) ] )
         return closures
 
+    def FastEnergyClosureLabels ( self, target ):
+        """Return the labels of the fast energy closures (the short-range MM/MM terms)."""
+        labels = super ( NBModelCutOff, self ).FastEnergyClosureLabels ( target )
+        labels.update ( { "MM/MM NB Evaluation", "MM/MM 1-4 NB Evaluation", "MM/MM Image NB Evaluation" } )
+        return labels
+
     def EnergyImage ( self, target ):
         """Image energy."""
         energies           = {}
         symmetryParameters = target.symmetryParameters
-        if symmetryParameters is not None:
+        if ( symmetryParameters is not None ) and ( not self.UseMinimumImage ( target ) ):
             scratch      = target.scratch
             coordinates3 = scratch.Get ( "coordinates3NB", target.coordinates3 )
             pNode        = scratch.GetSetNode ( _UpdatablePairLists )
@@ -230,6 +319,45 @@ class NBModelCutOff ( NBModel ):
         self.CenterCoordinates     ( target )
         self.ImageUpdateInitialize ( target )
 
+    def EnergyMinimumImage ( self, target ):
+        """Energy 1-5+ including all images within the minimum image convention."""
+        energies           = {}
+        scratch            = target.scratch
+        coordinates3       = scratch.Get ( "coordinates3NB", target.coordinates3 )
+        symmetryParameters = target.symmetryParameters
+        pNode              = scratch.GetSetNode ( _UpdatablePairLists )
+        pairList           = pNode.Get ( "mmmmMI", None )
+        if pairList is None:
+            pairList     = MinimumImagePairList_SelfFromCoordinates3 ( self.generator.cutOff     ,
+                                                                       coordinates3              ,
+                                                                       symmetryParameters        ,
+                                                                       target.mmState.mmAtoms    ,
+                                                                       target.freeAtoms          ,
+                                                                       target.mmState.exclusions )
+            pNode.mmmmMI = pairList
+            sNode        = scratch.Get ( _PairListStatistics )
+            n            = float ( len ( pairList ) )
+            sNode[ "MM/MM Pairs" ]  = n
+            sNode["<MM/MM Pairs>"] += n
+        if len ( pairList ) > 0:
+            ( eElectrostatic, eLennardJones ) = self.pairwiseInteraction.MMMMEnergyMI ( target.mmState.charges       ,
+                                                                                        target.mmState.charges       ,
+                                                                                        target.mmState.ljTypeIndices ,
+                                                                                        target.mmState.ljTypeIndices ,
+                                                                                        target.mmState.ljParameters  ,
+                                                                                        ( 1.0 / self.dielectric )    ,
+                                                                                          1.0                        ,
+                                                                                        coordinates3                 ,
+                                                                                        coordinates3                 ,
+                                                                                        symmetryParameters           ,
+                                                                                        pairList                     ,
+                                                                                        scratch.Get ( "gradients3"                , None ) ,
+                                                                                        scratch.Get ( "gradients3"                , None ) ,
+                                                                                        scratch.Get ( "symmetryParameterGradients", None ) )
+            energies.update ( { "MM/MM Electrostatic" : eElectrostatic ,
+                                "MM/MM Lennard-Jones" : eLennardJones  } )
+        return energies
+
     def ImageUpdateInitialize ( self, target ):
         """Set up data for image calculation."""
         # . MM grids and scan data.
@@ -245,7 +373,8 @@ class NBModelCutOff ( NBModel ):
                 ( grid, occupancy ) = coordinates3.MakeGridAndOccupancy ( self.generator.cellSize )
                 pNode.Set ( _MMGrid     , grid      )
                 pNode.Set ( _MMOccupancy, occupancy )
-            if scanData is None:
+            # . The scan data are not needed for MM/MM interactions within the minimum image convention.
+            if ( scanData is None ) and not ( self.UseMinimumImage ( target ) and ( target.qcModel is None ) ):
                 scanData = ImageScanContainer.Constructor ( coordinates3                    ,
                                                             symmetryParameters              ,
                                                             target.symmetry.transformations ,
@@ -263,6 +392,22 @@ class NBModelCutOff ( NBModel ):
             models["qcqcLennardJones" ] = QCQCLennardJonesModelCutOff
         return models
 
+    def UseIncrementalUpdates ( self, target ):
+        """Check whether the MM/MM pairlist is to be updated incrementally."""
+        # . This is only done for MM systems without symmetry as the QC/MM and image lists are made from the current coordinates.
+        return self.useIncrementalUpdates             and \
+               ( target.symmetryParameters is None ) and \
+               ( target.qcModel            is None )
+
+    def UseMinimumImage ( self, target ):
+        """Check whether the MM/MM interactions are to be evaluated within the minimum image convention."""
+        # . This requires a P1 cell whose smallest perpendicular width is at least twice the cut-off.
+        symmetryParameters = target.symmetryParameters
+        return self.useMinimumImage                       and \
+               ( symmetryParameters is not None )         and \
+               target.symmetry.transformations.isIdentity and \
+               symmetryParameters.IsMinimumImageConventionSatisfied ( self.generator.cutOff )
+
 #===================================================================================================================================
 # . Testing.
 #===================================================================================================================================
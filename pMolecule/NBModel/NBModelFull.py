@@ -1,16 +1,27 @@
 """Defines a simple full NB model."""
 
-from   pCore                                          import SelfPairList
-from   pMolecule.QCModel                              import QCModelDFT             , \
+from   pCore                                          import Selection               , \
+                                                             SelfPairList
+from   pMolecule.QCModel                              import QCModelDFT              , \
                                                              QCModelMNDO
-from  .NBDefaults                                     import _NonUpdatablePairLists , \
-                                                             _PairListStatistics
+from   pScientific.Geometry3                          import PairListGenerator
+from  .FMMTree                                        import FMMTree
+from  .NBDefaults                                     import _DefaultGeneratorCutOff         , \
+                                                             _DefaultPairwiseInteractionABFS , \
+                                                             _MMGrid                         , \
+                                                             _MMOccupancy                    , \
+                                                             _NonUpdatablePairLists          , \
+                                                             _PairListStatistics             , \
+                                                             _UpdatablePairLists
 from  .NBModel                                        import NBModel
+from  .NBModelError                                   import NBModelError
+from  .PairwiseInteractionABFS                        import PairwiseInteractionABFS
 from  .PairwiseInteractionFull                        import PairwiseInteractionFull
 from  .QCMMElectrostaticModelDensityFullGaussianBasis import QCMMElectrostaticModelDensityFullGaussianBasis
 from  .QCMMElectrostaticModelDensityFullMNDO          import QCMMElectrostaticModelDensityFullMNDO
 from  .QCMMElectrostaticModelMultipoleFull            import QCMMElectrostaticModelMultipoleFull
 from  .QCMMLennardJonesModelFull                      import QCMMLennardJonesModelFull
+from  .UpdateChecker                                  import UpdateChecker
 from ..EnergyModel                                    import EnergyClosurePriority
 
 #===================================================================================================================================
@@ -20,11 +31,52 @@ class NBModelFull ( NBModel ):
     """Define a full NB model."""
 
     # . Defaults.
+    # . The FMM tree, generator, Lennard-Jones interaction and update checker are only needed, and made, when the fast multipole
+    #   method is used.
+    _attributable             = dict ( NBModel._attributable )
     _classLabel               = "Full NB Model"
     _pairwiseInteractionClass = PairwiseInteractionFull
+    _summarizable             = dict ( NBModel._summarizable )
+    _attributable.update ( { "fmmTree"                 : None  ,
+                             "generator"               : None  ,
+                             "lennardJonesInteraction" : None  ,
+                             "updateChecker"           : None  ,
+                             "useFMM"                  : False } )
+    _summarizable.update ( { "fmmTree"                 : None      ,
+                             "generator"               : None      ,
+                             "lennardJonesInteraction" : None      ,
+                             "useFMM"                  : "Use FMM" } )
+
+    def _CheckOptions ( self ):
+        """Check options."""
+        super ( NBModelFull, self )._CheckOptions ( )
+        if self.useFMM:
+            if self.fmmTree is None:
+                self.fmmTree = FMMTree.WithOptions ( )
+            elif not isinstance ( self.fmmTree, FMMTree ):
+                raise TypeError ( "Invalid FMM tree attribute." )
+            if self.generator is None:
+                self.generator = _DefaultGeneratorCutOff ( )
+            elif not isinstance ( self.generator, PairListGenerator ):
+                raise TypeError ( "Invalid pairlist generator attribute." )
+            if self.lennardJonesInteraction is None:
+                self.lennardJonesInteraction = _DefaultPairwiseInteractionABFS ( )
+            elif not isinstance ( self.lennardJonesInteraction, PairwiseInteractionABFS ):
+                raise TypeError ( "Invalid Lennard-Jones interaction attribute." )
+            if ( self.generator.cutOff - self.lennardJonesInteraction.range ) < 0.0:
+                raise NBModelError ( "Incompatible generator/Lennard-Jones interaction cut-offs." )
+        return self
+
+    def CheckForUpdate ( self, target ):
+        """Check for an update of the Lennard-Jones pairlist."""
+        if self.updateChecker is None:
+            buffer = self.generator.cutOff - self.lennardJonesInteraction.range
+            self.updateChecker = UpdateChecker.WithOptions ( buffer = buffer )
+        self.updateChecker.Check ( target )
 
     def Energy ( self, target ):
         """Energy 1-5+."""
+        if self.useFMM: return self.EnergyFMM ( target )
         energies = {}
         pNode    = target.scratch.GetSetNode ( _NonUpdatablePairLists )
         pairList = pNode.Get ( "mmmm", None )
@@ -86,6 +138,95 @@ class NBModelFull ( NBModel ):
                                 "MM/MM 1-4 Lennard-Jones" : eLennardJones  } )
         return energies
 
+    def EnergyFMM ( self, target ):
+        """Energy 1-5+ with the fast multipole method."""
+        # . The electrostatic interactions of all MM atoms are found by FMM and those of the excluded pairs, and of the pairs of
+        #   fixed atoms, removed afterwards.
+        # . The Lennard-Jones interactions are short-range and so are evaluated with a smoothed cut-off interaction.
+        mmState      = target.mmState
+        coordinates3 = target.coordinates3
+        freeAtoms    = target.freeAtoms
+        gradients3   = target.scratch.Get ( "gradients3", None )
+        scale        = ( 1.0 / self.dielectric )
+        pNode        = target.scratch.GetSetNode ( _NonUpdatablePairLists )
+        exclusions   = pNode.Get ( "mmmmExclusions", None )
+        if exclusions is None:
+            exclusions = SelfPairList.FromSelfPairList ( mmState.exclusions   ,
+                                                         len ( target.atoms ) ,
+                                                         mmState.mmAtoms      ,
+                                                         freeAtoms            )
+            pNode.mmmmExclusions = exclusions
+            if freeAtoms is not None:
+                if mmState.mmAtoms is None: mmAtoms = range ( len ( target.atoms ) )
+                else:                       mmAtoms = mmState.mmAtoms
+                pNode.mmmmFixedAtoms = Selection.FromIterable ( set ( mmAtoms ) - set ( freeAtoms ) )
+        eElectrostatic = self.fmmTree.MMMMEnergy ( self.pairwiseInteraction ,
+                                                   mmState.charges          ,
+                                                   scale                    ,
+                                                   coordinates3             ,
+                                                   mmState.mmAtoms          ,
+                                                   gradients3               )
+        if freeAtoms is not None:
+            eElectrostatic += self.fmmTree.MMMMEnergy ( self.pairwiseInteraction ,
+                                                        mmState.charges          ,
+                                                        -scale                   ,
+                                                        coordinates3             ,
+                                                        pNode.mmmmFixedAtoms     ,
+                                                        gradients3               )
+        if ( exclusions is not None ) and ( len ( exclusions ) > 0 ):
+            ( eExcluded, eZero         ) = self.pairwiseInteraction.MMMMEnergy ( mmState.charges       ,
+                                                                                 mmState.charges       ,
+                                                                                 mmState.ljTypeIndices ,
+                                                                                 mmState.ljTypeIndices ,
+                                                                                 mmState.ljParameters  ,
+                                                                                 -scale                ,
+                                                                                 0.0                   ,
+                                                                                 coordinates3          ,
+                                                                                 coordinates3          ,
+                                                                                 exclusions            ,
+                                                                                 gradients3            ,
+                                                                                 gradients3            )
+            eElectrostatic += eExcluded
+        # . Lennard-Jones.
+        # . The pairlist is only remade when the update checker finds that the atoms have moved too far.
+        uNode    = target.scratch.GetSetNode ( _UpdatablePairLists )
+        pairList = uNode.Get ( "mmmmLennardJones", None )
+        if pairList is None:
+            grid      = uNode.Get ( _MMGrid     , None )
+            occupancy = uNode.Get ( _MMOccupancy, None )
+            if ( ( grid is None ) or ( occupancy is None ) ) and self.generator.UseGridSearch ( coordinates3 ):
+                ( grid, occupancy ) = coordinates3.MakeGridAndOccupancy ( self.generator.cellSize )
+                uNode.Set ( _MMGrid     , grid      )
+                uNode.Set ( _MMOccupancy, occupancy )
+            pairList = self.generator.SelfPairListFromCoordinates3 ( coordinates3       ,
+                                                                     None               ,
+                                                                     mmState.mmAtoms    ,
+                                                                     freeAtoms          ,
+                                                                     mmState.exclusions ,
+                                                                     grid               ,
+                                                                     occupancy          )
+            uNode.mmmmLennardJones = pairList
+            sNode = target.scratch.Get ( _PairListStatistics )
+            n     = float ( len ( pairList ) )
+            sNode[ "MM/MM Lennard-Jones Pairs" ]  = n
+            sNode["<MM/MM Lennard-Jones Pairs>"] += n
+        eLennardJones = 0.0
+        if len ( pairList ) > 0:
+            ( eZero    , eLennardJones ) = self.lennardJonesInteraction.MMMMEnergy ( None                  ,
+                                                                                     None                  ,
+                                                                                     mmState.ljTypeIndices ,
+                                                                                     mmState.ljTypeIndices ,
+                                                                                     mmState.ljParameters  ,
+                                                                                     0.0                   ,
+                                                                                     1.0                   ,
+                                                                                     coordinates3          ,
+                                                                                     coordinates3          ,
+                                                                                     pairList              ,
+                                                                                     gradients3            ,
+                                                                                     gradients3            )
+        return { "MM/MM Electrostatic" : eElectrostatic ,
+                 "MM/MM Lennard-Jones" : eLennardJones  }
+
     def EnergyClosures ( self, target ):
         """Return energy closures."""
         def a ( ):
@@ -97,6 +238,17 @@ class NBModelFull ( NBModel ):
                             ( EnergyClosurePriority.IndependentEnergyTerm, b, "MM/MM 1-4 NB Evaluation" ) ] )
         return closures
 
+    def EnergyInitialize ( self, target ):
+        """Energy initialization."""
+        super ( NBModelFull, self ).EnergyInitialize ( target )
+        if self.useFMM: self.CheckForUpdate ( target )
+
+    def FastEnergyClosureLabels ( self, target ):
+        """Return the labels of the fast energy closures (the full MM/MM terms are long-range and so slow)."""
+        labels = super ( NBModelFull, self ).FastEnergyClosureLabels ( target )
+        labels.add ( "MM/MM 1-4 NB Evaluation" )
+        return labels
+
     def QCMMModels ( self, qcModel = None, withSymmetry = False ):
         """Default companion QC/MM models for the model."""
         models = { "qcmmLennardJones" : QCMMLennardJonesModelFull }
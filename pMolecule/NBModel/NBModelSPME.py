@@ -0,0 +1,164 @@
+"""Defines a smooth particle-mesh Ewald NB model."""
+
+import math
+
+from   pCore                                 import SelfPairList
+from   pScientific.Arrays                    import Array
+from  .NBDefaults                            import _DefaultPairwiseInteractionSplineABFS , \
+                                                    _NonUpdatablePairLists                , \
+                                                    _PairListStatistics                   , \
+                                                    _SPMEGrid
+from  .NBModelCutOff                         import NBModelCutOff
+from  .NBModelError                          import NBModelError
+from  .PairwiseInteractionSplineABFS         import PairwiseInteractionSplineABFS
+from  .QCMMElectrostaticModelMultipoleSPME   import QCMMElectrostaticModelMultipoleSPME
+from  .SPMEGrid                              import SPMEGrid
+from ..EnergyModel                           import EnergyClosurePriority
+
+# . The real space part of the Ewald sum is evaluated with the cut-off machinery of the parent class using a spline pairwise
+# . interaction from which erf ( kappa r ) / r has been removed. The reciprocal space part, which includes all pairs, is
+# . evaluated on a grid and is corrected for excluded and 1-4 pairs.
+
+# . Only systems in which the images are generated by lattice translations alone (P1) are handled.
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+class NBModelSPME ( NBModelCutOff ):
+    """The smooth particle-mesh Ewald NB model."""
+
+    _attributable             = dict ( NBModelCutOff._attributable )
+    _classLabel               = "SPME NB Model"
+    _pairwiseInteractionClass = PairwiseInteractionSplineABFS
+    _summarizable             = dict ( NBModelCutOff._summarizable )
+    _attributable.update ( { "ewaldTolerance" : 1.0e-5 ,
+                             "gridSpacing"    : 1.0    ,
+                             "kappa"          : None   ,
+                             "splineOrder"    : 4      } )
+    _summarizable.update ( { "ewaldTolerance" : ( "Ewald Tolerance" , "{:.3g}" ) ,
+                             "gridSpacing"    : ( "Grid Spacing"    , "{:.3f}" ) ,
+                             "splineOrder"    : ( "Spline Order"    , "{:d}"   ) } )
+
+    def _CheckOptions ( self ):
+        """Check options."""
+        if self.pairwiseInteraction is None:
+            self.pairwiseInteraction = _DefaultPairwiseInteractionSplineABFS ( )
+        super ( NBModelSPME, self )._CheckOptions ( )
+        if self.kappa is None:
+            self.kappa = self.KappaFromTolerance ( self.ewaldTolerance, self.pairwiseInteraction.innerCutOff )
+        elif self.kappa <= 0.0:
+            raise NBModelError ( "Invalid Ewald kappa: {:.3f}.".format ( self.kappa ) )
+        if self.pairwiseInteraction.ewaldKappa != self.kappa:
+            self.pairwiseInteraction.SetOptions ( ewaldKappa = self.kappa )
+        return self
+
+    def EnergyClosures ( self, target ):
+        """Return energy closures."""
+        def a ( ): target.scratch.energyTerms.update ( self.EnergyReciprocal ( target ) )
+        def b ( ): target.scratch.energyTerms.update ( self.EnergyCorrection ( target ) )
+        closures = super ( NBModelSPME, self ).EnergyClosures ( target )
+        closures.extend ( [ ( EnergyClosurePriority.IndependentEnergyTerm, a, "MM/MM Ewald Reciprocal Evaluation" ) ,
+                            ( EnergyClosurePriority.IndependentEnergyTerm, b, "MM/MM Ewald Correction Evaluation" ) ] )
+        return closures
+
+    def EnergyCorrection ( self, target ):
+        """Remove the reciprocal space interactions of excluded pairs and add back those of scaled 1-4 pairs."""
+        # . Excluded pairs include fixed atoms as the reciprocal space term does whereas the 1-4 pairs are those of Energy14.
+        scratch        = target.scratch
+        coordinates3   = scratch.Get ( "coordinates3NB", target.coordinates3 )
+        gradients3     = scratch.Get ( "gradients3"    , None                )
+        grid           = self.GetSPMEGrid ( target )
+        pNode          = scratch.GetSetNode ( _NonUpdatablePairLists )
+        exclusions     = pNode.Get ( "mmmmEwaldExclusions", None )
+        interactions14 = pNode.Get ( "mmmm14"             , None )
+        if exclusions is None:
+            exclusions = SelfPairList.FromSelfPairList ( target.mmState.exclusions ,
+                                                         len ( target.atoms )      ,
+                                                         target.mmState.mmAtoms    ,
+                                                         None                      )
+            pNode.mmmmEwaldExclusions = exclusions
+            sNode = scratch.Get ( _PairListStatistics )
+            sNode["MM/MM Ewald Exclusion Pairs"] = float ( len ( exclusions ) )
+        if interactions14 is None:
+            interactions14 = SelfPairList.FromSelfPairList ( target.mmState.interactions14 ,
+                                                             len ( target.atoms )          ,
+                                                             target.mmState.mmAtoms        ,
+                                                             target.freeAtoms              )
+            pNode.mmmm14 = interactions14
+        energy = 0.0
+        if ( exclusions is not None ) and ( len ( exclusions ) > 0 ):
+            energy += grid.PairCorrection ( - 1.0 / self.dielectric, target.mmState.charges, coordinates3, exclusions, gradients3 )
+        if ( interactions14 is not None ) and ( len ( interactions14 ) > 0 ):
+            scale   = ( target.mmModel.electrostaticScale14 / self.dielectric )
+            energy += grid.PairCorrection ( scale, target.mmState.charges, coordinates3, interactions14, gradients3 )
+        return { "MM/MM Ewald Correction" : energy }
+
+    def EnergyReciprocal ( self, target ):
+        """The reciprocal space, self and background energy."""
+        scratch = target.scratch
+        energy  = self.GetSPMEGrid ( target ).Energy ( 1.0 / self.dielectric                                              ,
+                                                       self.MaskedCharges ( target, "mmChargesSPME", target.mmState.mmAtoms ) ,
+                                                       scratch.Get ( "coordinates3NB", target.coordinates3 )              ,
+                                                       target.symmetryParameters                                          ,
+                                                       scratch.Get ( "gradients3"                , None )                 ,
+                                                       scratch.Get ( "symmetryParameterGradients", None )                 )
+        return { "MM/MM Ewald Reciprocal" : energy }
+
+    def EnergyInitialize ( self, target ):
+        """Energy initialization"""
+        if target.symmetryParameters is None:
+            raise NBModelError ( "The SPME NB model requires periodic boundary conditions." )
+        elif len ( target.symmetry.transformations ) > 1:
+            raise NBModelError ( "The SPME NB model only handles systems with translational symmetry." )
+        super ( NBModelSPME, self ).EnergyInitialize ( target )
+
+    def GetSPMEGrid ( self, target ):
+        """Get the SPME grid, creating it if necessary."""
+        # . The grid is remade whenever the number of points it needs changes, as can happen when the box changes size.
+        scratch = target.scratch
+        grid    = scratch.Get ( _SPMEGrid, None )
+        extents = SPMEGrid.ExtentsFromSymmetryParameters ( target.symmetryParameters, self.gridSpacing, self.splineOrder )
+        if ( grid is None ) or ( grid.kappa != self.kappa ) or ( grid.order != self.splineOrder ) or ( grid.shape != extents ):
+            grid = SPMEGrid.FromSymmetryParameters ( target.symmetryParameters, self.gridSpacing, self.splineOrder, self.kappa )
+            scratch.Set ( _SPMEGrid, grid )
+        return grid
+
+    @staticmethod
+    def KappaFromTolerance ( tolerance, cutOff ):
+        """Find kappa such that erfc ( kappa * cutOff ) equals tolerance."""
+        if ( tolerance <= 0.0 ) or ( tolerance >= 1.0 ) or ( cutOff <= 0.0 ):
+            raise NBModelError ( "Invalid Ewald tolerance or cut-off." )
+        lower = 0.0
+        upper = 1.0
+        while math.erfc ( upper * cutOff ) > tolerance: upper *= 2.0
+        for i in range ( 100 ):
+            kappa = 0.5 * ( lower + upper )
+            if math.erfc ( kappa * cutOff ) > tolerance: lower = kappa
+            else:                                        upper = kappa
+        return 0.5 * ( lower + upper )
+
+    def MaskedCharges ( self, target, key, selection ):
+        """Return charges that are zero for atoms not in a selection."""
+        charges = target.mmState.charges
+        if selection is not None:
+            pNode  = target.scratch.GetSetNode ( _NonUpdatablePairLists )
+            masked = pNode.Get ( key, None )
+            if masked is None:
+                masked = Array.WithExtent ( len ( charges ) )
+                masked.Set ( 0.0 )
+                for i in selection: masked[i] = charges[i]
+                pNode.Set ( key, masked )
+            charges = masked
+        return charges
+
+    def QCMMModels ( self, qcModel = None, withSymmetry = False ):
+        """Default companion QC/MM models for the model."""
+        models = super ( NBModelSPME, self ).QCMMModels ( qcModel = qcModel, withSymmetry = withSymmetry )
+        models["qcmmElectrostatic"] = QCMMElectrostaticModelMultipoleSPME
+        return models
+
+#===================================================================================================================================
+# . Testing.
+#===================================================================================================================================
+if __name__ == "__main__" :
+    pass
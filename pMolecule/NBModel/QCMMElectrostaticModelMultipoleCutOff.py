@@ -5,6 +5,7 @@ from   pCore                               import CrossPairList
                                                   LogFileActive
 from   pScientific                         import Units
 from   pScientific.Arrays                  import Array
+from   pScientific.Geometry3               import PairListGenerator
 from  .ImagePairListContainer              import ImagePairListContainer
 from  .NBDefaults                          import _CheckCutOffs                             , \
                                                   _DefaultGeneratorCutOff                   , \
@@ -41,7 +42,7 @@ class QCMMElectrostaticModelMultipoleCutOff ( QCMMElectrostaticModelMultipoleBas
             raise TypeError ( "Invalid pairlist generator attribute." )
         if self.pairwiseInteraction is None:
             self.pairwiseInteraction = _DefaultPairwiseInteractionSplineABFSQCMM ( )
-        elif not isinstance ( pairwiseInteraction, self.__class__._pairwiseInteractionClass ):
+        elif not isinstance ( self.pairwiseInteraction, self.__class__._pairwiseInteractionClass ):
             raise TypeError ( "Invalid pairwise interaction attribute." )              
         _CheckCutOffs ( self )
         return self
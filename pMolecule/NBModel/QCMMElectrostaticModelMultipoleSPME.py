@@ -0,0 +1,93 @@
+"""Defines a smooth particle-mesh Ewald QC/MM electrostatic multipole model."""
+
+from  .QCMMElectrostaticModelMultipoleCutOff import QCMMElectrostaticModelMultipoleCutOff
+from ..EnergyModel                           import EnergyClosurePriority
+
+# . The real space interactions are those of the parent class with erf ( kappa r ) / r removed from the pairwise interaction.
+# . The reciprocal space interactions are between the QC monopoles and the MM and boundary partner charges only.
+# . The model takes its kappa and grid from the SPME NB model of the target.
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+class QCMMElectrostaticModelMultipoleSPME ( QCMMElectrostaticModelMultipoleCutOff ):
+    """Define a smooth particle-mesh Ewald QC/MM electrostatic model."""
+
+    _classLabel = "SPME Multipole QC/MM Electrostatic Model"
+
+    def EnergyClosures ( self, target ):
+        """Return energy closures."""
+        def a ( ): self.QCMMPotentialsReciprocal ( target )
+        def b ( ): self.QCMMGradientsReciprocal  ( target )
+        closures = super ( QCMMElectrostaticModelMultipoleSPME, self ).EnergyClosures ( target )
+        closures.extend ( [ ( EnergyClosurePriority.QCIntegrals , a, "QC/MM Reciprocal Electrostatic Potentials" ) ,
+                            ( EnergyClosurePriority.QCGradients , b, "QC/MM Reciprocal Electrostatic Gradients"  ) ] )
+        return closures
+
+    def EnergyInitialize ( self, target ):
+        """Energy initialization"""
+        kappa = target.nbModel.kappa
+        if self.pairwiseInteraction.ewaldKappa != kappa:
+            self.pairwiseInteraction.SetOptions ( ewaldKappa = kappa )
+        super ( QCMMElectrostaticModelMultipoleSPME, self ).EnergyInitialize ( target )
+
+    def QCMMGradientsReciprocal ( self, target ):
+        """QC/MM and QC/BP reciprocal space gradients."""
+        scratch = target.scratch
+        if scratch.doGradients:
+            nbModel            = target.nbModel
+            grid               = nbModel.GetSPMEGrid ( target )
+            monopoles          = scratch.qcmmMultipoles[0:len ( target.qcState.qcAtoms )]
+            qcCoordinates3     = scratch.qcCoordinates3QCMM
+            spGradients        = scratch.Get ( "symmetryParameterGradients", None )
+            symmetryParameters = target.symmetryParameters
+            grid.CrossEnergy ( 1.0 / self.dielectric                                                          ,
+                               monopoles                                                                      ,
+                               nbModel.MaskedCharges ( target, "pureMMChargesSPME", target.mmState.pureMMAtoms ) ,
+                               qcCoordinates3                                                                 ,
+                               scratch.Get ( "coordinates3NB", target.coordinates3 )                          ,
+                               symmetryParameters                                                             ,
+                               scratch.qcGradients3QCMM                                                       ,
+                               scratch.gradients3                                                             ,
+                               spGradients                                                                    )
+            state     = getattr ( target, self.__class__._stateName )
+            bpCharges = getattr ( state, "bpCharges", None )
+            if bpCharges is not None:
+                grid.CrossEnergy ( 1.0 / self.dielectric      ,
+                                   monopoles                  ,
+                                   bpCharges                  ,
+                                   qcCoordinates3             ,
+                                   scratch.bpCoordinates3     ,
+                                   symmetryParameters         ,
+                                   scratch.qcGradients3QCMM   ,
+                                   scratch.bpGradients3       ,
+                                   spGradients                )
+
+    def QCMMPotentialsReciprocal ( self, target ):
+        """QC/MM and QC/BP reciprocal space potentials."""
+        scratch            = target.scratch
+        nbModel            = target.nbModel
+        grid               = nbModel.GetSPMEGrid ( target )
+        qcCoordinates3     = scratch.qcCoordinates3QCMM
+        symmetryParameters = target.symmetryParameters
+        grid.Potentials ( 1.0 / self.dielectric                                                          ,
+                          nbModel.MaskedCharges ( target, "pureMMChargesSPME", target.mmState.pureMMAtoms ) ,
+                          scratch.Get ( "coordinates3NB", target.coordinates3 )                          ,
+                          qcCoordinates3                                                                 ,
+                          symmetryParameters                                                             ,
+                          scratch.qcmmPotentials                                                         )
+        state     = getattr ( target, self.__class__._stateName )
+        bpCharges = getattr ( state, "bpCharges", None )
+        if bpCharges is not None:
+            grid.Potentials ( 1.0 / self.dielectric  ,
+                              bpCharges              ,
+                              scratch.bpCoordinates3 ,
+                              qcCoordinates3         ,
+                              symmetryParameters     ,
+                              scratch.qcmmPotentials )
+
+#===================================================================================================================================
+# . Testing.
+#===================================================================================================================================
+if __name__ == "__main__" :
+    pass
@@ -4,6 +4,7 @@ from   pCore                         import logFile
                                             LogFileActive
 from   pScientific.Arrays            import Array                                     , \
                                             StorageType
+from   pScientific.Geometry3         import PairListGenerator
 from  .ImagePairListContainer        import ImagePairListContainer
 from  .NBDefaults                    import _CheckCutOffs                             , \
                                             _DefaultGeneratorCutOff                   , \
@@ -45,7 +46,7 @@ class QCQCElectrostaticModelMultipoleCutOff ( EnergyModel ):
             raise TypeError ( "Invalid pairlist generator attribute." )
         if self.pairwiseInteraction is None:
             self.pairwiseInteraction = _DefaultPairwiseInteractionSplineABFSQCQC ( )
-        elif not isinstance ( pairwiseInteraction, self.__class__._pairwiseInteractionClass ):
+        elif not isinstance ( self.pairwiseInteraction, self.__class__._pairwiseInteractionClass ):
             raise TypeError ( "Invalid pairwise interaction attribute." )              
         _CheckCutOffs ( self )
         return self
@@ -0,0 +1,56 @@
+# ifndef _ATOMORDERING
+# define _ATOMORDERING
+
+# include "Coordinates3.h"
+# include "Integer.h"
+# include "IntegerArray1D.h"
+# include "PairList.h"
+# include "Real.h"
+# include "RealArray1D.h"
+# include "Status.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The atom ordering type. */
+/* . The atoms in a pair-list are ordered along a Morton (Z-order) space-filling curve so that atoms that are close in space
+!    are also close in memory. atoms[p] is the original index of the atom at position p and positions[i] is the position of
+!    the atom with original index i (or -1 if the atom is absent). There are upperBound items in positions. */
+typedef struct {
+    Integer  numberOfAtoms ;
+    Integer  upperBound    ;
+    Integer *atoms         ;
+    Integer *positions     ;
+} AtomOrdering ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern AtomOrdering *AtomOrdering_Allocate                ( const Integer             numberOfAtoms ,
+                                                            const Integer             upperBound    ,
+                                                                  Status             *status        ) ;
+extern void          AtomOrdering_Deallocate              (       AtomOrdering      **self          ) ;
+extern AtomOrdering *AtomOrdering_FromSelfPairList        (       PairList           *pairList      ,
+                                                            const Coordinates3       *coordinates3  ,
+                                                                  Status             *status        ) ;
+extern void          AtomOrdering_GatherCoordinates3      ( const AtomOrdering       *self          ,
+                                                            const Coordinates3       *coordinates3  ,
+                                                                  Coordinates3       *ordered       ,
+                                                                  Status             *status        ) ;
+extern void          AtomOrdering_GatherIntegerArray1D    ( const AtomOrdering       *self          ,
+                                                            const IntegerArray1D     *values        ,
+                                                                  IntegerArray1D     *ordered       ,
+                                                                  Status             *status        ) ;
+extern void          AtomOrdering_GatherRealArray1D       ( const AtomOrdering       *self          ,
+                                                            const RealArray1D        *values        ,
+                                                                  RealArray1D        *ordered       ,
+                                                                  Status             *status        ) ;
+extern PairList     *AtomOrdering_OrderSelfPairList       ( const AtomOrdering       *self          ,
+                                                                  PairList           *pairList      ,
+                                                                  Status             *status        ) ;
+extern void          AtomOrdering_ScatterAddCoordinates3  ( const AtomOrdering       *self          ,
+                                                            const Coordinates3       *ordered       ,
+                                                                  Coordinates3       *coordinates3  ,
+                                                                  Status             *status        ) ;
+
+# endif
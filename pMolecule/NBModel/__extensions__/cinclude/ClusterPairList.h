@@ -0,0 +1,54 @@
+# ifndef _CLUSTERPAIRLIST
+# define _CLUSTERPAIRLIST
+
+# include "Boolean.h"
+# include "Cardinal.h"
+# include "Coordinates3.h"
+# include "Integer.h"
+# include "PairList.h"
+# include "Real.h"
+# include "Status.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The number of atoms in a cluster. */
+# define ClusterPairList_ClusterSize 4
+
+/* . The cluster pair list type. */
+/* . The atoms are grouped into spatially compact clusters of fixed size with atoms[c*ClusterSize+s] the atom in slot s of
+!    cluster c (or -1 if the slot is empty). The interacting cluster pairs are stored in compressed sparse row form with the
+!    partners of cluster c being partners[offsets[c]] to partners[offsets[c+1]-1]. Each cluster pair has a mask whose bit
+!    ( sI * ClusterSize + sJ ) is set if the atoms in slots sI and sJ of the first and second clusters interact. Only self
+!    lists are handled and each atom pair appears once, with the partner cluster never greater than the first cluster. */
+typedef struct {
+    Integer   numberOfAtoms        ;
+    Integer   numberOfClusterPairs ;
+    Integer   numberOfClusters     ;
+    Integer   numberOfPairs        ;
+    Integer  *atoms                ;
+    Integer  *offsets              ;
+    Integer  *partners             ;
+    Cardinal *masks                ;
+} ClusterPairList ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Macros.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The fraction of the cluster pair interactions that are atom pairs in the list. */
+# define ClusterPairList_Efficiency( self ) ( ( (self)->numberOfClusterPairs > 0 ) ? \
+                                              ( ( Real ) (self)->numberOfPairs ) / \
+                                              ( ( Real ) ( (self)->numberOfClusterPairs * ClusterPairList_ClusterSize * ClusterPairList_ClusterSize ) ) : 0.0e+00 )
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern ClusterPairList *ClusterPairList_Allocate         ( const Integer           numberOfClusters     ,
+                                                           const Integer           numberOfClusterPairs ,
+                                                                 Status           *status               ) ;
+extern void             ClusterPairList_Deallocate       (       ClusterPairList **self                 ) ;
+extern ClusterPairList *ClusterPairList_FromSelfPairList (       PairList         *pairList             ,
+                                                           const Coordinates3     *coordinates3         ,
+                                                                 Status           *status               ) ;
+
+# endif
@@ -0,0 +1,45 @@
+# ifndef _FFT3D
+# define _FFT3D
+
+# include "Boolean.h"
+# include "Integer.h"
+# include "Real.h"
+# include "Status.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The maximum number of factors of a transform length. */
+# define FFT1D_MaximumFactors 32
+
+/* . A one-dimensional complex transform plan. */
+/* . The factors are stored as (radix, remaining length) pairs and the twiddles are exp ( - 2 pi i k / n ) for k = 0 to n - 1. */
+typedef struct {
+    Integer  n                               ;
+    Integer  numberOfFactors                 ;
+    Integer  factors[2*FFT1D_MaximumFactors] ;
+    Real    *twiddles                        ;
+} FFT1D ;
+
+/* . A three-dimensional complex transform. */
+/* . The data are stored as interleaved complex numbers in row-major order. */
+typedef struct {
+    Integer  extents[3]    ;
+    Integer  maximumExtent ;
+    Integer  size          ;
+    FFT1D   *transforms[3] ;
+} FFT3D ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern FFT3D   *FFT3D_Allocate   ( const Integer  *extents ,
+                                         Status   *status  ) ;
+extern void     FFT3D_Deallocate (       FFT3D   **self    ) ;
+extern Integer  FFT3D_GoodLength ( const Integer   n       ) ;
+extern void     FFT3D_Transform  ( const FFT3D    *self    ,
+                                         Real     *data    ,
+                                   const Boolean   forward ,
+                                         Status   *status  ) ;
+
+# endif
@@ -0,0 +1,38 @@
+# ifndef _FMMTREE
+# define _FMMTREE
+
+# include "Coordinates3.h"
+# include "Integer.h"
+# include "PairwiseInteractionFull.h"
+# include "Real.h"
+# include "RealArray1D.h"
+# include "Selection.h"
+# include "Status.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The FMM tree type. */
+/* . This holds the options for a fast multipole evaluation. The octree itself is rebuilt for each set of coordinates.
+!  . The order trades accuracy for speed. The default of 16 gives relative energy and gradient errors of about 5e-6 and 1e-4. */
+typedef struct {
+    Integer numberOfLeafPoints ;
+    Integer order              ;
+} FMMTree ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern FMMTree *FMMTree_Allocate   (       Status                  *status             ) ;
+extern void     FMMTree_Deallocate (       FMMTree                **self               ) ;
+extern void     FMMTree_MMMMEnergy ( const FMMTree                 *self               ,
+                                     const PairwiseInteractionFull *interaction        ,
+                                     const RealArray1D             *charges            ,
+                                     const Real                     electrostaticScale ,
+                                     const Coordinates3            *coordinates3       ,
+                                           Selection               *selection          ,
+                                           Real                    *eElectrostatic     ,
+                                           Coordinates3            *gradients3         ,
+                                           Status                  *status             ) ;
+
+# endif
@@ -0,0 +1,44 @@
+# ifndef _INCREMENTALPAIRLIST
+# define _INCREMENTALPAIRLIST
+
+# include "Coordinates3.h"
+# include "Integer.h"
+# include "PairList.h"
+# include "Real.h"
+# include "RegularGrid.h"
+# include "RegularGridOccupancy.h"
+# include "Selection.h"
+# include "Status.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The incremental pair-list type. */
+/* . This holds the coordinates, grid and grid occupancy with which the current pair-list was made. The number of updated points
+!    is that of the points whose records were regenerated at the last update. */
+typedef struct {
+    Integer               numberOfUpdatedPoints ;
+    Real                  cellSize              ;
+    Real                  cutOff                ;
+    Coordinates3         *reference             ;
+    RegularGrid          *grid                  ;
+    RegularGridOccupancy *occupancy             ;
+} IncrementalPairList ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern IncrementalPairList *IncrementalPairList_Allocate   ( const Real                  cutOff       ,
+                                                             const Real                  cellSize     ,
+                                                                   Status               *status       ) ;
+extern void                 IncrementalPairList_Deallocate (       IncrementalPairList **self         ) ;
+extern void                 IncrementalPairList_Reset      (       IncrementalPairList  *self         ) ;
+extern PairList            *IncrementalPairList_Update     (       IncrementalPairList  *self         ,
+                                                             const Coordinates3         *coordinates3 ,
+                                                                   Selection            *andSelection ,
+                                                                   Selection            *orSelection  ,
+                                                                   PairList             *exclusions   ,
+                                                                   PairList             *pairList     ,
+                                                                   Status               *status       ) ;
+
+# endif
@@ -0,0 +1,22 @@
+# ifndef _MINIMUMIMAGEPAIRLIST
+# define _MINIMUMIMAGEPAIRLIST
+
+# include "Coordinates3.h"
+# include "PairList.h"
+# include "Real.h"
+# include "Selection.h"
+# include "Status.h"
+# include "SymmetryParameters.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern PairList *MinimumImagePairList_SelfFromCoordinates3 ( const Real                cutOff             ,
+                                                             const Coordinates3       *coordinates3       ,
+                                                             const SymmetryParameters *symmetryParameters ,
+                                                                   Selection          *andSelection       ,
+                                                                   Selection          *orSelection        ,
+                                                                   PairList           *exclusions         ,
+                                                                   Status             *status             ) ;
+
+# endif
@@ -3,9 +3,59 @@
 
 /* . Utilities for minimum image pairwise interactions. */
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Notes.
+! . The fractional coordinates are not wrapped into the primary cell so that the translation, t, that is removed from the
+!   fractional displacement of a pair is the full translation between the pair's images. The Cartesian displacement is then
+!   H ( fI - fJ - t ) and, at fixed Cartesian coordinates, the derivatives of the energy with respect to H are minus the sums
+!   over pairs of the outer products of the pair gradients and the translations.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Macros.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The nearest integer to a real with halves rounded away from zero. This avoids branches and calls to floor or rint. */
+# define MinimumImage_Round( d ) ( ( Real ) ( ( Integer ) ( (d) + copysign ( 0.5e+00, (d) ) ) ) )
+
+/* . Unwrapped fractional coordinates. */
+# define MinimumImage_MakeFractionalCoordinates( symmetryParameters, coordinates3, fractional, status ) \
+    fractional = Coordinates3_Allocate ( Coordinates3_Rows ( coordinates3 ), status ) ; \
+    if ( fractional != NULL ) RealArray2D_MatrixMultiply ( False, True, 1.0e+00, coordinates3, (symmetryParameters)->inverseH, 0.0e+00, fractional, status ) ;
+
+/* . The minimum image displacement of a pair of points with fractional coordinates and the translation that was removed. */
+# define MinimumImage_PairDisplacement( fractionalI, fractionalJ, i, j, h, tA, tB, tC, xIJ, yIJ, zIJ ) \
+    { \
+        auto Real _dA, _dB, _dC ; \
+        _dA = Coordinates3_Item ( fractionalI, i, 0 ) - Coordinates3_Item ( fractionalJ, j, 0 ) ; tA = MinimumImage_Round ( _dA ) ; _dA -= tA ; \
+        _dB = Coordinates3_Item ( fractionalI, i, 1 ) - Coordinates3_Item ( fractionalJ, j, 1 ) ; tB = MinimumImage_Round ( _dB ) ; _dB -= tB ; \
+        _dC = Coordinates3_Item ( fractionalI, i, 2 ) - Coordinates3_Item ( fractionalJ, j, 2 ) ; tC = MinimumImage_Round ( _dC ) ; _dC -= tC ; \
+        xIJ = h[0] * _dA + h[1] * _dB + h[2] * _dC ; \
+        yIJ = h[3] * _dA + h[4] * _dB + h[5] * _dC ; \
+        zIJ = h[6] * _dA + h[7] * _dB + h[8] * _dC ; \
+    }
+
+/* . Accumulate the H derivatives of a pair given the gradient of its first point. */
+# define MinimumImage_PairDerivatives( dEdH, tA, tB, tC, gX, gY, gZ ) \
+    if ( ( tA != 0.0e+00 ) || ( tB != 0.0e+00 ) || ( tC != 0.0e+00 ) ) \
+    { \
+        dEdH[0] -= gX * tA ; dEdH[1] -= gX * tB ; dEdH[2] -= gX * tC ; \
+        dEdH[3] -= gY * tA ; dEdH[4] -= gY * tB ; dEdH[5] -= gY * tC ; \
+        dEdH[6] -= gZ * tA ; dEdH[7] -= gZ * tB ; dEdH[8] -= gZ * tC ; \
+    }
+
+/* . Get H and add H derivatives to the symmetry parameter gradients. */
+# define MinimumImage_GetH( symmetryParameters, h ) \
+    { \
+        auto Integer _a, _b ; \
+        for ( _a = 0 ; _a < 3 ; _a++ ) { for ( _b = 0 ; _b < 3 ; _b++ ) h[3*_a+_b] = Matrix33_Item ( (symmetryParameters)->H, _a, _b ) ; } \
+    }
+# define MinimumImage_AddDerivatives( symmetryParameterGradients, dEdH ) \
+    { \
+        auto Integer _a, _b ; \
+        for ( _a = 0 ; _a < 3 ; _a++ ) { for ( _b = 0 ; _b < 3 ; _b++ ) Matrix33_Item ( (symmetryParameterGradients)->dEdH, _a, _b ) += dEdH[3*_a+_b] ; } \
+    }
+
+/* . Record by record minimum image displacements. */
 # define MinimumImage_Allocate( coordinates3I, coordinates3J ) \
     auto Integer       c ; \
     auto Real          d, fI[3], t ; \
@@ -13,8 +63,8 @@
     auto RealArray2D  *fDisplacements, *rDisplacements, *translations ; \
     auto RealArray2D   fView, rView ; \
     n              = PairList_MaximumRecordSize ( pairList ) ; \
-    fractionalI    = SymmetryParameters_MakeFractionalCoordinates ( symmetryParameters, coordinates3I, status ) ; \
-    fractionalJ    = SymmetryParameters_MakeFractionalCoordinates ( symmetryParameters, coordinates3J, status ) ; \
+    MinimumImage_MakeFractionalCoordinates ( symmetryParameters, coordinates3I, fractionalI, status ) ; \
+    MinimumImage_MakeFractionalCoordinates ( symmetryParameters, coordinates3J, fractionalJ, status ) ; \
     fDisplacements = RealArray2D_AllocateWithExtents ( n, 3, status ) ; \
     rDisplacements = RealArray2D_AllocateWithExtents ( n, 3, status ) ; \
     translations   = RealArray2D_AllocateWithExtents ( n, 3, status ) ; \
@@ -35,27 +85,29 @@
 
 # define MinimumImage_Displacements( i, j ) \
     for ( c = 0 ; c < 3 ; c++ ) fI[c] = Coordinates3_Item ( fractionalI, i, c ) ; \
-    for ( n = 0 ; n < record->capacity ; n++ ) \
+    for ( n = 0 ; n < PairList_RecordCapacity ( pairList, r ) ; n++ ) \
     { \
-        j = record->indices[n] ; \
+        j = PairList_RecordPartners ( pairList, r )[n] ; \
         for ( c = 0 ; c < 3 ; c++ ) \
         { \
-            d = fI[c] - Coordinates3_Item ( fractionalJ, j, c ) ; \
-            t = 0.0e+00 ; \
-            if      ( d >=  0.5 ) { d -= 1.0 ; t =  1.0e+00 ; } \
-            else if ( d <  -0.5 ) { d += 1.0 ; t = -1.0e+00 ; } \
+            d  = fI[c] - Coordinates3_Item ( fractionalJ, j, c ) ; \
+            t  = MinimumImage_Round ( d ) ; \
+            d -= t ; \
             Coordinates3_Item ( fDisplacements, n, c ) = d ; \
             Coordinates3_Item ( translations  , n, c ) = t ; \
         } \
     } \
-    RealArray2D_View ( fDisplacements, 0, 0, record->capacity, 3, 1, 1, False, &fView, status ) ; \
-    RealArray2D_View ( rDisplacements, 0, 0, record->capacity, 3, 1, 1, False, &rView, status ) ; \
+    RealArray2D_View ( fDisplacements, 0, 0, PairList_RecordCapacity ( pairList, r ), 3, 1, 1, False, &fView, status ) ; \
+    RealArray2D_View ( rDisplacements, 0, 0, PairList_RecordCapacity ( pairList, r ), 3, 1, 1, False, &rView, status ) ; \
     RealArray2D_MatrixMultiply ( False, True, 1.0e+00, fDisplacements, symmetryParameters->H, 0.0e+00, rDisplacements, status ) ; \
     RealArray2D_Set ( fDisplacements, 0.0e+00 ) ;
 
 # define MinimumImage_Gradients \
-    RealArray2D_View ( fDisplacements, 0, 0, record->capacity, 3, 1, 1, False, &fView, status ) ; \
-    RealArray2D_View ( translations  , 0, 0, record->capacity, 3, 1, 1, False, &rView, status ) ; \
-    RealArray2D_MatrixMultiply ( True, False, 1.0e+00, &fView, &rView, 1.0e+00, symmetryParameterGradients->dEdH, status ) ;
+    if ( symmetryParameterGradients != NULL ) \
+    { \
+        RealArray2D_View ( fDisplacements, 0, 0, PairList_RecordCapacity ( pairList, r ), 3, 1, 1, False, &fView, status ) ; \
+        RealArray2D_View ( translations  , 0, 0, PairList_RecordCapacity ( pairList, r ), 3, 1, 1, False, &rView, status ) ; \
+        RealArray2D_MatrixMultiply ( True, False, -1.0e+00, &fView, &rView, 1.0e+00, symmetryParameterGradients->dEdH, status ) ; \
+    }
 
 # endif
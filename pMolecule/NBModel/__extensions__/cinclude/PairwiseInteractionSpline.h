@@ -6,6 +6,7 @@
 # include "ImagePairListContainer.h"
 # include "IntegerArray1D.h"
 # include "LJParameterContainer.h"
+# include "MachineTypes.h"
 # include "PairList.h"
 # include "Real.h"
 # include "RealArray1D.h"
@@ -16,10 +17,21 @@
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Definitions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The number of coefficients per bin in the interaction table. */
+# define PairwiseInteractionSpline_TableStride 16
+
 /* . The spline pairwise interaction type. */
+/* . The splines are also stored as a fused table of cubic polynomials over bins of equal width in r^2. Bin b occupies
+!    table[b*TableStride] to table[(b+1)*TableStride-1] and holds the coefficients c[4*p+k] of t^p for interaction k (0 for
+!    electrostatics, 1 and 2 for Lennard-Jones A and B, and 3 for padding) where t is the fractional position within the bin.
+!    tableSingle is a single precision copy of table. */
 typedef struct {
+    Integer      tableBins           ;
     Real         cutOff              ;
     Real         cutOff2             ;
+    Real         tableScale          ;
+    Real        *table               ;
+    Real32      *tableSingle         ;
     CubicSpline *electrostaticSpline ;
     CubicSpline *lennardJonesASpline ;
     CubicSpline *lennardJonesBSpline ;
@@ -94,6 +106,22 @@ extern void                       PairwiseInteractionSpline_MMMMEnergyMI
                                                                                               Coordinates3               *gradients3J                ,
                                                                                               SymmetryParameterGradients *symmetryParameterGradients ,
                                                                                               Status                     *status                     ) ;
+extern void                       PairwiseInteractionSpline_MMMMEnergySingle          ( const PairwiseInteractionSpline  *self                       ,
+                                                                                        const RealArray1D                *chargesI                   ,
+                                                                                        const RealArray1D                *chargesJ                   ,
+                                                                                              IntegerArray1D             *ljTypesI                   ,
+                                                                                              IntegerArray1D             *ljTypesJ                   ,
+                                                                                        const LJParameterContainer       *ljParameters               ,
+                                                                                        const Real                        electrostaticScale         ,
+                                                                                        const Real                        lennardJonesScale          ,
+                                                                                        const Coordinates3               *coordinates3I              ,
+                                                                                        const Coordinates3               *coordinates3J              ,
+                                                                                              PairList                   *pairList                   ,
+                                                                                              Real                       *eElectrostatic             ,
+                                                                                              Real                       *eLennardJones              ,
+                                                                                              Coordinates3               *gradients3I                ,
+                                                                                              Coordinates3               *gradients3J                ,
+                                                                                              Status                     *status                     ) ;
 extern void                       PairwiseInteractionSpline_QCMMGradients             ( const PairwiseInteractionSpline  *self                       ,   
                                                                                         const RealArray1D                *chargesQ                   ,   
                                                                                         const RealArray1D                *chargesM                   ,   
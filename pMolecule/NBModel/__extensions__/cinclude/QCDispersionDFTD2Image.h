@@ -0,0 +1,30 @@
+# ifndef _QCDISPERSIONDFTD2IMAGE
+# define _QCDISPERSIONDFTD2IMAGE
+
+# include "Coordinates3.h"
+# include "ImagePairListContainer.h"
+# include "Real.h"
+# include "RealArray1D.h"
+# include "Status.h"
+# include "SymmetryParameterGradients.h"
+# include "SymmetryParameters.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern Real QCDispersionDFTD2Image_Energy ( const Real                        s6                         ,
+                                            const Real                        sR                         ,
+                                            const Real                        dR                         ,
+                                            const RealArray1D                *sqrtC6                     ,
+                                            const RealArray1D                *r0                         ,
+                                                  Coordinates3               *coordinates3               ,
+                                                  SymmetryParameters         *symmetryParameters         ,
+                                                  ImagePairListContainer     *imagePairLists             ,
+                                                  Coordinates3               *gradients3                 ,
+                                                  SymmetryParameterGradients *symmetryParameterGradients ,
+                                                  Status                     *status                     ) ;
+# endif
@@ -0,0 +1,83 @@
+# ifndef _SPMEGRID
+# define _SPMEGRID
+
+# include "Coordinates3.h"
+# include "FFT3D.h"
+# include "Integer.h"
+# include "PairList.h"
+# include "Real.h"
+# include "RealArray1D.h"
+# include "RegularGrid.h"
+# include "Status.h"
+# include "SymmetryParameterGradients.h"
+# include "SymmetryParameters.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The B-spline order limits. */
+# define SPMEGrid_MaximumOrder 12
+# define SPMEGrid_MinimumOrder  3
+
+/* . The smooth particle-mesh Ewald grid type. */
+/* . The grid is a periodic regular grid in fractional space with the same number of points along each dimension as the
+!    transform. The B-spline moduli are stored consecutively for each dimension. The two complex work grids permit the
+!    evaluation of the cross terms between two sets of charges. */
+typedef struct {
+    Integer      order   ;
+    Real         kappa   ;
+    Real        *bModuli ;
+    Real        *gridA   ;
+    Real        *gridB   ;
+    FFT3D       *fft     ;
+    RegularGrid *grid    ;
+} SPMEGrid ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern Real      SPMEGrid_CrossEnergy             (       SPMEGrid                    *self                       ,
+                                                    const Real                         electrostaticScale         ,
+                                                    const RealArray1D                 *chargesA                   ,
+                                                    const RealArray1D                 *chargesB                   ,
+                                                    const Coordinates3                *coordinates3A              ,
+                                                    const Coordinates3                *coordinates3B              ,
+                                                    const SymmetryParameters          *symmetryParameters         ,
+                                                          Coordinates3                *gradients3A                ,
+                                                          Coordinates3                *gradients3B                ,
+                                                          SymmetryParameterGradients  *symmetryParameterGradients ,
+                                                          Status                      *status                     ) ;
+extern void      SPMEGrid_Deallocate              (       SPMEGrid                   **self                       ) ;
+extern Real      SPMEGrid_Energy                  (       SPMEGrid                    *self                       ,
+                                                    const Real                         electrostaticScale         ,
+                                                    const RealArray1D                 *charges                    ,
+                                                    const Coordinates3                *coordinates3               ,
+                                                    const SymmetryParameters          *symmetryParameters         ,
+                                                          Coordinates3                *gradients3                 ,
+                                                          SymmetryParameterGradients  *symmetryParameterGradients ,
+                                                          Status                      *status                     ) ;
+extern void      SPMEGrid_Extents                 ( const SymmetryParameters          *symmetryParameters         ,
+                                                    const Real                         gridSpacing                ,
+                                                    const Integer                      order                      ,
+                                                          Integer                     *extents                    ) ;
+extern SPMEGrid *SPMEGrid_FromSymmetryParameters  ( const SymmetryParameters          *symmetryParameters         ,
+                                                    const Real                         gridSpacing                ,
+                                                    const Integer                      order                      ,
+                                                    const Real                         kappa                      ,
+                                                          Status                      *status                     ) ;
+extern Real      SPMEGrid_PairCorrection          ( const SPMEGrid                    *self                       ,
+                                                    const Real                         electrostaticScale         ,
+                                                    const RealArray1D                 *charges                    ,
+                                                    const Coordinates3                *coordinates3               ,
+                                                          PairList                    *pairList                   ,
+                                                          Coordinates3                *gradients3                 ,
+                                                          Status                      *status                     ) ;
+extern void      SPMEGrid_Potentials              (       SPMEGrid                    *self                       ,
+                                                    const Real                         electrostaticScale         ,
+                                                    const RealArray1D                 *charges                    ,
+                                                    const Coordinates3                *coordinates3               ,
+                                                    const Coordinates3                *pointCoordinates3          ,
+                                                    const SymmetryParameters          *symmetryParameters         ,
+                                                          RealArray1D                 *potentials                 ,
+                                                          Status                      *status                     ) ;
+# endif
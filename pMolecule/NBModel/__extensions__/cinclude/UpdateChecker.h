@@ -20,17 +20,21 @@ typedef struct {
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Functions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-extern UpdateChecker *UpdateChecker_Allocate            (       Status                 *status              ) ;
-extern Boolean        UpdateChecker_CheckForImageUpdate ( const SymmetryParameters     *set1                ,
-                                                                SymmetryParameters     *set2                ,
-                                                                ImagePairListContainer *images              ,
-                                                          const Real                    buffer              ,
-                                                          const Real                    maximumDisplacement ) ;
-extern Boolean        UpdateChecker_CheckForUpdate      ( const Coordinates3           *set1                ,   
-                                                                Coordinates3           *set2                ,   
-                                                                Selection              *freeAtoms           ,   
-                                                          const Real                    buffer              ,   
-                                                                Real                   *maximumDisplacement ) ; 
-extern void           UpdateChecker_Deallocate          (       UpdateChecker         **self                ) ;
+extern UpdateChecker *UpdateChecker_Allocate              (       Status                 *status              ) ;
+extern Boolean        UpdateChecker_CheckForImageUpdate   ( const SymmetryParameters     *set1                ,
+                                                                  SymmetryParameters     *set2                ,
+                                                                  ImagePairListContainer *images              ,
+                                                            const Real                    buffer              ,
+                                                            const Real                    maximumDisplacement ) ;
+extern Boolean        UpdateChecker_CheckForUpdate        ( const Coordinates3           *set1                ,   
+                                                                  Coordinates3           *set2                ,   
+                                                                  Selection              *freeAtoms           ,   
+                                                            const Real                    buffer              ,   
+                                                                  Real                   *maximumDisplacement ) ; 
+extern void           UpdateChecker_Deallocate            (       UpdateChecker         **self                ) ;
+extern void           UpdateChecker_UpdateMovedReferences ( const Coordinates3           *set1                ,
+                                                                  Coordinates3           *set2                ,
+                                                                  Selection              *freeAtoms           ,
+                                                            const Real                    buffer              ) ;
 
 # endif
@@ -0,0 +1,335 @@
+/*==================================================================================================================================
+! . Atom orderings.
+!=================================================================================================================================*/
+
+# include <stdlib.h>
+
+# include "AtomOrdering.h"
+# include "BooleanUtilities.h"
+# include "IntegerUtilities.h"
+# include "MachineTypes.h"
+# include "Memory.h"
+# include "NumericalMacros.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The cells used for ordering the atoms along the curve. The cell size is chosen so that a cell contains a few atoms at
+!    liquid densities. */
+# define _OrderBits     21
+# define _OrderCellSize 2.0e+00
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Structures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+typedef struct {
+    Cardinal64 key  ;
+    Integer    atom ;
+} OrderRecord ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer OrderRecord_Compare ( const void *vRecord1, const void *vRecord2 ) ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+AtomOrdering *AtomOrdering_Allocate ( const Integer numberOfAtoms, const Integer upperBound, Status *status )
+{
+    AtomOrdering *self = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        self = Memory_AllocateType ( AtomOrdering ) ;
+        if ( self != NULL )
+        {
+            auto Integer n = Maximum ( numberOfAtoms, 0 ), u = Maximum ( upperBound, 0 ) ;
+            self->numberOfAtoms = n ;
+            self->upperBound    = u ;
+            self->atoms         = Memory_AllocateArrayOfTypes ( Maximum ( n, 1 ), Integer ) ;
+            self->positions     = Memory_AllocateArrayOfTypes ( Maximum ( u, 1 ), Integer ) ;
+            if ( ( self->atoms == NULL ) || ( self->positions == NULL ) ) AtomOrdering_Deallocate ( &self ) ;
+            else
+            {
+                auto Integer i ;
+                for ( i = 0 ; i < n ; i++ ) self->atoms    [i] = -1 ;
+                for ( i = 0 ; i < u ; i++ ) self->positions[i] = -1 ;
+            }
+        }
+        if ( self == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void AtomOrdering_Deallocate ( AtomOrdering **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->atoms     ) ;
+        Memory_Deallocate ( (*self)->positions ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Order the atoms in a self pair-list along a space-filling curve.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+AtomOrdering *AtomOrdering_FromSelfPairList ( PairList *pairList, const Coordinates3 *coordinates3, Status *status )
+{
+    AtomOrdering *self = NULL ;
+    if ( ( pairList != NULL ) && ( coordinates3 != NULL ) && Status_IsOK ( status ) )
+    {
+        auto Boolean     *isPresent = NULL ;
+        auto OrderRecord *records   = NULL ;
+        auto Integer      i, n, r, upperBound = 0 ;
+        if ( ! pairList->isSelf ) { Status_Set ( status, Status_InvalidArgument ) ; return NULL ; }
+        /* . The atoms that are present. */
+        for ( r = 0 ; r < pairList->count ; r++ )
+        {
+            upperBound = Maximum ( upperBound, PairList_RecordIndex ( pairList, r ) + 1 ) ;
+            for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ ) upperBound = Maximum ( upperBound, pairList->partners[n] + 1 ) ;
+        }
+        if ( upperBound > Coordinates3_Rows ( coordinates3 ) ) { Status_Set ( status, Status_IndexOutOfRange ) ; return NULL ; }
+        isPresent = Boolean_Allocate ( Maximum ( upperBound, 1 ), status ) ;
+        if ( isPresent != NULL )
+        {
+            Boolean_Set ( isPresent, upperBound, False ) ;
+            for ( r = 0 ; r < pairList->count ; r++ )
+            {
+                isPresent[PairList_RecordIndex ( pairList, r )] = True ;
+                for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ ) isPresent[pairList->partners[n]] = True ;
+            }
+            for ( i = n = 0 ; i < upperBound ; i++ ) { if ( isPresent[i] ) n += 1 ; }
+            self    = AtomOrdering_Allocate ( n, upperBound, status ) ;
+            records = Memory_AllocateArrayOfTypes ( Maximum ( n, 1 ), OrderRecord ) ;
+            if ( records == NULL ) { AtomOrdering_Deallocate ( &self ) ; Status_Set ( status, Status_OutOfMemory ) ; }
+            else if ( ( self != NULL ) && ( n > 0 ) )
+            {
+                auto Cardinal64 cell, key, maximum = ( ( Cardinal64 ) 1 << _OrderBits ) - 1 ;
+                auto Integer    b, c ;
+                auto Real       lower[3], x ;
+                for ( c = 0 ; c < 3 ; c++ ) lower[c] = 0.0e+00 ;
+                for ( i = 0, r = -1 ; i < upperBound ; i++ )
+                {
+                    if ( isPresent[i] )
+                    {
+                        for ( c = 0 ; c < 3 ; c++ )
+                        {
+                            x = Coordinates3_Item ( coordinates3, i, c ) ;
+                            lower[c] = ( ( r < 0 ) ? x : Minimum ( lower[c], x ) ) ;
+                        }
+                        r = i ;
+                    }
+                }
+                for ( i = n = 0 ; i < upperBound ; i++ )
+                {
+                    if ( isPresent[i] )
+                    {
+                        /* . Interleave the bits of the cell indices. */
+                        for ( c = 0, key = 0 ; c < 3 ; c++ )
+                        {
+                            x    = ( Coordinates3_Item ( coordinates3, i, c ) - lower[c] ) / _OrderCellSize ;
+                            cell = Minimum ( ( Cardinal64 ) x, maximum ) ;
+                            for ( b = 0 ; b < _OrderBits ; b++ ) key |= ( ( cell >> b ) & 1 ) << ( 3 * b + c ) ;
+                        }
+                        records[n].key  = key ;
+                        records[n].atom = i   ;
+                        n += 1 ;
+                    }
+                }
+                qsort ( ( void * ) records, ( size_t ) n, sizeof ( OrderRecord ), ( void * ) OrderRecord_Compare ) ;
+                for ( i = 0 ; i < n ; i++ )
+                {
+                    self->atoms[i] = records[i].atom ;
+                    self->positions[records[i].atom] = i ;
+                }
+            }
+            Memory_Deallocate ( records ) ;
+        }
+        Boolean_Deallocate ( &isPresent ) ;
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Gather the coordinates of the ordered atoms.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void AtomOrdering_GatherCoordinates3 ( const AtomOrdering *self, const Coordinates3 *coordinates3, Coordinates3 *ordered, Status *status )
+{
+    if ( ( self != NULL ) && ( coordinates3 != NULL ) && ( ordered != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( Coordinates3_Rows ( coordinates3 ) < self->upperBound    ) ||
+             ( Coordinates3_Rows ( ordered      ) < self->numberOfAtoms ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Integer i, p ;
+            auto Real    x, y, z ;
+            for ( p = 0 ; p < self->numberOfAtoms ; p++ )
+            {
+                i = self->atoms[p] ;
+                Coordinates3_GetRow ( coordinates3, i, x, y, z ) ;
+                Coordinates3_SetRow ( ordered     , p, x, y, z ) ;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Gather the integer values of the ordered atoms.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void AtomOrdering_GatherIntegerArray1D ( const AtomOrdering *self, const IntegerArray1D *values, IntegerArray1D *ordered, Status *status )
+{
+    if ( ( self != NULL ) && ( values != NULL ) && ( ordered != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( View1D_Extent ( values  ) < self->upperBound    ) ||
+             ( View1D_Extent ( ordered ) < self->numberOfAtoms ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Integer p ;
+            for ( p = 0 ; p < self->numberOfAtoms ; p++ ) Array1D_Item ( ordered, p ) = Array1D_Item ( values, self->atoms[p] ) ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Gather the real values of the ordered atoms.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void AtomOrdering_GatherRealArray1D ( const AtomOrdering *self, const RealArray1D *values, RealArray1D *ordered, Status *status )
+{
+    if ( ( self != NULL ) && ( values != NULL ) && ( ordered != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( View1D_Extent ( values  ) < self->upperBound    ) ||
+             ( View1D_Extent ( ordered ) < self->numberOfAtoms ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Integer p ;
+            for ( p = 0 ; p < self->numberOfAtoms ; p++ ) Array1D_Item ( ordered, p ) = Array1D_Item ( values, self->atoms[p] ) ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Order record comparison.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer OrderRecord_Compare ( const void *vRecord1, const void *vRecord2 )
+{
+    OrderRecord *record1 = ( OrderRecord * ) vRecord1 ;
+    OrderRecord *record2 = ( OrderRecord * ) vRecord2 ;
+    Integer      i ;
+         if ( record1->key  < record2->key  ) i = -1 ;
+    else if ( record1->key  > record2->key  ) i =  1 ;
+    else if ( record1->atom < record2->atom ) i = -1 ;
+    else if ( record1->atom > record2->atom ) i =  1 ;
+    else i = 0 ;
+    return i ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Renumber a self pair-list so that it refers to the ordered atoms.
+! . Each pair is stored in the record of the atom with the larger position and the records and their partners are sorted so
+!   that the atoms are accessed in increasing order in memory.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+PairList *AtomOrdering_OrderSelfPairList ( const AtomOrdering *self, PairList *pairList, Status *status )
+{
+    PairList *ordered = NULL ;
+    if ( ( self != NULL ) && ( pairList != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ! pairList->isSelf ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            auto Integer *counts, *partners ;
+            auto Integer  numberOfPairs = pairList->numberOfPairs ;
+            counts   = Memory_AllocateArrayOfTypes ( self->numberOfAtoms + 1        , Integer ) ;
+            partners = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPairs, 1 ) , Integer ) ;
+            if ( ( counts == NULL ) || ( partners == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else
+            {
+                auto Integer i, j, n, p, pI, pJ, r, rows = 0 ;
+                /* . Count the pairs of each record. */
+                for ( p = 0 ; p <= self->numberOfAtoms ; p++ ) counts[p] = 0 ;
+                for ( r = 0 ; r < pairList->count ; r++ )
+                {
+                    i = PairList_RecordIndex ( pairList, r ) ;
+                    if ( i >= self->upperBound ) { Status_Set ( status, Status_IndexOutOfRange ) ; break ; }
+                    pI = self->positions[i] ;
+                    for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                    {
+                        j  = pairList->partners[n] ;
+                        pJ = ( ( j < self->upperBound ) ? self->positions[j] : -1 ) ;
+                        if ( ( pI < 0 ) || ( pJ < 0 ) ) { Status_Set ( status, Status_IndexOutOfRange ) ; break ; }
+                        counts[Maximum ( pI, pJ )+1] += 1 ;
+                    }
+                    if ( ! Status_IsOK ( status ) ) break ;
+                }
+                if ( Status_IsOK ( status ) )
+                {
+                    for ( p = 0 ; p < self->numberOfAtoms ; p++ )
+                    {
+                        if ( counts[p+1] > 0 ) rows += 1 ;
+                        counts[p+1] += counts[p] ;
+                    }
+                    /* . Bucket the pairs. */
+                    for ( r = 0 ; r < pairList->count ; r++ )
+                    {
+                        pI = self->positions[PairList_RecordIndex ( pairList, r )] ;
+                        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                        {
+                            pJ = self->positions[pairList->partners[n]] ;
+                            p  = Maximum ( pI, pJ ) ;
+                            partners[counts[p]] = Minimum ( pI, pJ ) ;
+                            counts[p] += 1 ;
+                        }
+                    }
+                    for ( p = self->numberOfAtoms ; p > 0 ; p-- ) counts[p] = counts[p-1] ;
+                    counts[0] = 0 ;
+                    /* . Create the list. */
+                    ordered = PairList_Allocate ( rows, status ) ;
+                    if ( ( ordered != NULL ) && PairList_ReallocatePartners ( ordered, Maximum ( numberOfPairs, 1 ), status ) )
+                    {
+                        ordered->isSelf = True ;
+                        for ( p = 0 ; p < self->numberOfAtoms ; p++ )
+                        {
+                            n = counts[p+1] - counts[p] ;
+                            if ( n > 0 )
+                            {
+                                Integer_Sort      ( &(partners[counts[p]]), n ) ;
+                                PairList_Append   ( ordered, p, n, &(partners[counts[p]]), status ) ;
+                            }
+                        }
+                        ordered->isSorted = True ;
+                    }
+                    if ( ! Status_IsOK ( status ) ) PairList_Deallocate ( &ordered ) ;
+                }
+            }
+            Memory_Deallocate ( counts   ) ;
+            Memory_Deallocate ( partners ) ;
+        }
+    }
+    return ordered ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Add ordered values, typically gradients, to those of the original atoms.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void AtomOrdering_ScatterAddCoordinates3 ( const AtomOrdering *self, const Coordinates3 *ordered, Coordinates3 *coordinates3, Status *status )
+{
+    if ( ( self != NULL ) && ( coordinates3 != NULL ) && ( ordered != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( Coordinates3_Rows ( coordinates3 ) < self->upperBound    ) ||
+             ( Coordinates3_Rows ( ordered      ) < self->numberOfAtoms ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Integer i, p ;
+            auto Real    x, y, z ;
+            for ( p = 0 ; p < self->numberOfAtoms ; p++ )
+            {
+                i = self->atoms[p] ;
+                Coordinates3_GetRow       ( ordered     , p, x, y, z ) ;
+                Coordinates3_IncrementRow ( coordinates3, i, x, y, z ) ;
+            }
+        }
+    }
+}
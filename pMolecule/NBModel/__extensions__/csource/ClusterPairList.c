@@ -0,0 +1,170 @@
+/*==================================================================================================================================
+! . Cluster pair lists.
+!=================================================================================================================================*/
+
+# include "AtomOrdering.h"
+# include "ClusterPairList.h"
+# include "IntegerUtilities.h"
+# include "Memory.h"
+# include "NumericalMacros.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The number of bits needed for a cluster pair mask. */
+# define _ClusterMaskBits ( ClusterPairList_ClusterSize * ClusterPairList_ClusterSize )
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+ClusterPairList *ClusterPairList_Allocate ( const Integer numberOfClusters, const Integer numberOfClusterPairs, Status *status )
+{
+    ClusterPairList *self = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        self = Memory_AllocateType ( ClusterPairList ) ;
+        if ( self != NULL )
+        {
+            auto Integer n = Maximum ( numberOfClusters, 0 ), p = Maximum ( numberOfClusterPairs, 0 ) ;
+            self->numberOfAtoms        = 0 ;
+            self->numberOfClusterPairs = p ;
+            self->numberOfClusters     = n ;
+            self->numberOfPairs        = 0 ;
+            self->atoms                = Memory_AllocateArrayOfTypes ( Maximum ( n * ClusterPairList_ClusterSize, 1 ), Integer  ) ;
+            self->offsets              = Memory_AllocateArrayOfTypes ( n + 1                                         , Integer  ) ;
+            self->partners             = Memory_AllocateArrayOfTypes ( Maximum ( p, 1 )                              , Integer  ) ;
+            self->masks                = Memory_AllocateArrayOfTypes ( Maximum ( p, 1 )                              , Cardinal ) ;
+            if ( ( self->atoms == NULL ) || ( self->offsets == NULL ) || ( self->partners == NULL ) || ( self->masks == NULL ) ) ClusterPairList_Deallocate ( &self ) ;
+            else
+            {
+                auto Integer i ;
+                for ( i = 0 ; i < n * ClusterPairList_ClusterSize ; i++ ) self->atoms[i] = -1 ;
+            }
+        }
+        if ( self == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void ClusterPairList_Deallocate ( ClusterPairList **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->atoms    ) ;
+        Memory_Deallocate ( (*self)->offsets  ) ;
+        Memory_Deallocate ( (*self)->partners ) ;
+        Memory_Deallocate ( (*self)->masks    ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make a cluster pair list from a self pair-list.
+! . The atoms in the list are ordered along a space-filling curve and split into consecutive clusters. The masks are then built from the pairs so
+!   that excluded pairs, and pairs not in the list, never interact.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+ClusterPairList *ClusterPairList_FromSelfPairList ( PairList *pairList, const Coordinates3 *coordinates3, Status *status )
+{
+    ClusterPairList *self = NULL ;
+    if ( ( pairList != NULL ) && ( coordinates3 != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ! pairList->isSelf ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            auto AtomOrdering *ordering ;
+            ordering = AtomOrdering_FromSelfPairList ( pairList, coordinates3, status ) ;
+            if ( ordering != NULL )
+            {
+                auto Cardinal *masks    = NULL ;
+                auto Integer  *counts   = NULL, *entries = NULL, *partners = NULL, *positions = NULL ;
+                auto Integer  *order = ordering->atoms ;
+                auto Integer   numberOfAtoms = ordering->numberOfAtoms, numberOfClusters, numberOfPairs = pairList->numberOfPairs, upperBound = ordering->upperBound ;
+                numberOfClusters = ( numberOfAtoms + ClusterPairList_ClusterSize - 1 ) / ClusterPairList_ClusterSize ;
+                counts    = Memory_AllocateArrayOfTypes ( numberOfClusters + 1           , Integer  ) ;
+                entries   = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPairs, 1 )   , Integer  ) ;
+                masks     = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPairs, 1 )   , Cardinal ) ;
+                partners  = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPairs, 1 )   , Integer  ) ;
+                positions = Memory_AllocateArrayOfTypes ( Maximum ( upperBound, 1 )      , Integer  ) ;
+                if ( ( counts == NULL ) || ( entries == NULL ) || ( masks == NULL ) || ( partners == NULL ) || ( positions == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+                else
+                {
+                    auto Integer c, cI, cJ, i, j, n, p, pI, pJ, r, start, t ;
+                    /* . The positions of the atoms. */
+                    for ( p = 0 ; p < numberOfAtoms ; p++ ) positions[order[p]] = p ;
+                    /* . Count the pairs of each cluster with the larger position first. */
+                    for ( r = 0 ; r < pairList->count ; r++ )
+                    {
+                        pI = positions[PairList_RecordIndex ( pairList, r )] ;
+                        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                        {
+                            pJ = positions[pairList->partners[n]] ;
+                            counts[Maximum ( pI, pJ ) / ClusterPairList_ClusterSize+1] += 1 ;
+                        }
+                    }
+                    for ( c = 0 ; c < numberOfClusters ; c++ ) counts[c+1] += counts[c] ;
+                    /* . Bucket the pairs by first cluster with each entry holding the second cluster and mask bit. */
+                    for ( r = 0 ; r < pairList->count ; r++ )
+                    {
+                        i = positions[PairList_RecordIndex ( pairList, r )] ;
+                        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                        {
+                            j  = positions[pairList->partners[n]] ;
+                            pI = Maximum ( i, j ) ;
+                            pJ = Minimum ( i, j ) ;
+                            cI = pI / ClusterPairList_ClusterSize ;
+                            entries[counts[cI]] = ( pJ / ClusterPairList_ClusterSize ) * _ClusterMaskBits +
+                                                  ( pI % ClusterPairList_ClusterSize ) * ClusterPairList_ClusterSize + ( pJ % ClusterPairList_ClusterSize ) ;
+                            counts[cI] += 1 ;
+                        }
+                    }
+                    for ( c = numberOfClusters ; c > 0 ; c-- ) counts[c] = counts[c-1] ;
+                    counts[0] = 0 ;
+                    /* . Merge the entries of each cluster into cluster pairs. */
+                    /* . positions is reused to hold the cluster pair of each second cluster and counts the cluster offsets. */
+                    for ( c = 0 ; c < numberOfClusters ; c++ ) positions[c] = -1 ;
+                    for ( cI = n = 0 ; cI < numberOfClusters ; cI++ )
+                    {
+                        start = n ;
+                        for ( r = counts[cI] ; r < counts[cI+1] ; r++ )
+                        {
+                            cJ = entries[r] / _ClusterMaskBits ;
+                            t  = entries[r] % _ClusterMaskBits ;
+                            p  = positions[cJ] ;
+                            if ( p < start )
+                            {
+                                p = n ; n += 1 ;
+                                positions[cJ] = p ;
+                                partners [p]  = cJ ;
+                                masks    [p]  = 0 ;
+                            }
+                            masks[p] |= ( ( Cardinal ) 1 ) << t ;
+                        }
+                        counts[cI] = start ;
+                    }
+                    /* . Create the list. */
+                    self = ClusterPairList_Allocate ( numberOfClusters, n, status ) ;
+                    if ( self != NULL )
+                    {
+                        self->numberOfAtoms = numberOfAtoms ;
+                        self->numberOfPairs = numberOfPairs ;
+                        for ( p = 0 ; p < numberOfAtoms ; p++ ) self->atoms[p] = order[p] ;
+                        for ( c = 0 ; c < numberOfClusters ; c++ ) self->offsets[c] = counts[c] ;
+                        self->offsets[numberOfClusters] = n ;
+                        Integer_CopyTo ( partners, n, self->partners, NULL ) ;
+                        for ( p = 0 ; p < n ; p++ ) self->masks[p] = masks[p] ;
+                    }
+                }
+                Memory_Deallocate ( counts    ) ;
+                Memory_Deallocate ( entries   ) ;
+                Memory_Deallocate ( masks     ) ;
+                Memory_Deallocate ( partners  ) ;
+                Memory_Deallocate ( positions ) ;
+                AtomOrdering_Deallocate ( &ordering ) ;
+            }
+        }
+    }
+    return self ;
+}
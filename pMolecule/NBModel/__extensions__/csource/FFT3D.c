@@ -0,0 +1,296 @@
+/*==================================================================================================================================
+! . Three-dimensional complex fast Fourier transforms.
+!===================================================================================================================================
+!
+! . A simple mixed-radix transform. Each dimension is transformed in turn with the one-dimensional lines being distributed
+!   over threads. The transforms are unnormalized with the forward transform having a negative exponent.
+!
+! . Lengths whose factors are all small (see FFT3D_GoodLength) should be used for efficiency.
+!
+!=================================================================================================================================*/
+
+# include <math.h>
+# include <stdlib.h>
+
+# include "FFT3D.h"
+# include "Memory.h"
+# include "NumericalMacros.h"
+
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local procedures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static FFT1D *FFT1D_Allocate   ( const Integer   n        ) ;
+static void   FFT1D_Butterfly  (       Real     *out      ,
+                                 const Integer   fStride  ,
+                                 const FFT1D    *self     ,
+                                 const Integer   m        ,
+                                 const Integer   p        ,
+                                 const Real      sign     ,
+                                       Real     *scratch  ) ;
+static void   FFT1D_Deallocate (       FFT1D   **self     ) ;
+static void   FFT1D_Work       (       Real     *out      ,
+                                 const Real     *in       ,
+                                 const Integer   fStride  ,
+                                 const Integer  *factors  ,
+                                 const FFT1D    *self     ,
+                                 const Real      sign     ,
+                                       Real     *scratch  ) ;
+
+/*==================================================================================================================================
+! . One-dimensional procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation.
+! . Radices of 4 are used first, then 2, 3, 5, ... and finally any remaining prime.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static FFT1D *FFT1D_Allocate ( const Integer n )
+{
+    FFT1D *self = NULL ;
+    if ( n > 0 )
+    {
+        self = Memory_AllocateType ( FFT1D ) ;
+        if ( self != NULL )
+        {
+            self->n               = n ;
+            self->numberOfFactors = 0 ;
+            self->twiddles        = Memory_AllocateArrayOfTypes ( 2 * n, Real ) ;
+            if ( self->twiddles == NULL ) FFT1D_Deallocate ( &self ) ;
+            else
+            {
+                auto Integer k, m = n, p = 4 ;
+                auto Real    phase, root = floor ( sqrt ( ( Real ) n ) ) ;
+                for ( k = 0 ; k < n ; k++ )
+                {
+                    phase = - 2.0e+00 * M_PI * ( Real ) k / ( Real ) n ;
+                    self->twiddles[2*k  ] = cos ( phase ) ;
+                    self->twiddles[2*k+1] = sin ( phase ) ;
+                }
+                do
+                {
+                    while ( ( m % p ) != 0 )
+                    {
+                        if      ( p == 4 ) p  = 2 ;
+                        else if ( p == 2 ) p  = 3 ;
+                        else               p += 2 ;
+                        if ( p > root ) p = m ;
+                    }
+                    m /= p ;
+                    self->factors[2*self->numberOfFactors  ] = p ;
+                    self->factors[2*self->numberOfFactors+1] = m ;
+                    self->numberOfFactors += 1 ;
+                }
+                while ( m > 1 ) ;
+            }
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . A generic butterfly of radix p.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void FFT1D_Butterfly (       Real    *out     ,
+                              const Integer  fStride ,
+                              const FFT1D   *self    ,
+                              const Integer  m       ,
+                              const Integer  p       ,
+                              const Real     sign    ,
+                                    Real    *scratch )
+{
+    Integer k, q, q1, twiddle, u ;
+    Real    sI, sR, wI, wR ;
+    for ( u = 0 ; u < m ; u++ )
+    {
+        for ( q1 = 0, k = u ; q1 < p ; q1++, k += m )
+        {
+            scratch[2*q1  ] = out[2*k  ] ;
+            scratch[2*q1+1] = out[2*k+1] ;
+        }
+        for ( q1 = 0, k = u ; q1 < p ; q1++, k += m )
+        {
+            out[2*k  ] = scratch[0] ;
+            out[2*k+1] = scratch[1] ;
+            for ( q = 1, twiddle = 0 ; q < p ; q++ )
+            {
+                twiddle += fStride * k ;
+                if ( twiddle >= self->n ) twiddle -= self->n ;
+                wR = self->twiddles[2*twiddle  ] ;
+                wI = self->twiddles[2*twiddle+1] * sign ;
+                sR = scratch[2*q  ] ;
+                sI = scratch[2*q+1] ;
+                out[2*k  ] += ( sR * wR - sI * wI ) ;
+                out[2*k+1] += ( sR * wI + sI * wR ) ;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void FFT1D_Deallocate ( FFT1D **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->twiddles ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Recursive decimation in time.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void FFT1D_Work (       Real    *out     ,
+                         const Real    *in      ,
+                         const Integer  fStride ,
+                         const Integer *factors ,
+                         const FFT1D   *self    ,
+                         const Real     sign    ,
+                               Real    *scratch )
+{
+    Integer j, m = factors[1], p = factors[0] ;
+    if ( m == 1 )
+    {
+        for ( j = 0 ; j < p ; j++ )
+        {
+            out[2*j  ] = in[2*j*fStride  ] ;
+            out[2*j+1] = in[2*j*fStride+1] ;
+        }
+    }
+    else
+    {
+        for ( j = 0 ; j < p ; j++ ) FFT1D_Work ( &out[2*j*m], &in[2*j*fStride], fStride * p, &factors[2], self, sign, scratch ) ;
+    }
+    FFT1D_Butterfly ( out, fStride, self, m, p, sign, scratch ) ;
+}
+
+/*==================================================================================================================================
+! . Three-dimensional procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+FFT3D *FFT3D_Allocate ( const Integer *extents, Status *status )
+{
+    FFT3D *self = NULL ;
+    if ( ( extents != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( extents[0] <= 0 ) || ( extents[1] <= 0 ) || ( extents[2] <= 0 ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            self = Memory_AllocateType ( FFT3D ) ;
+            if ( self != NULL )
+            {
+                auto Boolean isOK = True ;
+                auto Integer d ;
+                self->maximumExtent = 0 ;
+                self->size          = 1 ;
+                for ( d = 0 ; d < 3 ; d++ )
+                {
+                    self->extents[d]     = extents[d] ;
+                    self->maximumExtent  = Maximum ( self->maximumExtent, extents[d] ) ;
+                    self->size          *= extents[d] ;
+                    self->transforms[d]  = FFT1D_Allocate ( extents[d] ) ;
+                    if ( self->transforms[d] == NULL ) isOK = False ;
+                }
+                if ( ! isOK ) FFT3D_Deallocate ( &self ) ;
+            }
+            if ( self == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void FFT3D_Deallocate ( FFT3D **self )
+{
+    if ( (*self) != NULL )
+    {
+        auto Integer d ;
+        for ( d = 0 ; d < 3 ; d++ ) FFT1D_Deallocate ( &((*self)->transforms[d]) ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The smallest length not less than n whose only prime factors are 2, 3 and 5.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Integer FFT3D_GoodLength ( const Integer n )
+{
+    Integer m, p ;
+    for ( m = Maximum ( n, 1 ) ; ; m++ )
+    {
+        p = m ;
+        while ( ( p % 2 ) == 0 ) p /= 2 ;
+        while ( ( p % 3 ) == 0 ) p /= 3 ;
+        while ( ( p % 5 ) == 0 ) p /= 5 ;
+        if ( p == 1 ) break ;
+    }
+    return m ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . In-place transform.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void FFT3D_Transform ( const FFT3D *self, Real *data, const Boolean forward, Status *status )
+{
+    if ( ( self != NULL ) && ( data != NULL ) && Status_IsOK ( status ) )
+    {
+        auto Integer  numberOfThreads = 1 ;
+        auto Real    *buffers ;
+# ifdef USEOPENMP
+        numberOfThreads = omp_get_max_threads ( ) ;
+# endif
+        buffers = Memory_AllocateArrayOfTypes ( 6 * numberOfThreads * self->maximumExtent, Real ) ;
+        if ( buffers == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+        else
+        {
+            auto Integer d, e, inner, lines, n ;
+            auto Real    sign = ( forward ? 1.0e+00 : -1.0e+00 ) ;
+            for ( d = 0 ; d < 3 ; d++ )
+            {
+                n     = self->extents[d] ;
+                lines = self->size / n   ;
+                for ( e = d+1, inner = 1 ; e < 3 ; e++ ) inner *= self->extents[e] ;
+# ifdef USEOPENMP
+                #pragma omp parallel num_threads(numberOfThreads)
+# endif
+                {
+                    auto Integer  i, l, start, t = 0 ;
+                    auto Real    *in, *out, *scratch ;
+# ifdef USEOPENMP
+                    t = omp_get_thread_num ( ) ;
+# endif
+                    in      = &buffers[6*t*self->maximumExtent] ;
+                    out     = &in [2*self->maximumExtent] ;
+                    scratch = &out[2*self->maximumExtent] ;
+# ifdef USEOPENMP
+                    #pragma omp for schedule(static)
+# endif
+                    for ( l = 0 ; l < lines ; l++ )
+                    {
+                        start = ( l / inner ) * n * inner + ( l % inner ) ;
+                        for ( i = 0 ; i < n ; i++ )
+                        {
+                            in[2*i  ] = data[2*(start+i*inner)  ] ;
+                            in[2*i+1] = data[2*(start+i*inner)+1] ;
+                        }
+                        FFT1D_Work ( out, in, 1, self->transforms[d]->factors, self->transforms[d], sign, scratch ) ;
+                        for ( i = 0 ; i < n ; i++ )
+                        {
+                            data[2*(start+i*inner)  ] = out[2*i  ] ;
+                            data[2*(start+i*inner)+1] = out[2*i+1] ;
+                        }
+                    }
+                }
+            }
+            Memory_Deallocate ( buffers ) ;
+        }
+    }
+}
@@ -0,0 +1,837 @@
+/*==================================================================================================================================
+! . Fast multipole evaluation of the Coulomb interactions between point charges in non-periodic systems.
+!=================================================================================================================================*/
+
+/*
+! . The points are put in a uniform octree whose depth is the smallest for which the occupied leaves hold on average no more
+!   than numberOfLeafPoints points. Only occupied boxes are stored and they are found by binary search on their Morton keys.
+!   Interactions between points in the same or adjacent leaves are evaluated directly with the damped kernel of the full
+!   pairwise interaction and the remainder with multipole and local expansions of the given order.
+!
+! . The expansions are in terms of the complex regular and irregular solid harmonics:
+!
+!     R_n^m(r) = r^n P_n^m ( cos t ) exp ( i m p ) / (n+m)!      I_n^m(r) = (n-m)! P_n^m ( cos t ) exp ( i m p ) / r^(n+1)
+!
+!   with X_n^-m = (-1)^m conj ( X_n^m ). The potential of a multipole expansion M about C is then sum M_n^m I_n^m(r-C) and
+!   that of a local expansion L about C is sum L_n^m conj ( R_n^m(r-C) ). Only the coefficients with m >= 0 are calculated
+!   but all are stored so that the translations need no special treatment of negative m.
+!
+! . The potential and its gradient are accumulated for each point separately so that the interactions of each pair are counted
+!   in both directions. In this way each box only writes its own data and all passes can be done in parallel.
+*/
+
+# include <math.h>
+# include <stdlib.h>
+
+# include "Cardinal.h"
+# include "FMMTree.h"
+# include "Memory.h"
+# include "NumericalMacros.h"
+# include "Units.h"
+
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The defaults. */
+/* . The error falls slowly with order as only adjacent leaves are treated directly. For charges at condensed-phase densities the
+!    relative errors in the energy and the RMS gradient are about 4e-5 and 3e-4 at order 12, 4e-6 and 1e-4 at order 16, and
+!    5e-6 and 6e-5 at order 18. The cost of the translations grows as the fourth power of the order. */
+# define _DefaultNumberOfLeafPoints 128
+# define _DefaultOrder              16
+
+/* . The depth limits. Well-separated boxes only occur from depth 2 and the keys have 10 bits per dimension. */
+# define _MaximumDepth 10
+# define _MinimumDepth  2
+
+/* . The order limits. */
+# define _MaximumOrder 20
+# define _MinimumOrder  2
+
+/* . The number of coefficients for an order and the index of a coefficient. */
+# define _MaximumCoefficients NumberOfCoefficients ( _MaximumOrder )
+# define CoefficientIndex( n, m ) ( (n) * ( (n) + 1 ) + (m) )
+# define NumberOfCoefficients( p ) ( ( (p) + 1 ) * ( (p) + 1 ) )
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Structures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The octree. */
+/* . The boxes of each level are in increasing key order. For the leaves, firsts and counts refer to points and, for the other
+!    levels, to the boxes of the next level down. The expansions of a box are stored as the real parts followed by the imaginary
+!    parts of its coefficients. */
+typedef struct {
+    Integer   depth                             ;
+    Integer   numberOfCoefficients              ;
+    Integer   numberOfPoints                    ;
+    Integer   order                             ;
+    Integer   numberOfBoxes [_MaximumDepth+1]   ;
+    Integer  *points                            ;
+    Integer  *counts        [_MaximumDepth+1]   ;
+    Integer  *firsts        [_MaximumDepth+1]   ;
+    Cardinal *keys          [_MaximumDepth+1]   ;
+    Real      edge                              ;
+    Real      lower         [3]                 ;
+    Real     *charges                           ;
+    Real     *gradients                         ;
+    Real     *potentials                        ;
+    Real     *x                                 ;
+    Real     *y                                 ;
+    Real     *z                                 ;
+    Real     *locals        [_MaximumDepth+1]   ;
+    Real     *multipoles    [_MaximumDepth+1]   ;
+} Octree ;
+
+/* . A point and its key for sorting. */
+typedef struct {
+    Cardinal key   ;
+    Integer  point ;
+} PointRecord ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local functions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void      BoxCenter            ( const Octree *self, const Integer level, const Cardinal key, Real *center ) ;
+static void      FillNegativeOrders   ( const Integer p, Real *re, Real *im ) ;
+static Integer   FindBox              ( const Octree *self, const Integer level, const Cardinal key ) ;
+static void      IrregularHarmonics   ( const Integer p, const Real x, const Real y, const Real z, Real *re, Real *im ) ;
+static Cardinal  MortonCompact        ( Cardinal v ) ;
+static void      MortonDecode         ( const Cardinal key, Integer *i, Integer *j, Integer *k ) ;
+static Cardinal  MortonEncode         ( const Integer i, const Integer j, const Integer k ) ;
+static Cardinal  MortonSpread         ( Cardinal v ) ;
+static void      Octree_Deallocate    ( Octree **self ) ;
+static void      Octree_Downward      ( Octree *self ) ;
+static void      Octree_Leaves        ( Octree *self, const Real cutOff2, const Real alpha, const Real beta ) ;
+static Octree   *Octree_Make          ( const FMMTree *options, const Real minimumEdge, const RealArray1D *charges, const Coordinates3 *coordinates3, Selection *selection, Status *status ) ;
+static void      Octree_Upward        ( Octree *self ) ;
+static Integer   PointRecord_Compare  ( const void *vRecord1, const void *vRecord2 ) ;
+static void      RegularHarmonics     ( const Integer p, const Real x, const Real y, const Real z, Real *re, Real *im ) ;
+
+/*==================================================================================================================================
+! . Public procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+FMMTree *FMMTree_Allocate ( Status *status )
+{
+    FMMTree *self = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        self = Memory_AllocateType ( FMMTree ) ;
+        if ( self != NULL )
+        {
+            self->numberOfLeafPoints = _DefaultNumberOfLeafPoints ;
+            self->order              = _DefaultOrder              ;
+        }
+        else Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void FMMTree_Deallocate ( FMMTree **self )
+{
+    if ( (*self) != NULL ) Memory_Deallocate ( (*self) ) ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . MM/MM electrostatic energy and gradients of all pairs of selected points.
+! . Exclusions are not handled and so must be removed separately.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void FMMTree_MMMMEnergy ( const FMMTree                 *self               ,
+                          const PairwiseInteractionFull *interaction        ,
+                          const RealArray1D             *charges            ,
+                          const Real                     electrostaticScale ,
+                          const Coordinates3            *coordinates3       ,
+                                Selection               *selection          ,
+                                Real                    *eElectrostatic     ,
+                                Coordinates3            *gradients3         ,
+                                Status                  *status             )
+{
+    if ( eElectrostatic != NULL ) (*eElectrostatic) = 0.0e+00 ;
+    if ( ( self               != NULL    ) &&
+         ( interaction        != NULL    ) &&
+         ( charges            != NULL    ) &&
+         ( coordinates3       != NULL    ) &&
+         ( eElectrostatic     != NULL    ) &&
+         ( electrostaticScale != 0.0e+00 ) &&
+         Status_IsOK ( status ) )
+    {
+        auto Octree *tree ;
+        auto Real    cutOff = Maximum ( 0.0e+00, interaction->dampingCutOff ) ;
+        /* . The leaves must be larger than the damping cutoff so that all damped pairs are treated directly. */
+        tree = Octree_Make ( self, cutOff, charges, coordinates3, selection, status ) ;
+        if ( tree != NULL )
+        {
+            auto Integer i, p ;
+            auto Real    eScale, energy = 0.0e+00, q ;
+            Octree_Upward   ( tree ) ;
+            Octree_Downward ( tree ) ;
+            Octree_Leaves   ( tree, cutOff * cutOff, interaction->alpha1, interaction->beta1 ) ;
+            /* . Energy and gradients. */
+            eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+            for ( i = 0 ; i < tree->numberOfPoints ; i++ ) energy += tree->charges[i] * tree->potentials[i] ;
+            (*eElectrostatic) = 0.5e+00 * eScale * energy ;
+            if ( gradients3 != NULL )
+            {
+                for ( i = 0 ; i < tree->numberOfPoints ; i++ )
+                {
+                    p = tree->points[i] ;
+                    q = eScale * tree->charges[i] ;
+                    Coordinates3_IncrementRow ( gradients3, p, q * tree->gradients[3*i  ] ,
+                                                               q * tree->gradients[3*i+1] ,
+                                                               q * tree->gradients[3*i+2] ) ;
+                }
+            }
+            Octree_Deallocate ( &tree ) ;
+        }
+    }
+}
+
+/*==================================================================================================================================
+! . Private procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The center of a box.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void BoxCenter ( const Octree *self, const Integer level, const Cardinal key, Real *center )
+{
+    Integer i, j, k ;
+    Real    edge = self->edge / ( Real ) ( 1 << level ) ;
+    MortonDecode ( key, &i, &j, &k ) ;
+    center[0] = self->lower[0] + ( ( Real ) i + 0.5e+00 ) * edge ;
+    center[1] = self->lower[1] + ( ( Real ) j + 0.5e+00 ) * edge ;
+    center[2] = self->lower[2] + ( ( Real ) k + 0.5e+00 ) * edge ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Fill the coefficients with negative m from those with positive m.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void FillNegativeOrders ( const Integer p, Real *re, Real *im )
+{
+    Integer m, n ;
+    for ( n = 1 ; n <= p ; n++ )
+    {
+        for ( m = 1 ; m <= n ; m++ )
+        {
+            if ( m % 2 == 0 ) { re[CoefficientIndex ( n, -m )] =   re[CoefficientIndex ( n, m )] ; im[CoefficientIndex ( n, -m )] = - im[CoefficientIndex ( n, m )] ; }
+            else              { re[CoefficientIndex ( n, -m )] = - re[CoefficientIndex ( n, m )] ; im[CoefficientIndex ( n, -m )] =   im[CoefficientIndex ( n, m )] ; }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Find the index of a box given its key (-1 if not present).
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer FindBox ( const Octree *self, const Integer level, const Cardinal key )
+{
+    Cardinal *keys  = self->keys[level] ;
+    Integer   lower = 0, middle, upper = self->numberOfBoxes[level] - 1 ;
+    while ( lower <= upper )
+    {
+        middle = ( lower + upper ) / 2 ;
+             if ( keys[middle] < key ) lower = middle + 1 ;
+        else if ( keys[middle] > key ) upper = middle - 1 ;
+        else return middle ;
+    }
+    return -1 ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The irregular solid harmonics up to order p.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void IrregularHarmonics ( const Integer p, const Real x, const Real y, const Real z, Real *re, Real *im )
+{
+    Integer c, d, i, i1, i2, m, n ;
+    Real    a, b, f, s2 ;
+    s2    = 1.0e+00 / ( x * x + y * y + z * z ) ;
+    re[0] = sqrt ( s2 ) ;
+    im[0] = 0.0e+00 ;
+    for ( m = 0 ; m <= p ; m++ )
+    {
+        c = CoefficientIndex ( m, m ) ;
+        if ( m > 0 )
+        {
+            d     = CoefficientIndex ( m-1, m-1 ) ;
+            f     = ( Real ) ( 2 * m - 1 ) * s2 ;
+            re[c] = f * ( re[d] * x - im[d] * y ) ;
+            im[c] = f * ( re[d] * y + im[d] * x ) ;
+        }
+        if ( m < p )
+        {
+            f = ( Real ) ( 2 * m + 1 ) * z * s2 ;
+            re[CoefficientIndex ( m+1, m )] = f * re[c] ;
+            im[CoefficientIndex ( m+1, m )] = f * im[c] ;
+        }
+        for ( n = m + 2 ; n <= p ; n++ )
+        {
+            i     = CoefficientIndex ( n  , m ) ;
+            i1    = CoefficientIndex ( n-1, m ) ;
+            i2    = CoefficientIndex ( n-2, m ) ;
+            a     = ( Real ) ( 2 * n - 1 ) * z ;
+            b     = ( Real ) ( ( n + m - 1 ) * ( n - m - 1 ) ) ;
+            re[i] = ( a * re[i1] - b * re[i2] ) * s2 ;
+            im[i] = ( a * im[i1] - b * im[i2] ) * s2 ;
+        }
+    }
+    FillNegativeOrders ( p, re, im ) ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Morton keys with 10 bits per dimension.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Cardinal MortonCompact ( Cardinal v )
+{
+    v &= 0x09249249 ;
+    v  = ( v ^ ( v >>  2 ) ) & 0x030C30C3 ;
+    v  = ( v ^ ( v >>  4 ) ) & 0x0300F00F ;
+    v  = ( v ^ ( v >>  8 ) ) & 0x030000FF ;
+    v  = ( v ^ ( v >> 16 ) ) & 0x000003FF ;
+    return v ;
+}
+
+static void MortonDecode ( const Cardinal key, Integer *i, Integer *j, Integer *k )
+{
+    (*i) = ( Integer ) MortonCompact ( key      ) ;
+    (*j) = ( Integer ) MortonCompact ( key >> 1 ) ;
+    (*k) = ( Integer ) MortonCompact ( key >> 2 ) ;
+}
+
+static Cardinal MortonEncode ( const Integer i, const Integer j, const Integer k )
+{
+    return ( MortonSpread ( ( Cardinal ) i ) | ( MortonSpread ( ( Cardinal ) j ) << 1 ) | ( MortonSpread ( ( Cardinal ) k ) << 2 ) ) ;
+}
+
+static Cardinal MortonSpread ( Cardinal v )
+{
+    v &= 0x000003FF ;
+    v  = ( v | ( v << 16 ) ) & 0x030000FF ;
+    v  = ( v | ( v <<  8 ) ) & 0x0300F00F ;
+    v  = ( v | ( v <<  4 ) ) & 0x030C30C3 ;
+    v  = ( v | ( v <<  2 ) ) & 0x09249249 ;
+    return v ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Octree deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void Octree_Deallocate ( Octree **self )
+{
+    if ( (*self) != NULL )
+    {
+        auto Integer l ;
+        for ( l = 0 ; l <= _MaximumDepth ; l++ )
+        {
+            Memory_Deallocate ( (*self)->counts    [l] ) ;
+            Memory_Deallocate ( (*self)->firsts    [l] ) ;
+            Memory_Deallocate ( (*self)->keys      [l] ) ;
+            Memory_Deallocate ( (*self)->locals    [l] ) ;
+            Memory_Deallocate ( (*self)->multipoles[l] ) ;
+        }
+        Memory_Deallocate ( (*self)->charges    ) ;
+        Memory_Deallocate ( (*self)->gradients  ) ;
+        Memory_Deallocate ( (*self)->points     ) ;
+        Memory_Deallocate ( (*self)->potentials ) ;
+        Memory_Deallocate ( (*self)->x          ) ;
+        Memory_Deallocate ( (*self)->y          ) ;
+        Memory_Deallocate ( (*self)->z          ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The downward pass in which the local expansions are formed from those of the parent and from the multipole expansions of
+!   the boxes in the interaction list.
+! . The interaction list of a box consists of the children of its parent's neighbours that are not adjacent to it.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void Octree_Downward ( Octree *self )
+{
+    Integer level, nC = self->numberOfCoefficients, p = self->order ;
+    for ( level = _MinimumDepth ; level <= self->depth ; level++ )
+    {
+        auto Integer b, extent = ( 1 << level ), parentExtent = ( 1 << ( level - 1 ) ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < self->numberOfBoxes[level] ; b++ )
+        {
+            auto Integer  i, iX, iY, iZ, j, jX, jY, jZ, k, l, m, n, pX, pY, pZ, s ;
+            auto Real     center[3], d[3], hRe[_MaximumCoefficients], hIm[_MaximumCoefficients], sign, sRe, sIm ;
+            auto Real    *lRe, *lIm, *mRe, *mIm ;
+            lRe = &(self->locals[level][2*nC*b]) ;
+            lIm = &(lRe[nC]) ;
+            BoxCenter    ( self, level, self->keys[level][b], center ) ;
+            MortonDecode ( self->keys[level][b], &iX, &iY, &iZ ) ;
+            /* . The parent's local expansion. */
+            if ( level > _MinimumDepth )
+            {
+                auto Real *pRe, *pIm, pCenter[3] ;
+                s   = FindBox ( self, level-1, self->keys[level][b] >> 3 ) ;
+                pRe = &(self->locals[level-1][2*nC*s]) ;
+                pIm = &(pRe[nC]) ;
+                BoxCenter ( self, level-1, self->keys[level-1][s], pCenter ) ;
+                for ( i = 0 ; i < 3 ; i++ ) d[i] = center[i] - pCenter[i] ;
+                RegularHarmonics ( p, d[0], d[1], d[2], hRe, hIm ) ;
+                for ( j = 0 ; j <= p ; j++ )
+                {
+                    for ( k = 0 ; k <= j ; k++ )
+                    {
+                        sRe = sIm = 0.0e+00 ;
+                        for ( n = 0 ; n <= p - j ; n++ )
+                        {
+                            for ( m = -n ; m <= n ; m++ )
+                            {
+                                i    = CoefficientIndex ( j+n, k+m ) ;
+                                l    = CoefficientIndex ( n  , m   ) ;
+                                sRe += ( pRe[i] * hRe[l] + pIm[i] * hIm[l] ) ;
+                                sIm += ( pIm[i] * hRe[l] - pRe[i] * hIm[l] ) ;
+                            }
+                        }
+                        lRe[CoefficientIndex ( j, k )] += sRe ;
+                        lIm[CoefficientIndex ( j, k )] += sIm ;
+                    }
+                }
+            }
+            /* . The interaction list. */
+            for ( pX = Maximum ( ( iX >> 1 ) - 1, 0 ) ; pX <= Minimum ( ( iX >> 1 ) + 1, parentExtent - 1 ) ; pX++ )
+            {
+            for ( pY = Maximum ( ( iY >> 1 ) - 1, 0 ) ; pY <= Minimum ( ( iY >> 1 ) + 1, parentExtent - 1 ) ; pY++ )
+            {
+            for ( pZ = Maximum ( ( iZ >> 1 ) - 1, 0 ) ; pZ <= Minimum ( ( iZ >> 1 ) + 1, parentExtent - 1 ) ; pZ++ )
+            {
+                for ( jX = 2*pX ; jX <= Minimum ( 2*pX+1, extent - 1 ) ; jX++ )
+                {
+                for ( jY = 2*pY ; jY <= Minimum ( 2*pY+1, extent - 1 ) ; jY++ )
+                {
+                for ( jZ = 2*pZ ; jZ <= Minimum ( 2*pZ+1, extent - 1 ) ; jZ++ )
+                {
+                    if ( ( abs ( jX - iX ) <= 1 ) && ( abs ( jY - iY ) <= 1 ) && ( abs ( jZ - iZ ) <= 1 ) ) continue ;
+                    s = FindBox ( self, level, MortonEncode ( jX, jY, jZ ) ) ;
+                    if ( s < 0 ) continue ;
+                    mRe = &(self->multipoles[level][2*nC*s]) ;
+                    mIm = &(mRe[nC]) ;
+                    /* . The source and target centers differ by an integral number of box edges. */
+                    d[0] = ( Real ) ( iX - jX ) * self->edge / ( Real ) extent ;
+                    d[1] = ( Real ) ( iY - jY ) * self->edge / ( Real ) extent ;
+                    d[2] = ( Real ) ( iZ - jZ ) * self->edge / ( Real ) extent ;
+                    IrregularHarmonics ( p, d[0], d[1], d[2], hRe, hIm ) ;
+                    for ( k = 0, sign = 1.0e+00 ; k <= p ; k++, sign *= -1.0e+00 )
+                    {
+                        for ( l = 0 ; l <= k ; l++ )
+                        {
+                            sRe = sIm = 0.0e+00 ;
+                            for ( n = 0 ; n <= p - k ; n++ )
+                            {
+                                for ( m = -n ; m <= n ; m++ )
+                                {
+                                    i    = CoefficientIndex ( n  , m   ) ;
+                                    j    = CoefficientIndex ( n+k, m+l ) ;
+                                    sRe += ( mRe[i] * hRe[j] - mIm[i] * hIm[j] ) ;
+                                    sIm += ( mRe[i] * hIm[j] + mIm[i] * hRe[j] ) ;
+                                }
+                            }
+                            lRe[CoefficientIndex ( k, l )] += sign * sRe ;
+                            lIm[CoefficientIndex ( k, l )] += sign * sIm ;
+                        }
+                    }
+                }
+                }
+                }
+            }
+            }
+            }
+            FillNegativeOrders ( p, lRe, lIm ) ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The leaf pass in which the potentials and their gradients at the points are found from the local expansions of their leaves
+!   and from the points in the same and adjacent leaves.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void Octree_Leaves ( Octree *self, const Real cutOff2, const Real alpha, const Real beta )
+{
+    Integer b, extent = ( 1 << self->depth ), level = self->depth, nC = self->numberOfCoefficients, p = self->order ;
+# ifdef USEOPENMP
+    #pragma omp parallel for schedule ( dynamic )
+# endif
+    for ( b = 0 ; b < self->numberOfBoxes[level] ; b++ )
+    {
+        auto Integer i, iLast, iX, iY, iZ, j, jLast, jX, jY, jZ, s ;
+        auto Real    gX, gY, gZ, phi, r2, s1, s3, xI, xIJ, yI, yIJ, zI, zIJ ;
+        iLast = self->firsts[level][b] + self->counts[level][b] ;
+        /* . Local expansions. */
+        if ( level >= _MinimumDepth )
+        {
+            auto Integer  k, l, t, u ;
+            auto Real     center[3], hRe[_MaximumCoefficients], hIm[_MaximumCoefficients] ;
+            auto Real    *lRe, *lIm ;
+            lRe = &(self->locals[level][2*nC*b]) ;
+            lIm = &(lRe[nC]) ;
+            BoxCenter ( self, level, self->keys[level][b], center ) ;
+            for ( i = self->firsts[level][b] ; i < iLast ; i++ )
+            {
+                RegularHarmonics ( p, self->x[i] - center[0], self->y[i] - center[1], self->z[i] - center[2], hRe, hIm ) ;
+                phi = gX = gY = gZ = 0.0e+00 ;
+                for ( t = 0 ; t < nC ; t++ ) phi += ( lRe[t] * hRe[t] + lIm[t] * hIm[t] ) ;
+                /* . The gradient is from the order one terms of the local expansion shifted to the point. */
+                for ( k = 1 ; k <= p ; k++ )
+                {
+                    for ( l = -(k-1) ; l <= (k-1) ; l++ )
+                    {
+                        u   = CoefficientIndex ( k-1, l   ) ;
+                        t   = CoefficientIndex ( k  , l   ) ;
+                        gZ += ( lRe[t] * hRe[u] + lIm[t] * hIm[u] ) ;
+                        t   = CoefficientIndex ( k  , l+1 ) ;
+                        gX += ( lRe[t] * hRe[u] + lIm[t] * hIm[u] ) ;
+                        gY += ( lIm[t] * hRe[u] - lRe[t] * hIm[u] ) ;
+                    }
+                }
+                self->potentials[i]    += phi ;
+                self->gradients [3*i  ] += gX ;
+                self->gradients [3*i+1] += gY ;
+                self->gradients [3*i+2] += gZ ;
+            }
+        }
+        /* . Direct interactions. */
+        MortonDecode ( self->keys[level][b], &iX, &iY, &iZ ) ;
+        for ( jX = Maximum ( iX - 1, 0 ) ; jX <= Minimum ( iX + 1, extent - 1 ) ; jX++ )
+        {
+        for ( jY = Maximum ( iY - 1, 0 ) ; jY <= Minimum ( iY + 1, extent - 1 ) ; jY++ )
+        {
+        for ( jZ = Maximum ( iZ - 1, 0 ) ; jZ <= Minimum ( iZ + 1, extent - 1 ) ; jZ++ )
+        {
+            s = FindBox ( self, level, MortonEncode ( jX, jY, jZ ) ) ;
+            if ( s < 0 ) continue ;
+            jLast = self->firsts[level][s] + self->counts[level][s] ;
+            for ( i = self->firsts[level][b] ; i < iLast ; i++ )
+            {
+                xI  = self->x[i] ;
+                yI  = self->y[i] ;
+                zI  = self->z[i] ;
+                phi = gX = gY = gZ = 0.0e+00 ;
+                for ( j = self->firsts[level][s] ; j < jLast ; j++ )
+                {
+                    if ( j == i ) continue ;
+                    xIJ = xI - self->x[j] ;
+                    yIJ = yI - self->y[j] ;
+                    zIJ = zI - self->z[j] ;
+                    r2  = xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ;
+                    if ( r2 <= cutOff2 )
+                    {
+                        phi += self->charges[j] * ( alpha * r2 + beta ) ;
+                        s3   = 2.0e+00 * alpha * self->charges[j] ;
+                    }
+                    else
+                    {
+                        s1   = 1.0e+00 / sqrt ( r2 ) ;
+                        phi += self->charges[j] * s1 ;
+                        s3   = - self->charges[j] * s1 * s1 * s1 ;
+                    }
+                    gX += s3 * xIJ ;
+                    gY += s3 * yIJ ;
+                    gZ += s3 * zIJ ;
+                }
+                self->potentials[i]    += phi ;
+                self->gradients [3*i  ] += gX ;
+                self->gradients [3*i+1] += gY ;
+                self->gradients [3*i+2] += gZ ;
+            }
+        }
+        }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make an octree for a set of points.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Octree *Octree_Make ( const FMMTree *options, const Real minimumEdge, const RealArray1D *charges, const Coordinates3 *coordinates3, Selection *selection, Status *status )
+{
+    Integer  n ;
+    Octree  *self = NULL ;
+    n = ( selection == NULL ) ? Coordinates3_Rows ( coordinates3 ) : Selection_Capacity ( selection ) ;
+    if ( n > 0 )
+    {
+        auto PointRecord *records ;
+        self    = Memory_AllocateType ( Octree ) ;
+        records = Memory_AllocateArrayOfTypes ( n, PointRecord ) ;
+        if ( self != NULL )
+        {
+            auto Integer l ;
+            self->depth                = 0 ;
+            self->numberOfPoints       = n ;
+            self->order                = Maximum ( Minimum ( options->order, _MaximumOrder ), _MinimumOrder ) ;
+            self->numberOfCoefficients = NumberOfCoefficients ( self->order ) ;
+            for ( l = 0 ; l <= _MaximumDepth ; l++ )
+            {
+                self->numberOfBoxes[l] = 0    ;
+                self->counts       [l] = NULL ;
+                self->firsts       [l] = NULL ;
+                self->keys         [l] = NULL ;
+                self->locals       [l] = NULL ;
+                self->multipoles   [l] = NULL ;
+            }
+            self->charges    = Memory_AllocateArrayOfTypes (     n, Real    ) ;
+            self->gradients  = Memory_AllocateArrayOfTypes ( 3 * n, Real    ) ;
+            self->points     = Memory_AllocateArrayOfTypes (     n, Integer ) ;
+            self->potentials = Memory_AllocateArrayOfTypes (     n, Real    ) ;
+            self->x          = Memory_AllocateArrayOfTypes (     n, Real    ) ;
+            self->y          = Memory_AllocateArrayOfTypes (     n, Real    ) ;
+            self->z          = Memory_AllocateArrayOfTypes (     n, Real    ) ;
+        }
+        if ( ( self == NULL ) || ( records == NULL ) || ( self->charges == NULL ) || ( self->gradients == NULL ) || ( self->points == NULL ) ||
+             ( self->potentials == NULL ) || ( self->x == NULL ) || ( self->y == NULL ) || ( self->z == NULL ) ) goto Error ;
+        else
+        {
+            auto Cardinal key ;
+            auto Integer  b, c, depth, i, index[3], l, m, p, shift ;
+            auto Real     finestEdge, upper[3], v[3] ;
+            /* . The bounding cube. */
+            for ( i = 0 ; i < n ; i++ )
+            {
+                p = ( selection == NULL ) ? i : Selection_Item ( selection, i ) ;
+                Coordinates3_GetRow ( coordinates3, p, v[0], v[1], v[2] ) ;
+                for ( c = 0 ; c < 3 ; c++ )
+                {
+                    if ( ( i == 0 ) || ( v[c] < self->lower[c] ) ) self->lower[c] = v[c] ;
+                    if ( ( i == 0 ) || ( v[c] > upper[c]       ) ) upper[c]       = v[c] ;
+                }
+            }
+            for ( c = 0, self->edge = 0.0e+00 ; c < 3 ; c++ ) self->edge = Maximum ( self->edge, upper[c] - self->lower[c] ) ;
+            self->edge = Maximum ( self->edge, minimumEdge ) * ( 1.0e+00 + 1.0e-6 ) + 1.0e-6 ;
+            /* . The keys at the finest resolution. */
+            finestEdge = self->edge / ( Real ) ( 1 << _MaximumDepth ) ;
+            m          = ( 1 << _MaximumDepth ) - 1 ;
+            for ( i = 0 ; i < n ; i++ )
+            {
+                p = ( selection == NULL ) ? i : Selection_Item ( selection, i ) ;
+                Coordinates3_GetRow ( coordinates3, p, v[0], v[1], v[2] ) ;
+                for ( c = 0 ; c < 3 ; c++ ) index[c] = Maximum ( Minimum ( ( Integer ) floor ( ( v[c] - self->lower[c] ) / finestEdge ), m ), 0 ) ;
+                records[i].key   = MortonEncode ( index[0], index[1], index[2] ) ;
+                records[i].point = p ;
+            }
+            qsort ( ( void * ) records, ( Size ) n, SizeOf ( PointRecord ), ( void * ) PointRecord_Compare ) ;
+            /* . The depth is the smallest for which the mean leaf occupancy is small enough provided that the leaves are
+            !    not smaller than the minimum edge. */
+            for ( depth = 0 ; depth < _MaximumDepth ; depth++ )
+            {
+                if ( self->edge / ( Real ) ( 1 << ( depth + 1 ) ) < minimumEdge ) break ;
+                shift = 3 * ( _MaximumDepth - depth ) ;
+                for ( i = 1, b = 1 ; i < n ; i++ ) { if ( ( records[i].key >> shift ) != ( records[i-1].key >> shift ) ) b++ ; }
+                if ( n <= b * Maximum ( options->numberOfLeafPoints, 1 ) ) break ;
+            }
+            if ( depth < _MinimumDepth ) depth = 0 ;
+            self->depth = depth ;
+            shift       = 3 * ( _MaximumDepth - depth ) ;
+            for ( i = 0 ; i < n ; i++ ) records[i].key >>= shift ;
+            /* . The sorted points. */
+            for ( i = 0 ; i < n ; i++ )
+            {
+                p = records[i].point ;
+                self->points    [i]     = p ;
+                self->charges   [i]     = Array1D_Item ( charges, p ) ;
+                self->potentials[i]     = 0.0e+00 ;
+                self->gradients [3*i  ] = 0.0e+00 ;
+                self->gradients [3*i+1] = 0.0e+00 ;
+                self->gradients [3*i+2] = 0.0e+00 ;
+                Coordinates3_GetRow ( coordinates3, p, self->x[i], self->y[i], self->z[i] ) ;
+            }
+            /* . The leaves. */
+            for ( i = 1, b = 1 ; i < n ; i++ ) { if ( records[i].key != records[i-1].key ) b++ ; }
+            self->numberOfBoxes[depth] = b ;
+            self->counts       [depth] = Memory_AllocateArrayOfTypes ( b, Integer  ) ;
+            self->firsts       [depth] = Memory_AllocateArrayOfTypes ( b, Integer  ) ;
+            self->keys         [depth] = Memory_AllocateArrayOfTypes ( b, Cardinal ) ;
+            if ( ( self->counts[depth] == NULL ) || ( self->firsts[depth] == NULL ) || ( self->keys[depth] == NULL ) ) goto Error ;
+            for ( i = 0, b = -1 ; i < n ; i++ )
+            {
+                if ( ( i == 0 ) || ( records[i].key != records[i-1].key ) )
+                {
+                    b++ ;
+                    self->counts[depth][b] = 0 ;
+                    self->firsts[depth][b] = i ;
+                    self->keys  [depth][b] = records[i].key ;
+                }
+                self->counts[depth][b] += 1 ;
+            }
+            /* . The remaining levels with expansions. */
+            for ( l = depth - 1 ; l >= _MinimumDepth ; l-- )
+            {
+                for ( i = 1, b = 1 ; i < self->numberOfBoxes[l+1] ; i++ ) { if ( ( self->keys[l+1][i] >> 3 ) != ( self->keys[l+1][i-1] >> 3 ) ) b++ ; }
+                self->numberOfBoxes[l] = b ;
+                self->counts       [l] = Memory_AllocateArrayOfTypes ( b, Integer  ) ;
+                self->firsts       [l] = Memory_AllocateArrayOfTypes ( b, Integer  ) ;
+                self->keys         [l] = Memory_AllocateArrayOfTypes ( b, Cardinal ) ;
+                if ( ( self->counts[l] == NULL ) || ( self->firsts[l] == NULL ) || ( self->keys[l] == NULL ) ) goto Error ;
+                for ( i = 0, b = -1 ; i < self->numberOfBoxes[l+1] ; i++ )
+                {
+                    key = self->keys[l+1][i] >> 3 ;
+                    if ( ( i == 0 ) || ( key != self->keys[l][b] ) )
+                    {
+                        b++ ;
+                        self->counts[l][b] = 0 ;
+                        self->firsts[l][b] = i ;
+                        self->keys  [l][b] = key ;
+                    }
+                    self->counts[l][b] += 1 ;
+                }
+            }
+            /* . The expansions. */
+            if ( depth >= _MinimumDepth )
+            {
+                for ( l = _MinimumDepth ; l <= depth ; l++ )
+                {
+                    m = 2 * self->numberOfCoefficients * self->numberOfBoxes[l] ;
+                    self->locals    [l] = Memory_AllocateArrayOfTypes ( m, Real ) ;
+                    self->multipoles[l] = Memory_AllocateArrayOfTypes ( m, Real ) ;
+                    if ( ( self->locals[l] == NULL ) || ( self->multipoles[l] == NULL ) ) goto Error ;
+                    for ( i = 0 ; i < m ; i++ ) { self->locals[l][i] = 0.0e+00 ; self->multipoles[l][i] = 0.0e+00 ; }
+                }
+            }
+        }
+        Memory_Deallocate ( records ) ;
+        return self ;
+    Error:
+        Memory_Deallocate ( records ) ;
+        Octree_Deallocate ( &self ) ;
+        Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The upward pass in which the multipole expansions of the leaves are formed from their points and those of the other boxes
+!   from their children.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void Octree_Upward ( Octree *self )
+{
+    if ( self->depth >= _MinimumDepth )
+    {
+        auto Integer b, level, nC = self->numberOfCoefficients, p = self->order ;
+        /* . The leaves. */
+        level = self->depth ;
+# ifdef USEOPENMP
+        #pragma omp parallel for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < self->numberOfBoxes[level] ; b++ )
+        {
+            auto Integer  i, k ;
+            auto Real     center[3], hRe[_MaximumCoefficients], hIm[_MaximumCoefficients], q ;
+            auto Real    *mRe, *mIm ;
+            mRe = &(self->multipoles[level][2*nC*b]) ;
+            mIm = &(mRe[nC]) ;
+            BoxCenter ( self, level, self->keys[level][b], center ) ;
+            for ( i = self->firsts[level][b] ; i < self->firsts[level][b] + self->counts[level][b] ; i++ )
+            {
+                q = self->charges[i] ;
+                RegularHarmonics ( p, self->x[i] - center[0], self->y[i] - center[1], self->z[i] - center[2], hRe, hIm ) ;
+                for ( k = 0 ; k < nC ; k++ ) { mRe[k] += q * hRe[k] ; mIm[k] -= q * hIm[k] ; }
+            }
+        }
+        /* . The remaining levels. */
+        for ( level = self->depth - 1 ; level >= _MinimumDepth ; level-- )
+        {
+# ifdef USEOPENMP
+            #pragma omp parallel for schedule ( dynamic )
+# endif
+            for ( b = 0 ; b < self->numberOfBoxes[level] ; b++ )
+            {
+                auto Integer  c, i, j, k, l, m, n ;
+                auto Real     center[3], cCenter[3], hRe[_MaximumCoefficients], hIm[_MaximumCoefficients], sRe, sIm ;
+                auto Real    *cRe, *cIm, *mRe, *mIm ;
+                mRe = &(self->multipoles[level][2*nC*b]) ;
+                mIm = &(mRe[nC]) ;
+                BoxCenter ( self, level, self->keys[level][b], center ) ;
+                for ( c = self->firsts[level][b] ; c < self->firsts[level][b] + self->counts[level][b] ; c++ )
+                {
+                    cRe = &(self->multipoles[level+1][2*nC*c]) ;
+                    cIm = &(cRe[nC]) ;
+                    BoxCenter ( self, level+1, self->keys[level+1][c], cCenter ) ;
+                    RegularHarmonics ( p, cCenter[0] - center[0], cCenter[1] - center[1], cCenter[2] - center[2], hRe, hIm ) ;
+                    for ( n = 0 ; n <= p ; n++ )
+                    {
+                        for ( m = 0 ; m <= n ; m++ )
+                        {
+                            sRe = sIm = 0.0e+00 ;
+                            for ( k = 0 ; k <= n ; k++ )
+                            {
+                                for ( l = Maximum ( -k, m - n + k ) ; l <= Minimum ( k, m + n - k ) ; l++ )
+                                {
+                                    i    = CoefficientIndex ( k  , l   ) ;
+                                    j    = CoefficientIndex ( n-k, m-l ) ;
+                                    sRe += ( hRe[i] * cRe[j] + hIm[i] * cIm[j] ) ;
+                                    sIm += ( hRe[i] * cIm[j] - hIm[i] * cRe[j] ) ;
+                                }
+                            }
+                            mRe[CoefficientIndex ( n, m )] += sRe ;
+                            mIm[CoefficientIndex ( n, m )] += sIm ;
+                        }
+                    }
+                }
+                FillNegativeOrders ( p, mRe, mIm ) ;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Point record comparison.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer PointRecord_Compare ( const void *vRecord1, const void *vRecord2 )
+{
+    PointRecord *record1 = ( PointRecord * ) vRecord1 ;
+    PointRecord *record2 = ( PointRecord * ) vRecord2 ;
+    Integer      i ;
+         if ( record1->key   < record2->key   ) i = -1 ;
+    else if ( record1->key   > record2->key   ) i =  1 ;
+    else if ( record1->point < record2->point ) i = -1 ;
+    else if ( record1->point > record2->point ) i =  1 ;
+    else i = 0 ;
+    return i ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The regular solid harmonics up to order p.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void RegularHarmonics ( const Integer p, const Real x, const Real y, const Real z, Real *re, Real *im )
+{
+    Integer c, d, i, i1, i2, m, n ;
+    Real    a, f, r2 ;
+    r2    = x * x + y * y + z * z ;
+    re[0] = 1.0e+00 ;
+    im[0] = 0.0e+00 ;
+    for ( m = 0 ; m <= p ; m++ )
+    {
+        c = CoefficientIndex ( m, m ) ;
+        if ( m > 0 )
+        {
+            d     = CoefficientIndex ( m-1, m-1 ) ;
+            f     = 1.0e+00 / ( Real ) ( 2 * m ) ;
+            re[c] = f * ( re[d] * x - im[d] * y ) ;
+            im[c] = f * ( re[d] * y + im[d] * x ) ;
+        }
+        if ( m < p )
+        {
+            re[CoefficientIndex ( m+1, m )] = z * re[c] ;
+            im[CoefficientIndex ( m+1, m )] = z * im[c] ;
+        }
+        for ( n = m + 2 ; n <= p ; n++ )
+        {
+            i     = CoefficientIndex ( n  , m ) ;
+            i1    = CoefficientIndex ( n-1, m ) ;
+            i2    = CoefficientIndex ( n-2, m ) ;
+            a     = ( Real ) ( 2 * n - 1 ) * z ;
+            f     = 1.0e+00 / ( Real ) ( ( n - m ) * ( n + m ) ) ;
+            re[i] = ( a * re[i1] - r2 * re[i2] ) * f ;
+            im[i] = ( a * im[i1] - r2 * im[i2] ) * f ;
+        }
+    }
+    FillNegativeOrders ( p, re, im ) ;
+}
@@ -0,0 +1,530 @@
+/*==================================================================================================================================
+! . Incremental pair lists.
+! . These are self pair-lists that are kept together with the coordinates, grid and grid occupancy with which they were made.
+!   When only some points have moved, the pairs of the moved points are regenerated and the remaining pairs are kept, so the
+!   cost of an update scales with the number of moved points and not with the size of the system.
+!=================================================================================================================================*/
+
+/*
+! . Each pair is stored in the record of the point with the higher index and the records are in increasing order of index.
+!
+! . At an update, the moved points are found and given new cells in the grid occupancy. Their records are dropped and the pairs
+!   they make with the points around their new positions are regenerated. The only other records that can hold pairs with a
+!   moved point are those of the points in the cells within range of the moved point's old cell. These are filtered and all
+!   other records are copied unchanged.
+!
+! . The reference coordinates are those of each point when its pairs were last generated and not the current coordinates.
+!   A list is valid for the current coordinates whenever no point has moved more than half the buffer from its reference.
+*/
+
+# include "BooleanBlock.h"
+# include "IncrementalPairList.h"
+# include "IntegerUtilities.h"
+# include "Memory.h"
+# include "NumericalMacros.h"
+
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The number of blocks per thread for threaded regeneration. */
+# define _BlocksPerThread 8
+
+/* . The number of empty cells added to each side of the grid so that points can move a little beyond their original extent. */
+# define _GridPadding 2
+
+/* . The fraction of moved points above which the list is regenerated from scratch. */
+# define _MaximumMovedFraction 0.25e+00
+
+/* . The first item of a block. */
+# define BlockFirst( b, numberOfBlocks, extent ) ( (b) * ( (extent) / (numberOfBlocks) ) + Minimum ( (b), (extent) % (numberOfBlocks) ) )
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local declarations.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static RegularGrid  *MakePaddedGrid    ( const Coordinates3         *coordinates3   ,
+                                               Selection            *andSelection   ,
+                                         const Real                  cellSize       ,
+                                               Status               *status         ) ;
+static PairList     *MergeRecords      (       PairList             *pairList       ,
+                                         const Integer               numberOfPoints ,
+                                         const Boolean              *isMoved        ,
+                                         const Boolean              *isNear         ,
+                                         const Integer               numberOfBlocks ,
+                                               PairList            **blocks         ,
+                                               Status               *status         ) ;
+static PairList    **RegenerateRecords ( const IncrementalPairList  *self           ,
+                                         const Integer               numberOfMoved  ,
+                                         const Integer              *moved          ,
+                                         const Boolean              *isMoved        ,
+                                         const Boolean              *QAND           ,
+                                         const Boolean              *QOR            ,
+                                         const PairConnections      *exclusions     ,
+                                               Integer              *numberOfBlocks ,
+                                               Status               *status         ) ;
+
+/*==================================================================================================================================
+! . Public procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+IncrementalPairList *IncrementalPairList_Allocate ( const Real cutOff, const Real cellSize, Status *status )
+{
+    IncrementalPairList *self = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        if ( ( cutOff <= 0.0e+00 ) || ( cellSize <= 0.0e+00 ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            self = Memory_AllocateType ( IncrementalPairList ) ;
+            if ( self != NULL )
+            {
+                self->numberOfUpdatedPoints = 0        ;
+                self->cellSize              = cellSize ;
+                self->cutOff                = cutOff   ;
+                self->reference             = NULL     ;
+                self->grid                  = NULL     ;
+                self->occupancy             = NULL     ;
+            }
+            else Status_Set ( status, Status_OutOfMemory ) ;
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void IncrementalPairList_Deallocate ( IncrementalPairList **self )
+{
+    if ( (*self) != NULL )
+    {
+        IncrementalPairList_Reset ( (*self) ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Reset so that the next update regenerates the list from scratch.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void IncrementalPairList_Reset ( IncrementalPairList *self )
+{
+    if ( self != NULL )
+    {
+        Coordinates3_Deallocate         ( &(self->reference) ) ;
+        RegularGrid_Deallocate          ( &(self->grid     ) ) ;
+        RegularGridOccupancy_Deallocate ( &(self->occupancy) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Update a pair-list given a new set of coordinates.
+! . The pair-list is the one returned by the previous update, or NULL, and is not modified. The selections and exclusions must be
+!   the same as those of the previous update.
+! . The moved points are those whose coordinates differ from their reference coordinates. The list is regenerated from scratch
+!   if there is no previous list, if many points have moved or if a moved point has left the grid.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+PairList *IncrementalPairList_Update (       IncrementalPairList *self         ,
+                                       const Coordinates3        *coordinates3 ,
+                                             Selection           *andSelection ,
+                                             Selection           *orSelection  ,
+                                             PairList            *exclusions   ,
+                                             PairList            *pairList     ,
+                                             Status              *status       )
+{
+    PairList *new = NULL ;
+    if ( ( self != NULL ) && ( coordinates3 != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( exclusions != NULL ) && ( ! exclusions->isSelf ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            auto Boolean          doFull, *isMoved = NULL, *isNear = NULL, *QAND = NULL, *QOR = NULL ;
+            auto Integer          i, numberOfBlocks = 0, numberOfMoved = 0, numberOfPoints = Coordinates3_Rows ( coordinates3 ) ;
+            auto Integer         *moved = NULL ;
+            auto PairConnections *connections ;
+            auto PairList       **blocks = NULL ;
+            /* . Allocation. */
+            connections = SelfPairList_MakeConnections ( exclusions, numberOfPoints, status ) ;
+            isMoved     = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPoints, 1 ), Boolean ) ;
+            isNear      = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPoints, 1 ), Boolean ) ;
+            moved       = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPoints, 1 ), Integer ) ;
+            if ( andSelection != NULL ) { auto BooleanBlock *flags = Selection_MakeFlags ( andSelection, numberOfPoints, status ) ; if ( flags != NULL ) QAND = Block_Items ( flags ) ; }
+            if ( orSelection  != NULL ) { auto BooleanBlock *flags = Selection_MakeFlags ( orSelection , numberOfPoints, status ) ; if ( flags != NULL ) QOR  = Block_Items ( flags ) ; }
+            if ( ( isMoved == NULL ) || ( isNear == NULL ) || ( moved == NULL ) ||
+                 ( ( andSelection != NULL ) && ( QAND == NULL ) ) || ( ( orSelection != NULL ) && ( QOR == NULL ) ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else
+            {
+                /* . Find the moved points. */
+                doFull = ( pairList == NULL ) || ( self->reference == NULL ) || ( self->grid == NULL ) || ( self->occupancy == NULL ) ||
+                         ( Coordinates3_Rows ( self->reference ) != numberOfPoints ) ;
+                if ( ! doFull )
+                {
+                    for ( i = 0 ; i < numberOfPoints ; i++ )
+                    {
+                        isMoved[i] = ( ( QAND == NULL ) || QAND[i] ) &&
+                                     ( ( Coordinates3_Item ( coordinates3, i, 0 ) != Coordinates3_Item ( self->reference, i, 0 ) ) ||
+                                       ( Coordinates3_Item ( coordinates3, i, 1 ) != Coordinates3_Item ( self->reference, i, 1 ) ) ||
+                                       ( Coordinates3_Item ( coordinates3, i, 2 ) != Coordinates3_Item ( self->reference, i, 2 ) ) ) ;
+                        isNear [i] = False ;
+                        if ( isMoved[i] ) { moved[numberOfMoved] = i ; numberOfMoved++ ; }
+                    }
+                    doFull = ( ( Real ) numberOfMoved > _MaximumMovedFraction * ( Real ) numberOfPoints ) ;
+                }
+                /* . Flag the points whose records can hold pairs with the moved points and move the points on the grid. */
+                if ( ( ! doFull ) && ( numberOfMoved > 0 ) )
+                {
+                    auto Boolean                *isChanged ;
+                    auto Integer                 c, m, n, numberOfCells = self->occupancy->numberOfCells ;
+                    auto RegularGridSearchRange *range ;
+                    isChanged = Memory_AllocateArrayOfTypes ( numberOfCells, Boolean ) ;
+                    range     = RegularGrid_MakeSearchRange ( self->grid, self->cutOff, status ) ;
+                    if ( ( isChanged == NULL ) || ( range == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+                    else
+                    {
+                        for ( c = 0 ; c < numberOfCells ; c++ ) isChanged[c] = False ;
+                        for ( m = 0 ; m < numberOfMoved ; m++ )
+                        {
+                            c = Array1D_Item ( self->occupancy->pointCells, moved[m] ) ;
+                            if ( c >= 0 ) isChanged[c] = True ;
+                        }
+                        for ( c = 0 ; c < numberOfCells ; c++ )
+                        {
+                            if ( isChanged[c] )
+                            {
+                                n = RegularGrid_FindCellsWithinRangeOfCell ( self->grid, c, range, NULL ) ;
+                                for ( m = 0 ; m < n ; m++ ) isChanged[Array1D_Item ( range->cellIDs, m )] = True ;
+                            }
+                        }
+                        for ( i = 0 ; i < numberOfPoints ; i++ )
+                        {
+                            c = Array1D_Item ( self->occupancy->pointCells, i ) ;
+                            isNear[i] = ( c >= 0 ) && isChanged[c] && ( ! isMoved[i] ) ;
+                        }
+                        for ( m = 0 ; m < numberOfMoved ; m++ )
+                        {
+                            i = moved[m] ;
+                            Coordinates3_Item ( self->reference, i, 0 ) = Coordinates3_Item ( coordinates3, i, 0 ) ;
+                            Coordinates3_Item ( self->reference, i, 1 ) = Coordinates3_Item ( coordinates3, i, 1 ) ;
+                            Coordinates3_Item ( self->reference, i, 2 ) = Coordinates3_Item ( coordinates3, i, 2 ) ;
+                        }
+                        doFull = ( RegularGridOccupancy_UpdatePoints ( self->occupancy, self->grid, self->reference, numberOfMoved, moved, status ) != 0 ) ;
+                    }
+                    Memory_Deallocate ( isChanged ) ;
+                    RegularGridSearchRange_Deallocate ( &range ) ;
+                }
+                /* . Set up for a full regeneration in which all points are treated as moved. */
+                if ( doFull && Status_IsOK ( status ) )
+                {
+                    IncrementalPairList_Reset ( self ) ;
+                    pairList        = NULL ;
+                    self->reference = Coordinates3_CloneDeep ( coordinates3, status ) ;
+                    self->grid      = MakePaddedGrid ( coordinates3, andSelection, self->cellSize, status ) ;
+                    self->occupancy = RegularGridOccupancy_FromGridAndPoints ( self->grid, self->reference, status ) ;
+                    for ( i = numberOfMoved = 0 ; i < numberOfPoints ; i++ )
+                    {
+                        isMoved[i] = ( QAND == NULL ) || QAND[i] ;
+                        isNear [i] = False ;
+                        if ( isMoved[i] ) { moved[numberOfMoved] = i ; numberOfMoved++ ; }
+                    }
+                }
+                /* . Regenerate the pairs of the moved points and merge them with the kept ones. */
+                if ( Status_IsOK ( status ) )
+                {
+                    if ( doFull ) blocks = RegenerateRecords ( self, numberOfMoved, moved, NULL   , QAND, QOR, connections, &numberOfBlocks, status ) ;
+                    else          blocks = RegenerateRecords ( self, numberOfMoved, moved, isMoved, QAND, QOR, connections, &numberOfBlocks, status ) ;
+                    new = MergeRecords ( pairList, numberOfPoints, isMoved, isNear, numberOfBlocks, blocks, status ) ;
+                    self->numberOfUpdatedPoints = numberOfMoved ;
+                }
+                /* . An error leaves the object in an inconsistent state. */
+                if ( ! Status_IsOK ( status ) ) IncrementalPairList_Reset ( self ) ;
+            }
+            /* . Finish up. */
+            if ( blocks != NULL )
+            {
+                auto Integer b ;
+                for ( b = 0 ; b < numberOfBlocks ; b++ ) PairList_Deallocate ( &(blocks[b]) ) ;
+                Memory_Deallocate ( blocks ) ;
+            }
+            Memory_Deallocate ( isMoved ) ;
+            Memory_Deallocate ( isNear  ) ;
+            Memory_Deallocate ( moved   ) ;
+        }
+    }
+    return new ;
+}
+
+/*==================================================================================================================================
+! . Local procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make a grid enclosing a set of coordinates with some extra cells on each side.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static RegularGrid *MakePaddedGrid ( const Coordinates3 *coordinates3, Selection *andSelection, const Real cellSize, Status *status )
+{
+    RegularGrid *grid = Coordinates3_MakeGrid ( coordinates3, andSelection, cellSize, status ) ;
+    if ( grid != NULL )
+    {
+        auto Integer d, stride = 1 ;
+        for ( d = 2 ; d >= 0 ; d-- )
+        {
+            grid->dimensions[d].bins         += 2 * _GridPadding ;
+            grid->dimensions[d].lower        -= ( Real ) _GridPadding * grid->dimensions[d].binSize ;
+            grid->dimensions[d].midPointLower = grid->dimensions[d].lower + 0.5e+00 * grid->dimensions[d].binSize ;
+            grid->dimensions[d].upper         = grid->dimensions[d].lower + ( Real ) ( grid->dimensions[d].bins ) * grid->dimensions[d].binSize ;
+            grid->dimensions[d].stride        = stride ;
+            stride *= grid->dimensions[d].bins ;
+        }
+    }
+    return grid ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Merge the kept pairs of a pair-list with those that have been regenerated.
+! . The records of moved points are dropped and the pairs with moved points are removed from the records of near points.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static PairList *MergeRecords (       PairList  *pairList       ,
+                                const Integer    numberOfPoints ,
+                                const Boolean   *isMoved        ,
+                                const Boolean   *isNear         ,
+                                const Integer    numberOfBlocks ,
+                                      PairList **blocks         ,
+                                      Status    *status         )
+{
+    PairList *new = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        auto Integer  *counts, *regenerated = NULL ;
+        auto Integer   b, i, j, m, n, numberOfPairs = 0, numberOfRecords = 0, numberOfRegenerated = 0, r ;
+        /* . Bucket the regenerated pairs by the point with the higher index. */
+        for ( b = 0 ; b < numberOfBlocks ; b++ ) numberOfRegenerated += blocks[b]->numberOfPairs ;
+        counts      = Memory_AllocateArrayOfTypes ( numberOfPoints + 1                   , Integer ) ;
+        regenerated = Memory_AllocateArrayOfTypes ( Maximum ( numberOfRegenerated, 1 ) , Integer ) ;
+        if ( ( counts == NULL ) || ( regenerated == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+        else
+        {
+            for ( i = 0 ; i <= numberOfPoints ; i++ ) counts[i] = 0 ;
+            for ( b = 0 ; b < numberOfBlocks ; b++ )
+            {
+                for ( r = 0 ; r < blocks[b]->count ; r++ )
+                {
+                    i = PairList_RecordIndex ( blocks[b], r ) ;
+                    for ( m = blocks[b]->offsets[r] ; m < blocks[b]->offsets[r+1] ; m++ ) counts[Maximum ( i, blocks[b]->partners[m] )+1] += 1 ;
+                }
+            }
+            for ( i = 0 ; i < numberOfPoints ; i++ ) counts[i+1] += counts[i] ;
+            for ( b = 0 ; b < numberOfBlocks ; b++ )
+            {
+                for ( r = 0 ; r < blocks[b]->count ; r++ )
+                {
+                    i = PairList_RecordIndex ( blocks[b], r ) ;
+                    for ( m = blocks[b]->offsets[r] ; m < blocks[b]->offsets[r+1] ; m++ )
+                    {
+                        j = blocks[b]->partners[m] ;
+                        n = Maximum ( i, j ) ;
+                        regenerated[counts[n]] = Minimum ( i, j ) ;
+                        counts[n] += 1 ;
+                    }
+                }
+            }
+            for ( i = numberOfPoints ; i > 0 ; i-- ) counts[i] = counts[i-1] ;
+            counts[0] = 0 ;
+            /* . Find the size of the merged list. */
+            numberOfPairs   = numberOfRegenerated ;
+            numberOfRecords = numberOfRegenerated ;
+            if ( pairList != NULL )
+            {
+                numberOfRecords += pairList->count ;
+                for ( r = 0 ; r < pairList->count ; r++ )
+                {
+                    i = PairList_RecordIndex ( pairList, r ) ;
+                    if      ( isMoved[i] ) continue ;
+                    else if ( isNear [i] ) { for ( m = pairList->offsets[r] ; m < pairList->offsets[r+1] ; m++ ) { if ( ! isMoved[pairList->partners[m]] ) numberOfPairs += 1 ; } }
+                    else numberOfPairs += PairList_RecordCapacity ( pairList, r ) ;
+                }
+            }
+            numberOfRecords = Minimum ( numberOfRecords, numberOfPoints ) ;
+            /* . Allocation. */
+            new = PairList_Allocate ( numberOfRecords, status ) ;
+            if ( ( new != NULL ) && ( numberOfPairs > new->partnerCapacity ) ) PairList_ReallocatePartners ( new, numberOfPairs, status ) ;
+        }
+        /* . Merge the records in order of increasing index. */
+        if ( Status_IsOK ( status ) )
+        {
+            auto Integer nK = 0, p, rK = 0 ;
+            auto Integer *partners = new->partners ;
+            new->isSelf = True ;
+            if ( pairList != NULL ) nK = pairList->count ;
+            for ( i = p = 0 ; i < numberOfPoints ; i++ )
+            {
+                n = p ;
+                if ( ( rK < nK ) && ( PairList_RecordIndex ( pairList, rK ) == i ) )
+                {
+                    if ( isNear[i] )
+                    {
+                        for ( m = pairList->offsets[rK] ; m < pairList->offsets[rK+1] ; m++ )
+                        {
+                            j = pairList->partners[m] ;
+                            if ( ! isMoved[j] ) { partners[p] = j ; p++ ; }
+                        }
+                    }
+                    else if ( ! isMoved[i] )
+                    {
+                        m = PairList_RecordCapacity ( pairList, rK ) ;
+                        Integer_CopyTo ( PairList_RecordPartners ( pairList, rK ), m, &(partners[p]), NULL ) ;
+                        p += m ;
+                    }
+                    rK++ ;
+                }
+                m = counts[i+1] - counts[i] ;
+                if ( m > 0 ) { Integer_CopyTo ( &(regenerated[counts[i]]), m, &(partners[p]), NULL ) ; p += m ; }
+                if ( p > n )
+                {
+                    new->indices[new->count]   = i ;
+                    new->offsets[new->count+1] = p ;
+                    new->count += 1 ;
+                }
+            }
+            new->numberOfPairs = p ;
+        }
+        else PairList_Deallocate ( &new ) ;
+        Memory_Deallocate ( counts      ) ;
+        Memory_Deallocate ( regenerated ) ;
+    }
+    return new ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Regenerate the pairs of a set of moved points.
+! . The pairs between two moved points are only generated for the point with the higher index. If the moved flags are absent, all
+!   points are taken to have moved.
+! . The pairs are generated by block with each block being saved to its own pairlist.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static PairList **RegenerateRecords ( const IncrementalPairList  *self           ,
+                                      const Integer               numberOfMoved  ,
+                                      const Integer              *moved          ,
+                                      const Boolean              *isMoved        ,
+                                      const Boolean              *QAND           ,
+                                      const Boolean              *QOR            ,
+                                      const PairConnections      *exclusions     ,
+                                            Integer              *numberOfBlocks ,
+                                            Status               *status         )
+{
+    Boolean                 **isIncluded = NULL ;
+    Integer                   b, i, n, numberOfPoints, numberOfThreads = 1, t ;
+    Integer                 **indices    = NULL ;
+    PairList                **blocks     = NULL ;
+    RegularGrid             **grids      = NULL ;
+    RegularGridSearchRange  **ranges     = NULL ;
+    /* . Allocation. */
+    /* . Each thread has its own flags, indices and grid as the cell searches use the grid's work arrays. */
+# ifdef USEOPENMP
+    numberOfThreads = omp_get_max_threads ( ) ;
+# endif
+    n              = Maximum ( Minimum ( numberOfMoved, numberOfThreads * _BlocksPerThread ), 1 ) ;
+    numberOfPoints = Coordinates3_Rows ( self->reference ) ;
+    blocks         = Memory_AllocateArrayOfReferences ( n              , PairList               ) ;
+    grids          = Memory_AllocateArrayOfReferences ( numberOfThreads, RegularGrid            ) ;
+    indices        = Memory_AllocateArrayOfReferences ( numberOfThreads, Integer                ) ;
+    isIncluded     = Memory_AllocateArrayOfReferences ( numberOfThreads, Boolean                ) ;
+    ranges         = Memory_AllocateArrayOfReferences ( numberOfThreads, RegularGridSearchRange ) ;
+    if ( ( blocks == NULL ) || ( grids == NULL ) || ( indices == NULL ) || ( isIncluded == NULL ) || ( ranges == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+    else
+    {
+        for ( b = 0 ; b < n ; b++ ) blocks[b] = PairList_Allocate ( numberOfMoved / n + 1, status ) ;
+        for ( t = 0 ; t < numberOfThreads ; t++ )
+        {
+            grids     [t] = RegularGrid_Clone ( self->grid, status ) ;
+            ranges    [t] = RegularGrid_MakeSearchRange ( grids[t], self->cutOff, status ) ;
+            indices   [t] = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPoints, 1 ), Integer ) ;
+            isIncluded[t] = Memory_AllocateArrayOfTypes ( Maximum ( numberOfPoints, 1 ), Boolean ) ;
+            if ( ( grids[t] == NULL ) || ( ranges[t] == NULL ) || ( indices[t] == NULL ) || ( isIncluded[t] == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else { for ( i = 0 ; i < numberOfPoints ; i++ ) isIncluded[t][i] = ( QAND == NULL ) || QAND[i] ; }
+        }
+    }
+    /* . Loop over blocks of points. */
+    if ( Status_IsOK ( status ) )
+    {
+        auto Integer numberOfErrors = 0 ;
+# ifdef USEOPENMP
+        #pragma omp parallel for num_threads ( numberOfThreads ) reduction ( + : numberOfErrors ) schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < n ; b++ )
+        {
+            auto Boolean                 includeAll, QORI, *tIsIncluded ;
+            auto Integer                 a, aLast, c, i, j, m, numberOfCells, p, pStart, pTotal, q, t = 0, x, xFirst = 0, xLast = 0, *tIndices ;
+            auto Real                    cutOffSquared = self->cutOff * self->cutOff, xij, yij, zij ;
+            auto RegularGridSearchRange *range ;
+            auto Status                  localStatus = Status_OK ;
+# ifdef USEOPENMP
+            t = omp_get_thread_num ( ) ;
+# endif
+            range       = ranges    [t] ;
+            tIndices    = indices   [t] ;
+            tIsIncluded = isIncluded[t] ;
+            aLast       = BlockFirst ( b+1, n, numberOfMoved ) ;
+            for ( a = BlockFirst ( b, n, numberOfMoved ) ; a < aLast ; a++ )
+            {
+                i    = moved[a] ;
+                QORI = ( QOR == NULL ) || QOR[i] ;
+                /* . Flag excluded points. */
+                if ( exclusions != NULL )
+                {
+                    xFirst = exclusions->itemsI[i]   ;
+                    xLast  = exclusions->itemsI[i+1] ;
+                    for ( x = xFirst ; x < xLast ; x++ ) tIsIncluded[exclusions->itemsJ[x]] = False ;
+                }
+                /* . Loop over cells within range. */
+                numberOfCells = RegularGrid_FindCellsWithinRangeOfCell ( grids[t], Array1D_Item ( self->occupancy->pointCells, i ), range, NULL ) ;
+                for ( m = q = 0 ; m < numberOfCells ; m++ )
+                {
+                    c          = Array1D_Item ( range->cellIDs                   , m ) ;
+                    includeAll = Array1D_Item ( range->isFullyWithinRange        , m ) ;
+                    pStart     = Array1D_Item ( self->occupancy->cellFirstPoints , c ) ;
+                    pTotal     = Array1D_Item ( self->occupancy->cellTotalPoints , c ) ;
+                    for ( p = pStart ; p < pStart + pTotal ; p++ )
+                    {
+                        j = Array1D_Item ( self->occupancy->cellPoints, p ) ;
+                        if ( isMoved == NULL ) { if ( j >= i ) break ; }
+                        else if ( ( j == i ) || ( isMoved[j] && ( j > i ) ) ) continue ;
+                        if ( tIsIncluded[j] && ( QORI || QOR[j] ) )
+                        {
+                            if ( ! includeAll )
+                            {
+                                Coordinates3_DifferenceRow ( self->reference, i, j, xij, yij, zij ) ;
+                                if ( ( xij * xij + yij * yij + zij * zij ) > cutOffSquared ) continue ;
+                            }
+                            tIndices[q] = j ; q++ ;
+                        }
+                    }
+                }
+                /* . Save the interactions. */
+                if ( q > 0 ) PairList_Append ( blocks[b], i, q, tIndices, &localStatus ) ;
+                /* . Unflag excluded points. */
+                if ( exclusions != NULL )
+                {
+                    for ( x = xFirst ; x < xLast ; x++ ) { j = exclusions->itemsJ[x] ; tIsIncluded[j] = ( QAND == NULL ) || QAND[j] ; }
+                }
+            }
+            if ( localStatus != Status_OK ) numberOfErrors += 1 ;
+        }
+        if ( numberOfErrors > 0 ) Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    /* . Finish up. */
+    for ( t = 0 ; t < numberOfThreads ; t++ )
+    {
+        if ( grids      != NULL ) RegularGrid_Deallocate            ( &(grids [t]) ) ;
+        if ( ranges     != NULL ) RegularGridSearchRange_Deallocate ( &(ranges[t]) ) ;
+        if ( indices    != NULL ) Memory_Deallocate ( indices   [t] ) ;
+        if ( isIncluded != NULL ) Memory_Deallocate ( isIncluded[t] ) ;
+    }
+    Memory_Deallocate ( grids      ) ;
+    Memory_Deallocate ( indices    ) ;
+    Memory_Deallocate ( isIncluded ) ;
+    Memory_Deallocate ( ranges     ) ;
+    (*numberOfBlocks) = ( blocks == NULL ) ? 0 : n ;
+    return blocks ;
+}
@@ -0,0 +1,183 @@
+/*==================================================================================================================================
+! . Minimum image pair lists.
+! . These are self pair-lists that include the interactions between all images of a set of points within a periodic cell. They
+!   are generated with a single periodic cell list and are valid when the cut-off is no larger than half of the cell's smallest
+!   perpendicular width so that each pair has at most one image within range.
+!=================================================================================================================================*/
+
+# include <math.h>
+
+# include "BooleanBlock.h"
+# include "Memory.h"
+# include "MinimumImagePairList.h"
+# include "MinimumImageUtilities.h"
+# include "NumericalMacros.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The cell size as a fraction of the cut-off. */
+# define _CellSizeFactor 0.5e+00
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make a self pair-list within the minimum image convention.
+! . The points are wrapped into the primary cell and sorted into a grid of cells along the cell axes. The cells searched for a
+!   point are all those within range of it, with offsets that may extend past the grid's boundaries. Each offset corresponds
+!   to a distinct image of its cell, with its own translation, so no rounding is needed for the displacements and each image is
+!   visited once even when the grid has few cells along an axis.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+PairList *MinimumImagePairList_SelfFromCoordinates3 ( const Real                cutOff             ,
+                                                      const Coordinates3       *coordinates3       ,
+                                                      const SymmetryParameters *symmetryParameters ,
+                                                            Selection          *andSelection       ,
+                                                            Selection          *orSelection        ,
+                                                            PairList           *exclusions         ,
+                                                            Status             *status             )
+{
+    PairList *pairList = NULL ;
+    if ( ( coordinates3 != NULL ) && ( symmetryParameters != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( ( exclusions != NULL ) && ( ! exclusions->isSelf ) ) || ( cutOff <= 0.0e+00 ) ||
+             ( ! SymmetryParameters_IsMinimumImageConventionSatisfied ( symmetryParameters, cutOff ) ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            auto Boolean         *isIncluded = NULL, *QAND = NULL, *QOR = NULL ;
+            auto Coordinates3    *fractional ;
+            auto Integer          a, extents[3], numberOfCells, numberOfPoints = Coordinates3_Rows ( coordinates3 ), ranges[3] ;
+            auto Integer         *cellPoints = NULL, *cells = NULL, *cellStarts = NULL, *indices = NULL ;
+            auto PairConnections *connections ;
+            auto Real            *cellCoordinates = NULL, h[9], widths[3] ;
+            /* . Cell extents and the number of cells within range along each axis. */
+            SymmetryParameters_PerpendicularWidths ( symmetryParameters, widths ) ;
+            for ( a = 0, numberOfCells = 1 ; a < 3 ; a++ )
+            {
+                extents[a]     = Maximum ( ( Integer ) floor ( widths[a] / ( _CellSizeFactor * cutOff ) ), 1 ) ;
+                ranges [a]     = ( Integer ) ceil ( cutOff * ( Real ) extents[a] / widths[a] ) ;
+                numberOfCells *= extents[a] ;
+            }
+            /* . Allocation. */
+            connections     = SelfPairList_MakeConnections ( exclusions, numberOfPoints, status ) ;
+            fractional      = SymmetryParameters_MakeFractionalCoordinates ( symmetryParameters, coordinates3, status ) ;
+            pairList        = PairList_Allocate ( numberOfPoints, status ) ;
+            cellCoordinates = Memory_AllocateArrayOfTypes ( Maximum ( 3 * numberOfPoints, 1 ), Real    ) ;
+            cellPoints      = Memory_AllocateArrayOfTypes ( Maximum (     numberOfPoints, 1 ), Integer ) ;
+            cells           = Memory_AllocateArrayOfTypes ( Maximum (     numberOfPoints, 1 ), Integer ) ;
+            cellStarts      = Memory_AllocateArrayOfTypes ( numberOfCells + 1                , Integer ) ;
+            indices         = Memory_AllocateArrayOfTypes ( Maximum (     numberOfPoints, 1 ), Integer ) ;
+            isIncluded      = Memory_AllocateArrayOfTypes ( Maximum (     numberOfPoints, 1 ), Boolean ) ;
+            if ( andSelection != NULL ) { auto BooleanBlock *flags = Selection_MakeFlags ( andSelection, numberOfPoints, status ) ; if ( flags != NULL ) QAND = Block_Items ( flags ) ; }
+            if ( orSelection  != NULL ) { auto BooleanBlock *flags = Selection_MakeFlags ( orSelection , numberOfPoints, status ) ; if ( flags != NULL ) QOR  = Block_Items ( flags ) ; }
+            if ( ( fractional == NULL ) || ( pairList   == NULL ) || ( cellCoordinates == NULL ) || ( cellPoints == NULL ) ||
+                 ( cells      == NULL ) || ( cellStarts == NULL ) || ( indices         == NULL ) || ( isIncluded == NULL ) ||
+                 ( ( andSelection != NULL ) && ( QAND == NULL ) ) || ( ( orSelection != NULL ) && ( QOR == NULL ) ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else
+            {
+                auto Boolean QORI ;
+                auto Integer b, c, cA, cB, cC, i, j, n, nA, nB, nC, oA, oB, oC, p, x, xFirst = 0, xLast = 0 ;
+                auto Real    cutOff2 = cutOff * cutOff, fA, fB, fC, *rJ, sA, sB, sC, xI, xIJ, yI, yIJ, zI, zIJ ;
+                pairList->isSelf = True ;
+                MinimumImage_GetH ( symmetryParameters, h ) ;
+                /* . Assign the points to cells in order so that the points of each cell are sorted. */
+                for ( c = 0 ; c <= numberOfCells ; c++ ) cellStarts[c] = 0 ;
+                for ( i = 0 ; i < numberOfPoints ; i++ )
+                {
+                    cA = Minimum ( ( Integer ) ( Coordinates3_Item ( fractional, i, 0 ) * ( Real ) extents[0] ), extents[0] - 1 ) ;
+                    cB = Minimum ( ( Integer ) ( Coordinates3_Item ( fractional, i, 1 ) * ( Real ) extents[1] ), extents[1] - 1 ) ;
+                    cC = Minimum ( ( Integer ) ( Coordinates3_Item ( fractional, i, 2 ) * ( Real ) extents[2] ), extents[2] - 1 ) ;
+                    cells[i] = ( cA * extents[1] + cB ) * extents[2] + cC ;
+                    cellStarts[cells[i]+1] += 1 ;
+                    isIncluded[i] = ( QAND == NULL ) || QAND[i] ;
+                }
+                for ( c = 0 ; c < numberOfCells ; c++ ) cellStarts[c+1] += cellStarts[c] ;
+                /* . The points are stored by cell with the Cartesian coordinates of their images in the primary cell. */
+                for ( i = 0 ; i < numberOfPoints ; i++ )
+                {
+                    c  = cells[i] ;
+                    p  = cellStarts[c] ;
+                    fA = Coordinates3_Item ( fractional, i, 0 ) ;
+                    fB = Coordinates3_Item ( fractional, i, 1 ) ;
+                    fC = Coordinates3_Item ( fractional, i, 2 ) ;
+                    cellPoints[p]        = i ;
+                    cellCoordinates[3*p  ] = h[0] * fA + h[1] * fB + h[2] * fC ;
+                    cellCoordinates[3*p+1] = h[3] * fA + h[4] * fB + h[5] * fC ;
+                    cellCoordinates[3*p+2] = h[6] * fA + h[7] * fB + h[8] * fC ;
+                    cellStarts[c] += 1 ;
+                }
+                for ( c = numberOfCells ; c > 0 ; c-- ) cellStarts[c] = cellStarts[c-1] ;
+                cellStarts[0] = 0 ;
+                /* . Loop over points. */
+                for ( i = 1 ; i < numberOfPoints ; i++ )
+                {
+                    if ( ! isIncluded[i] ) continue ;
+                    QORI = ( QOR == NULL ) || QOR[i] ;
+                    /* . Flag excluded points. */
+                    if ( connections != NULL )
+                    {
+                        xFirst = connections->itemsI[i]   ;
+                        xLast  = connections->itemsI[i+1] ;
+                        for ( x = xFirst ; x < xLast ; x++ ) { j = connections->itemsJ[x] ; if ( j >= i ) break ; isIncluded[j] = False ; }
+                    }
+                    /* . Loop over cells within range. */
+                    c  = cells[i] ;
+                    cA = c / ( extents[1] * extents[2] ) ;
+                    cB = ( c / extents[2] ) % extents[1] ;
+                    cC = c % extents[2] ;
+                    fA = Coordinates3_Item ( fractional, i, 0 ) ;
+                    fB = Coordinates3_Item ( fractional, i, 1 ) ;
+                    fC = Coordinates3_Item ( fractional, i, 2 ) ;
+                    for ( n = 0, oA = cA - ranges[0] ; oA <= cA + ranges[0] ; oA++ )
+                    {
+                        nA = ( ( oA % extents[0] ) + extents[0] ) % extents[0] ;
+                        sA = fA - ( Real ) ( ( oA - nA ) / extents[0] ) ;
+                        for ( oB = cB - ranges[1] ; oB <= cB + ranges[1] ; oB++ )
+                        {
+                            nB = ( ( oB % extents[1] ) + extents[1] ) % extents[1] ;
+                            sB = fB - ( Real ) ( ( oB - nB ) / extents[1] ) ;
+                            for ( oC = cC - ranges[2] ; oC <= cC + ranges[2] ; oC++ )
+                            {
+                                nC = ( ( oC % extents[2] ) + extents[2] ) % extents[2] ;
+                                sC = fC - ( Real ) ( ( oC - nC ) / extents[2] ) ;
+                                b  = ( nA * extents[1] + nB ) * extents[2] + nC ;
+                                /* . The coordinates of point i relative to the image of the cell. */
+                                xI = h[0] * sA + h[1] * sB + h[2] * sC ;
+                                yI = h[3] * sA + h[4] * sB + h[5] * sC ;
+                                zI = h[6] * sA + h[7] * sB + h[8] * sC ;
+                                for ( p = cellStarts[b] ; p < cellStarts[b+1] ; p++ )
+                                {
+                                    j = cellPoints[p] ;
+                                    if ( j >= i ) break ;
+                                    rJ  = &cellCoordinates[3*p] ;
+                                    xIJ = xI - rJ[0] ;
+                                    yIJ = yI - rJ[1] ;
+                                    zIJ = zI - rJ[2] ;
+                                    if ( ( ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) <= cutOff2 ) && isIncluded[j] && ( QORI || QOR[j] ) ) { indices[n] = j ; n++ ; }
+                                }
+                            }
+                        }
+                    }
+                    /* . Save the interactions. */
+                    if ( n > 0 )
+                    {
+                        PairList_Append ( pairList, i, n, indices, status ) ;
+                        if ( ! Status_IsOK ( status ) ) break ;
+                    }
+                    /* . Unflag excluded points. */
+                    if ( connections != NULL )
+                    {
+                        for ( x = xFirst ; x < xLast ; x++ ) { j = connections->itemsJ[x] ; if ( j >= i ) break ; isIncluded[j] = ( QAND == NULL ) || QAND[j] ; }
+                    }
+                }
+            }
+            /* . Finish up. */
+            Coordinates3_Deallocate ( &fractional ) ;
+            Memory_Deallocate ( cellCoordinates ) ;
+            Memory_Deallocate ( cellPoints      ) ;
+            Memory_Deallocate ( cells           ) ;
+            Memory_Deallocate ( cellStarts      ) ;
+            Memory_Deallocate ( indices         ) ;
+            Memory_Deallocate ( isIncluded      ) ;
+            if ( ! Status_IsOK ( status ) ) PairList_Deallocate ( &pairList ) ;
+        }
+    }
+    return pairList ;
+}
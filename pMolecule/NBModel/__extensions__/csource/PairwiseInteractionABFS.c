@@ -2,13 +2,20 @@
 ! . Pairwise interactions with ABFS smoothing.
 !=================================================================================================================================*/
 
+# include <math.h>
+
 # include "Boolean.h"
+# include "MachineTypes.h"
 # include "Memory.h"
 # include "MinimumImageUtilities.h"
 # include "NumericalMacros.h"
 # include "PairwiseInteractionABFS.h"
 # include "Units.h"
 
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Parameters.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -16,6 +23,9 @@
 # define _DefaultInnerCutOff    8.0e+00
 # define _DefaultOuterCutOff   12.0e+00
 
+/* . The cluster size. */
+# define _ClusterSize ClusterPairList_ClusterSize
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Structures.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -47,6 +57,31 @@ typedef struct {
     Real bAlpha   ;
 } ABFSFactors ;
 
+/* . Single precision factors. */
+typedef struct {
+    Real32 r2Damp   ;
+    Real32 r2Off    ;
+    Real32 r2On     ;
+    Real32 a        ;
+    Real32 b        ;
+    Real32 c        ;
+    Real32 d        ;
+    Real32 qShift1  ;
+    Real32 qShift2  ;
+    Real32 qF0      ;
+    Real32 qAlpha   ;
+    Real32 aF6      ;
+    Real32 aK12     ;
+    Real32 aShift12 ;
+    Real32 aF0      ;
+    Real32 aAlpha   ;
+    Real32 bF3      ;
+    Real32 bK6      ;
+    Real32 bShift6  ;
+    Real32 bF0      ;
+    Real32 bAlpha   ;
+} ABFSFactorsSingle ;
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Macros.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -58,6 +93,13 @@ typedef struct {
         else { s2 = 1.0e+00 / r2 ; s = sqrt ( s2 ) ; } \
     }
 
+/* . The index of the lowest set bit of a non-zero mask. */
+# ifdef __GNUC__
+# define LowestSetBit( mask, k ) { k = __builtin_ctz ( mask ) ; }
+# else
+# define LowestSetBit( mask, k ) { for ( k = 0 ; ( ( mask >> k ) & 1 ) == 0 ; k++ ) ; }
+# endif
+
 /* . Electrostaticinteraction. */
 # define ElectrostaticTerm( self, r2, s, qIJ, f, g ) \
     { \
@@ -144,12 +186,61 @@ typedef struct {
         } \
     }
 
+/* . Single precision versions of the distance check and the electrostatic and Lennard-Jones interactions. */
+# define CheckDistancesSingle( self, r2, s, s2 ) \
+    { \
+        if ( r2 > self.r2Off  ) continue ; \
+        else if ( r2 < self.r2Damp ) { s2 = 0.0e+00f ; s = 0.0e+00f ; } \
+        else { s2 = 1.0e+00f / r2 ; s = sqrtf ( s2 ) ; } \
+    }
+
+# define ElectrostaticTermSingle( self, r2, s, qIJ, f, g ) \
+    { \
+        if ( r2 > self.r2On ) \
+        { \
+            f  = qIJ * ( s * ( self.a - r2 * ( self.b + r2 * ( self.c + self.d * r2 ) ) ) + self.qShift2 ) ; \
+            g += - qIJ * 0.5e+00f * s * ( self.a + r2 * ( self.b + r2 * ( 3.0e+00f * self.c + 5.0e+00f * self.d * r2 ) ) ) / r2 ; \
+        } \
+        else if ( r2 > self.r2Damp ) \
+        { \
+            f  = qIJ * ( s + self.qShift1 ) ; \
+            g += - qIJ * 0.5e+00f * s / r2 ; \
+        } \
+        else \
+        { \
+            f  = qIJ * ( self.qF0 - self.qAlpha * r2 ) ; \
+            g += - qIJ * self.qAlpha ; \
+        } \
+    }
+
+# define LennardJonesTermSingle( self, r2, s, s2, aIJ, bIJ, f, g ) \
+    { \
+        auto Real32 s6 = s2 * s2 * s2 ; \
+        if ( r2 > self.r2On ) \
+        { \
+            auto Real32 l1 = s6 - self.aF6, l2 = ( s / r2 ) - self.bF3 ; \
+            f  = aIJ * self.aK12 * l1 * l1 - bIJ * self.bK6 * l2 * l2 ; \
+            g += - 3.0e+00f * s6 * ( 2.0e+00f * aIJ * self.aK12 * l1 / r2 - bIJ * self.bK6 * l2 / s ) ; \
+        } \
+        else if ( r2 > self.r2Damp ) \
+        { \
+            f  = aIJ * ( s6 * s6 - self.aShift12 ) - bIJ * ( s6 - self.bShift6 ) ; \
+            g += - 3.0e+00f * s6 * ( 2.0e+00f * aIJ * s6 - bIJ ) / r2 ; \
+        } \
+        else \
+        { \
+            f  = aIJ * ( self.aF0 - self.aAlpha * r2 ) - bIJ * ( self.bF0 - self.bAlpha * r2 ) ; \
+            g += - aIJ * self.aAlpha + bIJ * self.bAlpha ; \
+        } \
+    }
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Local functions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static void PairwiseInteractionABFS_CopyTo            ( const PairwiseInteractionABFS *self, PairwiseInteractionABFS *other ) ;
-static void PairwiseInteractionABFS_Initialize        (       PairwiseInteractionABFS *self ) ;
-static void PairwiseInteractionABFS_InitializeFactors ( const PairwiseInteractionABFS *self, ABFSFactors *factors ) ;
+static void PairwiseInteractionABFS_CopyTo                  ( const PairwiseInteractionABFS *self, PairwiseInteractionABFS *other ) ;
+static void PairwiseInteractionABFS_Initialize              (       PairwiseInteractionABFS *self ) ;
+static void PairwiseInteractionABFS_InitializeFactors       ( const PairwiseInteractionABFS *self, ABFSFactors       *factors ) ;
+static void PairwiseInteractionABFS_InitializeFactorsSingle ( const PairwiseInteractionABFS *self, ABFSFactorsSingle *factors ) ;
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Allocation.
@@ -264,6 +355,39 @@ static void PairwiseInteractionABFS_InitializeFactors ( const PairwiseInteractio
     }
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Initialize single precision factors.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void PairwiseInteractionABFS_InitializeFactorsSingle ( const PairwiseInteractionABFS *self, ABFSFactorsSingle *factors )
+{
+    if ( ( self != NULL ) && ( factors != NULL ) )
+    {
+        auto ABFSFactors f ;
+        PairwiseInteractionABFS_InitializeFactors ( self, &f ) ;
+        factors->r2Damp   = ( Real32 ) f.r2Damp   ;
+        factors->r2Off    = ( Real32 ) f.r2Off    ;
+        factors->r2On     = ( Real32 ) f.r2On     ;
+        factors->a        = ( Real32 ) f.a        ;
+        factors->b        = ( Real32 ) f.b        ;
+        factors->c        = ( Real32 ) f.c        ;
+        factors->d        = ( Real32 ) f.d        ;
+        factors->qShift1  = ( Real32 ) f.qShift1  ;
+        factors->qShift2  = ( Real32 ) f.qShift2  ;
+        factors->qF0      = ( Real32 ) f.qF0      ;
+        factors->qAlpha   = ( Real32 ) f.qAlpha   ;
+        factors->aF6      = ( Real32 ) f.aF6      ;
+        factors->aK12     = ( Real32 ) f.aK12     ;
+        factors->aShift12 = ( Real32 ) f.aShift12 ;
+        factors->aF0      = ( Real32 ) f.aF0      ;
+        factors->aAlpha   = ( Real32 ) f.aAlpha   ;
+        factors->bF3      = ( Real32 ) f.bF3      ;
+        factors->bK6      = ( Real32 ) f.bK6      ;
+        factors->bShift6  = ( Real32 ) f.bShift6  ;
+        factors->bF0      = ( Real32 ) f.bF0      ;
+        factors->bAlpha   = ( Real32 ) f.bAlpha   ;
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Interactions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -343,63 +467,417 @@ void PairwiseInteractionABFS_MMMMEnergy ( const PairwiseInteractionABFS *self
         if ( doElectrostatic|| doLennardJones )
         {
             auto ABFSFactors       factors ;
-            auto Integer           i, j, n, numberOfLJTypes = 0, tI = 0, tIJ ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
-            auto Real              aIJ, bIJ, eScale, f, g, qI = 0.0e+00, qIJ, r2, s, s2, xI, xIJ, xJ, yI, yIJ, yJ, zI, zIJ, zJ ;
+            auto Integer           numberOfLJTypes = 0, numberOfThreads ;
+            auto Real              eScale, *iBuffers = NULL, *jBuffers = NULL ;
             auto Real              eLJ = 0.0e+00, eQQ = 0.0e+00 ;
             /* . Initialization. */
             eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
             if ( doLennardJones  ) numberOfLJTypes = ljParameters->ntypes ;
             PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-            /* . Loop over record. */
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3I, gradients3J, &numberOfThreads, &iBuffers, &jBuffers ) ;
+            else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+            /* . Loop over records. */
+# ifdef USEOPENMP
+            #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
             {
-                /* . First atom. */
-                i  = record->index ;
-	        if ( doElectrostatic ) qI = eScale          * Array1D_Item ( chargesI, i ) ;
-                if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
-	        Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
-                /* . Second atom. */
-       	        for ( n = 0 ; n < record->capacity ; n++ )
-	        {
-	            j   = record->indices[n] ;
-	            Coordinates3_GetRow ( coordinates3J , j, xJ, yJ, zJ ) ;
-                    xIJ = xI - xJ ;
-                    yIJ = yI - yJ ;
-                    zIJ = zI - zJ ;
-                    r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
-                    CheckDistances ( factors, r2, s, s2 ) ;
-                    f = 0.0e+00 ;
-                    g = 0.0e+00 ;
-                    if ( doElectrostatic)
+                auto Coordinates3 iView, jView, *threadGradients3I = NULL, *threadGradients3J = NULL ;
+                auto Integer      i, j, n, r, tI = 0, tIJ ;
+                auto Real         aIJ, bIJ, f, g, qI = 0.0e+00, qIJ, r2, s, s2, xI, xIJ, xJ, yI, yIJ, yJ, zI, zIJ, zJ ;
+                if ( doGradients )
+                {
+                    threadGradients3I = Coordinates3_ThreadBuffer ( gradients3I, iBuffers, &iView ) ;
+                    threadGradients3J = Coordinates3_ThreadBuffer ( gradients3J, jBuffers, &jView ) ;
+                }
+# ifdef USEOPENMP
+                #pragma omp for schedule ( dynamic )
+# endif
+                for ( r = 0 ; r < pairList->count ; r++ )
+                {
+                    /* . First atom. */
+                    i  = pairList->indices[r] ;
+                    if ( doElectrostatic ) qI = eScale          * Array1D_Item ( chargesI, i ) ;
+                    if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
+                    Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
+                    /* . Second atom. */
+                    for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
                     {
-                        qIJ = qI * Array1D_Item ( chargesJ, j ) ;
-                        ElectrostaticTerm ( factors, r2, s, qIJ, f, g ) ;
-                        eQQ += f ;
+                        j   = pairList->partners[n] ;
+                        Coordinates3_GetRow ( coordinates3J , j, xJ, yJ, zJ ) ;
+                        xIJ = xI - xJ ;
+                        yIJ = yI - yJ ;
+                        zIJ = zI - zJ ;
+                        r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                        CheckDistances ( factors, r2, s, s2 ) ;
+                        f = 0.0e+00 ;
+                        g = 0.0e+00 ;
+                        if ( doElectrostatic)
+                        {
+                            qIJ = qI * Array1D_Item ( chargesJ, j ) ;
+                            ElectrostaticTerm ( factors, r2, s, qIJ, f, g ) ;
+                            eQQ += f ;
+                        }
+                        if ( doLennardJones )
+                        {
+                            tIJ = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                            aIJ = ljParameters->tableA[tIJ] * lennardJonesScale ;
+                            bIJ = ljParameters->tableB[tIJ] * lennardJonesScale ;
+                            LennardJonesTerm ( factors, r2, s, s2, aIJ, bIJ, f, g ) ;
+                            eLJ += f ;
+                        }
+                        if ( doGradients )
+                        {
+                            g   *= 2.0e+00 ;
+                            xIJ *= g ;
+                            yIJ *= g ;
+                            zIJ *= g ;
+                            Coordinates3_IncrementRow ( threadGradients3I, i, xIJ, yIJ, zIJ ) ;
+                            Coordinates3_DecrementRow ( threadGradients3J, j, xIJ, yIJ, zIJ ) ;
+                        }
                     }
-                    if ( doLennardJones )
+                }
+            }
+            if ( doGradients     ) Coordinates3_ReducePairedThreadBuffers ( gradients3I, gradients3J, numberOfThreads, &iBuffers, &jBuffers ) ;
+            if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
+            if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . MM/MM energy and gradients with a cluster pair list.
+! . The coordinates, charges and types of the atoms are packed cluster by cluster so that the data for a cluster pair is
+!   contiguous and the gradients are accumulated in the packed arrays. The pairs of each cluster pair are given by its mask so
+!   there are no exclusion checks and no partner lookups.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void PairwiseInteractionABFS_MMMMEnergyCluster ( const PairwiseInteractionABFS *self               ,
+                                                 const RealArray1D             *charges            ,
+                                                       IntegerArray1D          *ljTypes            ,
+                                                 const LJParameterContainer    *ljParameters       ,
+                                                 const Real                     electrostaticScale ,
+                                                 const Real                     lennardJonesScale  ,
+                                                 const Coordinates3            *coordinates3       ,
+                                                 const ClusterPairList         *clusterPairList    ,
+                                                       Real                    *eElectrostatic     ,
+                                                       Real                    *eLennardJones      ,
+                                                       Coordinates3            *gradients3         ,
+                                                       Status                  *status             )
+{
+    if ( eElectrostatic != NULL ) (*eElectrostatic) = 0.0e+00 ;
+    if ( eLennardJones  != NULL ) (*eLennardJones ) = 0.0e+00 ;
+    if ( ( self            != NULL ) &&
+         ( coordinates3    != NULL ) &&
+         ( clusterPairList != NULL ) &&
+           Status_IsOK ( status ) )
+    {
+        auto Boolean doElectrostatic, doGradients, doLennardJones ;
+        doElectrostatic = ( charges            != NULL    ) &&
+                          ( eElectrostatic     != NULL    ) &&
+                          ( electrostaticScale != 0.0e+00 ) ;
+        doGradients     = ( gradients3         != NULL    ) ;
+        doLennardJones  = ( eLennardJones      != NULL    ) &&
+                          ( ljTypes            != NULL    ) &&
+                          ( ljParameters       != NULL    ) &&
+                          ( lennardJonesScale  != 0.0e+00 ) ;
+        if ( doElectrostatic || doLennardJones )
+        {
+            auto Integer  m     = clusterPairList->numberOfClusters * _ClusterSize, numberOfThreads, w ;
+            auto Integer *types = NULL ;
+            auto Real    *work  = NULL ;
+            Coordinates3_AllocateThreadBuffers ( NULL, &numberOfThreads ) ;
+            w     = 4 * m ;
+            if ( doGradients ) w += 3 * m * numberOfThreads ;
+            types = Memory_AllocateArrayOfTypes ( Maximum ( m, 1 ), Integer ) ;
+            work  = Memory_AllocateArrayOfTypes ( Maximum ( w, 1 ), Real    ) ;
+            if ( ( types == NULL ) || ( work == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else
+            {
+                auto ABFSFactors factors ;
+                auto Integer     i, j, numberOfLJTypes = 0, t ;
+                auto Real        eScale, gXt, gYt, gZt ;
+                auto Real        eLJ = 0.0e+00, eQQ = 0.0e+00 ;
+                auto Real       *q = &work[3*m], *x = &work[0], *y = &work[m], *z = &work[2*m] ;
+                /* . Initialization. */
+                eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+                if ( doLennardJones ) numberOfLJTypes = ljParameters->ntypes ;
+                PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
+                /* . Pack the atom data with empty slots having zero charge and type. */
+                for ( i = 0 ; i < m ; i++ )
+                {
+                    j = clusterPairList->atoms[i] ;
+                    if ( j >= 0 )
                     {
-	                tIJ = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
-                        aIJ = ljParameters->tableA[tIJ] * lennardJonesScale ;
-                        bIJ = ljParameters->tableB[tIJ] * lennardJonesScale ;
-                        LennardJonesTerm ( factors, r2, s, s2, aIJ, bIJ, f, g ) ;
-                        eLJ += f ;
+                        Coordinates3_GetRow ( coordinates3, j, x[i], y[i], z[i] ) ;
+                        if ( doElectrostatic ) q    [i] = Array1D_Item ( charges, j ) ;
+                        if ( doLennardJones  ) types[i] = Array1D_Item ( ljTypes, j ) ;
                     }
-                    if ( doGradients )
+                }
+                /* . Loop over the first clusters with each thread accumulating its gradients in its own packed arrays. */
+# ifdef USEOPENMP
+                #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
+                {
+                    auto Cardinal mask ;
+                    auto Integer  a, cI, i, iOffset, j, jOffset, k, n, tI[_ClusterSize], tIJ, u = 0 ;
+                    auto Real     aIJ, bIJ, f, g, qI[_ClusterSize], r2, s, s2, xIJ, yIJ, zIJ ;
+                    auto Real    *gX, *gY, *gZ ;
+# ifdef USEOPENMP
+                    u  = omp_get_thread_num ( ) ;
+# endif
+                    gX = &work[(4+3*u)*m] ; gY = &work[(5+3*u)*m] ; gZ = &work[(6+3*u)*m] ;
+# ifdef USEOPENMP
+                    #pragma omp for schedule ( dynamic )
+# endif
+                    for ( cI = 0 ; cI < clusterPairList->numberOfClusters ; cI++ )
+                    {
+                        iOffset = cI * _ClusterSize ;
+                        for ( a = 0 ; a < _ClusterSize ; a++ )
+                        {
+                            qI[a] = eScale          * q    [iOffset+a] ;
+                            tI[a] = numberOfLJTypes * types[iOffset+a] ;
+                        }
+                        /* . Loop over the second clusters. */
+                        for ( n = clusterPairList->offsets[cI] ; n < clusterPairList->offsets[cI+1] ; n++ )
+                        {
+                            jOffset = clusterPairList->partners[n] * _ClusterSize ;
+                            mask    = clusterPairList->masks[n] ;
+                            /* . Loop over the pairs in the mask. */
+                            while ( mask != 0 )
+                            {
+                                LowestSetBit ( mask, k ) ;
+                                mask &= mask - 1 ;
+                                a   = k / _ClusterSize ;
+                                i   = iOffset + a ;
+                                j   = jOffset + k % _ClusterSize ;
+                                xIJ = x[i] - x[j] ;
+                                yIJ = y[i] - y[j] ;
+                                zIJ = z[i] - z[j] ;
+                                r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                                CheckDistances ( factors, r2, s, s2 ) ;
+                                f = 0.0e+00 ;
+                                g = 0.0e+00 ;
+                                if ( doElectrostatic )
+                                {
+                                    ElectrostaticTerm ( factors, r2, s, qI[a] * q[j], f, g ) ;
+                                    eQQ += f ;
+                                }
+                                if ( doLennardJones )
+                                {
+                                    tIJ = ljParameters->tableindex[tI[a]+types[j]] ;
+                                    aIJ = ljParameters->tableA[tIJ] * lennardJonesScale ;
+                                    bIJ = ljParameters->tableB[tIJ] * lennardJonesScale ;
+                                    LennardJonesTerm ( factors, r2, s, s2, aIJ, bIJ, f, g ) ;
+                                    eLJ += f ;
+                                }
+                                if ( doGradients )
+                                {
+                                    g   *= 2.0e+00 ;
+                                    xIJ *= g ;
+                                    yIJ *= g ;
+                                    zIJ *= g ;
+                                    gX[i] += xIJ ; gX[j] -= xIJ ;
+                                    gY[i] += yIJ ; gY[j] -= yIJ ;
+                                    gZ[i] += zIJ ; gZ[j] -= zIJ ;
+                                }
+                            }
+                        }
+                    }
+                }
+                /* . Finish up. */
+                if ( doGradients )
+                {
+                    for ( i = 0 ; i < m ; i++ )
                     {
-                        g   *= 2.0e+00 ;
-                        xIJ *= g ;
-                        yIJ *= g ;
-                        zIJ *= g ;
-                        Coordinates3_IncrementRow ( gradients3I, i, xIJ, yIJ, zIJ ) ;
-                        Coordinates3_DecrementRow ( gradients3J, j, xIJ, yIJ, zIJ ) ;
-	            }
+                        j = clusterPairList->atoms[i] ;
+                        if ( j >= 0 )
+                        {
+                            gXt = gYt = gZt = 0.0e+00 ;
+                            for ( t = 0 ; t < numberOfThreads ; t++ )
+                            {
+                                gXt += work[(4+3*t)*m+i] ;
+                                gYt += work[(5+3*t)*m+i] ;
+                                gZt += work[(6+3*t)*m+i] ;
+                            }
+                            Coordinates3_IncrementRow ( gradients3, j, gXt, gYt, gZt ) ;
+                        }
+                    }
                 }
+                if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
+                if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
             }
-            if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
-            if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
+            Memory_Deallocate ( types ) ;
+            Memory_Deallocate ( work  ) ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . MM/MM energy and gradients with a cluster pair list in mixed precision.
+! . The packed coordinates and charges and the pair arithmetic are single precision whereas the energies and gradients are
+!   accumulated in double precision.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void PairwiseInteractionABFS_MMMMEnergyClusterSingle ( const PairwiseInteractionABFS *self               ,
+                                                       const RealArray1D             *charges            ,
+                                                             IntegerArray1D          *ljTypes            ,
+                                                       const LJParameterContainer    *ljParameters       ,
+                                                       const Real                     electrostaticScale ,
+                                                       const Real                     lennardJonesScale  ,
+                                                       const Coordinates3            *coordinates3       ,
+                                                       const ClusterPairList         *clusterPairList    ,
+                                                             Real                    *eElectrostatic     ,
+                                                             Real                    *eLennardJones      ,
+                                                             Coordinates3            *gradients3         ,
+                                                             Status                  *status             )
+{
+    if ( eElectrostatic != NULL ) (*eElectrostatic) = 0.0e+00 ;
+    if ( eLennardJones  != NULL ) (*eLennardJones ) = 0.0e+00 ;
+    if ( ( self            != NULL ) &&
+         ( coordinates3    != NULL ) &&
+         ( clusterPairList != NULL ) &&
+           Status_IsOK ( status ) )
+    {
+        auto Boolean doElectrostatic, doGradients, doLennardJones ;
+        doElectrostatic = ( charges            != NULL    ) &&
+                          ( eElectrostatic     != NULL    ) &&
+                          ( electrostaticScale != 0.0e+00 ) ;
+        doGradients     = ( gradients3         != NULL    ) ;
+        doLennardJones  = ( eLennardJones      != NULL    ) &&
+                          ( ljTypes            != NULL    ) &&
+                          ( ljParameters       != NULL    ) &&
+                          ( lennardJonesScale  != 0.0e+00 ) ;
+        if ( doElectrostatic || doLennardJones )
+        {
+            auto Integer  m       = clusterPairList->numberOfClusters * _ClusterSize, numberOfThreads ;
+            auto Integer *types   = NULL ;
+            auto Real    *work    = NULL ;
+            auto Real32  *packed  = NULL ;
+            Coordinates3_AllocateThreadBuffers ( NULL, &numberOfThreads ) ;
+            packed = Memory_AllocateArrayOfTypes ( Maximum ( 4 * m, 1 ), Real32  ) ;
+            types  = Memory_AllocateArrayOfTypes ( Maximum (     m, 1 ), Integer ) ;
+            if ( doGradients ) work = Memory_AllocateArrayOfTypes ( Maximum ( 3 * m * numberOfThreads, 1 ), Real ) ;
+            if ( ( packed == NULL ) || ( types == NULL ) || ( doGradients && ( work == NULL ) ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else
+            {
+                auto ABFSFactorsSingle factors ;
+                auto Integer           i, j, numberOfLJTypes = 0, t ;
+                auto Real              gXt, gYt, gZt ;
+                auto Real              eLJ = 0.0e+00, eQQ = 0.0e+00 ;
+                auto Real32            eScale, ljScale ;
+                auto Real32           *q = &packed[3*m], *x = &packed[0], *y = &packed[m], *z = &packed[2*m] ;
+                /* . Initialization. */
+                eScale  = ( Real32 ) ( electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ) ;
+                ljScale = ( Real32 ) lennardJonesScale ;
+                if ( doLennardJones ) numberOfLJTypes = ljParameters->ntypes ;
+                PairwiseInteractionABFS_InitializeFactorsSingle ( self, &factors ) ;
+                /* . Pack the atom data with empty slots having zero charge and type. */
+                for ( i = 0 ; i < m ; i++ )
+                {
+                    j = clusterPairList->atoms[i] ;
+                    if ( j >= 0 )
+                    {
+                        x[i] = ( Real32 ) Coordinates3_Item ( coordinates3, j, 0 ) ;
+                        y[i] = ( Real32 ) Coordinates3_Item ( coordinates3, j, 1 ) ;
+                        z[i] = ( Real32 ) Coordinates3_Item ( coordinates3, j, 2 ) ;
+                        if ( doElectrostatic ) q    [i] = ( Real32 ) Array1D_Item ( charges, j ) ;
+                        if ( doLennardJones  ) types[i] = Array1D_Item ( ljTypes, j ) ;
+                    }
+                }
+                /* . Loop over the first clusters with each thread accumulating its gradients in its own packed arrays. */
+# ifdef USEOPENMP
+                #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
+                {
+                    auto Cardinal mask ;
+                    auto Integer  a, cI, i, iOffset, j, jOffset, k, n, tI[_ClusterSize], tIJ, u = 0 ;
+                    auto Real    *gX = NULL, *gY = NULL, *gZ = NULL ;
+                    auto Real32   aIJ, bIJ, f, g, qI[_ClusterSize], r2, s, s2, xIJ, yIJ, zIJ ;
+# ifdef USEOPENMP
+                    u = omp_get_thread_num ( ) ;
+# endif
+                    if ( doGradients ) { gX = &work[3*u*m] ; gY = &work[(3*u+1)*m] ; gZ = &work[(3*u+2)*m] ; }
+# ifdef USEOPENMP
+                    #pragma omp for schedule ( dynamic )
+# endif
+                    for ( cI = 0 ; cI < clusterPairList->numberOfClusters ; cI++ )
+                    {
+                        iOffset = cI * _ClusterSize ;
+                        for ( a = 0 ; a < _ClusterSize ; a++ )
+                        {
+                            qI[a] = eScale          * q    [iOffset+a] ;
+                            tI[a] = numberOfLJTypes * types[iOffset+a] ;
+                        }
+                        /* . Loop over the second clusters. */
+                        for ( n = clusterPairList->offsets[cI] ; n < clusterPairList->offsets[cI+1] ; n++ )
+                        {
+                            jOffset = clusterPairList->partners[n] * _ClusterSize ;
+                            mask    = clusterPairList->masks[n] ;
+                            /* . Loop over the pairs in the mask. */
+                            while ( mask != 0 )
+                            {
+                                LowestSetBit ( mask, k ) ;
+                                mask &= mask - 1 ;
+                                a   = k / _ClusterSize ;
+                                i   = iOffset + a ;
+                                j   = jOffset + k % _ClusterSize ;
+                                xIJ = x[i] - x[j] ;
+                                yIJ = y[i] - y[j] ;
+                                zIJ = z[i] - z[j] ;
+                                r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                                CheckDistancesSingle ( factors, r2, s, s2 ) ;
+                                f = 0.0e+00f ;
+                                g = 0.0e+00f ;
+                                if ( doElectrostatic )
+                                {
+                                    ElectrostaticTermSingle ( factors, r2, s, qI[a] * q[j], f, g ) ;
+                                    eQQ += f ;
+                                }
+                                if ( doLennardJones )
+                                {
+                                    tIJ = ljParameters->tableindex[tI[a]+types[j]] ;
+                                    aIJ = ( Real32 ) ljParameters->tableA[tIJ] * ljScale ;
+                                    bIJ = ( Real32 ) ljParameters->tableB[tIJ] * ljScale ;
+                                    LennardJonesTermSingle ( factors, r2, s, s2, aIJ, bIJ, f, g ) ;
+                                    eLJ += f ;
+                                }
+                                if ( doGradients )
+                                {
+                                    g   *= 2.0e+00f ;
+                                    xIJ *= g ;
+                                    yIJ *= g ;
+                                    zIJ *= g ;
+                                    gX[i] += xIJ ; gX[j] -= xIJ ;
+                                    gY[i] += yIJ ; gY[j] -= yIJ ;
+                                    gZ[i] += zIJ ; gZ[j] -= zIJ ;
+                                }
+                            }
+                        }
+                    }
+                }
+                /* . Finish up. */
+                if ( doGradients )
+                {
+                    for ( i = 0 ; i < m ; i++ )
+                    {
+                        j = clusterPairList->atoms[i] ;
+                        if ( j >= 0 )
+                        {
+                            gXt = gYt = gZt = 0.0e+00 ;
+                            for ( t = 0 ; t < numberOfThreads ; t++ )
+                            {
+                                gXt += work[3*t*m+i] ;
+                                gYt += work[(3*t+1)*m+i] ;
+                                gZt += work[(3*t+2)*m+i] ;
+                            }
+                            Coordinates3_IncrementRow ( gradients3, j, gXt, gYt, gZt ) ;
+                        }
+                    }
+                }
+                if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
+                if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
+            }
+            Memory_Deallocate ( packed ) ;
+            Memory_Deallocate ( types  ) ;
+            Memory_Deallocate ( work   ) ;
         }
     }
 }
@@ -479,6 +957,8 @@ void PairwiseInteractionABFS_MMMMEnergyImage ( const PairwiseInteractionABFS
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . MM/MM energy and gradients within the minimum image convention.
+! . The minimum image displacement of each pair is found from the fractional coordinates when the pair is processed so that
+!   a single pair-list, without images, covers all interactions. The H derivatives are accumulated by thread and then summed.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 void PairwiseInteractionABFS_MMMMEnergyMI ( const PairwiseInteractionABFS    *self                       ,
                                             const RealArray1D                *chargesI                   ,
@@ -508,82 +988,267 @@ void PairwiseInteractionABFS_MMMMEnergyMI ( const PairwiseInteractionABFS    *se
          ( pairList           != NULL ) &&
            Status_IsOK ( status ) )
     {
-        auto Boolean doElectrostatic, doGradients, doLennardJones ;
+        auto Boolean doElectrostatic, doGradients, doLennardJones, doSymmetry ;
         doElectrostatic = ( chargesI                   != NULL    ) &&
                           ( chargesJ                   != NULL    ) &&
                           ( eElectrostatic             != NULL    ) &&
                           ( electrostaticScale         != 0.0e+00 ) ;
         doGradients     = ( gradients3I                != NULL    ) && 
-                          ( gradients3J                != NULL    ) &&
-                          ( symmetryParameterGradients != NULL    ) ;
+                          ( gradients3J                != NULL    ) ;
         doLennardJones  = ( eLennardJones              != NULL    ) &&
                           ( ljTypesI                   != NULL    ) &&
                           ( ljTypesJ                   != NULL    ) &&
                           ( ljParameters               != NULL    ) &&
                           ( lennardJonesScale          != 0.0e+00 ) ;
+        doSymmetry      = doGradients && ( symmetryParameterGradients != NULL ) ;
         if ( doElectrostatic|| doLennardJones )
         {
-            auto ABFSFactors       factors ;
-            auto Integer           i, j, n, numberOfLJTypes = 0, tI = 0, tIJ ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
-            auto Real              aIJ, bIJ, eScale, f, g, qI = 0.0e+00, qIJ, r2, s, s2, xIJ, yIJ, zIJ ;
-            auto Real              eLJ = 0.0e+00, eQQ = 0.0e+00 ;
-            /* . Minimum image setup. */
-            MinimumImage_Allocate ( coordinates3I, coordinates3J ) ;
-            /* . Initialization. */
-            eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
-            if ( doLennardJones  ) numberOfLJTypes = ljParameters->ntypes ;
-            PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-            /* . Loop over record. */
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            auto ABFSFactors   factors ;
+            auto Coordinates3 *fractionalI = NULL, *fractionalJ = NULL ;
+            auto Integer       numberOfLJTypes = 0, numberOfThreads ;
+            auto Real          eScale, h[9], *iBuffers = NULL, *jBuffers = NULL ;
+            auto Real          eLJ = 0.0e+00, eQQ = 0.0e+00 ;
+            /* . Fractional coordinates. */
+            MinimumImage_MakeFractionalCoordinates ( symmetryParameters, coordinates3I, fractionalI, status ) ;
+            if ( coordinates3J == coordinates3I ) fractionalJ = fractionalI ;
+            else { MinimumImage_MakeFractionalCoordinates ( symmetryParameters, coordinates3J, fractionalJ, status ) ; }
+            if ( ( fractionalI != NULL ) && ( fractionalJ != NULL ) )
             {
-                /* . First atom. */
-                i = record->index ;
-	        if ( doElectrostatic ) qI = eScale          * Array1D_Item ( chargesI, i ) ;
-                if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
-                /* . Displacements. */
-                MinimumImage_Displacements ( i, j ) ;
-                /* . Second atom. */
-       	        for ( n = 0 ; n < record->capacity ; n++ )
-	        {
-	            j = record->indices[n] ;
-	            Coordinates3_GetRow ( rDisplacements, n, xIJ, yIJ, zIJ ) ;
-                    r2 = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
-                    CheckDistances ( factors, r2, s, s2 ) ;
-                    f = 0.0e+00 ;
-                    g = 0.0e+00 ;
-                    if ( doElectrostatic )
+                /* . Initialization. */
+                eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+                if ( doLennardJones  ) numberOfLJTypes = ljParameters->ntypes ;
+                MinimumImage_GetH ( symmetryParameters, h ) ;
+                PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
+                if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3I, gradients3J, &numberOfThreads, &iBuffers, &jBuffers ) ;
+                else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+                /* . Loop over records. */
+# ifdef USEOPENMP
+                #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
+                {
+                    auto Coordinates3 iView, jView, *threadGradients3I = NULL, *threadGradients3J = NULL ;
+                    auto Integer      i, j, n, r, tI = 0, tIJ ;
+                    auto Real         aIJ, bIJ, dEdH[9], f, g, qI = 0.0e+00, qIJ, r2, s, s2, tA, tB, tC, xIJ, yIJ, zIJ ;
+                    for ( n = 0 ; n < 9 ; n++ ) dEdH[n] = 0.0e+00 ;
+                    if ( doGradients )
                     {
-                        qIJ = qI * Array1D_Item ( chargesJ, j ) ;
-                        ElectrostaticTerm ( factors, r2, s, qIJ, f, g ) ;
-                        eQQ += f ;
+                        threadGradients3I = Coordinates3_ThreadBuffer ( gradients3I, iBuffers, &iView ) ;
+                        threadGradients3J = Coordinates3_ThreadBuffer ( gradients3J, jBuffers, &jView ) ;
                     }
-                    if ( doLennardJones )
+# ifdef USEOPENMP
+                    #pragma omp for schedule ( dynamic )
+# endif
+                    for ( r = 0 ; r < pairList->count ; r++ )
+                    {
+                        /* . First atom. */
+                        i  = pairList->indices[r] ;
+                        if ( doElectrostatic ) qI = eScale          * Array1D_Item ( chargesI, i ) ;
+                        if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
+                        /* . Second atom. */
+                        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                        {
+                            j = pairList->partners[n] ;
+                            MinimumImage_PairDisplacement ( fractionalI, fractionalJ, i, j, h, tA, tB, tC, xIJ, yIJ, zIJ ) ;
+                            r2 = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                            CheckDistances ( factors, r2, s, s2 ) ;
+                            f = 0.0e+00 ;
+                            g = 0.0e+00 ;
+                            if ( doElectrostatic )
+                            {
+                                qIJ = qI * Array1D_Item ( chargesJ, j ) ;
+                                ElectrostaticTerm ( factors, r2, s, qIJ, f, g ) ;
+                                eQQ += f ;
+                            }
+                            if ( doLennardJones )
+                            {
+                                tIJ = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                                aIJ = ljParameters->tableA[tIJ] * lennardJonesScale ;
+                                bIJ = ljParameters->tableB[tIJ] * lennardJonesScale ;
+                                LennardJonesTerm ( factors, r2, s, s2, aIJ, bIJ, f, g ) ;
+                                eLJ += f ;
+                            }
+                            if ( doGradients )
+                            {
+                                g   *= 2.0e+00 ;
+                                xIJ *= g ;
+                                yIJ *= g ;
+                                zIJ *= g ;
+                                Coordinates3_IncrementRow ( threadGradients3I, i, xIJ, yIJ, zIJ ) ;
+                                Coordinates3_DecrementRow ( threadGradients3J, j, xIJ, yIJ, zIJ ) ;
+                                if ( doSymmetry ) MinimumImage_PairDerivatives ( dEdH, tA, tB, tC, xIJ, yIJ, zIJ ) ;
+                            }
+                        }
+                    }
+                    if ( doSymmetry )
+                    {
+# ifdef USEOPENMP
+                        #pragma omp critical ( MinimumImageDerivatives )
+# endif
+                        MinimumImage_AddDerivatives ( symmetryParameterGradients, dEdH ) ;
+                    }
+                }
+                if ( doGradients     ) Coordinates3_ReducePairedThreadBuffers ( gradients3I, gradients3J, numberOfThreads, &iBuffers, &jBuffers ) ;
+                if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
+                if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
+            }
+            if ( fractionalJ != fractionalI ) Coordinates3_Deallocate ( &fractionalJ ) ;
+            Coordinates3_Deallocate ( &fractionalI ) ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . MM/MM energy and gradients in mixed precision.
+! . Single precision copies of the coordinates and charges are made and used for the pair arithmetic whereas the energies and
+!   gradients are accumulated in double precision.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void PairwiseInteractionABFS_MMMMEnergySingle ( const PairwiseInteractionABFS *self               ,
+                                                const RealArray1D             *chargesI           ,
+                                                const RealArray1D             *chargesJ           ,
+                                                      IntegerArray1D          *ljTypesI           ,
+                                                      IntegerArray1D          *ljTypesJ           ,
+                                                const LJParameterContainer    *ljParameters       ,
+                                                const Real                     electrostaticScale ,
+                                                const Real                     lennardJonesScale  ,
+                                                const Coordinates3            *coordinates3I      ,
+                                                const Coordinates3            *coordinates3J      ,
+                                                      PairList                *pairList           ,
+                                                      Real                    *eElectrostatic     ,
+                                                      Real                    *eLennardJones      ,
+                                                      Coordinates3            *gradients3I        ,
+                                                      Coordinates3            *gradients3J        ,
+                                                      Status                  *status             )
+{
+    if ( eElectrostatic != NULL ) (*eElectrostatic) = 0.0e+00 ;
+    if ( eLennardJones  != NULL ) (*eLennardJones ) = 0.0e+00 ;
+    if ( ( self          != NULL ) &&
+         ( coordinates3I != NULL ) &&
+         ( coordinates3J != NULL ) &&
+         ( pairList      != NULL ) &&
+           Status_IsOK ( status ) )
+    {
+        auto Boolean doElectrostatic, doGradients, doLennardJones ;
+        doElectrostatic = ( chargesI           != NULL    ) &&
+                          ( chargesJ           != NULL    ) &&
+                          ( eElectrostatic     != NULL    ) &&
+                          ( electrostaticScale != 0.0e+00 ) ;
+        doGradients     = ( gradients3I        != NULL    ) &&
+                          ( gradients3J        != NULL    ) ;
+        doLennardJones  = ( eLennardJones      != NULL    ) &&
+                          ( ljTypesI           != NULL    ) &&
+                          ( ljTypesJ           != NULL    ) &&
+                          ( ljParameters       != NULL    ) &&
+                          ( lennardJonesScale  != 0.0e+00 ) ;
+        if ( doElectrostatic || doLennardJones )
+        {
+            auto Boolean  isShared = ( coordinates3I == coordinates3J ) && ( chargesI == chargesJ ) ;
+            auto Integer  nI = Coordinates3_Rows ( coordinates3I ), nJ = Coordinates3_Rows ( coordinates3J ) ;
+            auto Real32  *packedI = NULL, *packedJ = NULL ;
+            /* . Single precision copies of the coordinates and charges stored as x, y, z and q for each atom. */
+            packedI = Memory_AllocateArrayOfTypes ( Maximum ( 4 * nI, 1 ), Real32 ) ;
+            if ( isShared ) packedJ = packedI ;
+            else            packedJ = Memory_AllocateArrayOfTypes ( Maximum ( 4 * nJ, 1 ), Real32 ) ;
+            if ( ( packedI == NULL ) || ( packedJ == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else
+            {
+                auto ABFSFactorsSingle factors ;
+                auto Integer           i, numberOfLJTypes = 0, numberOfThreads ;
+                auto Real             *iBuffers = NULL, *jBuffers = NULL ;
+                auto Real              eLJ = 0.0e+00, eQQ = 0.0e+00 ;
+                auto Real32            eScale, ljScale ;
+                /* . Initialization. */
+                eScale  = ( Real32 ) ( electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ) ;
+                ljScale = ( Real32 ) lennardJonesScale ;
+                if ( doLennardJones ) numberOfLJTypes = ljParameters->ntypes ;
+                PairwiseInteractionABFS_InitializeFactorsSingle ( self, &factors ) ;
+                for ( i = 0 ; i < nI ; i++ )
+                {
+                    packedI[4*i  ] = ( Real32 ) Coordinates3_Item ( coordinates3I, i, 0 ) ;
+                    packedI[4*i+1] = ( Real32 ) Coordinates3_Item ( coordinates3I, i, 1 ) ;
+                    packedI[4*i+2] = ( Real32 ) Coordinates3_Item ( coordinates3I, i, 2 ) ;
+                    if ( doElectrostatic ) packedI[4*i+3] = ( Real32 ) Array1D_Item ( chargesI, i ) ;
+                }
+                if ( ! isShared )
+                {
+                    for ( i = 0 ; i < nJ ; i++ )
                     {
-	                tIJ = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
-                        aIJ = ljParameters->tableA[tIJ] * lennardJonesScale ;
-                        bIJ = ljParameters->tableB[tIJ] * lennardJonesScale ;
-                        LennardJonesTerm ( factors, r2, s, s2, aIJ, bIJ, f, g ) ;
-                        eLJ += f ;
+                        packedJ[4*i  ] = ( Real32 ) Coordinates3_Item ( coordinates3J, i, 0 ) ;
+                        packedJ[4*i+1] = ( Real32 ) Coordinates3_Item ( coordinates3J, i, 1 ) ;
+                        packedJ[4*i+2] = ( Real32 ) Coordinates3_Item ( coordinates3J, i, 2 ) ;
+                        if ( doElectrostatic ) packedJ[4*i+3] = ( Real32 ) Array1D_Item ( chargesJ, i ) ;
                     }
+                }
+                if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3I, gradients3J, &numberOfThreads, &iBuffers, &jBuffers ) ;
+                else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+                /* . Loop over records. */
+# ifdef USEOPENMP
+                #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
+                {
+                    auto Coordinates3  iView, jView, *threadGradients3I = NULL, *threadGradients3J = NULL ;
+                    auto Integer       i, j, n, r, tI = 0, tIJ ;
+                    auto Real32        aIJ, bIJ, f, g, qI = 0.0e+00f, r2, s, s2, xI, xIJ, yI, yIJ, zI, zIJ ;
+                    auto Real32       *pJ ;
                     if ( doGradients )
                     {
-                        g   *= 2.0e+00 ;
-                        xIJ *= g ;
-                        yIJ *= g ;
-                        zIJ *= g ;
-                        Coordinates3_IncrementRow ( gradients3I   , i, xIJ, yIJ, zIJ ) ;
-                        Coordinates3_DecrementRow ( gradients3J   , j, xIJ, yIJ, zIJ ) ;
-                        Coordinates3_SetRow       ( fDisplacements, n, xIJ, yIJ, zIJ ) ;
-	            }
+                        threadGradients3I = Coordinates3_ThreadBuffer ( gradients3I, iBuffers, &iView ) ;
+                        threadGradients3J = Coordinates3_ThreadBuffer ( gradients3J, jBuffers, &jView ) ;
+                    }
+# ifdef USEOPENMP
+                    #pragma omp for schedule ( dynamic )
+# endif
+                    for ( r = 0 ; r < pairList->count ; r++ )
+                    {
+                        /* . First atom. */
+                        i  = pairList->indices[r] ;
+                        xI = packedI[4*i  ] ;
+                        yI = packedI[4*i+1] ;
+                        zI = packedI[4*i+2] ;
+                        if ( doElectrostatic ) qI = eScale * packedI[4*i+3] ;
+                        if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
+                        /* . Second atom. */
+                        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                        {
+                            j   = pairList->partners[n] ;
+                            pJ  = &packedJ[4*j] ;
+                            xIJ = xI - pJ[0] ;
+                            yIJ = yI - pJ[1] ;
+                            zIJ = zI - pJ[2] ;
+                            r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                            CheckDistancesSingle ( factors, r2, s, s2 ) ;
+                            f = 0.0e+00f ;
+                            g = 0.0e+00f ;
+                            if ( doElectrostatic )
+                            {
+                                ElectrostaticTermSingle ( factors, r2, s, qI * pJ[3], f, g ) ;
+                                eQQ += f ;
+                            }
+                            if ( doLennardJones )
+                            {
+                                tIJ = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                                aIJ = ( Real32 ) ljParameters->tableA[tIJ] * ljScale ;
+                                bIJ = ( Real32 ) ljParameters->tableB[tIJ] * ljScale ;
+                                LennardJonesTermSingle ( factors, r2, s, s2, aIJ, bIJ, f, g ) ;
+                                eLJ += f ;
+                            }
+                            if ( doGradients )
+                            {
+                                g   *= 2.0e+00f ;
+                                xIJ *= g ;
+                                yIJ *= g ;
+                                zIJ *= g ;
+                                Coordinates3_IncrementRow ( threadGradients3I, i, xIJ, yIJ, zIJ ) ;
+                                Coordinates3_DecrementRow ( threadGradients3J, j, xIJ, yIJ, zIJ ) ;
+                            }
+                        }
+                    }
                 }
-                MinimumImage_Gradients ;
+                if ( doGradients     ) Coordinates3_ReducePairedThreadBuffers ( gradients3I, gradients3J, numberOfThreads, &iBuffers, &jBuffers ) ;
+                if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
+                if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
             }
-            if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
-            if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
-            MinimumImage_Deallocate ;
+            if ( ! isShared ) Memory_Deallocate ( packedJ ) ;
+            Memory_Deallocate ( packedI ) ;
         }
     }
 }
@@ -613,42 +1278,55 @@ void PairwiseInteractionABFS_QCMMGradients ( const PairwiseInteractionABFS *self
          ( pairList           != NULL    ) &&
            Status_IsOK ( status ) )
     {
-        auto ABFSFactors              factors ;
-        auto Integer                  m, n, q ;
-        auto PairListIterator         iterator ;
-        auto PairRecord              *record ;
-        auto Real                     eScale, f, g, gX, gY, gZ, qQ, qQM, r2, s, s2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
-        eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+        auto ABFSFactors   factors ;
+        auto Coordinates3 *mGradients3 = ( Coordinates3 * ) gradients3M ;
+        auto Integer       numberOfThreads ;
+        auto Real          eScale, *mBuffers ;
+        eScale   = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
         PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-        PairListIterator_Initialize ( &iterator, pairList ) ;
-        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        mBuffers = Coordinates3_AllocateThreadBuffers ( mGradients3, &numberOfThreads ) ;
+        /* . Each QC atom has a single record so only the MM gradients need per-thread buffers. */
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads )
+# endif
         {
-            q  = record->index ;
-            qQ = eScale * Array1D_Item ( chargesQ, q ) ;
-	    Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
-       	    for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < record->capacity ; n++ )
-	    {
-	        m   = record->indices[n] ;
-                qQM = 2.0e+00 * qQ * Array1D_Item ( chargesM, m ) ; /*. Note the extra factor of 2 here rather than later. */
-	        Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
-                xQM = xQ - xM ;
-                yQM = yQ - yM ;
-                zQM = zQ - zM ;
-                r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
-                f   = 0.0e+00 ;
-                g   = 0.0e+00 ;
-                CheckDistances    ( factors, r2, s, s2        ) ;
-                ElectrostaticTerm ( factors, r2, s, qQM, f, g ) ;
-                xQM *= g ;
-                yQM *= g ;
-                zQM *= g ;
-                Coordinates3_DecrementRow ( gradients3M, m, xQM, yQM, zQM ) ;
-                gX  += xQM ;
-                gY  += yQM ;
-                gZ  += zQM ;
-	    }
-            Coordinates3_IncrementRow ( gradients3Q, q, gX, gY, gZ ) ;
+            auto Coordinates3 mView, *threadGradients3M ;
+            auto Integer      m, n, q, r ;
+            auto Real         f, g, gX, gY, gZ, qQ, qQM, r2, s, s2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
+            threadGradients3M = Coordinates3_ThreadBuffer ( mGradients3, mBuffers, &mView ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( r = 0 ; r < pairList->count ; r++ )
+            {
+                q  = pairList->indices[r] ;
+                qQ = eScale * Array1D_Item ( chargesQ, q ) ;
+                Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
+                for ( n = pairList->offsets[r], gX = gY = gZ = 0.0e+00 ; n < pairList->offsets[r+1] ; n++ )
+                {
+                    m   = pairList->partners[n] ;
+                    qQM = 2.0e+00 * qQ * Array1D_Item ( chargesM, m ) ; /*. Note the extra factor of 2 here rather than later. */
+                    Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
+                    xQM = xQ - xM ;
+                    yQM = yQ - yM ;
+                    zQM = zQ - zM ;
+                    r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
+                    f   = 0.0e+00 ;
+                    g   = 0.0e+00 ;
+                    CheckDistances    ( factors, r2, s, s2        ) ;
+                    ElectrostaticTerm ( factors, r2, s, qQM, f, g ) ;
+                    xQM *= g ;
+                    yQM *= g ;
+                    zQM *= g ;
+                    Coordinates3_DecrementRow ( threadGradients3M, m, xQM, yQM, zQM ) ;
+                    gX  += xQM ;
+                    gY  += yQM ;
+                    gZ  += zQM ;
+                }
+                Coordinates3_IncrementRow ( gradients3Q, q, gX, gY, gZ ) ;
+            }
         }
+        Coordinates3_ReduceThreadBuffers ( mGradients3, numberOfThreads, &mBuffers ) ;
     }
 }
 
@@ -739,26 +1417,23 @@ void PairwiseInteractionABFS_QCMMGradientsMI ( const PairwiseInteractionABFS
            Status_IsOK ( status ) )
     {
         auto ABFSFactors              factors ;
-        auto Integer                  m, n, q ;
-        auto PairListIterator         iterator ;
-        auto PairRecord              *record ;
+        auto Integer                  m, n, q, r ;
         auto Real                     eScale, f, g, gX, gY, gZ, qQ, qQM, r2, s, s2, xQM, yQM, zQM ;
         /* . Minimum image setup. */
         MinimumImage_Allocate ( coordinates3Q, coordinates3M ) ;
         /* . Initialization. */
         eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
         PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-        PairListIterator_Initialize ( &iterator, pairList ) ;
-        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        for ( r = 0 ; r < pairList->count ; r++ )
         {
-            q  = record->index ;
+            q  = pairList->indices[r] ;
             qQ = eScale * Array1D_Item ( chargesQ, q ) ;
             /* . Displacements. */
             MinimumImage_Displacements ( q, m ) ;
             /* . MM atom. */
-       	    for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < record->capacity ; n++ )
+       	    for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < PairList_RecordCapacity ( pairList, r ) ; n++ )
 	    {
-	        m   = record->indices[n] ;
+	        m   = PairList_RecordPartners ( pairList, r )[n] ;
                 qQM = 2.0e+00 * qQ * Array1D_Item ( chargesM, m ) ; /*. Note the extra factor of 2 here rather than later. */
 	        Coordinates3_GetRow ( rDisplacements, m, xQM, yQM, zQM ) ;
                 r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
@@ -804,20 +1479,21 @@ void PairwiseInteractionABFS_QCMMPotentials ( const PairwiseInteractionABFS *sel
            Status_IsOK ( status )        )
     {
         auto ABFSFactors              factors ;
-        auto Integer                  m, n, q ;
-        auto PairListIterator         iterator ;
-        auto PairRecord              *record ;
+        auto Integer                  m, n, q, r ;
         auto Real                     eScale, f, g, p, qM, r2, s, s2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
         eScale  = electrostaticScale / Units_Length_Angstroms_To_Bohrs ;
         PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-        PairListIterator_Initialize ( &iterator, pairList ) ;
-        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        /* . Each QC atom has a single record so the records can be done in parallel. */
+# ifdef USEOPENMP
+        #pragma omp parallel for private ( f, g, m, n, p, q, qM, r2, s, s2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ) schedule ( dynamic )
+# endif
+        for ( r = 0 ; r < pairList->count ; r++ )
         {
-            q  = record->index ;
+            q  = pairList->indices[r] ;
 	    Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
-       	    for ( n = 0, g = p = 0.0e+00 ; n < record->capacity ; n++ )
+       	    for ( n = pairList->offsets[r], g = p = 0.0e+00 ; n < pairList->offsets[r+1] ; n++ )
 	    {
-	        m   = record->indices[n] ;
+	        m   = pairList->partners[n] ;
                 qM  = Array1D_Item ( chargesM, m ) ;
 	        Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
                 xQM = xQ - xM ;
@@ -905,25 +1581,22 @@ void PairwiseInteractionABFS_QCMMPotentialsMI ( const PairwiseInteractionABFS *s
            Status_IsOK ( status )        )
     {
         auto ABFSFactors              factors ;
-        auto Integer                  m, n, q ;
-        auto PairListIterator         iterator ;
-        auto PairRecord              *record ;
+        auto Integer                  m, n, q, r ;
         auto Real                     eScale, f, g, p, qM, r2, s, s2, xQM, yQM, zQM ;
         /* . Minimum image setup. */
         MinimumImage_Allocate ( coordinates3Q, coordinates3M ) ;
         /* . Initialization. */
         eScale  = electrostaticScale / Units_Length_Angstroms_To_Bohrs ;
         PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-        PairListIterator_Initialize ( &iterator, pairList ) ;
-        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        for ( r = 0 ; r < pairList->count ; r++ )
         {
-            q  = record->index ;
+            q  = pairList->indices[r] ;
             /* . Displacements. */
             MinimumImage_Displacements ( q, m ) ;
             /* . MM atom. */
-       	    for ( n = 0, g = p = 0.0e+00 ; n < record->capacity ; n++ )
+       	    for ( n = 0, g = p = 0.0e+00 ; n < PairList_RecordCapacity ( pairList, r ) ; n++ )
 	    {
-	        m   = record->indices[n] ;
+	        m   = PairList_RecordPartners ( pairList, r )[n] ;
                 qM  = Array1D_Item ( chargesM, m ) ;
 	        Coordinates3_GetRow ( rDisplacements, m, xQM, yQM, zQM ) ;
                 r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
@@ -961,21 +1634,18 @@ void PairwiseInteractionABFS_QCQCGradients ( const PairwiseInteractionABFS *self
          ( Status_IsOK ( status )        ) )
     {
         auto ABFSFactors              factors ;
-        auto Integer                  i, j, n ;
-        auto PairListIterator         iterator ;
-        auto PairRecord              *record ;
+        auto Integer                  i, j, n, r ;
         auto Real                     eScale, f, g, gX, gY, gZ, qI, qIJ, r2, s, s2, xI, xJ, xIJ, yI, yJ, yIJ, zI, zJ, zIJ ;
         eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
         PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-        PairListIterator_Initialize ( &iterator, pairList ) ;
-        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        for ( r = 0 ; r < pairList->count ; r++ )
         {
-            i  = record->index ;
+            i  = pairList->indices[r] ;
             qI = eScale * Array1D_Item ( charges, i ) ;
 	    Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
-       	    for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < record->capacity ; n++ )
+       	    for ( n = pairList->offsets[r], gX = gY = gZ = 0.0e+00 ; n < pairList->offsets[r+1] ; n++ )
 	    {
-	        j   = record->indices[n] ;
+	        j   = pairList->partners[n] ;
                 qIJ = 2.0e+00 * qI * Array1D_Item ( charges, j ) ; /*. Note the extra factor of 2 here rather than later. */
 	        Coordinates3_GetRow ( coordinates3J, j, xJ, yJ, zJ ) ;
                 xIJ = xI - xJ ;
@@ -1069,20 +1739,17 @@ void PairwiseInteractionABFS_QCQCPotentials ( const PairwiseInteractionABFS *sel
          ( Status_IsOK ( status )        ) )
     {
         auto ABFSFactors              factors ;
-        auto Integer                  i, j, n ;
-        auto PairListIterator         iterator ;
-        auto PairRecord              *record ;
+        auto Integer                  i, j, n, r ;
         auto Real                     eScale, f, g, r2, s, s2, xI, xJ, xIJ, yI, yJ, yIJ, zI, zJ, zIJ ;
         eScale  = electrostaticScale / Units_Length_Angstroms_To_Bohrs ;
         PairwiseInteractionABFS_InitializeFactors ( self, &factors ) ;
-        PairListIterator_Initialize ( &iterator, pairList ) ;
-        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        for ( r = 0 ; r < pairList->count ; r++ )
         {
-            i = record->index ;
+            i = pairList->indices[r] ;
 	    Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
-       	    for ( n = 0, g = 0.0e+00 ; n < record->capacity ; n++ )
+       	    for ( n = pairList->offsets[r], g = 0.0e+00 ; n < pairList->offsets[r+1] ; n++ )
 	    {
-	        j   = record->indices[n] ;
+	        j   = pairList->partners[n] ;
 	        Coordinates3_GetRow ( coordinates3J, j, xJ, yJ, zJ ) ;
                 xIJ = xI - xJ ;
                 yIJ = yI - yJ ;
@@ -5,6 +5,7 @@
 /*# include <stdio.h>*/
 
 # include "Boolean.h"
+# include "IntegerUtilities.h"
 # include "Memory.h"
 # include "NumericalMacros.h"
 # include "PairwiseInteractionFull.h"
@@ -223,91 +224,113 @@ void PairwiseInteractionFull_MMMMEnergy ( const PairwiseInteractionFull *self
                           ( lennardJonesScale  != 0.0e+00 ) ;
         if ( doElectrostatic|| doLennardJones )
         {
-            auto Integer     i, j, n, numberOfLJTypes = 0, r, tI = 0, tIJ ;
-            auto PairRecord *record ;
-            auto Real        aIJ, alpha, beta, bIJ, cutOff2, eScale, f, g, qI = 0.0e+00, qIJ, r2, s, s2, s6, xI, xIJ, xJ, yI, yIJ, yJ, zI, zIJ, zJ ;
+            auto Integer     numberOfLJTypes = 0, numberOfThreads, *work ;
+            auto Real        cutOff2, eScale, *iBuffers = NULL, *jBuffers = NULL ;
             auto Real        eLJ = 0.0e+00, eQQ = 0.0e+00 ;
             /* . Initialization. */
             cutOff2 = Maximum ( 0.0e+00 , self->dampingCutOff * self->dampingCutOff ) ;
             eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
             if ( doLennardJones  ) numberOfLJTypes = ljParameters->ntypes ;
+            if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3I, gradients3J, &numberOfThreads, &iBuffers, &jBuffers ) ;
+            else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+            work = PairList_AllocateThreadWork ( pairList, &numberOfThreads ) ;
             /* . Loop over records. */
-            for ( r = 0 ; r < pairList->count ; r++ )
+# ifdef USEOPENMP
+            #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
             {
-                record = PairList_GetRecord ( pairList, r ) ;
-                /* . First atom. */
-                i  = record->index ;
-	        if ( doElectrostatic) qI = eScale          * Array1D_Item   ( chargesI, i ) ;
-                if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
-	        Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
-                /* . Second atom. */
-       	        for ( n = 0 ; n < record->capacity ; n++ )
-	        {
-	            j   = record->indices[n] ;
-	            Coordinates3_GetRow ( coordinates3J, j, xJ, yJ, zJ ) ;
-                    xIJ = xI - xJ ;
-                    yIJ = yI - yJ ;
-                    zIJ = zI - zJ ;
-                    r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
-                    g   = 0.0e+00 ;
-                    /* . Damping. */
-                    if ( r2 <= cutOff2 )
+                auto Coordinates3  iView, jView, *threadGradients3I = NULL, *threadGradients3J = NULL ;
+                auto Integer       i, j, n, r, tI = 0, tIJ, *threadWork ;
+                auto PairRecord   *record, view ;
+                auto Real          aIJ, alpha, beta, bIJ, f, g, qI = 0.0e+00, qIJ, r2, s, s2, s6, xI, xIJ, xJ, yI, yIJ, yJ, zI, zIJ, zJ ;
+                if ( doGradients )
+                {
+                    threadGradients3I = Coordinates3_ThreadBuffer ( gradients3I, iBuffers, &iView ) ;
+                    threadGradients3J = Coordinates3_ThreadBuffer ( gradients3J, jBuffers, &jView ) ;
+                }
+                threadWork = PairList_ThreadWork ( pairList, work ) ;
+# ifdef USEOPENMP
+                #pragma omp for schedule ( dynamic )
+# endif
+                for ( r = 0 ; r < pairList->count ; r++ )
+                {
+                    record = PairList_GetRecordWithWork ( pairList, r, threadWork, &view ) ;
+                    /* . First atom. */
+                    i  = record->index ;
+                    if ( doElectrostatic) qI = eScale          * Array1D_Item   ( chargesI, i ) ;
+                    if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
+                    Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
+                    /* . Second atom. */
+                    for ( n = 0 ; n < record->capacity ; n++ )
                     {
-                        if ( doElectrostatic)
+                        j   = record->indices[n] ;
+                        Coordinates3_GetRow ( coordinates3J, j, xJ, yJ, zJ ) ;
+                        xIJ = xI - xJ ;
+                        yIJ = yI - yJ ;
+                        zIJ = zI - zJ ;
+                        r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                        g   = 0.0e+00 ;
+                        /* . Damping. */
+                        if ( r2 <= cutOff2 )
                         {
-                            qIJ   = qI  * Array1D_Item ( chargesJ, j ) ;
-                            alpha = qIJ * self->alpha1 ;
-                            beta  = qIJ * self->beta1  ;
-                            eQQ  += ( alpha * r2 + beta ) ;
-                            g    +=   alpha ;
+                            if ( doElectrostatic)
+                            {
+                                qIJ   = qI  * Array1D_Item ( chargesJ, j ) ;
+                                alpha = qIJ * self->alpha1 ;
+                                beta  = qIJ * self->beta1  ;
+                                eQQ  += ( alpha * r2 + beta ) ;
+                                g    +=   alpha ;
+                            }
+                            if ( doLennardJones )
+                            {
+                                tIJ   = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                                aIJ   = ljParameters->tableA[tIJ] * lennardJonesScale ;
+                                bIJ   = ljParameters->tableB[tIJ] * lennardJonesScale ;
+                                alpha = aIJ * self->alpha12 + bIJ * self->alpha6 ;
+                                beta  = aIJ * self->beta12  + bIJ * self->beta6  ;
+                                eLJ  += ( alpha * r2 + beta ) ;
+                                g    +=   alpha ;
+                            }
                         }
-                        if ( doLennardJones )
-                        {
-	                    tIJ   = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
-                            aIJ   = ljParameters->tableA[tIJ] * lennardJonesScale ;
-                            bIJ   = ljParameters->tableB[tIJ] * lennardJonesScale ;
-                            alpha = aIJ * self->alpha12 + bIJ * self->alpha6 ;
-                            beta  = aIJ * self->beta12  + bIJ * self->beta6  ;
-                            eLJ  += ( alpha * r2 + beta ) ;
-                            g    +=   alpha ;
-                        }
-                    }
-                    /* . Full. */
-                    else
-                    {
-                        s2 = 1.0e+00 / r2 ;
-                        s  = sqrt ( s2 ) ;
-                        f  = 0.0e+00 ;
-                        if ( doElectrostatic)
+                        /* . Full. */
+                        else
                         {
-                            qIJ  = qI * Array1D_Item ( chargesJ, j ) ;
-                            f    = qIJ * s  ;
-                            g   -= 0.5e+00 * f * s2 ;
-                            eQQ += f ;
+                            s2 = 1.0e+00 / r2 ;
+                            s  = sqrt ( s2 ) ;
+                            f  = 0.0e+00 ;
+                            if ( doElectrostatic)
+                            {
+                                qIJ  = qI * Array1D_Item ( chargesJ, j ) ;
+                                f    = qIJ * s  ;
+                                g   -= 0.5e+00 * f * s2 ;
+                                eQQ += f ;
+                            }
+                            if ( doLennardJones )
+                            {
+
+                                tIJ  = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                                aIJ  = ljParameters->tableA[tIJ] * lennardJonesScale ;
+                                bIJ  = ljParameters->tableB[tIJ] * lennardJonesScale ;
+                                s6   = s2 * s2 * s2 ;
+                                f    = ( aIJ * s6 - bIJ ) * s6 ;
+                                g   -= 3.0e+00 * s2 * ( aIJ * s6 * s6 + f ) ;
+                                eLJ += f ;
+                            }
                         }
-                        if ( doLennardJones )
+                        if ( doGradients )
                         {
-
-	                    tIJ  = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
-                            aIJ  = ljParameters->tableA[tIJ] * lennardJonesScale ;
-                            bIJ  = ljParameters->tableB[tIJ] * lennardJonesScale ;
-                            s6   = s2 * s2 * s2 ;
-                            f    = ( aIJ * s6 - bIJ ) * s6 ;
-                            g   -= 3.0e+00 * s2 * ( aIJ * s6 * s6 + f ) ;
-                            eLJ += f ;
+                            g   *= 2.0e+00 ;
+                            xIJ *= g ;
+                            yIJ *= g ;
+                            zIJ *= g ;
+                            Coordinates3_IncrementRow ( threadGradients3I, i, xIJ, yIJ, zIJ ) ;
+                            Coordinates3_DecrementRow ( threadGradients3J, j, xIJ, yIJ, zIJ ) ;
                         }
                     }
-                    if ( doGradients )
-                    {
-                        g   *= 2.0e+00 ;
-                        xIJ *= g ;
-                        yIJ *= g ;
-                        zIJ *= g ;
-                        Coordinates3_IncrementRow ( gradients3I, i, xIJ, yIJ, zIJ ) ;
-                        Coordinates3_DecrementRow ( gradients3J, j, xIJ, yIJ, zIJ ) ;
-                    }
-	        }
+                }
             }
+            Integer_Deallocate ( &work ) ;
+            if ( doGradients     ) Coordinates3_ReducePairedThreadBuffers ( gradients3I, gradients3J, numberOfThreads, &iBuffers, &jBuffers ) ;
             if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
             if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
         }
@@ -340,103 +363,120 @@ void PairwiseInteractionFull_QCMMGradients ( const PairwiseInteractionFull *self
          ( pairList           != NULL    ) &&
          ( Status_IsOK ( status )        ) )
     {
-        auto Integer     d = Coordinates3_Rows ( coordinates3Q ), m, n, order, q, r ;
-        auto PairRecord *record ;
-
-        auto Real        a, b, cutOff, eScale, dX, dY, dZ, f2, f3, g1, g2, g3, gX, gXt, gY, gYt, gZ, gZt,
-                         q0, qM, qX  = 0.0e+00, qY  = 0.0e+00, qZ  = 0.0e+00,
-                                 qXX = 0.0e+00, qXY = 0.0e+00, qXZ = 0.0e+00,
-                                 qYY = 0.0e+00, qYZ = 0.0e+00, qZZ = 0.0e+00,
-                         r1, r2, scale1, scale2, scale3, t, xM, xQ, yM, yQ, zM, zQ ;
-
-        cutOff = Maximum ( 0.0e+00, self->dampingCutOff ) ;
-        eScale = electrostaticScale * Units_Energy_Hartrees_To_Kilojoules_Per_Mole ;
-        order  = Maximum ( Minimum ( multipoleOrder, 2 ), 0 ) ;
-        scale1 =       Units_Length_Angstroms_To_Bohrs      ;
-        scale2 = pow ( Units_Length_Angstroms_To_Bohrs, 2 ) ;
-        scale3 = pow ( Units_Length_Angstroms_To_Bohrs, 3 ) ;
-        for ( r = 0 ; r < pairList->count ; r++ )
+        auto Coordinates3 *mGradients3 = ( Coordinates3 * ) gradients3M ;
+        auto Integer       d = Coordinates3_Rows ( coordinates3Q ), numberOfThreads, order, *work ;
+        auto Real          cutOff, eScale, *mBuffers, scale1, scale2, scale3 ;
+        cutOff   = Maximum ( 0.0e+00, self->dampingCutOff ) ;
+        eScale   = electrostaticScale * Units_Energy_Hartrees_To_Kilojoules_Per_Mole ;
+        order    = Maximum ( Minimum ( multipoleOrder, 2 ), 0 ) ;
+        scale1   =       Units_Length_Angstroms_To_Bohrs      ;
+        scale2   = pow ( Units_Length_Angstroms_To_Bohrs, 2 ) ;
+        scale3   = pow ( Units_Length_Angstroms_To_Bohrs, 3 ) ;
+        mBuffers = Coordinates3_AllocateThreadBuffers ( mGradients3, &numberOfThreads ) ;
+        work     = PairList_AllocateThreadWork        ( pairList   , &numberOfThreads ) ;
+        /* . Each QC atom has a single record so only the MM gradients need per-thread buffers. */
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads )
+# endif
         {
-            record = PairList_GetRecord ( pairList, r ) ;
-            q      = record->index ;
-            q0     = eScale * Array1D_Item ( multipolesQ, q ) ;
-            if ( order > 0 )
+            auto Coordinates3  mView, *threadGradients3M ;
+            auto Integer       m, n, q, r, *threadWork ;
+            auto PairRecord   *record, view ;
+            auto Real          a, b, dX, dY, dZ, f2, f3, g1, g2, g3, gX, gXt, gY, gYt, gZ, gZt,
+                               q0, qM, qX  = 0.0e+00, qY  = 0.0e+00, qZ  = 0.0e+00,
+                                       qXX = 0.0e+00, qXY = 0.0e+00, qXZ = 0.0e+00,
+                                       qYY = 0.0e+00, qYZ = 0.0e+00, qZZ = 0.0e+00,
+                               r1, r2, t, xM, xQ, yM, yQ, zM, zQ ;
+            threadGradients3M = Coordinates3_ThreadBuffer ( mGradients3, mBuffers, &mView ) ;
+            threadWork        = PairList_ThreadWork       ( pairList   , work                ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( r = 0 ; r < pairList->count ; r++ )
             {
-                qX = eScale * Array1D_Item ( multipolesQ, q +   d ) ;
-                qY = eScale * Array1D_Item ( multipolesQ, q + 2*d ) ;
-                qZ = eScale * Array1D_Item ( multipolesQ, q + 3*d ) ;
-                if ( order > 1 )
-                {
-                    qXX = eScale * Array1D_Item ( multipolesQ, q + 4*d ) ;
-                    qXY = eScale * Array1D_Item ( multipolesQ, q + 5*d ) ;
-                    qXZ = eScale * Array1D_Item ( multipolesQ, q + 6*d ) ;
-                    qYY = eScale * Array1D_Item ( multipolesQ, q + 7*d ) ;
-                    qYZ = eScale * Array1D_Item ( multipolesQ, q + 8*d ) ;
-                    qZZ = eScale * Array1D_Item ( multipolesQ, q + 9*d ) ;
-                }
-            }
-	    Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
-       	    for ( n = 0, gXt = gYt = gZt = 0.0e+00 ; n < record->capacity ; n++ )
-	    {
-	        m  = record->indices[n] ;
-                qM = Array1D_Item ( chargesM, m ) ;
-	        Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
-                dX = xQ - xM ;
-                dY = yQ - yM ;
-                dZ = zQ - zM ;
-                r2  = ( dX * dX + dY * dY + dZ * dZ ) ;
-                r1  = sqrt ( r2 ) ;
-                if ( r1 <= cutOff )
-                {
-                    f2 = qM * ( self->alpha2 * r2 + self->beta2 ) / scale2 ; ;
-                    f3 = qM * ( self->alpha3 * r2 + self->beta3 ) / scale3 ; ;
-                    g1 = 2.0e+00 * qM * self->alpha1 * r1 / scale1 ;
-                    g2 = 2.0e+00 * qM * self->alpha2 * r1 / scale2 ;
-                    g3 = 2.0e+00 * qM * self->alpha3 * r1 / scale3 ;
-                    if ( r1 == 0.0e+00 ) { dX = dY = dZ = 0.0e+00 ; r1 = 1.0e+00 ; }
-                }
-                else
-                {
-                    f2 = qM / (      r2 * scale2 ) ;
-                    f3 = qM / ( r1 * r2 * scale3 ) ;
-                    g1 = -           qM / (      r2 * scale1 ) ;
-                    g2 = - 2.0e+00 * qM / ( r1 * r2 * scale2 ) ;
-                    g3 = - 3.0e+00 * qM / ( r2 * r2 * scale3 ) ;
-                }
-                dX /= r1 ;
-                dY /= r1 ;
-                dZ /= r1 ;
-                g1 *= q0 ;
-                gX  = g1 * dX ;
-                gY  = g1 * dY ;
-                gZ  = g1 * dZ ;
+                record = PairList_GetRecordWithWork ( pairList, r, threadWork, &view ) ;
+                q      = record->index ;
+                q0     = eScale * Array1D_Item ( multipolesQ, q ) ;
                 if ( order > 0 )
                 {
-                    a   = f2 / r1 ;
-                    b   = ( g2 - a ) * ( dX * qX + dY * qY + dZ * qZ ) ;
-                    gX -= ( qX * a + dX * b ) ;
-                    gY -= ( qY * a + dY * b ) ;
-                    gZ -= ( qZ * a + dZ * b ) ;
+                    qX = eScale * Array1D_Item ( multipolesQ, q +   d ) ;
+                    qY = eScale * Array1D_Item ( multipolesQ, q + 2*d ) ;
+                    qZ = eScale * Array1D_Item ( multipolesQ, q + 3*d ) ;
                     if ( order > 1 )
                     {
-                        t   = qXX + qYY + qZZ ;
-                        a   = 2.0e+00 * f3 / r1 ;
-                        b   = 0.5e+00 * ( 3.0e+00 * ( g3 - a ) * ( qXX * dX * dX +
-                                                                   qYY * dY * dY +
-                                                                   qZZ * dZ * dZ +
-                                                       2.0e+00 * ( qXY * dX * dY +
-                                                                   qXZ * dX * dZ +
-                                                                   qYZ * dY * dZ ) ) - g3 * t ) ;
-                        gX += ( 1.5e+00 * a * ( qXX * dX + qXY * dY + qXZ * dZ ) + dX * b ) ;
-                        gY += ( 1.5e+00 * a * ( qXY * dX + qYY * dY + qYZ * dZ ) + dY * b ) ;
-                        gZ += ( 1.5e+00 * a * ( qXZ * dX + qYZ * dY + qZZ * dZ ) + dZ * b ) ;
+                        qXX = eScale * Array1D_Item ( multipolesQ, q + 4*d ) ;
+                        qXY = eScale * Array1D_Item ( multipolesQ, q + 5*d ) ;
+                        qXZ = eScale * Array1D_Item ( multipolesQ, q + 6*d ) ;
+                        qYY = eScale * Array1D_Item ( multipolesQ, q + 7*d ) ;
+                        qYZ = eScale * Array1D_Item ( multipolesQ, q + 8*d ) ;
+                        qZZ = eScale * Array1D_Item ( multipolesQ, q + 9*d ) ;
                     }
                 }
-                gXt += gX ; gYt += gY ; gZt += gZ ;
-                Coordinates3_DecrementRow ( gradients3M, m, gX, gY, gZ ) ;
-	    }
-            Coordinates3_IncrementRow ( gradients3Q, q, gXt, gYt, gZt ) ;
+                Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
+                for ( n = 0, gXt = gYt = gZt = 0.0e+00 ; n < record->capacity ; n++ )
+                {
+                    m  = record->indices[n] ;
+                    qM = Array1D_Item ( chargesM, m ) ;
+                    Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
+                    dX = xQ - xM ;
+                    dY = yQ - yM ;
+                    dZ = zQ - zM ;
+                    r2  = ( dX * dX + dY * dY + dZ * dZ ) ;
+                    r1  = sqrt ( r2 ) ;
+                    if ( r1 <= cutOff )
+                    {
+                        f2 = qM * ( self->alpha2 * r2 + self->beta2 ) / scale2 ; ;
+                        f3 = qM * ( self->alpha3 * r2 + self->beta3 ) / scale3 ; ;
+                        g1 = 2.0e+00 * qM * self->alpha1 * r1 / scale1 ;
+                        g2 = 2.0e+00 * qM * self->alpha2 * r1 / scale2 ;
+                        g3 = 2.0e+00 * qM * self->alpha3 * r1 / scale3 ;
+                        if ( r1 == 0.0e+00 ) { dX = dY = dZ = 0.0e+00 ; r1 = 1.0e+00 ; }
+                    }
+                    else
+                    {
+                        f2 = qM / (      r2 * scale2 ) ;
+                        f3 = qM / ( r1 * r2 * scale3 ) ;
+                        g1 = -           qM / (      r2 * scale1 ) ;
+                        g2 = - 2.0e+00 * qM / ( r1 * r2 * scale2 ) ;
+                        g3 = - 3.0e+00 * qM / ( r2 * r2 * scale3 ) ;
+                    }
+                    dX /= r1 ;
+                    dY /= r1 ;
+                    dZ /= r1 ;
+                    g1 *= q0 ;
+                    gX  = g1 * dX ;
+                    gY  = g1 * dY ;
+                    gZ  = g1 * dZ ;
+                    if ( order > 0 )
+                    {
+                        a   = f2 / r1 ;
+                        b   = ( g2 - a ) * ( dX * qX + dY * qY + dZ * qZ ) ;
+                        gX -= ( qX * a + dX * b ) ;
+                        gY -= ( qY * a + dY * b ) ;
+                        gZ -= ( qZ * a + dZ * b ) ;
+                        if ( order > 1 )
+                        {
+                            t   = qXX + qYY + qZZ ;
+                            a   = 2.0e+00 * f3 / r1 ;
+                            b   = 0.5e+00 * ( 3.0e+00 * ( g3 - a ) * ( qXX * dX * dX +
+                                                                       qYY * dY * dY +
+                                                                       qZZ * dZ * dZ +
+                                                           2.0e+00 * ( qXY * dX * dY +
+                                                                       qXZ * dX * dZ +
+                                                                       qYZ * dY * dZ ) ) - g3 * t ) ;
+                            gX += ( 1.5e+00 * a * ( qXX * dX + qXY * dY + qXZ * dZ ) + dX * b ) ;
+                            gY += ( 1.5e+00 * a * ( qXY * dX + qYY * dY + qYZ * dZ ) + dY * b ) ;
+                            gZ += ( 1.5e+00 * a * ( qXZ * dX + qYZ * dY + qZZ * dZ ) + dZ * b ) ;
+                        }
+                    }
+                    gXt += gX ; gYt += gY ; gZt += gZ ;
+                    Coordinates3_DecrementRow ( threadGradients3M, m, gX, gY, gZ ) ;
+                }
+                Coordinates3_IncrementRow ( gradients3Q, q, gXt, gYt, gZt ) ;
+            }
         }
+        Coordinates3_ReduceThreadBuffers ( mGradients3, numberOfThreads, &mBuffers ) ;
+        Integer_Deallocate ( &work ) ;
     }
 }
 
@@ -464,83 +504,97 @@ void PairwiseInteractionFull_QCMMPotentials ( const PairwiseInteractionFull *sel
          ( potentials         != NULL    ) &&
          ( Status_IsOK ( status )        ) )
     {
-        auto Integer     d = Coordinates3_Rows ( coordinates3Q ), m, n, order, q, r ;
-        auto PairRecord *record ;
-        auto Real        cutOff, dX, dY, dZ, eScale, f1, f2, f3,
-                         p0, pX, pY, pZ, pXX, pXY, pXZ, pYY, pYZ, pZZ,
-                         qM, r1, r2, scale1, scale2, scale3,
-                         xM, xQ, yM, yQ, zM, zQ ;
+        auto Integer     d = Coordinates3_Rows ( coordinates3Q ), numberOfThreads, order, *work ;
+        auto Real        cutOff, eScale, scale1, scale2, scale3 ;
         cutOff = Maximum ( 0.0e+00, self->dampingCutOff ) ;
         eScale = electrostaticScale ;
         order  = Maximum ( Minimum ( multipoleOrder, 2 ), 0 ) ;
         scale1 =       Units_Length_Angstroms_To_Bohrs      ;
         scale2 = pow ( Units_Length_Angstroms_To_Bohrs, 2 ) ;
         scale3 = pow ( Units_Length_Angstroms_To_Bohrs, 3 ) ;
-        for ( r = 0 ; r < pairList->count ; r++ )
+        /* . Each QC atom has a single record so the records can be done in parallel. */
+        Coordinates3_AllocateThreadBuffers ( NULL, &numberOfThreads ) ;
+        work = PairList_AllocateThreadWork ( pairList, &numberOfThreads ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads )
+# endif
         {
-            record = PairList_GetRecord ( pairList, r ) ;
-            q      = record->index ;
-	    Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
-            p0 = pX = pY = pZ = pXX = pXY = pXZ = pYY = pYZ = pZZ = 0.0e+00 ;
-       	    for ( n = 0 ; n < record->capacity ; n++ )
-	    {
-	        m   = record->indices[n] ;
-                qM  = Array1D_Item ( chargesM, m ) ;
-	        Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
-                dX = xQ - xM ;
-                dY = yQ - yM ;
-                dZ = zQ - zM ;
-                r2  = ( dX * dX + dY * dY + dZ * dZ ) ;
-                r1  = sqrt ( r2 ) ;
-                if ( r1 <= cutOff )
-                {
-                    f1 = qM * ( self->alpha1 * r2 + self->beta1 ) / scale1 ;
-                    f2 = qM * ( self->alpha2 * r2 + self->beta2 ) / scale2 ;
-                    f3 = qM * ( self->alpha3 * r2 + self->beta3 ) / scale3 ;
-                    if ( r1 == 0.0e+00 ) { dX = dY = dZ = 0.0e+00 ; r1 = 1.0e+00 ; }
-                }
-                else
+            auto Integer     m, n, q, r, *threadWork ;
+            auto PairRecord *record, view ;
+            auto Real        dX, dY, dZ, f1, f2, f3,
+                             p0, pX, pY, pZ, pXX, pXY, pXZ, pYY, pYZ, pZZ,
+                             qM, r1, r2, xM, xQ, yM, yQ, zM, zQ ;
+            threadWork = PairList_ThreadWork ( pairList, work ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( r = 0 ; r < pairList->count ; r++ )
+            {
+                record = PairList_GetRecordWithWork ( pairList, r, threadWork, &view ) ;
+                q      = record->index ;
+                Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
+                p0 = pX = pY = pZ = pXX = pXY = pXZ = pYY = pYZ = pZZ = 0.0e+00 ;
+                for ( n = 0 ; n < record->capacity ; n++ )
                 {
-                    f1 = qM / ( r1      * scale1 ) ;
-                    f2 = qM / (      r2 * scale2 ) ;
-                    f3 = qM / ( r1 * r2 * scale3 ) ;
+                    m   = record->indices[n] ;
+                    qM  = Array1D_Item ( chargesM, m ) ;
+                    Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
+                    dX = xQ - xM ;
+                    dY = yQ - yM ;
+                    dZ = zQ - zM ;
+                    r2  = ( dX * dX + dY * dY + dZ * dZ ) ;
+                    r1  = sqrt ( r2 ) ;
+                    if ( r1 <= cutOff )
+                    {
+                        f1 = qM * ( self->alpha1 * r2 + self->beta1 ) / scale1 ;
+                        f2 = qM * ( self->alpha2 * r2 + self->beta2 ) / scale2 ;
+                        f3 = qM * ( self->alpha3 * r2 + self->beta3 ) / scale3 ;
+                        if ( r1 == 0.0e+00 ) { dX = dY = dZ = 0.0e+00 ; r1 = 1.0e+00 ; }
+                    }
+                    else
+                    {
+                        f1 = qM / ( r1      * scale1 ) ;
+                        f2 = qM / (      r2 * scale2 ) ;
+                        f3 = qM / ( r1 * r2 * scale3 ) ;
+                    }
+                    p0 += f1 ;
+                    if ( order > 0 )
+                    {
+                        dX /= r1 ;
+                        dY /= r1 ;
+                        dZ /= r1 ;
+                        pX -= dX * f2 ;
+                        pY -= dY * f2 ;
+                        pZ -= dZ * f2 ;
+                        if ( order > 1 )
+                        {
+                            pXX += 0.5e+00 * ( 3.0e+00 * dX * dX - 1.0e+00 ) * f3 ;
+                            pXY +=           ( 3.0e+00 * dX * dY           ) * f3 ; /* times 2 */
+                            pXZ +=           ( 3.0e+00 * dX * dZ           ) * f3 ; /* times 2 */
+                            pYY += 0.5e+00 * ( 3.0e+00 * dY * dY - 1.0e+00 ) * f3 ;
+                            pYZ +=           ( 3.0e+00 * dY * dZ           ) * f3 ; /* times 2 */
+                            pZZ += 0.5e+00 * ( 3.0e+00 * dZ * dZ - 1.0e+00 ) * f3 ;
+                        }
+                    }
                 }
-                p0 += f1 ;
+                Array1D_Item ( potentials, q ) += ( eScale * p0 ) ;
                 if ( order > 0 )
                 {
-                    dX /= r1 ;
-                    dY /= r1 ;
-                    dZ /= r1 ;
-                    pX -= dX * f2 ;
-                    pY -= dY * f2 ;
-                    pZ -= dZ * f2 ;
+                    Array1D_Item ( potentials, q +   d ) += ( eScale * pX ) ;
+                    Array1D_Item ( potentials, q + 2*d ) += ( eScale * pY ) ;
+                    Array1D_Item ( potentials, q + 3*d ) += ( eScale * pZ ) ;
                     if ( order > 1 )
                     {
-                        pXX += 0.5e+00 * ( 3.0e+00 * dX * dX - 1.0e+00 ) * f3 ;
-                        pXY +=           ( 3.0e+00 * dX * dY           ) * f3 ; /* times 2 */
-                        pXZ +=           ( 3.0e+00 * dX * dZ           ) * f3 ; /* times 2 */
-                        pYY += 0.5e+00 * ( 3.0e+00 * dY * dY - 1.0e+00 ) * f3 ;
-                        pYZ +=           ( 3.0e+00 * dY * dZ           ) * f3 ; /* times 2 */
-                        pZZ += 0.5e+00 * ( 3.0e+00 * dZ * dZ - 1.0e+00 ) * f3 ;
+                        Array1D_Item ( potentials, q + 4*d ) += ( eScale * pXX ) ;
+                        Array1D_Item ( potentials, q + 5*d ) += ( eScale * pXY ) ;
+                        Array1D_Item ( potentials, q + 6*d ) += ( eScale * pXZ ) ;
+                        Array1D_Item ( potentials, q + 7*d ) += ( eScale * pYY ) ;
+                        Array1D_Item ( potentials, q + 8*d ) += ( eScale * pYZ ) ;
+                        Array1D_Item ( potentials, q + 9*d ) += ( eScale * pZZ ) ;
                     }
                 }
-	    }
-            Array1D_Item ( potentials, q ) += ( eScale * p0 ) ;
-            if ( order > 0 )
-            {
-                Array1D_Item ( potentials, q +   d ) += ( eScale * pX ) ;
-                Array1D_Item ( potentials, q + 2*d ) += ( eScale * pY ) ;
-                Array1D_Item ( potentials, q + 3*d ) += ( eScale * pZ ) ;
-                if ( order > 1 )
-                {
-                    Array1D_Item ( potentials, q + 4*d ) += ( eScale * pXX ) ;
-                    Array1D_Item ( potentials, q + 5*d ) += ( eScale * pXY ) ;
-                    Array1D_Item ( potentials, q + 6*d ) += ( eScale * pXZ ) ;
-                    Array1D_Item ( potentials, q + 7*d ) += ( eScale * pYY ) ;
-                    Array1D_Item ( potentials, q + 8*d ) += ( eScale * pYZ ) ;
-                    Array1D_Item ( potentials, q + 9*d ) += ( eScale * pZZ ) ;
-                }
             }
         }
+        Integer_Deallocate ( &work ) ;
     }
 }
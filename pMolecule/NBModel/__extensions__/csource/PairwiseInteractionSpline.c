@@ -2,7 +2,9 @@
 ! . Pairwise interactions of general form and limited range.
 !=================================================================================================================================*/
 
+# include <math.h>
 # include "Boolean.h"
+# include "MachineTypes.h"
 # include "Memory.h"
 # include "MinimumImageUtilities.h"
 # include "NumericalMacros.h"
@@ -14,10 +16,56 @@
 !---------------------------------------------------------------------------------------------------------------------------------*/
 # define _DefaultCutOff 12.0e+00
 
+/* . The number of table bins per unit of r^2 (Angstroms^2). */
+# define _TableDensity 25.0e+00
+
+/* . The number of interactions and lanes per table coefficient. */
+# define _TableInteractions 3
+# define _TableLanes        4
+# define _TableStride       PairwiseInteractionSpline_TableStride
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Macros.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . Evaluation of all interactions, f, and their derivatives with respect to r^2, g, from the table. */
+/* . The loop over lanes is of fixed length and operates on contiguous coefficients so that it can be vectorized. */
+# define TableEvaluateFG( self, r2, f, g ) \
+    { \
+        auto Integer  b, k ; \
+        auto Real     t, x ; \
+        auto Real    *c ; \
+        x = r2 * self->tableScale ; \
+        b = Minimum ( ( Integer ) x, self->tableBins - 1 ) ; \
+        t = x - ( Real ) b ; \
+        c = &(self->table[b*_TableStride]) ; \
+        for ( k = 0 ; k < _TableLanes ; k++ ) \
+        { \
+            f[k] = c[k] + t * ( c[k+_TableLanes] + t * ( c[k+2*_TableLanes] + t * c[k+3*_TableLanes] ) ) ; \
+            g[k] = ( c[k+_TableLanes] + t * ( 2.0e+00 * c[k+2*_TableLanes] + 3.0e+00 * t * c[k+3*_TableLanes] ) ) * self->tableScale ; \
+        } \
+    }
+
+# define TableEvaluateFGSingle( self, r2, scale, f, g ) \
+    { \
+        auto Integer  b, k ; \
+        auto Real32   t, x ; \
+        auto Real32  *c ; \
+        x = r2 * scale ; \
+        b = Minimum ( ( Integer ) x, self->tableBins - 1 ) ; \
+        t = x - ( Real32 ) b ; \
+        c = &(self->tableSingle[b*_TableStride]) ; \
+        for ( k = 0 ; k < _TableLanes ; k++ ) \
+        { \
+            f[k] = c[k] + t * ( c[k+_TableLanes] + t * ( c[k+2*_TableLanes] + t * c[k+3*_TableLanes] ) ) ; \
+            g[k] = ( c[k+_TableLanes] + t * ( 2.0e+00f * c[k+2*_TableLanes] + 3.0e+00f * t * c[k+3*_TableLanes] ) ) * scale ; \
+        } \
+    }
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Local functions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static void PairwiseInteractionSpline_Initialize ( PairwiseInteractionSpline *self ) ;
+static void PairwiseInteractionSpline_Initialize ( PairwiseInteractionSpline *self                 ) ;
+static void PairwiseInteractionSpline_MakeTable  ( PairwiseInteractionSpline *self, Status *status ) ;
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Allocation.
@@ -42,6 +90,7 @@ void PairwiseInteractionSpline_AssignElectrostaticSpline ( PairwiseInteractionSp
         self->electrostaticSpline = spline ;
         self->cutOff              = Maximum ( cutOff, self->cutOff ) ;
         self->cutOff2             = self->cutOff * self->cutOff      ;
+        PairwiseInteractionSpline_MakeTable ( self, NULL ) ;
     }
 }
 void PairwiseInteractionSpline_AssignLennardJonesASpline ( PairwiseInteractionSpline *self, CubicSpline *spline, Real cutOff )
@@ -52,6 +101,7 @@ void PairwiseInteractionSpline_AssignLennardJonesASpline ( PairwiseInteractionSp
         self->lennardJonesASpline = spline ;
         self->cutOff              = Maximum ( cutOff, self->cutOff ) ;
         self->cutOff2             = self->cutOff * self->cutOff      ;
+        PairwiseInteractionSpline_MakeTable ( self, NULL ) ;
     }
 }
 void PairwiseInteractionSpline_AssignLennardJonesBSpline ( PairwiseInteractionSpline *self, CubicSpline *spline, Real cutOff )
@@ -62,6 +112,7 @@ void PairwiseInteractionSpline_AssignLennardJonesBSpline ( PairwiseInteractionSp
         self->lennardJonesBSpline = spline ;
         self->cutOff              = Maximum ( cutOff, self->cutOff ) ;
         self->cutOff2             = self->cutOff * self->cutOff      ;
+        PairwiseInteractionSpline_MakeTable ( self, NULL ) ;
     }
 }
 
@@ -81,6 +132,7 @@ PairwiseInteractionSpline *PairwiseInteractionSpline_Clone ( PairwiseInteraction
             clone->electrostaticSpline = CubicSpline_Clone ( self->electrostaticSpline, status ) ;
             clone->lennardJonesASpline = CubicSpline_Clone ( self->lennardJonesASpline, status ) ;
             clone->lennardJonesBSpline = CubicSpline_Clone ( self->lennardJonesBSpline, status ) ;
+            PairwiseInteractionSpline_MakeTable ( clone, status ) ;
         }
     }
     return clone ;
@@ -96,6 +148,8 @@ void PairwiseInteractionSpline_Deallocate ( PairwiseInteractionSpline **self )
         CubicSpline_Deallocate ( &((*self)->electrostaticSpline) ) ;
         CubicSpline_Deallocate ( &((*self)->lennardJonesASpline) ) ;
         CubicSpline_Deallocate ( &((*self)->lennardJonesBSpline) ) ;
+        Memory_Deallocate ( (*self)->table       ) ;
+        Memory_Deallocate ( (*self)->tableSingle ) ;
         Memory_Deallocate ( (*self) ) ;
     }
 }
@@ -120,8 +174,12 @@ static void PairwiseInteractionSpline_Initialize ( PairwiseInteractionSpline *se
 {
     if ( self != NULL )
     {
+        self->tableBins           = 0 ;
         self->cutOff              = _DefaultCutOff ;
         self->cutOff2             = self->cutOff * self->cutOff ;
+        self->tableScale          = 0.0e+00 ;
+        self->table               = NULL ;
+        self->tableSingle         = NULL ;
         self->electrostaticSpline = NULL ;
         self->lennardJonesASpline = NULL ;
         self->lennardJonesBSpline = NULL ;
@@ -166,6 +224,66 @@ void PairwiseInteractionSpline_Interactions ( const PairwiseInteractionSpline *s
     }
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make the interaction table from the splines.
+! . The polynomial in each bin is the cubic Hermite interpolant of the spline values and derivatives at the ends of the bin.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void PairwiseInteractionSpline_MakeTable ( PairwiseInteractionSpline *self, Status *status )
+{
+    if ( self != NULL )
+    {
+        Memory_Deallocate ( self->table       ) ;
+        Memory_Deallocate ( self->tableSingle ) ;
+        self->tableBins  = 0       ;
+        self->tableScale = 0.0e+00 ;
+        if ( ( ( self->electrostaticSpline != NULL ) ||
+               ( self->lennardJonesASpline != NULL ) ||
+               ( self->lennardJonesBSpline != NULL ) ) && Status_IsOK ( status ) )
+        {
+            auto Integer n = Maximum ( ( Integer ) ceil ( _TableDensity * self->cutOff2 ), 1 ) ;
+            self->table       = Memory_AllocateArrayOfTypes ( _TableStride * n, Real   ) ;
+            self->tableSingle = Memory_AllocateArrayOfTypes ( _TableStride * n, Real32 ) ;
+            if ( ( self->table == NULL ) || ( self->tableSingle == NULL ) )
+            {
+                Memory_Deallocate ( self->table       ) ;
+                Memory_Deallocate ( self->tableSingle ) ;
+                Status_Set ( status, Status_OutOfMemory ) ;
+            }
+            else
+            {
+                auto CubicSpline *spline, *splines[_TableInteractions] = { self->electrostaticSpline ,
+                                                                           self->lennardJonesASpline ,
+                                                                           self->lennardJonesBSpline } ;
+                auto Integer      b, i, k ;
+                auto Real         f0, f1, g0, g1, h, upper, *c ;
+                h = self->cutOff2 / ( Real ) n ;
+                self->tableBins  = n ;
+                self->tableScale = 1.0e+00 / h ;
+                for ( i = 0 ; i < _TableStride * n ; i++ ) self->table[i] = 0.0e+00 ;
+                for ( k = 0 ; k < _TableInteractions ; k++ )
+                {
+                    spline = splines[k] ;
+                    if ( spline == NULL ) continue ;
+                    upper = Array1D_Item ( spline->x, View1D_Extent ( spline->x ) - 1 ) ;
+                    CubicSpline_Evaluate ( spline, 0, 0.0e+00, &f1, &g1, NULL, NULL ) ;
+                    for ( b = 0 ; b < n ; b++ )
+                    {
+                        c  = &(self->table[b*_TableStride]) ;
+                        f0 = f1 ;
+                        g0 = g1 ;
+                        CubicSpline_Evaluate ( spline, 0, Minimum ( ( Real ) ( b + 1 ) * h, upper ), &f1, &g1, NULL, NULL ) ;
+                        c[k              ] = f0 ;
+                        c[k+  _TableLanes] = h * g0 ;
+                        c[k+2*_TableLanes] = 3.0e+00 * ( f1 - f0 ) - h * ( 2.0e+00 * g0 + g1 ) ;
+                        c[k+3*_TableLanes] = 2.0e+00 * ( f0 - f1 ) + h * ( g0 + g1 ) ;
+                    }
+                }
+                for ( i = 0 ; i < _TableStride * n ; i++ ) self->tableSingle[i] = ( Real32 ) self->table[i] ;
+            }
+        }
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . MM/MM energy and gradients.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -209,71 +327,78 @@ void PairwiseInteractionSpline_MMMMEnergy ( const PairwiseInteractionSpline *sel
                           ( lennardJonesScale         != 0.0e+00 ) &&
                           ( self->lennardJonesASpline != NULL    ) &&
                           ( self->lennardJonesBSpline != NULL    ) ;
-        if ( doElectrostatic|| doLennardJones )
+        if ( ( doElectrostatic || doLennardJones ) && ( self->table == NULL ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else if ( doElectrostatic || doLennardJones )
         {
-            auto Integer           i, j, n, numberOfLJTypes = 0, tI = 0, tIJ ;
-            auto CubicSpline      *referenceSpline ;
-            auto Integer           l, u  ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
-            auto Real              aIJ, bIJ, cutOff2 = self->cutOff2, d, eScale, f, g, gL, qI = 0.0e+00, qIJ,
-                                   r2, s, t, xI, xIJ, xJ, yI, yIJ, yJ, zI, zIJ, zJ ;
+            auto Integer           numberOfLJTypes = 0, numberOfThreads ;
+            auto Real              cutOff2 = self->cutOff2, eScale, *iBuffers = NULL, *jBuffers = NULL ;
             auto Real              eLJ = 0.0e+00, eQQ = 0.0e+00 ;
             /* . Initialization. */
             eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
-            if ( doElectrostatic ) referenceSpline = self->electrostaticSpline ;
-            else                   referenceSpline = self->lennardJonesASpline ;
             if ( doLennardJones  ) numberOfLJTypes = ljParameters->ntypes ;
-            /* . Loop over record. */
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3I, gradients3J, &numberOfThreads, &iBuffers, &jBuffers ) ;
+            else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+            /* . Loop over records. */
+# ifdef USEOPENMP
+            #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
             {
-                /* . First atom. */
-                i  = record->index ;
-	        if ( doElectrostatic ) qI = eScale          * Array1D_Item   ( chargesI, i ) ;
-                if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
-	        Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
-                /* . Second atom. */
-       	        for ( n = 0 ; n < record->capacity ; n++ )
-	        {
-	            j   = record->indices[n] ;
-	            Coordinates3_GetRow ( coordinates3J , j, xJ, yJ, zJ ) ;
-                    xIJ = xI - xJ ;
-                    yIJ = yI - yJ ;
-                    zIJ = zI - zJ ;
-                    r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
-                    if ( r2 > cutOff2 ) continue ;
-                    CubicSpline_EvaluateLUDST ( referenceSpline, r2, &l, &u, &d, &s, &t ) ; /* . Assume all abscissae are the same. */
-                    g   = 0.0e+00 ;
-                    if ( doElectrostatic )
-                    {
-                        qIJ  = qI * Array1D_Item ( chargesJ, j ) ;
-                        CubicSpline_FastEvaluateFGN ( self->electrostaticSpline, 0, l, u, d, s, t, f, gL ) ;
-                        eQQ += ( qIJ * f ) ;
-                        g   += ( 2.0e+00 * qIJ * gL ) ;
-                    }
-                    if ( doLennardJones )
+                auto Coordinates3 iView, jView, *threadGradients3I = NULL, *threadGradients3J = NULL ;
+                auto Integer      i, j, n, r, tI = 0, tIJ ;
+                auto Real         aIJ, bIJ, fT[_TableLanes], g, gT[_TableLanes], qI = 0.0e+00, qIJ, r2, xI, xIJ, xJ, yI, yIJ, yJ, zI, zIJ, zJ ;
+                if ( doGradients )
+                {
+                    threadGradients3I = Coordinates3_ThreadBuffer ( gradients3I, iBuffers, &iView ) ;
+                    threadGradients3J = Coordinates3_ThreadBuffer ( gradients3J, jBuffers, &jView ) ;
+                }
+# ifdef USEOPENMP
+                #pragma omp for schedule ( dynamic )
+# endif
+                for ( r = 0 ; r < pairList->count ; r++ )
+                {
+                    /* . First atom. */
+                    i  = pairList->indices[r] ;
+                    if ( doElectrostatic ) qI = eScale          * Array1D_Item ( chargesI, i ) ;
+                    if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
+                    Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
+                    /* . Second atom. */
+                    for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
                     {
-	                tIJ  = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
-                        aIJ  = ljParameters->tableA[tIJ] * lennardJonesScale ;
-                        bIJ  = ljParameters->tableB[tIJ] * lennardJonesScale ;
-                        CubicSpline_FastEvaluateFGN ( self->lennardJonesASpline, 0, l, u, d, s, t, f, gL ) ;
-                        eLJ += aIJ * f  ;
-                        g   += ( 2.0e+00 * aIJ * gL ) ;
-                        CubicSpline_FastEvaluateFGN ( self->lennardJonesBSpline, 0, l, u, d, s, t, f, gL ) ;
-                        eLJ += bIJ * f  ;
-                        g   += ( 2.0e+00 * bIJ * gL ) ;
+                        j   = pairList->partners[n] ;
+                        Coordinates3_GetRow ( coordinates3J , j, xJ, yJ, zJ ) ;
+                        xIJ = xI - xJ ;
+                        yIJ = yI - yJ ;
+                        zIJ = zI - zJ ;
+                        r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                        if ( r2 > cutOff2 ) continue ;
+                        TableEvaluateFG ( self, r2, fT, gT ) ;
+                        g   = 0.0e+00 ;
+                        if ( doElectrostatic )
+                        {
+                            qIJ  = qI * Array1D_Item ( chargesJ, j ) ;
+                            eQQ += ( qIJ * fT[0] ) ;
+                            g   += ( 2.0e+00 * qIJ * gT[0] ) ;
+                        }
+                        if ( doLennardJones )
+                        {
+                            tIJ  = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                            aIJ  = ljParameters->tableA[tIJ] * lennardJonesScale ;
+                            bIJ  = ljParameters->tableB[tIJ] * lennardJonesScale ;
+                            eLJ += ( aIJ * fT[1] + bIJ * fT[2] ) ;
+                            g   += ( 2.0e+00 * ( aIJ * gT[1] + bIJ * gT[2] ) ) ;
+                        }
+                        if ( doGradients )
+                        {
+                            xIJ *= g ;
+                            yIJ *= g ;
+                            zIJ *= g ;
+                            Coordinates3_IncrementRow ( threadGradients3I, i, xIJ, yIJ, zIJ ) ;
+                            Coordinates3_DecrementRow ( threadGradients3J, j, xIJ, yIJ, zIJ ) ;
+                        }
                     }
-                    if ( doGradients )
-                    {
-                        xIJ *= g ;
-                        yIJ *= g ;
-                        zIJ *= g ;
-                        Coordinates3_IncrementRow ( gradients3I, i, xIJ, yIJ, zIJ ) ;
-                        Coordinates3_DecrementRow ( gradients3J, j, xIJ, yIJ, zIJ ) ;
-	            }
                 }
             }
+            if ( doGradients     ) Coordinates3_ReducePairedThreadBuffers ( gradients3I, gradients3J, numberOfThreads, &iBuffers, &jBuffers ) ;
             if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
             if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
         }
@@ -355,6 +480,7 @@ void PairwiseInteractionSpline_MMMMEnergyImage ( const PairwiseInteractionSpline
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . MM/MM energy and gradients within the minimum image convention.
+! . As for the ABFS case, the minimum image displacements are found pair by pair from the fractional coordinates.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 void PairwiseInteractionSpline_MMMMEnergyMI ( const PairwiseInteractionSpline  *self                       ,
                                               const RealArray1D                *chargesI                   ,
@@ -384,15 +510,14 @@ void PairwiseInteractionSpline_MMMMEnergyMI ( const PairwiseInteractionSpline  *
          ( pairList           != NULL ) &&
            Status_IsOK ( status ) )
     {
-        auto Boolean doElectrostatic, doGradients, doLennardJones ;
+        auto Boolean doElectrostatic, doGradients, doLennardJones, doSymmetry ;
         doElectrostatic = ( chargesI                   != NULL    ) &&
                           ( chargesJ                   != NULL    ) &&
                           ( eElectrostatic             != NULL    ) &&
                           ( electrostaticScale         != 0.0e+00 ) &&
                           ( self->electrostaticSpline  != NULL    ) ;
         doGradients     = ( gradients3I                != NULL    ) &&
-                          ( gradients3J                != NULL    ) &&
-                          ( symmetryParameterGradients != NULL    ) ;
+                          ( gradients3J                != NULL    ) ;
         doLennardJones  = ( eLennardJones              != NULL    ) &&
                           ( ljTypesI                   != NULL    ) &&
                           ( ljTypesJ                   != NULL    ) &&
@@ -400,74 +525,255 @@ void PairwiseInteractionSpline_MMMMEnergyMI ( const PairwiseInteractionSpline  *
                           ( lennardJonesScale          != 0.0e+00 ) &&
                           ( self->lennardJonesASpline  != NULL    ) &&
                           ( self->lennardJonesBSpline  != NULL    ) ;
-        if ( doElectrostatic|| doLennardJones )
+        doSymmetry      = doGradients && ( symmetryParameterGradients != NULL ) ;
+        if ( ( doElectrostatic || doLennardJones ) && ( self->table == NULL ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else if ( doElectrostatic || doLennardJones )
         {
-            auto Integer           i, j, l, n, numberOfLJTypes = 0, tI = 0, tIJ, u ;
-            auto CubicSpline      *referenceSpline ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
-            auto Real              aIJ, bIJ, cutOff2 = self->cutOff2, eScale, f, g, gL, qI = 0.0e+00, qIJ, r2, s, xIJ, yIJ, zIJ ;
-            auto Real              eLJ = 0.0e+00, eQQ = 0.0e+00 ;
-            /* . Minimum image setup. */
-            MinimumImage_Allocate ( coordinates3I, coordinates3J ) ;
-            /* . Initialization. */
-            eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
-            if ( doElectrostatic ) referenceSpline = self->electrostaticSpline ;
-            else                   referenceSpline = self->lennardJonesASpline ;
-            if ( doLennardJones  ) numberOfLJTypes = ljParameters->ntypes ;
-            /* . Loop over record. */
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            auto Coordinates3 *fractionalI = NULL, *fractionalJ = NULL ;
+            auto Integer       numberOfLJTypes = 0, numberOfThreads ;
+            auto Real          cutOff2 = self->cutOff2, eScale, h[9], *iBuffers = NULL, *jBuffers = NULL ;
+            auto Real          eLJ = 0.0e+00, eQQ = 0.0e+00 ;
+            /* . Fractional coordinates. */
+            MinimumImage_MakeFractionalCoordinates ( symmetryParameters, coordinates3I, fractionalI, status ) ;
+            if ( coordinates3J == coordinates3I ) fractionalJ = fractionalI ;
+            else { MinimumImage_MakeFractionalCoordinates ( symmetryParameters, coordinates3J, fractionalJ, status ) ; }
+            if ( ( fractionalI != NULL ) && ( fractionalJ != NULL ) )
             {
-                /* . First atom. */
-                i  = record->index ;
-	        if ( doElectrostatic ) qI = eScale          * Array1D_Item ( chargesI, i ) ;
-                if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
-                /* . Displacements. */
-                MinimumImage_Displacements ( i, j ) ;
-                /* . Second atom. */
-       	        for ( n = 0 ; n < record->capacity ; n++ )
-	        {
-	            j = record->indices[n] ;
-	            Coordinates3_GetRow ( rDisplacements, n, xIJ, yIJ, zIJ ) ;
-                    r2 = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
-                    if ( r2 > cutOff2 ) continue ;
-                    CubicSpline_EvaluateLUDST ( referenceSpline, r2, &l, &u, &d, &s, &t ) ; /* . Assume all abscissae are the same. */
-                    g   = 0.0e+00 ;
-                    if ( doElectrostatic )
+                /* . Initialization. */
+                eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+                if ( doLennardJones  ) numberOfLJTypes = ljParameters->ntypes ;
+                MinimumImage_GetH ( symmetryParameters, h ) ;
+                if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3I, gradients3J, &numberOfThreads, &iBuffers, &jBuffers ) ;
+                else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+                /* . Loop over records. */
+# ifdef USEOPENMP
+                #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
+                {
+                    auto Coordinates3 iView, jView, *threadGradients3I = NULL, *threadGradients3J = NULL ;
+                    auto Integer      i, j, n, r, tI = 0, tIJ ;
+                    auto Real         aIJ, bIJ, dEdH[9], fT[_TableLanes], g, gT[_TableLanes], qI = 0.0e+00, qIJ, r2, tA, tB, tC, xIJ, yIJ, zIJ ;
+                    for ( n = 0 ; n < 9 ; n++ ) dEdH[n] = 0.0e+00 ;
+                    if ( doGradients )
+                    {
+                        threadGradients3I = Coordinates3_ThreadBuffer ( gradients3I, iBuffers, &iView ) ;
+                        threadGradients3J = Coordinates3_ThreadBuffer ( gradients3J, jBuffers, &jView ) ;
+                    }
+# ifdef USEOPENMP
+                    #pragma omp for schedule ( dynamic )
+# endif
+                    for ( r = 0 ; r < pairList->count ; r++ )
                     {
-                        qIJ  = qI * Array1D_Item ( chargesJ, j ) ;
-                        CubicSpline_FastEvaluateFGN ( self->electrostaticSpline, 0, l, u, d, s, t, f, gL ) ;
-                        eQQ += ( qIJ * f ) ;
-                        g   += ( 2.0e+00 * qIJ * gL ) ;
+                        /* . First atom. */
+                        i  = pairList->indices[r] ;
+                        if ( doElectrostatic ) qI = eScale          * Array1D_Item ( chargesI, i ) ;
+                        if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
+                        /* . Second atom. */
+                        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                        {
+                            j  = pairList->partners[n] ;
+                            MinimumImage_PairDisplacement ( fractionalI, fractionalJ, i, j, h, tA, tB, tC, xIJ, yIJ, zIJ ) ;
+                            r2 = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                            if ( r2 > cutOff2 ) continue ;
+                            TableEvaluateFG ( self, r2, fT, gT ) ;
+                            g  = 0.0e+00 ;
+                            if ( doElectrostatic )
+                            {
+                                qIJ  = qI * Array1D_Item ( chargesJ, j ) ;
+                                eQQ += ( qIJ * fT[0] ) ;
+                                g   += ( 2.0e+00 * qIJ * gT[0] ) ;
+                            }
+                            if ( doLennardJones )
+                            {
+                                tIJ  = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                                aIJ  = ljParameters->tableA[tIJ] * lennardJonesScale ;
+                                bIJ  = ljParameters->tableB[tIJ] * lennardJonesScale ;
+                                eLJ += ( aIJ * fT[1] + bIJ * fT[2] ) ;
+                                g   += ( 2.0e+00 * ( aIJ * gT[1] + bIJ * gT[2] ) ) ;
+                            }
+                            if ( doGradients )
+                            {
+                                xIJ *= g ;
+                                yIJ *= g ;
+                                zIJ *= g ;
+                                Coordinates3_IncrementRow ( threadGradients3I, i, xIJ, yIJ, zIJ ) ;
+                                Coordinates3_DecrementRow ( threadGradients3J, j, xIJ, yIJ, zIJ ) ;
+                                if ( doSymmetry ) MinimumImage_PairDerivatives ( dEdH, tA, tB, tC, xIJ, yIJ, zIJ ) ;
+                            }
+                        }
                     }
-                    if ( doLennardJones )
+                    if ( doSymmetry )
                     {
-	                tIJ  = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
-                        aIJ  = ljParameters->tableA[tIJ] * lennardJonesScale ;
-                        bIJ  = ljParameters->tableB[tIJ] * lennardJonesScale ;
-                        CubicSpline_FastEvaluateFGN ( self->lennardJonesASpline, 0, l, u, d, s, t, f, gL ) ;
-                        eLJ += aIJ * f  ;
-                        g   += ( 2.0e+00 * aIJ * gL ) ;
-                        CubicSpline_FastEvaluateFGN ( self->lennardJonesBSpline, 0, l, u, d, s, t, f, gL ) ;
-                        eLJ += bIJ * f  ;
-                        g   += ( 2.0e+00 * bIJ * gL ) ;
+# ifdef USEOPENMP
+                        #pragma omp critical ( MinimumImageDerivatives )
+# endif
+                        MinimumImage_AddDerivatives ( symmetryParameterGradients, dEdH ) ;
                     }
+                }
+                if ( doGradients     ) Coordinates3_ReducePairedThreadBuffers ( gradients3I, gradients3J, numberOfThreads, &iBuffers, &jBuffers ) ;
+                if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
+                if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
+            }
+            if ( fractionalJ != fractionalI ) Coordinates3_Deallocate ( &fractionalJ ) ;
+            Coordinates3_Deallocate ( &fractionalI ) ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . MM/MM energy and gradients in mixed precision.
+! . The pair arithmetic is done in single precision using the single precision table whereas the energies and gradients are
+!   accumulated in double precision.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void PairwiseInteractionSpline_MMMMEnergySingle ( const PairwiseInteractionSpline *self               ,
+                                                  const RealArray1D               *chargesI           ,
+                                                  const RealArray1D               *chargesJ           ,
+                                                        IntegerArray1D            *ljTypesI           ,
+                                                        IntegerArray1D            *ljTypesJ           ,
+                                                  const LJParameterContainer      *ljParameters       ,
+                                                  const Real                       electrostaticScale ,
+                                                  const Real                       lennardJonesScale  ,
+                                                  const Coordinates3              *coordinates3I      ,
+                                                  const Coordinates3              *coordinates3J      ,
+                                                        PairList                  *pairList           ,
+                                                        Real                      *eElectrostatic     ,
+                                                        Real                      *eLennardJones      ,
+                                                        Coordinates3              *gradients3I        ,
+                                                        Coordinates3              *gradients3J        ,
+                                                        Status                    *status             )
+{
+    if ( eElectrostatic != NULL ) (*eElectrostatic) = 0.0e+00 ;
+    if ( eLennardJones  != NULL ) (*eLennardJones ) = 0.0e+00 ;
+    if ( ( self          != NULL ) &&
+         ( coordinates3I != NULL ) &&
+         ( coordinates3J != NULL ) &&
+         ( pairList      != NULL ) &&
+           Status_IsOK ( status ) )
+    {
+        auto Boolean doElectrostatic, doGradients, doLennardJones ;
+        doElectrostatic = ( chargesI                  != NULL    ) &&
+                          ( chargesJ                  != NULL    ) &&
+                          ( eElectrostatic            != NULL    ) &&
+                          ( electrostaticScale        != 0.0e+00 ) &&
+                          ( self->electrostaticSpline != NULL    ) ;
+        doGradients     = ( gradients3I               != NULL    ) &&
+                          ( gradients3J               != NULL    ) ;
+        doLennardJones  = ( eLennardJones             != NULL    ) &&
+                          ( ljTypesI                  != NULL    ) &&
+                          ( ljTypesJ                  != NULL    ) &&
+                          ( ljParameters              != NULL    ) &&
+                          ( lennardJonesScale         != 0.0e+00 ) &&
+                          ( self->lennardJonesASpline != NULL    ) &&
+                          ( self->lennardJonesBSpline != NULL    ) ;
+        if ( ( doElectrostatic || doLennardJones ) && ( self->tableSingle == NULL ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else if ( doElectrostatic || doLennardJones )
+        {
+            auto Boolean  isShared = ( coordinates3I == coordinates3J ) && ( chargesI == chargesJ ) ;
+            auto Integer  nI = Coordinates3_Rows ( coordinates3I ), nJ = Coordinates3_Rows ( coordinates3J ) ;
+            auto Real32  *packedI = NULL, *packedJ = NULL ;
+            /* . Single precision copies of the coordinates and charges stored as x, y, z and q for each atom. */
+            packedI = Memory_AllocateArrayOfTypes ( Maximum ( 4 * nI, 1 ), Real32 ) ;
+            if ( isShared ) packedJ = packedI ;
+            else            packedJ = Memory_AllocateArrayOfTypes ( Maximum ( 4 * nJ, 1 ), Real32 ) ;
+            if ( ( packedI == NULL ) || ( packedJ == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+            else
+            {
+                auto Integer  i, numberOfLJTypes = 0, numberOfThreads ;
+                auto Real    *iBuffers = NULL, *jBuffers = NULL ;
+                auto Real     eLJ = 0.0e+00, eQQ = 0.0e+00 ;
+                auto Real32   cutOff2 = ( Real32 ) self->cutOff2, eScale, ljScale, tableScale = ( Real32 ) self->tableScale ;
+                /* . Initialization. */
+                eScale  = ( Real32 ) ( electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ) ;
+                ljScale = ( Real32 ) lennardJonesScale ;
+                if ( doLennardJones ) numberOfLJTypes = ljParameters->ntypes ;
+                for ( i = 0 ; i < nI ; i++ )
+                {
+                    packedI[4*i  ] = ( Real32 ) Coordinates3_Item ( coordinates3I, i, 0 ) ;
+                    packedI[4*i+1] = ( Real32 ) Coordinates3_Item ( coordinates3I, i, 1 ) ;
+                    packedI[4*i+2] = ( Real32 ) Coordinates3_Item ( coordinates3I, i, 2 ) ;
+                    if ( doElectrostatic ) packedI[4*i+3] = ( Real32 ) Array1D_Item ( chargesI, i ) ;
+                }
+                if ( ! isShared )
+                {
+                    for ( i = 0 ; i < nJ ; i++ )
+                    {
+                        packedJ[4*i  ] = ( Real32 ) Coordinates3_Item ( coordinates3J, i, 0 ) ;
+                        packedJ[4*i+1] = ( Real32 ) Coordinates3_Item ( coordinates3J, i, 1 ) ;
+                        packedJ[4*i+2] = ( Real32 ) Coordinates3_Item ( coordinates3J, i, 2 ) ;
+                        if ( doElectrostatic ) packedJ[4*i+3] = ( Real32 ) Array1D_Item ( chargesJ, i ) ;
+                    }
+                }
+                if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3I, gradients3J, &numberOfThreads, &iBuffers, &jBuffers ) ;
+                else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+                /* . Loop over records. */
+# ifdef USEOPENMP
+                #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : eLJ, eQQ )
+# endif
+                {
+                    auto Coordinates3  iView, jView, *threadGradients3I = NULL, *threadGradients3J = NULL ;
+                    auto Integer       i, j, n, r, tI = 0, tIJ ;
+                    auto Real32        aIJ, bIJ, fT[_TableLanes], g, gT[_TableLanes], qI = 0.0e+00f, qIJ, r2, xI, xIJ, yI, yIJ, zI, zIJ ;
+                    auto Real32       *pJ ;
                     if ( doGradients )
                     {
-                        xIJ *= g ;
-                        yIJ *= g ;
-                        zIJ *= g ;
-                        Coordinates3_IncrementRow ( gradients3I   , i, xIJ, yIJ, zIJ ) ;
-                        Coordinates3_DecrementRow ( gradients3J   , j, xIJ, yIJ, zIJ ) ;
-                        Coordinates3_SetRow       ( fDisplacements, n, xIJ, yIJ, zIJ ) ;
-	            }
+                        threadGradients3I = Coordinates3_ThreadBuffer ( gradients3I, iBuffers, &iView ) ;
+                        threadGradients3J = Coordinates3_ThreadBuffer ( gradients3J, jBuffers, &jView ) ;
+                    }
+# ifdef USEOPENMP
+                    #pragma omp for schedule ( dynamic )
+# endif
+                    for ( r = 0 ; r < pairList->count ; r++ )
+                    {
+                        /* . First atom. */
+                        i  = pairList->indices[r] ;
+                        xI = packedI[4*i  ] ;
+                        yI = packedI[4*i+1] ;
+                        zI = packedI[4*i+2] ;
+                        if ( doElectrostatic ) qI = eScale * packedI[4*i+3] ;
+                        if ( doLennardJones  ) tI = numberOfLJTypes * Array1D_Item ( ljTypesI, i ) ;
+                        /* . Second atom. */
+                        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
+                        {
+                            j   = pairList->partners[n] ;
+                            pJ  = &packedJ[4*j] ;
+                            xIJ = xI - pJ[0] ;
+                            yIJ = yI - pJ[1] ;
+                            zIJ = zI - pJ[2] ;
+                            r2  = ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                            if ( r2 > cutOff2 ) continue ;
+                            TableEvaluateFGSingle ( self, r2, tableScale, fT, gT ) ;
+                            g = 0.0e+00f ;
+                            if ( doElectrostatic )
+                            {
+                                qIJ  = qI * pJ[3] ;
+                                eQQ += ( qIJ * fT[0] ) ;
+                                g   += ( 2.0e+00f * qIJ * gT[0] ) ;
+                            }
+                            if ( doLennardJones )
+                            {
+                                tIJ  = ljParameters->tableindex[tI+Array1D_Item ( ljTypesJ, j )] ;
+                                aIJ  = ( Real32 ) ljParameters->tableA[tIJ] * ljScale ;
+                                bIJ  = ( Real32 ) ljParameters->tableB[tIJ] * ljScale ;
+                                eLJ += ( aIJ * fT[1] + bIJ * fT[2] ) ;
+                                g   += ( 2.0e+00f * ( aIJ * gT[1] + bIJ * gT[2] ) ) ;
+                            }
+                            if ( doGradients )
+                            {
+                                xIJ *= g ;
+                                yIJ *= g ;
+                                zIJ *= g ;
+                                Coordinates3_IncrementRow ( threadGradients3I, i, xIJ, yIJ, zIJ ) ;
+                                Coordinates3_DecrementRow ( threadGradients3J, j, xIJ, yIJ, zIJ ) ;
+                            }
+                        }
+                    }
                 }
-                MinimumImage_Gradients ;
+                if ( doGradients     ) Coordinates3_ReducePairedThreadBuffers ( gradients3I, gradients3J, numberOfThreads, &iBuffers, &jBuffers ) ;
+                if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
+                if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
             }
-            if ( doElectrostatic ) (*eElectrostatic) = eQQ ;
-            if ( doLennardJones  ) (*eLennardJones ) = eLJ ;
-            MinimumImage_Deallocate ;
+            if ( ! isShared ) Memory_Deallocate ( packedJ ) ;
+            Memory_Deallocate ( packedI ) ;
         }
     }
 }
@@ -499,41 +805,53 @@ void PairwiseInteractionSpline_QCMMGradients ( const PairwiseInteractionSpline *
     {
         if ( self->electrostaticSpline != NULL )
         {
-            auto Integer           m, n, q ;
+            auto Coordinates3     *mGradients3 = ( Coordinates3 * ) gradients3M ;
             auto CubicSpline      *spline = self->electrostaticSpline ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
-            auto Real              cutOff2 = self->cutOff2, eScale, g, gX, gY, gZ, qQ, qQM,
-                                   r2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
-            eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            auto Integer           numberOfThreads ;
+            auto Real              cutOff2 = self->cutOff2, eScale, *mBuffers ;
+            eScale   = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+            mBuffers = Coordinates3_AllocateThreadBuffers ( mGradients3, &numberOfThreads ) ;
+            /* . Each QC atom has a single record so only the MM gradients need per-thread buffers. */
+# ifdef USEOPENMP
+            #pragma omp parallel num_threads ( numberOfThreads )
+# endif
             {
-                q  = record->index ;
-                qQ = eScale * Array1D_Item ( chargesQ, q ) ;
-	        Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
-       	        for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < record->capacity ; n++ )
-	        {
-	            m   = record->indices[n] ;
-                    qQM = 2.0e+00 * qQ * Array1D_Item ( chargesM, m ) ; /*. Note the extra factor of 2 here rather than later. */
-	            Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
-                    xQM = xQ - xM ;
-                    yQM = yQ - yM ;
-                    zQM = zQ - zM ;
-                    r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
-                    if ( r2 > cutOff2 ) continue ;
-                    CubicSpline_Evaluate ( spline, 0, r2, NULL, &g, NULL, NULL ) ;
-                    g   *= qQM ;
-                    xQM *= g   ;
-                    yQM *= g   ;
-                    zQM *= g   ;
-                    Coordinates3_DecrementRow ( gradients3M, m, xQM, yQM, zQM ) ;
-                    gX  += xQM ;
-                    gY  += yQM ;
-                    gZ  += zQM ;
-	        }
-                Coordinates3_IncrementRow ( gradients3Q, q, gX, gY, gZ ) ;
+                auto Coordinates3 mView, *threadGradients3M ;
+                auto Integer      m, n, q, r ;
+                auto Real         g, gX, gY, gZ, qQ, qQM, r2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
+                threadGradients3M = Coordinates3_ThreadBuffer ( mGradients3, mBuffers, &mView ) ;
+# ifdef USEOPENMP
+                #pragma omp for schedule ( dynamic )
+# endif
+                for ( r = 0 ; r < pairList->count ; r++ )
+                {
+                    q  = pairList->indices[r] ;
+                    qQ = eScale * Array1D_Item ( chargesQ, q ) ;
+                    Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
+                    for ( n = pairList->offsets[r], gX = gY = gZ = 0.0e+00 ; n < pairList->offsets[r+1] ; n++ )
+                    {
+                        m   = pairList->partners[n] ;
+                        qQM = 2.0e+00 * qQ * Array1D_Item ( chargesM, m ) ; /*. Note the extra factor of 2 here rather than later. */
+                        Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
+                        xQM = xQ - xM ;
+                        yQM = yQ - yM ;
+                        zQM = zQ - zM ;
+                        r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
+                        if ( r2 > cutOff2 ) continue ;
+                        CubicSpline_Evaluate ( spline, 0, r2, NULL, &g, NULL, NULL ) ;
+                        g   *= qQM ;
+                        xQM *= g   ;
+                        yQM *= g   ;
+                        zQM *= g   ;
+                        Coordinates3_DecrementRow ( threadGradients3M, m, xQM, yQM, zQM ) ;
+                        gX  += xQM ;
+                        gY  += yQM ;
+                        gZ  += zQM ;
+                    }
+                    Coordinates3_IncrementRow ( gradients3Q, q, gX, gY, gZ ) ;
+                }
             }
+            Coordinates3_ReduceThreadBuffers ( mGradients3, numberOfThreads, &mBuffers ) ;
         }
     }
 }
@@ -626,26 +944,23 @@ void PairwiseInteractionSpline_QCMMGradientsMI ( const PairwiseInteractionSpline
     {
         if ( self->electrostaticSpline != NULL )
         {
-            auto Integer           m, n, q ;
+            auto Integer           m, n, q, r ;
             auto CubicSpline      *spline = self->electrostaticSpline ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
             auto Real              cutOff2 = self->cutOff2, eScale, g, gX, gY, gZ, qQ, qQM, r2, xQM, yQM, zQM ;
             /* . Minimum image setup. */
             MinimumImage_Allocate ( coordinates3Q, coordinates3M ) ;
             /* . Initialization. */
             eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            for ( r = 0 ; r < pairList->count ; r++ )
             {
-                q  = record->index ;
+                q  = pairList->indices[r] ;
                 qQ = eScale * Array1D_Item ( chargesQ, q ) ;
                 /* . Displacements. */
                 MinimumImage_Displacements ( q, m ) ;
                 /* . MM atom. */
-       	        for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < record->capacity ; n++ )
+       	        for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < PairList_RecordCapacity ( pairList, r ) ; n++ )
 	        {
-	            m   = record->indices[n] ;
+	            m   = PairList_RecordPartners ( pairList, r )[n] ;
                     qQM = 2.0e+00 * qQ * Array1D_Item ( chargesM, m ) ; /*. Note the extra factor of 2 here rather than later. */
 	            Coordinates3_GetRow ( rDisplacements, m, xQM, yQM, zQM ) ;
                     r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
@@ -692,20 +1007,21 @@ void PairwiseInteractionSpline_QCMMPotentials ( const PairwiseInteractionSpline
     {
         if ( self->electrostaticSpline != NULL )
         {
-            auto Integer           m, n, q ;
+            auto Integer           m, n, q, r ;
             auto CubicSpline      *spline = self->electrostaticSpline ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
             auto Real              cutOff2 = self->cutOff2, eScale, f, p, qM, r2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
             eScale  = electrostaticScale / Units_Length_Angstroms_To_Bohrs ;
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            /* . Each QC atom has a single record so the records can be done in parallel. */
+# ifdef USEOPENMP
+            #pragma omp parallel for private ( f, m, n, p, q, qM, r2, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ) schedule ( dynamic )
+# endif
+            for ( r = 0 ; r < pairList->count ; r++ )
             {
-                q  = record->index ;
+                q  = pairList->indices[r] ;
 	        Coordinates3_GetRow ( coordinates3Q, q, xQ, yQ, zQ ) ;
-       	        for ( n = 0, p = 0.0e+00 ; n < record->capacity ; n++ )
+       	        for ( n = pairList->offsets[r], p = 0.0e+00 ; n < pairList->offsets[r+1] ; n++ )
 	        {
-	            m   = record->indices[n] ;
+	            m   = pairList->partners[n] ;
                     qM  = Array1D_Item ( chargesM, m ) ;
 	            Coordinates3_GetRow ( coordinates3M, m, xM, yM, zM ) ;
                     xQM = xQ - xM ;
@@ -795,25 +1111,22 @@ void PairwiseInteractionSpline_QCMMPotentialsMI ( const PairwiseInteractionSplin
     {
         if ( self->electrostaticSpline != NULL )
         {
-            auto Integer           m, n, q ;
+            auto Integer           m, n, q, r ;
             auto CubicSpline      *spline = self->electrostaticSpline ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
             auto Real              cutOff2 = self->cutOff2, eScale, f, p, qM, r2, xQM, yQM, zQM ;
             /* . Minimum image setup. */
             MinimumImage_Allocate ( coordinates3Q, coordinates3M ) ;
             /* . Initialization. */
             eScale  = electrostaticScale / Units_Length_Angstroms_To_Bohrs ;
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            for ( r = 0 ; r < pairList->count ; r++ )
             {
-                q  = record->index ;
+                q  = pairList->indices[r] ;
                 /* . Displacements. */
                 MinimumImage_Displacements ( q, m ) ;
                 /* . MM atom. */
-       	        for ( n = 0, p = 0.0e+00 ; n < record->capacity ; n++ )
+       	        for ( n = 0, p = 0.0e+00 ; n < PairList_RecordCapacity ( pairList, r ) ; n++ )
 	        {
-	            m   = record->indices[n] ;
+	            m   = PairList_RecordPartners ( pairList, r )[n] ;
                     qM  = Array1D_Item ( chargesM, m ) ;
 	            Coordinates3_GetRow ( rDisplacements, m, xQM, yQM, zQM ) ;
                     r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
@@ -853,21 +1166,18 @@ void PairwiseInteractionSpline_QCQCGradients ( const PairwiseInteractionSpline *
     {
         if ( self->electrostaticSpline != NULL )
         {
-            auto Integer           i, j, n ;
+            auto Integer           i, j, n, r ;
             auto CubicSpline      *spline = self->electrostaticSpline ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
             auto Real              cutOff2 = self->cutOff2, eScale, g, gX, gY, gZ, qI, qIJ, r2, xI, xJ, xIJ, yI, yJ, yIJ, zI, zJ, zIJ ;
             eScale  = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            for ( r = 0 ; r < pairList->count ; r++ )
             {
-                i  = record->index ;
+                i  = pairList->indices[r] ;
                 qI = eScale * Array1D_Item ( charges, i ) ;
 	        Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
-       	        for ( n = 0, gX = gY = gZ = 0.0e+00 ; n < record->capacity ; n++ )
+       	        for ( n = pairList->offsets[r], gX = gY = gZ = 0.0e+00 ; n < pairList->offsets[r+1] ; n++ )
 	        {
-	            j   = record->indices[n] ;
+	            j   = pairList->partners[n] ;
                     qIJ = 2.0e+00 * qI * Array1D_Item ( charges, j ) ; /*. Note the extra factor of 2 here rather than later. */
 	            Coordinates3_GetRow ( coordinates3J, j, xJ, yJ, zJ ) ;
                     xIJ = xI - xJ ;
@@ -962,20 +1272,17 @@ void PairwiseInteractionSpline_QCQCPotentials ( const PairwiseInteractionSpline
     {
         if ( self->electrostaticSpline != NULL )
         {
-            auto Integer           i, j, n ;
+            auto Integer           i, j, n, r ;
             auto CubicSpline      *spline = self->electrostaticSpline ;
-            auto PairListIterator  iterator ;
-            auto PairRecord       *record ;
             auto Real              cutOff2 = self->cutOff2, eScale, f, r2, xI, xJ, xIJ, yI, yJ, yIJ, zI, zJ, zIJ ;
             eScale  = electrostaticScale / Units_Length_Angstroms_To_Bohrs ;
-            PairListIterator_Initialize ( &iterator, pairList ) ;
-            while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+            for ( r = 0 ; r < pairList->count ; r++ )
             {
-                i = record->index ;
+                i = pairList->indices[r] ;
 	        Coordinates3_GetRow ( coordinates3I, i, xI, yI, zI ) ;
-       	        for ( n = 0 ; n < record->capacity ; n++ )
+       	        for ( n = pairList->offsets[r] ; n < pairList->offsets[r+1] ; n++ )
 	        {
-	            j   = record->indices[n] ;
+	            j   = pairList->partners[n] ;
 	            Coordinates3_GetRow ( coordinates3J, j, xJ, yJ, zJ ) ;
                     xIJ = xI - xJ ;
                     yIJ = yI - yJ ;
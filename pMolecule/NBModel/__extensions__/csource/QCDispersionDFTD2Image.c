@@ -0,0 +1,62 @@
+/*==================================================================================================================================
+! . DFT-D2 QC dispersion interactions for images.
+!=================================================================================================================================*/
+
+# include "QCDispersionDFTD2.h"
+# include "QCDispersionDFTD2Image.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Image energy and gradients.
+! . The gradients are only calculated if both gradients3 and symmetryParameterGradients are present.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Real QCDispersionDFTD2Image_Energy ( const Real                        s6                         ,
+                                     const Real                        sR                         ,
+                                     const Real                        dR                         ,
+                                     const RealArray1D                *sqrtC6                     ,
+                                     const RealArray1D                *r0                         ,
+                                           Coordinates3               *coordinates3               ,
+                                           SymmetryParameters         *symmetryParameters         ,
+                                           ImagePairListContainer     *imagePairLists             ,
+                                           Coordinates3               *gradients3                 ,
+                                           SymmetryParameterGradients *symmetryParameterGradients ,
+                                           Status                     *status                     )
+{
+    Real energy = 0.0e+00 ;
+    if ( ( sqrtC6             != NULL ) &&
+         ( r0                 != NULL ) &&
+         ( coordinates3       != NULL ) &&
+         ( symmetryParameters != NULL ) &&
+         ( imagePairLists     != NULL ) &&
+         Status_IsOK ( status ) )
+    {
+        auto ImagePairListIterator iterator ;
+        ImagePairListIterator_Initialize ( &iterator                  ,
+                                           imagePairLists             ,
+                                           coordinates3               ,
+                                           symmetryParameters         ,
+                                           gradients3                 ,
+                                           symmetryParameterGradients ,
+                                           status                     ) ;
+        if ( Status_IsOK ( status ) )
+        {
+            while ( ImagePairListIterator_Next ( &iterator ) )
+            {
+                energy += QCDispersionDFTD2_EnergyPairList ( s6                     ,
+                                                             sR                     ,
+                                                             dR                     ,
+                                                             iterator.scale         ,
+                                                             sqrtC6                 ,
+                                                             r0                     ,
+                                                             coordinates3           ,
+                                                             iterator.iCoordinates3 ,
+                                                             iterator.pairList      ,
+                                                             gradients3             ,
+                                                             iterator.iGradients3   ,
+                                                             status                 ) ;
+                ImagePairListIterator_Gradients ( &iterator ) ;
+            }
+        }
+        ImagePairListIterator_Finalize ( &iterator ) ;
+    }
+    return energy ;
+}
@@ -0,0 +1,742 @@
+/*==================================================================================================================================
+! . Smooth particle-mesh Ewald electrostatics.
+!===================================================================================================================================
+!
+! . The reciprocal space sum is evaluated by spreading the charges onto a periodic grid in fractional space with cardinal
+!   B-splines, transforming, multiplying by the influence function and transforming back (U. Essmann et al., J. Chem. Phys.
+!   103, 8577, 1995).
+!
+! . Coordinates are in Angstroms, kappa in inverse Angstroms, energies in kJ mol^-1 and potentials in atomic units.
+!
+! . The symmetry parameter gradients are those at constant Cartesian coordinates so that the fractional terms are removed
+!   from the reciprocal space contribution (cf. SymmetryParameterGradients_FractionalDerivatives).
+!
+!=================================================================================================================================*/
+
+# include <math.h>
+# include <stdlib.h>
+
+# include "Memory.h"
+# include "NumericalMacros.h"
+# include "SPMEGrid.h"
+# include "Units.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The tolerance for zero B-spline moduli (these only occur for odd orders). */
+# define _ModulusTolerance 1.0e-7
+
+/* . The distance below which the limiting form of the pair correction is used. */
+# define _SmallDistance 1.0e-8
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local procedures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_BSplineModuli (       SPMEGrid           *self               ) ;
+static void SPMEGrid_BSplines      ( const Integer             order              ,
+                                     const Real                w                  ,
+                                           Real               *theta              ,
+                                           Real               *dTheta             ) ;
+static void SPMEGrid_Convolute     (       SPMEGrid           *self               ,
+                                     const SymmetryParameters *symmetryParameters ,
+                                     const Boolean             isCross            ,
+                                     const Boolean             doVirial           ,
+                                           Real               *energy             ,
+                                           Real               *virial             ) ;
+static void SPMEGrid_Gradients     ( const SPMEGrid           *self               ,
+                                     const Real               *grid               ,
+                                     const Real                scale              ,
+                                     const RealArray1D        *charges            ,
+                                     const Coordinates3       *coordinates3       ,
+                                     const Matrix33           *inverseH           ,
+                                           Coordinates3       *gradients3         ,
+                                           Matrix33           *dEdH               ) ;
+static void SPMEGrid_PointSplines  ( const SPMEGrid           *self               ,
+                                     const Matrix33           *inverseH           ,
+                                     const Real                x                  ,
+                                     const Real                y                  ,
+                                     const Real                z                  ,
+                                           Integer            *indices            ,
+                                           Real               *theta              ,
+                                           Real               *dTheta             ) ;
+static void SPMEGrid_Spread        (       SPMEGrid           *self               ,
+                                           Real               *grid               ,
+                                     const RealArray1D        *charges            ,
+                                     const Coordinates3       *coordinates3       ,
+                                     const Matrix33           *inverseH           ) ;
+static void SPMEGrid_Virial        ( const SymmetryParameters *symmetryParameters ,
+                                     const Real                scale              ,
+                                     const Real                energy             ,
+                                     const Real               *virial             ,
+                                           Matrix33           *dEdH               ) ;
+
+/*==================================================================================================================================
+! . Public procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The reciprocal space and background energy between two different sets of charges.
+! . The gradients of a set are calculated if the corresponding gradients array is present. The symmetry parameter gradients
+!   require both.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Real SPMEGrid_CrossEnergy (       SPMEGrid                   *self                       ,
+                            const Real                        electrostaticScale         ,
+                            const RealArray1D                *chargesA                   ,
+                            const RealArray1D                *chargesB                   ,
+                            const Coordinates3               *coordinates3A              ,
+                            const Coordinates3               *coordinates3B              ,
+                            const SymmetryParameters         *symmetryParameters         ,
+                                  Coordinates3               *gradients3A                ,
+                                  Coordinates3               *gradients3B                ,
+                                  SymmetryParameterGradients *symmetryParameterGradients ,
+                                  Status                     *status                     )
+{
+    Real energy = 0.0e+00 ;
+    if ( ( self               != NULL ) &&
+         ( chargesA           != NULL ) &&
+         ( chargesB           != NULL ) &&
+         ( coordinates3A      != NULL ) &&
+         ( coordinates3B      != NULL ) &&
+         ( symmetryParameters != NULL ) &&
+         Status_IsOK ( status ) )
+    {
+        if ( (   View1D_Extent ( chargesA ) != Coordinates3_Rows ( coordinates3A ) ) ||
+             (   View1D_Extent ( chargesB ) != Coordinates3_Rows ( coordinates3B ) ) ||
+             ( ( gradients3A != NULL ) && ( Coordinates3_Rows ( gradients3A ) != Coordinates3_Rows ( coordinates3A ) ) ) ||
+             ( ( gradients3B != NULL ) && ( Coordinates3_Rows ( gradients3B ) != Coordinates3_Rows ( coordinates3B ) ) ) )
+            Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Boolean doVirial = ( gradients3A != NULL ) && ( gradients3B != NULL ) && ( symmetryParameterGradients != NULL ) ;
+            auto Real    eBackground, eReciprocal, eScale, virial[6] ;
+            eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+            SPMEGrid_Spread ( self, self->gridA, chargesA, coordinates3A, symmetryParameters->inverseH ) ;
+            SPMEGrid_Spread ( self, self->gridB, chargesB, coordinates3B, symmetryParameters->inverseH ) ;
+            FFT3D_Transform ( self->fft, self->gridA, True, status ) ;
+            FFT3D_Transform ( self->fft, self->gridB, True, status ) ;
+            if ( Status_IsOK ( status ) )
+            {
+                SPMEGrid_Convolute ( self, symmetryParameters, True, doVirial, &eReciprocal, virial ) ;
+                eBackground = - M_PI * RealArray1D_Sum ( chargesA ) * RealArray1D_Sum ( chargesB ) /
+                                ( SymmetryParameters_Volume ( symmetryParameters ) * self->kappa * self->kappa ) ;
+                energy      = eScale * ( eReciprocal + eBackground ) ;
+                if ( gradients3A != NULL )
+                {
+                    FFT3D_Transform    ( self->fft, self->gridA, False, status ) ;
+                    SPMEGrid_Gradients ( self, self->gridA, eScale, chargesA, coordinates3A, symmetryParameters->inverseH, gradients3A,
+                                         ( doVirial ? symmetryParameterGradients->dEdH : NULL ) ) ;
+                }
+                if ( gradients3B != NULL )
+                {
+                    FFT3D_Transform    ( self->fft, self->gridB, False, status ) ;
+                    SPMEGrid_Gradients ( self, self->gridB, eScale, chargesB, coordinates3B, symmetryParameters->inverseH, gradients3B,
+                                         ( doVirial ? symmetryParameterGradients->dEdH : NULL ) ) ;
+                }
+                if ( doVirial ) SPMEGrid_Virial ( symmetryParameters, eScale, eReciprocal + eBackground, virial, symmetryParameterGradients->dEdH ) ;
+            }
+        }
+    }
+    return energy ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void SPMEGrid_Deallocate ( SPMEGrid **self )
+{
+    if ( (*self) != NULL )
+    {
+        FFT3D_Deallocate       ( &((*self)->fft ) ) ;
+        RegularGrid_Deallocate ( &((*self)->grid) ) ;
+        Memory_Deallocate      (   (*self)->bModuli ) ;
+        Memory_Deallocate      (   (*self)->gridA   ) ;
+        Memory_Deallocate      (   (*self)->gridB   ) ;
+        Memory_Deallocate      (   (*self)          ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The reciprocal space, self and background energy of a set of charges.
+! . The symmetry parameter gradients are only calculated if the gradients are present.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Real SPMEGrid_Energy (       SPMEGrid                   *self                       ,
+                       const Real                        electrostaticScale         ,
+                       const RealArray1D                *charges                    ,
+                       const Coordinates3               *coordinates3               ,
+                       const SymmetryParameters         *symmetryParameters         ,
+                             Coordinates3               *gradients3                 ,
+                             SymmetryParameterGradients *symmetryParameterGradients ,
+                             Status                     *status                     )
+{
+    Real energy = 0.0e+00 ;
+    if ( ( self               != NULL ) &&
+         ( charges            != NULL ) &&
+         ( coordinates3       != NULL ) &&
+         ( symmetryParameters != NULL ) &&
+         Status_IsOK ( status ) )
+    {
+        if ( (   View1D_Extent ( charges ) != Coordinates3_Rows ( coordinates3 ) ) ||
+             ( ( gradients3 != NULL ) && ( Coordinates3_Rows ( gradients3 ) != Coordinates3_Rows ( coordinates3 ) ) ) )
+            Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Boolean doVirial = ( gradients3 != NULL ) && ( symmetryParameterGradients != NULL ) ;
+            auto Real    eBackground, eReciprocal, eScale, eSelf, q, virial[6] ;
+            eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+            SPMEGrid_Spread ( self, self->gridA, charges, coordinates3, symmetryParameters->inverseH ) ;
+            FFT3D_Transform ( self->fft, self->gridA, True, status ) ;
+            if ( Status_IsOK ( status ) )
+            {
+                SPMEGrid_Convolute ( self, symmetryParameters, False, doVirial, &eReciprocal, virial ) ;
+                q           = RealArray1D_Sum ( charges ) ;
+                eBackground = - 0.5e+00 * M_PI * q * q / ( SymmetryParameters_Volume ( symmetryParameters ) * self->kappa * self->kappa ) ;
+                eSelf       = - self->kappa * RealArray1D_Dot ( charges, charges, NULL ) / sqrt ( M_PI ) ;
+                energy      = eScale * ( eReciprocal + eSelf + eBackground ) ;
+                if ( gradients3 != NULL )
+                {
+                    FFT3D_Transform    ( self->fft, self->gridA, False, status ) ;
+                    SPMEGrid_Gradients ( self, self->gridA, eScale, charges, coordinates3, symmetryParameters->inverseH, gradients3,
+                                         ( doVirial ? symmetryParameterGradients->dEdH : NULL ) ) ;
+                    if ( doVirial ) SPMEGrid_Virial ( symmetryParameters, eScale, eReciprocal + eBackground, virial, symmetryParameterGradients->dEdH ) ;
+                }
+            }
+        }
+    }
+    return energy ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The number of grid points along each dimension for a set of symmetry parameters and an approximate grid spacing.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void SPMEGrid_Extents ( const SymmetryParameters *symmetryParameters ,
+                        const Real                gridSpacing        ,
+                        const Integer             order              ,
+                              Integer            *extents            )
+{
+    if ( ( symmetryParameters != NULL ) && ( gridSpacing > 0.0e+00 ) && ( extents != NULL ) )
+    {
+        auto Integer d ;
+        auto Real    length ;
+        for ( d = 0 ; d < 3 ; d++ )
+        {
+            length     = sqrt ( Matrix33_Item ( symmetryParameters->H, 0, d ) * Matrix33_Item ( symmetryParameters->H, 0, d ) +
+                                Matrix33_Item ( symmetryParameters->H, 1, d ) * Matrix33_Item ( symmetryParameters->H, 1, d ) +
+                                Matrix33_Item ( symmetryParameters->H, 2, d ) * Matrix33_Item ( symmetryParameters->H, 2, d ) ) ;
+            extents[d] = FFT3D_GoodLength ( Maximum ( ( Integer ) ceil ( length / gridSpacing ), 2 * order ) ) ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Constructor given symmetry parameters and an approximate grid spacing.
+! . The number of points along each dimension is chosen to be efficient for the transform.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+SPMEGrid *SPMEGrid_FromSymmetryParameters ( const SymmetryParameters *symmetryParameters ,
+                                            const Real                gridSpacing        ,
+                                            const Integer             order              ,
+                                            const Real                kappa              ,
+                                                  Status             *status             )
+{
+    SPMEGrid *self = NULL ;
+    if ( ( symmetryParameters != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( gridSpacing <= 0.0e+00                ) ||
+             ( kappa       <= 0.0e+00                ) ||
+             ( order       <  SPMEGrid_MinimumOrder  ) ||
+             ( order       >  SPMEGrid_MaximumOrder  ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            self = Memory_AllocateType ( SPMEGrid ) ;
+            if ( self != NULL )
+            {
+                auto Integer d, extents[3], stride, total = 0 ;
+                SPMEGrid_Extents ( symmetryParameters, gridSpacing, order, extents ) ;
+                self->order   = order ;
+                self->kappa   = kappa ;
+                self->bModuli = NULL  ;
+                self->gridA   = NULL  ;
+                self->gridB   = NULL  ;
+                self->fft     = NULL  ;
+                self->grid    = RegularGrid_Allocate ( 3, status ) ;
+                if ( self->grid != NULL )
+                {
+                    for ( d = 0 ; d < 3 ; d++ )
+                    {
+                        self->grid->dimensions[d].bins          = extents[d] ;
+                        self->grid->dimensions[d].binSize       = 1.0e+00 / ( Real ) extents[d] ;
+                        self->grid->dimensions[d].isPeriodic    = True ;
+                        self->grid->dimensions[d].lower         = 0.0e+00 ;
+                        self->grid->dimensions[d].midPointLower = 0.5e+00 * self->grid->dimensions[d].binSize ;
+                        self->grid->dimensions[d].period        = 1.0e+00 ;
+                        self->grid->dimensions[d].upper         = 1.0e+00 ;
+                        total += extents[d] ;
+                    }
+                    for ( d = 2, stride = 1 ; d >= 0 ; d-- ) { self->grid->dimensions[d].stride = stride ; stride *= extents[d] ; }
+                    self->fft = FFT3D_Allocate ( extents, status ) ;
+                    if ( self->fft != NULL )
+                    {
+                        self->bModuli = Memory_AllocateArrayOfTypes ( total                , Real ) ;
+                        self->gridA   = Memory_AllocateArrayOfTypes ( 2 * self->fft->size, Real ) ;
+                        self->gridB   = Memory_AllocateArrayOfTypes ( 2 * self->fft->size, Real ) ;
+                    }
+                }
+                if ( ( self->bModuli == NULL ) || ( self->gridA == NULL ) || ( self->gridB == NULL ) )
+                {
+                    SPMEGrid_Deallocate ( &self ) ;
+                    Status_Set ( status, Status_OutOfMemory ) ;
+                }
+                else SPMEGrid_BSplineModuli ( self ) ;
+            }
+            else Status_Set ( status, Status_OutOfMemory ) ;
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The energy of the erf ( kappa r ) / r interactions between pairs of charges.
+! . This is used to remove the reciprocal space interactions of excluded and scaled pairs.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Real SPMEGrid_PairCorrection ( const SPMEGrid     *self               ,
+                               const Real          electrostaticScale ,
+                               const RealArray1D  *charges            ,
+                               const Coordinates3 *coordinates3       ,
+                                     PairList     *pairList           ,
+                                     Coordinates3 *gradients3         ,
+                                     Status       *status             )
+{
+    Real energy = 0.0e+00 ;
+    if ( ( self         != NULL ) &&
+         ( charges      != NULL ) &&
+         ( coordinates3 != NULL ) &&
+         ( pairList     != NULL ) &&
+         Status_IsOK ( status ) )
+    {
+        auto Integer           i, j, n ;
+        auto PairListIterator  iterator ;
+        auto PairRecord       *record ;
+        auto Real              eScale, f, g, kappa = self->kappa, qI, qIJ, r, r2, xI, xIJ, yI, yIJ, zI, zIJ ;
+        eScale = electrostaticScale * Units_Energy_E2Angstroms_To_Kilojoules_Per_Mole ;
+        PairListIterator_Initialize ( &iterator, pairList ) ;
+        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        {
+            i  = record->index ;
+            qI = eScale * Array1D_Item ( charges, i ) ;
+            Coordinates3_GetRow ( coordinates3, i, xI, yI, zI ) ;
+            for ( n = 0 ; n < record->capacity ; n++ )
+            {
+                j   = record->indices[n] ;
+                qIJ = qI * Array1D_Item ( charges, j ) ;
+                xIJ = xI - Coordinates3_Item ( coordinates3, j, 0 ) ;
+                yIJ = yI - Coordinates3_Item ( coordinates3, j, 1 ) ;
+                zIJ = zI - Coordinates3_Item ( coordinates3, j, 2 ) ;
+                r2  = xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ;
+                r   = sqrt ( r2 ) ;
+                if ( r < _SmallDistance )
+                {
+                    f = 2.0e+00 * kappa / sqrt ( M_PI ) ;
+                    g = 0.0e+00 ;
+                }
+                else
+                {
+                    f = erf ( kappa * r ) / r ;
+                    g = ( 2.0e+00 * kappa * exp ( - kappa * kappa * r2 ) / sqrt ( M_PI ) - f ) / r2 ;
+                }
+                energy += qIJ * f ;
+                if ( gradients3 != NULL )
+                {
+                    g   *= qIJ ;
+                    xIJ *= g   ;
+                    yIJ *= g   ;
+                    zIJ *= g   ;
+                    Coordinates3_IncrementRow ( gradients3, i, xIJ, yIJ, zIJ ) ;
+                    Coordinates3_DecrementRow ( gradients3, j, xIJ, yIJ, zIJ ) ;
+                }
+            }
+        }
+    }
+    return energy ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The reciprocal space and background potentials at a set of points due to a set of charges.
+! . The potentials are incremented.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void SPMEGrid_Potentials (       SPMEGrid           *self               ,
+                           const Real                electrostaticScale ,
+                           const RealArray1D        *charges            ,
+                           const Coordinates3       *coordinates3       ,
+                           const Coordinates3       *pointCoordinates3  ,
+                           const SymmetryParameters *symmetryParameters ,
+                                 RealArray1D        *potentials         ,
+                                 Status             *status             )
+{
+    if ( ( self               != NULL ) &&
+         ( charges            != NULL ) &&
+         ( coordinates3       != NULL ) &&
+         ( pointCoordinates3  != NULL ) &&
+         ( symmetryParameters != NULL ) &&
+         ( potentials         != NULL ) &&
+         Status_IsOK ( status ) )
+    {
+        if ( ( View1D_Extent ( charges    ) != Coordinates3_Rows ( coordinates3      ) ) ||
+             ( View1D_Extent ( potentials ) <  Coordinates3_Rows ( pointCoordinates3 ) ) )
+            Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Integer i ;
+            auto Real    eReciprocal, pScale, shift ;
+            pScale = electrostaticScale / Units_Length_Angstroms_To_Bohrs ;
+            SPMEGrid_Spread ( self, self->gridA, charges, coordinates3, symmetryParameters->inverseH ) ;
+            FFT3D_Transform ( self->fft, self->gridA, True, status ) ;
+            if ( Status_IsOK ( status ) )
+            {
+                SPMEGrid_Convolute ( self, symmetryParameters, False, False, &eReciprocal, NULL ) ;
+                FFT3D_Transform    ( self->fft, self->gridA, False, status ) ;
+                shift = - M_PI * RealArray1D_Sum ( charges ) / ( SymmetryParameters_Volume ( symmetryParameters ) * self->kappa * self->kappa ) ;
+# ifdef USEOPENMP
+                #pragma omp parallel for schedule(static)
+# endif
+                for ( i = 0 ; i < Coordinates3_Rows ( pointCoordinates3 ) ; i++ )
+                {
+                    auto Integer c, i0, i1, i2, indices[3*SPMEGrid_MaximumOrder], n = self->order ;
+                    auto Real    phi = 0.0e+00, t01, theta[3*SPMEGrid_MaximumOrder], x, y, z ;
+                    Coordinates3_GetRow   ( pointCoordinates3, i, x, y, z ) ;
+                    SPMEGrid_PointSplines ( self, symmetryParameters->inverseH, x, y, z, indices, theta, NULL ) ;
+                    for ( i0 = 0 ; i0 < n ; i0++ )
+                    {
+                        for ( i1 = 0 ; i1 < n ; i1++ )
+                        {
+                            c   = indices[i0] + indices[n+i1] ;
+                            t01 = theta[i0] * theta[n+i1] ;
+                            for ( i2 = 0 ; i2 < n ; i2++ ) phi += t01 * theta[2*n+i2] * self->gridA[2*(c+indices[2*n+i2])] ;
+                        }
+                    }
+                    Array1D_Item ( potentials, i ) += pScale * ( phi + shift ) ;
+                }
+            }
+        }
+    }
+}
+
+/*==================================================================================================================================
+! . Private procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The inverse squared moduli of the B-spline structure factors for each dimension.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_BSplineModuli ( SPMEGrid *self )
+{
+    Integer  d, k, m, n, order = self->order ;
+    Real     arg, c, *moduli, s, theta[SPMEGrid_MaximumOrder] ;
+    /* . Spline values at the integers, M(k+1) = theta[order-2-k]. */
+    SPMEGrid_BSplines ( order, 0.0e+00, theta, NULL ) ;
+    for ( d = 0, moduli = self->bModuli ; d < 3 ; moduli += n, d++ )
+    {
+        n = self->grid->dimensions[d].bins ;
+        for ( m = 0 ; m < n ; m++ )
+        {
+            c = s = 0.0e+00 ;
+            for ( k = 0 ; k < order - 1 ; k++ )
+            {
+                arg = 2.0e+00 * M_PI * ( Real ) ( m * k ) / ( Real ) n ;
+                c  += theta[order-2-k] * cos ( arg ) ;
+                s  += theta[order-2-k] * sin ( arg ) ;
+            }
+            moduli[m] = c * c + s * s ;
+        }
+        for ( m = 0 ; m < n ; m++ )
+        {
+            if ( moduli[m] < _ModulusTolerance ) moduli[m] = 0.5e+00 * ( moduli[(m-1+n)%n] + moduli[(m+1)%n] ) ;
+        }
+        for ( m = 0 ; m < n ; m++ ) moduli[m] = 1.0e+00 / moduli[m] ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The B-spline values and derivatives at w + order - 1 - j ( j = 0, order - 1 ) where 0 <= w < 1.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_BSplines ( const Integer order, const Real w, Real *theta, Real *dTheta )
+{
+    Integer j, k ;
+    Real    f ;
+    /* . Linear splines. */
+    theta[order-1] = 0.0e+00 ;
+    theta[1]       = w ;
+    theta[0]       = 1.0e+00 - w ;
+    /* . Recursion up to order - 1. */
+    for ( k = 3 ; k < order ; k++ )
+    {
+        f          = 1.0e+00 / ( Real ) ( k - 1 ) ;
+        theta[k-1] = f * w * theta[k-2] ;
+        for ( j = 1 ; j < k - 1 ; j++ ) theta[k-j-1] = f * ( ( w + ( Real ) j ) * theta[k-j-2] + ( ( Real ) ( k - j ) - w ) * theta[k-j-1] ) ;
+        theta[0] = f * ( 1.0e+00 - w ) * theta[0] ;
+    }
+    /* . Derivatives. */
+    if ( dTheta != NULL )
+    {
+        dTheta[0] = - theta[0] ;
+        for ( j = 1 ; j < order ; j++ ) dTheta[j] = theta[j-1] - theta[j] ;
+    }
+    /* . Final recursion. */
+    f                = 1.0e+00 / ( Real ) ( order - 1 ) ;
+    theta[order-1] = f * w * theta[order-2] ;
+    for ( j = 1 ; j < order - 1 ; j++ ) theta[order-j-1] = f * ( ( w + ( Real ) j ) * theta[order-j-2] + ( ( Real ) ( order - j ) - w ) * theta[order-j-1] ) ;
+    theta[0] = f * ( 1.0e+00 - w ) * theta[0] ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Multiplication of the transformed grids by the influence function.
+! . For a single set of charges the grid is replaced by its product with the influence function whereas for two sets the
+!   grids are exchanged before multiplication.
+! . The virial terms are sum_m 2 E_m ( pi^2 / kappa^2 + 1 / m^2 ) m_a m_b in the order 00, 01, 02, 11, 12 and 22.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_Convolute (       SPMEGrid           *self               ,
+                                 const SymmetryParameters *symmetryParameters ,
+                                 const Boolean             isCross            ,
+                                 const Boolean             doVirial           ,
+                                       Real               *energy             ,
+                                       Real               *virial             )
+{
+    Integer   m0, n0, n1, n2, s0, s1 ;
+    Real      e = 0.0e+00, factor, iH00, iH01, iH02, iH10, iH11, iH12, iH20, iH21, iH22,
+              p00 = 0.0e+00, p01 = 0.0e+00, p02 = 0.0e+00, p11 = 0.0e+00, p12 = 0.0e+00, p22 = 0.0e+00, *b0, *b1, *b2, vFactor ;
+    n0      = self->grid->dimensions[0].bins   ;
+    n1      = self->grid->dimensions[1].bins   ;
+    n2      = self->grid->dimensions[2].bins   ;
+    s0      = self->grid->dimensions[0].stride ;
+    s1      = self->grid->dimensions[1].stride ;
+    b0      = self->bModuli ;
+    b1      = &b0[n0] ;
+    b2      = &b1[n1] ;
+    factor  = M_PI * M_PI / ( self->kappa * self->kappa ) ;
+    vFactor = 1.0e+00 / ( M_PI * SymmetryParameters_Volume ( symmetryParameters ) ) ;
+    iH00    = Matrix33_Item ( symmetryParameters->inverseH, 0, 0 ) ;
+    iH01    = Matrix33_Item ( symmetryParameters->inverseH, 0, 1 ) ;
+    iH02    = Matrix33_Item ( symmetryParameters->inverseH, 0, 2 ) ;
+    iH10    = Matrix33_Item ( symmetryParameters->inverseH, 1, 0 ) ;
+    iH11    = Matrix33_Item ( symmetryParameters->inverseH, 1, 1 ) ;
+    iH12    = Matrix33_Item ( symmetryParameters->inverseH, 1, 2 ) ;
+    iH20    = Matrix33_Item ( symmetryParameters->inverseH, 2, 0 ) ;
+    iH21    = Matrix33_Item ( symmetryParameters->inverseH, 2, 1 ) ;
+    iH22    = Matrix33_Item ( symmetryParameters->inverseH, 2, 2 ) ;
+# ifdef USEOPENMP
+    #pragma omp parallel for reduction(+:e,p00,p01,p02,p11,p12,p22) schedule(static)
+# endif
+    for ( m0 = 0 ; m0 < n0 ; m0++ )
+    {
+        auto Integer c, m1, m2 ;
+        auto Real    aI, aR, bI, bR, eM, g, h0, h1, h2, mm, mx, my, mz, w ;
+        h0 = ( Real ) ( ( m0 <= n0 / 2 ) ? m0 : m0 - n0 ) ;
+        for ( m1 = 0 ; m1 < n1 ; m1++ )
+        {
+            h1 = ( Real ) ( ( m1 <= n1 / 2 ) ? m1 : m1 - n1 ) ;
+            for ( m2 = 0 ; m2 < n2 ; m2++ )
+            {
+                c  = 2 * ( m0 * s0 + m1 * s1 + m2 ) ;
+                aR = self->gridA[c  ] ;
+                aI = self->gridA[c+1] ;
+                if ( ( m0 == 0 ) && ( m1 == 0 ) && ( m2 == 0 ) )
+                {
+                    self->gridA[c] = self->gridA[c+1] = 0.0e+00 ;
+                    if ( isCross ) self->gridB[c] = self->gridB[c+1] = 0.0e+00 ;
+                    continue ;
+                }
+                h2 = ( Real ) ( ( m2 <= n2 / 2 ) ? m2 : m2 - n2 ) ;
+                mx = h0 * iH00 + h1 * iH10 + h2 * iH20 ;
+                my = h0 * iH01 + h1 * iH11 + h2 * iH21 ;
+                mz = h0 * iH02 + h1 * iH12 + h2 * iH22 ;
+                mm = mx * mx + my * my + mz * mz ;
+                g  = vFactor * b0[m0] * b1[m1] * b2[m2] * exp ( - factor * mm ) / mm ;
+                if ( isCross )
+                {
+                    bR = self->gridB[c  ] ;
+                    bI = self->gridB[c+1] ;
+                    eM = g * ( aR * bR + aI * bI ) ;
+                    self->gridA[c  ] = g * bR ;
+                    self->gridA[c+1] = g * bI ;
+                    self->gridB[c  ] = g * aR ;
+                    self->gridB[c+1] = g * aI ;
+                }
+                else
+                {
+                    eM = 0.5e+00 * g * ( aR * aR + aI * aI ) ;
+                    self->gridA[c  ] = g * aR ;
+                    self->gridA[c+1] = g * aI ;
+                }
+                e += eM ;
+                if ( doVirial )
+                {
+                    w    = 2.0e+00 * eM * ( factor + 1.0e+00 / mm ) ;
+                    p00 += w * mx * mx ;
+                    p01 += w * mx * my ;
+                    p02 += w * mx * mz ;
+                    p11 += w * my * my ;
+                    p12 += w * my * mz ;
+                    p22 += w * mz * mz ;
+                }
+            }
+        }
+    }
+    (*energy) = e ;
+    if ( doVirial )
+    {
+        virial[0] = p00 ; virial[1] = p01 ; virial[2] = p02 ;
+        virial[3] = p11 ; virial[4] = p12 ; virial[5] = p22 ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Gradients from a back-transformed grid.
+! . If dEdH is present, the fractional terms, sum_i g_ia f_ib, are removed.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_Gradients ( const SPMEGrid     *self         ,
+                                 const Real         *grid         ,
+                                 const Real          scale        ,
+                                 const RealArray1D  *charges      ,
+                                 const Coordinates3 *coordinates3 ,
+                                 const Matrix33     *inverseH     ,
+                                       Coordinates3 *gradients3   ,
+                                       Matrix33     *dEdH         )
+{
+    Integer i ;
+    Real    k0, k1, k2, w00 = 0.0e+00, w01 = 0.0e+00, w02 = 0.0e+00, w10 = 0.0e+00, w11 = 0.0e+00, w12 = 0.0e+00,
+                        w20 = 0.0e+00, w21 = 0.0e+00, w22 = 0.0e+00 ;
+    k0 = ( Real ) self->grid->dimensions[0].bins ;
+    k1 = ( Real ) self->grid->dimensions[1].bins ;
+    k2 = ( Real ) self->grid->dimensions[2].bins ;
+# ifdef USEOPENMP
+    #pragma omp parallel for reduction(+:w00,w01,w02,w10,w11,w12,w20,w21,w22) schedule(dynamic)
+# endif
+    for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
+    {
+        auto Integer c, i0, i1, i2, indices[3*SPMEGrid_MaximumOrder], n = self->order ;
+        auto Real    dTheta[3*SPMEGrid_MaximumOrder], fx, fy, fz, g0, g1, g2, gx, gy, gz, q, t0, t1, t2, td0, td1,
+                     theta[3*SPMEGrid_MaximumOrder], v, x, y, z ;
+        q = Array1D_Item ( charges, i ) ;
+        if ( q == 0.0e+00 ) continue ;
+        Coordinates3_GetRow   ( coordinates3, i, x, y, z ) ;
+        SPMEGrid_PointSplines ( self, inverseH, x, y, z, indices, theta, dTheta ) ;
+        g0 = g1 = g2 = 0.0e+00 ;
+        for ( i0 = 0 ; i0 < n ; i0++ )
+        {
+            t0  = theta [i0] ;
+            td0 = dTheta[i0] ;
+            for ( i1 = 0 ; i1 < n ; i1++ )
+            {
+                t1  = theta [n+i1] ;
+                td1 = dTheta[n+i1] ;
+                c   = indices[i0] + indices[n+i1] ;
+                for ( i2 = 0 ; i2 < n ; i2++ )
+                {
+                    t2  = theta[2*n+i2] ;
+                    v   = grid[2*(c+indices[2*n+i2])] ;
+                    g0 += td0 * t1  * t2 * v ;
+                    g1 += t0  * td1 * t2 * v ;
+                    g2 += t0  * t1  * dTheta[2*n+i2] * v ;
+                }
+            }
+        }
+        q  *= scale ;
+        g0 *= ( q * k0 ) ;
+        g1 *= ( q * k1 ) ;
+        g2 *= ( q * k2 ) ;
+        gx  = g0 * Matrix33_Item ( inverseH, 0, 0 ) + g1 * Matrix33_Item ( inverseH, 1, 0 ) + g2 * Matrix33_Item ( inverseH, 2, 0 ) ;
+        gy  = g0 * Matrix33_Item ( inverseH, 0, 1 ) + g1 * Matrix33_Item ( inverseH, 1, 1 ) + g2 * Matrix33_Item ( inverseH, 2, 1 ) ;
+        gz  = g0 * Matrix33_Item ( inverseH, 0, 2 ) + g1 * Matrix33_Item ( inverseH, 1, 2 ) + g2 * Matrix33_Item ( inverseH, 2, 2 ) ;
+        Coordinates3_IncrementRow ( gradients3, i, gx, gy, gz ) ;
+        if ( dEdH != NULL )
+        {
+            fx   = Matrix33_Item ( inverseH, 0, 0 ) * x + Matrix33_Item ( inverseH, 0, 1 ) * y + Matrix33_Item ( inverseH, 0, 2 ) * z ;
+            fy   = Matrix33_Item ( inverseH, 1, 0 ) * x + Matrix33_Item ( inverseH, 1, 1 ) * y + Matrix33_Item ( inverseH, 1, 2 ) * z ;
+            fz   = Matrix33_Item ( inverseH, 2, 0 ) * x + Matrix33_Item ( inverseH, 2, 1 ) * y + Matrix33_Item ( inverseH, 2, 2 ) * z ;
+            w00 += gx * fx ; w01 += gx * fy ; w02 += gx * fz ;
+            w10 += gy * fx ; w11 += gy * fy ; w12 += gy * fz ;
+            w20 += gz * fx ; w21 += gz * fy ; w22 += gz * fz ;
+        }
+    }
+    if ( dEdH != NULL )
+    {
+        Matrix33_Item ( dEdH, 0, 0 ) -= w00 ; Matrix33_Item ( dEdH, 0, 1 ) -= w01 ; Matrix33_Item ( dEdH, 0, 2 ) -= w02 ;
+        Matrix33_Item ( dEdH, 1, 0 ) -= w10 ; Matrix33_Item ( dEdH, 1, 1 ) -= w11 ; Matrix33_Item ( dEdH, 1, 2 ) -= w12 ;
+        Matrix33_Item ( dEdH, 2, 0 ) -= w20 ; Matrix33_Item ( dEdH, 2, 1 ) -= w21 ; Matrix33_Item ( dEdH, 2, 2 ) -= w22 ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The grid indices (multiplied by the strides) and splines for a point.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_PointSplines ( const SPMEGrid *self, const Matrix33 *inverseH, const Real x, const Real y, const Real z,
+                                    Integer *indices, Real *theta, Real *dTheta )
+{
+    Integer d, j, k, n, order = self->order, stride ;
+    Real    f, u ;
+    for ( d = 0 ; d < 3 ; d++ )
+    {
+        n      = self->grid->dimensions[d].bins   ;
+        stride = self->grid->dimensions[d].stride ;
+        f      = Matrix33_Item ( inverseH, d, 0 ) * x + Matrix33_Item ( inverseH, d, 1 ) * y + Matrix33_Item ( inverseH, d, 2 ) * z ;
+        u      = ( Real ) n * ( f - floor ( f ) ) ;
+        k      = ( Integer ) floor ( u ) ;
+        SPMEGrid_BSplines ( order, u - ( Real ) k, &theta[d*order], ( ( dTheta == NULL ) ? NULL : &dTheta[d*order] ) ) ;
+        k += ( n - order + 1 ) ;
+        for ( j = 0 ; j < order ; j++ ) indices[d*order+j] = ( ( k + j ) % n ) * stride ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Spread charges onto a grid.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_Spread (       SPMEGrid     *self         ,
+                                    Real         *grid         ,
+                              const RealArray1D  *charges      ,
+                              const Coordinates3 *coordinates3 ,
+                              const Matrix33     *inverseH     )
+{
+    Integer c, i, i0, i1, i2, indices[3*SPMEGrid_MaximumOrder], n = self->order ;
+    Real    q, q0, q01, theta[3*SPMEGrid_MaximumOrder], x, y, z ;
+    for ( i = 0 ; i < 2 * self->fft->size ; i++ ) grid[i] = 0.0e+00 ;
+    for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
+    {
+        q = Array1D_Item ( charges, i ) ;
+        if ( q == 0.0e+00 ) continue ;
+        Coordinates3_GetRow   ( coordinates3, i, x, y, z ) ;
+        SPMEGrid_PointSplines ( self, inverseH, x, y, z, indices, theta, NULL ) ;
+        for ( i0 = 0 ; i0 < n ; i0++ )
+        {
+            q0 = q * theta[i0] ;
+            for ( i1 = 0 ; i1 < n ; i1++ )
+            {
+                c   = indices[i0] + indices[n+i1] ;
+                q01 = q0 * theta[n+i1] ;
+                for ( i2 = 0 ; i2 < n ; i2++ ) grid[2*(c+indices[2*n+i2])] += q01 * theta[2*n+i2] ;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The reciprocal space and background derivatives with respect to H at constant fractional coordinates.
+! . dE/dH_ab = - E ( H^-T )_ab + sum_c P_ac ( H^-1 )_bc.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void SPMEGrid_Virial ( const SymmetryParameters *symmetryParameters ,
+                              const Real                scale              ,
+                              const Real                energy             ,
+                              const Real               *virial             ,
+                                    Matrix33           *dEdH               )
+{
+    Integer a, b, c ;
+    Real    p[3][3], sum ;
+    p[0][0] = virial[0] ; p[0][1] = virial[1] ; p[0][2] = virial[2] ;
+    p[1][0] = virial[1] ; p[1][1] = virial[3] ; p[1][2] = virial[4] ;
+    p[2][0] = virial[2] ; p[2][1] = virial[4] ; p[2][2] = virial[5] ;
+    for ( a = 0 ; a < 3 ; a++ )
+    {
+        for ( b = 0 ; b < 3 ; b++ )
+        {
+            sum = - energy * Matrix33_Item ( symmetryParameters->inverseH, b, a ) ;
+            for ( c = 0 ; c < 3 ; c++ ) sum += p[a][c] * Matrix33_Item ( symmetryParameters->inverseH, b, c ) ;
+            Matrix33_Item ( dEdH, a, b ) += scale * sum ;
+        }
+    }
+}
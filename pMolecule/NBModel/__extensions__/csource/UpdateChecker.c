@@ -150,6 +150,35 @@ Boolean UpdateChecker_CheckForUpdate  ( const Coordinates3 *set1
     return doUpdate ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Update the reference coordinates of the particles that have moved by more than half the buffer distance.
+! . This is used with incremental pair-lists whose reference coordinates are kept per particle.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void UpdateChecker_UpdateMovedReferences ( const Coordinates3 *set1      ,
+                                                 Coordinates3 *set2      ,
+                                                 Selection    *freeAtoms ,
+                                           const Real          buffer    )
+{
+    if ( ( set1 != NULL ) && ( set2 != NULL ) )
+    {
+        auto Integer  i, n, s ;
+        auto Real     buffer2, dX, dY, dZ, r2, x1, x2, y1, y2, z1, z2 ;
+        buffer2 = 0.25e+00 * buffer * buffer ;
+        n       = ( freeAtoms == NULL ) ? Coordinates3_Rows ( set1 ) : Selection_Capacity ( freeAtoms ) ;
+        for ( s = 0 ; s < n ; s++ )
+        {
+            i = ( freeAtoms == NULL ) ? s : Selection_Item ( freeAtoms, s ) ;
+            Coordinates3_GetRow ( set1, i, x1, y1, z1 ) ;
+            Coordinates3_GetRow ( set2, i, x2, y2, z2 ) ;
+            dX = x1 - x2 ;
+            dY = y1 - y2 ;
+            dZ = z1 - z2 ;
+            r2 = dX * dX + dY * dY + dZ * dZ ;
+            if ( r2 > buffer2 ) Coordinates3_SetRow ( set2, i, x1, y1, z1 ) ;
+        }
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Deallocation.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,56 @@
+from pCore.CPrimitiveTypes              cimport CInteger        , \
+                                                CReal
+from pCore.PairList                     cimport CPairList       , \
+                                                PairList        , \
+                                                SelfPairList
+from pCore.Status                       cimport CStatus         , \
+                                                CStatus_OK
+from pScientific.Arrays.IntegerArray1D  cimport CIntegerArray1D , \
+                                                IntegerArray1D
+from pScientific.Arrays.RealArray1D     cimport CRealArray1D    , \
+                                                RealArray1D
+from pScientific.Arrays.RealArray2D     cimport CRealArray2D
+from pScientific.Geometry3.Coordinates3 cimport Coordinates3
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "AtomOrdering.h":
+
+    ctypedef struct CAtomOrdering "AtomOrdering":
+        CInteger  numberOfAtoms
+        CInteger  upperBound
+        CInteger *atoms
+        CInteger *positions
+
+    cdef void           AtomOrdering_Deallocate             ( CAtomOrdering  **self         )
+    cdef CAtomOrdering *AtomOrdering_FromSelfPairList       ( CPairList       *pairList     ,
+                                                              CRealArray2D    *coordinates3 ,
+                                                              CStatus         *status       )
+    cdef void           AtomOrdering_GatherCoordinates3     ( CAtomOrdering   *self         ,
+                                                              CRealArray2D    *coordinates3 ,
+                                                              CRealArray2D    *ordered      ,
+                                                              CStatus         *status       )
+    cdef void           AtomOrdering_GatherIntegerArray1D   ( CAtomOrdering   *self         ,
+                                                              CIntegerArray1D *values       ,
+                                                              CIntegerArray1D *ordered      ,
+                                                              CStatus         *status       )
+    cdef void           AtomOrdering_GatherRealArray1D      ( CAtomOrdering   *self         ,
+                                                              CRealArray1D    *values       ,
+                                                              CRealArray1D    *ordered      ,
+                                                              CStatus         *status       )
+    cdef CPairList     *AtomOrdering_OrderSelfPairList      ( CAtomOrdering   *self         ,
+                                                              CPairList       *pairList     ,
+                                                              CStatus         *status       )
+    cdef void           AtomOrdering_ScatterAddCoordinates3 ( CAtomOrdering   *self         ,
+                                                              CRealArray2D    *ordered      ,
+                                                              CRealArray2D    *coordinates3 ,
+                                                              CStatus         *status       )
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class AtomOrdering:
+
+    cdef CAtomOrdering *cObject
+    cdef public object  isOwner
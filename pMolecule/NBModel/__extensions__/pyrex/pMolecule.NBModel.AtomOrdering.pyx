@@ -0,0 +1,100 @@
+"""Orderings of atoms along a space-filling curve."""
+
+from .NBModelError import NBModelError
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class AtomOrdering:
+    """Orderings of atoms along a space-filling curve."""
+
+    def __dealloc__ ( self ):
+        """Finalization."""
+        if self.isOwner:
+            AtomOrdering_Deallocate ( &self.cObject )
+            self.isOwner = False
+
+    def __init__ ( self ):
+        """Constructor."""
+        self._Initialize ( )
+
+    def __len__ ( self ):
+        """Return the number of ordered atoms."""
+        return self.numberOfAtoms
+
+    def _Initialize ( self ):
+        """Initialization."""
+        self.cObject = NULL
+        self.isOwner = False
+
+    @classmethod
+    def FromSelfPairList ( selfClass, PairList pairList not None, Coordinates3 coordinates3 not None ):
+        """Constructor from the atoms in a self pair-list."""
+        cdef AtomOrdering   self
+        cdef CAtomOrdering *cObject = NULL
+        cdef CStatus        cStatus = CStatus_OK
+        cObject = AtomOrdering_FromSelfPairList ( pairList.cObject, coordinates3.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error creating atom ordering." )
+        self         = selfClass.Raw ( )
+        self.cObject = cObject
+        self.isOwner = True
+        return self
+
+    def GatherCoordinates3 ( self, Coordinates3 coordinates3 not None, Coordinates3 ordered = None ):
+        """Gather the coordinates of the ordered atoms."""
+        cdef CStatus cStatus = CStatus_OK
+        if ordered is None: ordered = Coordinates3.WithExtent ( self.numberOfAtoms )
+        AtomOrdering_GatherCoordinates3 ( self.cObject, coordinates3.cObject, ordered.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error gathering ordered coordinates." )
+        return ordered
+
+    def GatherIntegerArray1D ( self, IntegerArray1D values not None, IntegerArray1D ordered = None ):
+        """Gather the integer values of the ordered atoms."""
+        cdef CStatus cStatus = CStatus_OK
+        if ordered is None: ordered = IntegerArray1D.WithExtent ( self.numberOfAtoms )
+        AtomOrdering_GatherIntegerArray1D ( self.cObject, values.cObject, ordered.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error gathering ordered integer values." )
+        return ordered
+
+    def GatherRealArray1D ( self, RealArray1D values not None, RealArray1D ordered = None ):
+        """Gather the real values of the ordered atoms."""
+        cdef CStatus cStatus = CStatus_OK
+        if ordered is None: ordered = RealArray1D.WithExtent ( self.numberOfAtoms )
+        AtomOrdering_GatherRealArray1D ( self.cObject, values.cObject, ordered.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error gathering ordered real values." )
+        return ordered
+
+    def OrderSelfPairList ( self, PairList pairList not None ):
+        """Return a copy of a self pair-list that refers to the ordered atoms."""
+        cdef SelfPairList  new
+        cdef CPairList    *cPairList = NULL
+        cdef CStatus       cStatus   = CStatus_OK
+        cPairList = AtomOrdering_OrderSelfPairList ( self.cObject, pairList.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error ordering self pair-list." )
+        new         = SelfPairList.Raw ( )
+        new.cObject = cPairList
+        new.isOwner = True
+        return new
+
+    @classmethod
+    def Raw ( selfClass ):
+        """Raw constructor."""
+        self = selfClass.__new__ ( selfClass )
+        self._Initialize ( )
+        return self
+
+    def ScatterAddCoordinates3 ( self, Coordinates3 ordered not None, Coordinates3 coordinates3 not None ):
+        """Add ordered values, typically gradients, to those of the original atoms."""
+        cdef CStatus cStatus = CStatus_OK
+        AtomOrdering_ScatterAddCoordinates3 ( self.cObject, ordered.cObject, coordinates3.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error scattering ordered values." )
+
+    # . Properties.
+    @property
+    def numberOfAtoms ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.numberOfAtoms
+    @property
+    def upperBound ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.upperBound
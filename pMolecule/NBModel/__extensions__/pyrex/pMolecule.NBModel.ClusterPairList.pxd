@@ -0,0 +1,40 @@
+from pCore.CPrimitiveTypes              cimport CCardinal    , \
+                                                CInteger     , \
+                                                CReal
+from pCore.PairList                     cimport CPairList    , \
+                                                PairList
+from pCore.Status                       cimport CStatus      , \
+                                                CStatus_OK
+from pScientific.Arrays.RealArray2D     cimport CRealArray2D
+from pScientific.Geometry3.Coordinates3 cimport Coordinates3
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "ClusterPairList.h":
+
+    cdef CInteger ClusterPairList_ClusterSize
+
+    ctypedef struct CClusterPairList "ClusterPairList":
+        CInteger   numberOfAtoms
+        CInteger   numberOfClusterPairs
+        CInteger   numberOfClusters
+        CInteger   numberOfPairs
+        CInteger  *atoms
+        CInteger  *offsets
+        CInteger  *partners
+        CCardinal *masks
+
+    cdef void              ClusterPairList_Deallocate       ( CClusterPairList **self         )
+    cdef CReal             ClusterPairList_Efficiency       ( CClusterPairList  *self         )
+    cdef CClusterPairList *ClusterPairList_FromSelfPairList ( CPairList         *pairList     ,
+                                                              CRealArray2D      *coordinates3 ,
+                                                              CStatus           *status       )
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class ClusterPairList:
+
+    cdef CClusterPairList *cObject
+    cdef public object     isOwner
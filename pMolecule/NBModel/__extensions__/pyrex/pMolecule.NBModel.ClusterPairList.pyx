@@ -0,0 +1,69 @@
+"""Cluster pair lists."""
+
+from .NBModelError import NBModelError
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class ClusterPairList:
+    """Cluster pair lists."""
+
+    def __dealloc__ ( self ):
+        """Finalization."""
+        if self.isOwner:
+            ClusterPairList_Deallocate ( &self.cObject )
+            self.isOwner = False
+
+    def __init__ ( self ):
+        """Constructor."""
+        self._Initialize ( )
+
+    def __len__ ( self ):
+        """Return the number of atom pairs."""
+        return self.numberOfPairs
+
+    def _Initialize ( self ):
+        """Initialization."""
+        self.cObject = NULL
+        self.isOwner = False
+
+    @classmethod
+    def FromSelfPairList ( selfClass, PairList pairList not None, Coordinates3 coordinates3 not None ):
+        """Constructor from a self pair-list."""
+        cdef ClusterPairList   self
+        cdef CClusterPairList *cObject = NULL
+        cdef CStatus           cStatus = CStatus_OK
+        cObject = ClusterPairList_FromSelfPairList ( pairList.cObject, coordinates3.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error creating cluster pair list." )
+        self         = selfClass.Raw ( )
+        self.cObject = cObject
+        self.isOwner = True
+        return self
+
+    @classmethod
+    def Raw ( selfClass ):
+        """Raw constructor."""
+        self = selfClass.__new__ ( selfClass )
+        self._Initialize ( )
+        return self
+
+    # . Properties.
+    @property
+    def clusterSize ( self ):
+        return ClusterPairList_ClusterSize
+    @property
+    def efficiency ( self ):
+        if self.cObject == NULL: return 0.0
+        else:                    return ClusterPairList_Efficiency ( self.cObject )
+    @property
+    def numberOfClusterPairs ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.numberOfClusterPairs
+    @property
+    def numberOfClusters ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.numberOfClusters
+    @property
+    def numberOfPairs ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.numberOfPairs
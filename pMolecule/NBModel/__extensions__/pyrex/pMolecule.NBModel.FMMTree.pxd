@@ -0,0 +1,41 @@
+from pCore.CPrimitiveTypes                     cimport CInteger                 , \
+                                                       CReal
+from pCore.Selection                           cimport CSelection               , \
+                                                       Selection
+from pCore.Status                              cimport CStatus                  , \
+                                                       CStatus_OK
+from pMolecule.NBModel.PairwiseInteractionFull cimport CPairwiseInteractionFull , \
+                                                       PairwiseInteractionFull
+from pScientific.Arrays.RealArray1D            cimport CRealArray1D             , \
+                                                       RealArray1D
+from pScientific.Arrays.RealArray2D            cimport CRealArray2D
+from pScientific.Geometry3.Coordinates3        cimport Coordinates3
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "FMMTree.h":
+
+    ctypedef struct CFMMTree "FMMTree":
+        CInteger numberOfLeafPoints
+        CInteger order
+
+    cdef CFMMTree *FMMTree_Allocate   ( CStatus                  *status             )
+    cdef void      FMMTree_Deallocate ( CFMMTree                **self               )
+    cdef void      FMMTree_MMMMEnergy ( CFMMTree                 *self               ,
+                                        CPairwiseInteractionFull *interaction        ,
+                                        CRealArray1D             *charges            ,
+                                        CReal                     electrostaticScale ,
+                                        CRealArray2D             *coordinates3       ,
+                                        CSelection               *selection          ,
+                                        CReal                    *eElectrostatic     ,
+                                        CRealArray2D             *gradients3         ,
+                                        CStatus                  *status             )
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class FMMTree:
+
+    cdef CFMMTree      *cObject
+    cdef public object  isOwner
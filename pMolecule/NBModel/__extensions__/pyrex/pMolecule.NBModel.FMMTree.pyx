@@ -0,0 +1,112 @@
+"""A class for the fast multipole evaluation of MM/MM electrostatic interactions in non-periodic systems."""
+
+from pCore             import logFile              , \
+                              LogFileActive        , \
+                              RawObjectConstructor
+from pMolecule.NBModel import NBModelError
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class FMMTree:
+    """A fast multipole evaluator."""
+
+    def __dealloc__ ( self ):
+        """Finalization."""
+        if self.isOwner:
+            FMMTree_Deallocate ( &self.cObject )
+            self.isOwner = False
+
+    def __getstate__ ( self ):
+        """Return the state."""
+        return { "numberOfLeafPoints" : self.numberOfLeafPoints ,
+                 "order"              : self.order              }
+
+    def __init__ ( self, **options ):
+        """Constructor with options."""
+        self._Initialize ( )
+        self._Allocate   ( )
+        self.SetOptions ( **options )
+
+    def __reduce_ex__ ( self, protocol ):
+        """Pickling protocol."""
+        return ( RawObjectConstructor, ( self.__class__, ), self.__getstate__ ( ) )
+
+    def __setstate__ ( self, state ):
+        """Set the state."""
+        self._Allocate ( )
+        self.SetOptions ( **state )
+
+    def _Allocate ( self ):
+        """Allocation."""
+        cdef CStatus cStatus = CStatus_OK
+        self.cObject = FMMTree_Allocate ( &cStatus )
+        self.isOwner = True
+        if cStatus != CStatus_OK: raise NBModelError ( "Error allocating FMM tree." )
+
+    def _Initialize ( self ):
+        """Initialization."""
+        self.cObject = NULL
+        self.isOwner = False
+
+    def MMMMEnergy ( self, PairwiseInteractionFull interaction                 ,
+                           RealArray1D             charges            not None ,
+                                                   electrostaticScale          ,
+                           Coordinates3            coordinates3       not None ,
+                           Selection               selection                   ,
+                           Coordinates3            gradients3                  ):
+        """MM/MM electrostatic energy of all pairs of selected points without exclusions."""
+        cdef CReal         eElectrostatic
+        cdef CRealArray2D *cGradients3 = NULL
+        cdef CSelection   *cSelection  = NULL
+        cdef CStatus       cStatus     = CStatus_OK
+        if gradients3 is not None: cGradients3 = gradients3.cObject
+        if selection  is not None: cSelection  = selection.cObject
+        FMMTree_MMMMEnergy ( self.cObject         ,
+                             interaction.cObject  ,
+                             charges.cObject      ,
+                             electrostaticScale   ,
+                             coordinates3.cObject ,
+                             cSelection           ,
+                             &eElectrostatic      ,
+                             cGradients3          ,
+                             &cStatus             )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error calculating FMM energy." )
+        return eElectrostatic
+
+    @classmethod
+    def Raw ( selfClass ):
+        """Raw constructor."""
+        self = selfClass.__new__ ( selfClass )
+        self._Initialize ( )
+        return self
+
+    def SetOptions ( self, **options ):
+        """Set options for the model."""
+        if "numberOfLeafPoints" in options: self.cObject.numberOfLeafPoints = options.pop ( "numberOfLeafPoints" )
+        if "order"              in options: self.cObject.order              = options.pop ( "order"              )
+        return options
+
+    def Summary ( self, log = logFile ):
+        """Summary."""
+        if LogFileActive ( log ):
+            log.SummaryOfItems ( self.SummaryItems ( ), title = "FMM Tree Summary" )
+
+    def SummaryItems ( self ):
+        """Summary items."""
+        return [ ( "FMM Leaf Points" , "{:d}".format ( self.numberOfLeafPoints ) ) ,
+                 ( "FMM Order"       , "{:d}".format ( self.order              ) ) ]
+
+    @classmethod
+    def WithOptions ( selfClass, **options ):
+        """Constructor from options."""
+        return selfClass ( **options )
+
+    @property
+    def numberOfLeafPoints ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.numberOfLeafPoints
+    @property
+    def order ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.order
@@ -0,0 +1,43 @@
+from pCore.CPrimitiveTypes              cimport CInteger             , \
+                                                CReal
+from pCore.PairList                     cimport CPairList            , \
+                                                PairList             , \
+                                                SelfPairList
+from pCore.Selection                    cimport CSelection           , \
+                                                Selection
+from pCore.Status                       cimport CStatus              , \
+                                                CStatus_OK
+from pScientific.Arrays.RealArray2D     cimport CRealArray2D
+from pScientific.Geometry3.Coordinates3 cimport Coordinates3
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "IncrementalPairList.h":
+
+    ctypedef struct CIncrementalPairList "IncrementalPairList":
+        CInteger numberOfUpdatedPoints
+        CReal    cellSize
+        CReal    cutOff
+
+    cdef CIncrementalPairList *IncrementalPairList_Allocate   ( CReal                  cutOff       ,
+                                                                CReal                  cellSize     ,
+                                                                CStatus               *status       )
+    cdef void                  IncrementalPairList_Deallocate ( CIncrementalPairList **self         )
+    cdef void                  IncrementalPairList_Reset      ( CIncrementalPairList  *self         )
+    cdef CPairList            *IncrementalPairList_Update     ( CIncrementalPairList  *self         ,
+                                                                CRealArray2D          *coordinates3 ,
+                                                                CSelection            *andSelection ,
+                                                                CSelection            *orSelection  ,
+                                                                CPairList             *exclusions   ,
+                                                                CPairList             *pairList     ,
+                                                                CStatus               *status       )
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class IncrementalPairList:
+
+    cdef CIncrementalPairList *cObject
+    cdef public object         isOwner
+    cdef public object         pairList
@@ -0,0 +1,99 @@
+"""Self pair-lists that are updated incrementally as points move."""
+
+from .NBModelError import NBModelError
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class IncrementalPairList:
+    """Self pair-lists that are updated incrementally as points move."""
+
+    def __dealloc__ ( self ):
+        """Finalization."""
+        if self.isOwner:
+            IncrementalPairList_Deallocate ( &self.cObject )
+            self.isOwner = False
+
+    def __init__ ( self, cutOff, cellSize ):
+        """Constructor."""
+        self._Initialize ( )
+        self._Allocate   ( cutOff, cellSize )
+
+    def _Allocate ( self, cutOff, cellSize ):
+        """Allocation."""
+        cdef CStatus cStatus = CStatus_OK
+        self.cObject = IncrementalPairList_Allocate ( cutOff, cellSize, &cStatus )
+        self.isOwner = True
+        if cStatus != CStatus_OK: raise NBModelError ( "Error allocating incremental pair-list." )
+
+    def _Initialize ( self ):
+        """Initialization."""
+        self.cObject  = NULL
+        self.isOwner  = False
+        self.pairList = None
+
+    @classmethod
+    def Raw ( selfClass ):
+        """Raw constructor."""
+        self = selfClass.__new__ ( selfClass )
+        self._Initialize ( )
+        return self
+
+    def Reset ( self ):
+        """Reset the list so that the next update is done from scratch."""
+        IncrementalPairList_Reset ( self.cObject )
+        self.pairList = None
+
+    def Update ( self, Coordinates3 coordinates3 not None ,
+                       Selection    andSelection          ,
+                       Selection    orSelection           ,
+                       PairList     exclusions            ):
+        """Update the list given the reference coordinates of the points."""
+        # . The selections and exclusions should be the same for each update.
+        cdef PairList      previous
+        cdef SelfPairList  pairList
+        cdef CPairList    *cExclusions   = NULL
+        cdef CPairList    *cPairList     = NULL
+        cdef CPairList    *cPrevious     = NULL
+        cdef CSelection   *cAndSelection = NULL
+        cdef CSelection   *cOrSelection  = NULL
+        cdef CStatus       cStatus       = CStatus_OK
+        previous = self.pairList
+        if andSelection is not None: cAndSelection = andSelection.cObject
+        if exclusions   is not None: cExclusions   = exclusions.cObject
+        if orSelection  is not None: cOrSelection  = orSelection.cObject
+        if previous     is not None: cPrevious     = previous.cObject
+        cPairList = IncrementalPairList_Update ( self.cObject         ,
+                                                 coordinates3.cObject ,
+                                                 cAndSelection        ,
+                                                 cOrSelection         ,
+                                                 cExclusions          ,
+                                                 cPrevious            ,
+                                                 &cStatus             )
+        if cStatus != CStatus_OK:
+            self.pairList = None
+            raise NBModelError ( "Error updating incremental pair-list." )
+        pairList         = SelfPairList.Raw ( )
+        pairList.cObject = cPairList
+        pairList.isOwner = True
+        self.pairList    = pairList
+        return pairList
+
+    @classmethod
+    def WithOptions ( selfClass, cellSize, cutOff ):
+        """Constructor from options."""
+        return selfClass ( cutOff, cellSize )
+
+    # . Properties.
+    @property
+    def cellSize ( self ):
+        if self.cObject == NULL: return 0.0
+        else:                    return self.cObject.cellSize
+    @property
+    def cutOff ( self ):
+        if self.cObject == NULL: return 0.0
+        else:                    return self.cObject.cutOff
+    @property
+    def numberOfUpdatedPoints ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.numberOfUpdatedPoints
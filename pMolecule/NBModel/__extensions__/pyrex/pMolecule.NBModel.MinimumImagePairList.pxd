@@ -0,0 +1,25 @@
+from pCore.CPrimitiveTypes                   cimport CReal
+from pCore.PairList                          cimport CPairList           , \
+                                                     PairList            , \
+                                                     SelfPairList
+from pCore.Selection                         cimport CSelection          , \
+                                                     Selection
+from pCore.Status                            cimport CStatus             , \
+                                                     CStatus_OK
+from pScientific.Arrays.RealArray2D          cimport CRealArray2D
+from pScientific.Geometry3.Coordinates3      cimport Coordinates3
+from pScientific.Symmetry.SymmetryParameters cimport CSymmetryParameters , \
+                                                     SymmetryParameters
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "MinimumImagePairList.h":
+
+    cdef CPairList *CMinimumImagePairList_SelfFromCoordinates3 "MinimumImagePairList_SelfFromCoordinates3" ( CReal                cutOff             ,
+                                                                                                              CRealArray2D        *coordinates3       ,
+                                                                                                              CSymmetryParameters *symmetryParameters ,
+                                                                                                              CSelection          *andSelection       ,
+                                                                                                              CSelection          *orSelection        ,
+                                                                                                              CPairList           *exclusions         ,
+                                                                                                              CStatus             *status             )
@@ -0,0 +1,34 @@
+"""Minimum image pair lists."""
+
+from .NBModelError import NBModelError
+
+#===================================================================================================================================
+# . Function.
+#===================================================================================================================================
+def MinimumImagePairList_SelfFromCoordinates3 ( cutOff, Coordinates3       coordinates3       not None ,
+                                                        SymmetryParameters symmetryParameters not None ,
+                                                        Selection          andSelection                ,
+                                                        Selection          orSelection                 ,
+                                                        PairList           exclusions                  ):
+    """Self pair-list within the minimum image convention."""
+    cdef SelfPairList  pairList
+    cdef CPairList    *cExclusions   = NULL
+    cdef CPairList    *cPairList     = NULL
+    cdef CSelection   *cAndSelection = NULL
+    cdef CSelection   *cOrSelection  = NULL
+    cdef CStatus       cStatus       = CStatus_OK
+    if andSelection is not None: cAndSelection = andSelection.cObject
+    if exclusions   is not None: cExclusions   = exclusions.cObject
+    if orSelection  is not None: cOrSelection  = orSelection.cObject
+    cPairList = CMinimumImagePairList_SelfFromCoordinates3 ( cutOff                     ,
+                                                             coordinates3.cObject       ,
+                                                             symmetryParameters.cObject ,
+                                                             cAndSelection              ,
+                                                             cOrSelection               ,
+                                                             cExclusions                ,
+                                                             &cStatus                   )
+    if cStatus != CStatus_OK: raise NBModelError ( "Error generating minimum image self pair-list." )
+    pairList         = SelfPairList.Raw ( )
+    pairList.cObject = cPairList
+    pairList.isOwner = True
+    return pairList
@@ -9,6 +9,8 @@ from pCore.Status                                    cimport CStatus
                                                              CStatus_OK
 from pMolecule.MMModel.LJParameterContainer          cimport CLJParameterContainer       , \
                                                              LJParameterContainer
+from pMolecule.NBModel.ClusterPairList               cimport CClusterPairList            , \
+                                                             ClusterPairList
 from pMolecule.NBModel.ImagePairListContainer        cimport CImagePairListContainer     , \
                                                              ImagePairListContainer
 from pMolecule.NBModel.PairwiseInteraction           cimport PairwiseInteraction
@@ -35,154 +37,194 @@ cdef extern from "PairwiseInteractionABFS.h":
         CReal innerCutOff
         CReal outerCutOff
 
-    cdef  CPairwiseInteractionABFS *PairwiseInteractionABFS_Allocate            ( CStatus                     *status                     )
-    cdef  CPairwiseInteractionABFS *PairwiseInteractionABFS_Clone               ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_Deallocate          ( CPairwiseInteractionABFS   **self                       )
-    cdef  void                      PairwiseInteractionABFS_Interactions        ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *r                          ,
-                                                                                  CRealArray1D                *electrostatic              ,
-                                                                                  CRealArray1D                *lennardJonesA              ,
-                                                                                  CRealArray1D                *lennardJonesB              )
-    cdef  void                      PairwiseInteractionABFS_MMMMEnergy          ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *chargesI                   ,
-                                                                                  CRealArray1D                *chargesJ                   ,
-                                                                                  CIntegerArray1D             *ljTypesI                   ,
-                                                                                  CIntegerArray1D             *ljTypesJ                   ,
-                                                                                  CLJParameterContainer       *ljParameters               ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CReal                        lennardJonesScale          ,
-                                                                                  CRealArray2D                *coordinates3I              ,
-                                                                                  CRealArray2D                *coordinates3J              ,
-                                                                                  CPairList                   *pairList                   ,
-                                                                                  CReal                       *eElectrostatic             ,
-                                                                                  CReal                       *eLennardJones              ,
-                                                                                  CRealArray2D                *gradients3I                ,
-                                                                                  CRealArray2D                *gradients3J                ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_MMMMEnergyImage     ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *charges                    ,
-                                                                                  CIntegerArray1D             *ljTypes                    ,
-                                                                                  CLJParameterContainer       *ljParameters               ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3               ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CImagePairListContainer     *imagePairLists             ,
-                                                                                  CReal                       *eElectrostatic             ,
-                                                                                  CReal                       *eLennardJones              ,
-                                                                                  CRealArray2D                *gradients3                 ,
-                                                                                  CSymmetryParameterGradients *symmetryParameterGradients ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_MMMMEnergyMI        ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *chargesI                   ,
-                                                                                  CRealArray1D                *chargesJ                   ,
-                                                                                  CIntegerArray1D             *ljTypesI                   ,
-                                                                                  CIntegerArray1D             *ljTypesJ                   ,
-                                                                                  CLJParameterContainer       *ljParameters               ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CReal                        lennardJonesScale          ,
-                                                                                  CRealArray2D                *coordinates3I              ,
-                                                                                  CRealArray2D                *coordinates3J              ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CPairList                   *pairList                   ,
-                                                                                  CReal                       *eElectrostatic             ,
-                                                                                  CReal                       *eLennardJones              ,
-                                                                                  CRealArray2D                *gradients3I                ,
-                                                                                  CRealArray2D                *gradients3J                ,
-                                                                                  CSymmetryParameterGradients *symmetryParameterGradients ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCMMGradients       ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *chargesQ                   ,
-                                                                                  CRealArray1D                *chargesM                   ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3Q              ,
-                                                                                  CRealArray2D                *coordinates3M              ,
-                                                                                  CPairList                   *pairList                   ,
-                                                                                  CRealArray2D                *gradients3Q                ,
-                                                                                  CRealArray2D                *gradients3M                ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCMMGradientsImage  ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *chargesA                   ,
-                                                                                  CRealArray1D                *chargesB                   ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3A              ,
-                                                                                  CRealArray2D                *coordinates3B              ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CImagePairListContainer     *imagePairLists             ,
-                                                                                  CRealArray2D                *gradients3A                ,
-                                                                                  CRealArray2D                *gradients3B                ,
-                                                                                  CSymmetryParameterGradients *symmetryParameterGradients ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCMMGradientsMI     ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *chargesQ                   ,
-                                                                                  CRealArray1D                *chargesM                   ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3Q              ,
-                                                                                  CRealArray2D                *coordinates3M              ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CPairList                   *pairList                   ,
-                                                                                  CRealArray2D                *gradients3Q                ,
-                                                                                  CRealArray2D                *gradients3M                ,
-                                                                                  CSymmetryParameterGradients *symmetryParameterGradients ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCMMPotentials      ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *chargesM                   ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3Q              ,
-                                                                                  CRealArray2D                *coordinates3M              ,
-                                                                                  CPairList                   *pairList                   ,
-                                                                                  CRealArray1D                *potentials                 ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCMMPotentialsImage ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *charges                    ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3A              ,
-                                                                                  CRealArray2D                *coordinates3B              ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CImagePairListContainer     *imagePairLists             ,
-                                                                                  CRealArray1D                *potentials                 ,
-                                                                                  CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCMMPotentialsMI    ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *chargesM                   ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3Q              ,
-                                                                                  CRealArray2D                *coordinates3M              ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CPairList                   *pairList                   ,
-                                                                                  CRealArray1D                *potentials                 ,
-                                                                                  CStatus                     *status                     )
-#   cdef  void                      PairwiseInteractionABFS_QCQCGradients       ( CPairwiseInteractionABFS    *self                       ,
-#                                                                                 CRealArray1D                *charges                    ,
-#                                                                                 CReal                        electrostaticScale         ,
-#                                                                                 CRealArray2D                *coordinates3I              ,
-#                                                                                 CRealArray2D                *coordinates3J              ,
-#                                                                                 CPairList                   *pairList                   ,
-#                                                                                 CRealArray2D                *gradients3I                ,
-#                                                                                 CRealArray2D                *gradients3J                ,
-#                                                                                 CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCQCGradientsImage  ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CRealArray1D                *charges                    ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3               ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CImagePairListContainer     *imagePairLists             ,
-                                                                                  CRealArray2D                *gradients3                 ,
-                                                                                  CSymmetryParameterGradients *symmetryParameterGradients ,
-                                                                                  CStatus                     *status                     )
-#   cdef  void                      PairwiseInteractionABFS_QCQCPotentials      ( CPairwiseInteractionABFS    *self                       ,
-#                                                                                 CReal                        electrostaticScale         ,
-#                                                                                 CRealArray2D                *coordinates3I              ,
-#                                                                                 CRealArray2D                *coordinates3J              ,
-#                                                                                 CPairList                   *pairList                   ,
-#                                                                                 CSymmetricMatrix            *potentials                 ,
-#                                                                                 CStatus                     *status                     )
-    cdef  void                      PairwiseInteractionABFS_QCQCPotentialsImage ( CPairwiseInteractionABFS    *self                       ,
-                                                                                  CReal                        electrostaticScale         ,
-                                                                                  CRealArray2D                *coordinates3               ,
-                                                                                  CSymmetryParameters         *symmetryParameters         ,
-                                                                                  CImagePairListContainer     *imagePairLists             ,
-                                                                                  CSymmetricMatrix            *potentials                 ,
-                                                                                  CStatus                     *status                     )
+    cdef  CPairwiseInteractionABFS *PairwiseInteractionABFS_Allocate                ( CStatus                     *status                     )
+    cdef  CPairwiseInteractionABFS *PairwiseInteractionABFS_Clone                   ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_Deallocate              ( CPairwiseInteractionABFS   **self                       )
+    cdef  void                      PairwiseInteractionABFS_Interactions            ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *r                          ,
+                                                                                      CRealArray1D                *electrostatic              ,
+                                                                                      CRealArray1D                *lennardJonesA              ,
+                                                                                      CRealArray1D                *lennardJonesB              )
+    cdef  void                      PairwiseInteractionABFS_MMMMEnergy              ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesI                   ,
+                                                                                      CRealArray1D                *chargesJ                   ,
+                                                                                      CIntegerArray1D             *ljTypesI                   ,
+                                                                                      CIntegerArray1D             *ljTypesJ                   ,
+                                                                                      CLJParameterContainer       *ljParameters               ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CReal                        lennardJonesScale          ,
+                                                                                      CRealArray2D                *coordinates3I              ,
+                                                                                      CRealArray2D                *coordinates3J              ,
+                                                                                      CPairList                   *pairList                   ,
+                                                                                      CReal                       *eElectrostatic             ,
+                                                                                      CReal                       *eLennardJones              ,
+                                                                                      CRealArray2D                *gradients3I                ,
+                                                                                      CRealArray2D                *gradients3J                ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_MMMMEnergyCluster       ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *charges                    ,
+                                                                                      CIntegerArray1D             *ljTypes                    ,
+                                                                                      CLJParameterContainer       *ljParameters               ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CReal                        lennardJonesScale          ,
+                                                                                      CRealArray2D                *coordinates3               ,
+                                                                                      CClusterPairList            *clusterPairList            ,
+                                                                                      CReal                       *eElectrostatic             ,
+                                                                                      CReal                       *eLennardJones              ,
+                                                                                      CRealArray2D                *gradients3                 ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_MMMMEnergyClusterSingle ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *charges                    ,
+                                                                                      CIntegerArray1D             *ljTypes                    ,
+                                                                                      CLJParameterContainer       *ljParameters               ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CReal                        lennardJonesScale          ,
+                                                                                      CRealArray2D                *coordinates3               ,
+                                                                                      CClusterPairList            *clusterPairList            ,
+                                                                                      CReal                       *eElectrostatic             ,
+                                                                                      CReal                       *eLennardJones              ,
+                                                                                      CRealArray2D                *gradients3                 ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_MMMMEnergyImage         ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *charges                    ,
+                                                                                      CIntegerArray1D             *ljTypes                    ,
+                                                                                      CLJParameterContainer       *ljParameters               ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3               ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CImagePairListContainer     *imagePairLists             ,
+                                                                                      CReal                       *eElectrostatic             ,
+                                                                                      CReal                       *eLennardJones              ,
+                                                                                      CRealArray2D                *gradients3                 ,
+                                                                                      CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_MMMMEnergyMI            ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesI                   ,
+                                                                                      CRealArray1D                *chargesJ                   ,
+                                                                                      CIntegerArray1D             *ljTypesI                   ,
+                                                                                      CIntegerArray1D             *ljTypesJ                   ,
+                                                                                      CLJParameterContainer       *ljParameters               ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CReal                        lennardJonesScale          ,
+                                                                                      CRealArray2D                *coordinates3I              ,
+                                                                                      CRealArray2D                *coordinates3J              ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CPairList                   *pairList                   ,
+                                                                                      CReal                       *eElectrostatic             ,
+                                                                                      CReal                       *eLennardJones              ,
+                                                                                      CRealArray2D                *gradients3I                ,
+                                                                                      CRealArray2D                *gradients3J                ,
+                                                                                      CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_MMMMEnergySingle        ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesI                   ,
+                                                                                      CRealArray1D                *chargesJ                   ,
+                                                                                      CIntegerArray1D             *ljTypesI                   ,
+                                                                                      CIntegerArray1D             *ljTypesJ                   ,
+                                                                                      CLJParameterContainer       *ljParameters               ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CReal                        lennardJonesScale          ,
+                                                                                      CRealArray2D                *coordinates3I              ,
+                                                                                      CRealArray2D                *coordinates3J              ,
+                                                                                      CPairList                   *pairList                   ,
+                                                                                      CReal                       *eElectrostatic             ,
+                                                                                      CReal                       *eLennardJones              ,
+                                                                                      CRealArray2D                *gradients3I                ,
+                                                                                      CRealArray2D                *gradients3J                ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCMMGradients           ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesQ                   ,
+                                                                                      CRealArray1D                *chargesM                   ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3Q              ,
+                                                                                      CRealArray2D                *coordinates3M              ,
+                                                                                      CPairList                   *pairList                   ,
+                                                                                      CRealArray2D                *gradients3Q                ,
+                                                                                      CRealArray2D                *gradients3M                ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCMMGradientsImage      ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesA                   ,
+                                                                                      CRealArray1D                *chargesB                   ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3A              ,
+                                                                                      CRealArray2D                *coordinates3B              ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CImagePairListContainer     *imagePairLists             ,
+                                                                                      CRealArray2D                *gradients3A                ,
+                                                                                      CRealArray2D                *gradients3B                ,
+                                                                                      CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCMMGradientsMI         ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesQ                   ,
+                                                                                      CRealArray1D                *chargesM                   ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3Q              ,
+                                                                                      CRealArray2D                *coordinates3M              ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CPairList                   *pairList                   ,
+                                                                                      CRealArray2D                *gradients3Q                ,
+                                                                                      CRealArray2D                *gradients3M                ,
+                                                                                      CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCMMPotentials          ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesM                   ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3Q              ,
+                                                                                      CRealArray2D                *coordinates3M              ,
+                                                                                      CPairList                   *pairList                   ,
+                                                                                      CRealArray1D                *potentials                 ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCMMPotentialsImage     ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *charges                    ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3A              ,
+                                                                                      CRealArray2D                *coordinates3B              ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CImagePairListContainer     *imagePairLists             ,
+                                                                                      CRealArray1D                *potentials                 ,
+                                                                                      CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCMMPotentialsMI        ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *chargesM                   ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3Q              ,
+                                                                                      CRealArray2D                *coordinates3M              ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CPairList                   *pairList                   ,
+                                                                                      CRealArray1D                *potentials                 ,
+                                                                                      CStatus                     *status                     )
+#   cdef  void                      PairwiseInteractionABFS_QCQCGradients           ( CPairwiseInteractionABFS    *self                       ,
+#                                                                                     CRealArray1D                *charges                    ,
+#                                                                                     CReal                        electrostaticScale         ,
+#                                                                                     CRealArray2D                *coordinates3I              ,
+#                                                                                     CRealArray2D                *coordinates3J              ,
+#                                                                                     CPairList                   *pairList                   ,
+#                                                                                     CRealArray2D                *gradients3I                ,
+#                                                                                     CRealArray2D                *gradients3J                ,
+#                                                                                     CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCQCGradientsImage      ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CRealArray1D                *charges                    ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3               ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CImagePairListContainer     *imagePairLists             ,
+                                                                                      CRealArray2D                *gradients3                 ,
+                                                                                      CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                                                      CStatus                     *status                     )
+#   cdef  void                      PairwiseInteractionABFS_QCQCPotentials          ( CPairwiseInteractionABFS    *self                       ,
+#                                                                                     CReal                        electrostaticScale         ,
+#                                                                                     CRealArray2D                *coordinates3I              ,
+#                                                                                     CRealArray2D                *coordinates3J              ,
+#                                                                                     CPairList                   *pairList                   ,
+#                                                                                     CSymmetricMatrix            *potentials                 ,
+#                                                                                     CStatus                     *status                     )
+    cdef  void                      PairwiseInteractionABFS_QCQCPotentialsImage     ( CPairwiseInteractionABFS    *self                       ,
+                                                                                      CReal                        electrostaticScale         ,
+                                                                                      CRealArray2D                *coordinates3               ,
+                                                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                                                      CImagePairListContainer     *imagePairLists             ,
+                                                                                      CSymmetricMatrix            *potentials                 ,
+                                                                                      CStatus                     *status                     )
 
 #===================================================================================================================================
 # . Class.
@@ -73,8 +73,9 @@ cdef class PairwiseInteractionABFS ( PairwiseInteraction ):
                            Coordinates3         coordinates3J not None ,
                            PairList             pairList      not None ,
                            Coordinates3         gradients3I            ,
-                           Coordinates3         gradients3J            ):
-        """MM/MM energy."""
+                           Coordinates3         gradients3J            ,
+                                                useSinglePrecision = False ):
+        """MM/MM energy with optional single precision pair arithmetic."""
         cdef CIntegerArray1D       *cLJTypesI      = NULL 
         cdef CIntegerArray1D       *cLJTypesJ      = NULL 
         cdef CRealArray2D          *cGradients3I   = NULL 
@@ -92,22 +93,90 @@ cdef class PairwiseInteractionABFS ( PairwiseInteraction ):
         if ljParameters is not None: cLJParameters = ljParameters.cObject
         if ljTypesI     is not None: cLJTypesI     = ljTypesI.cObject
         if ljTypesJ     is not None: cLJTypesJ     = ljTypesJ.cObject
-        PairwiseInteractionABFS_MMMMEnergy ( self.cObject          ,
-                                             cChargesI             ,
-                                             cChargesJ             ,
-                                             cLJTypesI             ,
-                                             cLJTypesJ             ,
-                                             cLJParameters         ,
-                                             electrostaticScale    ,
-                                             lennardJonesScale     ,
-                                             coordinates3I.cObject ,
-                                             coordinates3J.cObject ,
-                                             pairList.cObject      ,
-                                             &eElectrostatic       ,
-                                             &eLennardJones        ,
-                                             cGradients3I          ,
-                                             cGradients3J          ,
-                                             &cStatus              )
+        if useSinglePrecision:
+            PairwiseInteractionABFS_MMMMEnergySingle ( self.cObject          ,
+                                                       cChargesI             ,
+                                                       cChargesJ             ,
+                                                       cLJTypesI             ,
+                                                       cLJTypesJ             ,
+                                                       cLJParameters         ,
+                                                       electrostaticScale    ,
+                                                       lennardJonesScale     ,
+                                                       coordinates3I.cObject ,
+                                                       coordinates3J.cObject ,
+                                                       pairList.cObject      ,
+                                                       &eElectrostatic       ,
+                                                       &eLennardJones        ,
+                                                       cGradients3I          ,
+                                                       cGradients3J          ,
+                                                       &cStatus              )
+        else:
+            PairwiseInteractionABFS_MMMMEnergy ( self.cObject          ,
+                                                 cChargesI             ,
+                                                 cChargesJ             ,
+                                                 cLJTypesI             ,
+                                                 cLJTypesJ             ,
+                                                 cLJParameters         ,
+                                                 electrostaticScale    ,
+                                                 lennardJonesScale     ,
+                                                 coordinates3I.cObject ,
+                                                 coordinates3J.cObject ,
+                                                 pairList.cObject      ,
+                                                 &eElectrostatic       ,
+                                                 &eLennardJones        ,
+                                                 cGradients3I          ,
+                                                 cGradients3J          ,
+                                                 &cStatus              )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error calculating MM energy." )
+        return ( eElectrostatic, eLennardJones )
+
+    def MMMMEnergyCluster ( self, RealArray1D          charges                      ,
+                                  IntegerArray1D       ljTypes                      ,
+                                  LJParameterContainer ljParameters                 ,
+                                                       electrostaticScale           ,
+                                                       lennardJonesScale            ,
+                                  Coordinates3         coordinates3        not None ,
+                                  ClusterPairList      clusterPairList     not None ,
+                                  Coordinates3         gradients3                   ,
+                                                       useSinglePrecision = False   ):
+        """MM/MM energy with a cluster pair list and optional single precision pair arithmetic."""
+        cdef CIntegerArray1D       *cLJTypes      = NULL 
+        cdef CRealArray2D          *cGradients3   = NULL 
+        cdef CLJParameterContainer *cLJParameters = NULL
+        cdef CReal                  eElectrostatic
+        cdef CReal                  eLennardJones
+        cdef CRealArray1D          *cCharges      = NULL
+        cdef CStatus                cStatus        = CStatus_OK
+        if charges      is not None: cCharges      = charges.cObject
+        if gradients3   is not None: cGradients3   = gradients3.cObject
+        if ljParameters is not None: cLJParameters = ljParameters.cObject
+        if ljTypes      is not None: cLJTypes      = ljTypes.cObject
+        if useSinglePrecision:
+            PairwiseInteractionABFS_MMMMEnergyClusterSingle ( self.cObject            ,
+                                                              cCharges                ,
+                                                              cLJTypes                ,
+                                                              cLJParameters           ,
+                                                              electrostaticScale      ,
+                                                              lennardJonesScale       ,
+                                                              coordinates3.cObject    ,
+                                                              clusterPairList.cObject ,
+                                                              &eElectrostatic         ,
+                                                              &eLennardJones          ,
+                                                              cGradients3             ,
+                                                              &cStatus                )
+        else:
+            PairwiseInteractionABFS_MMMMEnergyCluster ( self.cObject            ,
+                                                        cCharges                ,
+                                                        cLJTypes                ,
+                                                        cLJParameters           ,
+                                                        electrostaticScale      ,
+                                                        lennardJonesScale       ,
+                                                        coordinates3.cObject    ,
+                                                        clusterPairList.cObject ,
+                                                        &eElectrostatic         ,
+                                                        &eLennardJones          ,
+                                                        cGradients3             ,
+                                                        &cStatus                )
         if cStatus != CStatus_OK: raise NBModelError ( "Error calculating MM energy." )
         return ( eElectrostatic, eLennardJones )
 
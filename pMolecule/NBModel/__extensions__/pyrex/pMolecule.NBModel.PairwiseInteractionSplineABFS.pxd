@@ -105,6 +105,22 @@ cdef extern from "PairwiseInteractionSpline.h":
                                                                                             CRealArray2D                *gradients3J                ,
                                                                                             CSymmetryParameterGradients *symmetryParameterGradients ,
                                                                                             CStatus                     *status                     )
+    cdef  void                        PairwiseInteractionSpline_MMMMEnergySingle          ( CPairwiseInteractionSpline  *self                       ,
+                                                                                            CRealArray1D                *chargesI                   ,
+                                                                                            CRealArray1D                *chargesJ                   ,
+                                                                                            CIntegerArray1D             *ljTypesI                   ,
+                                                                                            CIntegerArray1D             *ljTypesJ                   ,
+                                                                                            CLJParameterContainer       *ljParameters               ,
+                                                                                            CReal                        electrostaticScale         ,
+                                                                                            CReal                        lennardJonesScale          ,
+                                                                                            CRealArray2D                *coordinates3I              ,
+                                                                                            CRealArray2D                *coordinates3J              ,
+                                                                                            CPairList                   *pairList                   ,
+                                                                                            CReal                       *eElectrostatic             ,
+                                                                                            CReal                       *eLennardJones              ,
+                                                                                            CRealArray2D                *gradients3I                ,
+                                                                                            CRealArray2D                *gradients3J                ,
+                                                                                            CStatus                     *status                     )
     cdef  void                        PairwiseInteractionSpline_QCMMGradients             ( CPairwiseInteractionSpline  *self                       ,  
                                                                                             CRealArray1D                *chargesQ                   ,  
                                                                                             CRealArray1D                *chargesM                   ,  
@@ -211,6 +227,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
     cdef public CubicSpline          lennardJonesBSpline
     cdef public object               dampingCutOff
     cdef public object               electrostaticModel
+    cdef public object               ewaldKappa
     cdef public object               innerCutOff
     cdef public object               integrator
     cdef public object               outerCutOff
@@ -49,6 +49,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
         """Return the state."""
         return { "dampingCutOff"      : self.dampingCutOff      ,
                  "electrostaticModel" : self.electrostaticModel ,
+                 "ewaldKappa"         : self.ewaldKappa         ,
                  "innerCutOff"        : self.innerCutOff        ,
                  "outerCutOff"        : self.outerCutOff        ,
                  "pointDensity"       : self.pointDensity       ,
@@ -75,6 +76,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
             raise NBModelError ( "Invalid cutOff values: damping - {:.3f}; inner - {:.3f}; outer - {:.3f}.".format ( self.dampingCutOff , \
                                                                                                                      self.innerCutOff   , \
                                                                                                                      self.outerCutOff   ) )
+        if self.ewaldKappa < 0.0: raise NBModelError ( "Invalid Ewald kappa: {:.3f}.".format ( self.ewaldKappa ) )
         self.integrator = ABFSIntegrator.WithOptions ( dampingCutOff = self.dampingCutOff ,
                                                        innerCutOff   = self.innerCutOff   ,
                                                        outerCutOff   = self.outerCutOff   ,
@@ -87,6 +89,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
         self.dampingCutOff       = 0.5
         self.electrostaticModel  = _DefaultSplineModel
         self.electrostaticSpline = None
+        self.ewaldKappa          = 0.0
         self.innerCutOff         = 8.0
         self.integrator          = None
         self.lennardJonesASpline = None
@@ -111,8 +114,26 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
     # . p = "sqrt ( a )"                        Delta_Gaussian
     # . p = "sqrt ( a * b / ( a + b ) )"        Gaussian_Gaussian
     # . Small x expansions up to 10th order. At switch over point differences are of the order of 10^-16 (F) and 10^-14/15 (G).
+    # . Electrostatic models with a non-zero Ewald kappa have the reciprocal space term, erf ( kappa * r ) / r, removed.
     def IntegrationFunctions ( self, model ):
         """Return the integration functions."""
+        def FGaussian ( p ):
+            def F ( r ):
+                x  = p * r
+                x2 = x * x
+                if x > _MinimumR: f = math.erf ( x ) / x
+                else:             f = ( 2.0 - x2 * ( 2.0 / 3.0 - x2 * ( 0.2 - x2 * ( 1.0 / 21.0 - x2 * ( 1.0 / 108.0 - x2 / 660.0 ) ) ) ) ) / math.sqrt ( math.pi )
+                return ( f * p )
+            return F
+        def GGaussian ( p ):
+            def G ( r ):
+                sPi = math.sqrt ( math.pi )
+                x   = p * r
+                x2  = x * x
+                if x > _MinimumR: g = 2.0 * math.exp ( - x2 ) / ( sPi * x ) - math.erf ( x ) / x2
+                else:             g = - x * ( 4.0 / 3.0 - x2 * ( 0.8 - x2 * ( 2.0 / 7.0 - x2 * ( 2.0 / 27.0 - x2 / 66.0 ) ) ) ) / sPi
+                return ( g * p * p )
+            return G
         factor = 2.0 / math.sqrt ( math.pi )
         if model is SplineModel.Delta_Delta:            # . 1/r.
             def F ( r ):
@@ -139,25 +160,13 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
             if   model is SplineModel.Delta_Gaussian   : p = factor / self.width2
             elif model is SplineModel.Gaussian_Gaussian: p = factor / math.sqrt ( self.width1**2 + self.width2**2 )
             else: raise NBModelError ( "Invalid spline model: {:s}.".format ( model ) )
-            def FGaussian ( p ):
-                def F ( r ):
-                    x  = p * r
-                    x2 = x * x
-                    if x > _MinimumR: f = math.erf ( x ) / x
-                    else:             f = ( 2.0 - x2 * ( 2.0 / 3.0 - x2 * ( 0.2 - x2 * ( 1.0 / 21.0 - x2 * ( 1.0 / 108.0 - x2 / 660.0 ) ) ) ) ) / math.sqrt ( math.pi )
-                    return ( f * p )
-                return F
-            def GGaussian ( p ):
-                def G ( r ):
-                    sPi = math.sqrt ( math.pi )
-                    x   = p * r
-                    x2  = x * x
-                    if x > _MinimumR: g = 2.0 * math.exp ( - x2 ) / ( sPi * x ) - math.erf ( x ) / x2
-                    else:             g = - x * ( 4.0 / 3.0 - x2 * ( 0.8 - x2 * ( 2.0 / 7.0 - x2 * ( 2.0 / 27.0 - x2 / 66.0 ) ) ) ) / sPi
-                    return ( g * p * p )
-                return G
             F = FGaussian ( p )
             G = GGaussian ( p )
+        if ( self.ewaldKappa > 0.0 ) and ( model in ( SplineModel.Delta_Delta, SplineModel.Delta_Gaussian, SplineModel.Gaussian_Gaussian ) ):
+            ( F0, G0 ) = ( F, G )
+            ( FK, GK ) = ( FGaussian ( self.ewaldKappa ), GGaussian ( self.ewaldKappa ) )
+            def F ( r ): return ( F0 ( r ) - FK ( r ) )
+            def G ( r ): return ( G0 ( r ) - GK ( r ) )
         return ( F, G )
 
     def Interactions ( self, RealArray1D r not None ):
@@ -208,8 +217,9 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
                            Coordinates3         coordinates3J not None ,
                            PairList             pairList      not None ,
                            Coordinates3         gradients3I            ,
-                           Coordinates3         gradients3J            ):
-        """MM/MM energy."""
+                           Coordinates3         gradients3J            ,
+                                                useSinglePrecision = False ):
+        """MM/MM energy with optional single precision pair arithmetic."""
         cdef CIntegerArray1D       *cLJTypesI      = NULL 
         cdef CIntegerArray1D       *cLJTypesJ      = NULL 
         cdef CRealArray2D          *cGradients3I   = NULL 
@@ -227,22 +237,40 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
         if ljParameters is not None: cLJParameters = ljParameters.cObject
         if ljTypesI     is not None: cLJTypesI     = ljTypesI.cObject
         if ljTypesJ     is not None: cLJTypesJ     = ljTypesJ.cObject
-        PairwiseInteractionSpline_MMMMEnergy ( self.cObject          ,
-                                               cChargesI             ,
-                                               cChargesJ             ,
-                                               cLJTypesI             ,
-                                               cLJTypesJ             ,
-                                               cLJParameters         ,
-                                               electrostaticScale    ,
-                                               lennardJonesScale     ,
-                                               coordinates3I.cObject ,
-                                               coordinates3J.cObject ,
-                                               pairList.cObject      ,
-                                               &eElectrostatic       ,
-                                               &eLennardJones        ,
-                                               cGradients3I          ,
-                                               cGradients3J          ,
-                                               &cStatus               )
+        if useSinglePrecision:
+            PairwiseInteractionSpline_MMMMEnergySingle ( self.cObject          ,
+                                                         cChargesI             ,
+                                                         cChargesJ             ,
+                                                         cLJTypesI             ,
+                                                         cLJTypesJ             ,
+                                                         cLJParameters         ,
+                                                         electrostaticScale    ,
+                                                         lennardJonesScale     ,
+                                                         coordinates3I.cObject ,
+                                                         coordinates3J.cObject ,
+                                                         pairList.cObject      ,
+                                                         &eElectrostatic       ,
+                                                         &eLennardJones        ,
+                                                         cGradients3I          ,
+                                                         cGradients3J          ,
+                                                         &cStatus               )
+        else:
+            PairwiseInteractionSpline_MMMMEnergy ( self.cObject          ,
+                                                   cChargesI             ,
+                                                   cChargesJ             ,
+                                                   cLJTypesI             ,
+                                                   cLJTypesJ             ,
+                                                   cLJParameters         ,
+                                                   electrostaticScale    ,
+                                                   lennardJonesScale     ,
+                                                   coordinates3I.cObject ,
+                                                   coordinates3J.cObject ,
+                                                   pairList.cObject      ,
+                                                   &eElectrostatic       ,
+                                                   &eLennardJones        ,
+                                                   cGradients3I          ,
+                                                   cGradients3J          ,
+                                                   &cStatus               )
         if cStatus != CStatus_OK: raise NBModelError ( "Error calculating MM energy." )
         return ( eElectrostatic, eLennardJones )
 
@@ -344,6 +372,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
         """Option records and subobjects that also have options."""
         return ( [ ( "dampingCutOff"     , "Damping Cut-Off"      , "float"      , "{:.3f}".format ( self.dampingCutOff            ) ) ,
                    ( "electrostaticModel", "Electrostatic Model"  , "SplineModel", self.electrostaticModel.name.replace ( "_", "/" ) ) ,
+                   ( "ewaldKappa"        , "Ewald Kappa"          , "float"      , "{:.3f}".format ( self.ewaldKappa               ) ) ,
                    ( "innerCutOff"       , "Inner Cut-Off"        , "float"      , "{:.3f}".format ( self.innerCutOff              ) ) ,
                    ( "outerCutOff"       , "Outer Cut-Off"        , "float"      , "{:.3f}".format ( self.outerCutOff              ) ) ,
                    ( "pointDensity"      , "Spline Point Density" , "int"        , "{:d}"  .format ( self.pointDensity             ) ) ,
@@ -522,6 +551,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
         """Set options for the model."""
         if "dampingCutOff"      in options: self.dampingCutOff      = options.pop ( "dampingCutOff"      )
         if "electrostaticModel" in options: self.electrostaticModel = options.pop ( "electrostaticModel" )
+        if "ewaldKappa"         in options: self.ewaldKappa         = options.pop ( "ewaldKappa"         )
         if "innerCutOff"        in options: self.innerCutOff        = options.pop ( "innerCutOff"        )
         if "outerCutOff"        in options: self.outerCutOff        = options.pop ( "outerCutOff"        )
         if "pointDensity"       in options: self.pointDensity       = options.pop ( "pointDensity"       )
@@ -529,6 +559,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
         if "width2"             in options: self.width2             = options.pop ( "width2"             )
         if len ( options ) > 0: raise NBModelError ( "Invalid options: " + ", ".join ( sorted ( options.keys ( ) ) ) + "." )
         self._CheckOptions ( )
+        PairwiseInteractionSpline_DeassignSplines ( self.cObject ) # . The existing splines, if any, are owned by their Python objects.
         self.electrostaticSpline = self.MakeElectrostaticSpline ( )
         self.lennardJonesASpline = self.MakeLennardJonesASpline ( )
         self.lennardJonesBSpline = self.MakeLennardJonesBSpline ( )
@@ -542,6 +573,7 @@ cdef class PairwiseInteractionSplineABFS ( PairwiseInteraction ):
         """Summary items."""
         return [ ( "Damping Cut-Off"      , "{:.3f}".format ( self.dampingCutOff            ) ) ,
                  ( "Electrostatic Model"  , self.electrostaticModel.name.replace ( "_", "/" ) ) ,
+                 ( "Ewald Kappa"          , "{:.3f}".format ( self.ewaldKappa               ) ) ,
                  ( "Inner Cut-Off"        , "{:.3f}".format ( self.innerCutOff              ) ) ,
                  ( "Outer Cut-Off"        , "{:.3f}".format ( self.outerCutOff              ) ) ,
                  ( "Spline Point Density" , "{:d}"  .format ( self.pointDensity             ) ) ,
@@ -0,0 +1,30 @@
+from pCore.CPrimitiveTypes                           cimport CReal
+from pCore.Status                                    cimport CStatus                     , \
+                                                             CStatus_OK
+from pMolecule.NBModel.ImagePairListContainer        cimport CImagePairListContainer     , \
+                                                             ImagePairListContainer
+from pScientific.Arrays.RealArray1D                  cimport CRealArray1D                , \
+                                                             RealArray1D
+from pScientific.Arrays.RealArray2D                  cimport CRealArray2D
+from pScientific.Geometry3.Coordinates3              cimport Coordinates3
+from pScientific.Symmetry.SymmetryParameters         cimport CSymmetryParameters         , \
+                                                             SymmetryParameters
+from pScientific.Symmetry.SymmetryParameterGradients cimport CSymmetryParameterGradients , \
+                                                             SymmetryParameterGradients
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "QCDispersionDFTD2Image.h":
+
+    cdef CReal CQCDispersionDFTD2Image_Energy "QCDispersionDFTD2Image_Energy" ( CReal                        s6                         ,
+                                                                                CReal                        sR                         ,
+                                                                                CReal                        dR                         ,
+                                                                                CRealArray1D                *sqrtC6                     ,
+                                                                                CRealArray1D                *r0                         ,
+                                                                                CRealArray2D                *coordinates3               ,
+                                                                                CSymmetryParameters         *symmetryParameters         ,
+                                                                                CImagePairListContainer     *imagePairLists             ,
+                                                                                CRealArray2D                *gradients3                 ,
+                                                                                CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                                                CStatus                     *status                     )
@@ -0,0 +1,36 @@
+"""DFT-D2 QC dispersion image energy."""
+
+from .NBModelError import NBModelError
+
+#===================================================================================================================================
+# . Function.
+#===================================================================================================================================
+def QCDispersionDFTD2Image_Energy ( s6, sR, dR, RealArray1D                sqrtC6                     not None ,
+                                                RealArray1D                r0                         not None ,
+                                                Coordinates3               coordinates3               not None ,
+                                                SymmetryParameters         symmetryParameters         not None ,
+                                                ImagePairListContainer     imagePairLists             not None ,
+                                                Coordinates3               gradients3                          ,
+                                                SymmetryParameterGradients symmetryParameterGradients          ):
+    """DFT-D2 image energy."""
+    cdef CReal                        energy
+    cdef CRealArray2D                *cGradients3                 = NULL
+    cdef CSymmetryParameterGradients *cSymmetryParameterGradients = NULL
+    cdef CStatus                      cStatus                     = CStatus_OK
+    if ( gradients3                 is not None ) and \
+       ( symmetryParameterGradients is not None ):
+        cGradients3                 = gradients3.cObject
+        cSymmetryParameterGradients = symmetryParameterGradients.cObject
+    energy = CQCDispersionDFTD2Image_Energy ( s6                         ,
+                                              sR                         ,
+                                              dR                         ,
+                                              sqrtC6.cObject             ,
+                                              r0.cObject                 ,
+                                              coordinates3.cObject       ,
+                                              symmetryParameters.cObject ,
+                                              imagePairLists.cObject     ,
+                                              cGradients3                ,
+                                              cSymmetryParameterGradients ,
+                                              &cStatus                   )
+    if cStatus != CStatus_OK: raise NBModelError ( "Error evaluating DFT-D2 image energy." )
+    return energy
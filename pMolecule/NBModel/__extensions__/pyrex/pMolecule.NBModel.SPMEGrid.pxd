@@ -0,0 +1,78 @@
+from pCore.CPrimitiveTypes                           cimport CInteger                    , \
+                                                             CReal
+from pCore.PairList                                  cimport CPairList                   , \
+                                                             PairList
+from pCore.Status                                    cimport CStatus                     , \
+                                                             CStatus_OK
+from pScientific.Arrays.RealArray1D                  cimport CRealArray1D                , \
+                                                             RealArray1D
+from pScientific.Arrays.RealArray2D                  cimport CRealArray2D
+from pScientific.Geometry3.Coordinates3              cimport Coordinates3
+from pScientific.Geometry3.RegularGrid               cimport CRegularGrid
+from pScientific.Symmetry.SymmetryParameters         cimport CSymmetryParameters         , \
+                                                             SymmetryParameters
+from pScientific.Symmetry.SymmetryParameterGradients cimport CSymmetryParameterGradients , \
+                                                             SymmetryParameterGradients
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "SPMEGrid.h":
+
+    ctypedef struct CSPMEGrid "SPMEGrid":
+        CInteger      order
+        CReal         kappa
+        CRegularGrid *grid
+
+    cdef CReal      SPMEGrid_CrossEnergy            ( CSPMEGrid                   *self                       ,
+                                                      CReal                        electrostaticScale         ,
+                                                      CRealArray1D                *chargesA                   ,
+                                                      CRealArray1D                *chargesB                   ,
+                                                      CRealArray2D                *coordinates3A              ,
+                                                      CRealArray2D                *coordinates3B              ,
+                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                      CRealArray2D                *gradients3A                ,
+                                                      CRealArray2D                *gradients3B                ,
+                                                      CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                      CStatus                     *status                     )
+    cdef void       SPMEGrid_Deallocate             ( CSPMEGrid                  **self                       )
+    cdef CReal      SPMEGrid_Energy                 ( CSPMEGrid                   *self                       ,
+                                                      CReal                        electrostaticScale         ,
+                                                      CRealArray1D                *charges                    ,
+                                                      CRealArray2D                *coordinates3               ,
+                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                      CRealArray2D                *gradients3                 ,
+                                                      CSymmetryParameterGradients *symmetryParameterGradients ,
+                                                      CStatus                     *status                     )
+    cdef void       SPMEGrid_Extents                ( CSymmetryParameters         *symmetryParameters         ,
+                                                      CReal                        gridSpacing                ,
+                                                      CInteger                     order                      ,
+                                                      CInteger                    *extents                    )
+    cdef CSPMEGrid *SPMEGrid_FromSymmetryParameters ( CSymmetryParameters         *symmetryParameters         ,
+                                                      CReal                        gridSpacing                ,
+                                                      CInteger                     order                      ,
+                                                      CReal                        kappa                      ,
+                                                      CStatus                     *status                     )
+    cdef CReal      SPMEGrid_PairCorrection         ( CSPMEGrid                   *self                       ,
+                                                      CReal                        electrostaticScale         ,
+                                                      CRealArray1D                *charges                    ,
+                                                      CRealArray2D                *coordinates3               ,
+                                                      CPairList                   *pairList                   ,
+                                                      CRealArray2D                *gradients3                 ,
+                                                      CStatus                     *status                     )
+    cdef void       SPMEGrid_Potentials             ( CSPMEGrid                   *self                       ,
+                                                      CReal                        electrostaticScale         ,
+                                                      CRealArray1D                *charges                    ,
+                                                      CRealArray2D                *coordinates3               ,
+                                                      CRealArray2D                *pointCoordinates3          ,
+                                                      CSymmetryParameters         *symmetryParameters         ,
+                                                      CRealArray1D                *potentials                 ,
+                                                      CStatus                     *status                     )
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class SPMEGrid:
+
+    cdef CSPMEGrid     *cObject
+    cdef public object  isOwner
@@ -0,0 +1,154 @@
+"""Smooth particle-mesh Ewald grid."""
+
+from .NBModelError import NBModelError
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class SPMEGrid:
+    """Smooth particle-mesh Ewald grid."""
+
+    def __dealloc__ ( self ):
+        """Finalization."""
+        if self.isOwner:
+            SPMEGrid_Deallocate ( &self.cObject )
+            self.isOwner = False
+
+    def __init__ ( self ):
+        """Constructor."""
+        self._Initialize ( )
+
+    def _Initialize ( self ):
+        """Initialization."""
+        self.cObject = NULL
+        self.isOwner = False
+
+    def CrossEnergy ( self, electrostaticScale                                               ,
+                            RealArray1D                chargesA                   not None ,
+                            RealArray1D                chargesB                   not None ,
+                            Coordinates3               coordinates3A              not None ,
+                            Coordinates3               coordinates3B              not None ,
+                            SymmetryParameters         symmetryParameters         not None ,
+                            Coordinates3               gradients3A                         ,
+                            Coordinates3               gradients3B                         ,
+                            SymmetryParameterGradients symmetryParameterGradients          ):
+        """The reciprocal space and background energy between two sets of charges."""
+        cdef CReal                        energy
+        cdef CRealArray2D                *cGradients3A                = NULL
+        cdef CRealArray2D                *cGradients3B                = NULL
+        cdef CSymmetryParameterGradients *cSymmetryParameterGradients = NULL
+        cdef CStatus                      cStatus                     = CStatus_OK
+        if gradients3A                is not None: cGradients3A                = gradients3A.cObject
+        if gradients3B                is not None: cGradients3B                = gradients3B.cObject
+        if symmetryParameterGradients is not None: cSymmetryParameterGradients = symmetryParameterGradients.cObject
+        energy = SPMEGrid_CrossEnergy ( self.cObject                ,
+                                        electrostaticScale          ,
+                                        chargesA.cObject            ,
+                                        chargesB.cObject            ,
+                                        coordinates3A.cObject       ,
+                                        coordinates3B.cObject       ,
+                                        symmetryParameters.cObject  ,
+                                        cGradients3A                ,
+                                        cGradients3B                ,
+                                        cSymmetryParameterGradients ,
+                                        &cStatus                    )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error evaluating SPME cross energy." )
+        return energy
+
+    def Energy ( self, electrostaticScale                                               ,
+                       RealArray1D                charges                    not None ,
+                       Coordinates3               coordinates3               not None ,
+                       SymmetryParameters         symmetryParameters         not None ,
+                       Coordinates3               gradients3                          ,
+                       SymmetryParameterGradients symmetryParameterGradients          ):
+        """The reciprocal space, self and background energy of a set of charges."""
+        cdef CReal                        energy
+        cdef CRealArray2D                *cGradients3                 = NULL
+        cdef CSymmetryParameterGradients *cSymmetryParameterGradients = NULL
+        cdef CStatus                      cStatus                     = CStatus_OK
+        if gradients3                 is not None: cGradients3                 = gradients3.cObject
+        if symmetryParameterGradients is not None: cSymmetryParameterGradients = symmetryParameterGradients.cObject
+        energy = SPMEGrid_Energy ( self.cObject                ,
+                                   electrostaticScale          ,
+                                   charges.cObject             ,
+                                   coordinates3.cObject        ,
+                                   symmetryParameters.cObject  ,
+                                   cGradients3                 ,
+                                   cSymmetryParameterGradients ,
+                                   &cStatus                    )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error evaluating SPME energy." )
+        return energy
+
+    @staticmethod
+    def ExtentsFromSymmetryParameters ( SymmetryParameters symmetryParameters not None, gridSpacing, order ):
+        """The number of grid points along each dimension for a set of symmetry parameters."""
+        cdef CInteger extents[3]
+        if gridSpacing <= 0.0: raise NBModelError ( "Invalid SPME grid spacing." )
+        SPMEGrid_Extents ( symmetryParameters.cObject, gridSpacing, order, extents )
+        return [ extents[0], extents[1], extents[2] ]
+
+    @classmethod
+    def FromSymmetryParameters ( selfClass, SymmetryParameters symmetryParameters not None, gridSpacing, order, kappa ):
+        """Constructor given symmetry parameters."""
+        cdef SPMEGrid   self
+        cdef CSPMEGrid *cObject = NULL
+        cdef CStatus    cStatus = CStatus_OK
+        cObject = SPMEGrid_FromSymmetryParameters ( symmetryParameters.cObject, gridSpacing, order, kappa, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error creating SPME grid." )
+        self         = selfClass.Raw ( )
+        self.cObject = cObject
+        self.isOwner = True
+        return self
+
+    def PairCorrection ( self, electrostaticScale                      ,
+                               RealArray1D  charges      not None ,
+                               Coordinates3 coordinates3 not None ,
+                               PairList     pairList     not None ,
+                               Coordinates3 gradients3            ):
+        """The erf ( kappa r ) / r energy of a set of pairs."""
+        cdef CReal         energy
+        cdef CRealArray2D *cGradients3 = NULL
+        cdef CStatus       cStatus     = CStatus_OK
+        if gradients3 is not None: cGradients3 = gradients3.cObject
+        energy = SPMEGrid_PairCorrection ( self.cObject, electrostaticScale, charges.cObject, coordinates3.cObject, pairList.cObject, cGradients3, &cStatus )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error evaluating SPME pair correction." )
+        return energy
+
+    def Potentials ( self, electrostaticScale                                       ,
+                           RealArray1D        charges            not None ,
+                           Coordinates3       coordinates3       not None ,
+                           Coordinates3       pointCoordinates3  not None ,
+                           SymmetryParameters symmetryParameters not None ,
+                           RealArray1D        potentials         not None ):
+        """Increment the potentials at a set of points (in atomic units)."""
+        cdef CStatus cStatus = CStatus_OK
+        SPMEGrid_Potentials ( self.cObject                ,
+                              electrostaticScale          ,
+                              charges.cObject             ,
+                              coordinates3.cObject        ,
+                              pointCoordinates3.cObject   ,
+                              symmetryParameters.cObject  ,
+                              potentials.cObject          ,
+                              &cStatus                    )
+        if cStatus != CStatus_OK: raise NBModelError ( "Error evaluating SPME potentials." )
+
+    @classmethod
+    def Raw ( selfClass ):
+        """Raw constructor."""
+        self = selfClass.__new__ ( selfClass )
+        self._Initialize ( )
+        return self
+
+    # . Properties.
+    @property
+    def kappa ( self ):
+        if self.cObject == NULL: return 0.0
+        else:                    return self.cObject.kappa
+    @property
+    def order ( self ):
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.order
+    @property
+    def shape ( self ):
+        if self.cObject == NULL: return None
+        else:                    return [ self.cObject.grid.dimensions[d].bins for d in range ( 3 ) ]
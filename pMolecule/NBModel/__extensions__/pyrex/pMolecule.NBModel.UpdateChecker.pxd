@@ -22,18 +22,22 @@ cdef extern from "UpdateChecker.h":
     ctypedef struct CUpdateChecker "UpdateChecker":
         CReal buffer
 
-    cdef CUpdateChecker *UpdateChecker_Allocate            ( CStatus                 *status              )
-    cdef CBoolean        UpdateChecker_CheckForImageUpdate ( CSymmetryParameters     *set1                ,
-                                                             CSymmetryParameters     *set2                ,
-                                                             CImagePairListContainer *images              ,
-                                                             CReal                    buffer              ,
-                                                             CReal                    maximumDisplacement )
-    cdef CBoolean        UpdateChecker_CheckForUpdate      ( CRealArray2D            *set1                ,
-                                                             CRealArray2D            *set2                ,
-                                                             CSelection              *freeAtoms           ,
-                                                             CReal                    buffer              ,
-                                                             CReal                   *maximumDisplacement )
-    cdef void            UpdateChecker_Deallocate          ( CUpdateChecker         **self                )
+    cdef CUpdateChecker *UpdateChecker_Allocate              ( CStatus                 *status              )
+    cdef CBoolean        UpdateChecker_CheckForImageUpdate   ( CSymmetryParameters     *set1                ,
+                                                               CSymmetryParameters     *set2                ,
+                                                               CImagePairListContainer *images              ,
+                                                               CReal                    buffer              ,
+                                                               CReal                    maximumDisplacement )
+    cdef CBoolean        UpdateChecker_CheckForUpdate        ( CRealArray2D            *set1                ,
+                                                               CRealArray2D            *set2                ,
+                                                               CSelection              *freeAtoms           ,
+                                                               CReal                    buffer              ,
+                                                               CReal                   *maximumDisplacement )
+    cdef void            UpdateChecker_Deallocate            ( CUpdateChecker         **self                )
+    cdef void            UpdateChecker_UpdateMovedReferences ( CRealArray2D            *set1                ,
+                                                               CRealArray2D            *set2                ,
+                                                               CSelection              *freeAtoms           ,
+                                                               CReal                    buffer              )
 
 #===================================================================================================================================
 # . Class.
@@ -5,7 +5,8 @@ from pCore                        import Clone                , \
                                          LogFileActive        , \
                                          RawObjectConstructor
 from pMolecule.NBModel            import NBModelError
-from pMolecule.NBModel.NBDefaults import _NumberOfCalls       , \
+from pMolecule.NBModel.NBDefaults import _IncrementalPairList , \
+                                         _NumberOfCalls       , \
                                          _NumberOfUpdates     , \
                                          _PairListStatistics  , \
                                          _UpdatablePairLists  , \
@@ -54,7 +55,7 @@ cdef class UpdateChecker:
         self.cObject = NULL
         self.isOwner = False
 
-    def Check ( self, target ):
+    def Check ( self, target, isIncremental = False ):
         """Check for an update."""
         cdef Coordinates3            coordinates3
         cdef Coordinates3            rCoordinates3
@@ -82,6 +83,7 @@ cdef class UpdateChecker:
                 uNode.symmetryParameters = rSymmetryParameters
         # . Pairlist data.
         doUpdate = ( not uNodeExists ) or ( not hasattr ( scratch, _UpdatablePairLists ) )
+        isForced = doUpdate
         pNode    = scratch.GetSetNode ( _UpdatablePairLists )
         if not doUpdate:
             freeAtoms = target.freeAtoms
@@ -107,8 +109,16 @@ cdef class UpdateChecker:
         if doUpdate:
             scratch.Delete ( _UpdatablePairLists )
             sNode[_NumberOfUpdates] += 1
-            coordinates3.CopyTo ( rCoordinates3 )
-            if symmetryParameters is not None: symmetryParameters.CopyTo ( rSymmetryParameters )
+            # . Incremental pair-lists keep the reference coordinates of particles that have not moved far.
+            if isIncremental and ( not isForced ) and ( symmetryParameters is None ):
+                UpdateChecker_UpdateMovedReferences ( coordinates3.cObject  ,
+                                                      rCoordinates3.cObject ,
+                                                      cFreeAtoms            ,
+                                                      self.cObject.buffer   )
+            else:
+                uNode.Delete ( _IncrementalPairList )
+                coordinates3.CopyTo ( rCoordinates3 )
+                if symmetryParameters is not None: symmetryParameters.CopyTo ( rSymmetryParameters )
 
     @classmethod
     def WithOptions ( selfClass, **options ):
@@ -1,11 +1,16 @@
 """A sub-package for NB models."""
 
-# . To be implemented (possibly): fast Ewald and minimum image.
-
 from .ABFSIntegrator                                 import ABFSIntegrator
+from .AtomOrdering                                   import AtomOrdering
+from .ClusterPairList                                import ClusterPairList
+from .FMMTree                                        import FMMTree
 from .ImagePairListContainer                         import ImagePairListContainer
 from .ImageScanContainer                             import ImageScanContainer
+from .IncrementalPairList                            import IncrementalPairList
+from .MinimumImagePairList                           import MinimumImagePairList_SelfFromCoordinates3
 from .MNDOQCMMImageEvaluator                         import MNDOQCMMImageEvaluator
+from .QCDispersionDFTD2Image                         import QCDispersionDFTD2Image_Energy
+from .SPMEGrid                                       import SPMEGrid
 
 from .NBModel                                        import NBModel
 from .NBModelCutOff                                  import NBModelCutOff
@@ -13,6 +18,7 @@ from .NBModelDFTB                                    import NBModelDFTB
 from .NBModelFull                                    import NBModelFull
 from .NBModelMonteCarlo                              import NBModelMonteCarlo
 from .NBModelORCA                                    import NBModelORCA
+from .NBModelSPME                                    import NBModelSPME
 
 from .PairwiseInteraction                            import PairwiseInteraction
 from .PairwiseInteractionABFS                        import PairwiseInteractionABFS
@@ -31,6 +37,7 @@ from .QCMMElectrostaticModelDFTB                     import QCMMElectrostaticMod
 from .QCMMElectrostaticModelMultipoleBase            import QCMMElectrostaticModelMultipoleBase
 from .QCMMElectrostaticModelMultipoleCutOff          import QCMMElectrostaticModelMultipoleCutOff
 from .QCMMElectrostaticModelMultipoleFull            import QCMMElectrostaticModelMultipoleFull
+from .QCMMElectrostaticModelMultipoleSPME            import QCMMElectrostaticModelMultipoleSPME
 from .QCMMElectrostaticModelORCA                     import QCMMElectrostaticModelORCA
 from .QCQCElectrostaticModelMultipoleCutOff          import QCQCElectrostaticModelMultipoleCutOff
 
@@ -23,8 +23,9 @@ from  pCore                     import AttributableObject          , \
 from  pScientific.Arrays        import Array                       , \
                                        StorageType
 from  pScientific.LinearAlgebra import CGLinearEquationSolver      , \
-                                       CGLinearEquationSolverState
+                                       CGLinearEquationSolverBlockState
 from .CICPHF                    import CICPHF_ApplyCPHFMatrix      , \
+                                       CICPHF_ApplyCPHFMatrices    , \
                                        CICPHF_CalculateCPHFVectors , \
                                        CICPHF_Transform
 
@@ -63,16 +64,16 @@ class CPHFSolver ( AttributableObject ):
                              "qR"                        : None ,
                              "rhs"                       : None ,
                              "solver"                    : None ,
-                             "solverState"               : None ,
                              "target"                    : None ,
                              "twoElectronIntegrals"      : None ,
                              "twoPDM"                    : None ,
                              "warnings"                  : None ,
                              "work1"                     : None ,
                              "work2"                     : None ,
-                             "zMatrix"                   : None } )
+                             "zMatrix"                   : None ,
+                             "zNR"                       : None } )
 
-    # . The following two methods are needed by the CG solver. 
+    # . The following three methods are needed by the CG solvers. 
     def ApplyMatrix ( self, x, y ):
         """Apply the A matrix to x and put in y."""
         CICPHF_ApplyCPHFMatrix ( self.numberNonRedundant   ,
@@ -87,11 +88,51 @@ class CPHFSolver ( AttributableObject ):
                                  self.work2                ,
                                  y                         )
 
+    def ApplyMatrices ( self, x, y ):
+        """Apply the A matrix to the rows of x and put in the rows of y."""
+        CICPHF_ApplyCPHFMatrices ( self.numberNonRedundant   ,
+                                   self.indicesNR            ,
+                                   self.numberNonRedundant   ,
+                                   self.indicesNR            ,
+                                   self.aDiagonal            ,
+                                   x                         ,
+                                   self.orbitals             ,
+                                   self.twoElectronIntegrals ,
+                                   self.work1                ,
+                                   self.work2                ,
+                                   y                         )
+
     def ApplyPreconditioner ( self, x, y ):
         """Apply the diagonal preconditioner to x and put in y."""
         x.CopyTo ( y )
         y.Multiply ( self.preconditioner )
 
+    def CalculateCPHFVectors ( self ):
+        """Calculate the CPHF vectors for the current densities of the target."""
+        ( self.numberDegenerateRedundant, self.numberRedundant ) = CICPHF_CalculateCPHFVectors ( self.nActive                   ,
+                                                                                                 self.nCore                     ,
+                                                                                                 self.nOrbitals                 ,
+                                                                                                 self.twoElectronIntegrals      ,
+                                                                                                 self.twoPDM                    ,
+                                                                                                 self.energies                  ,
+                                                                                                 self.occupancies               ,
+                                                                                                 self.orbitals                  ,
+                                                                                                 self.moTEI234                  ,
+                                                                                                 self.fCore                     ,
+                                                                                                 self.onePDM                    ,
+                                                                                                 self.onePDMMO                  ,
+                                                                                                 self.work1                     ,
+                                                                                                 self.work2                     ,
+                                                                                                 self.numberDegenerateRedundant ,
+                                                                                                 self.numberNonRedundant        ,
+                                                                                                 self.numberRedundant           ,
+                                                                                                 self.indicesNR                 ,
+                                                                                                 self.indicesR                  ,
+                                                                                                 self.aDiagonal                 ,
+                                                                                                 self.qNR                       ,
+                                                                                                 self.qR                        ,
+                                                                                                 self.preconditioner            )
+
     @classmethod
     def FromTarget ( selfClass, target ):
         """Constructor from target."""
@@ -155,7 +196,8 @@ class CPHFSolver ( AttributableObject ):
             self.indicesNR      = Array.WithExtents ( numberNonRedundant , 2, dataType = DataType.Integer )
             self.aDiagonal      = Array.WithExtent  ( numberNonRedundant )
             self.qNR            = Array.WithExtent  ( numberNonRedundant )
-            self.rhs            = Array.WithExtent  ( numberNonRedundant )
+            self.rhs            = Array.WithExtents ( 1, numberNonRedundant )
+            self.zNR            = Array.WithExtents ( 1, numberNonRedundant )
             self.preconditioner = Array.WithExtent  ( numberNonRedundant )
         if self.numberRedundant != numberRedundant:
             self.indicesR       = Array.WithExtents ( numberRedundant , 2, dataType = DataType.Integer )
@@ -172,39 +214,11 @@ class CPHFSolver ( AttributableObject ):
     def Solve ( self ):
         """Solve the CPHF equations for zNR and form the Z-matrix."""
         # . Calculate the CPHF vectors.
-        ( self.numberDegenerateRedundant, self.numberRedundant ) = CICPHF_CalculateCPHFVectors ( self.nActive                   ,
-                                                                                                 self.nCore                     ,
-                                                                                                 self.nOrbitals                 ,
-                                                                                                 self.twoElectronIntegrals      ,
-                                                                                                 self.twoPDM                    ,
-                                                                                                 self.energies                  ,
-                                                                                                 self.occupancies               ,
-                                                                                                 self.orbitals                  ,
-                                                                                                 self.moTEI234                  ,
-                                                                                                 self.fCore                     ,
-                                                                                                 self.onePDM                    ,
-                                                                                                 self.onePDMMO                  ,
-                                                                                                 self.work1                     ,
-                                                                                                 self.work2                     ,
-                                                                                                 self.numberDegenerateRedundant ,
-                                                                                                 self.numberNonRedundant        ,
-                                                                                                 self.numberRedundant           ,
-                                                                                                 self.indicesNR                 ,
-                                                                                                 self.indicesR                  ,
-                                                                                                 self.aDiagonal                 ,
-                                                                                                 self.qNR                       ,
-                                                                                                 self.qR                        ,
-                                                                                                 self.preconditioner            )
-        # . Initialize target arrays. 
-        self.qNR.CopyTo ( self.rhs )  # . RHS. 
-        self.qNR.Set    ( 0.0      )  # . Initial guess at solution.
-        # . Set up the solver.
-        if self.solver is None:
-            self.solver      = CGLinearEquationSolver ( )
-            self.solverState = CGLinearEquationSolverState.FromTarget ( self, self.rhs, self.qNR, doPreconditioning = True )
-        # . Solve. 
-        self.report = self.solver.Solve ( self.solverState )
-        if not self.report["Is Converged"]: self.warnings.append ( "CPHF calculation not converged." )
+        self.CalculateCPHFVectors ( )
+        # . Solve.
+        self.qNR.CopyTo ( self.rhs[0,:] )
+        self.report = self.SolveZVectors ( self.rhs, self.zNR )
+        self.zNR[0,:].CopyTo ( self.qNR )
         # . Extract Z and convert to AO basis. 
         CICPHF_Transform ( self.numberNonRedundant ,
                            self.indicesNR          ,
@@ -217,6 +231,19 @@ class CPHFSolver ( AttributableObject ):
                            self.work1              ,
                            self.zMatrix            )
 
+    def SolveZVectors ( self, rhs, zVectors ):
+        """Solve the CPHF equations for several right-hand sides together.
+
+        The right-hand sides and solutions are the rows of rhs and zVectors. The CPHF vectors must have been calculated
+        beforehand so that aDiagonal and the preconditioner, which are common to all right-hand sides, are available.
+        """
+        if self.solver is None: self.solver = CGLinearEquationSolver ( )
+        zVectors.Set ( 0.0 ) # . Initial guess at solution.
+        state  = CGLinearEquationSolverBlockState.FromTarget ( self, rhs, zVectors, doPreconditioning = True )
+        report = self.solver.SolveBlock ( state )
+        if not report["Is Converged"]: self.warnings.append ( "CPHF calculation not converged." )
+        return report
+
 #===================================================================================================================================
 # . Testing.
 #===================================================================================================================================
@@ -55,6 +55,9 @@ extern void          BlockStorage_Deallocate (       BlockStorage **self
 extern void          BlockStorage_Empty      (       BlockStorage  *self              ) ;
 extern Real          BlockStorage_ByteSize   (       BlockStorage  *self              ) ;
 extern Block        *BlockStorage_Iterate    (       BlockStorage  *self              ) ;
+extern void          BlockStorage_Merge      (       BlockStorage  *self              ,
+                                                     BlockStorage  *other             ,
+                                                     Status        *status            ) ;
 extern void          BlockStorage_Print      (       BlockStorage  *self              ) ;
 
 # endif
@@ -2,6 +2,7 @@
 # define _GAUSSIANBASISCONTAINER
 
 # include "Boolean.h"
+# include "Coordinates3.h"
 # include "GaussianBasis.h"
 # include "Integer.h"
 # include "IntegerArray1D.h"
@@ -14,8 +15,11 @@
 ! . Definitions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 /* . The container type. */
+/* . If orderCenters is set, the integral drivers that support it loop over the centers in an order that groups centers
+!    which are close in space and have the same basis. The function order of the matrices is unaffected. */
 typedef struct {
     Boolean         isOwner                ;
+    Boolean         orderCenters           ;
     Integer         capacity               ;
     IntegerArray1D *centerFunctionPointers ;
     IntegerArray1D *functionCenters        ;
@@ -30,6 +34,9 @@ extern GaussianBasisContainer *GaussianBasisContainer_Allocate              ( co
 extern GaussianBasisContainer *GaussianBasisContainer_Clone                 ( const GaussianBasisContainer  *self                   ,
                                                                                     Status                  *status                 ) ;
 extern void                    GaussianBasisContainer_Deallocate            (       GaussianBasisContainer **self                   ) ;
+extern Integer                *GaussianBasisContainer_CenterOrder           ( const GaussianBasisContainer  *self                   ,
+                                                                              const Coordinates3            *coordinates3           ,
+                                                                                    Status                  *status                 ) ;
 extern Integer                 GaussianBasisContainer_LargestBasis          ( const GaussianBasisContainer  *self                   ,
                                                                               const Boolean                  forC                   ) ;
 extern Integer                 GaussianBasisContainer_LargestShell          ( const GaussianBasisContainer  *self                   ,
@@ -270,6 +270,31 @@ Block *BlockStorage_Iterate ( BlockStorage *self )
     else                return ( Block * ) List_Iterate ( self->blocks ) ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Move all the blocks of other to the end of self leaving other empty.
+! . Partially filled blocks are kept as is so that no data are copied.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void BlockStorage_Merge ( BlockStorage *self, BlockStorage *other, Status *status )
+{
+    if ( ( self != NULL ) && ( other != NULL ) && ( self != other ) && Status_IsOK ( status ) )
+    {
+        if ( ( self->nIndices16 == other->nIndices16 ) &&
+             ( self->nIndices32 == other->nIndices32 ) &&
+             ( self->nReal      == other->nReal      ) )
+        {
+            auto Block *block ;
+            while ( List_Size ( other->blocks ) > 0 )
+            {
+                block = ( Block * ) List_Element_Pop_By_Index ( other->blocks, 0 ) ;
+                if ( block != NULL ) List_Element_Append ( self->blocks, ( void * ) block ) ;
+            }
+            self->count += other->count ;
+            other->count = 0 ;
+        }
+        else Status_Set ( status, Status_InvalidArgument ) ;
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Print all block data.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -2,10 +2,32 @@
 ! . A container for Gaussian basis sets.
 !=================================================================================================================================*/
 
+# include <stdlib.h>
+
 # include "GaussianBasisContainer.h"
+# include "MachineTypes.h"
 # include "Memory.h"
 # include "NumericalMacros.h"
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The cell size and the number of bits per dimension for the center ordering. */
+# define _CenterOrderBits     10
+# define _CenterOrderCellSize 4.0e+00
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local types and procedures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . A center ordering record. */
+typedef struct {
+    Cardinal64 key          ;
+    Integer    atomicNumber ;
+    Integer    center       ;
+} CenterOrderRecord ;
+
+static Integer CenterOrderRecord_Compare ( const void *vRecord1, const void *vRecord2 ) ;
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Allocation.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -19,6 +41,7 @@ GaussianBasisContainer *GaussianBasisContainer_Allocate ( const Integer capacity
         self->entries                = NULL     ;
         self->functionCenters        = NULL     ;
         self->isOwner                = False    ;
+        self->orderCenters           = False    ;
         if ( capacity > 0 )
         {
             self->entries = Memory_AllocateArrayOfReferences ( capacity, GaussianBasis ) ;
@@ -34,6 +57,80 @@ GaussianBasisContainer *GaussianBasisContainer_Allocate ( const Integer capacity
     return self ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The order in which to loop over the centers.
+! . The natural order is returned unless orderCenters is set. Otherwise, the centers are sorted by the position of their cell
+!   along a Morton (Z-order) space-filling curve and then, within a cell, by atomic number so that centers with the same shells
+!   are together.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Integer *GaussianBasisContainer_CenterOrder ( const GaussianBasisContainer *self         ,
+                                              const Coordinates3           *coordinates3 ,
+                                                    Status                 *status       )
+{
+    Integer *order = NULL ;
+    if ( ( self != NULL ) && ( self->capacity > 0 ) && Status_IsOK ( status ) )
+    {
+        order = Memory_AllocateArrayOfTypes ( self->capacity, Integer ) ;
+        if ( order == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+        else
+        {
+            auto Integer i ;
+            for ( i = 0 ; i < self->capacity ; i++ ) order[i] = i ;
+            if ( self->orderCenters && ( coordinates3 != NULL ) )
+            {
+                auto CenterOrderRecord *records = Memory_AllocateArrayOfTypes ( self->capacity, CenterOrderRecord ) ;
+                if ( records == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+                else
+                {
+                    auto Cardinal64 cell, key, maximum = ( 1 << _CenterOrderBits ) - 1 ;
+                    auto Integer    b, c ;
+                    auto Real       lower[3], x ;
+                    for ( c = 0 ; c < 3 ; c++ ) lower[c] = Coordinates3_Item ( coordinates3, 0, c ) ;
+                    for ( i = 1 ; i < self->capacity ; i++ )
+                    {
+                        for ( c = 0 ; c < 3 ; c++ ) lower[c] = Minimum ( lower[c], Coordinates3_Item ( coordinates3, i, c ) ) ;
+                    }
+                    for ( i = 0 ; i < self->capacity ; i++ )
+                    {
+                        /* . Interleave the bits of the cell indices. */
+                        for ( c = 0, key = 0 ; c < 3 ; c++ )
+                        {
+                            x    = ( Coordinates3_Item ( coordinates3, i, c ) - lower[c] ) / _CenterOrderCellSize ;
+                            cell = Minimum ( ( Cardinal64 ) x, maximum ) ;
+                            for ( b = 0 ; b < _CenterOrderBits ; b++ ) key |= ( ( cell >> b ) & 1 ) << ( 3 * b + c ) ;
+                        }
+                        records[i].key          = key ;
+                        records[i].atomicNumber = self->entries[i]->atomicNumber ;
+                        records[i].center       = i ;
+                    }
+                    qsort ( ( void * ) records, ( size_t ) self->capacity, sizeof ( CenterOrderRecord ), ( void * ) CenterOrderRecord_Compare ) ;
+                    for ( i = 0 ; i < self->capacity ; i++ ) order[i] = records[i].center ;
+                    Memory_Deallocate ( records ) ;
+                }
+            }
+        }
+    }
+    return order ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Center ordering record comparison.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer CenterOrderRecord_Compare ( const void *vRecord1, const void *vRecord2 )
+{
+    CenterOrderRecord *record1 = ( CenterOrderRecord * ) vRecord1 ;
+    CenterOrderRecord *record2 = ( CenterOrderRecord * ) vRecord2 ;
+    Integer            i ;
+         if ( record1->key          < record2->key          ) i = -1 ;
+    else if ( record1->key          > record2->key          ) i =  1 ;
+    else if ( record1->atomicNumber < record2->atomicNumber ) i = -1 ;
+    else if ( record1->atomicNumber > record2->atomicNumber ) i =  1 ;
+    else if ( record1->center       < record2->center       ) i = -1 ;
+    else if ( record1->center       > record2->center       ) i =  1 ;
+    else i = 0 ;
+    return i ;
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Cloning (without index arrays).
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -46,7 +143,8 @@ GaussianBasisContainer *GaussianBasisContainer_Clone ( const GaussianBasisContai
         if ( clone != NULL )
         {
             auto Integer  i ;
-            clone->isOwner = self->isOwner ;
+            clone->isOwner      = self->isOwner      ;
+            clone->orderCenters = self->orderCenters ;
             if ( self->isOwner )
             {
                 for ( i = 0 ; i < self->capacity ; i++ )
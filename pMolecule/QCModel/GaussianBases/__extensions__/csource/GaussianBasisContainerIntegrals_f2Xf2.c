@@ -11,6 +11,7 @@
 # include "GaussianBasisIntegrals_f2Xf2.h"
 # include "Integer.h"
 # include "IntegerUtilities.h"
+# include "Memory.h"
 # include "RealUtilities.h"
 
 /*
@@ -82,7 +83,7 @@ void GaussianBasisContainerIntegrals_f2Cf2i ( const GaussianBasisContainer *self
          Status_IsOK ( status ) )
     {
         auto Block         *block ;
-        auto Integer        c, i, i0, *iWork, j, j0, k, k0, l, l0, n, s4 ;
+        auto Integer        c, i, i0, iO, *iWork, j, j0, jO, k, k0, kO, l, l0, lO, n, *order = NULL, s4 ;
         auto GaussianBasis *iBasis, *jBasis, *kBasis, *lBasis ;
         auto Real           d, *rI, rIJ[3], rIJ2, *rJ, *rK, rKL[3], rKL2, *rL, *rWork ;
         /* . Initialization. */
@@ -98,32 +99,37 @@ void GaussianBasisContainerIntegrals_f2Cf2i ( const GaussianBasisContainer *self
         s4    = n*n*n*n ;
         iWork = Integer_Allocate ( 3*s4, status ) ;
         rWork = Real_Allocate    ( 3*s4, status ) ;
+        order = GaussianBasisContainer_CenterOrder ( self, coordinates3, status ) ;
         if ( ! Status_IsOK ( status ) ) goto FinishUp ;
-        /* . Quadruple loop over centers. */
-        for ( i = 0 ; i < self->capacity ; i++ )
+        /* . Quadruple loop over centers in the container's order. */
+        for ( iO = 0 ; iO < self->capacity ; iO++ )
         {
+            i      = order[iO] ;
             iBasis = self->entries[i] ;
             i0     = Array1D_Item ( self->centerFunctionPointers, i ) ;
             rI     = Coordinates3_RowPointer ( coordinates3, i ) ;
-            for ( j = 0 ; j <= i ; j++ )
+            for ( jO = 0 ; jO <= iO ; jO++ )
             {
+                j      = order[jO] ;
                 jBasis = self->entries[j] ;
                 j0     = Array1D_Item ( self->centerFunctionPointers, j ) ;
                 rJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
                 for ( c = 0, rIJ2 = 0.0e+00 ; c < 3 ; c++ ) { d = rI[c] - rJ[c] ; rIJ[c] = d ; rIJ2 += d * d ; }
-                for ( k = 0 ; k <= i ; k++ )
+                for ( kO = 0 ; kO <= iO ; kO++ )
                 {
+                    k      = order[kO] ;
                     kBasis = self->entries[k] ;
                     k0     = Array1D_Item ( self->centerFunctionPointers, k ) ;
                     rK     = Coordinates3_RowPointer ( coordinates3, k ) ;
-                    for ( l = 0 ; l <= k ; l++ )
+                    for ( lO = 0 ; lO <= kO ; lO++ )
                     {
+                        l      = order[lO] ;
                         lBasis = self->entries[l] ;
                         l0     = Array1D_Item ( self->centerFunctionPointers, l ) ;
                         rL     = Coordinates3_RowPointer ( coordinates3, l ) ;
                         for ( c = 0, rKL2 = 0.0e+00 ; c < 3 ; c++ ) { d = rK[c] - rL[c] ; rKL[c] = d ; rKL2 += d * d ; }
 /* . Need flag for j < l. */
-                        GaussianBasisIntegrals_f2Cf2i ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( j < l ), s4, iWork, rWork, block ) ;
+                        GaussianBasisIntegrals_f2Cf2i ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( jO < lO ), s4, iWork, rWork, block ) ;
                         ProcessTEIs ( i0, j0, k0, l0, block, teis, status ) ;
                         if ( ! Status_IsOK ( status ) ) goto FinishUp ;
                     }
@@ -134,6 +140,7 @@ FinishUp:
         if ( ! Status_IsOK ( status ) ) BlockStorage_Deallocate ( &teis ) ;
         Block_Deallocate   ( &block ) ;
         Integer_Deallocate ( &iWork ) ;
+        Memory_Deallocate  (  order ) ;
         Real_Deallocate    ( &rWork ) ;
     }
 }
@@ -160,7 +167,7 @@ void GaussianBasisContainerIntegrals_f2Cf2R1 ( const GaussianBasisContainer *sel
     {
         auto Block         *block ;
         auto Boolean        doExchange ;
-        auto Integer        c, i, i0, *iWork, j, j0, k, k0, l, l0, n, s4 ;
+        auto Integer        c, i, i0, iO, *iWork, j, j0, jO, k, k0, kO, l, l0, lO, n, *order = NULL, s4 ;
         auto GaussianBasis *iBasis, *jBasis, *kBasis, *lBasis ;
         auto Real           d, *rI, rIJ[3], rIJ2, *rJ, *rK, rKL[3], rKL2, *rL, *rWork ;
         n     = GaussianBasisContainer_LargestBasis ( self, False ) ;
@@ -169,33 +176,38 @@ void GaussianBasisContainerIntegrals_f2Cf2R1 ( const GaussianBasisContainer *sel
         s4    = n*n*n*n ;
         iWork = Integer_Allocate (  6*s4, status ) ;
         rWork = Real_Allocate    ( 11*s4, status ) ;
+        order = GaussianBasisContainer_CenterOrder ( self, coordinates3, status ) ;
         if ( ! Status_IsOK ( status ) ) goto FinishUp ;
         doExchange = ( exchangeScaling != 0.0e+00 ) ;
-        /* . Quadruple loop over centers. */
-        for ( i = 0 ; i < self->capacity ; i++ )
+        /* . Quadruple loop over centers in the container's order. */
+        for ( iO = 0 ; iO < self->capacity ; iO++ )
         {
+            i      = order[iO] ;
             iBasis = self->entries[i] ;
             i0     = Array1D_Item ( self->centerFunctionPointers, i ) ;
             rI     = Coordinates3_RowPointer ( coordinates3, i ) ;
-            for ( j = 0 ; j <= i ; j++ )
+            for ( jO = 0 ; jO <= iO ; jO++ )
             {
+                j      = order[jO] ;
                 jBasis = self->entries[j] ;
                 j0     = Array1D_Item ( self->centerFunctionPointers, j ) ;
                 rJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
                 for ( c = 0, rIJ2 = 0.0e+00 ; c < 3 ; c++ ) { d = rI[c] - rJ[c] ; rIJ[c] = d ; rIJ2 += d * d ; }
-                for ( k = 0 ; k <= i ; k++ )
+                for ( kO = 0 ; kO <= iO ; kO++ )
                 {
+                    k      = order[kO] ;
                     kBasis = self->entries[k] ;
                     k0     = Array1D_Item ( self->centerFunctionPointers, k ) ;
                     rK     = Coordinates3_RowPointer ( coordinates3, k ) ;
-                    for ( l = 0 ; l <= k ; l++ )
+                    for ( lO = 0 ; lO <= kO ; lO++ )
                     {
+                        l      = order[lO] ;
                         lBasis = self->entries[l] ;
                         l0     = Array1D_Item ( self->centerFunctionPointers, l ) ;
                         rL     = Coordinates3_RowPointer ( coordinates3, l ) ;
                         for ( c = 0, rKL2 = 0.0e+00 ; c < 3 ; c++ ) { d = rK[c] - rL[c] ; rKL[c] = d ; rKL2 += d * d ; }
 /* . Need flag for j < l. */
-                        GaussianBasisIntegrals_f2Cf2r1 ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( j < l ), s4, iWork, rWork, block ) ;
+                        GaussianBasisIntegrals_f2Cf2r1 ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( jO < lO ), s4, iWork, rWork, block ) ;
                         ProcessTEIsD ( doCoulomb, doExchange, i, j, k, l, i0, j0, k0, l0, exchangeScaling, dTotal, dSpin, block, gradients3 ) ;
                     }
                 }
@@ -204,6 +216,7 @@ void GaussianBasisContainerIntegrals_f2Cf2R1 ( const GaussianBasisContainer *sel
 FinishUp:
         Block_Deallocate   ( &block ) ;
         Integer_Deallocate ( &iWork ) ;
+        Memory_Deallocate  (  order ) ;
         Real_Deallocate    ( &rWork ) ;
     }
 }
@@ -226,7 +239,7 @@ void GaussianBasisContainerIntegrals_f2Xf2i ( const GaussianBasisContainer *self
          Status_IsOK ( status ) )
     {
         auto Block         *block ;
-        auto Integer        c, i, i0, *iWork, j, j0, k, k0, l, l0, n, s4 ;
+        auto Integer        c, i, i0, iO, *iWork, j, j0, jO, k, k0, kO, l, l0, lO, n, *order = NULL, s4 ;
         auto GaussianBasis *iBasis, *jBasis, *kBasis, *lBasis ;
         auto Real           d, *rI, rIJ[3], rIJ2 = 0.0e+00, *rJ, *rK, rKL[3], rKL2 = 0.0e+00, *rL, *rWork ;
         /* . Initialization. */
@@ -243,15 +256,18 @@ void GaussianBasisContainerIntegrals_f2Xf2i ( const GaussianBasisContainer *self
         iWork = Integer_Allocate ( 3*s4, status ) ;
         if ( operator == GaussianBasisOperator_Overlap ) rWork = Real_Allocate ( 2*s4, status ) ;
         else                                             rWork = Real_Allocate ( 3*s4, status ) ;
+        order = GaussianBasisContainer_CenterOrder ( self, coordinates3, status ) ;
         if ( ! Status_IsOK ( status ) ) goto FinishUp ;
-        /* . Quadruple loop over centers. */
-        for ( i = 0 ; i < self->capacity ; i++ )
+        /* . Quadruple loop over centers in the container's order. */
+        for ( iO = 0 ; iO < self->capacity ; iO++ )
         {
+            i      = order[iO] ;
             iBasis = self->entries[i] ;
             i0     = Array1D_Item ( self->centerFunctionPointers, i ) ;
             rI     = Coordinates3_RowPointer ( coordinates3, i ) ;
-            for ( j = 0 ; j <= i ; j++ )
+            for ( jO = 0 ; jO <= iO ; jO++ )
             {
+                j      = order[jO] ;
                 jBasis = self->entries[j] ;
                 j0     = Array1D_Item ( self->centerFunctionPointers, j ) ;
                 rJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
@@ -259,13 +275,15 @@ void GaussianBasisContainerIntegrals_f2Xf2i ( const GaussianBasisContainer *self
                 {
                     for ( c = 0, rIJ2 = 0.0e+00 ; c < 3 ; c++ ) { d = rI[c] - rJ[c] ; rIJ[c] = d ; rIJ2 += d * d ; }
                 }
-                for ( k = 0 ; k <= i ; k++ )
+                for ( kO = 0 ; kO <= iO ; kO++ )
                 {
+                    k      = order[kO] ;
                     kBasis = self->entries[k] ;
                     k0     = Array1D_Item ( self->centerFunctionPointers, k ) ;
                     rK     = Coordinates3_RowPointer ( coordinates3, k ) ;
-                    for ( l = 0 ; l <= k ; l++ )
+                    for ( lO = 0 ; lO <= kO ; lO++ )
                     {
+                        l      = order[lO] ;
                         lBasis = self->entries[l] ;
                         l0     = Array1D_Item ( self->centerFunctionPointers, l ) ;
                         rL     = Coordinates3_RowPointer ( coordinates3, l ) ;
@@ -276,15 +294,15 @@ void GaussianBasisContainerIntegrals_f2Xf2i ( const GaussianBasisContainer *self
 /* . Need flag for j < l. */
                              if ( operator == GaussianBasisOperator_AntiCoulomb )
                         {
-                            GaussianBasisIntegrals_f2Af2i ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( j < l ), s4, iWork, rWork, block ) ;
+                            GaussianBasisIntegrals_f2Af2i ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( jO < lO ), s4, iWork, rWork, block ) ;
                         }
                         else if ( operator == GaussianBasisOperator_Coulomb )
                         {
-                            GaussianBasisIntegrals_f2Cf2i ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( j < l ), s4, iWork, rWork, block ) ;
+                            GaussianBasisIntegrals_f2Cf2i ( iBasis, rI, jBasis, rJ, rIJ, rIJ2, kBasis, rK, lBasis, rL, rKL, rKL2, ( jO < lO ), s4, iWork, rWork, block ) ;
                         }
                         else if ( operator == GaussianBasisOperator_Overlap )
                         {
-                            GaussianBasisIntegrals_f2Of2i ( iBasis, rI, jBasis, rJ,            kBasis, rK, lBasis, rL,            ( j < l ), s4, iWork, rWork, block ) ;
+                            GaussianBasisIntegrals_f2Of2i ( iBasis, rI, jBasis, rJ,            kBasis, rK, lBasis, rL,            ( jO < lO ), s4, iWork, rWork, block ) ;
                         }
                         ProcessTEIs ( i0, j0, k0, l0, block, teis, status ) ;
                         if ( ! Status_IsOK ( status ) ) goto FinishUp ;
@@ -296,6 +314,7 @@ FinishUp:
         if ( ! Status_IsOK ( status ) ) BlockStorage_Deallocate ( &teis ) ;
         Block_Deallocate   ( &block ) ;
         Integer_Deallocate ( &iWork ) ;
+        Memory_Deallocate  (  order ) ;
         Real_Deallocate    ( &rWork ) ;
     }
 }
@@ -15,13 +15,16 @@
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Static procedures.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-# ifndef _UseRealArray_
-static void Transform1 ( const Integer  dC       ,
-                         const Integer  dS       ,
-                         const Real    *T        ,
-                         const Real    *In       ,
-                               Real    *Out      ) ;
-# endif
+static void TransformAxpy ( const Integer  dI       ,
+                           const Integer  dC       ,
+                           const Integer  dS       ,
+                           const Real    *T        ,
+                           const Real    *In       ,
+                           const Integer  iStrideI ,
+                           const Integer  iStrideJ ,
+                                 Real    *Out      ,
+                           const Integer  oStrideI ,
+                           const Integer  oStrideJ ) ;
 static void Transform2 ( const Integer  dI       ,
                          const Integer  dC       ,
                          const Integer  dS       ,
@@ -71,7 +74,7 @@ void GaussianBasisTransform1 ( const RealArray2D *tI     ,
         RealArray2D_VectorMultiply ( True, 1.0e+00, tI, &viewIn, 0.0e+00, &viewOut, NULL ) ;
 # else
         dC  = tI->extent0 ; dS = tI->extent1 ; T = Array_DataPointer ( tI ) ;
-        Transform1 ( dC, dS, T, In, Out ) ;
+        Transform2 ( 1, dC, dS, T, In, dC, 1, Out, dS, 1 ) ;
 # endif
         (*values) = Out ;
         (*work  ) = In  ;
@@ -307,24 +310,70 @@ void GaussianBasisTransform4 (       Integer      dI     ,
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Subsidiary transformations.
 ! . All arrays are compact including T (strideC = dS, strideS = 1).
+! . Each transformation is a small matrix multiplication, Out(i,s) = Sum_c In(i,c) * T(c,s), in which i runs over all the
+!   untransformed indices of the block of integrals. Two kernels are used depending upon the layout of In:
+!   - when c is the fastest-running index, a dot-product kernel whose c loop is specialized at compile-time for each
+!     Cartesian shell size so that it can be fully unrolled;
+!   - otherwise, an axpy kernel with i innermost which also skips the zero elements of T. These are the majority for the
+!     Cartesian to spherical transformations of d and higher shells.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-# ifndef _UseRealArray_
-/* . 1-transform. */
-static void Transform1 ( const Integer  dC  ,
-                         const Integer  dS  ,
-                         const Real    *T   ,
-                         const Real    *In  ,
-                               Real    *Out )
+/* . The dot-product kernel. */
+# define _TransformDot( dC ) \
+    { \
+        auto Integer c, i, s ; \
+        auto Real    v ; \
+        for ( i = 0 ; i < dI ; i++ ) \
+        { \
+            auto const Real *inI  = &In [i*iStrideI] ; \
+            auto       Real *outI = &Out[i*oStrideI] ; \
+            for ( s = 0 ; s < dS ; s++ ) \
+            { \
+                for ( c = 0, v = 0.0e+00 ; c < dC ; c++ ) { v += ( T[c*dS+s] * inI[c] ) ; } \
+                outI[s*oStrideJ] = v ; \
+            } \
+        } \
+    }
+
+/* . The axpy kernel loop with unit and general strides. */
+# define _TransformAxpyLoop( operator ) \
+    if ( ( iStrideI == 1 ) && ( oStrideI == 1 ) ) { for ( i = 0 ; i < dI ; i++ ) outS[i]          operator ( t * inC[i]          ) ; } \
+    else                                          { for ( i = 0 ; i < dI ; i++ ) outS[i*oStrideI] operator ( t * inC[i*iStrideI] ) ; }
+
+/* . The axpy kernel. */
+static void TransformAxpy ( const Integer  dI       ,
+                            const Integer  dC       ,
+                            const Integer  dS       ,
+                            const Real    *T        ,
+                            const Real    *In       ,
+                            const Integer  iStrideI ,
+                            const Integer  iStrideJ ,
+                                  Real    *Out      ,
+                            const Integer  oStrideI ,
+                            const Integer  oStrideJ )
 {
-    Integer c, s ;
-    Real    v ;
+    Boolean     isFirst ;
+    Integer     c, i, s ;
+    Real        t ;
+    const Real *inC ;
+          Real *outS ;
     for ( s = 0 ; s < dS ; s++ )
     {
-        for ( c = 0, v = 0.0e+00 ; c < dC ; c++ ) { v += ( T[c*dS+s] * In[c] ) ; }
-        Out[s] = v ;
+        isFirst = True ;
+        outS    = &Out[s*oStrideJ] ;
+        for ( c = 0 ; c < dC ; c++ )
+        {
+            t = T[c*dS+s] ;
+            if ( t != 0.0e+00 )
+            {
+                inC = &In[c*iStrideJ] ;
+                if ( isFirst ) { _TransformAxpyLoop (  = ) ; isFirst = False ; }
+                else           { _TransformAxpyLoop ( += ) ; }
+            }
+        }
+        if ( isFirst ) { t = 0.0e+00 ; inC = In ; _TransformAxpyLoop ( = ) ; }
     }
 }
-# endif
+# undef _TransformAxpyLoop
 
 /* . 2-transform. */
 static void Transform2 ( const Integer  dI       ,
@@ -338,19 +387,22 @@ static void Transform2 ( const Integer  dI       ,
                          const Integer  oStrideI ,
                          const Integer  oStrideJ )
 {
-    Integer c, i, iI, oI, s ;
-    Real    v ;
-    for ( i = 0 ; i < dI ; i++ )
+    if ( iStrideJ == 1 )
     {
-        iI = i * iStrideI ;
-        oI = i * oStrideI ;
-        for ( s = 0 ; s < dS ; s++ )
+        switch ( dC )
         {
-            for ( c = 0, v = 0.0e+00 ; c < dC ; c++ ) { v += ( T[c*dS+s] * In[iI+c*iStrideJ] ) ; }
-            Out[oI+s*oStrideJ] = v ;
+            case  1: _TransformDot (  1 ) ; break ;
+            case  3: _TransformDot (  3 ) ; break ;
+            case  6: _TransformDot (  6 ) ; break ;
+            case 10: _TransformDot ( 10 ) ; break ;
+            case 15: _TransformDot ( 15 ) ; break ;
+            case 21: _TransformDot ( 21 ) ; break ;
+            default: _TransformDot ( dC ) ; break ;
         }
     }
+    else TransformAxpy ( dI, dC, dS, T, In, iStrideI, iStrideJ, Out, oStrideI, oStrideJ ) ;
 }
+# undef _TransformDot
 
 /* . 3-transform. */
 static void Transform3 ( const Integer  dI       ,
@@ -367,21 +419,6 @@ static void Transform3 ( const Integer  dI       ,
                          const Integer  oStrideJ ,
                          const Integer  oStrideK )
 {
-    Integer c, i, iI, iIJ, j, oI, oIJ, s ;
-    Real    v ;
-    for ( i = 0 ; i < dI ; i++ )
-    {
-        iI = i * iStrideI ;
-        oI = i * oStrideI ;
-        for ( j = 0 ; j < dJ ; j++ )
-        {
-            iIJ = iI + j * iStrideJ ;
-            oIJ = oI + j * oStrideJ ;
-            for ( s = 0 ; s < dS ; s++ )
-            {
-                for ( c = 0, v = 0.0e+00 ; c < dC ; c++ ) { v += ( T[c*dS+s] * In[iIJ+c*iStrideK] ) ; }
-                Out[oIJ+s*oStrideK] = v ;
-            }
-        }
-    }
+    Integer i ;
+    for ( i = 0 ; i < dI ; i++ ) Transform2 ( dJ, dC, dS, T, &In[i*iStrideI], iStrideJ, iStrideK, &Out[i*oStrideI], oStrideJ, oStrideK ) ;
 }
@@ -22,6 +22,7 @@ cdef extern from "GaussianBasisContainer.h":
 
     ctypedef struct CGaussianBasisContainer "GaussianBasisContainer":
         CBoolean         isOwner 
+        CBoolean         orderCenters
         CInteger         capacity
         CIntegerArray1D *centerFunctionPointers
         CIntegerArray1D *functionCenters
@@ -45,6 +45,7 @@ cdef class GaussianBasisContainer:
         state = { "Atomic Numbers" : self.atomicNumbers ,
                   "Unique Entries" : self.uniqueEntries }
         if self.label is not None: state["Label"] = self.label
+        if self.orderCenters     : state["Order Centers"] = True
         return state
 
     def __init__ ( self, capacity ):
@@ -63,7 +64,8 @@ cdef class GaussianBasisContainer:
     def __setstate__ ( self, state ):
         """Set the state."""
         self._CreateObject ( state["Unique Entries"], state["Atomic Numbers"] )
-        self.label = state.get ( "Label", None )
+        self.label        = state.get ( "Label"        , None  )
+        self.orderCenters = state.get ( "Order Centers", False )
         self._MakeFunctionData ( )
 
     def _Allocate ( self, capacity ):
@@ -230,3 +232,13 @@ cdef class GaussianBasisContainer:
     @property
     def numberOfWorkFunctions ( self ):
         return self._numberOfWorkFunctions
+
+    @property
+    def orderCenters ( self ):
+        if self.cObject == NULL: return False
+        else:                    return ( self.cObject.orderCenters == CTrue )
+    @orderCenters.setter
+    def orderCenters ( self, value ):
+        if self.cObject != NULL:
+            if value: self.cObject.orderCenters = CTrue
+            else:     self.cObject.orderCenters = CFalse
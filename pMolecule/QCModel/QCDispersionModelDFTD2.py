@@ -2,22 +2,38 @@
 
 import math, os, os.path
 
-from   pCore              import Clone                 , \
-                                 logFile               , \
-                                 LogFileActive         , \
-                                 YAMLUnpickle
-from   pScientific        import Units
-from   pScientific.Arrays import Array
-from  .QCDispersionDFTD2  import QCDispersionDFTD2_Energy
-from  .QCModelError       import QCModelError
-from ..EnergyModel        import EnergyClosurePriority , \
-                                 EnergyModel
+from   pCore                  import Clone                           , \
+                                     logFile                         , \
+                                     LogFileActive                   , \
+                                     YAMLUnpickle
+from   pScientific            import Units
+from   pScientific.Arrays     import Array
+from   pScientific.Geometry3  import Coordinates3                    , \
+                                     PairListGenerator
+from  .QCDispersionDFTD2      import QCDispersionDFTD2_PairListEnergy
+from  .QCModelError           import QCModelError
+from ..EnergyModel            import EnergyClosurePriority           , \
+                                     EnergyModel                     , \
+                                     EnergyModelState
 
 #===================================================================================================================================
 # . Parameters.
 #===================================================================================================================================
+# . The cut-off (Angstroms) beyond which interactions are neglected. At this distance typical pair energies are < 10^-5 kJ mol^-1.
+_DefaultCutOff   = 30.0
 _DefaultYAMLPath = "dftD2.yaml"
 
+def _DefaultGenerator ( ):
+    """The default generator."""
+    return PairListGenerator.WithOptions ( cutOff               = _DefaultCutOff ,
+                                           cutOffCellSizeFactor = 0.5            ,
+                                           minimumCellExtent    = 2              ,
+                                           minimumCellSize      = 3.0            ,
+                                           minimumExtentFactor  = 1.5            ,
+                                           minimumPoints        = 500            ,
+                                           sortIndices          = False          ,
+                                           useGridByCell        = True           )
+
 #===================================================================================================================================
 # . State class.
 #===================================================================================================================================
@@ -32,23 +48,33 @@ class QCDispersionModelState ( EnergyModelState ):
 # . Class.
 #===================================================================================================================================
 class QCDispersionModelDFTD2 ( EnergyModel ):
-    """D2 DFT dispersion model."""
+    """D2 DFT dispersion model.
+
+    Only pairs within the cut-off of the generator are included. For periodic systems interactions with images are also calculated.
+    """
 
     # . Defaults.
     _attributable = dict ( EnergyModel._attributable )
     _classLabel   = "DFT-D2 QC Dispersion Model Summary"
     _stateName    = "qcDispersionState"
-    _stateObject      = QCDispersionModelState
+    _stateObject  = QCDispersionModelState
     _summarizable = dict ( EnergyModel._summarizable )
-    _attributable.update ( { "sqrtC6"   : None ,
-                             "dR"       : 0.0  ,
-                             "elements" : dict ,
-                             "r0"       : None ,
-                             "s6"       : 0.0  ,
-                             "sR"       : 0.0  } )
-    _summarizable.update ( { "dR" : ( "dR", "{:10.5f}" ) ,
-                             "sR" : ( "sR", "{:10.5f}" ) ,
-                             "s6" : ( "s6", "{:10.5f}" ) }
+    _attributable.update ( { "dR"        : 0.0  ,
+                             "elements"  : dict ,
+                             "generator" : None ,
+                             "s6"        : 0.0  ,
+                             "sR"        : 0.0  } )
+    _summarizable.update ( { "dR"        : ( "dR", "{:10.5f}" ) ,
+                             "generator" : None                 ,
+                             "sR"        : ( "sR", "{:10.5f}" ) ,
+                             "s6"        : ( "s6", "{:10.5f}" ) } )
+
+    def _CheckOptions ( self ):
+        """Check options."""
+        if self.generator is None:
+            self.generator = _DefaultGenerator ( )
+        elif not isinstance ( self.generator, PairListGenerator ):
+            raise TypeError ( "Invalid pairlist generator attribute." )
 
     def BuildModel ( self, target ):
         """Build the model."""
@@ -56,32 +82,47 @@ class QCDispersionModelDFTD2 ( EnergyModel ):
         if qcState is None:
             raise QCModelError ( "This QC dispersion model requires a pre-defined QC model." )
         else:
+            # . The parameters are in Angstroms and kJ mol^-1.
+            self._CheckOptions ( )
             state        = super ( QCDispersionModelDFTD2, self ).BuildModel ( target )
             n            = len ( qcState.atomicNumbers )
             state.sqrtC6 = Array.WithExtent ( n )
             state.r0     = Array.WithExtent ( n )
-            factor       = 1000.0 * math.pow ( Units.Length_Angstroms_To_Bohrs, 6 ) / Units.Energy_Hartrees_To_Kilojoules_Per_Mole
             for ( i, n ) in enumerate ( qcState.atomicNumbers ):
                 if n in self.elements:
                     ( c6, r0 )      = self.elements[n]
-                    state.sqrtC6[i] = math.sqrt ( c6 * factor )
-                    state.r0    [i] = Units.Length_Angstroms_To_Bohrs * r0
+                    state.sqrtC6[i] = math.sqrt ( c6 * 1000.0 )
+                    state.r0    [i] = r0
                 else:
                     raise QCModelError ( "DFT-D2 dispersion parameters not found for element {:d}.".format ( n ) )
+            return state
 
     def Energy ( self, target ):
         """Energy."""
-        coordinates3 = target.scratch.qcCoordinates3AU
-        gradients3   = target.scratch.Get ( "qcGradients3AU", None )
+        scratch      = target.scratch
+        coordinates3 = scratch.qcCoordinates3
         state        = getattr ( target, self.__class__._stateName )
-        energy       = QCDispersionDFTD2_Energy ( self.s6      ,
-                                                  self.sR      ,
-                                                  self.dR      ,
-                                                  state.sqrtC6 ,
-                                                  state.r0     ,
-                                                  coordinates3 ,
-                                                  gradients3   )
-        return { "DFT-D2 Dispersion" : energy * Units.Energy_Hartrees_To_Kilojoules_Per_Mole }
+        if scratch.doGradients:
+            gradients3 = scratch.Get ( "qcDispersionGradients3", None )
+            if gradients3 is None:
+                gradients3 = Coordinates3.WithExtent ( coordinates3.rows )
+                scratch.qcDispersionGradients3 = gradients3
+            gradients3.Set ( 0.0 )
+        else:
+            gradients3 = None
+        pairList = self.generator.SelfPairListFromCoordinates3 ( coordinates3, None, None, None, None, None, None )
+        energy   = QCDispersionDFTD2_PairListEnergy ( self.s6      ,
+                                                      self.sR      ,
+                                                      self.dR      ,
+                                                      state.sqrtC6 ,
+                                                      state.r0     ,
+                                                      coordinates3 ,
+                                                      pairList     ,
+                                                      gradients3   )
+        energy += self.EnergyImage ( target, gradients3 )
+        if gradients3 is not None:
+            scratch.qcGradients3AU.Add ( gradients3, scale = 1.0 / ( Units.Length_Angstroms_To_Bohrs * Units.Energy_Hartrees_To_Kilojoules_Per_Mole ) )
+        return { "DFT-D2 Dispersion" : energy }
 
     def EnergyClosures ( self, target ):
         """Return energy closures."""
@@ -90,15 +131,57 @@ class QCDispersionModelDFTD2 ( EnergyModel ):
             target.scratch.energyTerms.update ( results )
         return [ ( EnergyClosurePriority.QCEnergy, a, "QC Dispersion Energy" ) ]
 
+    def EnergyImage ( self, target, gradients3 ):
+        """Image energy."""
+        energy             = 0.0
+        symmetryParameters = target.symmetryParameters
+        if symmetryParameters is not None:
+            # . Image pairlists are handled by the NB package which depends on this one.
+            from ..NBModel import ImagePairListContainer, ImageScanContainer, QCDispersionDFTD2Image_Energy
+            scratch      = target.scratch
+            coordinates3 = scratch.qcCoordinates3
+            scanData     = ImageScanContainer.Constructor     ( coordinates3                    ,
+                                                                symmetryParameters              ,
+                                                                target.symmetry.transformations ,
+                                                                self.generator.cutOff           ,
+                                                                True                            ,
+                                                                0                               )
+            pairList     = ImagePairListContainer.Constructor ( self.generator                  ,
+                                                                None                            ,
+                                                                None                            ,
+                                                                None                            ,
+                                                                coordinates3                    ,
+                                                                coordinates3                    ,
+                                                                symmetryParameters              ,
+                                                                target.symmetry.transformations ,
+                                                                scanData                        ,
+                                                                None                            ,
+                                                                None                            ,
+                                                                True                            )
+            if len ( pairList ) > 0:
+                state   = getattr ( target, self.__class__._stateName )
+                energy += QCDispersionDFTD2Image_Energy ( self.s6            ,
+                                                          self.sR            ,
+                                                          self.dR            ,
+                                                          state.sqrtC6       ,
+                                                          state.r0           ,
+                                                          coordinates3       ,
+                                                          symmetryParameters ,
+                                                          pairList           ,
+                                                          gradients3         ,
+                                                          scratch.Get ( "symmetryParameterGradients", None ) )
+        return energy
+
     @classmethod
     def FromYAMLFile ( selfClass, path = None ):
         """Constructor from YAML file."""
         self = selfClass ( )
         self.LoadYAMLFile ( path = path )
+        self._CheckOptions ( )
         return self
 
     def LoadYAMLFile ( self, path = None ):
-        ""'Load parameters from a YAML file."""
+        """Load parameters from a YAML file."""
         if path is None: path = os.path.join ( os.getenv ( "PDYNAMO3_PARAMETERS" ), "qcDispersion", _DefaultYAMLPath )
         parameters = YAMLUnpickle ( path )
         # . Element parameters.
@@ -112,7 +195,7 @@ class QCDispersionModelDFTD2 ( EnergyModel ):
     def SummaryItems ( self ):
         """Summary items."""
         items = super ( QCDispersionModelDFTD2, self ).SummaryItems ( )
-        items.append ( ( "Number Of Elements" , "{:d}".format ( len ( self.elements ) ) )
+        items.append ( ( "Number Of Elements" , "{:d}".format ( len ( self.elements ) ) ) )
         return items
 
 #===================================================================================================================================
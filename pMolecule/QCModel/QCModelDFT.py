@@ -52,13 +52,15 @@ class QCModelDFT ( QCModelBase ):
                              "integralEvaluator"  : GaussianBasisIntegralEvaluator ,
                              "multipoleEvaluator" : MullikenMultipoleEvaluator     ,
                              "maximumMemory"      : _DefaultMaximumMemory          ,
-                             "orbitalBasis"       : "6-31g_st"                     } )
+                             "orbitalBasis"       : "6-31g_st"                     ,
+                             "orderBasisCenters"  : False                          } )
     _summarizable.update ( { "fitBasis"           : "Fit Basis"                    ,
                              "fitOperator"        : "Fit Operator"                 ,
                              "functional"         : "Functional"                   ,
                              "gridIntegrator"     : None                           ,
                              "maximumMemory"      : ( "Maximum Memory (GB)", "{:.3f}" ) ,
-                             "orbitalBasis"       :   "Orbital Basis"              } )
+                             "orbitalBasis"       :   "Orbital Basis"              ,
+                             "orderBasisCenters"  :   "Order Basis Centers"        } )
 
     def _CheckOptions ( self ):
         """Check options."""
@@ -337,6 +339,7 @@ class QCModelDFT ( QCModelBase ):
             state.fitBases = GaussianBasisContainer.FromParameterDirectory ( self.fitBasis       ,
                                                                              state.atomicNumbers )
         state.orbitalBases   = GaussianBasisContainer.FromParameterDirectory ( self.orbitalBasis, state.atomicNumbers )
+        state.orbitalBases.orderCenters = self.orderBasisCenters
         state.nuclearCharges = state.orbitalBases.nuclearCharges
         self.functionalModel = DFTFunctionalModel.FromOptions ( self.functional, isSpinRestricted = target.electronicState.isSpinRestricted )
         if self.functionalModel is not None:
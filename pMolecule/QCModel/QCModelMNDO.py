@@ -48,8 +48,10 @@ class QCModelMNDO ( QCModelBase ):
     _summarizable = dict ( QCModelBase._summarizable )
     _attributable.update ( { "hamiltonian"        : "am1"                  ,
                              "integralEvaluator"  : MNDOIntegralEvaluator  ,
-                             "multipoleEvaluator" : MNDOMultipoleEvaluator } )
-    _summarizable.update ( { "hamiltonian"        :"Hamiltonian"           } )
+                             "multipoleEvaluator" : MNDOMultipoleEvaluator ,
+                             "useIntegralTable"   : False                  } )
+    _summarizable.update ( { "hamiltonian"        :"Hamiltonian"           ,
+                             "useIntegralTable"   :"Use Integral Table"    } )
 
     def EnergyClosureGradients ( self, target ):
         """Gradient energy closure."""
@@ -102,6 +104,7 @@ class QCModelMNDO ( QCModelBase ):
         """Get the parameters for the model."""
         state = target.qcState
         state.mndoParameters = MNDOParametersContainer.FromParameterDirectory ( self.hamiltonian, state.atomicNumbers )
+        if self.useIntegralTable: state.mndoParameters.MakeIntegralTable ( )
         state.energyBaseLine = state.mndoParameters.energyBaseLine
         state.nuclearCharges = state.mndoParameters.coreCharges
         state.orbitalBases   = state.mndoParameters.MakeOrbitalBasis ( state.atomicNumbers )
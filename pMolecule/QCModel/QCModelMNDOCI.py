@@ -13,6 +13,7 @@ from   pScientific.Arrays        import Array                 , \
                                         StorageType
 from   pScientific.LinearAlgebra import EigenPairs
 from  .CIConfigurationContainer  import CIConfigurationContainer
+from  .CIDirectHamiltonian       import CIDirectHamiltonian
 from  .CIFourIndexTransformation import CIFourIndexTransformation_Make
 from  .CISparseSolver            import CISparseSolver
 from  .CPHFSolver                import CPHFSolver
@@ -33,6 +34,7 @@ class CIDiagonalization ( Enum ):
     """The type of CI diagonalization."""
     Dense  = 1
     Sparse = 2
+    Direct = 3 # . As sparse but without construction of the CI matrix.
 
 class CIMethod ( Enum ):
     """The type of CI method."""
@@ -87,6 +89,7 @@ class QCModelMNDOCI ( QCModelMNDO ):
     _attributable.update ( { "activeElectrons"              : 0                       ,
                              "activeOrbitals"               : 0                       ,
                              "checkSparseDiagonalization"   : False                   ,
+                             "ciBlockSize"                  : 1                       , # . For sparse diagonalization.
                              "ciDiagonalization"            : CIDiagonalization.Dense ,
                              "ciMethod"                     : CIMethod.Full           ,
                              "degeneracyTolerance"          : 1.0e-03                 , # . Hartrees.
@@ -102,6 +105,7 @@ class QCModelMNDOCI ( QCModelMNDO ):
     _summarizable.update ( { "activeElectrons"              :   "Active Electrons"                          ,
                              "activeOrbitals"               :   "Active Orbitals"                           ,
                              "checkSparseDiagonalization"   :   "Check Sparse Diagonalization"              ,
+                             "ciBlockSize"                  :   "CI Block Size"                             ,
                              "ciDiagonalization"            :   "CI Diagonalization"                        ,
                              "ciMethod"                     :   "CI Method"                                 ,
                              "degeneracyTolerance"          : ( "Degeneracy Tolerance"           , "{:g}" ) ,
@@ -182,7 +186,11 @@ class QCModelMNDOCI ( QCModelMNDO ):
         if self.ciDiagonalization == CIDiagonalization.Dense:
             EigenPairs ( node.ciMatrixDense, node.ciEnergies, node.ciVectors, columnMajor = True, preserveInput = False, upper = self.numberOfStates )
         else:
-            node.ciMatrixSparse.MakeDiagonalPreconditioner ( node.preconditioner )
+            if self.ciDiagonalization == CIDiagonalization.Direct:
+                node.ciHamiltonian.Update ( node.fCoreMO, moTEIs )
+                node.ciHamiltonian.MakeDiagonalPreconditioner ( node.preconditioner )
+            else:
+                node.ciMatrixSparse.MakeDiagonalPreconditioner ( node.preconditioner )
             report = node.sparseSolver.Solve ( )
             if self.checkSparseDiagonalization:
                 EigenPairs ( node.ciMatrixDense, node.ciEnergiesReference, None, columnMajor = True, preserveInput = False, upper = self.numberOfStates )
@@ -208,13 +216,7 @@ class QCModelMNDOCI ( QCModelMNDO ):
         node.ciRoot   = rootNumber
         node.ciVector = ciVector
         # . Make the CI densities.
-        # . dTotal and dSpin are general.
-        # . onePDMHF, onePDMMO(t), onePDM and dCore are only needed for the gradients.
-        # . onePDMMOs is scratch.
-        state.configurations.MakeDensities ( ciVector, node.onePDMMO, node.onePDMMOs, node.twoPDM )
-        node.onePDMMO.Transform  ( node.activeMOs, node.onePDM, useTranspose = True )
-        node.onePDMMOs.Transform ( node.activeMOs, node.dSpin , useTranspose = True )
-        node.onePDM.CopyTo ( node.dTotal ) ; node.dTotal.Add ( node.dCore )
+        self.MakeCIDensities ( target, ciVector )
 
     def CIInitialize ( self, target ):
         """Set up a CI energy calculation."""
@@ -265,14 +267,18 @@ class QCModelMNDOCI ( QCModelMNDO ):
             # . Diagonalization.
             ciMatrixDense  = None
             ciMatrixSparse = None
-            if self.ciDiagonalization == CIDiagonalization.Sparse:
+            if self.ciDiagonalization == CIDiagonalization.Direct:
+                node.ciHamiltonian    = CIDirectHamiltonian.FromConfigurations ( state.configurations )
+                node.preconditioner   = Array.WithShape ( [ nConfigurations ] )
+                node.sparseSolver     = CISparseSolver.FromArrays ( node.ciEnergies, node.ciVectors, node.ciHamiltonian, node.preconditioner, blockSize = self.ciBlockSize )
+            elif self.ciDiagonalization == CIDiagonalization.Sparse:
                 ( nonZero, sparsity ) = state.configurations.CIMatrixSparsity ( )
                 ciMatrixSparse        = SparseSymmetricMatrix.WithExtentAndSize ( nConfigurations, nonZero )
                 node.preconditioner   = Array.WithShape ( [ nConfigurations ] )
-                sparseSolver          = CISparseSolver.FromArrays ( node.ciEnergies, node.ciVectors, ciMatrixSparse, node.preconditioner )
+                sparseSolver          = CISparseSolver.FromArrays ( node.ciEnergies, node.ciVectors, ciMatrixSparse, node.preconditioner, blockSize = self.ciBlockSize )
                 node.sparseSolver     = sparseSolver
-                if self.checkSparseDiagonalization:
-                    node.ciEnergiesReference = Array.WithShape ( [ self.numberOfStates ] )
+            if ( self.ciDiagonalization != CIDiagonalization.Dense ) and self.checkSparseDiagonalization:
+                node.ciEnergiesReference = Array.WithShape ( [ self.numberOfStates ] )
             if ( self.ciDiagonalization == CIDiagonalization.Dense ) or self.checkSparseDiagonalization:
                 ciMatrixDense = Array.WithExtent ( nConfigurations, storageType = StorageType.Symmetric )
             node.ciMatrixDense  = ciMatrixDense
@@ -390,6 +396,29 @@ class QCModelMNDOCI ( QCModelMNDO ):
                 table.Entry   ( "{:s}".format     ( microStates[0][m: ] ) )
             table.Stop ( )
 
+    def CPHFZVectors ( self, target, roots ):
+        """Solve the CPHF equations for the Z-vectors of several CI states together.
+
+        An energy must have been calculated beforehand. The Z-vectors are returned as the rows of an array in the
+        order of roots, together with the solver report. The densities of the selected root are restored on exit but
+        the CPHF quantities needed for the gradients of the last energy calculation are overwritten.
+        """
+        node   = target.scratch.ci
+        solver = node.Get ( "cphfSolver", None )
+        if solver is None:
+            solver = CPHFSolver.FromTarget ( target )
+            node.cphfSolver = solver
+        solver.SetUp ( )
+        rhs      = Array.WithExtents ( len ( roots ), solver.numberNonRedundant )
+        zVectors = Array.WithExtents ( len ( roots ), solver.numberNonRedundant )
+        for ( i, root ) in enumerate ( roots ):
+            self.MakeCIDensities ( target, node.ciVectors[root,:] )
+            solver.CalculateCPHFVectors ( )
+            solver.qNR.CopyTo ( rhs[i,:] )
+        self.MakeCIDensities ( target, node.ciVector )
+        report = solver.SolveZVectors ( rhs, zVectors )
+        return ( zVectors, report )
+
     def EnergyClosureGradients ( self, target ):
         """Gradient energy closure."""
         def a ( ): self.integralEvaluator.ResonanceGradients            ( target, doCI = True )
@@ -451,6 +480,18 @@ class QCModelMNDOCI ( QCModelMNDO ):
             # . Final energy.
             log.Paragraph ( "Selected State CI Energy = {:.8g} kJ/mol.".format ( node.ciEnergy ) )
 
+    def MakeCIDensities ( self, target, ciVector ):
+        """Make the CI densities of a state."""
+        # . dTotal and dSpin are general.
+        # . onePDMHF, onePDMMO(t), onePDM and dCore are only needed for the gradients.
+        # . onePDMMOs is scratch.
+        node  = target.scratch.ci
+        state = target.qcState
+        state.configurations.MakeDensities ( ciVector, node.onePDMMO, node.onePDMMOs, node.twoPDM )
+        node.onePDMMO.Transform  ( node.activeMOs, node.onePDM, useTranspose = True )
+        node.onePDMMOs.Transform ( node.activeMOs, node.dSpin , useTranspose = True )
+        node.onePDM.CopyTo ( node.dTotal ) ; node.dTotal.Add ( node.dCore )
+
     def MakeConfigurations ( self, target ):
         """Make the configurations."""
         state = target.qcState
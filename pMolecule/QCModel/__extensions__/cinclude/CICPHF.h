@@ -26,6 +26,18 @@ extern void         CICPHF_ApplyCPHFMatrix      ( const Integer                n
                                                         SymmetricMatrix       *work1                     ,
                                                         SymmetricMatrix       *work2                     ,
                                                         RealArray1D           *x                         ) ;
+extern void         CICPHF_ApplyCPHFMatrices    ( const Integer                n1                        ,
+                                                  const IntegerArray2D        *in1                       ,
+                                                  const Integer                n2                        ,
+                                                  const IntegerArray2D        *in2                       ,
+                                                  const RealArray1D           *aDiagonal                 ,
+                                                  const RealArray2D           *b                         ,
+                                                  const RealArray2D           *orbitals                  ,
+                                                        BlockStorage          *twoElectronIntegrals      ,
+                                                        SymmetricMatrix       *work1                     ,
+                                                        SymmetricMatrix       *work2                     ,
+                                                        RealArray2D           *x                         ,
+                                                        Status                *status                    ) ;
 extern void         CICPHF_CalculateCPHFVectors ( const Integer                nActive                   ,
                                                   const Integer                nCore                     ,
                                                   const Integer                nOrbitals                 ,
@@ -0,0 +1,73 @@
+# ifndef _CIDIRECTHAMILTONIAN
+# define _CIDIRECTHAMILTONIAN
+
+# include "CIConfigurationContainer.h"
+# include "DoubleSymmetricMatrix.h"
+# include "Integer.h"
+# include "Real.h"
+# include "RealArray1D.h"
+# include "RealArray2D.h"
+# include "Status.h"
+# include "SymmetricMatrix.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Structures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The complete set of strings of a given number of electrons of one spin in the active orbitals. */
+/* . The single excitations of each string, E_kl |I> = sign |K>, are stored as the target string K, the orbital pair index,
+!    k * nActive + l, and the sign. The diagonal excitations (k == l) are included. The same-spin part of the Hamiltonian is
+!    stored row by row with a fixed capacity per row. */
+typedef struct {
+    Integer  nElectrons   ;
+    Integer  nExcitations ;
+    Integer  nStrings     ;
+    Integer  rowCapacity  ;
+    Integer *pairs        ;
+    Integer *rowCounts    ;
+    Integer *rowIndices   ;
+    Integer *targets      ;
+    Real    *rowValues    ;
+    Real    *signs        ;
+} CIStringSpace ;
+
+/* . The direct CI Hamiltonian type. */
+/* . The configurations are indexed by their alpha and beta strings and the lookup table, of extent nAlphaStrings x nBetaStrings,
+!    gives the configuration corresponding to a pair of strings or -1 if it is not in the CI space. */
+typedef struct {
+    Integer        nActive         ;
+    Integer        nConfigurations ;
+    Integer       *alphaIndices    ;
+    Integer       *betaIndices     ;
+    Integer       *lookUp          ;
+    Real          *oneElectron     ;
+    Real          *twoElectron     ;
+    CIStringSpace *alphas          ;
+    CIStringSpace *betas           ;
+} CIDirectHamiltonian ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Procedures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern void                 CIDirectHamiltonian_Deallocate                 (       CIDirectHamiltonian      **self           ) ;
+extern CIDirectHamiltonian *CIDirectHamiltonian_FromConfigurations         ( const CIConfigurationContainer  *configurations ,
+                                                                                    Status                    *status         ) ;
+extern void                 CIDirectHamiltonian_GetDiagonal                ( const CIDirectHamiltonian       *self           ,
+                                                                                   RealArray1D               *diagonal       ,
+                                                                                   Status                    *status         ) ;
+extern void                 CIDirectHamiltonian_MakeDiagonalPreconditioner ( const CIDirectHamiltonian       *self           ,
+                                                                                   RealArray1D               *preconditioner ,
+                                                                             const Real                      *tolerance      ,
+                                                                                   Status                    *status         ) ;
+extern void                 CIDirectHamiltonian_Update                     (       CIDirectHamiltonian       *self           ,
+                                                                             const SymmetricMatrix           *fCoreMO        ,
+                                                                             const DoubleSymmetricMatrix     *moTEIs         ,
+                                                                                   Status                    *status         ) ;
+extern void                 CIDirectHamiltonian_VectorMultiply             ( const CIDirectHamiltonian       *self           ,
+                                                                             const RealArray1D               *x              ,
+                                                                                   RealArray1D               *y              ,
+                                                                                   Status                    *status         ) ;
+extern void                 CIDirectHamiltonian_VectorsMultiply            ( const CIDirectHamiltonian       *self           ,
+                                                                             const RealArray2D               *x              ,
+                                                                                   RealArray2D               *y              ,
+                                                                                   Status                    *status         ) ;
+# endif
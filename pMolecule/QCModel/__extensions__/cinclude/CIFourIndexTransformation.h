@@ -5,6 +5,7 @@
 # include "DoubleSymmetricMatrix.h"
 # include "RealArray2D.h"
 # include "RealArrayND.h"
+# include "Status.h"
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Structures.
@@ -17,5 +18,6 @@ extern void CIFourIndexTransformation ( const RealArray2D           *activeMOs
                                               BlockStorage          *twoElectronIntegrals ,
                                               RealArray2D           *moTEI34              ,
                                               RealArrayND           *moTEI234             ,
-                                              DoubleSymmetricMatrix *moTEIs               ) ;
+                                              DoubleSymmetricMatrix *moTEIs               ,
+                                              Status                *status               ) ;
 # endif
@@ -7,6 +7,7 @@
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Procedures.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+extern void CISparseSolver_ApplyDirectMatrix   ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme ) ;
 extern void CISparseSolver_ApplyMatrix         ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme ) ;
 extern void CISparseSolver_ApplyPreconditioner ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme ) ;
 
@@ -4,6 +4,7 @@
 # include "BlockStorage.h"
 # include "Real.h"
 # include "RealArray1D.h"
+# include "RealArray2D.h"
 # include "Status.h"
 # include "SymmetricMatrix.h"
 
@@ -43,6 +44,11 @@ extern Real Fock_MakeFromTEIs                     (       BlockStorage    *twoEl
                                                     const Real             exchangeScaling      ,
                                                           SymmetricMatrix *fTotal               ,
                                                           SymmetricMatrix *fSpin                ) ;
+extern void Fock_MakeFromTEIsMultiple             (       BlockStorage    *twoElectronIntegrals ,
+                                                    const RealArray2D     *dTotals              ,
+                                                    const Real             exchangeScaling      ,
+                                                          RealArray2D     *fTotals              ,
+                                                          Status          *status               ) ;
 extern Real Fock_MakeFromTEIsCoulomb              (       BlockStorage    *twoElectronIntegrals ,
                                                     const SymmetricMatrix *dTotal               ,
                                                           SymmetricMatrix *fTotal               ) ;
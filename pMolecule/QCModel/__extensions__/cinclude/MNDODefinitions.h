@@ -96,6 +96,9 @@
 # define SMALL_RIJ                   5.0e-03
 # define SMALL_RIJ2                  2.5e-05
 
+/* . The maximum number of one-center charge distributions - 1 (s), 10 (sp), 45 (spd). */
+# define NCHARGEDISTRIBUTIONS 45
+
 /* . The maximum number of unique one-center two-electron integrals - 1 (s), 16 (sp), 155 (spd). */
 # define N1CTEIS 155
 
@@ -0,0 +1,62 @@
+# ifndef _MNDOINTEGRALTABLE
+# define _MNDOINTEGRALTABLE
+
+# include "Boolean.h"
+# include "CubicSpline.h"
+# include "Integer.h"
+# include "MNDOParameters.h"
+# include "Real.h"
+# include "RealArray1D.h"
+# include "RealArray2D.h"
+# include "Status.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The tabulated local-frame integrals for an ordered pair of parameter sets. */
+/* . Only the integrals that are not zero by symmetry are splined. Their positions are given with respect
+!    to the concatenated array of TEIs (ni x nj), core1b (ni) and core2a (nj) integrals. */
+typedef struct {
+    Integer      ni       ;
+    Integer      nj       ;
+    Integer      nSplines ;
+    Integer     *indices  ;
+    CubicSpline *spline   ;
+} MNDOIntegralTablePair ;
+
+/* . The table type. */
+typedef struct {
+    Boolean                 isBuilt            ;
+    Integer                 numberOfParameters ;
+    Integer                 numberOfPoints     ;
+    Real                    lowerBound         ;
+    Real                    spacing            ;
+    Real                    upperBound         ;
+    MNDOIntegralTablePair **pairs              ;
+    MNDOParameters        **parameters         ;
+} MNDOIntegralTable ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Procedure declarations.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+extern MNDOIntegralTable *MNDOIntegralTable_Allocate         ( const Integer             capacity   ,
+                                                                     MNDOParameters   **entries    ,
+                                                               const Real                lowerBound ,
+                                                               const Real                spacing    ,
+                                                               const Real                upperBound ,
+                                                                     Status            *status     ) ;
+extern void               MNDOIntegralTable_Build            (       MNDOIntegralTable *self       ,
+                                                                     Status            *status     ) ;
+extern void               MNDOIntegralTable_Deallocate       (       MNDOIntegralTable **self      ) ;
+extern void               MNDOIntegralTable_LocalFrame2CTEIs ( const MNDOIntegralTable *self       ,
+                                                               const MNDOParameters    *iData      ,
+                                                               const MNDOParameters    *jData      ,
+                                                               const Real               r          ,
+                                                                     RealArray2D       *lfteis     ,
+                                                                     RealArray1D       *core1b     ,
+                                                                     RealArray1D       *core2a     ,
+                                                                     RealArray2D       *dlfteis    ,
+                                                                     RealArray1D       *dcore1b    ,
+                                                                     RealArray1D       *dcore2a    ) ;
+
+# endif
@@ -3,7 +3,9 @@
 
 # include "Boolean.h"
 # include "Integer.h"
+# include "MNDOIntegralTable.h"
 # include "MNDOParameters.h"
+# include "Real.h"
 # include "Status.h"
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -11,19 +13,25 @@
 !---------------------------------------------------------------------------------------------------------------------------------*/
 /* . The container type. */
 typedef struct {
-    Boolean          isOwner  ;
-    Integer          capacity ;
-    MNDOParameters **entries  ;
+    Boolean            isOwner       ;
+    Integer            capacity      ;
+    MNDOIntegralTable *integralTable ;
+    MNDOParameters   **entries       ;
 } MNDOParametersContainer ;
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Procedure declarations.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-extern MNDOParametersContainer *MNDOParametersContainer_Allocate     ( const Integer                   capacity ,
-                                                                             Status                   *status   ) ;
-extern MNDOParametersContainer *MNDOParametersContainer_Clone        ( const MNDOParametersContainer  *self     ,
-                                                                             Status                   *status   ) ;
-extern void                     MNDOParametersContainer_Deallocate   (       MNDOParametersContainer **self     ) ;
-extern Integer                  MNDOParametersContainer_LargestBasis ( const MNDOParametersContainer  *self     ) ;
+extern MNDOParametersContainer *MNDOParametersContainer_Allocate          ( const Integer                   capacity   ,
+                                                                                  Status                   *status     ) ;
+extern MNDOParametersContainer *MNDOParametersContainer_Clone             ( const MNDOParametersContainer  *self       ,
+                                                                                  Status                   *status     ) ;
+extern void                     MNDOParametersContainer_Deallocate        (       MNDOParametersContainer **self       ) ;
+extern Integer                  MNDOParametersContainer_LargestBasis      ( const MNDOParametersContainer  *self       ) ;
+extern void                     MNDOParametersContainer_MakeIntegralTable (       MNDOParametersContainer  *self       ,
+                                                                            const Real                      lowerBound ,
+                                                                            const Real                      spacing    ,
+                                                                            const Real                      upperBound ,
+                                                                                  Status                   *status     ) ;
 
 # endif
@@ -2,8 +2,10 @@
 # define _QCDISPERSIONDFTD2
 
 # include "Coordinates3.h"
+# include "PairList.h"
 # include "Real.h"
 # include "RealArray1D.h"
+# include "Status.h"
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Definitions.
@@ -12,12 +14,24 @@
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Procedures.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-extern Real QCDispersionDFTD2_Energy ( const Real          s6           ,
-                                       const Real          sR           ,
-                                       const Real          dR           ,
-                                       const RealArray1D  *sqrtC6       ,
-                                       const RealArray1D  *r0           ,
-                                       const Coordinates3 *coordinates3 ,
-                                             Coordinates3 *gradients3   ) ;
+extern Real QCDispersionDFTD2_Energy         ( const Real          s6            ,
+                                               const Real          sR            ,
+                                               const Real          dR            ,
+                                               const RealArray1D  *sqrtC6        ,
+                                               const RealArray1D  *r0            ,
+                                               const Coordinates3 *coordinates3  ,
+                                                     Coordinates3 *gradients3    ) ;
+extern Real QCDispersionDFTD2_EnergyPairList ( const Real          s6            ,
+                                               const Real          sR            ,
+                                               const Real          dR            ,
+                                               const Real          scale         ,
+                                               const RealArray1D  *sqrtC6        ,
+                                               const RealArray1D  *r0            ,
+                                               const Coordinates3 *coordinates3A ,
+                                               const Coordinates3 *coordinates3B ,
+                                                     PairList     *pairList      ,
+                                                     Coordinates3 *gradients3A   ,
+                                                     Coordinates3 *gradients3B   ,
+                                                     Status       *status        ) ;
 
 # endif
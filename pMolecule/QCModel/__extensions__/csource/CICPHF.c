@@ -57,6 +57,79 @@ void CICPHF_ApplyCPHFMatrix ( const Integer          n1                   ,
     }
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Calculate A * B for several vectors, stored as the rows of B and X, with a single pass over the integrals.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CICPHF_ApplyCPHFMatrices ( const Integer          n1                   ,
+                                const IntegerArray2D  *in1                  ,
+                                const Integer          n2                   ,
+                                const IntegerArray2D  *in2                  ,
+                                const RealArray1D     *aDiagonal            ,
+                                const RealArray2D     *b                    ,
+                                const RealArray2D     *orbitals             ,
+                                      BlockStorage    *twoElectronIntegrals ,
+                                      SymmetricMatrix *work1                ,
+                                      SymmetricMatrix *work2                ,
+                                      RealArray2D     *x                    ,
+                                      Status          *status               )
+{
+    if ( ( in1      != NULL ) &&
+         ( in2      != NULL ) &&
+         ( b        != NULL ) &&
+         ( orbitals != NULL ) &&
+         ( work1    != NULL ) &&
+         ( work2    != NULL ) &&
+         ( x        != NULL ) &&
+         Status_IsOK ( status ) )
+    {
+        auto Integer      nVectors = View2D_Rows ( b ) ;
+        auto RealArray2D *dTotals = NULL, *fTotals = NULL ;
+        if ( ( View2D_Rows ( x ) != nVectors ) || ( View2D_Columns ( b ) < n2 ) || ( View2D_Columns ( x ) < n1 ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            dTotals = RealArray2D_AllocateWithExtents ( nVectors, work1->size, status ) ;
+            fTotals = RealArray2D_AllocateWithExtents ( nVectors, work1->size, status ) ;
+            if ( Status_IsOK ( status ) )
+            {
+                auto Integer      i, j, m, n ;
+                auto RealArray1D  bV, xV ;
+                /* . Transform each B to the A.O. basis. */
+                for ( m = 0 ; m < nVectors ; m++ )
+                {
+                    RealArray1D_ViewOfRaw ( &bV, 0, View2D_Columns ( b ), b->stride1, Array2D_RowPointer ( b, m ) ) ;
+                    CICPHF_Transform ( n2, in2, &bV, 0, in2, &bV, orbitals, True, work1, work2 ) ;
+                    for ( n = 0 ; n < work2->size ; n++ ) Array2D_Item ( dTotals, m, n ) = work2->data[n] ;
+                }
+                /* . Build all Ys in the A.O. basis. */
+                Fock_MakeFromTEIsMultiple ( twoElectronIntegrals, dTotals, 1.0e+00, fTotals, status ) ;
+                /* . Transform each Y to the M.O. basis and fill X. */
+                for ( m = 0 ; m < nVectors ; m++ )
+                {
+                    for ( n = 0 ; n < work1->size ; n++ ) work1->data[n] = Array2D_Item ( fTotals, m, n ) ;
+                    SymmetricMatrix_Transform ( work1, orbitals, False, work2, NULL ) ;
+                    RealArray1D_ViewOfRaw ( &bV, 0, View2D_Columns ( b ), b->stride1, Array2D_RowPointer ( b, m ) ) ;
+                    RealArray1D_ViewOfRaw ( &xV, 0, View2D_Columns ( x ), x->stride1, Array2D_RowPointer ( x, m ) ) ;
+                    RealArray1D_Set ( &xV, 0.0e+00 ) ;
+                    for ( n = 0 ; n < n1 ; n++ )
+                    {
+                        i = Array2D_Item ( in1, n, 0 ) ;
+                        j = Array2D_Item ( in1, n, 1 ) ;
+                        Array1D_Item ( &xV, n ) = SymmetricMatrix_Item ( work2, j, i ) ;
+                    }
+                    RealArray1D_Scale ( &xV, 4.0e+00 ) ;
+                    /* . Add in the diagonal terms. */
+                    if ( aDiagonal != NULL )
+                    {
+                        for ( i = 0 ; i < n1 ; i++ ) Array1D_Item ( &xV, i ) += ( Array1D_Item ( aDiagonal, i ) * Array1D_Item ( &bV, i ) ) ;
+                    }
+                }
+            }
+            RealArray2D_Deallocate ( &dTotals ) ;
+            RealArray2D_Deallocate ( &fTotals ) ;
+        }
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Calculate the vectors required for solution of the CPHF equations.
 !---------------------------------------------------------------------------------------------------------------------------------*/
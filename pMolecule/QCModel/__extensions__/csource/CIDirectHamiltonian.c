@@ -0,0 +1,550 @@
+/*==================================================================================================================================
+! . Direct CI Hamiltonian.
+! . The CI configurations are factorized into alpha and beta strings so that the product of the CI matrix with a vector
+!   can be formed directly from the MO integrals, without constructing the matrix (Knowles and Handy, Olsen et al.).
+!
+! . The Hamiltonian is written in terms of the spin-summed excitation operators E_kl = E^a_kl + E^b_kl as:
+!
+!   H = Sum_kl h'_kl E_kl + 1/2 Sum_klmn (kl|mn) E_kl E_mn with h'_kl = h_kl - 1/2 Sum_m (km|ml)
+!
+!   and is split into alpha/alpha, beta/beta and alpha/beta parts. The same-spin parts depend only on one string and are
+!   precomputed for each string when the integrals are updated.
+!=================================================================================================================================*/
+
+# include <math.h>
+# include <stdlib.h>
+
+# include "CIDirectHamiltonian.h"
+# include "Memory.h"
+# include "NumericalMacros.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Parameters.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The minimum absolute value of a diagonal element for the preconditioner. */
+# define _Small 1.0e-06
+
+/*==================================================================================================================================
+! . Local procedures declarations.
+!=================================================================================================================================*/
+static Integer        CIStrings_Address          ( const Integer        nActive    ,
+                                                   const Integer        nElectrons ,
+                                                   const Integer       *occupied   ,
+                                                   const Integer       *binomials  ) ;
+static Integer       *CIStrings_Binomials        ( const Integer        nActive    ) ;
+static Integer        CIStrings_FromOccupancies  ( const Integer        nActive    ,
+                                                   const IntegerArray1D *occupancy ,
+                                                   const Integer       *binomials  ) ;
+
+static CIStringSpace *CIStringSpace_Allocate     ( const Integer        nActive    ,
+                                                   const Integer        nElectrons ,
+                                                   const Integer       *binomials  ,
+                                                         Status        *status     ) ;
+static void           CIStringSpace_Deallocate   (       CIStringSpace **self      ) ;
+static void           CIStringSpace_MakeRows     (       CIStringSpace  *self      ,
+                                                   const Integer        nActive    ,
+                                                   const Real          *oneElectron ,
+                                                   const Real          *twoElectron ,
+                                                         Status        *status     ) ;
+
+/*==================================================================================================================================
+! . Public procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CIDirectHamiltonian_Deallocate ( CIDirectHamiltonian **self )
+{
+    if ( (*self) != NULL )
+    {
+        CIStringSpace_Deallocate ( &((*self)->alphas) ) ;
+        CIStringSpace_Deallocate ( &((*self)->betas ) ) ;
+        Memory_Deallocate ( (*self)->alphaIndices ) ;
+        Memory_Deallocate ( (*self)->betaIndices  ) ;
+        Memory_Deallocate ( (*self)->lookUp       ) ;
+        Memory_Deallocate ( (*self)->oneElectron  ) ;
+        Memory_Deallocate ( (*self)->twoElectron  ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Construction from a set of configurations.
+! . All configurations must have the same numbers of alpha and beta electrons.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+CIDirectHamiltonian *CIDirectHamiltonian_FromConfigurations ( const CIConfigurationContainer *configurations, Status *status )
+{
+    CIDirectHamiltonian *self = NULL ;
+    if ( ( configurations != NULL ) && ( configurations->nConfigurations > 0 ) && Status_IsOK ( status ) )
+    {
+        auto Integer  c, i, n, nA, nActive, nB, nConfigurations, *binomials = NULL ;
+        /* . Check the configurations. */
+        nActive         = configurations->nActive         ;
+        nConfigurations = configurations->nConfigurations ;
+        nA              = configurations->configurations[0].nAlphas ;
+        nB              = configurations->nElectrons - nA ;
+        for ( c = 1 ; c < nConfigurations ; c++ )
+        {
+            if ( configurations->configurations[c].nAlphas != nA ) { Status_Set ( status, Status_InvalidArgument ) ; return NULL ; }
+        }
+        /* . Allocation. */
+        binomials = CIStrings_Binomials ( nActive ) ;
+        self      = Memory_AllocateType ( CIDirectHamiltonian ) ;
+        if ( ( binomials == NULL ) || ( self == NULL ) ) goto FinishUp ;
+        self->nActive         = nActive         ;
+        self->nConfigurations = nConfigurations ;
+        self->alphaIndices    = NULL ;
+        self->betaIndices     = NULL ;
+        self->lookUp          = NULL ;
+        self->oneElectron     = NULL ;
+        self->twoElectron     = NULL ;
+        self->alphas          = CIStringSpace_Allocate ( nActive, nA, binomials, status ) ;
+        self->betas           = CIStringSpace_Allocate ( nActive, nB, binomials, status ) ;
+        if ( ( self->alphas == NULL ) || ( self->betas == NULL ) ) goto FinishUp ;
+        n = nActive * nActive ;
+        self->alphaIndices = Memory_AllocateArrayOfTypes ( nConfigurations, Integer ) ;
+        self->betaIndices  = Memory_AllocateArrayOfTypes ( nConfigurations, Integer ) ;
+        self->lookUp       = Memory_AllocateArrayOfTypes ( self->alphas->nStrings * self->betas->nStrings, Integer ) ;
+        self->oneElectron  = Memory_AllocateArrayOfTypes ( n    , Real ) ;
+        self->twoElectron  = Memory_AllocateArrayOfTypes ( n * n, Real ) ;
+        if ( ( self->alphaIndices == NULL ) ||
+             ( self->betaIndices  == NULL ) ||
+             ( self->lookUp       == NULL ) ||
+             ( self->oneElectron  == NULL ) ||
+             ( self->twoElectron  == NULL ) ) goto FinishUp ;
+        /* . String indices and look-up table. */
+        n = self->alphas->nStrings * self->betas->nStrings ;
+        for ( i = 0 ; i < n ; i++ ) self->lookUp[i] = -1 ;
+        for ( c = 0 ; c < nConfigurations ; c++ )
+        {
+            self->alphaIndices[c] = CIStrings_FromOccupancies ( nActive, configurations->configurations[c].alphas, binomials ) ;
+            self->betaIndices [c] = CIStrings_FromOccupancies ( nActive, configurations->configurations[c].betas , binomials ) ;
+            self->lookUp[self->alphaIndices[c]*self->betas->nStrings+self->betaIndices[c]] = c ;
+        }
+        Memory_Deallocate ( binomials ) ;
+        return self ;
+    FinishUp:
+        Memory_Deallocate ( binomials ) ;
+        CIDirectHamiltonian_Deallocate ( &self ) ;
+        Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The diagonal of the Hamiltonian.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CIDirectHamiltonian_GetDiagonal ( const CIDirectHamiltonian *self, RealArray1D *diagonal, Status *status )
+{
+    if ( ( self != NULL ) && ( diagonal != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( View1D_Extent ( diagonal ) != self->nConfigurations ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto CIStringSpace *alphas = self->alphas, *betas = self->betas ;
+            auto Integer        a, b, c, e, f, n, n2 ;
+            auto Real           sum ;
+            n  = self->nActive ;
+            n2 = n * n ;
+            for ( c = 0 ; c < self->nConfigurations ; c++ )
+            {
+                a   = self->alphaIndices[c] ;
+                b   = self->betaIndices [c] ;
+                sum = 0.0e+00 ;
+                /* . Same-spin terms. */
+                for ( e = 0 ; e < alphas->rowCounts[a] ; e++ ) { if ( alphas->rowIndices[a*alphas->rowCapacity+e] == a ) { sum += alphas->rowValues[a*alphas->rowCapacity+e] ; break ; } }
+                for ( e = 0 ; e < betas->rowCounts [b] ; e++ ) { if ( betas->rowIndices [b*betas->rowCapacity +e] == b ) { sum += betas->rowValues [b*betas->rowCapacity +e] ; break ; } }
+                /* . Alpha/beta terms. */
+                for ( e = 0 ; e < alphas->nExcitations ; e++ )
+                {
+                    if ( alphas->targets[a*alphas->nExcitations+e] != a ) continue ;
+                    for ( f = 0 ; f < betas->nExcitations ; f++ )
+                    {
+                        if ( betas->targets[b*betas->nExcitations+f] != b ) continue ;
+                        sum += self->twoElectron[alphas->pairs[a*alphas->nExcitations+e]*n2+betas->pairs[b*betas->nExcitations+f]] ;
+                    }
+                }
+                Array1D_Item ( diagonal, c ) = sum ;
+            }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make a diagonal preconditioner.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CIDirectHamiltonian_MakeDiagonalPreconditioner ( const CIDirectHamiltonian *self, RealArray1D *preconditioner, const Real *tolerance, Status *status )
+{
+    if ( ( self != NULL ) && ( preconditioner != NULL ) )
+    {
+        auto Integer i ;
+        auto Real    t, v ;
+        if ( tolerance == NULL ) t = _Small ;
+        else                     t = (*tolerance ) ;
+        CIDirectHamiltonian_GetDiagonal ( self, preconditioner, status ) ;
+        for ( i = 0 ; i < preconditioner->extent ; i++ )
+        {
+            v = Maximum ( fabs ( Array1D_Item ( preconditioner, i ) ), t ) ;
+            Array1D_Item ( preconditioner, i ) = 1.0e+00 / v ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Update the Hamiltonian with new integrals.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CIDirectHamiltonian_Update (       CIDirectHamiltonian   *self    ,
+                                  const SymmetricMatrix       *fCoreMO ,
+                                  const DoubleSymmetricMatrix *moTEIs  ,
+                                        Status                *status  )
+{
+    if ( ( self != NULL ) && ( fCoreMO != NULL ) && ( moTEIs != NULL ) && Status_IsOK ( status ) )
+    {
+        auto Integer  k, l, m, n, n2, q ;
+        auto Real     sum ;
+        n  = self->nActive ;
+        n2 = n * n ;
+        /* . Two-electron integrals (kl|mq) indexed by pairs. */
+        for ( k = 0 ; k < n ; k++ )
+        {
+            for ( l = 0 ; l < n ; l++ )
+            {
+                for ( m = 0 ; m < n ; m++ )
+                {
+                    for ( q = 0 ; q < n ; q++ ) self->twoElectron[(k*n+l)*n2+m*n+q] = DoubleSymmetricMatrix_GetItem ( moTEIs, k, l, m, q, NULL ) ;
+                }
+            }
+        }
+        /* . Modified one-electron integrals. */
+        for ( k = 0 ; k < n ; k++ )
+        {
+            for ( l = 0 ; l < n ; l++ )
+            {
+                sum = SymmetricMatrix_Item ( fCoreMO, Maximum ( k, l ), Minimum ( k, l ) ) ;
+                for ( m = 0 ; m < n ; m++ ) sum -= 0.5e+00 * self->twoElectron[(k*n+m)*n2+m*n+l] ;
+                self->oneElectron[k*n+l] = sum ;
+            }
+        }
+        /* . Same-spin parts. */
+        CIStringSpace_MakeRows ( self->alphas, n, self->oneElectron, self->twoElectron, status ) ;
+        CIStringSpace_MakeRows ( self->betas , n, self->oneElectron, self->twoElectron, status ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Multiply a vector by the Hamiltonian (y = H * x).
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CIDirectHamiltonian_VectorMultiply ( const CIDirectHamiltonian *self, const RealArray1D *x, RealArray1D *y, Status *status )
+{
+    if ( ( self != NULL ) && ( x != NULL ) && ( y != NULL ) && Status_IsOK ( status ) )
+    {
+        auto RealArray2D xV, yV ;
+        RealArray2D_ViewOfRaw ( &xV, 0, 1, View1D_Extent ( x ), 0, x->stride, Array1D_ItemPointer ( x, 0 ) ) ;
+        RealArray2D_ViewOfRaw ( &yV, 0, 1, View1D_Extent ( y ), 0, y->stride, Array1D_ItemPointer ( y, 0 ) ) ;
+        CIDirectHamiltonian_VectorsMultiply ( self, &xV, &yV, status ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Multiply a block of vectors, stored as the rows of x and y, by the Hamiltonian.
+! . The work for each configuration is independent and so the configurations are done in parallel if possible.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CIDirectHamiltonian_VectorsMultiply ( const CIDirectHamiltonian *self, const RealArray2D *x, RealArray2D *y, Status *status )
+{
+    if ( ( self != NULL ) && ( x != NULL ) && ( y != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( View2D_Columns ( x ) != self->nConfigurations ) || ( View2D_Columns ( y ) != self->nConfigurations ) ||
+             ( View2D_Rows    ( x ) != View2D_Rows ( y )     ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Boolean isOK = True ;
+            auto Integer capacity ;
+            /* . The maximum number of terms for a configuration. */
+            capacity = self->alphas->rowCapacity + self->betas->rowCapacity + self->alphas->nExcitations * self->betas->nExcitations ;
+# ifdef USEOPENMP
+            #pragma omp parallel reduction ( && : isOK )
+# endif
+            {
+                auto CIStringSpace *alphas = self->alphas, *betas = self->betas ;
+                auto Integer        a, b, c, e, f, j, n, nB, n2, t, v, *indices, *lookUp = self->lookUp, *pA, *pB, *rI, *tA, *tB ;
+                auto Real           sA, sum, *rV, *sB, *terms, *v2 ;
+                nB      = betas->nStrings ;
+                n2      = self->nActive * self->nActive ;
+                indices = Memory_AllocateArrayOfTypes ( capacity, Integer ) ;
+                terms   = Memory_AllocateArrayOfTypes ( capacity, Real    ) ;
+                if ( ( indices == NULL ) || ( terms == NULL ) ) isOK = False ;
+                else
+                {
+                    /* . The terms for each configuration are gathered first and then applied to all vectors. */
+# ifdef USEOPENMP
+                    #pragma omp for schedule ( dynamic, 16 )
+# endif
+                    for ( c = 0 ; c < self->nConfigurations ; c++ )
+                    {
+                        a = self->alphaIndices[c] ;
+                        b = self->betaIndices [c] ;
+                        n = 0 ;
+                        /* . Alpha/alpha. */
+                        rI = &(alphas->rowIndices[a*alphas->rowCapacity]) ;
+                        rV = &(alphas->rowValues [a*alphas->rowCapacity]) ;
+                        for ( e = 0 ; e < alphas->rowCounts[a] ; e++ )
+                        {
+                            j = lookUp[rI[e]*nB+b] ;
+                            if ( j >= 0 ) { indices[n] = j ; terms[n] = rV[e] ; n++ ; }
+                        }
+                        /* . Beta/beta. */
+                        rI = &(betas->rowIndices[b*betas->rowCapacity]) ;
+                        rV = &(betas->rowValues [b*betas->rowCapacity]) ;
+                        for ( e = 0 ; e < betas->rowCounts[b] ; e++ )
+                        {
+                            j = lookUp[a*nB+rI[e]] ;
+                            if ( j >= 0 ) { indices[n] = j ; terms[n] = rV[e] ; n++ ; }
+                        }
+                        /* . Alpha/beta. */
+                        pA = &(alphas->pairs  [a*alphas->nExcitations]) ;
+                        tA = &(alphas->targets[a*alphas->nExcitations]) ;
+                        pB = &(betas->pairs   [b*betas->nExcitations ]) ;
+                        sB = &(betas->signs   [b*betas->nExcitations ]) ;
+                        tB = &(betas->targets [b*betas->nExcitations ]) ;
+                        for ( e = 0 ; e < alphas->nExcitations ; e++ )
+                        {
+                            sA = alphas->signs[a*alphas->nExcitations+e] ;
+                            v2 = &(self->twoElectron[pA[e]*n2]) ;
+                            for ( f = 0 ; f < betas->nExcitations ; f++ )
+                            {
+                                j = lookUp[tA[e]*nB+tB[f]] ;
+                                if ( j >= 0 ) { indices[n] = j ; terms[n] = sA * sB[f] * v2[pB[f]] ; n++ ; }
+                            }
+                        }
+                        /* . Products. */
+                        for ( v = 0 ; v < View2D_Rows ( x ) ; v++ )
+                        {
+                            for ( t = 0, sum = 0.0e+00 ; t < n ; t++ ) sum += terms[t] * Array2D_Item ( x, v, indices[t] ) ;
+                            Array2D_Item ( y, v, c ) = sum ;
+                        }
+                    }
+                }
+                Memory_Deallocate ( indices ) ;
+                Memory_Deallocate ( terms   ) ;
+            }
+            if ( ! isOK ) Status_Set ( status, Status_OutOfMemory ) ;
+        }
+    }
+}
+
+/*==================================================================================================================================
+! . String procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The address of a string given its occupied orbitals in increasing order.
+! . This is the combinatorial number system so that addresses run from 0 to C(nActive,nElectrons)-1.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer CIStrings_Address ( const Integer nActive, const Integer nElectrons, const Integer *occupied, const Integer *binomials )
+{
+    Integer i, address = 0 ;
+    for ( i = 0 ; i < nElectrons ; i++ ) address += binomials[occupied[i]*(nActive+1)+i+1] ;
+    return address ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . A table of binomial coefficients C(n,k) for n, k <= nActive.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer *CIStrings_Binomials ( const Integer nActive )
+{
+    Integer  m = nActive + 1, *binomials ;
+    binomials = Memory_AllocateArrayOfTypes ( m * m, Integer ) ;
+    if ( binomials != NULL )
+    {
+        auto Integer k, n ;
+        for ( n = 0 ; n < m ; n++ )
+        {
+            binomials[n*m] = 1 ;
+            for ( k = 1 ; k <= n ; k++ ) binomials[n*m+k] = binomials[(n-1)*m+k-1] + ( ( k < n ) ? binomials[(n-1)*m+k] : 0 ) ;
+            for ( k = n+1 ; k < m ; k++ ) binomials[n*m+k] = 0 ;
+        }
+    }
+    return binomials ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The address of a string given as an array of occupancies.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Integer CIStrings_FromOccupancies ( const Integer nActive, const IntegerArray1D *occupancy, const Integer *binomials )
+{
+    Integer i, address = 0, n = 0 ;
+    for ( i = 0 ; i < nActive ; i++ )
+    {
+        if ( Array1D_Item ( occupancy, i ) != 0 ) { n++ ; address += binomials[i*(nActive+1)+n] ; }
+    }
+    return address ;
+}
+
+/*==================================================================================================================================
+! . String space procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation of a string space and its single excitations.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static CIStringSpace *CIStringSpace_Allocate ( const Integer nActive, const Integer nElectrons, const Integer *binomials, Status *status )
+{
+    CIStringSpace *self = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        auto Integer  m = nActive + 1, nDoubles, nHoles, nStrings, size ;
+        self = Memory_AllocateType ( CIStringSpace ) ;
+        if ( self == NULL ) goto FinishUp ;
+        nHoles   = nActive - nElectrons ;
+        nStrings = binomials[nActive*m+nElectrons] ;
+        nDoubles = ( ( nElectrons * ( nElectrons - 1 ) ) / 2 ) * ( ( nHoles * ( nHoles - 1 ) ) / 2 ) ;
+        self->nElectrons   = nElectrons ;
+        self->nExcitations = nElectrons * ( nHoles + 1 ) ;
+        self->nStrings     = nStrings ;
+        self->rowCapacity  = 1 + nElectrons * nHoles + nDoubles ;
+        size               = self->nExcitations * nStrings ;
+        self->pairs        = Memory_AllocateArrayOfTypes ( Maximum ( size, 1 ), Integer ) ;
+        self->signs        = Memory_AllocateArrayOfTypes ( Maximum ( size, 1 ), Real    ) ;
+        self->targets      = Memory_AllocateArrayOfTypes ( Maximum ( size, 1 ), Integer ) ;
+        self->rowCounts    = Memory_AllocateArrayOfTypes ( nStrings, Integer ) ;
+        self->rowIndices   = Memory_AllocateArrayOfTypes ( nStrings * self->rowCapacity, Integer ) ;
+        self->rowValues    = Memory_AllocateArrayOfTypes ( nStrings * self->rowCapacity, Real    ) ;
+        if ( ( self->pairs      == NULL ) ||
+             ( self->signs      == NULL ) ||
+             ( self->targets    == NULL ) ||
+             ( self->rowCounts  == NULL ) ||
+             ( self->rowIndices == NULL ) ||
+             ( self->rowValues  == NULL ) ) goto FinishUp ;
+        /* . Generate the strings in lexical order. */
+        if ( nElectrons > 0 )
+        {
+            auto Boolean *isOccupied = NULL ;
+            auto Integer  e, h, i, I, j, k, l, p, s, *newOccupied = NULL, *occupied = NULL ;
+            isOccupied  = Memory_AllocateArrayOfTypes ( nActive   , Boolean ) ;
+            newOccupied = Memory_AllocateArrayOfTypes ( nElectrons, Integer ) ;
+            occupied    = Memory_AllocateArrayOfTypes ( nElectrons, Integer ) ;
+            if ( ( isOccupied != NULL ) && ( newOccupied != NULL ) && ( occupied != NULL ) )
+            {
+                for ( i = 0 ; i < nElectrons ; i++ ) occupied[i] = i ;
+                for ( s = 0 ; s < nStrings ; s++ )
+                {
+                    /* . The current string. */
+                    I = CIStrings_Address ( nActive, nElectrons, occupied, binomials ) ;
+                    for ( k = 0 ; k < nActive    ; k++ ) isOccupied[k] = False ;
+                    for ( i = 0 ; i < nElectrons ; i++ ) isOccupied[occupied[i]] = True ;
+                    /* . Excitations from l to k. */
+                    for ( e = i = 0 ; i < nElectrons ; i++ )
+                    {
+                        l = occupied[i] ;
+                        for ( k = 0 ; k < nActive ; k++ )
+                        {
+                            if ( isOccupied[k] && ( k != l ) ) continue ;
+                            /* . The target string and sign. */
+                            for ( h = j = 0 ; j < nElectrons ; j++ ) { if ( j != i ) { newOccupied[h] = occupied[j] ; h++ ; } }
+                            for ( j = nElectrons - 1 ; ( j > 0 ) && ( newOccupied[j-1] > k ) ; j-- ) newOccupied[j] = newOccupied[j-1] ;
+                            newOccupied[j] = k ;
+                            for ( h = 0, p = 0 ; h < nElectrons ; h++ )
+                            {
+                                if ( ( occupied[h] > Minimum ( k, l ) ) && ( occupied[h] < Maximum ( k, l ) ) ) p++ ;
+                            }
+                            self->pairs  [I*self->nExcitations+e] = k * nActive + l ;
+                            self->signs  [I*self->nExcitations+e] = ( IsOdd ( p ) ? -1.0e+00 : 1.0e+00 ) ;
+                            self->targets[I*self->nExcitations+e] = CIStrings_Address ( nActive, nElectrons, newOccupied, binomials ) ;
+                            e++ ;
+                        }
+                    }
+                    /* . The next string. */
+                    if ( s < ( nStrings - 1 ) )
+                    {
+                        i = nElectrons - 1 ;
+                        while ( occupied[i] == ( nHoles + i ) ) i-- ;
+                        occupied[i] += 1 ;
+                        for ( j = i+1 ; j < nElectrons ; j++ ) occupied[j] = occupied[j-1] + 1 ;
+                    }
+                }
+            }
+            else Status_Set ( status, Status_OutOfMemory ) ;
+            Memory_Deallocate ( isOccupied  ) ;
+            Memory_Deallocate ( newOccupied ) ;
+            Memory_Deallocate ( occupied    ) ;
+        }
+        if ( Status_IsOK ( status ) ) return self ;
+    FinishUp:
+        CIStringSpace_Deallocate ( &self ) ;
+        Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void CIStringSpace_Deallocate ( CIStringSpace **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->pairs      ) ;
+        Memory_Deallocate ( (*self)->rowCounts  ) ;
+        Memory_Deallocate ( (*self)->rowIndices ) ;
+        Memory_Deallocate ( (*self)->rowValues  ) ;
+        Memory_Deallocate ( (*self)->signs      ) ;
+        Memory_Deallocate ( (*self)->targets    ) ;
+        Memory_Deallocate ( (*self) ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make the same-spin part of the Hamiltonian for each string.
+! . <I|H|J> = Sum_K <I|E_lk|K> ( h'_kl delta_KJ + 1/2 Sum_mn (kl|mn) <K|E_nm|J> ).
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void CIStringSpace_MakeRows (       CIStringSpace *self        ,
+                                     const Integer        nActive     ,
+                                     const Real          *oneElectron ,
+                                     const Real          *twoElectron ,
+                                           Status        *status      )
+{
+    if ( ( self != NULL ) && Status_IsOK ( status ) )
+    {
+        auto Integer *touched = NULL ;
+        auto Real    *work    = NULL ;
+        touched = Memory_AllocateArrayOfTypes ( self->nStrings, Integer ) ;
+        work    = Memory_AllocateArrayOfTypes ( self->nStrings, Real    ) ;
+        if ( ( touched != NULL ) && ( work != NULL ) )
+        {
+            auto Integer     e, f, I, J, K, n, nE = self->nExcitations, n2 = nActive * nActive, p ;
+            auto Real        s ;
+            auto const Real *v ;
+            for ( J = 0 ; J < self->nStrings ; J++ ) { touched[J] = -1 ; work[J] = 0.0e+00 ; }
+            for ( I = 0 ; I < self->nStrings ; I++ )
+            {
+                n = 0 ;
+                for ( e = 0 ; e < nE ; e++ )
+                {
+                    K = self->targets[I*nE+e] ;
+                    p = self->pairs  [I*nE+e] ;
+                    s = self->signs  [I*nE+e] ;
+                    if ( touched[K] != I ) { touched[K] = I ; self->rowIndices[I*self->rowCapacity+n] = K ; n++ ; }
+                    work[K] += s * oneElectron[p] ;
+                    v = &(twoElectron[p*n2]) ;
+                    for ( f = 0 ; f < nE ; f++ )
+                    {
+                        J = self->targets[K*nE+f] ;
+                        if ( touched[J] != I ) { touched[J] = I ; self->rowIndices[I*self->rowCapacity+n] = J ; n++ ; }
+                        work[J] += 0.5e+00 * s * self->signs[K*nE+f] * v[self->pairs[K*nE+f]] ;
+                    }
+                }
+                /* . Save the row and reset the work space. */
+                self->rowCounts[I] = n ;
+                for ( e = 0 ; e < n ; e++ )
+                {
+                    J = self->rowIndices[I*self->rowCapacity+e] ;
+                    self->rowValues[I*self->rowCapacity+e] = work[J] ;
+                    work[J] = 0.0e+00 ;
+                }
+            }
+        }
+        else Status_Set ( status, Status_OutOfMemory ) ;
+        Memory_Deallocate ( touched ) ;
+        Memory_Deallocate ( work    ) ;
+    }
+}
+
+# undef _Small
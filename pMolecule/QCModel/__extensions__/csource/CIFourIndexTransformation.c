@@ -4,6 +4,9 @@
 
 # include <math.h>
 # include <stdlib.h>
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
 
 # include "CIFourIndexTransformation.h"
 # include "Integer.h"
@@ -13,31 +16,39 @@
 /*==================================================================================================================================
 ! . Local procedures declarations.
 !=================================================================================================================================*/
-static void CIFIT_TransformIndex1    ( const RealArray2D *mos, const RealArrayND *tei234, DoubleSymmetricMatrix *moTEIs ) ;
-static void CIFIT_TransformIndex2    ( const RealArray2D *mos, const RealArray2D *tei34, RealArrayND *tei234 ) ;
-static void CIFIT_TransformIndices34 ( const RealArray2D *mos, BlockStorage *twoElectronIntegrals, RealArray2D *tei34 ) ;
+static void CIFIT_TransformIndex1    ( const RealArray2D *mos, const RealArrayND *tei234, DoubleSymmetricMatrix *moTEIs, Status *status ) ;
+static void CIFIT_TransformIndex2    ( const RealArray2D *mos, const RealArray2D *tei34, RealArrayND *tei234, Status *status ) ;
+static void CIFIT_TransformIndices34 ( const RealArray2D *mos, BlockStorage *twoElectronIntegrals, RealArray2D *tei34, Status *status ) ;
 
 /*==================================================================================================================================
 ! . Public procedures.
 !=================================================================================================================================*/
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . A no-nonsense four index transformation for small numbers of MOs only.
+! . The AO integrals are sparse and so indices 3 and 4 are transformed by looping over the integrals whereas indices 2 and 1
+!   are transformed with dense matrix multiplications.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 void CIFourIndexTransformation ( const RealArray2D           *activeMOs            ,
                                        BlockStorage          *twoElectronIntegrals ,
                                        RealArray2D           *moTEI34              ,
                                        RealArrayND           *moTEI234             ,
-                                       DoubleSymmetricMatrix *moTEIs               )
+                                       DoubleSymmetricMatrix *moTEIs               ,
+                                       Status                *status               )
 {
     if ( ( activeMOs            != NULL ) &&
          ( twoElectronIntegrals != NULL ) &&
          ( moTEI34              != NULL ) &&
          ( moTEI234             != NULL ) &&
-         ( moTEIs               != NULL ) )
+         ( moTEIs               != NULL ) &&
+         Status_IsOK ( status ) )
     {
-        CIFIT_TransformIndices34 ( activeMOs, twoElectronIntegrals, moTEI34  ) ;
-        CIFIT_TransformIndex2    ( activeMOs, moTEI34             , moTEI234 ) ;
-        CIFIT_TransformIndex1    ( activeMOs, moTEI234            , moTEIs   ) ;
+        if ( ! View2D_IsCompact1 ( activeMOs ) || ! View2D_IsCompact ( moTEI34 ) || ! ViewND_IsCompact ( moTEI234->view ) ) Status_Set ( status, Status_InvalidArrayOperation ) ;
+        else
+        {
+            CIFIT_TransformIndices34 ( activeMOs, twoElectronIntegrals, moTEI34 , status ) ;
+            CIFIT_TransformIndex2    ( activeMOs, moTEI34             , moTEI234, status ) ;
+            CIFIT_TransformIndex1    ( activeMOs, moTEI234            , moTEIs  , status ) ;
+        }
     }
 }
 
@@ -46,136 +57,184 @@ void CIFourIndexTransformation ( const RealArray2D           *activeMOs
 !=================================================================================================================================*/
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Transform index 1 by reading the hybrid integrals already with indices 2, 3 and 4 transformed.
+! . This is a single multiplication, C^T * T, with T the hybrid integrals treated as a nBasis x ( nActive * nActivePairs ) matrix.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static void CIFIT_TransformIndex1 ( const RealArray2D *mos, const RealArrayND *tei234, DoubleSymmetricMatrix *moTEIs )
+static void CIFIT_TransformIndex1 ( const RealArray2D *mos, const RealArrayND *tei234, DoubleSymmetricMatrix *moTEIs, Status *status )
 {
-    if  ( ( mos != NULL ) && ( tei234 != NULL ) && ( moTEIs != NULL ) )
+    if  ( ( mos != NULL ) && ( tei234 != NULL ) && ( moTEIs != NULL ) && Status_IsOK ( status ) )
     {
-        auto Integer  i, nActive, nBasis, p, pq, q, r, rs, s, upper ;
-        auto Real     sum ;
-
-        /* . Initialization. */
+        auto Integer      nActive, nATr, nBasis ;
+        auto RealArray2D *work ;
+        auto RealArray2D  t ;
         nActive = View2D_Columns ( mos ) ;
         nBasis  = View2D_Rows    ( mos ) ;
-        DoubleSymmetricMatrix_Set ( moTEIs, 0.0e+00 ) ;
-
-        /* . Loop over MOs. */
-        for ( p = pq = 0 ; p < nActive ; p++ )
+        nATr    = ( nActive * ( nActive + 1 ) ) / 2 ;
+        work    = RealArray2D_AllocateWithExtents ( nActive, nActive * nATr, status ) ;
+        if ( work != NULL )
         {
-            for ( q = 0 ; q <= p ; q++, pq++ )
+            auto Integer p, pq, q, r, rs, s, upper ;
+            RealArray2D_ViewOfRaw ( &t, 0, nBasis, nActive * nATr, nActive * nATr, 1, ArrayND_Data ( tei234 ) ) ;
+            RealArray2D_MatrixMultiply ( True, False, 1.0e+00, mos, &t, 0.0e+00, work, status ) ;
+            DoubleSymmetricMatrix_Set ( moTEIs, 0.0e+00 ) ;
+            for ( p = pq = 0 ; p < nActive ; p++ )
             {
-                for ( r = rs = 0 ; r <= p ; r++ )
+                for ( q = 0 ; q <= p ; q++, pq++ )
                 {
-                    if ( r == p ) upper = q ;
-                    else          upper = r ;
-                    for ( s = 0 ; s <= upper ; s++, rs++ )
+                    for ( r = rs = 0 ; r <= p ; r++ )
                     {
-                        /* . This is a dot-product so ultimately should use slices. */
-                        for ( i = 0, sum = 0.0e+00 ; i < nBasis ; i++ ) sum += Array2D_Item ( mos, i, p ) * ArrayND_Item3D ( tei234, i, q, rs ) ;
-                        DoubleSymmetricMatrix_SetItem ( moTEIs, p, q, r, s, sum, NULL ) ;
+                        if ( r == p ) upper = q ;
+                        else          upper = r ;
+                        for ( s = 0 ; s <= upper ; s++, rs++ ) DoubleSymmetricMatrix_SetItem ( moTEIs, p, q, r, s, Array2D_Item ( work, p, q*nATr+rs ), NULL ) ;
                     }
                 }
             }
+            RealArray2D_Deallocate ( &work ) ;
         }
     }
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Transform index 2 by reading the hybrid integrals already with indices 3 and 4 transformed.
+! . For each AO i the hybrid integrals (ij|rs) are unpacked into a dense nBasis x nActivePairs matrix, U, which is then
+!   transformed as C^T * U. The AOs are independent and so are done in parallel if possible.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static void CIFIT_TransformIndex2 ( const RealArray2D *mos, const RealArray2D *tei34, RealArrayND *tei234 )
+static void CIFIT_TransformIndex2 ( const RealArray2D *mos, const RealArray2D *tei34, RealArrayND *tei234, Status *status )
 {
-    if  ( ( mos != NULL ) && ( tei34 != NULL ) && ( tei234 != NULL ) )
+    if  ( ( mos != NULL ) && ( tei34 != NULL ) && ( tei234 != NULL ) && Status_IsOK ( status ) )
     {
-        auto Integer  i, ij, j, nActive, nBasis,q, r, rs, s ;
-        auto Real     t ;
-
-        /* . Initialization. */
-        nActive = View2D_Columns ( mos ) ;
-        nBasis  = View2D_Rows    ( mos ) ;
-        RealArrayND_Set ( tei234, 0.0e+00, NULL ) ;
-
-        /* . Loop over MO pairs. */
-        for ( r = rs = 0 ; r < nActive ; r++ )
+        auto Boolean isOK = True ;
+        auto Integer nActive, nATr, nBasis ;
+        nActive = View2D_Columns ( mos   ) ;
+        nBasis  = View2D_Rows    ( mos   ) ;
+        nATr    = View2D_Columns ( tei34 ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel reduction ( && : isOK )
+# endif
         {
-            for ( s = 0 ; s <= r ; s++, rs++ )
+            auto Integer      i, j ;
+            auto RealArray2D *unpacked ;
+            auto RealArray2D  t ;
+            auto Status       localStatus = Status_OK ;
+            unpacked = RealArray2D_AllocateWithExtents ( nBasis, nATr, &localStatus ) ;
+            if ( unpacked == NULL ) isOK = False ;
+            else
             {
-                /* . Loop over AOs. */
-                for ( i = ij = 0 ; i < nBasis ; i++ )
+# ifdef USEOPENMP
+                #pragma omp for schedule ( dynamic )
+# endif
+                for ( i = 0 ; i < nBasis ; i++ )
                 {
-                    for ( j = 0 ; j <= i ; ij++, j++ )
+                    for ( j = 0 ; j < nBasis ; j++ )
                     {
-                        t  = Array2D_Item ( tei34, ij, rs ) ;
-                        if ( i == j ) t *= 0.5e+00 ;
-                        for ( q = 0 ; q < nActive ; q++ )
-                        {
-                            ArrayND_Item3D ( tei234, i, q, rs ) += t * Array2D_Item ( mos, j, q ) ;
-                            ArrayND_Item3D ( tei234, j, q, rs ) += t * Array2D_Item ( mos, i, q ) ;
-                        }
+                        auto Integer  ij = ( ( i >= j ) ? SymmetricMatrix_ItemIndex ( i, j ) : SymmetricMatrix_ItemIndex ( j, i ) ) ;
+                        auto Integer  rs ;
+                        auto Real    *source = Array2D_RowPointer ( tei34, ij ), *target = Array2D_RowPointer ( unpacked, j ) ;
+                        for ( rs = 0 ; rs < nATr ; rs++ ) target[rs] = source[rs] ;
                     }
+                    RealArray2D_ViewOfRaw ( &t, 0, nActive, nATr, nATr, 1, &ArrayND_Item3D ( tei234, i, 0, 0 ) ) ;
+                    RealArray2D_MatrixMultiply ( True, False, 1.0e+00, mos, unpacked, 0.0e+00, &t, &localStatus ) ;
                 }
+                if ( localStatus != Status_OK ) isOK = False ;
+                RealArray2D_Deallocate ( &unpacked ) ;
             }
         }
+        if ( ! isOK ) Status_Set ( status, Status_OutOfMemory ) ;
     }
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Transform indices 3 and 4 together by reading the A.O. integrals.
+! . The pair transformation, P(kl,rs) = w(kl) ( C(k,r) C(l,s) + C(l,r) C(k,s) ), is calculated first so that each integral
+!   (ij|kl) only adds rows of P to rows of the transformed integrals. The integrals are read once per thread with each thread
+!   treating a different range of MO pairs.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static void CIFIT_TransformIndices34 ( const RealArray2D *mos, BlockStorage *twoElectronIntegrals, RealArray2D *tei34 )
+static void CIFIT_TransformIndices34 ( const RealArray2D *mos, BlockStorage *twoElectronIntegrals, RealArray2D *tei34, Status *status )
 {
-    if  ( ( mos != NULL ) && ( twoElectronIntegrals != NULL ) && ( tei34 != NULL ) )
+    if  ( ( mos != NULL ) && ( twoElectronIntegrals != NULL ) && ( tei34 != NULL ) && Status_IsOK ( status ) )
     {
-        auto Integer  i, ii, ij, j, k, kl, l, m, n, nActive, r, rs, s ;
-        auto Real     t, wij, wkl ;
-        auto Block   *block ;
+        auto Integer      nActive, nATr, nBasis ;
+        auto RealArray2D *pairs ;
 
         /* . Initialization. */
-        nActive = View2D_Columns ( mos ) ;
+        nActive = View2D_Columns ( mos   ) ;
+        nBasis  = View2D_Rows    ( mos   ) ;
+        nATr    = View2D_Columns ( tei34 ) ;
+        pairs   = RealArray2D_AllocateWithExtents ( View2D_Rows ( tei34 ), nATr, status ) ;
         RealArray2D_Set ( tei34, 0.0e+00 ) ;
-
-        /* . Loop over the integral blocks. */
-        List_Iterate_Initialize ( twoElectronIntegrals->blocks ) ;
-        while ( ( block = BlockStorage_Iterate ( twoElectronIntegrals ) ) != NULL )
+        if ( pairs != NULL )
         {
-            /* . Loop over the integrals. */
-            for ( ii = 0, n = 0 ; ii < block->count ; ii++, n += 4 )
-            {
-                /* . Get the data. */
-                i = block->indices16[n  ] ;
-                j = block->indices16[n+1] ;
-                k = block->indices16[n+2] ;
-                l = block->indices16[n+3] ;
-                t = block->data[ii] ;
-
-                /* . Shuffle the index pairs. */
-	        if ( i < j ) { m = i ; i = j ; j = m ; }
-                if ( k < l ) { m = k ; k = l ; l = m ; }
-
-                /* . Shuffle the indices of both pairs. */
-                if ( ( i < k ) || ( ( i == k ) && ( j < l  ) ) ) { m = i ; i = k ; k = m ; m = j ; j = l ; l = m ; }
-
-                /* . RealArray2D indices. */
-                ij = SymmetricMatrix_ItemIndex ( i, j ) ;
-                kl = SymmetricMatrix_ItemIndex ( k, l ) ;
+            auto Integer k, kl, l, r, rs, s ;
+            auto Real    w, *p ;
 
-                /* . Get the appropriate scaling factors. */
-                wij = 1.0e+00 ;
-                wkl = 1.0e+00 ;
-	        if ( i == j ) wij *= 0.5e+00 ;
-	        if ( k == l ) wkl *= 0.5e+00 ;
-                if ( ij == kl ) { wij *= 0.5e+00 ; wkl *= 0.5e+00 ; }
+            /* . The pair transformation. */
+            for ( k = kl = 0 ; k < nBasis ; k++ )
+            {
+                for ( l = 0 ; l <= k ; kl++, l++ )
+                {
+                    p = Array2D_RowPointer ( pairs, kl ) ;
+                    w = ( ( k == l ) ? 0.5e+00 : 1.0e+00 ) ;
+                    for ( r = rs = 0 ; r < nActive ; r++ )
+                    {
+                        for ( s = 0 ; s <= r ; rs++, s++ ) p[rs] = w * ( Array2D_Item ( mos, k, r ) * Array2D_Item ( mos, l, s ) + Array2D_Item ( mos, l, r ) * Array2D_Item ( mos, k, s ) ) ;
+                    }
+                }
+            }
 
-                /* . Loop over MO pairs. */
-                for ( r = rs = 0 ; r < nActive ; r++ )
+            /* . Loop over the integrals. */
+# ifdef USEOPENMP
+            #pragma omp parallel
+# endif
+            {
+                auto Block       *block ;
+                auto ListElement *element ;
+                auto Integer  i, ii, ij, j, k, kl, l, m, n, rs, start, stop ;
+                auto Real     t, *pIJ, *pKL, *tIJ, *tKL ;
+# ifdef USEOPENMP
+                auto Integer  nThreads = omp_get_num_threads ( ), thread = omp_get_thread_num ( ) ;
+# else
+                auto Integer  nThreads = 1, thread = 0 ;
+# endif
+                start = (   thread       * nATr ) / nThreads ;
+                stop  = ( ( thread + 1 ) * nATr ) / nThreads ;
+                if ( start < stop )
                 {
-                    for ( s = 0 ; s <= r ; rs++, s++ )
+                    /* . Loop over the integral blocks. */
+                    for ( element = twoElectronIntegrals->blocks->first ; element != NULL ; element = element->next )
                     {
-                        Array2D_Item ( tei34, ij, rs ) += t * ( Array2D_Item ( mos, k, r ) * Array2D_Item ( mos, l, s ) + Array2D_Item ( mos, l, r ) * Array2D_Item ( mos, k, s ) ) * wkl ;
-                        Array2D_Item ( tei34, kl, rs ) += t * ( Array2D_Item ( mos, i, r ) * Array2D_Item ( mos, j, s ) + Array2D_Item ( mos, j, r ) * Array2D_Item ( mos, i, s ) ) * wij ;
+                        block = ( Block * ) element->node ;
+                        for ( ii = 0, n = 0 ; ii < block->count ; ii++, n += 4 )
+                        {
+                            /* . Get the data. */
+                            i = block->indices16[n  ] ;
+                            j = block->indices16[n+1] ;
+                            k = block->indices16[n+2] ;
+                            l = block->indices16[n+3] ;
+                            t = block->data[ii] ;
+
+                            /* . Shuffle the index pairs. */
+                            if ( i < j ) { m = i ; i = j ; j = m ; }
+                            if ( k < l ) { m = k ; k = l ; l = m ; }
+
+                            /* . Pair indices. */
+                            ij  = SymmetricMatrix_ItemIndex ( i, j ) ;
+                            kl  = SymmetricMatrix_ItemIndex ( k, l ) ;
+                            pIJ = Array2D_RowPointer ( pairs, ij ) ;
+                            pKL = Array2D_RowPointer ( pairs, kl ) ;
+                            tIJ = Array2D_RowPointer ( tei34, ij ) ;
+                            tKL = Array2D_RowPointer ( tei34, kl ) ;
+
+                            /* . Accumulate. */
+                            if ( ij == kl ) { for ( rs = start ; rs < stop ; rs++ ) tIJ[rs] += t * pIJ[rs] ; }
+                            else
+                            {
+                                for ( rs = start ; rs < stop ; rs++ ) tIJ[rs] += t * pKL[rs] ;
+                                for ( rs = start ; rs < stop ; rs++ ) tKL[rs] += t * pIJ[rs] ;
+                            }
+                        }
                     }
                 }
             }
+            RealArray2D_Deallocate ( &pairs ) ;
         }
     }
 }
@@ -2,49 +2,84 @@
 ! . Module for CI sparse matrix diagonalization.
 ! . Functions for the primme solver.
 !=================================================================================================================================*/
+/*
+! . Primme passes blocks of vectors that are stored contiguously, one after the other. A null block size is taken to be 1.
+*/
 
 # include <stdio.h>
 # include <stdlib.h>
 
+# include "CIDirectHamiltonian.h"
 # include "CISparseSolver.h"
 # include "Real.h"
 # include "RealArray1D.h"
+# include "RealArray2D.h"
 # include "SparseSymmetricMatrix.h"
 
 /*----------------------------------------------------------------------------------------------------------------------------------
-! . Apply the CI matrix to a vector.
+! . Local procedures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void CISparseSolver_BlockViews ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme, RealArray2D *hV, RealArray2D *v ) ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Apply the CI matrix to a block of vectors.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 void CISparseSolver_ApplyMatrix ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme )
 {
-    Real                  *x, *y ;
-    RealArray1D            hV, v ;
-    SparseSymmetricMatrix *matrix ;
-    /* . Casts. */
-    matrix = ( SparseSymmetricMatrix * ) primme->matrix ;
-    x      = ( Real * ) xVoid ;
-    y      = ( Real * ) yVoid ;
-    /* . Views. */
-    RealArray1D_ViewOfRaw (  &v, 0, primme->n, 1, x ) ;
-    RealArray1D_ViewOfRaw ( &hV, 0, primme->n, 1, y ) ;
-    /* . Calculate H * v. */
-    SparseSymmetricMatrix_VectorMultiply ( matrix, &v, &hV, NULL ) ;
+    RealArray2D hV, v ;
+    CISparseSolver_BlockViews ( xVoid, yVoid, blockSize, primme, &hV, &v ) ;
+    SparseSymmetricMatrix_VectorsMultiply ( ( SparseSymmetricMatrix * ) primme->matrix, &v, &hV, NULL ) ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Apply the direct CI Hamiltonian to a block of vectors.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void CISparseSolver_ApplyDirectMatrix ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme )
+{
+    RealArray2D hV, v ;
+    CISparseSolver_BlockViews ( xVoid, yVoid, blockSize, primme, &hV, &v ) ;
+    CIDirectHamiltonian_VectorsMultiply ( ( CIDirectHamiltonian * ) primme->matrix, &v, &hV, NULL ) ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
-! . Apply the CI matrix preconditioner to a vector.
+! . Apply the CI matrix preconditioner to a block of vectors.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 void CISparseSolver_ApplyPreconditioner ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme )
 {
+    Integer      i, n, nV ;
     Real        *x, *y ;
-    RealArray1D  hV, v, *preconditioner ;
+    RealArray1D *preconditioner ;
     /* . Casts. */
     preconditioner = ( RealArray1D * ) primme->preconditioner ;
     x              = ( Real * ) xVoid ;
     y              = ( Real * ) yVoid ;
-    /* . Views. */
-    RealArray1D_ViewOfRaw (  &v, 0, primme->n, 1, x ) ;
-    RealArray1D_ViewOfRaw ( &hV, 0, primme->n, 1, y ) ;
-    /* . Calculate v / Diagonal ( h ). */
-    RealArray1D_CopyTo   ( &v , &hV           , NULL ) ;
-    RealArray1D_Multiply ( &hV, preconditioner, NULL ) ;
+    /* . Calculate v / Diagonal ( h ) or copy v if there is no preconditioner. */
+    n  = primme->n ;
+    nV = ( ( blockSize == NULL ) ? 1 : (*blockSize) ) ;
+    if ( preconditioner == NULL )
+    {
+# ifdef USEOPENMP
+        #pragma omp parallel for schedule ( static )
+# endif
+        for ( i = 0 ; i < n * nV ; i++ ) y[i] = x[i] ;
+    }
+    else
+    {
+# ifdef USEOPENMP
+        #pragma omp parallel for schedule ( static )
+# endif
+        for ( i = 0 ; i < n * nV ; i++ ) y[i] = x[i] * Array1D_Item ( preconditioner, i % n ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Views of the input and output blocks with one vector per row.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void CISparseSolver_BlockViews ( void *xVoid, void *yVoid, Integer *blockSize, primme_params *primme, RealArray2D *hV, RealArray2D *v )
+{
+    Integer n, nV ;
+    n  = primme->n ;
+    nV = ( ( blockSize == NULL ) ? 1 : (*blockSize) ) ;
+    RealArray2D_ViewOfRaw ( hV, 0, nV, n, n, 1, ( Real * ) yVoid ) ;
+    RealArray2D_ViewOfRaw (  v, 0, nV, n, n, 1, ( Real * ) xVoid ) ;
 }
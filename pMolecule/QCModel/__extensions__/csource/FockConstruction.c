@@ -272,6 +272,78 @@ Real Fock_MakeFromTEIs (       BlockStorage    *twoElectronIntegrals ,
     return eTEI ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Form the two-electron parts of several spin-free Fock matrices with a single pass over the integrals.
+! . The density and Fock matrices are stored in packed symmetric form as the rows of dTotals and fTotals.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void Fock_MakeFromTEIsMultiple (       BlockStorage *twoElectronIntegrals ,
+                                 const RealArray2D  *dTotals              ,
+                                 const Real          exchangeScaling      ,
+                                       RealArray2D  *fTotals              ,
+                                       Status       *status               )
+{
+    if  ( ( twoElectronIntegrals != NULL ) && ( dTotals != NULL ) && ( fTotals != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( View2D_Rows ( dTotals ) != View2D_Rows ( fTotals ) ) || ( View2D_Columns ( dTotals ) != View2D_Columns ( fTotals ) ) ||
+             ! View2D_IsCompact1 ( dTotals ) || ! View2D_IsCompact1 ( fTotals ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else
+        {
+            auto Block   *block ;
+            auto Integer  i, i1, i2, i3, i4, j, m, n, nIJ, nIK, nIL, nJK, nJL, nKL, t ;
+            auto Real     value, *d, *f ;
+            RealArray2D_Set ( fTotals, 0.0e+00 ) ;
+            List_Iterate_Initialize ( twoElectronIntegrals->blocks ) ;
+            while ( ( block = BlockStorage_Iterate ( twoElectronIntegrals ) ) != NULL )
+            {
+                for ( i = 0, n = 0 ; i < block->count ; i++, n += 4 )
+                {
+                    i1    = block->indices16[n  ] ;
+                    i2    = block->indices16[n+1] ;
+                    i3    = block->indices16[n+2] ;
+                    i4    = block->indices16[n+3] ;
+                    value = block->data[i] ;
+	            if ( i1 < i2 ) { t = i1 ; i1 = i2 ; i2 = t ; }
+                    if ( i3 < i4 ) { t = i3 ; i3 = i4 ; i4 = t ; }
+                    if ( ( i1 < i3 ) || ( ( i1 == i3 ) && ( i2 < i4  ) ) ) { t = i1 ; i1 = i3 ; i3 = t ; t = i2 ; i2 = i4 ; i4 = t ; }
+	            if ( i1 == i2 ) value *= 0.5e+00 ;
+	            if ( i3 == i4 ) value *= 0.5e+00 ;
+                    if ( ( i1 == i3 ) && ( i2 == i4 ) ) value *= 0.5e+00 ;
+                    nIJ = BFINDEX ( i1 ) + i2 ;
+                    nKL = BFINDEX ( i3 ) + i4 ;
+                    nIK = BFINDEX ( i1 ) + i3 ;
+                    nIL = BFINDEX ( i1 ) + i4 ;
+                    if ( i2 > i3 ) nJK = BFINDEX ( i2 ) + i3 ;
+                    else           nJK = BFINDEX ( i3 ) + i2 ;
+                    if ( i2 > i4 ) nJL = BFINDEX ( i2 ) + i4 ;
+                    else           nJL = BFINDEX ( i4 ) + i2 ;
+                    for ( m = 0 ; m < View2D_Rows ( dTotals ) ; m++ )
+                    {
+                        d = Array2D_RowPointer ( dTotals, m ) ;
+                        f = Array2D_RowPointer ( fTotals, m ) ;
+                        /* . Coulomb. */
+                        f[nIJ] += 4.0e+00 * value * d[nKL] ;
+                        f[nKL] += 4.0e+00 * value * d[nIJ] ;
+                        /* . Exchange. */
+                        f[nIK] -= exchangeScaling * value * d[nJL] ;
+                        f[nIL] -= exchangeScaling * value * d[nJK] ;
+                        f[nJK] -= exchangeScaling * value * d[nIL] ;
+                        f[nJL] -= exchangeScaling * value * d[nIK] ;
+                    }
+                }
+            }
+            /* . Scale the off-diagonal elements. */
+            for ( m = 0 ; m < View2D_Rows ( fTotals ) ; m++ )
+            {
+                f = Array2D_RowPointer ( fTotals, m ) ;
+                for ( i = n = 0 ; n < View2D_Columns ( fTotals ) ; i++, n++ )
+                {
+                    for ( j = 0 ; j < i ; j++, n++ ) f[n] *= 0.5e+00 ;
+                }
+            }
+        }
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Form the Coulomb two-electron part of the Fock matrices.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -28,35 +28,49 @@ extern Real MNDO_CoreCoreEnergy ( const MNDOParametersContainer *parameters   ,
     if ( ( parameters   != NULL ) &&
          ( coordinates3 != NULL ) )
     {
-        auto Boolean         doGradients = ( gradients3 != NULL ) ; 
-        auto Integer         i, j ;
-        auto MNDOParameters *iData, *jData ;
-        auto Real            f, g, *gP = NULL, R, xI, xIJ, yI, yIJ, zI, zIJ ;
-        if ( doGradients ) gP = &g ;
-        for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
+        auto Boolean  doGradients = ( gradients3 != NULL ) ;
+        auto Integer  numberOfThreads ;
+        auto Real    *threadBuffers ;
+        threadBuffers = Coordinates3_AllocateThreadBuffers ( gradients3, &numberOfThreads ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
         {
-            iData = parameters->entries[i] ;
-            xI    = Coordinates3_Item ( coordinates3, i, 0 ) ;
-            yI    = Coordinates3_Item ( coordinates3, i, 1 ) ;
-            zI    = Coordinates3_Item ( coordinates3, i, 2 ) ;
-            for ( j = 0 ; j < i ; j++ )
+            auto Coordinates3    view, *threadGradients3 ;
+            auto Integer         i, j ;
+            auto MNDOParameters *iData, *jData ;
+            auto Real            f, g, *gP = NULL, R, xI, xIJ, yI, yIJ, zI, zIJ ;
+            if ( doGradients ) gP = &g ;
+            threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, threadBuffers, &view ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
             {
-                jData = parameters->entries[j] ;
-                xIJ   = Coordinates3_Item ( coordinates3, j, 0 ) - xI ;
-                yIJ   = Coordinates3_Item ( coordinates3, j, 1 ) - yI ;
-                zIJ   = Coordinates3_Item ( coordinates3, j, 2 ) - zI ;
-                R     = sqrt ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
-                CoreCoreInteractions ( iData, jData, R, &f, gP ) ;
-                energy += f ;
-                if ( doGradients )
+                iData = parameters->entries[i] ;
+                xI    = Coordinates3_Item ( coordinates3, i, 0 ) ;
+                yI    = Coordinates3_Item ( coordinates3, i, 1 ) ;
+                zI    = Coordinates3_Item ( coordinates3, i, 2 ) ;
+                for ( j = 0 ; j < i ; j++ )
                 {
-                    g   /= ( - R ) ;
-                    xIJ *= g ; yIJ *= g ; zIJ *= g ;
-                    Coordinates3_IncrementRow ( gradients3, i, xIJ, yIJ, zIJ ) ;
-                    Coordinates3_DecrementRow ( gradients3, j, xIJ, yIJ, zIJ ) ;
+                    jData = parameters->entries[j] ;
+                    xIJ   = Coordinates3_Item ( coordinates3, j, 0 ) - xI ;
+                    yIJ   = Coordinates3_Item ( coordinates3, j, 1 ) - yI ;
+                    zIJ   = Coordinates3_Item ( coordinates3, j, 2 ) - zI ;
+                    R     = sqrt ( xIJ * xIJ + yIJ * yIJ + zIJ * zIJ ) ;
+                    CoreCoreInteractions ( iData, jData, R, &f, gP ) ;
+                    energy += f ;
+                    if ( doGradients )
+                    {
+                        g   /= ( - R ) ;
+                        xIJ *= g ; yIJ *= g ; zIJ *= g ;
+                        Coordinates3_IncrementRow ( threadGradients3, i, xIJ, yIJ, zIJ ) ;
+                        Coordinates3_DecrementRow ( threadGradients3, j, xIJ, yIJ, zIJ ) ;
+                    }
                 }
             }
         }
+        Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &threadBuffers ) ;
     }
     return energy ;
 }
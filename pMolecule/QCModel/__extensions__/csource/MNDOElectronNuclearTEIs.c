@@ -5,12 +5,19 @@
 # include <math.h>
 # include <stdio.h>
 
-# include "Integer.h"
+# include "IntegerUtilities.h"
+# include "MNDODefinitions.h"
 # include "MNDOElectronNuclearTEIs.h"
 # include "MNDOIntegrals.h"
+# include "MNDOIntegralTable.h"
 # include "MNDOParameters.h"
 # include "Real.h"
 # include "RealArray1D.h"
+# include "RealUtilities.h"
+
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Definitions.
@@ -60,35 +67,47 @@ void MNDO_ElectronNuclearTEIGradients ( const MNDOParametersContainer *parameter
          ( dTotal       != NULL ) &&
          ( gradients3   != NULL ) )
     {
-        auto Integer         i, i0, j, j0, nI, nJ ;
-        auto MNDOParameters *iData , *jData  ;
-        auto Real            gX, gY, gZ, *xI, *xJ ;
-        auto RealArray1D    *dOneI, *dOneJ ;
-        auto RealArray2D    *dTwoIJ ;
-        for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
+        auto Integer  numberOfThreads ;
+        auto Real    *threadBuffers ;
+        MNDOIntegralTable_Build ( parameters->integralTable, NULL ) ;
+        threadBuffers = Coordinates3_AllocateThreadBuffers ( gradients3, &numberOfThreads ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads )
+# endif
         {
-            iData = parameters->entries[i] ;
-            i0    = Array1D_Item ( basisIndices, i ) ;
-            nI    = ( iData->norbitals * ( iData->norbitals + 1 ) ) / 2 ;
-            xI    = Coordinates3_RowPointer ( coordinates3, i ) ;
-            dOneI = RealArray1D_AllocateWithExtent ( nI, NULL ) ; RealArray1D_Set ( dOneI, 0.0e+00 ) ;
-            for ( j = 0 ; j < i ; j++ )
+            auto Coordinates3    view, *threadGradients3 ;
+            auto Integer         i, i0, j, j0, nI, nJ ;
+            auto MNDOParameters *iData , *jData  ;
+            auto Real            dOneIData[NCHARGEDISTRIBUTIONS], dOneJData[NCHARGEDISTRIBUTIONS], dTwoIJData[N2CTEIS], gX, gY, gZ, *xI, *xJ ;
+            auto RealArray1D     dOneI, dOneJ ;
+            auto RealArray2D     dTwoIJ ;
+            threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, threadBuffers, &view ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
             {
-                jData  = parameters->entries[j] ;
-                j0     = Array1D_Item ( basisIndices, j ) ;
-                nJ     = ( jData->norbitals * ( jData->norbitals + 1 ) ) / 2 ;
-                xJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
-                dOneJ  = RealArray1D_AllocateWithExtent  ( nJ    , NULL ) ; RealArray1D_Set ( dOneJ , 0.0e+00 ) ;
-                dTwoIJ = RealArray2D_AllocateWithExtents ( nI, nJ, NULL ) ; RealArray2D_Set ( dTwoIJ, 0.0e+00 ) ;
-                GetGradientDensityTerms ( iData, i0, jData, j0, dTotal, dSpin, dOneI, dOneJ, dTwoIJ ) ;
-                MNDOIntegrals_MolecularFrame2CIntegralsD ( iData, i0, xI, jData, j0, xJ, dOneI, dOneJ, dTwoIJ, &gX, &gY, &gZ ) ;
-                RealArray1D_Deallocate ( &dOneJ  ) ;
-                RealArray2D_Deallocate ( &dTwoIJ ) ;
-                Coordinates3_IncrementRow ( gradients3, i, gX, gY, gZ ) ;
-                Coordinates3_DecrementRow ( gradients3, j, gX, gY, gZ ) ;
+                iData = parameters->entries[i] ;
+                i0    = Array1D_Item ( basisIndices, i ) ;
+                nI    = ( iData->norbitals * ( iData->norbitals + 1 ) ) / 2 ;
+                xI    = Coordinates3_RowPointer ( coordinates3, i ) ;
+                RealArray1D_ViewOfRaw ( &dOneI, 0, nI, 1, dOneIData ) ;
+                for ( j = 0 ; j < i ; j++ )
+                {
+                    jData  = parameters->entries[j] ;
+                    j0     = Array1D_Item ( basisIndices, j ) ;
+                    nJ     = ( jData->norbitals * ( jData->norbitals + 1 ) ) / 2 ;
+                    xJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
+                    RealArray1D_ViewOfRaw ( &dOneJ , 0, nJ    , 1    , dOneJData  ) ;
+                    RealArray2D_ViewOfRaw ( &dTwoIJ, 0, nI, nJ, nJ, 1, dTwoIJData ) ;
+                    GetGradientDensityTerms ( iData, i0, jData, j0, dTotal, dSpin, &dOneI, &dOneJ, &dTwoIJ ) ;
+                    MNDOIntegrals_MolecularFrame2CIntegralsD ( parameters->integralTable, iData, i0, xI, jData, j0, xJ, &dOneI, &dOneJ, &dTwoIJ, &gX, &gY, &gZ ) ;
+                    Coordinates3_IncrementRow ( threadGradients3, i, gX, gY, gZ ) ;
+                    Coordinates3_DecrementRow ( threadGradients3, j, gX, gY, gZ ) ;
+                }
             }
-            RealArray1D_Deallocate ( &dOneI ) ;
         }
+        Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &threadBuffers ) ;
     }
 }
 
@@ -122,36 +141,45 @@ void MNDO_ElectronNuclearTEIGradientsCI ( const Integer                  nActive
          ( zMatrix      != NULL ) &&
          ( gradients3   != NULL ) )
     {
-        auto Integer      extents[3] ;
-        auto RealArray1D *tPDM1 ;
-        auto RealArray2D *tPDM2 ;
-        auto RealArrayND *tPDM3 ;
-        extents[0] = nActive ; extents[1] = nActive ; extents[2] = nActive ;
-        tPDM1 = RealArray1D_AllocateWithExtent          ( nActive  ,          NULL ) ;
-        tPDM2 = RealArray2D_AllocateWithExtents          ( nOrbitals, nActive, NULL ) ;
-        tPDM3 = RealArrayND_AllocateWithShape ( 3        , extents, NULL ) ;
-        if ( ( tPDM1 != NULL ) && ( tPDM2 != NULL ) && ( tPDM3 != NULL ) )
+        auto Integer  numberOfThreads ;
+        auto Real    *threadBuffers ;
+        MNDOIntegralTable_Build ( parameters->integralTable, NULL ) ;
+        threadBuffers = Coordinates3_AllocateThreadBuffers ( gradients3, &numberOfThreads ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads )
+# endif
         {
-            auto Integer         i, i0, j, j0, nI, nJ ;
+            auto Coordinates3    view, *threadGradients3 ;
+            auto Integer         extents[3], i, i0, j, j0, nI, nJ ;
             auto MNDOParameters *iData , *jData  ;
-            auto Real            gX, gY, gZ, *xI, *xJ ;
-            auto RealArray1D    *dOneI, *dOneJ ;
-            auto RealArray2D    *dTwoIJ ;
+            auto Real            dOneIData[NCHARGEDISTRIBUTIONS], dOneJData[NCHARGEDISTRIBUTIONS], dTwoIJData[N2CTEIS], gX, gY, gZ, *xI, *xJ ;
+            auto RealArray1D     dOneI, dOneJ, *tPDM1 ;
+            auto RealArray2D     dTwoIJ, *tPDM2 ;
+            auto RealArrayND    *tPDM3 ;
+            extents[0] = nActive ; extents[1] = nActive ; extents[2] = nActive ;
+            tPDM1 = RealArray1D_AllocateWithExtent  ( nActive  ,          NULL ) ;
+            tPDM2 = RealArray2D_AllocateWithExtents ( nOrbitals, nActive, NULL ) ;
+            tPDM3 = RealArrayND_AllocateWithShape   ( 3        , extents, NULL ) ;
+            threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, threadBuffers, &view ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
             for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
             {
+                if ( ( tPDM1 == NULL ) || ( tPDM2 == NULL ) || ( tPDM3 == NULL ) ) continue ;
                 iData = parameters->entries[i] ;
                 i0    = Array1D_Item ( basisIndices, i ) ;
                 nI    = ( iData->norbitals * ( iData->norbitals + 1 ) ) / 2 ;
                 xI    = Coordinates3_RowPointer ( coordinates3, i ) ;
-                dOneI = RealArray1D_AllocateWithExtent ( nI, NULL ) ; RealArray1D_Set ( dOneI, 0.0e+00 ) ;
+                RealArray1D_ViewOfRaw ( &dOneI, 0, nI, 1, dOneIData ) ;
                 for ( j = 0 ; j < i ; j++ )
                 {
                     jData  = parameters->entries[j] ;
                     j0     = Array1D_Item ( basisIndices, j ) ;
                     nJ     = ( jData->norbitals * ( jData->norbitals + 1 ) ) / 2 ;
                     xJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
-                    dOneJ  = RealArray1D_AllocateWithExtent ( nJ    , NULL ) ; RealArray1D_Set ( dOneJ , 0.0e+00 ) ;
-                    dTwoIJ = RealArray2D_AllocateWithExtents ( nI, nJ, NULL ) ; RealArray2D_Set ( dTwoIJ, 0.0e+00 ) ;
+                    RealArray1D_ViewOfRaw ( &dOneJ , 0, nJ    , 1    , dOneJData  ) ;
+                    RealArray2D_ViewOfRaw ( &dTwoIJ, 0, nI, nJ, nJ, 1, dTwoIJData ) ;
                     GetGradientDensityTermsCI ( nActive  ,
                                                 nCore    ,
                                                 iData    ,
@@ -168,21 +196,19 @@ void MNDO_ElectronNuclearTEIGradientsCI ( const Integer                  nActive
                                                 tPDM1    ,
                                                 tPDM2    ,
                                                 tPDM3    ,
-                                                dOneI    ,
-                                                dOneJ    ,
-                                                dTwoIJ   ) ;
-                    MNDOIntegrals_MolecularFrame2CIntegralsD ( iData, i0, xI, jData, j0, xJ, dOneI, dOneJ, dTwoIJ, &gX, &gY, &gZ ) ;
-                    RealArray1D_Deallocate ( &dOneJ  ) ;
-                    RealArray2D_Deallocate ( &dTwoIJ ) ;
-                    Coordinates3_IncrementRow ( gradients3, i, gX, gY, gZ ) ;
-                    Coordinates3_DecrementRow ( gradients3, j, gX, gY, gZ ) ;
+                                                &dOneI   ,
+                                                &dOneJ   ,
+                                                &dTwoIJ  ) ;
+                    MNDOIntegrals_MolecularFrame2CIntegralsD ( parameters->integralTable, iData, i0, xI, jData, j0, xJ, &dOneI, &dOneJ, &dTwoIJ, &gX, &gY, &gZ ) ;
+                    Coordinates3_IncrementRow ( threadGradients3, i, gX, gY, gZ ) ;
+                    Coordinates3_DecrementRow ( threadGradients3, j, gX, gY, gZ ) ;
                 }
-                RealArray1D_Deallocate ( &dOneI ) ;
             }
+            RealArray1D_Deallocate ( &tPDM1 ) ;
+            RealArray2D_Deallocate ( &tPDM2 ) ;
+            RealArrayND_Deallocate ( &tPDM3 ) ;
         }
-        RealArray1D_Deallocate ( &tPDM1 ) ;
-        RealArray2D_Deallocate ( &tPDM2 ) ;
-        RealArrayND_Deallocate ( &tPDM3 ) ;
+        Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &threadBuffers ) ;
     }
 }
 
@@ -191,6 +217,20 @@ void MNDO_ElectronNuclearTEIGradientsCI ( const Integer                  nActive
 !---------------------------------------------------------------------------------------------------------------------------------*/
 # define MNDO_BLOCKSIZE 1024
 # define MNDO_UNDERFLOW 1.0e-12
+static BlockStorage *MNDO_AllocateTEIStorage ( void )
+{
+    BlockStorage *teis = BlockStorage_Allocate ( NULL ) ;
+    if ( teis != NULL )
+    {
+        teis->blockSize      = MNDO_BLOCKSIZE ;
+        teis->checkUnderFlow = True ;
+        teis->nIndices16     = 4 ;
+        teis->nReal          = 1 ;
+        teis->underFlow      = MNDO_UNDERFLOW ;
+    }
+    return teis ;
+}
+
 void MNDO_ElectronNuclearTEIIntegrals ( const MNDOParametersContainer *parameters           ,
                                         const IntegerArray1D          *basisIndices         ,
                                         const Coordinates3            *coordinates3         ,
@@ -202,45 +242,113 @@ void MNDO_ElectronNuclearTEIIntegrals ( const MNDOParametersContainer *parameter
          ( coordinates3      != NULL ) &&
          ( oneElectronMatrix != NULL ) )
     {
-        auto BlockStorage   *teis = NULL ;
-        auto Integer         i, i0, j, j0, nI, nJ, u, v, w ;
-        auto MNDOParameters *iData , *jData  ;
-        auto Real           *xI, *xJ ;
-        auto RealArray1D    *e1b, *e2a ;
-        teis = BlockStorage_Allocate ( NULL ) ;
-        teis->blockSize      = MNDO_BLOCKSIZE ;
-        teis->checkUnderFlow = True ;
-        teis->nIndices16     = 4 ;
-        teis->nReal          = 1 ;
-        teis->underFlow      = MNDO_UNDERFLOW ;
-        for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
+        auto Boolean       isOK ;
+        auto BlockStorage *teis = NULL ;
+        auto Integer       nAtoms, nBlocks = 0, numberOfThreads, *offsets = NULL ;
+        auto Real         *blocks = NULL ;
+        auto Status        status = Status_OK ;
+        MNDOIntegralTable_Build ( parameters->integralTable, NULL ) ;
+        /* . The one-center blocks of the one-electron matrix are accumulated separately by each thread. */
+        nAtoms = Coordinates3_Rows ( coordinates3 ) ;
+        Coordinates3_AllocateThreadBuffers ( NULL, &numberOfThreads ) ;
+        if ( nAtoms > 0 )
         {
-            iData = parameters->entries[i] ;
-            i0    = Array1D_Item ( basisIndices, i ) ;
-            nI    = iData->norbitals ;
-            xI    = Coordinates3_RowPointer ( coordinates3, i ) ;
-            MNDOIntegrals_AddInOneCenterTEIs ( iData, i0, teis ) ;
-            for ( j = 0 ; j < i ; j++ )
+            offsets = Integer_Allocate ( nAtoms, &status ) ;
+            if ( offsets != NULL )
+            {
+                auto Integer i, nI ;
+                for ( i = 0 ; i < nAtoms ; i++ )
+                {
+                    nI          = parameters->entries[i]->norbitals ;
+                    offsets[i]  = nBlocks ;
+                    nBlocks    += ( nI * ( nI + 1 ) ) / 2 ;
+                }
+                blocks = Real_Allocate ( numberOfThreads * nBlocks, &status ) ;
+            }
+        }
+        teis = MNDO_AllocateTEIStorage ( ) ;
+        isOK = ( teis != NULL ) && Status_IsOK ( &status ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads ) if ( isOK )
+# endif
+        {
+            auto BlockStorage   *threadTEIs = teis ;
+            auto Integer         i, i0, iOffset, j, j0, jOffset, nI, nJ, w ;
+            auto MNDOParameters *iData , *jData  ;
+            auto Real            e1bData[NCHARGEDISTRIBUTIONS], e2aData[NCHARGEDISTRIBUTIONS], *threadBlocks = blocks, *xI, *xJ ;
+            auto RealArray1D     e1b, e2a ;
+# ifdef USEOPENMP
+            if ( omp_get_num_threads ( ) > 1 )
+            {
+                threadTEIs = MNDO_AllocateTEIStorage ( ) ;
+                if ( threadTEIs == NULL )
+                {
+                    #pragma omp atomic write
+                    isOK = False ;
+                }
+            }
+            /* . All threads skip the work if any of them could not allocate its storage. */
+            #pragma omp barrier
+# endif
+            if ( isOK )
             {
-                jData = parameters->entries[j] ;
-                j0    = Array1D_Item ( basisIndices, j ) ;
-                nJ    = jData->norbitals ;
-                xJ    = Coordinates3_RowPointer ( coordinates3, j ) ;
-                e1b   = RealArray1D_AllocateWithExtent ( ( nI * ( nI + 1 ) ) / 2, NULL ) ;
-                e2a   = RealArray1D_AllocateWithExtent ( ( nJ * ( nJ + 1 ) ) / 2, NULL ) ;
-                MNDOIntegrals_MolecularFrame2CIntegrals ( iData, i0, xI, jData, j0, xJ, e1b, e2a, teis ) ;
-                for ( u = i0, w = 0 ; u < ( i0+nI ) ; u++ )
+# ifdef USEOPENMP
+                threadBlocks = &(blocks[omp_get_thread_num ( ) * nBlocks]) ;
+                #pragma omp for schedule ( dynamic )
+# endif
+                for ( i = 0 ; i < nAtoms ; i++ )
                 {
-                    for ( v = i0 ; v <= u ; v++, w++ ) SymmetricMatrix_Item ( oneElectronMatrix, u, v ) += e1b->data[w] ;
+                    iData   = parameters->entries[i] ;
+                    i0      = Array1D_Item ( basisIndices, i ) ;
+                    iOffset = offsets[i] ;
+                    nI      = ( iData->norbitals * ( iData->norbitals + 1 ) ) / 2 ;
+                    xI      = Coordinates3_RowPointer ( coordinates3, i ) ;
+                    RealArray1D_ViewOfRaw ( &e1b, 0, nI, 1, e1bData ) ;
+                    MNDOIntegrals_AddInOneCenterTEIs ( iData, i0, threadTEIs ) ;
+                    for ( j = 0 ; j < i ; j++ )
+                    {
+                        jData   = parameters->entries[j] ;
+                        j0      = Array1D_Item ( basisIndices, j ) ;
+                        jOffset = offsets[j] ;
+                        nJ      = ( jData->norbitals * ( jData->norbitals + 1 ) ) / 2 ;
+                        xJ      = Coordinates3_RowPointer ( coordinates3, j ) ;
+                        RealArray1D_ViewOfRaw ( &e2a, 0, nJ, 1, e2aData ) ;
+                        MNDOIntegrals_MolecularFrame2CIntegrals ( parameters->integralTable, iData, i0, xI, jData, j0, xJ, &e1b, &e2a, threadTEIs ) ;
+                        for ( w = 0 ; w < nI ; w++ ) threadBlocks[iOffset+w] += e1bData[w] ;
+                        for ( w = 0 ; w < nJ ; w++ ) threadBlocks[jOffset+w] += e2aData[w] ;
+                    }
                 }
-                for ( u = j0, w = 0 ; u < ( j0+nJ ) ; u++ )
+                if ( threadTEIs != teis )
                 {
-                    for ( v = j0 ; v <= u ; v++, w++ ) SymmetricMatrix_Item ( oneElectronMatrix, u, v ) += e2a->data[w] ;
+# ifdef USEOPENMP
+                    #pragma omp critical ( MNDOElectronNuclearTEIMerge )
+# endif
+                    BlockStorage_Merge ( teis, threadTEIs, NULL ) ;
+                }
+            }
+            if ( threadTEIs != teis ) BlockStorage_Deallocate ( &threadTEIs ) ;
+        }
+        /* . Reduce the one-center blocks. */
+        if ( isOK )
+        {
+            auto Integer i, i0, n, nI, t, u, v, w ;
+            for ( i = 0 ; i < nAtoms ; i++ )
+            {
+                i0 = Array1D_Item ( basisIndices, i ) ;
+                nI = parameters->entries[i]->norbitals ;
+                for ( t = 0 ; t < numberOfThreads ; t++ )
+                {
+                    n = t * nBlocks + offsets[i] ;
+                    for ( u = i0, w = 0 ; u < ( i0+nI ) ; u++ )
+                    {
+                        for ( v = i0 ; v <= u ; v++, w++ ) SymmetricMatrix_Item ( oneElectronMatrix, u, v ) += blocks[n+w] ;
+                    }
                 }
-                RealArray1D_Deallocate ( &e1b ) ;
-                RealArray1D_Deallocate ( &e2a ) ;
             }
         }
+        else BlockStorage_Deallocate ( &teis ) ;
+        Integer_Deallocate ( &offsets ) ;
+        Real_Deallocate    ( &blocks  ) ;
         (*twoElectronIntegrals) = teis ;
     }
 }
@@ -0,0 +1,299 @@
+/*==================================================================================================================================
+! . Tabulated MNDO local-frame two-center integrals.
+! . The local-frame integrals of a pair of atoms depend only on their separation so they can be splined as a function of distance
+!   for each pair of parameter sets. Distances outside the tabulated range are handled analytically.
+!=================================================================================================================================*/
+
+# include <math.h>
+
+# include "MNDODefinitions.h"
+# include "MNDOIntegralTable.h"
+# include "MNDOIntegralUtilities.h"
+# include "Memory.h"
+# include "NumericalMacros.h"
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local procedures.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void                   MNDOIntegralTablePair_Deallocate (       MNDOIntegralTablePair **self       ) ;
+static MNDOIntegralTablePair *MNDOIntegralTablePair_Make       ( const MNDOIntegralTable      *table      ,
+                                                                 const MNDOParameters         *iData      ,
+                                                                 const MNDOParameters         *jData      ,
+                                                                       Status                 *status     ) ;
+
+/* . Access to an item in the concatenated integral arrays. */
+# define ConcatenatedItem( p, nIJ, nI, nJ, lfteis, core1b, core2a ) \
+    ( ( p < nIJ ) ? &Array2D_Item ( lfteis, p / nJ, p % nJ ) : ( ( p < nIJ + nI ) ? &Array1D_Item ( core1b, p - nIJ ) : &Array1D_Item ( core2a, p - nIJ - nI ) ) )
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocation.
+! . The table is empty until it is built.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+MNDOIntegralTable *MNDOIntegralTable_Allocate ( const Integer          capacity   ,
+                                                      MNDOParameters **entries    ,
+                                                const Real             lowerBound ,
+                                                const Real             spacing    ,
+                                                const Real             upperBound ,
+                                                      Status          *status     )
+{
+    MNDOIntegralTable *self = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        auto Integer  numberOfPoints = 0 ;
+        if ( spacing > 0.0e+00 ) numberOfPoints = ( Integer ) floor ( ( upperBound - lowerBound ) / spacing + 1.0e-10 ) + 1 ;
+        if ( ( capacity < 0 ) || ( ( capacity > 0 ) && ( entries == NULL ) ) || ( lowerBound <= 0.0e+00 ) || ( numberOfPoints < 2 ) ) Status_Set ( status, Status_InvalidArgument ) ;
+        else
+        {
+            self = Memory_AllocateType ( MNDOIntegralTable ) ;
+            if ( self != NULL )
+            {
+                self->isBuilt            = False          ;
+                self->numberOfParameters = 0              ;
+                self->numberOfPoints     = numberOfPoints ;
+                self->lowerBound         = lowerBound     ;
+                self->spacing            = spacing        ;
+                self->upperBound         = lowerBound + ( Real ) ( numberOfPoints - 1 ) * spacing ;
+                self->pairs              = NULL           ;
+                self->parameters         = NULL           ;
+                if ( capacity > 0 )
+                {
+                    self->parameters = Memory_AllocateArrayOfReferences ( capacity, MNDOParameters ) ;
+                    if ( self->parameters == NULL ) MNDOIntegralTable_Deallocate ( &self ) ;
+                    else
+                    {
+                        /* . Find the unique parameter sets. */
+                        auto Integer  i, n ;
+                        for ( i = 0 ; i < capacity ; i++ )
+                        {
+                            for ( n = 0 ; n < self->numberOfParameters ; n++ ) { if ( self->parameters[n] == entries[i] ) break ; }
+                            if ( ( n == self->numberOfParameters ) && ( entries[i] != NULL ) ) { self->parameters[n] = entries[i] ; self->numberOfParameters += 1 ; }
+                        }
+                        n = self->numberOfParameters * self->numberOfParameters ;
+                        if ( n > 0 )
+                        {
+                            self->pairs = Memory_AllocateArrayOfReferences ( n, MNDOIntegralTablePair ) ;
+                            if ( self->pairs == NULL ) MNDOIntegralTable_Deallocate ( &self ) ;
+                        }
+                    }
+                }
+            }
+            if ( self == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Build the splines for all pairs of parameter sets.
+! . This is done once only and needs to be called before the table is used inside a parallel region.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void MNDOIntegralTable_Build ( MNDOIntegralTable *self, Status *status )
+{
+    if ( ( self != NULL ) && ( ! self->isBuilt ) && Status_IsOK ( status ) )
+    {
+        auto Boolean isOK = True ;
+        auto Integer n = self->numberOfParameters * self->numberOfParameters ;
+# ifdef USEOPENMP
+        #pragma omp parallel
+# endif
+        {
+            auto Integer p ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( p = 0 ; p < n ; p++ )
+            {
+                if ( self->pairs[p] == NULL )
+                {
+                    auto Status localStatus = Status_OK ;
+                    self->pairs[p] = MNDOIntegralTablePair_Make ( self, self->parameters[p / self->numberOfParameters] ,
+                                                                        self->parameters[p % self->numberOfParameters] , &localStatus ) ;
+                    if ( ! Status_IsOK ( &localStatus ) )
+                    {
+# ifdef USEOPENMP
+                        #pragma omp atomic write
+# endif
+                        isOK = False ;
+                    }
+                }
+            }
+        }
+        /* . Pairs that could not be made are evaluated analytically. */
+        if ( ! isOK ) Status_Set ( status, Status_OutOfMemory ) ;
+        self->isBuilt = True ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void MNDOIntegralTable_Deallocate ( MNDOIntegralTable **self )
+{
+    if ( (*self) != NULL )
+    {
+        if ( (*self)->pairs != NULL )
+        {
+            auto Integer  p ;
+            for ( p = 0 ; p < (*self)->numberOfParameters * (*self)->numberOfParameters ; p++ ) MNDOIntegralTablePair_Deallocate ( &((*self)->pairs[p]) ) ;
+        }
+        Memory_Deallocate ( (*self)->pairs      ) ;
+        Memory_Deallocate ( (*self)->parameters ) ;
+        Memory_Deallocate ( (*self)             ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The local-frame integrals and, optionally, their radial derivatives.
+! . The arguments are as for MNDOIntegralUtilities_LocalFrame2CTEIs to which the calculation reverts if there is no
+!   tabulated data.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void MNDOIntegralTable_LocalFrame2CTEIs ( const MNDOIntegralTable *self    ,
+                                          const MNDOParameters    *iData   ,
+                                          const MNDOParameters    *jData   ,
+                                          const Real               r       ,
+                                                RealArray2D       *lfteis  ,
+                                                RealArray1D       *core1b  ,
+                                                RealArray1D       *core2a  ,
+                                                RealArray2D       *dlfteis ,
+                                                RealArray1D       *dcore1b ,
+                                                RealArray1D       *dcore2a )
+{
+    MNDOIntegralTablePair *pair = NULL ;
+    /* . Find the pair. */
+    if ( ( self != NULL ) && self->isBuilt && ( r >= self->lowerBound ) && ( r <= self->upperBound ) )
+    {
+        auto Integer  a, b ;
+        for ( a = 0 ; a < self->numberOfParameters ; a++ ) { if ( self->parameters[a] == iData ) break ; }
+        for ( b = 0 ; b < self->numberOfParameters ; b++ ) { if ( self->parameters[b] == jData ) break ; }
+        if ( ( a < self->numberOfParameters ) && ( b < self->numberOfParameters ) ) pair = self->pairs[a*self->numberOfParameters+b] ;
+    }
+    /* . Analytic evaluation. */
+    if ( ( pair == NULL ) || ( pair->spline == NULL ) )
+    {
+        MNDOIntegralUtilities_LocalFrame2CTEIs ( iData, jData, r, lfteis, core1b, core2a, dlfteis, dcore1b, dcore2a ) ;
+    }
+    /* . Spline evaluation on a uniform grid. */
+    else
+    {
+        auto Boolean doGradients = ( dlfteis != NULL ) && ( dcore1b != NULL ) && ( dcore2a != NULL ) ;
+        auto Integer l, n, nI = pair->ni, nIJ = pair->ni * pair->nj, nJ = pair->nj, p, u ;
+        auto Real    d = self->spacing, f, g, s, t ;
+        RealArray2D_Set ( lfteis, 0.0e+00 ) ;
+        RealArray1D_Set ( core1b, 0.0e+00 ) ;
+        RealArray1D_Set ( core2a, 0.0e+00 ) ;
+        if ( doGradients )
+        {
+            RealArray2D_Set ( dlfteis, 0.0e+00 ) ;
+            RealArray1D_Set ( dcore1b, 0.0e+00 ) ;
+            RealArray1D_Set ( dcore2a, 0.0e+00 ) ;
+        }
+        l = ( Integer ) floor ( ( r - self->lowerBound ) / d ) ;
+        l = Maximum ( 0, Minimum ( l, self->numberOfPoints - 2 ) ) ;
+        u = l + 1 ;
+        s = ( r - Array1D_Item ( pair->spline->x, l ) ) / d ;
+        t = ( Array1D_Item ( pair->spline->x, u ) - r ) / d ;
+        for ( n = 0 ; n < pair->nSplines ; n++ )
+        {
+            CubicSpline_FastEvaluateFGN ( pair->spline, n, l, u, d, s, t, f, g ) ;
+            p = pair->indices[n] ;
+            (*ConcatenatedItem ( p, nIJ, nI, nJ, lfteis, core1b, core2a )) = f ;
+            if ( doGradients ) (*ConcatenatedItem ( p, nIJ, nI, nJ, dlfteis, dcore1b, dcore2a )) = g ;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Pair deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void MNDOIntegralTablePair_Deallocate ( MNDOIntegralTablePair **self )
+{
+    if ( (*self) != NULL )
+    {
+        CubicSpline_Deallocate ( &((*self)->spline) ) ;
+        Memory_Deallocate ( (*self)->indices ) ;
+        Memory_Deallocate ( (*self)          ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make the splines for a pair of parameter sets.
+! . Integrals that are zero by symmetry are identified by evaluation at sample distances and are not splined. The end conditions
+!   are the analytic radial derivatives.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static MNDOIntegralTablePair *MNDOIntegralTablePair_Make ( const MNDOIntegralTable *table  ,
+                                                           const MNDOParameters    *iData  ,
+                                                           const MNDOParameters    *jData  ,
+                                                                 Status            *status )
+{
+    MNDOIntegralTablePair *self = Memory_AllocateType ( MNDOIntegralTablePair ) ;
+    if ( self != NULL )
+    {
+        auto Integer      k, n, nI, nIJ, nJ, nT, p ;
+        auto Real         core1bData[NCHARGEDISTRIBUTIONS], core2aData[NCHARGEDISTRIBUTIONS], lfteisData[N2CTEIS] ,
+                          dcore1bData[NCHARGEDISTRIBUTIONS], dcore2aData[NCHARGEDISTRIBUTIONS], dlfteisData[N2CTEIS] ,
+                          r, *value ;
+        auto RealArray1D  core1b, core2a, dcore1b, dcore2a ;
+        auto RealArray2D  dlfteis, lfteis ;
+        /* . Initialization. */
+        nI  = ( iData->norbitals * ( iData->norbitals + 1 ) ) / 2 ;
+        nJ  = ( jData->norbitals * ( jData->norbitals + 1 ) ) / 2 ;
+        nIJ = nI * nJ ;
+        nT  = nIJ + nI + nJ ;
+        self->ni       = nI   ;
+        self->nj       = nJ   ;
+        self->nSplines = 0    ;
+        self->indices  = Memory_AllocateArrayOfTypes ( nT, Integer ) ;
+        self->spline   = NULL ;
+        RealArray1D_ViewOfRaw ( &core1b , 0, nI,         1, core1bData  ) ;
+        RealArray1D_ViewOfRaw ( &core2a , 0, nJ,         1, core2aData  ) ;
+        RealArray1D_ViewOfRaw ( &dcore1b, 0, nI,         1, dcore1bData ) ;
+        RealArray1D_ViewOfRaw ( &dcore2a, 0, nJ,         1, dcore2aData ) ;
+        RealArray2D_ViewOfRaw ( &dlfteis, 0, nI, nJ, nJ, 1, dlfteisData ) ;
+        RealArray2D_ViewOfRaw ( &lfteis , 0, nI, nJ, nJ, 1, lfteisData  ) ;
+        if ( self->indices == NULL ) MNDOIntegralTablePair_Deallocate ( &self ) ;
+        else
+        {
+            /* . Find the non-zero integrals by sampling at the ends and the middle of the range. */
+            auto Boolean isNonZero[N2CTEIS+2*NCHARGEDISTRIBUTIONS] ;
+            for ( p = 0 ; p < nT ; p++ ) isNonZero[p] = False ;
+            for ( k = 0 ; k < 3 ; k++ )
+            {
+                r = table->lowerBound + 0.5e+00 * ( Real ) k * ( table->upperBound - table->lowerBound ) ;
+                MNDOIntegralUtilities_LocalFrame2CTEIs ( iData, jData, r, &lfteis, &core1b, &core2a, NULL, NULL, NULL ) ;
+                for ( p = 0 ; p < nT ; p++ ) { if ( (*ConcatenatedItem ( p, nIJ, nI, nJ, &lfteis, &core1b, &core2a )) != 0.0e+00 ) isNonZero[p] = True ; }
+            }
+            for ( p = 0 ; p < nT ; p++ ) { if ( isNonZero[p] ) { self->indices[self->nSplines] = p ; self->nSplines += 1 ; } }
+            /* . Tabulate. */
+            if ( self->nSplines > 0 )
+            {
+                auto Real *lowerDerivatives = NULL, *upperDerivatives = NULL ;
+                self->spline     = CubicSpline_AllocateWithExtents ( table->numberOfPoints, self->nSplines, status ) ;
+                lowerDerivatives = Memory_AllocateArrayOfTypes ( self->nSplines, Real ) ;
+                upperDerivatives = Memory_AllocateArrayOfTypes ( self->nSplines, Real ) ;
+                if ( ( lowerDerivatives == NULL ) || ( upperDerivatives == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
+                if ( Status_IsOK ( status ) )
+                {
+                    for ( k = 0 ; k < table->numberOfPoints ; k++ )
+                    {
+                        r = table->lowerBound + ( Real ) k * table->spacing ;
+                        Array1D_Item ( self->spline->x, k ) = r ;
+                        if ( ( k == 0 ) || ( k == table->numberOfPoints - 1 ) )
+                        {
+                            value = ( k == 0 ) ? lowerDerivatives : upperDerivatives ;
+                            MNDOIntegralUtilities_LocalFrame2CTEIs ( iData, jData, r, &lfteis, &core1b, &core2a, &dlfteis, &dcore1b, &dcore2a ) ;
+                            for ( n = 0 ; n < self->nSplines ; n++ ) value[n] = (*ConcatenatedItem ( self->indices[n], nIJ, nI, nJ, &dlfteis, &dcore1b, &dcore2a )) ;
+                        }
+                        else MNDOIntegralUtilities_LocalFrame2CTEIs ( iData, jData, r, &lfteis, &core1b, &core2a, NULL, NULL, NULL ) ;
+                        for ( n = 0 ; n < self->nSplines ; n++ ) Array2D_Item ( self->spline->y, k, n ) = (*ConcatenatedItem ( self->indices[n], nIJ, nI, nJ, &lfteis, &core1b, &core2a )) ;
+                    }
+                    for ( n = 0 ; n < self->nSplines ; n++ ) CubicSpline_SetUpSpline ( self->spline, n, 1, lowerDerivatives[n], 1, upperDerivatives[n], status ) ;
+                }
+                Memory_Deallocate ( lowerDerivatives ) ;
+                Memory_Deallocate ( upperDerivatives ) ;
+                if ( ! Status_IsOK ( status ) ) MNDOIntegralTablePair_Deallocate ( &self ) ;
+            }
+        }
+    }
+    if ( self == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+    return self ;
+}
@@ -11,6 +11,7 @@
 # include "MNDODefinitions.h"
 # include "MNDOIntegralDefinitions.h"
 # include "MNDOIntegrals.h"
+# include "MNDOIntegralTable.h"
 # include "MNDOIntegralUtilities.h"
 # include "MNDOParameters.h"
 # include "Units.h"
@@ -35,15 +36,16 @@ void MNDOIntegrals_AddInOneCenterTEIs ( const MNDOParameters *self
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Calculate the integrals in the molecular frame.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-void MNDOIntegrals_MolecularFrame2CIntegrals ( const MNDOParameters *iData                ,
-                                               const Integer         i0                   ,
-                                               const Real           *xI                   ,
-                                               const MNDOParameters *jData                ,
-                                               const Integer         j0                   ,
-                                               const Real           *xJ                   ,
-                                                     RealArray1D    *mfcore1b             ,
-                                                     RealArray1D    *mfcore2a             ,
-                                                     BlockStorage   *twoElectronIntegrals )
+void MNDOIntegrals_MolecularFrame2CIntegrals ( const MNDOIntegralTable *table                ,
+                                               const MNDOParameters    *iData                ,
+                                               const Integer            i0                   ,
+                                               const Real              *xI                   ,
+                                               const MNDOParameters    *jData                ,
+                                               const Integer            j0                   ,
+                                               const Real              *xJ                   ,
+                                                     RealArray1D       *mfcore1b             ,
+                                                     RealArray1D       *mfcore2a             ,
+                                                     BlockStorage      *twoElectronIntegrals )
 {
     if ( ( iData != NULL ) && ( jData != NULL ) && ( mfcore1b != NULL ) && ( mfcore2a != NULL ) && ( twoElectronIntegrals != NULL ) )
     {
@@ -64,7 +66,7 @@ void MNDOIntegrals_MolecularFrame2CIntegrals ( const MNDOParameters *iData
         if ( jTransformation == NULL ) lfcore2a = mfcore2a ;
         else                           lfcore2a = RealArray1D_AllocateWithExtent ( nj, NULL ) ;
         /* . Get the integrals in the local frame. */
-        MNDOIntegralUtilities_LocalFrame2CTEIs ( iData, jData, r, lfteis, lfcore1b, lfcore2a, NULL, NULL, NULL ) ;
+        MNDOIntegralTable_LocalFrame2CTEIs ( table, iData, jData, r, lfteis, lfcore1b, lfcore2a, NULL, NULL, NULL ) ;
         /* . Transform from the local to molecular frames. */
         /* . OEIs then TEIs. */
         if ( iTransformation == NULL )
@@ -129,18 +131,19 @@ void MNDOIntegrals_MolecularFrame2CIntegrals ( const MNDOParameters *iData
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Calculate the derivatives in the molecular frame.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-void MNDOIntegrals_MolecularFrame2CIntegralsD ( const MNDOParameters *iData  ,
-                                                const Integer         i0     ,
-                                                const Real           *xI     ,
-                                                const MNDOParameters *jData  ,
-                                                const Integer         j0     ,
-                                                const Real           *xJ     ,
-                                                const RealArray1D    *dOneI  ,
-                                                const RealArray1D    *dOneJ  ,
-                                                const RealArray2D    *dTwoIJ ,
-                                                      Real           *gX     ,
-                                                      Real           *gY     ,
-                                                      Real           *gZ     )
+void MNDOIntegrals_MolecularFrame2CIntegralsD ( const MNDOIntegralTable *table  ,
+                                                const MNDOParameters    *iData  ,
+                                                const Integer            i0     ,
+                                                const Real              *xI     ,
+                                                const MNDOParameters    *jData  ,
+                                                const Integer            j0     ,
+                                                const Real              *xJ     ,
+                                                const RealArray1D       *dOneI  ,
+                                                const RealArray1D       *dOneJ  ,
+                                                const RealArray2D       *dTwoIJ ,
+                                                      Real              *gX     ,
+                                                      Real              *gY     ,
+                                                      Real              *gZ     )
 {
     Boolean      doI, doJ ;
     Integer      i, ix, j, ni, nj ;
@@ -178,7 +181,7 @@ void MNDOIntegrals_MolecularFrame2CIntegralsD ( const MNDOParameters *iData  ,
     iTransformationD[0] = iTransformationX ; iTransformationD[1] = iTransformationY ; iTransformationD[2] = iTransformationZ ;
     jTransformationD[0] = jTransformationX ; jTransformationD[1] = jTransformationY ; jTransformationD[2] = jTransformationZ ;
     /* . Compute the integrals and derivatives in the local frame. */
-    MNDOIntegralUtilities_LocalFrame2CTEIs ( iData, jData, r, lfteis, lfcore1b, lfcore2a, dlfteis, dlfcore1b, dlfcore2a ) ;
+    MNDOIntegralTable_LocalFrame2CTEIs ( table, iData, jData, r, lfteis, lfcore1b, lfcore2a, dlfteis, dlfcore1b, dlfcore2a ) ;
     /* . Set some flags. */
     doI = ( iTransformation != NULL ) ;
     doJ = ( jTransformation != NULL ) ;
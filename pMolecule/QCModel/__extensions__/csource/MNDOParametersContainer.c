@@ -14,9 +14,10 @@ MNDOParametersContainer *MNDOParametersContainer_Allocate ( const Integer  capac
     MNDOParametersContainer *self = Memory_AllocateType ( MNDOParametersContainer ) ;
     if ( self != NULL )
     {
-        self->capacity = capacity ;
-        self->entries  = NULL     ;
-        self->isOwner  = False    ;
+        self->capacity      = capacity ;
+        self->entries       = NULL     ;
+        self->integralTable = NULL     ;
+        self->isOwner       = False    ;
         if ( capacity > 0 )
         {
             self->entries = Memory_AllocateArrayOfReferences ( capacity, MNDOParameters ) ;
@@ -57,6 +58,14 @@ MNDOParametersContainer *MNDOParametersContainer_Clone ( const MNDOParametersCon
             {
                 for ( i = 0 ; i < self->capacity ; i++ ) { clone->entries[i] = self->entries[i] ; }
             }
+            /* . The clone's table is rebuilt when needed as its entries may differ. */
+            if ( ( clone != NULL ) && ( self->integralTable != NULL ) )
+            {
+                MNDOParametersContainer_MakeIntegralTable ( clone, self->integralTable->lowerBound ,
+                                                                   self->integralTable->spacing    ,
+                                                                   self->integralTable->upperBound , status ) ;
+                if ( clone->integralTable == NULL ) MNDOParametersContainer_Deallocate ( &clone ) ;
+            }
         }
         if ( clone == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
     }
@@ -75,6 +84,7 @@ void MNDOParametersContainer_Deallocate ( MNDOParametersContainer **self )
             auto Integer  i ;
             for ( i = 0 ; i < (*self)->capacity ; i++ ) MNDOParameters_Deallocate ( &((*self)->entries[i]) ) ;
         }
+        MNDOIntegralTable_Deallocate ( &((*self)->integralTable) ) ;
         Memory_Deallocate ( (*self)->entries ) ;
         Memory_Deallocate ( (*self)          ) ;
     }
@@ -93,3 +103,20 @@ Integer MNDOParametersContainer_LargestBasis ( const MNDOParametersContainer *se
     }
     return n ;
 }
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Make an integral table.
+! . The table is empty and is only built when first used.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void MNDOParametersContainer_MakeIntegralTable (       MNDOParametersContainer *self       ,
+                                                 const Real                     lowerBound ,
+                                                 const Real                     spacing    ,
+                                                 const Real                     upperBound ,
+                                                       Status                  *status     )
+{
+    if ( self != NULL )
+    {
+        MNDOIntegralTable_Deallocate ( &(self->integralTable) ) ;
+        self->integralTable = MNDOIntegralTable_Allocate ( self->capacity, self->entries, lowerBound, spacing, upperBound, status ) ;
+    }
+}
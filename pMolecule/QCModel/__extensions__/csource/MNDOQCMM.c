@@ -1,21 +1,28 @@
 /*==================================================================================================================================
 ! . MNDO QC/MM integrals and their derivatives.
+! . The MM atoms interacting with a QC atom are processed in batches that are stored as structures of arrays. This permits the
+!   rotation and accumulation of the integrals of s and sp QC atoms to be done with simple loops over the MM atoms in a batch.
 !=================================================================================================================================*/
 
 # include <math.h>
-# include <stdio.h>
 
-# include "Integer.h"
+# include "IntegerUtilities.h"
 # include "Memory.h"
+# include "MNDODefinitions.h"
 # include "MNDOIntegralDefinitions.h"
 # include "MNDOIntegralsMM.h"
 # include "MNDOQCMM.h"
 # include "Real.h"
 # include "Units.h"
 
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Parameters.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+# define _BatchSize           64
 # define _BlockSize           1024
 # define _DefaultCutOff       1.0e+6
 # define _ConversionFactorE   Units_Energy_Hartrees_To_Kilojoules_Per_Mole
@@ -24,6 +31,49 @@
 # define _NumberOfMFOEIs      45      /* . s, sp, spd: 1, 10, 45 = (n*(n+1))/2. */
 # define _UnderFlow           1.0e-12
 
+/* . The Cartesian component of each p-orbital in the molecular frame (PZ, PX, PY). */
+static const Integer _PCartesianComponent[4] = { -1, 2, 0, 1 } ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Batch type.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . Quantities for each MM atom in the batch. The molecular frame integrals and their derivatives are stored integral by
+!   integral, each with _BatchSize items. e is the unit vector from the QC to the MM atom. */
+typedef struct {
+    Integer  count                ;
+    Integer  m       [_BatchSize] ;
+    Real     eX      [_BatchSize] ;
+    Real     eY      [_BatchSize] ;
+    Real     eZ      [_BatchSize] ;
+    Real     gCore   [_BatchSize] ;
+    Real     qM      [_BatchSize] ;
+    Real     r       [_BatchSize] ;
+    Real     rInverse[_BatchSize] ;
+    Real     dPiPi   [_BatchSize] ;
+    Real     dPS     [_BatchSize] ;
+    Real     dPP     [_BatchSize] ;
+    Real     dSS     [_BatchSize] ;
+    Real     lPiPi   [_BatchSize] ;
+    Real     lPS     [_BatchSize] ;
+    Real     lPP     [_BatchSize] ;
+    Real     lSS     [_BatchSize] ;
+    Real    *gMX                  ;
+    Real    *gMY                  ;
+    Real    *gMZ                  ;
+    Real    *iM                   ;
+} MNDOQCMMBatch ;
+
+static MNDOQCMMBatch *MNDOQCMMBatch_Allocate       ( const Integer                  nT          ,
+                                                     const Boolean                  doGradients ) ;
+static void           MNDOQCMMBatch_Deallocate     (       MNDOQCMMBatch          **self        ) ;
+static Real           MNDOQCMMBatch_LocalIntegrals (       MNDOQCMMBatch           *self        ,
+                                                     const MNDOParameters          *qData       ,
+                                                     const CubicSpline             *qSpline     ,
+                                                     const Boolean                  doGradients ) ;
+static void           MNDOQCMMBatch_RotateSP       (       MNDOQCMMBatch           *self        ,
+                                                     const Integer                  nI          ,
+                                                     const Boolean                  doGradients ) ;
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Gradients in normal units.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -41,34 +91,69 @@ void MNDO_QCMMGradients ( const IntegerArray1D  *atomIndices  , /* . The atom to
          ( qcGradients3 != NULL ) &&
          Status_IsOK ( status ) )
     {
-        auto Block      *block ;
-        auto Cardinal16 *indices16 ;
-        auto Cardinal32 *indices32 ;
-        auto Integer     c, c2, c3, m, q, u, v ;
-        auto Real       *data, gX, gY, gZ, p ;
-        List_Iterate_Initialize ( integrals->blocks ) ;
-        while ( ( block = BlockStorage_Iterate ( integrals ) ) != NULL )
+        auto Block   **blocks ;
+        auto Integer   numberOfBlocks, numberOfThreads ;
+        auto Real     *mmBuffers = NULL, *qcBuffers = NULL ;
+        /* . Gather the blocks for random access. */
+        numberOfBlocks = List_Size ( integrals->blocks ) ;
+        blocks         = Memory_AllocateArrayOfReferences ( Maximum ( numberOfBlocks, 1 ), Block ) ;
+        if ( blocks == NULL ) { Status_Set ( status, Status_OutOfMemory ) ; return ; }
+        {
+            auto Block   *block ;
+            auto Integer  b = 0 ;
+            List_Iterate_Initialize ( integrals->blocks ) ;
+            while ( ( block = BlockStorage_Iterate ( integrals ) ) != NULL ) { blocks[b] = block ; b++ ; }
+            numberOfBlocks = b ;
+        }
+        /* . Thread buffers. */
+        mmBuffers = Coordinates3_AllocateThreadBuffers ( mmGradients3, &numberOfThreads ) ;
+        if ( mmBuffers != NULL )
         {
-            data      = block->data      ;
-            indices16 = block->indices16 ;
-            indices32 = block->indices32 ;
-            for ( c = 0 ; c < block->count ; c++ )
+            qcBuffers = Coordinates3_AllocateThreadBuffers ( qcGradients3, NULL ) ;
+            if ( qcBuffers == NULL ) { Memory_Deallocate ( mmBuffers ) ; numberOfThreads = 1 ; }
+        }
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads )
+# endif
+        {
+            auto Block        *block ;
+            auto Cardinal16   *indices16 ;
+            auto Cardinal32   *indices32 ;
+            auto Coordinates3  mmView, qcView, *threadMMGradients3, *threadQCGradients3 ;
+            auto Integer       c, c2, c3, i, m, q, u, v ;
+            auto Real         *data, gX, gY, gZ, p ;
+            threadMMGradients3 = Coordinates3_ThreadBuffer ( mmGradients3, mmBuffers, &mmView ) ;
+            threadQCGradients3 = Coordinates3_ThreadBuffer ( qcGradients3, qcBuffers, &qcView ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( i = 0 ; i < numberOfBlocks ; i++ )
             {
-                c2 = 2 * c ;
-                c3 = 3 * c ;
-                u  = indices16[c2  ] ;
-                v  = indices16[c2+1] ;
-                p  = SymmetricMatrix_Item ( dTotal, u, v ) ;
-                if ( u != v ) p *= 2.0e+00 ; /* . Scale off-diagonal values. */
-                gX = p * data [c3  ] ;
-                gY = p * data [c3+1] ;
-                gZ = p * data [c3+2] ;
-                m  = indices32[c   ] ;
-                q  = Array1D_Item ( atomIndices, u ) ;
-                Coordinates3_IncrementRow ( qcGradients3, q, gX, gY, gZ ) ; /* . Positive as g terms already have -1 factor. */
-                Coordinates3_DecrementRow ( mmGradients3, m, gX, gY, gZ ) ;
+                block     = blocks[i]        ;
+                data      = block->data      ;
+                indices16 = block->indices16 ;
+                indices32 = block->indices32 ;
+                for ( c = 0 ; c < block->count ; c++ )
+                {
+                    c2 = 2 * c ;
+                    c3 = 3 * c ;
+                    u  = indices16[c2  ] ;
+                    v  = indices16[c2+1] ;
+                    p  = SymmetricMatrix_Item ( dTotal, u, v ) ;
+                    if ( u != v ) p *= 2.0e+00 ; /* . Scale off-diagonal values. */
+                    gX = p * data [c3  ] ;
+                    gY = p * data [c3+1] ;
+                    gZ = p * data [c3+2] ;
+                    m  = indices32[c   ] ;
+                    q  = Array1D_Item ( atomIndices, u ) ;
+                    Coordinates3_IncrementRow ( threadQCGradients3, q, gX, gY, gZ ) ; /* . Positive as g terms already have -1 factor. */
+                    Coordinates3_DecrementRow ( threadMMGradients3, m, gX, gY, gZ ) ;
+                }
             }
         }
+        Coordinates3_ReduceThreadBuffers ( mmGradients3, numberOfThreads, &mmBuffers ) ;
+        Coordinates3_ReduceThreadBuffers ( qcGradients3, numberOfThreads, &qcBuffers ) ;
+        Memory_Deallocate ( blocks ) ;
     }
 }
 
@@ -76,6 +161,21 @@ void MNDO_QCMMGradients ( const IntegerArray1D  *atomIndices  , /* . The atom to
 ! . Integrals, derivative integrals, core energy and gradients.
 ! . Integrals in atomic units, all other quantities in normal units.
 !---------------------------------------------------------------------------------------------------------------------------------*/
+static BlockStorage *MNDO_AllocateQCMMStorage ( void )
+{
+    BlockStorage *dOEIs = BlockStorage_Allocate ( NULL ) ;
+    if ( dOEIs != NULL )
+    {
+        dOEIs->blockSize      = _BlockSize ;
+        dOEIs->checkUnderFlow = True ;
+        dOEIs->nIndices16     = 2 ;
+        dOEIs->nIndices32     = 1 ;
+        dOEIs->nReal          = 3 ;
+        dOEIs->underFlow      = _UnderFlow ;
+    }
+    return dOEIs ;
+}
+
 Real MNDO_QCMMIntegrals ( const MNDOParametersContainer *parameters          ,
                           const IntegerArray1D          *basisIndices        ,
                           const CubicSplineContainer    *splines             ,
@@ -102,185 +202,402 @@ Real MNDO_QCMMIntegrals ( const MNDOParametersContainer *parameters          ,
          ( oneElectronMatrix != NULL    ) &&
          Status_IsOK ( status ) )
     {
-        auto BlockStorage     *dOEIs     = NULL ;
-        auto Boolean           doGradients, useSplines ;
-        auto Cardinal16       *indices16 = NULL ;
-        auto Cardinal32       *indices32 = NULL ;
-        auto CubicSpline      *qSpline ;
-        auto Integer           c, c2, c3, i0, m, n, nI, nT, q, u, v, w ;
-        auto MNDOParameters   *qData ;
-        auto PairListIterator  iterator ;
-        auto PairRecord       *record ;
-        auto Real              cutOffSquared, eNuc, gNuc, gX, gXt = 0.0e+00, gY, gYt = 0.0e+00, gZ, gZt = 0.0e+00,
-                               qM, r, r2, scale, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
-        auto Real             *dIntegrals = NULL ;
-        auto RealArray1D      *gLocal = NULL , *gMolecularX = NULL , *gMolecularY = NULL , *gMolecularZ = NULL ,
-                              *iLocal = NULL , *iMolecular  = NULL , *iTotal      = NULL ;
+        auto BlockStorage *dOEIs = NULL ;
+        auto Boolean       doGradients, isOK = True, useSplines ;
+        auto Integer       maximumRecordSize, nTMaximum, numberOfRecords, numberOfThreads, *work ;
+        auto Real          cutOffSquared, *mmBuffers = NULL ;
         /* . Options */
         if ( cutOff > 0.0e+00 ) cutOffSquared = pow (         cutOff, 2 ) ;
         else                    cutOffSquared = pow ( _DefaultCutOff, 2 ) ;
         doGradients = ( ( derivativeIntegrals != NULL ) && ( mmGradients3 != NULL ) && ( qcGradients3 != NULL ) ) ;
         useSplines  = ( splines != NULL ) ;
         /* . Initialization. */
+        maximumRecordSize = PairList_MaximumRecordSize ( pairList ) ;
+        numberOfRecords   = PairList_NumberOfRecords   ( pairList ) ;
+        nTMaximum         = MNDOParametersContainer_LargestBasis ( parameters ) ;
+        nTMaximum         = ( nTMaximum * ( nTMaximum + 1 ) ) / 2 ;
         if ( derivativeIntegrals != NULL ) (*derivativeIntegrals) = NULL ;
         if ( doGradients )
         {
-            /* . Allocation. */
-            nI         = MNDOParametersContainer_LargestBasis ( parameters ) ;
-            nT         = ( nI * ( nI + 1 ) ) / 2 ;
-            n          = PairList_MaximumRecordSize  ( pairList ) * nT ;
-            dOEIs      = BlockStorage_Allocate       ( NULL ) ;
-            dIntegrals = Memory_AllocateArrayOfTypes ( 3 * n, Real       ) ;
-            indices16  = Memory_AllocateArrayOfTypes ( 2 * n, Cardinal16 ) ;
-            indices32  = Memory_AllocateArrayOfTypes (     n, Cardinal32 ) ;
-            if ( ( dOEIs      == NULL ) ||
-                 ( dIntegrals == NULL ) ||
-                 ( indices16  == NULL ) ||
-                 ( indices32  == NULL ) ) { Status_Set ( status, Status_OutOfMemory ) ; goto FinishUp ; }
-            /* . Initialization. */
-            dOEIs->blockSize      = _BlockSize ;
-            dOEIs->checkUnderFlow = True ;
-            dOEIs->nIndices16     = 2 ;
-            dOEIs->nIndices32     = 1 ;
-            dOEIs->nReal          = 3 ;
-            dOEIs->underFlow      = _UnderFlow ;
+            dOEIs     = MNDO_AllocateQCMMStorage ( ) ;
+            isOK      = ( dOEIs != NULL ) ;
+            mmBuffers = Coordinates3_AllocateThreadBuffers ( mmGradients3, &numberOfThreads ) ;
         }
+        else Coordinates3_AllocateThreadBuffers ( NULL, &numberOfThreads ) ;
+        work = PairList_AllocateThreadWork ( pairList, &numberOfThreads ) ;
         /* . Loop over QC/MM records. */
-        PairListIterator_Initialize ( &iterator, pairList ) ;
-        while ( ( record = PairListIterator_Next ( &iterator ) ) != NULL )
+        /* . Each thread has its own copy of isOK which is combined with the others at the end of the parallel region. */
+# ifdef USEOPENMP
+        #pragma omp parallel if ( isOK ) num_threads ( numberOfThreads ) reduction ( + : eNuclear ) reduction ( && : isOK )
+# endif
         {
-            q     = record->index ;
-            qData = parameters->entries[q] ;
-            if ( useSplines ) qSpline = splines->entries[q] ;
-            nI    = qData->norbitals ;
-            if ( nI <= 0 ) continue ;
-            i0    = Array1D_Item ( basisIndices, q ) ;
-            nT    = ( nI * ( nI + 1 ) ) / 2 ;
-            Coordinates3_GetRow ( qcCoordinates3, q, xQ, yQ, zQ ) ; /* . In Angstroms. */
+            auto BlockStorage   *threadDOEIs = dOEIs ;
+            auto Cardinal16     *indices16   = NULL  ;
+            auto Cardinal32     *indices32   = NULL  ;
+            auto Coordinates3    mmView, *threadMMGradients3 = NULL ;
+            auto CubicSpline    *qSpline     = NULL  ;
+            auto Integer         b, c, c2, c3, i0, m, n, nI, nT, q, r, u, v, w, *threadWork ;
+            auto MNDOParameters *qData ;
+            auto MNDOQCMMBatch  *batch       = NULL  ;
+            auto PairRecord     *record, view ;
+            auto Real            gX, gXt, gY, gYt, gZ, gZt, iTotal[_NumberOfMFOEIs], scale, sum, xM, xQ, xQM, yM, yQ, yQM, zM, zQ, zQM ;
+            auto Real           *dIntegrals  = NULL  , *iM ;
             /* . Allocation. */
-            iLocal      = RealArray1D_AllocateWithExtent ( nT, status ) ;
-            iMolecular  = RealArray1D_AllocateWithExtent ( nT, status ) ;
-            iTotal      = RealArray1D_AllocateWithExtent ( nT, status ) ;
+            batch      = MNDOQCMMBatch_Allocate ( nTMaximum, doGradients ) ;
+            threadWork = PairList_ThreadWork    ( pairList , work        ) ;
+            if ( batch == NULL ) isOK = False ;
             if ( doGradients )
             {
-                gLocal      = RealArray1D_AllocateWithExtent ( nT, status ) ;
-                gMolecularX = RealArray1D_AllocateWithExtent ( nT, status ) ;
-                gMolecularY = RealArray1D_AllocateWithExtent ( nT, status ) ;
-                gMolecularZ = RealArray1D_AllocateWithExtent ( nT, status ) ;
+                n          = maximumRecordSize * nTMaximum ;
+                dIntegrals = Memory_AllocateArrayOfTypes ( 3 * n, Real       ) ;
+                indices16  = Memory_AllocateArrayOfTypes ( 2 * n, Cardinal16 ) ;
+                indices32  = Memory_AllocateArrayOfTypes (     n, Cardinal32 ) ;
+                if ( ( dIntegrals == NULL ) || ( indices16 == NULL ) || ( indices32 == NULL ) ) isOK = False ;
+                threadMMGradients3 = Coordinates3_ThreadBuffer ( mmGradients3, mmBuffers, &mmView ) ;
+# ifdef USEOPENMP
+                if ( omp_get_num_threads ( ) > 1 )
+                {
+                    threadDOEIs = MNDO_AllocateQCMMStorage ( ) ;
+                    if ( threadDOEIs == NULL ) isOK = False ;
+                }
+# endif
             }
-            if ( ! Status_IsOK ( status ) ) goto Deallocate ;
-            /* . Initialization. */
-            RealArray1D_Set ( iTotal, 0.0e+00 ) ;
-            if ( doGradients ) { gXt = gYt = gZt = 0.0e+00 ; }
-            /* . Loop over interactions. */
-       	    for ( c = n = 0 ; n < record->capacity ; n++ )
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( r = 0 ; r < numberOfRecords ; r++ )
             {
-	        m  = record->indices[n] ;
-                Coordinates3_GetRow ( mmCoordinates3, m, xM, yM, zM ) ; /* . In Angstroms. */
-	        xQM = xQ - xM ;
-                yQM = yQ - yM ;
-                zQM = zQ - zM ;
-                r2  = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
-                if ( r2 < cutOffSquared )
+                if ( ! isOK ) continue ;
+                record = PairList_GetRecordWithWork ( pairList, r, threadWork, &view ) ;
+                q      = record->index ;
+                qData  = parameters->entries[q] ;
+                if ( useSplines ) qSpline = splines->entries[q] ;
+                nI     = qData->norbitals ;
+                if ( nI <= 0 ) continue ;
+                i0     = Array1D_Item ( basisIndices, q ) ;
+                nT     = ( nI * ( nI + 1 ) ) / 2 ;
+                Coordinates3_GetRow ( qcCoordinates3, q, xQ, yQ, zQ ) ; /* . In Angstroms. */
+                /* . Initialization. */
+                for ( w = 0 ; w < nT ; w++ ) iTotal[w] = 0.0e+00 ;
+                gXt = gYt = gZt = 0.0e+00 ;
+                /* . Loop over batches of interactions. */
+                for ( c = n = 0 ; n < record->capacity ; )
                 {
-                    r    = sqrt ( r2 ) * Units_Length_Angstroms_To_Bohrs ;
-                    qM   = eScale * Array1D_Item ( mmCharges, m ) ;
-                    xQM *=               Units_Length_Angstroms_To_Bohrs ;
-                    yQM *=               Units_Length_Angstroms_To_Bohrs ;
-                    zQM *=               Units_Length_Angstroms_To_Bohrs ;
-                    RealArray1D_Set ( iLocal, 0.0e+00 ) ;
-                    RealArray1D_Set ( gLocal, 0.0e+00 ) ;
-                    /* . Core term and local integrals in atomic units. */
-                    if ( useSplines )
+                    /* . Gather the MM atoms within the cutoff. */
+                    for ( batch->count = 0 ; ( batch->count < _BatchSize ) && ( n < record->capacity ) ; n++ )
                     {
-                        MNDOIntegralsMM_FromSpline ( qData, qSpline, qM, r, &eNuc, &gNuc, iLocal, gLocal ) ;
+                        m = record->indices[n] ;
+                        Coordinates3_GetRow ( mmCoordinates3, m, xM, yM, zM ) ; /* . In Angstroms. */
+                        xQM = xQ - xM ;
+                        yQM = yQ - yM ;
+                        zQM = zQ - zM ;
+                        sum = ( xQM * xQM + yQM * yQM + zQM * zQM ) ;
+                        if ( sum < cutOffSquared )
+                        {
+                            b = batch->count ;
+                            batch->m [b] = m ;
+                            batch->qM[b] = eScale * Array1D_Item ( mmCharges, m ) ;
+                            batch->r [b] = sqrt ( sum ) * Units_Length_Angstroms_To_Bohrs ;
+                            if ( batch->r[b] > SMALL_RIJ )
+                            {
+                                sum = 1.0e+00 / sqrt ( sum ) ;
+                                batch->eX      [b] = - xQM * sum ;
+                                batch->eY      [b] = - yQM * sum ;
+                                batch->eZ      [b] = - zQM * sum ;
+                                batch->rInverse[b] = 1.0e+00 / batch->r[b] ;
+                            }
+                            else batch->eX[b] = batch->eY[b] = batch->eZ[b] = batch->rInverse[b] = 0.0e+00 ;
+                            batch->count += 1 ;
+                        }
                     }
-                    else
+                    if ( batch->count == 0 ) continue ;
+                    /* . Core terms and integrals in atomic units. */
+                    eNuclear += MNDOQCMMBatch_LocalIntegrals ( batch, qData, qSpline, doGradients ) ;
+                    if ( nI <= 4 ) MNDOQCMMBatch_RotateSP ( batch, nI, doGradients ) ;
+                    /* . Accumulate the integrals. */
+                    for ( w = 0 ; w < nT ; w++ )
                     {
-                        auto Real eNuc0, eNuc1, gNuc0, gNuc1 ;
-                        MNDOIntegralsMM_CoreCharge ( qData, qM, r, &eNuc0, &eNuc1, &gNuc0, &gNuc1 ) ; eNuc = eNuc0 + eNuc1 ; gNuc = gNuc0 + gNuc1 ;
-                        MNDOIntegralsMM_LocalFrame ( qData,     r, iLocal        , gLocal         ) ;
+                        iM  = &(batch->iM[w*_BatchSize]) ;
+                        sum = 0.0e+00 ;
+                        for ( b = 0 ; b < batch->count ; b++ ) sum += batch->qM[b] * iM[b] ;
+                        iTotal[w] += sum ;
                     }
-                    eNuclear += eNuc ;
-                    MNDOIntegralsMM_MolecularFrame ( nI, r, xQM, yQM, zQM, iLocal, gLocal, iMolecular, gMolecularX, gMolecularY, gMolecularZ ) ; /* . I and -dI/dx (for some reason). */
-                    RealArray1D_Add ( iTotal, qM, iMolecular, NULL ) ;
-/*
-printf ( "Core and Integrals (local, molecule, total) for %d/%d\n", q, m ) ; fflush ( stdout ) ;
-printf ( "Core, distance, charge = %20.5f %10.3f %10.3f\n", eNuc, r, qM ) ; fflush ( stdout ) ;
-RealArray1D_Print ( iLocal     ) ; fflush ( stdout ) ;
-RealArray1D_Print ( iMolecular ) ; fflush ( stdout ) ;
-RealArray1D_Print ( iTotal     ) ; fflush ( stdout ) ;
-*/
                     if ( doGradients )
                     {
-                        /* . Core term. */
-                        scale = _ConversionFactorG ;
-                        gNuc *= ( scale / r ) ;
-                        gX    = gNuc * xQM ; gXt += gX ;
-                        gY    = gNuc * yQM ; gYt += gY ;
-                        gZ    = gNuc * zQM ; gZt += gZ ;
-                        Coordinates3_DecrementRow ( mmGradients3, m, gX, gY, gZ ) ;
-                        /* . Electron term. */
-                        scale *= qM ;
-                        for ( u = i0, w = 0 ; u < ( i0+nI ) ; u++ )
+                        for ( b = 0 ; b < batch->count ; b++ )
                         {
-                            for ( v = i0 ; v <= u ; c++, v++, w++ )
+                            /* . Core term. */
+                            m     = batch->m[b] ;
+                            scale = - _ConversionFactorG * batch->gCore[b] ;
+                            gX    = scale * batch->eX[b] ; gXt += gX ;
+                            gY    = scale * batch->eY[b] ; gYt += gY ;
+                            gZ    = scale * batch->eZ[b] ; gZt += gZ ;
+                            Coordinates3_DecrementRow ( threadMMGradients3, m, gX, gY, gZ ) ;
+                            /* . Electron term. */
+                            scale = _ConversionFactorG * batch->qM[b] ;
+                            for ( u = i0, w = 0 ; u < ( i0+nI ) ; u++ )
                             {
-                                c2 = 2 * c ;
-                                c3 = 3 * c ;
-                                indices16 [c2  ] = u ;
-                                indices16 [c2+1] = v ;
-                                indices32 [c   ] = m ;
-                                dIntegrals[c3  ] = scale * Array1D_Item ( gMolecularX, w ) ;
-                                dIntegrals[c3+1] = scale * Array1D_Item ( gMolecularY, w ) ;
-                                dIntegrals[c3+2] = scale * Array1D_Item ( gMolecularZ, w ) ;
+                                for ( v = i0 ; v <= u ; c++, v++, w++ )
+                                {
+                                    c2 = 2 * c ;
+                                    c3 = 3 * c ;
+                                    indices16 [c2  ] = u ;
+                                    indices16 [c2+1] = v ;
+                                    indices32 [c   ] = m ;
+                                    dIntegrals[c3  ] = scale * batch->gMX[w*_BatchSize+b] ;
+                                    dIntegrals[c3+1] = scale * batch->gMY[w*_BatchSize+b] ;
+                                    dIntegrals[c3+2] = scale * batch->gMZ[w*_BatchSize+b] ;
+                                }
                             }
                         }
                     }
                 }
+                /* . Accumulate the terms for q. */
+                if ( doGradients )
+                {
+                    auto Status localStatus = Status_OK ;
+                    BlockStorage_AddData ( threadDOEIs, c, dIntegrals, indices16, indices32, &localStatus ) ;
+                    if ( ! Status_IsOK ( &localStatus ) ) isOK = False ;
+                }
+# ifdef USEOPENMP
+                #pragma omp critical ( MNDOQCMMRecords )
+# endif
+                {
+                    for ( u = i0, w = 0 ; u < ( i0+nI ) ; u++ )
+                    {
+                        for ( v = i0 ; v <= u ; v++, w++ ) SymmetricMatrix_Item ( oneElectronMatrix, u, v ) -= iTotal[w] ; /* . -ve as electrons. */
+                    }
+                    if ( doGradients ) Coordinates3_IncrementRow ( qcGradients3, q, gXt, gYt, gZt ) ;
+                }
             }
-            /* . Accumulate the terms for q. */
-/*
-printf ( "Final Integrals for %d\n", q ) ; fflush ( stdout ) ;
-RealArray1D_Print ( iTotal ) ; fflush ( stdout ) ;
-printf ( "Counters : %d %d %d %d\n", i0, i0 + nI, nI, nT ) ; fflush ( stdout ) ;
-*/
-            for ( u = i0, w = 0 ; u < ( i0+nI ) ; u++ )
-            {
-                for ( v = i0 ; v <= u ; v++, w++ ) SymmetricMatrix_Item ( oneElectronMatrix, u, v ) -= Array1D_Item ( iTotal, w ) ; /* . -ve as electrons. */
-            }
-            if ( doGradients )
+            /* . Finish up. */
+            if ( ( threadDOEIs != NULL ) && ( threadDOEIs != dOEIs ) )
             {
-                Coordinates3_IncrementRow ( qcGradients3, q, gXt, gYt, gZt ) ;
-                BlockStorage_AddData ( dOEIs, c, dIntegrals, indices16, indices32, status ) ;
-                if ( ! Status_IsOK ( status ) ) goto FinishUp ;
+# ifdef USEOPENMP
+                #pragma omp critical ( MNDOQCMMMerge )
+# endif
+                BlockStorage_Merge ( dOEIs, threadDOEIs, NULL ) ;
+                BlockStorage_Deallocate ( &threadDOEIs ) ;
             }
-            /* . Finish up. */
-        Deallocate:
-            RealArray1D_Deallocate ( &gLocal      ) ;
-            RealArray1D_Deallocate ( &gMolecularX ) ;
-            RealArray1D_Deallocate ( &gMolecularY ) ;
-            RealArray1D_Deallocate ( &gMolecularZ ) ;
-            RealArray1D_Deallocate ( &iLocal      ) ;
-            RealArray1D_Deallocate ( &iMolecular  ) ;
-            RealArray1D_Deallocate ( &iTotal      ) ;
-            if ( ! Status_IsOK ( status ) ) break ;
+            MNDOQCMMBatch_Deallocate ( &batch ) ;
+            Memory_Deallocate ( dIntegrals ) ;
+            Memory_Deallocate ( indices16  ) ;
+            Memory_Deallocate ( indices32  ) ;
         }
         /* . Finish up. */
-    FinishUp:
+        Integer_Deallocate ( &work ) ;
         eNuclear *= _ConversionFactorE ;
         if ( doGradients )
         {
-            if ( Status_IsOK ( status ) ) (*derivativeIntegrals) = dOEIs ;
+            Coordinates3_ReduceThreadBuffers ( mmGradients3, numberOfThreads, &mmBuffers ) ;
+            if ( isOK ) (*derivativeIntegrals) = dOEIs ;
             else BlockStorage_Deallocate ( &dOEIs ) ;
-            Memory_Deallocate ( dIntegrals ) ;
-            Memory_Deallocate ( indices16  ) ;
-            Memory_Deallocate ( indices32  ) ;
+        }
+        if ( ! isOK ) Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return eNuclear ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Batch allocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static MNDOQCMMBatch *MNDOQCMMBatch_Allocate ( const Integer nT, const Boolean doGradients )
+{
+    MNDOQCMMBatch *self = Memory_AllocateType ( MNDOQCMMBatch ) ;
+    if ( self != NULL )
+    {
+        auto Integer n = Maximum ( nT, 1 ) * _BatchSize ;
+        self->count = 0 ;
+        self->gMX   = NULL ;
+        self->gMY   = NULL ;
+        self->gMZ   = NULL ;
+        self->iM    = Memory_AllocateArrayOfTypes ( n, Real ) ;
+        if ( doGradients )
+        {
+            self->gMX = Memory_AllocateArrayOfTypes ( n, Real ) ;
+            self->gMY = Memory_AllocateArrayOfTypes ( n, Real ) ;
+            self->gMZ = Memory_AllocateArrayOfTypes ( n, Real ) ;
+        }
+        if ( ( self->iM == NULL ) || ( doGradients && ( ( self->gMX == NULL ) || ( self->gMY == NULL ) || ( self->gMZ == NULL ) ) ) )
+        {
+            MNDOQCMMBatch_Deallocate ( &self ) ;
+        }
+    }
+    return self ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Batch deallocation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void MNDOQCMMBatch_Deallocate ( MNDOQCMMBatch **self )
+{
+    if ( (*self) != NULL )
+    {
+        Memory_Deallocate ( (*self)->gMX ) ;
+        Memory_Deallocate ( (*self)->gMY ) ;
+        Memory_Deallocate ( (*self)->gMZ ) ;
+        Memory_Deallocate ( (*self)->iM  ) ;
+        Memory_Deallocate ( (*self)      ) ;
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The core terms and local frame integrals for a batch.
+! . The unique local frame integrals of s and sp atoms are saved for rotation whereas those of spd atoms are transformed
+!   directly to the molecular frame. The core energy of the batch in atomic units is returned.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Real MNDOQCMMBatch_LocalIntegrals (       MNDOQCMMBatch  *self        ,
+                                          const MNDOParameters *qData       ,
+                                          const CubicSpline    *qSpline     ,
+                                          const Boolean         doGradients )
+{
+    Integer      b, nI = qData->norbitals, nT ;
+    Real         eNuc, eNuclear = 0.0e+00, gLocalData[_NumberOfMFOEIs], gNuc, iLocalData[_NumberOfMFOEIs] ;
+    RealArray1D  gLocal, gMX, gMY, gMZ, iLocal, iM, *pGLocal = NULL ;
+    nT = ( nI * ( nI + 1 ) ) / 2 ;
+    RealArray1D_ViewOfRaw ( &gLocal, 0, nT, 1, gLocalData ) ;
+    RealArray1D_ViewOfRaw ( &iLocal, 0, nT, 1, iLocalData ) ;
+    if ( doGradients ) pGLocal = &gLocal ;
+    for ( b = 0 ; b < self->count ; b++ )
+    {
+        RealArray1D_Set ( &iLocal, 0.0e+00 ) ;
+        RealArray1D_Set (  pGLocal, 0.0e+00 ) ;
+        if ( qSpline != NULL )
+        {
+            MNDOIntegralsMM_FromSpline ( qData, qSpline, self->qM[b], self->r[b], &eNuc, &gNuc, &iLocal, pGLocal ) ;
+        }
+        else
+        {
+            auto Real eNuc0, eNuc1, gNuc0, gNuc1 ;
+            MNDOIntegralsMM_CoreCharge ( qData, self->qM[b], self->r[b], &eNuc0, &eNuc1, &gNuc0, &gNuc1 ) ; eNuc = eNuc0 + eNuc1 ; gNuc = gNuc0 + gNuc1 ;
+            MNDOIntegralsMM_LocalFrame ( qData, self->r[b], &iLocal, pGLocal ) ;
+        }
+        eNuclear      += eNuc ;
+        self->gCore[b] = gNuc ;
+        if ( nI <= 4 )
+        {
+            self->lSS[b] = iLocalData[SS] ;
+            if ( doGradients ) self->dSS[b] = gLocalData[SS] ;
+            if ( nI == 4 )
+            {
+                self->lPS  [b] = iLocalData[PZS ] ;
+                self->lPP  [b] = iLocalData[PZPZ] ;
+                self->lPiPi[b] = iLocalData[PXPX] ;
+                if ( doGradients )
+                {
+                    self->dPS  [b] = gLocalData[PZS ] ;
+                    self->dPP  [b] = gLocalData[PZPZ] ;
+                    self->dPiPi[b] = gLocalData[PXPX] ;
+                }
+            }
+        }
+        else
+        {
+            /* . The molecular frame arrays are strided views into the batch arrays. */
+            RealArray1D_ViewOfRaw ( &iM, 0, nT, _BatchSize, &(self->iM[b]) ) ;
+            if ( doGradients )
+            {
+                RealArray1D_ViewOfRaw ( &gMX, 0, nT, _BatchSize, &(self->gMX[b]) ) ;
+                RealArray1D_ViewOfRaw ( &gMY, 0, nT, _BatchSize, &(self->gMY[b]) ) ;
+                RealArray1D_ViewOfRaw ( &gMZ, 0, nT, _BatchSize, &(self->gMZ[b]) ) ;
+                MNDOIntegralsMM_MolecularFrame ( nI, self->r[b], - self->r[b] * self->eX[b], - self->r[b] * self->eY[b], - self->r[b] * self->eZ[b],
+                                                                                     &iLocal, &gLocal, &iM, &gMX, &gMY, &gMZ ) ;
+            }
+            else MNDOIntegralsMM_MolecularFrame ( nI, self->r[b], - self->r[b] * self->eX[b], - self->r[b] * self->eY[b], - self->r[b] * self->eZ[b],
+                                                                                     &iLocal, NULL, &iM, NULL, NULL, NULL ) ;
         }
     }
     return eNuclear ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Rotate the local frame integrals of s and sp atoms to the molecular frame.
+! . With e the unit vector along the QC-MM axis, the molecular frame integrals are:
+!     (ss) = SS, (pa s) = ea PZS and (pa pb) = ea eb ( PZPZ - PXPX ) + dab PXPX.
+!   The derivatives are with respect to the MM-QC displacement as in MNDOIntegralsMM_MolecularFrame.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void MNDOQCMMBatch_RotateSP (       MNDOQCMMBatch *self        ,
+                                     const Integer        nI          ,
+                                     const Boolean        doGradients )
+{
+    Integer  b, c, n = self->count, u, v, w ;
+    Real     dUC, dVC, *e[4], *eC, *eU, *eV, *gM[3], *g, *iM = self->iM, t, tU, tV ;
+    Real    *dPiPi = self->dPiPi, *dPS = self->dPS, *dPP = self->dPP, *dSS = self->dSS,
+            *lPiPi = self->lPiPi, *lPS = self->lPS, *lPP = self->lPP, *lSS = self->lSS, *rI = self->rInverse ;
+    Real    *cartesian[3] ;
+    cartesian[0] = self->eX ; cartesian[1] = self->eY ; cartesian[2] = self->eZ ;
+    e[0] = NULL ; e[1] = self->eZ ; e[2] = self->eX ; e[3] = self->eY ;
+    gM[0] = self->gMX ; gM[1] = self->gMY ; gM[2] = self->gMZ ;
+    /* . ss. */
+    for ( b = 0 ; b < n ; b++ ) iM[b] = lSS[b] ;
+    if ( doGradients )
+    {
+        for ( c = 0 ; c < 3 ; c++ )
+        {
+            eC = cartesian[c] ; g = gM[c] ;
+            for ( b = 0 ; b < n ; b++ ) g[b] = dSS[b] * eC[b] ;
+        }
+    }
+    if ( nI == 1 ) return ;
+    /* . Terms involving p-orbitals. */
+    for ( u = 1 ; u < 4 ; u++ )
+    {
+        eU = e[u] ;
+        /* . ps. */
+        w = ( u * ( u + 1 ) ) / 2 ;
+        for ( b = 0 ; b < n ; b++ ) iM[w*_BatchSize+b] = eU[b] * lPS[b] ;
+        if ( doGradients )
+        {
+            for ( c = 0 ; c < 3 ; c++ )
+            {
+                dUC = ( _PCartesianComponent[u] == c ) ? 1.0e+00 : 0.0e+00 ;
+                eC  = cartesian[c] ; g = &(gM[c][w*_BatchSize]) ;
+                for ( b = 0 ; b < n ; b++ )
+                {
+                    t    = eU[b] * eC[b] ;
+                    g[b] = t * dPS[b] + lPS[b] * ( dUC - t ) * rI[b] ;
+                }
+            }
+        }
+        /* . pp. */
+        for ( v = 1 ; v <= u ; v++ )
+        {
+            eV = e[v] ;
+            w  = ( u * ( u + 1 ) ) / 2 + v ;
+            if ( u == v ) { for ( b = 0 ; b < n ; b++ ) iM[w*_BatchSize+b] = eU[b] * eV[b] * ( lPP[b] - lPiPi[b] ) + lPiPi[b] ; }
+            else          { for ( b = 0 ; b < n ; b++ ) iM[w*_BatchSize+b] = eU[b] * eV[b] * ( lPP[b] - lPiPi[b] ) ; }
+            if ( doGradients )
+            {
+                for ( c = 0 ; c < 3 ; c++ )
+                {
+                    dUC = ( _PCartesianComponent[u] == c ) ? 1.0e+00 : 0.0e+00 ;
+                    dVC = ( _PCartesianComponent[v] == c ) ? 1.0e+00 : 0.0e+00 ;
+                    eC  = cartesian[c] ; g = &(gM[c][w*_BatchSize]) ;
+                    if ( u == v )
+                    {
+                        for ( b = 0 ; b < n ; b++ )
+                        {
+                            tU   = ( dUC - eU[b] * eC[b] ) * eV[b] ;
+                            tV   = ( dVC - eV[b] * eC[b] ) * eU[b] ;
+                            g[b] = eC[b] * ( eU[b] * eV[b] * ( dPP[b] - dPiPi[b] ) + dPiPi[b] ) + ( lPP[b] - lPiPi[b] ) * ( tU + tV ) * rI[b] ;
+                        }
+                    }
+                    else
+                    {
+                        for ( b = 0 ; b < n ; b++ )
+                        {
+                            tU   = ( dUC - eU[b] * eC[b] ) * eV[b] ;
+                            tV   = ( dVC - eV[b] * eC[b] ) * eU[b] ;
+                            g[b] = eC[b] * ( eU[b] * eV[b] * ( dPP[b] - dPiPi[b] ) ) + ( lPP[b] - lPiPi[b] ) * ( tU + tV ) * rI[b] ;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+# undef _BatchSize
 # undef _BlockSize
 # undef _ConversionFactorE
 # undef _ConversionFactorG
@@ -14,6 +14,10 @@
 # include "RealArray2D.h"
 # include "RealUtilities.h"
 
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . The resonance gradients.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -29,20 +33,32 @@ void MNDO_ResonanceGradients ( const MNDOParametersContainer *parameters   ,
          ( dTotal       != NULL ) &&
          ( gradients3   != NULL ) )
     {
-        auto Integer n, s2 ;
-        auto Real   *rWork ;
+        auto Integer  n, numberOfThreads, s2 ;
+        auto Real    *threadBuffers ;
         n     = GaussianBasisContainer_LargestShell ( bases, True ) ;
         s2    = n*n ;
-        rWork = Real_Allocate ( 4*s2, NULL ) ;
-        if ( rWork != NULL )
+        threadBuffers = Coordinates3_AllocateThreadBuffers ( gradients3, &numberOfThreads ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads )
+# endif
         {
-            auto Integer         i, i0, j, j0, nI, nJ, u, uv, v ;
+            auto Coordinates3    view, *threadGradients3 ;
+            auto Integer         i, i0, j, j0, m, nI, nJ, u, uv, v ;
             auto GaussianBasis  *iBasis, *jBasis ;
             auto MNDOParameters *iData , *jData  ;
-            auto Real            b, gX, gY, gZ, *xI, *xJ ;
-            auto RealArray2D    *sX, *sY, *sZ ;
+            auto Real            b, gX, gY, gZ, *rWork, *sWork, *xI, *xJ ;
+            auto RealArray2D     sX, sY, sZ ;
+            /* . The integral work space and the largest possible sX, sY and sZ. */
+            m     = GaussianBasisContainer_LargestBasis ( bases, False ) ;
+            rWork = Real_Allocate ( 4*s2, NULL ) ;
+            sWork = Real_Allocate ( 3*m*m, NULL ) ;
+            threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, threadBuffers, &view ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
             for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
             {
+                if ( ( rWork == NULL ) || ( sWork == NULL ) ) continue ;
                 iBasis = bases->entries[i] ;
                 iData  = parameters->entries[i] ;
                 i0     = Array1D_Item ( bases->centerFunctionPointers, i ) ;
@@ -55,35 +71,31 @@ void MNDO_ResonanceGradients ( const MNDOParametersContainer *parameters   ,
                     j0     = Array1D_Item ( bases->centerFunctionPointers, j ) ;
                     nJ     = jData->norbitals ;
                     xJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
-                    sX     = RealArray2D_AllocateWithExtents ( iBasis->nBasis, jBasis->nBasis, NULL ) ;
-                    sY     = RealArray2D_AllocateWithExtents ( iBasis->nBasis, jBasis->nBasis, NULL ) ;
-                    sZ     = RealArray2D_AllocateWithExtents ( iBasis->nBasis, jBasis->nBasis, NULL ) ;
-                    if ( ( sX != NULL ) && ( sY != NULL ) && ( sZ != NULL ) )
+                    RealArray2D_ViewOfRaw ( &sX, 0, iBasis->nBasis, jBasis->nBasis, jBasis->nBasis, 1, &sWork[0    ] ) ;
+                    RealArray2D_ViewOfRaw ( &sY, 0, iBasis->nBasis, jBasis->nBasis, jBasis->nBasis, 1, &sWork[  m*m] ) ;
+                    RealArray2D_ViewOfRaw ( &sZ, 0, iBasis->nBasis, jBasis->nBasis, jBasis->nBasis, 1, &sWork[2*m*m] ) ;
+                    GaussianBasisIntegrals_f1Og1r1 ( iBasis, xI, jBasis, xJ, s2, rWork, &sX, &sY, &sZ ) ;
+                    gX = gY = gZ = 0.0e+00 ;
+                    for ( u = uv = 0 ; u < nI ; u++ )
                     {
-                        GaussianBasisIntegrals_f1Og1r1 ( iBasis, xI, jBasis, xJ, s2, rWork, sX, sY, sZ ) ;
-                        gX = gY = gZ = 0.0e+00 ;
-                        for ( u = uv = 0 ; u < nI ; u++ )
+                        uv = ( ( u + i0 ) * ( ( u + i0 ) + 1 ) ) / 2 + j0 ;
+                        for ( v = 0 ; v < nJ ; uv++, v++ )
                         {
-                            uv = ( ( u + i0 ) * ( ( u + i0 ) + 1 ) ) / 2 + j0 ;
-                            for ( v = 0 ; v < nJ ; uv++, v++ )
-                            {
-                                /* . Note the implicit factor of 2 here. */
-                                b   = ( iData->beta[u] + jData->beta[v] ) * iData->normalization[u] * jData->normalization[v] * dTotal->data[uv] ;
-                                gX += b * Array2D_Item ( sX, u, v ) ;
-                                gY += b * Array2D_Item ( sY, u, v ) ;
-                                gZ += b * Array2D_Item ( sZ, u, v ) ;
-                            }
+                            /* . Note the implicit factor of 2 here. */
+                            b   = ( iData->beta[u] + jData->beta[v] ) * iData->normalization[u] * jData->normalization[v] * dTotal->data[uv] ;
+                            gX += b * Array2D_Item ( &sX, u, v ) ;
+                            gY += b * Array2D_Item ( &sY, u, v ) ;
+                            gZ += b * Array2D_Item ( &sZ, u, v ) ;
                         }
-                        Coordinates3_IncrementRow ( gradients3, i, gX, gY, gZ ) ;
-                        Coordinates3_DecrementRow ( gradients3, j, gX, gY, gZ ) ;
                     }
-                    RealArray2D_Deallocate ( &sX ) ;
-                    RealArray2D_Deallocate ( &sY ) ;
-                    RealArray2D_Deallocate ( &sZ ) ;
+                    Coordinates3_IncrementRow ( threadGradients3, i, gX, gY, gZ ) ;
+                    Coordinates3_DecrementRow ( threadGradients3, j, gX, gY, gZ ) ;
                 }
             }
+            Real_Deallocate ( &rWork ) ;
+            Real_Deallocate ( &sWork ) ;
         }
-        Real_Deallocate ( &rWork ) ;
+        Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &threadBuffers ) ;
     }
 }
 
@@ -101,20 +113,28 @@ void MNDO_ResonanceIntegrals ( const MNDOParametersContainer *parameters
          ( oneElectronMatrix != NULL ) )
     {
         auto Integer n, s2 ;
-        auto Real   *rWork ;
-        n     = GaussianBasisContainer_LargestShell ( bases, True ) ;
-        s2    = n*n ;
-        rWork = Real_Allocate ( 2*s2, NULL ) ;
-        if ( rWork != NULL )
+        n  = GaussianBasisContainer_LargestShell ( bases, True ) ;
+        s2 = n*n ;
+        /* . Each pair updates a distinct block of the matrix so there are no write conflicts between threads. */
+# ifdef USEOPENMP
+        #pragma omp parallel
+# endif
         {
-            auto Integer         i, i0, j, j0, nI, nJ, u, v ;
+            auto Integer         i, i0, j, j0, m, nI, nJ, u, v ;
             auto Real            b ;
             auto GaussianBasis  *iBasis, *jBasis ;
             auto MNDOParameters *iData , *jData  ;
-            auto Real           *xI, *xJ ;
-            auto RealArray2D    *s ;
+            auto Real           *rWork, *sWork, *xI, *xJ ;
+            auto RealArray2D     s ;
+            m     = GaussianBasisContainer_LargestBasis ( bases, False ) ;
+            rWork = Real_Allocate ( 2*s2, NULL ) ;
+            sWork = Real_Allocate ( m*m , NULL ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
             for ( i = 0 ; i < Coordinates3_Rows ( coordinates3 ) ; i++ )
             {
+                if ( ( rWork == NULL ) || ( sWork == NULL ) ) continue ;
                 iBasis = bases->entries[i] ;
                 iData  = parameters->entries[i] ;
                 i0     = Array1D_Item ( bases->centerFunctionPointers, i ) ;
@@ -128,23 +148,20 @@ void MNDO_ResonanceIntegrals ( const MNDOParametersContainer *parameters
                     j0     = Array1D_Item ( bases->centerFunctionPointers, j ) ;
                     nJ     = jData->norbitals ;
                     xJ     = Coordinates3_RowPointer ( coordinates3, j ) ;
-                    s      = RealArray2D_AllocateWithExtents ( iBasis->nBasis, jBasis->nBasis, NULL ) ;
-                    if ( s != NULL )
+                    RealArray2D_ViewOfRaw ( &s, 0, iBasis->nBasis, jBasis->nBasis, jBasis->nBasis, 1, sWork ) ;
+                    GaussianBasisIntegrals_f1Og1i ( iBasis, xI, jBasis, xJ, s2, rWork, &s ) ;
+                    for ( u = 0 ; u < nI ; u++ )
                     {
-                        GaussianBasisIntegrals_f1Og1i ( iBasis, xI, jBasis, xJ, s2, rWork, s ) ;
-                        for ( u = 0 ; u < nI ; u++ )
+                        for ( v = 0 ; v < nJ ; v++ )
                         {
-                            for ( v = 0 ; v < nJ ; v++ )
-                            {
-                                b = 0.5e+00 * ( iData->beta[u] + jData->beta[v] ) * iData->normalization[u] * jData->normalization[v] ;
-                                SymmetricMatrix_Item ( oneElectronMatrix, u+i0, v+j0 ) += ( b * Array2D_Item ( s, u, v ) ) ;
-                            }
+                            b = 0.5e+00 * ( iData->beta[u] + jData->beta[v] ) * iData->normalization[u] * jData->normalization[v] ;
+                            SymmetricMatrix_Item ( oneElectronMatrix, u+i0, v+j0 ) += ( b * Array2D_Item ( &s, u, v ) ) ;
                         }
-                        RealArray2D_Deallocate ( &s ) ;
                     }
                 }
             }
+            Real_Deallocate ( &rWork ) ;
+            Real_Deallocate ( &sWork ) ;
         }
-        Real_Deallocate ( &rWork ) ;
     }
 }
@@ -10,10 +10,19 @@
 # include "Units.h"
 
 /*----------------------------------------------------------------------------------------------------------------------------------
-! . Energy and gradients.
-! . All in atomic units.
+! . Parameters.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 # define _LogTolerance 27.63102111592855 /* . Equivalent to - ln ( 10^(-12) ). */
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Declarations.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Real PairInteraction ( const Real dR, const Real cIJ, const Real rIJ, const Real r2, Real *dF ) ;
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Energy and gradients for all pairs.
+! . All in atomic units.
+!---------------------------------------------------------------------------------------------------------------------------------*/
 Real QCDispersionDFTD2_Energy ( const Real          s6           ,
                                 const Real          sR           ,
                                 const Real          dR           ,
@@ -26,38 +35,143 @@ Real QCDispersionDFTD2_Energy ( const Real          s6           ,
     if ( ( sqrtC6 != NULL ) && ( r0 != NULL ) && ( coordinates3 != NULL ) )
     {
         auto Boolean  doGradients = ( gradients3 != NULL ) ;
-        auto Integer  i, j ;
-        auto Real     cI, cIJ, damp, dampF, dF, dX, dY, dZ, eLocal, expArg, gX, gY, gZ, r, rI, rIJ, r2, r6 ;
-        for ( i = 1 ; i < View1D_Extent ( sqrtC6 ) ; i++ )
+        auto Integer  numberOfThreads ;
+        auto Real    *threadBuffers ;
+        threadBuffers = Coordinates3_AllocateThreadBuffers ( gradients3, &numberOfThreads ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
+        {
+            auto Coordinates3 view, *threadGradients3 ;
+            auto Integer      i, j ;
+            auto Real         cI, dF, dX, dY, dZ, rI ;
+            threadGradients3 = Coordinates3_ThreadBuffer ( gradients3, threadBuffers, &view ) ;
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( i = 1 ; i < View1D_Extent ( sqrtC6 ) ; i++ )
+            {
+                cI = Array1D_Item ( sqrtC6, i ) * s6 ;
+                rI = Array1D_Item ( r0    , i )      ;
+                for ( j = 0 ; j < i ; j++ )
+                {
+                    Coordinates3_DifferenceRow ( coordinates3, i, j, dX, dY, dZ ) ; /* rI - rJ */
+                    energy -= PairInteraction ( dR                                   ,
+                                                cI * Array1D_Item ( sqrtC6, j )      ,
+                                                sR * ( rI + Array1D_Item ( r0, j ) ) ,
+                                                dX * dX + dY * dY + dZ * dZ          ,
+                                                &dF                                  ) ;
+                    if ( doGradients )
+                    {
+                        dX *= dF ; dY *= dF ; dZ *= dF ;
+                        Coordinates3_IncrementRow ( threadGradients3, i, dX, dY, dZ ) ;
+                        Coordinates3_DecrementRow ( threadGradients3, j, dX, dY, dZ ) ;
+                    }
+                }
+            }
+        }
+        Coordinates3_ReduceThreadBuffers ( gradients3, numberOfThreads, &threadBuffers ) ;
+    }
+    return energy ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Energy and gradients for the pairs in a pairlist.
+! . The pairlist can be a self pairlist, in which case coordinates3A and coordinates3B (and the gradients) are the same, or a
+! . cross pairlist. The latter is used for images in which case coordinates3B are the transformed coordinates of the image.
+! . The units are those of the arguments (e.g. Angstroms and kJ mol^-1 when periodic images are involved).
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Real QCDispersionDFTD2_EnergyPairList ( const Real          s6            ,
+                                        const Real          sR            ,
+                                        const Real          dR            ,
+                                        const Real          scale         ,
+                                        const RealArray1D  *sqrtC6        ,
+                                        const RealArray1D  *r0            ,
+                                        const Coordinates3 *coordinates3A ,
+                                        const Coordinates3 *coordinates3B ,
+                                              PairList     *pairList      ,
+                                              Coordinates3 *gradients3A   ,
+                                              Coordinates3 *gradients3B   ,
+                                              Status       *status        )
+{
+    auto Real energy = 0.0e+00 ;
+    if ( ( sqrtC6        != NULL ) &&
+         ( r0            != NULL ) &&
+         ( coordinates3A != NULL ) &&
+         ( coordinates3B != NULL ) &&
+         ( pairList      != NULL ) &&
+         ( PairList_NumberOfPairs ( pairList ) > 0 ) &&
+         Status_IsOK ( status ) )
+    {
+        auto Boolean  doGradients = ( gradients3A != NULL ) && ( gradients3B != NULL ) ;
+        auto Integer  numberOfThreads, numberOfRecords ;
+        auto Real    *threadBuffersA = NULL, *threadBuffersB = NULL ;
+        if ( doGradients ) Coordinates3_AllocatePairedThreadBuffers ( gradients3A, gradients3B, &numberOfThreads, &threadBuffersA, &threadBuffersB ) ;
+        else               Coordinates3_AllocateThreadBuffers       ( NULL, &numberOfThreads ) ;
+        numberOfRecords = PairList_NumberOfRecords ( pairList ) ;
+# ifdef USEOPENMP
+        #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : energy )
+# endif
         {
-            cI = Array1D_Item ( sqrtC6, i ) * s6 ;
-            rI = Array1D_Item ( r0    , i )      ;
-            for ( j = 0 ; j < i ; j++ )
+            auto Coordinates3  viewA, viewB, *threadGradients3A = NULL, *threadGradients3B = NULL ;
+            auto Integer       i, j, m, r ;
+            auto Real          cI, dF, dX, dY, dZ, rI, xI, yI, zI ;
+            if ( doGradients )
             {
-	        Coordinates3_DifferenceRow ( coordinates3, i, j, dX, dY, dZ ) ; /* rI - rJ */
-                cIJ    = cI * Array1D_Item ( sqrtC6, j ) ;
-                rIJ    = sR * ( rI + Array1D_Item ( r0, j ) ) ;
-                r2     = dX * dX + dY * dY + dZ * dZ ;
-                r6     = r2 * r2 * r2 ;
-                r      = sqrt ( r2 ) ;
-                expArg = dR * ( r / rIJ - 1.0e+00 ) ;
-                     if ( expArg >  _LogTolerance ) { damp = 1.0e+00 ; dampF = 0.0e+00 ; }
-                else if ( expArg < -_LogTolerance ) { damp = 0.0e+00 ; dampF = 0.0e+00 ; }
-                else { dampF = exp ( -expArg ) ; damp = 1.0e+00 / ( 1.0e+00 + dampF ) ; }
-                eLocal  = cIJ * damp / r6 ;
-                energy -= eLocal ;
-                if ( doGradients )
+                threadGradients3A = Coordinates3_ThreadBuffer ( gradients3A, threadBuffersA, &viewA ) ;
+                threadGradients3B = Coordinates3_ThreadBuffer ( gradients3B, threadBuffersB, &viewB ) ;
+            }
+# ifdef USEOPENMP
+            #pragma omp for schedule ( dynamic )
+# endif
+            for ( r = 0 ; r < numberOfRecords ; r++ )
+            {
+                i      = pairList->indices[r] ;
+                cI     = Array1D_Item ( sqrtC6, i ) * s6 * scale ;
+                rI     = Array1D_Item ( r0    , i ) ;
+                xI     = Coordinates3_Item ( coordinates3A, i, 0 ) ;
+                yI     = Coordinates3_Item ( coordinates3A, i, 1 ) ;
+                zI     = Coordinates3_Item ( coordinates3A, i, 2 ) ;
+                for ( m = pairList->offsets[r] ; m < pairList->offsets[r+1] ; m++ )
                 {
-                    dF = ( 6.0e+00 / r2 - ( dR * damp * dampF ) / ( r * rIJ ) ) * eLocal ;
-                    gX = dF * dX ;
-                    gY = dF * dY ;
-                    gZ = dF * dZ ;
-                    Coordinates3_IncrementRow ( gradients3, i, gX, gY, gZ ) ;
-                    Coordinates3_DecrementRow ( gradients3, j, gX, gY, gZ ) ;
+                    j  = pairList->partners[m] ;
+                    dX = xI - Coordinates3_Item ( coordinates3B, j, 0 ) ;
+                    dY = yI - Coordinates3_Item ( coordinates3B, j, 1 ) ;
+                    dZ = zI - Coordinates3_Item ( coordinates3B, j, 2 ) ;
+                    energy -= PairInteraction ( dR                                   ,
+                                                cI * Array1D_Item ( sqrtC6, j )      ,
+                                                sR * ( rI + Array1D_Item ( r0, j ) ) ,
+                                                dX * dX + dY * dY + dZ * dZ          ,
+                                                &dF                                  ) ;
+                    if ( doGradients )
+                    {
+                        dX *= dF ; dY *= dF ; dZ *= dF ;
+                        Coordinates3_IncrementRow ( threadGradients3A, i, dX, dY, dZ ) ;
+                        Coordinates3_DecrementRow ( threadGradients3B, j, dX, dY, dZ ) ;
+                    }
                 }
             }
         }
+        if ( doGradients ) Coordinates3_ReducePairedThreadBuffers ( gradients3A, gradients3B, numberOfThreads, &threadBuffersA, &threadBuffersB ) ;
     }
     return energy ;
 }
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . The interaction for a single pair without the minus sign.
+! . dF is the radial derivative of the (signed) energy divided by r.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static Real PairInteraction ( const Real dR, const Real cIJ, const Real rIJ, const Real r2, Real *dF )
+{
+    Real damp, dampF, eLocal, expArg, r, r6 ;
+    r6     = r2 * r2 * r2 ;
+    r      = sqrt ( r2 ) ;
+    expArg = dR * ( r / rIJ - 1.0e+00 ) ;
+         if ( expArg >  _LogTolerance ) { damp = 1.0e+00 ; dampF = 0.0e+00 ; }
+    else if ( expArg < -_LogTolerance ) { damp = 0.0e+00 ; dampF = 0.0e+00 ; }
+    else { dampF = exp ( -expArg ) ; damp = 1.0e+00 / ( 1.0e+00 + dampF ) ; }
+    eLocal = cIJ * damp / r6 ;
+    (*dF)  = ( 6.0e+00 / r2 - ( dR * damp * dampF ) / ( r * rIJ ) ) * eLocal ;
+    return eLocal ;
+}
 # undef _LogTolerance
@@ -36,6 +36,18 @@ cdef extern from "CICPHF.h":
                                                                            CSymmetricMatrix       *work1                     ,
                                                                            CSymmetricMatrix       *work2                     ,
                                                                            CRealArray1D           *x                         )
+    cdef void CCICPHF_ApplyCPHFMatrices    "CICPHF_ApplyCPHFMatrices"    ( CInteger                n1                        ,
+                                                                           CIntegerArray2D        *in1                       ,
+                                                                           CInteger                n2                        ,
+                                                                           CIntegerArray2D        *in2                       ,
+                                                                           CRealArray1D           *aDiagonal                 ,
+                                                                           CRealArray2D           *b                         ,
+                                                                           CRealArray2D           *orbitals                  ,
+                                                                           CBlockStorage          *twoElectronIntegrals      ,
+                                                                           CSymmetricMatrix       *work1                     ,
+                                                                           CSymmetricMatrix       *work2                     ,
+                                                                           CRealArray2D           *x                         ,
+                                                                           CStatus                *status                    )
     cdef void CCICPHF_CalculateCPHFVectors "CICPHF_CalculateCPHFVectors" ( CInteger                nActive                   ,
                                                                            CInteger                nCore                     ,
                                                                            CInteger                nOrbitals                 ,
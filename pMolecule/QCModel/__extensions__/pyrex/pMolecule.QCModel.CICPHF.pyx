@@ -31,6 +31,35 @@ def CICPHF_ApplyCPHFMatrix (                 n1                            ,
                               work2.cObject                ,
                               x.cObject                    )
 
+def CICPHF_ApplyCPHFMatrices (                 n1                            ,
+                               IntegerArray2D  in1                  not None ,
+                                               n2                            ,
+                               IntegerArray2D  in2                  not None ,
+                               RealArray1D     aDiagonal                     ,
+                               RealArray2D     b                    not None ,
+                               RealArray2D     orbitals             not None ,
+                               BlockStorage    twoElectronIntegrals not None ,
+                               SymmetricMatrix work1                not None ,
+                               SymmetricMatrix work2                not None ,
+                               RealArray2D     x                    not None ):
+    """Apply the CPHF matrix to several vectors stored as the rows of b."""
+    cdef CRealArray1D *cADiagonal = NULL
+    cdef CStatus       cStatus    = CStatus_OK
+    if aDiagonal is not None: cADiagonal = aDiagonal.cObject
+    CCICPHF_ApplyCPHFMatrices ( n1                           ,
+                                in1.cObject                  ,
+                                n2                           ,
+                                in2.cObject                  ,
+                                cADiagonal                   ,
+                                b.cObject                    ,
+                                orbitals.cObject             ,
+                                twoElectronIntegrals.cObject ,
+                                work1.cObject                ,
+                                work2.cObject                ,
+                                x.cObject                    ,
+                                &cStatus                     )
+    if cStatus != CStatus_OK: raise QCModelError ( "Error applying the CPHF matrix." )
+
 def CICPHF_CalculateCPHFVectors ( nActive   ,
                                   nCore     ,
                                   nOrbitals ,
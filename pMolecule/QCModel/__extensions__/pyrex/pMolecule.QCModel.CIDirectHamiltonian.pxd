@@ -0,0 +1,48 @@
+from pCore.CPrimitiveTypes                                cimport CInteger                          , \
+                                                                  CReal
+from pCore.Status                                         cimport CStatus                           , \
+                                                                  CStatus_OK
+from pMolecule.QCModel.CIConfigurationContainer           cimport CCIConfigurationContainer         , \
+                                                                  CIConfigurationContainer
+from pScientific.Arrays.DoubleSymmetricMatrix             cimport CDoubleSymmetricMatrix            , \
+                                                                  DoubleSymmetricMatrix
+from pScientific.Arrays.RealArray1D                       cimport CRealArray1D                      , \
+                                                                  RealArray1D
+from pScientific.Arrays.SymmetricMatrix                   cimport CSymmetricMatrix                  , \
+                                                                  SymmetricMatrix
+
+#===================================================================================================================================
+# . Declarations.
+#===================================================================================================================================
+cdef extern from "CIDirectHamiltonian.h":
+
+    ctypedef struct CCIDirectHamiltonian "CIDirectHamiltonian":
+        CInteger nActive
+        CInteger nConfigurations
+
+    cdef void                  CIDirectHamiltonian_Deallocate                 ( CCIDirectHamiltonian      **self           )
+    cdef CCIDirectHamiltonian *CIDirectHamiltonian_FromConfigurations         ( CCIConfigurationContainer  *configurations ,
+                                                                                CStatus                    *status         )
+    cdef void                  CIDirectHamiltonian_GetDiagonal                ( CCIDirectHamiltonian       *self           ,
+                                                                                CRealArray1D               *diagonal       ,
+                                                                                CStatus                    *status         )
+    cdef void                  CIDirectHamiltonian_MakeDiagonalPreconditioner ( CCIDirectHamiltonian       *self           ,
+                                                                                CRealArray1D               *preconditioner ,
+                                                                                CReal                      *tolerance      ,
+                                                                                CStatus                    *status         )
+    cdef void                  CIDirectHamiltonian_Update                     ( CCIDirectHamiltonian       *self           ,
+                                                                                CSymmetricMatrix           *fCoreMO        ,
+                                                                                CDoubleSymmetricMatrix     *moTEIs         ,
+                                                                                CStatus                    *status         )
+    cdef void                  CIDirectHamiltonian_VectorMultiply             ( CCIDirectHamiltonian       *self           ,
+                                                                                CRealArray1D               *x              ,
+                                                                                CRealArray1D               *y              ,
+                                                                                CStatus                    *status         )
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class CIDirectHamiltonian:
+
+    cdef CCIDirectHamiltonian *cObject
+    cdef public object         isOwner
@@ -0,0 +1,72 @@
+"""A direct CI Hamiltonian that forms CI matrix-vector products without constructing the matrix."""
+
+from .QCModelError import QCModelError
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+cdef class CIDirectHamiltonian:
+
+    def __dealloc__ ( self ):
+        """Destructor."""
+        if self.isOwner:
+            CIDirectHamiltonian_Deallocate ( &self.cObject )
+            self.isOwner = False
+
+    def __len__ ( self ):
+        """The number of configurations."""
+        if self.cObject == NULL: return 0
+        else:                    return self.cObject.nConfigurations
+
+    def _Initialize ( self ):
+        """Initialization."""
+        self.cObject = NULL
+        self.isOwner = False
+
+    @classmethod
+    def FromConfigurations ( selfClass, CIConfigurationContainer configurations not None ):
+        """Constructor from a set of configurations."""
+        cdef CIDirectHamiltonian self
+        cdef CStatus             cStatus = CStatus_OK
+        self         = selfClass.Raw ( )
+        self.cObject = CIDirectHamiltonian_FromConfigurations ( configurations.cObject, &cStatus )
+        self.isOwner = True
+        if cStatus != CStatus_OK: raise QCModelError ( "Error making direct CI Hamiltonian - configurations must all have the same numbers of alpha and beta electrons." )
+        return self
+
+    def GetDiagonal ( self, RealArray1D diagonal not None ):
+        """Get the diagonal of the Hamiltonian."""
+        cdef CStatus cStatus = CStatus_OK
+        CIDirectHamiltonian_GetDiagonal ( self.cObject, diagonal.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise QCModelError ( "Error getting direct CI Hamiltonian diagonal." )
+
+    def MakeDiagonalPreconditioner ( self, RealArray1D preconditioner not None, tolerance = None ):
+        """Make a diagonal preconditioner."""
+        cdef CReal   cTolerance
+        cdef CReal  *pTolerance = NULL
+        cdef CStatus cStatus    = CStatus_OK
+        if tolerance is not None:
+            cTolerance = tolerance
+            pTolerance = &cTolerance
+        CIDirectHamiltonian_MakeDiagonalPreconditioner ( self.cObject, preconditioner.cObject, pTolerance, &cStatus )
+        if cStatus != CStatus_OK: raise QCModelError ( "Error making direct CI Hamiltonian preconditioner." )
+
+    @classmethod
+    def Raw ( selfClass ):
+        """Raw constructor."""
+        self = selfClass.__new__ ( selfClass )
+        self._Initialize ( )
+        return self
+
+    def Update ( self, SymmetricMatrix       fCoreMO not None ,
+                       DoubleSymmetricMatrix moTEIs  not None ):
+        """Update the Hamiltonian with new integrals."""
+        cdef CStatus cStatus = CStatus_OK
+        CIDirectHamiltonian_Update ( self.cObject, fCoreMO.cObject, moTEIs.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise QCModelError ( "Error updating direct CI Hamiltonian." )
+
+    def VectorMultiply ( self, RealArray1D x not None, RealArray1D y not None ):
+        """Multiply x by the Hamiltonian and put the result in y."""
+        cdef CStatus cStatus = CStatus_OK
+        CIDirectHamiltonian_VectorMultiply ( self.cObject, x.cObject, y.cObject, &cStatus )
+        if cStatus != CStatus_OK: raise QCModelError ( "Error multiplying vector by direct CI Hamiltonian." )
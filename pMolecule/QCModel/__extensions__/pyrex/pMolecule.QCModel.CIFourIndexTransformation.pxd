@@ -23,4 +23,5 @@ cdef extern from "CIFourIndexTransformation.h":
                                           CBlockStorage          *twoElectronIntegrals ,
                                           CRealArray2D           *moTEI34              ,
                                           CRealArrayND           *moTEI234             ,
-                                          CDoubleSymmetricMatrix *moTEIs               ) ;
+                                          CDoubleSymmetricMatrix *moTEIs               ,
+                                          CStatus                *status               ) ;
@@ -1,5 +1,7 @@
 """TEI four-index transformation functions."""
 
+from .QCModelError import QCModelError
+
 # . Should probably check dimensions here.
 
 #===================================================================================================================================
@@ -19,6 +21,7 @@ def CIFourIndexTransformation_Make ( RealArray2D  activeMOs            not None
     cdef DoubleSymmetricMatrix moTEIs   = None
     cdef RealArray2D           moTEI34  = None
     cdef RealArrayND           moTEI234 = None
+    cdef CStatus               cStatus  = CStatus_OK
     ( nBasis, nActive ) = activeMOs.shape
     nATr   = ( nActive * ( nActive + 1 ) ) / 2 ;
     nBTr   = ( nBasis  * ( nBasis  + 1 ) ) / 2 ;
@@ -38,5 +41,7 @@ def CIFourIndexTransformation_Make ( RealArray2D  activeMOs            not None
                                 twoElectronIntegrals.cObject ,
                                 moTEI34.cObject              ,
                                 moTEI234.cObject             ,
-                                moTEIs.cObject               )
+                                moTEIs.cObject               ,
+                                &cStatus                     )
+    if cStatus != CStatus_OK: raise QCModelError ( "Error performing four-index transformation." )
     return moTEIs
@@ -3,6 +3,7 @@ from pCore.CPrimitiveTypes                    cimport CBoolean
                                                       CInteger                     , \
                                                       CReal                        , \
                                                       CTrue
+from pMolecule.QCModel.CIDirectHamiltonian    cimport CIDirectHamiltonian
 from pScientific.Arrays.IntegerArray1D        cimport IntegerArray1D               , \
                                                       IntegerArray1D_PointerToData
 from pScientific.Arrays.RealArray1D           cimport CRealArray1D                 , \
@@ -24,6 +25,7 @@ from pScientific.LinearAlgebra.PrimmeSolver   cimport CPrimmeParams
 #===================================================================================================================================
 cdef extern from "CISparseSolver.h":
 
+    cdef void CISparseSolver_ApplyDirectMatrix   ( void *xVoid, void *yVoid, CInteger *blockSize, CPrimmeParams *primme )
     cdef void CISparseSolver_ApplyMatrix         ( void *xVoid, void *yVoid, CInteger *blockSize, CPrimmeParams *primme )
     cdef void CISparseSolver_ApplyPreconditioner ( void *xVoid, void *yVoid, CInteger *blockSize, CPrimmeParams *primme )
 
@@ -36,7 +38,7 @@ cdef class CISparseSolver:
     cdef public RealArray1D           eigenValues
     cdef public RealArray2D           eigenVectors
     cdef public IntegerArray1D        iWork
-    cdef public SparseSymmetricMatrix matrix
+    cdef public object                matrix
     cdef public RealArray1D           preconditioner
     cdef public RealArray1D           residualNorms
     cdef public RealArray1D           rWork
@@ -38,9 +38,9 @@ cdef class CISparseSolver:
     def ApplyMatrix ( self, RealArray1D x not None ,
                             RealArray1D y not None ):
         """Apply the matrix to x in y."""
-        CISparseSolver_ApplyMatrix ( RealArray1D_PointerToData ( x.cObject ) ,
-                                     RealArray1D_PointerToData ( y.cObject ) ,
-                                     NULL, &(self.cObject) )
+        self.cObject.matrixMatvec ( RealArray1D_PointerToData ( x.cObject ) ,
+                                    RealArray1D_PointerToData ( y.cObject ) ,
+                                    NULL, &(self.cObject) )
 
     def ApplyPreconditioner ( self, RealArray1D x not None ,
                                     RealArray1D y not None ):
@@ -70,16 +70,25 @@ cdef class CISparseSolver:
         return results
 
     @classmethod
-    def FromArrays ( selfClass, RealArray1D           eigenValues  not None ,
-                                RealArray2D           eigenVectors not None ,
-                                SparseSymmetricMatrix matrix       not None ,
-                                RealArray1D           preconditioner        ):
-        """Set up the solver from arrays."""
+    def FromArrays ( selfClass, RealArray1D eigenValues  not None ,
+                                RealArray2D eigenVectors not None ,
+                                            matrix       not None ,
+                                RealArray1D preconditioner        ,
+                                            blockSize      = None ):
+        """Set up the solver from arrays.
+
+        The matrix is either a sparse symmetric matrix or a direct CI Hamiltonian.
+        The matrix and preconditioner are applied to blocks of at most blockSize vectors at once.
+        """
         cdef CISparseSolver self
         cdef int            n, v
         cdef CRealArray1D  *cPreconditioner = NULL
+        isDirect = isinstance ( matrix, CIDirectHamiltonian )
+        if isDirect: m = len ( matrix )
+        else:        m = matrix.shape[0]
         ( v, n ) = eigenVectors.shape # . Row-wise storage.
-        isOK     = ( n > 0 ) and ( v > 0 ) and ( v == len ( eigenValues ) ) and ( n == matrix.shape[0] ) and \
+        isOK     = ( n > 0 ) and ( v > 0 ) and ( v == len ( eigenValues ) ) and ( n == m ) and \
+                   ( isDirect or isinstance ( matrix, SparseSymmetricMatrix ) ) and \
                    ( ( preconditioner is None ) or ( ( preconditioner is not None ) and ( n == len ( preconditioner ) ) ) )
         if not isOK: raise QCModelError ( "Error setting up CI sparse matrix solver." )
         self = selfClass ( )
@@ -88,10 +97,15 @@ cdef class CISparseSolver:
         if preconditioner is not None: cPreconditioner = preconditioner.cObject
         self.cObject.n                   = n # . Matrix size.
         self.cObject.numEvals            = v # . Number of eigenvectors.
-        self.cObject.matrixMatvec        = CISparseSolver_ApplyMatrix
         self.cObject.applyPreconditioner = CISparseSolver_ApplyPreconditioner
-        self.cObject.matrix              = <void*> matrix.cObject
+        if isDirect:
+            self.cObject.matrixMatvec    = CISparseSolver_ApplyDirectMatrix
+            self.cObject.matrix          = <void*> ( <CIDirectHamiltonian> matrix ).cObject
+        else:
+            self.cObject.matrixMatvec    = CISparseSolver_ApplyMatrix
+            self.cObject.matrix          = <void*> ( <SparseSymmetricMatrix> matrix ).cObject
         self.cObject.preconditioner      = <void*> cPreconditioner
+        if blockSize is not None: self.cObject.maxBlockSize = max ( 1, min ( blockSize, v ) )
         # . Assignment.
         self.eigenValues    = eigenValues 
         self.eigenVectors   = eigenVectors
@@ -126,9 +140,9 @@ cdef class CISparseSolver:
         # . Simple case which gives an error in dprimme.
         if self.cObject.n == 1:
             self.eigenVectors.Set ( 1.0 )
-            CISparseSolver_ApplyMatrix ( RealArray2D_PointerToData ( self.eigenVectors.cObject ) ,
-                                         RealArray1D_PointerToData ( self.eigenValues.cObject  ) ,
-                                         NULL, &(self.cObject) )
+            self.cObject.matrixMatvec ( RealArray2D_PointerToData ( self.eigenVectors.cObject ) ,
+                                        RealArray1D_PointerToData ( self.eigenValues.cObject  ) ,
+                                        NULL, &(self.cObject) )
             return { "Converged"                     : True ,
                      "Converged Pairs"               : 1    ,
                      "Matrix-Vector Multiplications" : 1    ,
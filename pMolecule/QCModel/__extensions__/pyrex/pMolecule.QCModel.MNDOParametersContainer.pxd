@@ -3,7 +3,8 @@ from pCore.CPrimitiveTypes                                  cimport CBoolean
                                                                     CInteger               , \
                                                                     CReal                  , \
                                                                     CTrue
-from pCore.Status                                           cimport CStatus
+from pCore.Status                                           cimport CStatus                , \
+                                                                    CStatus_OK
 from pMolecule.QCModel.GaussianBases.GaussianBasisContainer cimport GaussianBasisContainer
 from pMolecule.QCModel.MNDOParameters                       cimport CMNDOParameters        , \
                                                                     MNDOParameters
@@ -12,18 +13,31 @@ from pScientific.Arrays.RealArray1D                         cimport RealArray1D
 #===================================================================================================================================
 # . Declarations.
 #===================================================================================================================================
+cdef extern from "MNDOIntegralTable.h":
+
+    ctypedef struct CMNDOIntegralTable "MNDOIntegralTable":
+        CReal lowerBound
+        CReal spacing
+        CReal upperBound
+
 cdef extern from "MNDOParametersContainer.h":
 
     ctypedef struct CMNDOParametersContainer "MNDOParametersContainer":
-        CBoolean          isOwner 
-        CInteger          capacity
-        CMNDOParameters **entries 
+        CBoolean            isOwner 
+        CInteger            capacity
+        CMNDOIntegralTable *integralTable
+        CMNDOParameters   **entries 
 
-    cdef CMNDOParametersContainer *MNDOParametersContainer_Allocate   ( CInteger                   capacity ,
-                                                                        CStatus                   *status   )
-    cdef CMNDOParametersContainer *MNDOParametersContainer_Clone      ( CMNDOParametersContainer  *self     ,
-                                                                        CStatus                   *status   )
-    cdef void                      MNDOParametersContainer_Deallocate ( CMNDOParametersContainer **self     )
+    cdef CMNDOParametersContainer *MNDOParametersContainer_Allocate          ( CInteger                   capacity   ,
+                                                                               CStatus                   *status     )
+    cdef CMNDOParametersContainer *MNDOParametersContainer_Clone             ( CMNDOParametersContainer  *self       ,
+                                                                               CStatus                   *status     )
+    cdef void                      MNDOParametersContainer_Deallocate        ( CMNDOParametersContainer **self       )
+    cdef void                      MNDOParametersContainer_MakeIntegralTable ( CMNDOParametersContainer  *self       ,
+                                                                               CReal                      lowerBound ,
+                                                                               CReal                      spacing    ,
+                                                                               CReal                      upperBound ,
+                                                                               CStatus                   *status     )
 
 #===================================================================================================================================
 # . Class.
@@ -45,6 +45,10 @@ cdef class MNDOParametersContainer:
         state = { "Atomic Numbers" : self.atomicNumbers ,
                   "Unique Entries" : self.uniqueEntries }
         if self.label is not None: state["Label"] = self.label
+        if ( self.cObject != NULL ) and ( self.cObject.integralTable != NULL ):
+            state["Integral Table"] = { "Lower Bound" : self.cObject.integralTable.lowerBound ,
+                                        "Spacing"     : self.cObject.integralTable.spacing    ,
+                                        "Upper Bound" : self.cObject.integralTable.upperBound }
         return state
 
     def __init__ ( self, capacity ):
@@ -60,6 +64,9 @@ cdef class MNDOParametersContainer:
         """Set the state."""
         self._CreateObject ( state["Unique Entries"], state["Atomic Numbers"] )
         self.label = state.get ( "Label", None )
+        table      = state.get ( "Integral Table", None )
+        if table is not None:
+            self.MakeIntegralTable ( lowerBound = table["Lower Bound"], spacing = table["Spacing"], upperBound = table["Upper Bound"] )
 
     def _Allocate ( self, capacity ):
         """Constructor."""
@@ -120,6 +127,12 @@ cdef class MNDOParametersContainer:
         self._CheckDiatomicTerms ( )
         return self
 
+    def MakeIntegralTable ( self, lowerBound = 0.5, spacing = 0.02, upperBound = 20.0 ):
+        """Make a table of the two-center local-frame integrals (distances in atomic units) that is built when first needed."""
+        cdef CStatus cStatus = CStatus_OK
+        MNDOParametersContainer_MakeIntegralTable ( self.cObject, lowerBound, spacing, upperBound, &cStatus )
+        if cStatus != CStatus_OK: raise QCModelError ( "Error making MNDO integral table." )
+
     def MakeOrbitalBasis ( self, atomicNumbers, path = None ):
         """Make the orbital basis."""
         if path is None: path = os.path.join ( os.getenv ( "PDYNAMO3_PARAMETERS" ), "mndoParameters", "mndostong" )
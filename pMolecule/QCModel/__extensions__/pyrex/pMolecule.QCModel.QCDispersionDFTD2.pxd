@@ -4,6 +4,10 @@ from pCore.CPrimitiveTypes              cimport CBoolean        , \
                                                 CTrue           , \
                                                 CInteger        , \
                                                 CReal              
+from pCore.PairList                     cimport CPairList       , \
+                                                PairList
+from pCore.Status                       cimport CStatus         , \
+                                                CStatus_OK
 from pScientific.Arrays.RealArray1D     cimport CRealArray1D    , \
                                                 RealArray1D        
 from pScientific.Arrays.RealArray2D     cimport CRealArray2D
@@ -21,3 +25,16 @@ cdef extern from "QCDispersionDFTD2.h":
                                                                       CRealArray1D  *r0           ,
                                                                       CRealArray2D  *coordinates3 ,
                                                                       CRealArray2D  *gradients3   )
+
+    cdef CReal QCDispersionDFTD2_EnergyPairList                     ( CReal          s6            ,
+                                                                      CReal          sR            ,
+                                                                      CReal          dR            ,
+                                                                      CReal          scale         ,
+                                                                      CRealArray1D  *sqrtC6        ,
+                                                                      CRealArray1D  *r0            ,
+                                                                      CRealArray2D  *coordinates3A ,
+                                                                      CRealArray2D  *coordinates3B ,
+                                                                      CPairList     *pairList      ,
+                                                                      CRealArray2D  *gradients3A   ,
+                                                                      CRealArray2D  *gradients3B   ,
+                                                                      CStatus       *status        )
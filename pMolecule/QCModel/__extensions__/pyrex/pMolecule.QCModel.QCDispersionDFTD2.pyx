@@ -1,7 +1,9 @@
 """DFT-D2 QC dispersion model energy."""
 
+from .QCModelError import QCModelError
+
 #===================================================================================================================================
-# . Function.
+# . Functions.
 #===================================================================================================================================
 def QCDispersionDFTD2_Energy ( s6, sR, dR, RealArray1D  sqrtC6       not None ,
                                            RealArray1D  r0           not None ,
@@ -19,3 +21,28 @@ def QCDispersionDFTD2_Energy ( s6, sR, dR, RealArray1D  sqrtC6       not None ,
                                          coordinates3.cObject ,
                                          cGradients3          )
     return energy
+
+def QCDispersionDFTD2_PairListEnergy ( s6, sR, dR, RealArray1D  sqrtC6       not None ,
+                                                   RealArray1D  r0           not None ,
+                                                   Coordinates3 coordinates3 not None ,
+                                                   PairList     pairList     not None ,
+                                                   Coordinates3 gradients3            ):
+    """DFT-D2 energy for the pairs in a self pairlist."""
+    cdef CReal         energy
+    cdef CRealArray2D *cGradients3 = NULL
+    cdef CStatus       cStatus     = CStatus_OK
+    if gradients3 is not None: cGradients3 = gradients3.cObject
+    energy = QCDispersionDFTD2_EnergyPairList ( s6                   ,
+                                                sR                   ,
+                                                dR                   ,
+                                                1.0                  ,
+                                                sqrtC6.cObject       ,
+                                                r0.cObject           ,
+                                                coordinates3.cObject ,
+                                                coordinates3.cObject ,
+                                                pairList.cObject     ,
+                                                cGradients3          ,
+                                                cGradients3          ,
+                                                &cStatus             )
+    if cStatus != CStatus_OK: raise QCModelError ( "Error evaluating DFT-D2 pairlist energy." )
+    return energy
@@ -33,6 +33,7 @@ from .MNDOQCMMEvaluator          import _MNDOQCMMTermLabels
 from .MullikenMultipoleEvaluator import MullikenMultipoleEvaluator
 from .QCDefinitions              import ChargeModel                                       , \
                                         FockClosurePriority
+from .QCDispersionModelDFTD2     import QCDispersionModelDFTD2
 from .QCModel                    import QCModel
 from .QCModelBase                import QCModelBase
 from .QCModelDFT                 import QCModelDFT
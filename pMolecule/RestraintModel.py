@@ -58,6 +58,10 @@ class RestraintModel ( EnergyModel ):
             target.scratch.restraintTerms     = state
         return [ ( EnergyClosurePriority.IndependentEnergyTerm, f, self.__class__._classLabel ) ]
 
+    def FastEnergyClosureLabels ( self, target ):
+        """Return the labels of the fast energy closures."""
+        return { self.__class__._classLabel }
+
     # . No checking is done for duplicate keys.
     @classmethod
     def Merge ( selfClass, items, information = {} ):
@@ -40,6 +40,7 @@ class System ( SummarizableObject ):
                              "_electronicState"    : None        ,
                              "_energyClosures"     : list        ,
                              "_energyModels"       : dict        ,
+                             "_fastEnergyClosures" : list        ,
                              "_freeAtoms"          : None        ,
                              "_mmModel"            : None        ,
                              "_nbModel"            : None        ,
@@ -60,7 +61,7 @@ class System ( SummarizableObject ):
         state.update ( self.connectivity.ToMapping ( ) )
         # . Other data.
         for ( key, value ) in self.__dict__.items ( ):
-            if ( key not in ( "_atoms", "_connectivity", "_energyClosures", "_scratch", "_sequence" ) ) and ( value is not None ): state[key] = value
+            if ( key not in ( "_atoms", "_connectivity", "_energyClosures", "_fastEnergyClosures", "_scratch", "_sequence" ) ) and ( value is not None ): state[key] = value
         return state
 
     def __setstate__ ( self, state ):
@@ -106,7 +107,8 @@ class System ( SummarizableObject ):
                 value = self.__dict__[key0]
                 if ( value is not None ) and hasattr ( value, "UnbuildModel" ): value.UnbuildModel ( self )
                 self.__dict__[key0] = None
-        self._energyClosures = []
+        self._energyClosures     = []
+        self._fastEnergyClosures = []
 
     def _SetHandlerCoordinates3 ( self, value ):
         """Coordinates3 set handler."""
@@ -174,11 +176,17 @@ class System ( SummarizableObject ):
         self.__dict__["_symmetryParameters"] = value
 
     def _UpdateEnergyClosures ( self ):
-        """Update the list of energy closures."""
-        closures = []
+        """Update the lists of energy closures."""
+        closures     = []
+        fastClosures = []
         for key in self._energyModels.keys ( ):
-            closures.extend ( self.__dict__[key].EnergyClosures ( self ) )
-        self._energyClosures = [ closure for ( priority, closure, label ) in sorted ( closures, key = lambda x: x[0] ) ]
+            model         = self.__dict__[key]
+            modelClosures = model.EnergyClosures ( self )
+            fastLabels    = model.FastEnergyClosureLabels ( self )
+            closures.extend     ( modelClosures )
+            fastClosures.extend ( [ item for item in modelClosures if item[2] in fastLabels ] )
+        self._energyClosures     = [ closure for ( priority, closure, label ) in sorted ( closures    , key = lambda x: x[0] ) ]
+        self._fastEnergyClosures = [ closure for ( priority, closure, label ) in sorted ( fastClosures, key = lambda x: x[0] ) ]
 
     def AddEnergyModel ( self, key, value, **options ):
         """Add an energy model."""
@@ -275,6 +283,16 @@ class System ( SummarizableObject ):
                     scratch.symmetryParameterGradients = SymmetryParameterGradients ( )
                 scratch.symmetryParameterGradients.Clear ( )
 
+    def FastEnergy ( self, doGradients = False, log = logFile ):
+        """Calculate the fast part of the energy and, optionally, its gradients for a system.
+
+        The fast part comprises the terms that are cheap to evaluate and that vary rapidly, such as
+        the bonded and short-range nonbonded MM terms.
+        """
+        self.EnergyInitialize ( doGradients, log )
+        for closure in self._fastEnergyClosures: closure ( )
+        return self.EnergyFinalize ( )
+
     @classmethod
     def FromAtoms ( selfClass, atoms, bonds = None, withSequence = False ):
         """Constructor given a list of atoms."""
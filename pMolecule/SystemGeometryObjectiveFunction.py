@@ -138,6 +138,19 @@ class SystemGeometryObjectiveFunction ( ObjectiveFunction ):
         gradients.Scale ( 2.0 )
         return d2
 
+    def FastAccelerations ( self, variables, accelerations ):
+        """Evaluate the fast part of the function and its accelerations."""
+        f = self.FastFunctionGradients ( variables, accelerations )
+        accelerations.Scale ( - _KJMOL_TO_AMUA2PS2 )
+        return f
+
+    def FastFunctionGradients ( self, variables, gradients ):
+        """Evaluate the fast part of the function and its gradients."""
+        self.VariablesPut ( variables )
+        f = self.system.FastEnergy ( doGradients = True, log = self.log )
+        self.GradientsGet ( gradients )
+        return f
+
     @classmethod
     def FromSystem ( selfClass, system ):
         """Constructor given a system."""
@@ -22,7 +22,9 @@ class SystemWithTimings ( System ):
                              "timings"             : None } )
 
     def _UpdateEnergyClosures ( self ):
-        """Update the list of energy closures."""
+        """Update the lists of energy closures."""
+        # . Only the full energy is timed.
+        super ( SystemWithTimings, self )._UpdateEnergyClosures ( )
         closures = []
         for key in self._energyModels.keys ( ):
             closures.extend ( self.__dict__[key].EnergyClosures ( self ) )
@@ -6,6 +6,7 @@
 # include "IntegerArray1D.h"
 # include "Real.h"
 # include "RealArray1D.h"
+# include "RealArray2D.h"
 # include "Status.h"
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -26,6 +27,8 @@ typedef struct {
     Integer                    maximumNonZeroRowItems ;
     Integer                    numberOfItems          ;
     Integer                    size                   ;
+    Integer                   *columnItems            ; /* . Upper-triangular items by row. */
+    IntegerArray1D            *columnIndex            ;
     IntegerArray1D            *rowIndex               ;
     SparseSymmetricMatrixItem *items                  ;
 } SparseSymmetricMatrix ;
@@ -64,6 +67,7 @@ extern void                   SparseSymmetricMatrix_GetDiagonal
 extern void                   SparseSymmetricMatrix_MakeDiagonalPreconditioner             ( const SparseSymmetricMatrix  *self, RealArray1D *preconditioner, const Real *tolerance, Status *status ) ;
 extern void                   SparseSymmetricMatrix_Print                                  ( const SparseSymmetricMatrix  *self ) ;
 extern void                   SparseSymmetricMatrix_VectorMultiply                         ( const SparseSymmetricMatrix  *self, const RealArray1D *x, RealArray1D *y, Status *status ) ;
+extern void                   SparseSymmetricMatrix_VectorsMultiply                        ( const SparseSymmetricMatrix  *self, const RealArray2D *x, RealArray2D *y, Status *status ) ;
 
 /* . Iterators. */
 extern void    SparseSymmetricMatrixRowItemIterator_Initialize ( SparseSymmetricMatrixRowItemIterator *self, SparseSymmetricMatrix *target, const Integer row, Status *status ) ;
@@ -14,7 +14,8 @@
 ! . this involves redundant extra storage for diagonal items.
 !
 ! . A matrix is canonical when its off-diagonal items are put in ascending order of (i,j) pairs
-! . with i > j.
+! . with i > j. Canonical matrices are also indexed by column so that the complete row of an item,
+! . both lower and upper-triangular parts, can be accessed without scattering.
 !
 ! . These choices may change if matrices with many zero diagonal elements are to be routinely treated.
 */
@@ -57,15 +58,20 @@ SparseSymmetricMatrix *SparseSymmetricMatrix_Allocate ( const Integer extent, co
             self->numberOfItems          = extent ;
             self->size                   = Maximum ( size, extent ) ;
             /* . Arrays. */
+            self->columnItems            = NULL ;
+            self->columnIndex            = NULL ;
             self->rowIndex               = NULL ;
             self->items                  = NULL ;
             /* . Allocation. */
-            self->items    = Memory_AllocateArrayOfTypes ( self->size, SparseSymmetricMatrixItem ) ;
-            self->rowIndex = IntegerArray1D_AllocateWithExtent ( extent+1, status ) ;
-            if ( ( self->items == NULL ) || ( self->rowIndex == NULL ) ) SparseSymmetricMatrix_Deallocate ( &self ) ;
+            self->columnItems = Memory_AllocateArrayOfTypes ( self->size, Integer ) ;
+            self->items       = Memory_AllocateArrayOfTypes ( self->size, SparseSymmetricMatrixItem ) ;
+            self->columnIndex = IntegerArray1D_AllocateWithExtent ( extent+1, status ) ;
+            self->rowIndex    = IntegerArray1D_AllocateWithExtent ( extent+1, status ) ;
+            if ( ( self->columnItems == NULL ) || ( self->items == NULL ) || ( self->columnIndex == NULL ) || ( self->rowIndex == NULL ) ) SparseSymmetricMatrix_Deallocate ( &self ) ;
             else
             {
-                IntegerArray1D_Set ( self->rowIndex, -1 ) ;
+                IntegerArray1D_Set ( self->columnIndex, -1 ) ;
+                IntegerArray1D_Set ( self->rowIndex   , -1 ) ;
                 SparseSymmetricMatrix_InitializeDiagonalItems ( self ) ;
             }
         }
@@ -507,8 +513,10 @@ void SparseSymmetricMatrix_Deallocate ( SparseSymmetricMatrix **self )
 {
     if ( ( self != NULL ) && ( (*self) != NULL ) )
     {
-        IntegerArray1D_Deallocate ( &((*self)->rowIndex) ) ;
-        Memory_Deallocate         (   (*self)->items     ) ;
+        IntegerArray1D_Deallocate ( &((*self)->columnIndex) ) ;
+        IntegerArray1D_Deallocate ( &((*self)->rowIndex   ) ) ;
+        Memory_Deallocate         (   (*self)->columnItems  ) ;
+        Memory_Deallocate         (   (*self)->items        ) ;
         Memory_Deallocate         (   (*self)            ) ;
     }
 }
@@ -583,6 +591,15 @@ static void SparseSymmetricMatrix_IndexItems ( SparseSymmetricMatrix *self )
 	    last += n ;
         }
         Array1D_Item ( self->rowIndex, self->extent ) = last ;
+
+        /* . Column index - the upper-triangular items in each row in ascending order of column. */
+        /* . These are found by following the links from the diagonal items. */
+        for ( n = 0, last = 0 ; n < self->extent ; n++ )
+        {
+            Array1D_Item ( self->columnIndex, n ) = last ;
+            for ( l = self->items[n].next ; l >= 0 ; l = self->items[l].next ) self->columnItems[last++] = l ;
+        }
+        Array1D_Item ( self->columnIndex, self->extent ) = last ;
     }
 }
 
@@ -682,6 +699,56 @@ void SparseSymmetricMatrix_VectorMultiply ( const SparseSymmetricMatrix *self, c
     }
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Matrix-vector multiplication for a block of vectors which are stored as the rows of x and y.
+! . Canonical matrices are done by row, in parallel if possible, whereas other matrices are done a vector at a time.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void SparseSymmetricMatrix_VectorsMultiply ( const SparseSymmetricMatrix *self, const RealArray2D *x, RealArray2D *y, Status *status )
+{
+    if ( ( self != NULL ) && ( x != NULL ) && ( y != NULL ) && Status_IsOK ( status ) )
+    {
+        if ( ( View2D_Columns ( x ) != self->extent ) || ( View2D_Columns ( y ) != self->extent ) || ( View2D_Rows ( x ) != View2D_Rows ( y ) ) ) Status_Set ( status, Status_NonConformableArrays ) ;
+        else if ( self->isCanonical )
+        {
+            auto Integer r ;
+# ifdef USEOPENMP
+            #pragma omp parallel for schedule ( dynamic, 64 )
+# endif
+            for ( r = 0 ; r < self->extent ; r++ )
+            {
+                auto Integer k, kStart, kStop, l, lStart, lStop, v ;
+                auto Real    sum ;
+                kStart = Array1D_Item ( self->columnIndex, r   ) ;
+                kStop  = Array1D_Item ( self->columnIndex, r+1 ) ;
+                lStart = Array1D_Item ( self->rowIndex   , r   ) ;
+                lStop  = Array1D_Item ( self->rowIndex   , r+1 ) ;
+                for ( v = 0 ; v < View2D_Rows ( x ) ; v++ )
+                {
+                    sum = self->items[r].value * Array2D_Item ( x, v, r ) ;
+                    for ( l = lStart ; l < lStop ; l++ ) sum += self->items[l].value * Array2D_Item ( x, v, self->items[l].j ) ;
+                    for ( k = kStart ; k < kStop ; k++ )
+                    {
+                        l    = self->columnItems[k] ;
+                        sum += self->items[l].value * Array2D_Item ( x, v, self->items[l].i ) ;
+                    }
+                    Array2D_Item ( y, v, r ) = sum ;
+                }
+            }
+        }
+        else
+        {
+            auto Integer     v ;
+            auto RealArray1D xV, yV ;
+            for ( v = 0 ; v < View2D_Rows ( x ) ; v++ )
+            {
+                RealArray1D_ViewOfRaw ( &xV, 0, self->extent, x->stride1, Array2D_RowPointer ( x, v ) ) ;
+                RealArray1D_ViewOfRaw ( &yV, 0, self->extent, y->stride1, Array2D_RowPointer ( y, v ) ) ;
+                SparseSymmetricMatrix_VectorMultiply ( self, &xV, &yV, status ) ;
+            }
+        }
+    }
+}
+
 /*==================================================================================================================================
 ! . Row iterator procedures.
 !=================================================================================================================================*/
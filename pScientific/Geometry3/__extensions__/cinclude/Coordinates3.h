@@ -103,6 +103,16 @@
 !---------------------------------------------------------------------------------------------------------------------------------*/
 extern Coordinates3 *Coordinates3_Allocate                                ( const Integer                extent            ,
                                                                                   Status                *status            ) ;
+extern void          Coordinates3_AllocatePairedThreadBuffers             ( const Coordinates3          *self              ,
+                                                                            const Coordinates3          *other             ,
+                                                                                  Integer               *numberOfThreads   ,
+                                                                                  Real                 **selfBuffers       ,
+                                                                                  Real                 **otherBuffers      ) ;
+extern Real         *Coordinates3_AllocateThreadBuffers                   ( const Coordinates3          *self              ,
+                                                                                  Integer               *numberOfThreads   ) ;
+extern Real         *Coordinates3_AllocateThreadBuffersForWork            ( const Coordinates3          *self              ,
+                                                                            const Integer                work              ,
+                                                                                  Integer               *numberOfThreads   ) ;
 extern Real          Coordinates3_Angle                                   ( const Coordinates3          *self              ,
                                                                             const Integer                i                 ,
                                                                             const Integer                j                 ,
@@ -220,6 +230,14 @@ extern void          Coordinates3_MomentsOfInertia                        ( cons
 extern Real          Coordinates3_RadiusOfGyration                        ( const Coordinates3          *self              ,
                                                                             const Selection             *selection         ,
                                                                             const RealArray1D           *weights           ) ;
+extern void          Coordinates3_ReducePairedThreadBuffers               (       Coordinates3          *self              ,
+                                                                                  Coordinates3          *other             ,
+                                                                            const Integer                numberOfThreads   ,
+                                                                                  Real                 **selfBuffers       ,
+                                                                                  Real                 **otherBuffers      ) ;
+extern void          Coordinates3_ReduceThreadBuffers                     (       Coordinates3          *self              ,
+                                                                            const Integer                numberOfThreads   ,
+                                                                                  Real                 **buffers           ) ;
 extern Real          Coordinates3_RootMeanSquareDeviation                 ( const Coordinates3          *self              ,
                                                                             const Coordinates3          *other             ,
                                                                             const Selection             *selection         ,
@@ -257,6 +275,9 @@ extern void          Coordinates3_Superimpose                             (
                                                                             const RealArray1D           *weights           ,
                                                                                   Matrix33              *rotation          ,
                                                                                   Vector3               *translation       ) ;
+extern Coordinates3 *Coordinates3_ThreadBuffer                            (       Coordinates3          *self              ,
+                                                                                  Real                  *buffers           ,
+                                                                                  Coordinates3          *view              ) ;
 extern void          Coordinates3_ToPrincipalAxes                         (       Coordinates3          *self              ,
                                                                             const Selection             *selection         ,
                                                                             const RealArray1D           *weights           ) ;
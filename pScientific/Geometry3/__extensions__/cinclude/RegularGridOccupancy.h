@@ -27,18 +27,24 @@ typedef struct {
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Functions.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-extern RegularGridOccupancy *RegularGridOccupancy_Allocate          ( const Integer                numberOfCells  ,
-                                                                      const Integer                numberOfPoints ,
-                                                                            Status                *status         ) ;
-extern void                  RegularGridOccupancy_Deallocate        (       RegularGridOccupancy **self           ) ;
-extern void                  RegularGridOccupancy_DeallocateVoid    (       void                 **vSelf          ) ;
-extern Integer               RegularGridOccupancy_Fill              (       RegularGridOccupancy  *self           ,
-                                                                      const RegularGrid           *grid           ,
-                                                                      const RealArray2D           *points         ,
-                                                                            Status                *status         ) ;
-extern RegularGridOccupancy *RegularGridOccupancy_FromGridAndPoints ( const RegularGrid           *grid           ,
-                                                                      const RealArray2D           *points         ,
-                                                                            Status                *status         ) ;
-extern void                  RegularGridOccupancy_Initialize        (       RegularGridOccupancy  *self           ) ;
+extern RegularGridOccupancy *RegularGridOccupancy_Allocate          ( const Integer                numberOfCells   ,
+                                                                      const Integer                numberOfPoints  ,
+                                                                            Status                *status          ) ;
+extern void                  RegularGridOccupancy_Deallocate        (       RegularGridOccupancy **self            ) ;
+extern void                  RegularGridOccupancy_DeallocateVoid    (       void                 **vSelf           ) ;
+extern Integer               RegularGridOccupancy_Fill              (       RegularGridOccupancy  *self            ,
+                                                                      const RegularGrid           *grid            ,
+                                                                      const RealArray2D           *points          ,
+                                                                            Status                *status          ) ;
+extern RegularGridOccupancy *RegularGridOccupancy_FromGridAndPoints ( const RegularGrid           *grid            ,
+                                                                      const RealArray2D           *points          ,
+                                                                            Status                *status          ) ;
+extern void                  RegularGridOccupancy_Initialize        (       RegularGridOccupancy  *self            ) ;
+extern Integer               RegularGridOccupancy_UpdatePoints      (       RegularGridOccupancy  *self            ,
+                                                                      const RegularGrid           *grid            ,
+                                                                      const RealArray2D           *points          ,
+                                                                      const Integer                numberOfIndices ,
+                                                                      const Integer               *indices         ,
+                                                                            Status                *status          ) ;
 
 # endif
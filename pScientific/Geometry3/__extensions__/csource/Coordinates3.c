@@ -10,14 +10,23 @@
 # include "Coordinates3.h"
 # include "DenseEigenvalueSolvers.h"
 # include "IntegerArray1D.h"
+# include "Memory.h"
 # include "NumericalMacros.h"
 
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Parameters.
 !---------------------------------------------------------------------------------------------------------------------------------*/
 /* . The value to return if there are problems with a calculation. */
 # define BadValue 1.0e+30
 
+/* . The minimum amount of work (e.g. terms) for which threading is worthwhile and the maximum number of buffer rows per unit of work. */
+# define MaximumThreadBufferRowsPerWork    4
+# define MinimumThreadedWork            1000
+
 /* . Debugging. */
 # define DEBUG
 /* # define DEBUGPRINTING */
@@ -32,6 +41,68 @@
 !---------------------------------------------------------------------------------------------------------------------------------*/
 Coordinates3 *Coordinates3_Allocate ( const Integer extent, Status *status ) { return RealArray2D_AllocateWithExtents ( extent, 3, status ) ; }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocate per-thread accumulation buffers for a pair of arrays, such as the gradients of two sets of atoms in a pair-list.
+! . The arrays may be the same in which case the buffers are shared. Either both sets of buffers are allocated or neither.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void Coordinates3_AllocatePairedThreadBuffers ( const Coordinates3  *self            ,
+                                                const Coordinates3  *other           ,
+                                                      Integer       *numberOfThreads ,
+                                                      Real         **selfBuffers     ,
+                                                      Real         **otherBuffers    )
+{
+    (*selfBuffers ) = Coordinates3_AllocateThreadBuffers ( self, numberOfThreads ) ;
+    (*otherBuffers) = NULL ;
+    if ( (*selfBuffers) != NULL )
+    {
+        if ( other == self ) (*otherBuffers) = (*selfBuffers) ;
+        else
+        {
+            (*otherBuffers) = Coordinates3_AllocateThreadBuffers ( other, NULL ) ;
+            if ( (*otherBuffers) == NULL ) { Memory_Deallocate ( (*selfBuffers) ) ; (*numberOfThreads) = 1 ; }
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocate zeroed per-thread accumulation buffers conforming to self (usually gradients).
+! . On entry numberOfThreads is ignored and on exit it holds the number of threads to use.
+! . NULL is returned if self is NULL, there is only one thread or the allocation fails. In the last case one thread is used.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Real *Coordinates3_AllocateThreadBuffers ( const Coordinates3 *self, Integer *numberOfThreads )
+{
+    Integer  n = 1 ;
+    Real    *buffers = NULL ;
+# ifdef USEOPENMP
+    n = omp_get_max_threads ( ) ;
+    if ( ( self != NULL ) && ( n > 1 ) )
+    {
+        buffers = Memory_AllocateArrayOfTypes ( n * 3 * Coordinates3_Rows ( self ), Real ) ;
+        if ( buffers == NULL ) n = 1 ;
+    }
+# endif
+    if ( numberOfThreads != NULL ) (*numberOfThreads) = n ;
+    return buffers ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . As Coordinates3_AllocateThreadBuffers except that one thread is used if the work, such as the number of terms in a loop,
+! . is too small to offset the cost of the threads and of zeroing and reducing the buffers.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Real *Coordinates3_AllocateThreadBuffersForWork ( const Coordinates3 *self, const Integer work, Integer *numberOfThreads )
+{
+    if ( (   work >= MinimumThreadedWork ) &&
+         ( ( self == NULL ) || ( MaximumThreadBufferRowsPerWork * work >= Coordinates3_Rows ( self ) ) ) )
+    {
+        return Coordinates3_AllocateThreadBuffers ( self, numberOfThreads ) ;
+    }
+    else
+    {
+        if ( numberOfThreads != NULL ) (*numberOfThreads) = 1 ;
+        return NULL ;
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Calculate an angle between three points.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -1290,6 +1361,51 @@ Real Coordinates3_RadiusOfGyration ( const Coordinates3 *self, const Selection *
     return rgyr ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Sum per-thread buffers allocated by Coordinates3_AllocatePairedThreadBuffers into self and other and deallocate them.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void Coordinates3_ReducePairedThreadBuffers (       Coordinates3  *self            ,
+                                                    Coordinates3  *other           ,
+                                              const Integer        numberOfThreads ,
+                                                    Real         **selfBuffers     ,
+                                                    Real         **otherBuffers    )
+{
+    if ( (*otherBuffers) != (*selfBuffers) ) Coordinates3_ReduceThreadBuffers ( other, numberOfThreads, otherBuffers ) ;
+    else (*otherBuffers) = NULL ;
+    Coordinates3_ReduceThreadBuffers ( self, numberOfThreads, selfBuffers ) ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Sum per-thread buffers into self and deallocate them.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+void Coordinates3_ReduceThreadBuffers ( Coordinates3 *self, const Integer numberOfThreads, Real **buffers )
+{
+    if ( ( buffers != NULL ) && ( (*buffers) != NULL ) )
+    {
+        if ( self != NULL )
+        {
+            auto Integer i, n, t ;
+            auto Real   *data = (*buffers), x, y, z ;
+            n = Coordinates3_Rows ( self ) ;
+# ifdef USEOPENMP
+            #pragma omp parallel for private ( t, x, y, z ) schedule ( static )
+# endif
+            for ( i = 0 ; i < n ; i++ )
+            {
+                x = y = z = 0.0e+00 ;
+                for ( t = 0 ; t < numberOfThreads ; t++ )
+                {
+                    x += data[3*(t*n+i)  ] ;
+                    y += data[3*(t*n+i)+1] ;
+                    z += data[3*(t*n+i)+2] ;
+                }
+                Coordinates3_IncrementRow ( self, i, x, y, z ) ;
+            }
+        }
+        Memory_Deallocate ( (*buffers) ) ;
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Calculate the root mean square deviation deviation between two data sets.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -1731,6 +1847,24 @@ void Coordinates3_Superimpose ( Coordinates3 *self, const Coordinates3 *other, c
     }
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Return the buffer of the calling thread as a view or self if there are no buffers.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Coordinates3 *Coordinates3_ThreadBuffer ( Coordinates3 *self, Real *buffers, Coordinates3 *view )
+{
+    if ( ( self != NULL ) && ( buffers != NULL ) && ( view != NULL ) )
+    {
+        auto Integer n, t = 0 ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        n = Coordinates3_Rows ( self ) ;
+        Coordinates3_ViewOfRaw ( view, 0, n, 3, 3, 1, &buffers[3*t*n] ) ;
+        return view ;
+    }
+    else return self ;
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Perform a principal axis transformation.
 ! . |selection| determines the calculation of the transformation but not which rows are transformed.
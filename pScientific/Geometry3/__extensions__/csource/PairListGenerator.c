@@ -6,6 +6,10 @@
 /*
 ! . The cell/cell generation method produces lists that are not sorted with respect to i.
 ! . Sorting with respect to j is optional although it can contribute substantially to the time.
+!
+! . Generation is threaded over blocks of cells or points. Each block is saved to its own pairlist and the blocks are then
+!   concatenated in order so that the final list is identical to that produced serially. Each thread has its own flags,
+!   indices and grid search workspace so that exclusions are handled exactly as in the serial case.
 */
 
 # include <math.h>
@@ -15,8 +19,32 @@
 # include "BooleanUtilities.h"
 # include "IntegerUtilities.h"
 # include "Memory.h"
+# include "NumericalMacros.h"
 # include "PairListGenerator.h"
 
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local definitions.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The number of blocks per thread for threaded generation. */
+# define _BlocksPerThread 8
+
+/* . The first item of a block. */
+# define BlockFirst( b, numberOfBlocks, extent ) ( (b) * ( (extent) / (numberOfBlocks) ) + Minimum ( (b), (extent) % (numberOfBlocks) ) )
+
+/* . Thread workspace. */
+/* . The grids are clones as the grid search procedures use their work arrays. */
+typedef struct {
+    Boolean                *isIncluded      ;
+    Integer                *indices         ;
+    RegularGrid            *grid1           ;
+    RegularGrid            *grid2           ;
+    RegularGridSearchRange *gridSearchRange ;
+} ThreadWork ;
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Self-pairlist generation macros.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -88,12 +116,6 @@
         pTotal     = Array1D_Item ( occupancy->cellTotalPoints          , c ) ; \
     }
 
-/* . Initialize isIncluded. */
-# define InitializeIsIncluded( numberOfPoints, QAND ) \
-    { \
-        for ( i = 0 ; i < numberOfPoints ; i++ ) isIncluded[i] = QAND[i] ; \
-    }
-
 /* . Non-self exclusions. */
 # define FlagNonSelfExclusions \
     { \
@@ -203,10 +225,18 @@
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Local declarations.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static void    AllocateTemporarySpace ( const Integer    numberOfPoints ,
-                                        Integer        **indices        ,
-                                        Boolean        **isIncluded     ,
-                                        Status          *status         ) ;
+static PairList  **AllocateBlockPairLists ( PairList         *pairList        ,
+                                            const Integer     extent          ,
+                                            const Integer     numberOfThreads ,
+                                            Integer          *numberOfBlocks  ) ;
+
+static ThreadWork *AllocateThreadWork ( const Integer      numberOfThreads ,
+                                        const Integer      numberOfPoints  ,
+                                        const Boolean     *QAND            ,
+                                        const RegularGrid *grid1           ,
+                                        const RegularGrid *grid2           ,
+                                        const Real         cutOff          ,
+                                              Status      *status          ) ;
 
 static Boolean CheckRadii             ( const Integer      numberOfPoints ,
                                         const RealArray1D *radii          ,
@@ -221,6 +251,9 @@ static void    CheckSelections        ( const Integer     numberOfPoints ,
                                         Boolean         **QOR            ,
                                         Status           *status         ) ;
 
+static void    DeallocateThreadWork   ( ThreadWork      **work            ,
+                                        const Integer     numberOfThreads ) ;
+
 static PairList *MakeCrossPairListFromCoordinates3 ( const PairListGenerator *self          ,
                                                      const Coordinates3      *coordinates31 ,
                                                      const Coordinates3      *coordinates32 ,
@@ -252,13 +285,11 @@ static Boolean MakeCrossPairListFromCoordinates3CellCell ( PairList *pairList, c
                                                                                const Boolean                *QOR1            ,
                                                                                const Boolean                *QOR2            ,
                                                                                const RegularGrid            *grid1           ,
-                                                                               const RegularGrid            *grid2           ,
                                                                                const RegularGridOccupancy   *occupancy1      ,
                                                                                const RegularGridOccupancy   *occupancy2      ,
                                                                                const IntegerArray1D         *offSet          ,
-                                                                                     RegularGridSearchRange *gridSearchRange ,
-                                                                                     Boolean                *isIncluded      ,
-                                                                                     Integer                *indices         ) ;
+                                                                               const Integer                 numberOfThreads ,
+                                                                                     ThreadWork             *work            ) ;
 
 static Boolean MakeCrossPairListFromCoordinates3Direct ( PairList *pairList, const Real             cutOff          ,
                                                                              const Coordinates3    *coordinates31   ,   
@@ -271,8 +302,8 @@ static Boolean MakeCrossPairListFromCoordinates3Direct ( PairList *pairList, con
                                                                              const Boolean         *QAND2           ,
                                                                              const Boolean         *QOR1            ,
                                                                              const Boolean         *QOR2            ,
-                                                                                   Boolean         *isIncluded      ,
-                                                                                   Integer         *indices         ) ;
+                                                                             const Integer          numberOfThreads ,
+                                                                                   ThreadWork      *work            ) ;
 
 static Boolean MakeCrossPairListFromCoordinates3PointCell ( PairList *pairList, const Boolean                 sortIndices     ,
                                                                                 const Real                    cutOff          ,
@@ -286,14 +317,11 @@ static Boolean MakeCrossPairListFromCoordinates3PointCell ( PairList *pairList,
                                                                                 const Boolean                *QAND2           ,
                                                                                 const Boolean                *QOR1            ,
                                                                                 const Boolean                *QOR2            ,
-                                                                                const RegularGrid            *grid1           ,
-                                                                                const RegularGrid            *grid2           ,
                                                                                 const RegularGridOccupancy   *occupancy1      ,
                                                                                 const RegularGridOccupancy   *occupancy2      ,
                                                                                 const IntegerArray1D         *offSet          ,
-                                                                                      RegularGridSearchRange *gridSearchRange ,
-                                                                                      Boolean                *isIncluded      ,
-                                                                                      Integer                *indices         ) ;
+                                                                                const Integer                 numberOfThreads ,
+                                                                                      ThreadWork             *work            ) ;
 
 static PairList *MakeSelfPairListFromCoordinates3 ( const PairListGenerator    *self         ,
                                                     const Coordinates3         *coordinates3 ,
@@ -314,18 +342,17 @@ static Boolean MakeSelfPairListFromCoordinates3CellCell ( PairList *pairList, co
                                                                               const Boolean                *QOR             ,
                                                                               const RegularGrid            *grid            ,
                                                                               const RegularGridOccupancy   *occupancy       ,
-                                                                                    RegularGridSearchRange *gridSearchRange ,
-                                                                                    Boolean                *isIncluded      ,
-                                                                                    Integer                *indices         ) ;
-
-static Boolean MakeSelfPairListFromCoordinates3Direct ( PairList *pairList, const Real             cutOff       ,
-                                                                            const Coordinates3    *coordinates3 ,
-                                                                            const RealArray1D     *radii        ,
-                                                                            const PairConnections *exclusions   ,
-                                                                            const Boolean         *QAND         ,
-                                                                            const Boolean         *QOR          ,
-                                                                                  Boolean         *isIncluded   ,
-                                                                                  Integer         *indices      ) ;
+                                                                              const Integer                 numberOfThreads ,
+                                                                                    ThreadWork             *work            ) ;
+
+static Boolean MakeSelfPairListFromCoordinates3Direct ( PairList *pairList, const Real             cutOff          ,
+                                                                            const Coordinates3    *coordinates3    ,
+                                                                            const RealArray1D     *radii           ,
+                                                                            const PairConnections *exclusions      ,
+                                                                            const Boolean         *QAND            ,
+                                                                            const Boolean         *QOR             ,
+                                                                            const Integer          numberOfThreads ,
+                                                                                  ThreadWork      *work            ) ;
 
 static Boolean MakeSelfPairListFromCoordinates3PointCell ( PairList *pairList, const Boolean                 sortIndices     ,
                                                                                const Real                    cutOff          ,
@@ -334,11 +361,14 @@ static Boolean MakeSelfPairListFromCoordinates3PointCell ( PairList *pairList, c
                                                                                const PairConnections        *exclusions      ,
                                                                                const Boolean                *QAND            ,
                                                                                const Boolean                *QOR             ,
-                                                                               const RegularGrid            *grid            ,
                                                                                const RegularGridOccupancy   *occupancy       ,
-                                                                                     RegularGridSearchRange *gridSearchRange ,
-                                                                                     Boolean                *isIncluded      ,
-                                                                                     Integer                *indices         ) ;
+                                                                               const Integer                 numberOfThreads ,
+                                                                                     ThreadWork             *work            ) ;
+
+static Boolean MergeBlockPairLists    (       PairList  *pairList        ,
+                                        const Integer    numberOfBlocks  ,
+                                              PairList **blocks          ,
+                                        const Integer    numberOfThreads ) ;
 
 static Boolean SaveInteractions (       PairList *pairList    , 
                                   const Integer   i           , 
@@ -634,15 +664,72 @@ PairList *PairListGenerator_SelfPairListFromCoordinates3 ( const PairListGenerat
 ! . Local procedures.
 !=================================================================================================================================*/
 /*----------------------------------------------------------------------------------------------------------------------------------
-! . Allocate some temporary space.
+! . Allocate the pairlists for the blocks of a threaded generation.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . Null is returned if there is a single block, in which case the pairlist is filled directly. */
+static PairList **AllocateBlockPairLists ( PairList         *pairList        ,
+                                           const Integer     extent          ,
+                                           const Integer     numberOfThreads ,
+                                           Integer          *numberOfBlocks  )
+{
+    Integer    n ;
+    PairList **blocks = NULL ;
+    n = Minimum ( extent, numberOfThreads * _BlocksPerThread ) ;
+    if ( ( numberOfThreads > 1 ) && ( n > 1 ) )
+    {
+        blocks = Memory_AllocateArrayOfReferences ( n, PairList ) ;
+        if ( blocks != NULL )
+        {
+            auto Integer b, capacity ;
+            auto Status  localStatus = Status_OK ;
+            capacity = pairList->capacity / n + 1 ;
+            for ( b = 0 ; b < n ; b++ ) blocks[b] = PairList_Allocate ( capacity, &localStatus ) ;
+            if ( localStatus != Status_OK )
+            {
+                for ( b = 0 ; b < n ; b++ ) PairList_Deallocate ( &(blocks[b]) ) ;
+                Memory_Deallocate ( blocks ) ;
+            }
+        }
+    }
+    if ( blocks == NULL ) n = 1 ;
+    (*numberOfBlocks) = n ;
+    return blocks ;
+}
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Allocate the thread workspace.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static void AllocateTemporarySpace ( const Integer    numberOfPoints ,
-                                           Integer  **indices        ,
-                                           Boolean  **isIncluded     ,
-                                           Status    *status         )
+/* . The grids are optional and are only needed for grid searches. */
+static ThreadWork *AllocateThreadWork ( const Integer      numberOfThreads ,
+                                        const Integer      numberOfPoints  ,
+                                        const Boolean     *QAND            ,
+                                        const RegularGrid *grid1           ,
+                                        const RegularGrid *grid2           ,
+                                        const Real         cutOff          ,
+                                              Status      *status          )
 {
-    (*indices   ) = Integer_Allocate ( numberOfPoints, NULL ) ;
-    (*isIncluded) = Boolean_Allocate  ( numberOfPoints, NULL ) ;
+    ThreadWork *work = NULL ;
+    if ( Status_IsOK ( status ) )
+    {
+        work = Memory_AllocateArrayOfTypes ( numberOfThreads, ThreadWork ) ;
+        if ( work != NULL )
+        {
+            auto Integer t ;
+            auto Status  localStatus = Status_OK ;
+            for ( t = 0 ; t < numberOfThreads ; t++ )
+            {
+                work[t].indices         = Integer_Allocate  ( numberOfPoints, &localStatus ) ;
+                work[t].isIncluded      = Boolean_Allocate  ( numberOfPoints, &localStatus ) ;
+                work[t].grid1           = RegularGrid_Clone ( grid1, &localStatus ) ;
+                work[t].grid2           = RegularGrid_Clone ( grid2, &localStatus ) ;
+                work[t].gridSearchRange = RegularGrid_MakeSearchRange ( work[t].grid1, cutOff, &localStatus ) ;
+                Boolean_CopyTo ( QAND, numberOfPoints, work[t].isIncluded, NULL ) ;
+            }
+            if ( localStatus != Status_OK ) DeallocateThreadWork ( &work, numberOfThreads ) ;
+        }
+        if ( work == NULL ) Status_Set ( status, Status_OutOfMemory ) ;
+    }
+    return work ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -705,6 +792,26 @@ static void CheckSelections ( const Integer     numberOfPoints ,
     if ( ( (*QAND) == NULL ) || ( (*QOR) == NULL ) ) Status_Set ( status, Status_OutOfMemory ) ;
 }
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Deallocate the thread workspace.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void DeallocateThreadWork ( ThreadWork **work, const Integer numberOfThreads )
+{
+    if ( (*work) != NULL )
+    {
+        auto Integer t ;
+        for ( t = 0 ; t < numberOfThreads ; t++ )
+        {
+            Memory_Deallocate                 (   (*work)[t].indices          ) ;
+            Memory_Deallocate                 (   (*work)[t].isIncluded       ) ;
+            RegularGrid_Deallocate            ( &((*work)[t].grid1          ) ) ;
+            RegularGrid_Deallocate            ( &((*work)[t].grid2          ) ) ;
+            RegularGridSearchRange_Deallocate ( &((*work)[t].gridSearchRange) ) ;
+        }
+        Memory_Deallocate ( (*work) ) ;
+    }
+}
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Create a cross-pairlist from two sets of coordinates3.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -729,16 +836,18 @@ static PairList *MakeCrossPairListFromCoordinates3 ( const PairListGenerator
     PairList *pairList = NULL ;
     if ( ( self != NULL ) && ( coordinates31 != NULL ) && ( coordinates32 != NULL ) )
     {
-        auto Boolean   emptyList, isOK, useGridSearch ;
-        auto Integer   numberOfPoints1, numberOfPoints2 ;
-        auto Real      maximumCutOff, maximumRadius1, maximumRadius2, minimumRadius1, minimumRadius2 ;
-        auto Status    localStatus ;
-        auto Boolean  *QAND1 = NULL, *QAND2 = NULL, *isIncluded = NULL, *QOR1 = NULL, *QOR2 = NULL ;
-        auto Integer  *indices = NULL ;
-        auto RegularGridSearchRange *gridSearchRange = NULL ;
+        auto Boolean     emptyList, isOK, useGridSearch ;
+        auto Integer     numberOfPoints1, numberOfPoints2, numberOfThreads = 1 ;
+        auto Real        maximumCutOff, maximumRadius1, maximumRadius2, minimumRadius1, minimumRadius2 ;
+        auto Status      localStatus ;
+        auto Boolean    *QAND1 = NULL, *QAND2 = NULL, *QOR1 = NULL, *QOR2 = NULL ;
+        auto ThreadWork *work = NULL ;
 
         /* . Initialization. */
         localStatus = Status_OK ;
+# ifdef USEOPENMP
+        numberOfThreads = omp_get_max_threads ( ) ;
+# endif
 
         /* . Get the dimensions of the problem. */
         numberOfPoints1 = coordinates31->extent0 ;
@@ -757,11 +866,11 @@ static PairList *MakeCrossPairListFromCoordinates3 ( const PairListGenerator
         /* . Set up for a grid search. */
         /* . Possible to use something else here appropriate for conforming grids? */
         useGridSearch = ( grid1 != NULL ) && ( grid2 != NULL ) && ( occupancy1 != NULL ) && ( occupancy2 != NULL ) && ( offSet != NULL ) ;
-        if ( useGridSearch ) gridSearchRange = RegularGrid_MakeSearchRange ( grid1, maximumCutOff, &localStatus ) ;
 
-        /* . Create the pairlist and allocate some temporary space. */
+        /* . Create the pairlist and allocate the thread workspace. */
         pairList = PairList_Allocate ( numberOfPoints1, &localStatus ) ;
-        AllocateTemporarySpace ( numberOfPoints2, &indices, &isIncluded, &localStatus ) ;
+        if ( useGridSearch ) work = AllocateThreadWork ( numberOfThreads, numberOfPoints2, QAND2, grid1, grid2, maximumCutOff, &localStatus ) ;
+        else                 work = AllocateThreadWork ( numberOfThreads, numberOfPoints2, QAND2, NULL , NULL , maximumCutOff, &localStatus ) ;
 
         /* . Check for a memory error. */
         isOK = ( pairList != NULL ) && ( localStatus == Status_OK ) ;
@@ -784,13 +893,11 @@ static PairList *MakeCrossPairListFromCoordinates3 ( const PairListGenerator
                                                                                                QOR1              ,
                                                                                                QOR2              ,
                                                                                                grid1             ,
-                                                                                               grid2             ,
                                                                                                occupancy1        ,
                                                                                                occupancy2        ,
                                                                                                offSet            ,
-                                                                                               gridSearchRange   ,
-                                                                                               isIncluded        ,
-                                                                                               indices           ) ;
+                                                                                               numberOfThreads   ,
+                                                                                               work              ) ;
                 else                       isOK = MakeCrossPairListFromCoordinates3PointCell ( pairList          ,
                                                                                                self->sortIndices ,
                                                                                                self->cutOff      ,
@@ -804,14 +911,11 @@ static PairList *MakeCrossPairListFromCoordinates3 ( const PairListGenerator
                                                                                                QAND2             ,
                                                                                                QOR1              ,
                                                                                                QOR2              ,
-                                                                                               grid1             ,
-                                                                                               grid2             ,
                                                                                                occupancy1        ,
                                                                                                occupancy2        ,
                                                                                                offSet            ,
-                                                                                               gridSearchRange   ,
-                                                                                               isIncluded        ,
-                                                                                               indices           ) ;
+                                                                                               numberOfThreads   ,
+                                                                                               work              ) ;
             }
             else                           isOK = MakeCrossPairListFromCoordinates3Direct    ( pairList          ,
                                                                                                self->cutOff      ,
@@ -825,18 +929,16 @@ static PairList *MakeCrossPairListFromCoordinates3 ( const PairListGenerator
                                                                                                QAND2             ,
                                                                                                QOR1              ,
                                                                                                QOR2              ,
-                                                                                               isIncluded        ,
-                                                                                               indices           ) ;
+                                                                                               numberOfThreads   ,
+                                                                                               work              ) ;
         }
 
         /* . Finish up. */
-        Memory_Deallocate ( isIncluded ) ;
-        Memory_Deallocate ( indices    ) ;
+        DeallocateThreadWork ( &work, numberOfThreads ) ;
         if ( andSelection1 == NULL ) Memory_Deallocate ( QAND1 ) ;
         if ( andSelection2 == NULL ) Memory_Deallocate ( QAND2 ) ;
         if ( orSelection1  == NULL ) Memory_Deallocate ( QOR1  ) ;
         if ( orSelection2  == NULL ) Memory_Deallocate ( QOR2  ) ;
-        RegularGridSearchRange_Deallocate ( &gridSearchRange ) ;
         if ( ! isOK ) PairList_Deallocate ( &pairList ) ;
         Status_Set ( status, localStatus ) ;
     }
@@ -859,146 +961,210 @@ static Boolean MakeCrossPairListFromCoordinates3CellCell ( PairList *pairList, c
                                                                                const Boolean                *QOR1            ,
                                                                                const Boolean                *QOR2            ,
                                                                                const RegularGrid            *grid1           ,
-                                                                               const RegularGrid            *grid2           ,
                                                                                const RegularGridOccupancy   *occupancy1      ,
                                                                                const RegularGridOccupancy   *occupancy2      ,
                                                                                const IntegerArray1D         *offSet          ,
-                                                                                     RegularGridSearchRange *gridSearchRange ,
-                                                                                     Boolean                *isIncluded      ,
-                                                                                     Integer                *indices         )
+                                                                               const Integer                 numberOfThreads ,
+                                                                                     ThreadWork             *work            )
 {
-    Boolean  hasExclusions, hasRadii1, hasRadii2, includeAll, isOK = True, QORI ;
-    Integer  c1, c2, i, j, m2, n, numberOfCells, numberOfPoints2, p1, p1Start, p1Total, p2, p2Start, p2Total, x, xFirst = 0, xLast = 0 ;
-    Real     cutOffSquared, dx, dy, dz, ri, rij, xi, xj, yi, yj, zi, zj ;
+    Boolean    hasExclusions, hasRadii1, hasRadii2, isOK ;
+    Integer    b, numberOfBlocks, numberOfErrors = 0, numberOfGridPoints ;
+    PairList **blocks ;
 
     /* . Initialization. */
-    cutOffSquared   = cutOff * cutOff ;
-    hasExclusions   = ( exclusions != NULL ) ;
-    hasRadii1       = ( radii1     != NULL ) ;
-    hasRadii2       = ( radii2     != NULL ) ;
-    numberOfPoints2 = coordinates32->extent0 ;
-    InitializeIsIncluded ( numberOfPoints2, QAND2 ) ;
-
-    /* . Outer loop over occupied cells in grid. */
-    for ( c1 = 0 ; c1 < RegularGrid_NumberOfGridPoints ( grid1 ); c1++ )
+    hasExclusions      = ( exclusions != NULL ) ;
+    hasRadii1          = ( radii1     != NULL ) ;
+    hasRadii2          = ( radii2     != NULL ) ;
+    numberOfGridPoints = RegularGrid_NumberOfGridPoints ( grid1 ) ;
+    blocks             = AllocateBlockPairLists ( pairList, numberOfGridPoints, numberOfThreads, &numberOfBlocks ) ;
+
+    /* . Loop over blocks of cells in grid. */
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : numberOfErrors )
+# endif
     {
-        /* . Set some information for the cell. */
-        p1Start = Array1D_Item ( occupancy1->cellFirstPoints, c1 ) ;
-        p1Total = Array1D_Item ( occupancy1->cellTotalPoints, c1 ) ;
-
-        /* . Find all conforming cells that are within the cutOff of the current cell. */
-        numberOfCells = RegularGrid_FindConformingCellsWithinRangeOfCell ( grid1, c1, grid2, offSet, gridSearchRange, NULL ) ;
-
-        /* . Outer loop over indices. */
-        for ( p1 = 0 ; p1 < p1Total ; p1++ )
+        auto Boolean                 includeAll, isBlockOK, QORI ;
+        auto Boolean                *isIncluded ;
+        auto Integer                 c1, c1Last, c2, i, j, m2, n, numberOfCells, p1, p1Start, p1Total, p2, p2Start, p2Total, t = 0, x, xFirst = 0, xLast = 0 ;
+        auto Integer                *indices ;
+        auto Real                    cutOffSquared, dx, dy, dz, ri, rij, xi, xj, yi, yj, zi, zj ;
+        auto PairList               *blockList ;
+        auto RegularGridSearchRange *gridSearchRange ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        cutOffSquared   = cutOff * cutOff ;
+        gridSearchRange = work[t].gridSearchRange ;
+        indices         = work[t].indices ;
+        isIncluded      = work[t].isIncluded ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < numberOfBlocks ; b++ )
         {
-            /* . Get the point index. */
-            i = Array1D_Item ( occupancy1->cellPoints, p1+p1Start ) ;
+            blockList = ( blocks == NULL ) ? pairList : blocks[b] ;
+            c1Last    = BlockFirst ( b+1, numberOfBlocks, numberOfGridPoints ) ;
+            isBlockOK = True ;
 
-            /* . AND test. */
-            if ( QAND1[i] )
+            /* . Outer loop over occupied cells in the block. */
+            for ( c1 = BlockFirst ( b, numberOfBlocks, numberOfGridPoints ) ; c1 < c1Last ; c1++ )
             {
-                /* . Get some information for the point. */
-                Coordinates3_GetRow ( coordinates31, i, xi, yi, zi ) ;
-                QORI = QOR1[i] ;
-
-                /* . Flag excluded points for i. */
-                if ( hasExclusions ) FlagNonSelfExclusions ;
-                if ( excludeSelf && QAND2[i] ) isIncluded[i] = False ;
+                /* . Set some information for the cell. */
+                p1Start = Array1D_Item ( occupancy1->cellFirstPoints, c1 ) ;
+                p1Total = Array1D_Item ( occupancy1->cellTotalPoints, c1 ) ;
+                if ( p1Total <= 0 ) continue ;
 
-                /* . Set the cutOff. */
-                ri = cutOff ;
-                if ( hasRadii1 ) ri += Array1D_Item ( radii1, i ) ;
+                /* . Find all conforming cells that are within the cutOff of the current cell. */
+                numberOfCells = RegularGrid_FindConformingCellsWithinRangeOfCell ( work[t].grid1, c1, work[t].grid2, offSet, gridSearchRange, NULL ) ;
 
-                /* . Loop over cells. */
-                for ( m2 = n = 0 ; m2 < numberOfCells ; m2++ )
+                /* . Outer loop over indices. */
+                for ( p1 = 0 ; p1 < p1Total ; p1++ )
                 {
-                    /* . Set some information for the cell. */
-                    GetCellInformation ( m2, occupancy2, c2, includeAll, p2Start, p2Total ) ;
-
-                    /* . Generate interactions. */
-                         if ( hasRadii2  ) { for ( p2 = 0 ; p2 < p2Total ; p2++ ) { CheckForGridCrossInteractionWithRadii   ( p2, p2Start ) ; } }
-                    else if ( includeAll ) { for ( p2 = 0 ; p2 < p2Total ; p2++ ) { IncludeAllCellCrossInteractions         ( p2, p2Start ) ; } }
-                    else                   { cutOffSquared = ri * ri ;
-                                             for ( p2 = 0 ; p2 < p2Total ; p2++ ) { CheckForGridCrossInteractionWithNoRadii ( p2, p2Start ) ; } }
+                    /* . Get the point index. */
+                    i = Array1D_Item ( occupancy1->cellPoints, p1+p1Start ) ;
+
+                    /* . AND test. */
+                    if ( QAND1[i] )
+                    {
+                        /* . Get some information for the point. */
+                        Coordinates3_GetRow ( coordinates31, i, xi, yi, zi ) ;
+                        QORI = QOR1[i] ;
+
+                        /* . Flag excluded points for i. */
+                        if ( hasExclusions ) FlagNonSelfExclusions ;
+                        if ( excludeSelf && QAND2[i] ) isIncluded[i] = False ;
+
+                        /* . Set the cutOff. */
+                        ri = cutOff ;
+                        if ( hasRadii1 ) ri += Array1D_Item ( radii1, i ) ;
+
+                        /* . Loop over cells. */
+                        for ( m2 = n = 0 ; m2 < numberOfCells ; m2++ )
+                        {
+                            /* . Set some information for the cell. */
+                            GetCellInformation ( m2, occupancy2, c2, includeAll, p2Start, p2Total ) ;
+
+                            /* . Generate interactions. */
+                                 if ( hasRadii2  ) { for ( p2 = 0 ; p2 < p2Total ; p2++ ) { CheckForGridCrossInteractionWithRadii   ( p2, p2Start ) ; } }
+                            else if ( includeAll ) { for ( p2 = 0 ; p2 < p2Total ; p2++ ) { IncludeAllCellCrossInteractions         ( p2, p2Start ) ; } }
+                            else                   { cutOffSquared = ri * ri ;
+                                                     for ( p2 = 0 ; p2 < p2Total ; p2++ ) { CheckForGridCrossInteractionWithNoRadii ( p2, p2Start ) ; } }
+                        }
+
+                        /* . Save the interactions. */
+                        isBlockOK = SaveInteractions ( blockList, i, n, indices, sortIndices ) ;
+                        if ( ! isBlockOK ) break ;
+
+                        /* . Unflag excluded points for i. */
+                        if ( hasExclusions ) UnflagNonSelfExclusions ( QAND2 ) ;
+                        if ( excludeSelf && QAND2[i] ) isIncluded[i] = True ;
+                    }
                 }
-
-                /* . Save the interactions. */
-                isOK = SaveInteractions ( pairList, i, n, indices, sortIndices ) ;
-                if ( ! isOK ) break ;
-
-                /* . Unflag excluded points for i. */
-                if ( hasExclusions ) UnflagNonSelfExclusions ( QAND2 ) ;
-                if ( excludeSelf && QAND2[i] ) isIncluded[i] = True ;
+                if ( ! isBlockOK ) break ;
             }
+            if ( ! isBlockOK ) numberOfErrors += 1 ;
         }
     }
-    return isOK ;
+
+    /* . Finish up. */
+    isOK = MergeBlockPairLists ( pairList, numberOfBlocks, blocks, numberOfThreads ) ;
+    return ( isOK && ( numberOfErrors == 0 ) ) ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Cross-pairlist generation using a direct method.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static Boolean MakeCrossPairListFromCoordinates3Direct ( PairList *pairList, const Real             cutOff        ,
-                                                                             const Coordinates3    *coordinates31 ,   
-                                                                             const Coordinates3    *coordinates32 ,
-                                                                             const RealArray1D     *radii1        ,
-                                                                             const RealArray1D     *radii2        ,
-                                                                             const PairConnections *exclusions    ,
-                                                                             const Boolean          excludeSelf   , 
-                                                                             const Boolean         *QAND1         , 
-                                                                             const Boolean         *QAND2         , 
-                                                                             const Boolean         *QOR1          , 
-                                                                             const Boolean         *QOR2          , 
-                                                                                   Boolean         *isIncluded    , 
-                                                                                   Integer         *indices       ) 
+static Boolean MakeCrossPairListFromCoordinates3Direct ( PairList *pairList, const Real             cutOff          ,
+                                                                             const Coordinates3    *coordinates31   ,   
+                                                                             const Coordinates3    *coordinates32   ,
+                                                                             const RealArray1D     *radii1          ,
+                                                                             const RealArray1D     *radii2          ,
+                                                                             const PairConnections *exclusions      ,
+                                                                             const Boolean          excludeSelf     , 
+                                                                             const Boolean         *QAND1           , 
+                                                                             const Boolean         *QAND2           , 
+                                                                             const Boolean         *QOR1            , 
+                                                                             const Boolean         *QOR2            , 
+                                                                             const Integer          numberOfThreads ,
+                                                                                   ThreadWork      *work            ) 
 {
-    Boolean  hasExclusions, hasRadii1, hasRadii2, isOK = True, QORI ;
-    Integer  i, j, n, numberOfPoints1, numberOfPoints2, x, xFirst = 0, xLast = 0 ;
-    Real     cutOffSquared, dx, dy, dz, ri, rij, xi, xj, yi, yj, zi, zj ;
+    Boolean    hasExclusions, hasRadii1, hasRadii2, isOK ;
+    Integer    b, numberOfBlocks, numberOfErrors = 0, numberOfPoints1, numberOfPoints2 ;
+    PairList **blocks ;
 
     /* . Initialization. */
-    cutOffSquared   = cutOff * cutOff ;
     hasExclusions   = ( exclusions != NULL ) ;
     hasRadii1       = ( radii1     != NULL ) ;
     hasRadii2       = ( radii2     != NULL ) ;
     numberOfPoints1 = coordinates31->extent0 ;
     numberOfPoints2 = coordinates32->extent0 ;
-    InitializeIsIncluded ( numberOfPoints2, QAND2 ) ;
+    blocks          = AllocateBlockPairLists ( pairList, numberOfPoints1, numberOfThreads, &numberOfBlocks ) ;
 
-    /* . Outer loop over indices. */
-    for ( i = 0 ; i < numberOfPoints1 ; i++ )
+    /* . Loop over blocks of indices. */
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : numberOfErrors )
+# endif
     {
-        /* . AND test. */
-        if ( QAND1[i] )
+        auto Boolean   isBlockOK, QORI ;
+        auto Boolean  *isIncluded ;
+        auto Integer   i, iLast, j, n, t = 0, x, xFirst = 0, xLast = 0 ;
+        auto Integer  *indices ;
+        auto Real      cutOffSquared, dx, dy, dz, ri, rij, xi, xj, yi, yj, zi, zj ;
+        auto PairList *blockList ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        cutOffSquared = cutOff * cutOff ;
+        indices       = work[t].indices ;
+        isIncluded    = work[t].isIncluded ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < numberOfBlocks ; b++ )
         {
-            /* . Get some information for the point. */
-            Coordinates3_GetRow ( coordinates31, i, xi, yi, zi ) ;
-            QORI = QOR1[i] ;
-
-            /* . Flag excluded points for i. */
-            if ( hasExclusions ) FlagNonSelfExclusions ;
-            if ( excludeSelf && QAND2[i] ) isIncluded[i] = False ;
-
-            /* . Set the cutOff. */
-            ri = cutOff ;
-            if ( hasRadii1 ) ri += Array1D_Item ( radii1, i ) ;
-
-            /* . Generate interactions. */
-            if ( hasRadii2 ) { for ( j = n = 0 ; j < numberOfPoints2 ; j++ ) { CheckForDirectCrossInteractionWithRadii   ; } }
-            else             { cutOffSquared = ri * ri ;
-                               for ( j = n = 0 ; j < numberOfPoints2 ; j++ ) { CheckForDirectCrossInteractionWithNoRadii ; } }
-
-            /* . Save the interactions. */
-            isOK = SaveInteractions ( pairList, i, n, indices, False ) ;
-            if ( ! isOK ) break ;
-
-            /* . Unflag excluded points for i. */
-            if ( hasExclusions ) UnflagNonSelfExclusions ( QAND2 ) ;
-            if ( excludeSelf && QAND2[i] ) isIncluded[i] = True ;
+            blockList = ( blocks == NULL ) ? pairList : blocks[b] ;
+            iLast     = BlockFirst ( b+1, numberOfBlocks, numberOfPoints1 ) ;
+            isBlockOK = True ;
+
+            /* . Outer loop over indices. */
+            for ( i = BlockFirst ( b, numberOfBlocks, numberOfPoints1 ) ; i < iLast ; i++ )
+            {
+                /* . AND test. */
+                if ( QAND1[i] )
+                {
+                    /* . Get some information for the point. */
+                    Coordinates3_GetRow ( coordinates31, i, xi, yi, zi ) ;
+                    QORI = QOR1[i] ;
+
+                    /* . Flag excluded points for i. */
+                    if ( hasExclusions ) FlagNonSelfExclusions ;
+                    if ( excludeSelf && QAND2[i] ) isIncluded[i] = False ;
+
+                    /* . Set the cutOff. */
+                    ri = cutOff ;
+                    if ( hasRadii1 ) ri += Array1D_Item ( radii1, i ) ;
+
+                    /* . Generate interactions. */
+                    if ( hasRadii2 ) { for ( j = n = 0 ; j < numberOfPoints2 ; j++ ) { CheckForDirectCrossInteractionWithRadii   ; } }
+                    else             { cutOffSquared = ri * ri ;
+                                       for ( j = n = 0 ; j < numberOfPoints2 ; j++ ) { CheckForDirectCrossInteractionWithNoRadii ; } }
+
+                    /* . Save the interactions. */
+                    isBlockOK = SaveInteractions ( blockList, i, n, indices, False ) ;
+                    if ( ! isBlockOK ) break ;
+
+                    /* . Unflag excluded points for i. */
+                    if ( hasExclusions ) UnflagNonSelfExclusions ( QAND2 ) ;
+                    if ( excludeSelf && QAND2[i] ) isIncluded[i] = True ;
+                }
+            }
+            if ( ! isBlockOK ) numberOfErrors += 1 ;
         }
     }
-    return isOK ;
+
+    /* . Finish up. */
+    isOK = MergeBlockPairLists ( pairList, numberOfBlocks, blocks, numberOfThreads ) ;
+    return ( isOK && ( numberOfErrors == 0 ) ) ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -1016,74 +1182,103 @@ static Boolean MakeCrossPairListFromCoordinates3PointCell ( PairList *pairList,
                                                                                 const Boolean                *QAND2           ,
                                                                                 const Boolean                *QOR1            ,
                                                                                 const Boolean                *QOR2            ,
-                                                                                const RegularGrid            *grid1           ,
-                                                                                const RegularGrid            *grid2           ,
                                                                                 const RegularGridOccupancy   *occupancy1      ,
                                                                                 const RegularGridOccupancy   *occupancy2      ,
                                                                                 const IntegerArray1D         *offSet          ,
-                                                                                      RegularGridSearchRange *gridSearchRange ,
-                                                                                      Boolean                *isIncluded      ,
-                                                                                      Integer                *indices         )
+                                                                                const Integer                 numberOfThreads ,
+                                                                                      ThreadWork             *work            )
 {
-    Boolean  hasExclusions, hasRadii1, hasRadii2, includeAll, isOK = True, QORI ;
-    Integer  c, i, j, m, n, numberOfCells, numberOfPoints1, numberOfPoints2, p, pStart, pTotal, x, xFirst = 0, xLast = 0 ;
-    Real     cutOffSquared, dx, dy, dz, ri, rij, xi, xj, yi, yj, zi, zj ;
+    Boolean    hasExclusions, hasRadii1, hasRadii2, isOK ;
+    Integer    b, numberOfBlocks, numberOfErrors = 0, numberOfPoints1 ;
+    PairList **blocks ;
 
     /* . Initialization. */
-    cutOffSquared   = cutOff * cutOff ;
     hasExclusions   = ( exclusions != NULL ) ;
     hasRadii1       = ( radii1     != NULL ) ;
     hasRadii2       = ( radii2     != NULL ) ;
     numberOfPoints1 = coordinates31->extent0 ;
-    numberOfPoints2 = coordinates32->extent0 ;
-    InitializeIsIncluded ( numberOfPoints2, QAND2 ) ;
+    blocks          = AllocateBlockPairLists ( pairList, numberOfPoints1, numberOfThreads, &numberOfBlocks ) ;
 
-    /* . Outer loop over indices. */
-    for ( i = 0 ; i < numberOfPoints1 ; i++ )
+    /* . Loop over blocks of indices. */
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : numberOfErrors )
+# endif
     {
-        /* . AND test. */
-        if ( QAND1[i] )
+        auto Boolean                 includeAll, isBlockOK, QORI ;
+        auto Boolean                *isIncluded ;
+        auto Integer                 c, i, iLast, j, m, n, numberOfCells, p, pStart, pTotal, t = 0, x, xFirst = 0, xLast = 0 ;
+        auto Integer                *indices ;
+        auto Real                    cutOffSquared, dx, dy, dz, ri, rij, xi, xj, yi, yj, zi, zj ;
+        auto PairList               *blockList ;
+        auto RegularGridSearchRange *gridSearchRange ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        cutOffSquared   = cutOff * cutOff ;
+        gridSearchRange = work[t].gridSearchRange ;
+        indices         = work[t].indices ;
+        isIncluded      = work[t].isIncluded ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < numberOfBlocks ; b++ )
         {
-            /* . Get some information for the point. */
-            Coordinates3_GetRow ( coordinates31, i, xi, yi, zi ) ;
-            QORI = QOR1[i] ;
-
-            /* . Flag excluded points for i. */
-            if ( hasExclusions ) FlagNonSelfExclusions ;
-            if ( excludeSelf && QAND2[i] ) isIncluded[i] = False ;
-
-            /* . Set the cutOff. */
-            ri = cutOff ;
-            if ( hasRadii1 ) ri += Array1D_Item ( radii1, i ) ;
-
-            /* . Find all cells that are within the cutOff of the current point. */
-            numberOfCells = RegularGrid_FindConformingCellsWithinRangeOfPoint ( grid1, Array1D_Item ( occupancy1->pointCells, i ) ,
-                                                                                            Coordinates3_RowPointer ( coordinates31, i ) ,
-                                                                                                  grid2, offSet, gridSearchRange, NULL ) ;
+            blockList = ( blocks == NULL ) ? pairList : blocks[b] ;
+            iLast     = BlockFirst ( b+1, numberOfBlocks, numberOfPoints1 ) ;
+            isBlockOK = True ;
 
-            /* . Loop over cells. */
-            for ( m = n = 0 ; m < numberOfCells ; m++ )
+            /* . Outer loop over indices. */
+            for ( i = BlockFirst ( b, numberOfBlocks, numberOfPoints1 ) ; i < iLast ; i++ )
             {
-                /* . Set some information for the cell. */
-                GetCellInformation ( m, occupancy2, c, includeAll, pStart, pTotal ) ;
-
-                /* . Generate interactions. */
-                     if ( hasRadii2  ) { for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridCrossInteractionWithRadii   ( p, pStart ) ; } }
-                else if ( includeAll ) { for ( p = 0 ; p < pTotal ; p++ ) { IncludeAllCellCrossInteractions         ( p, pStart ) ; } }
-                else                   { cutOffSquared = ri * ri ;
-                                         for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridCrossInteractionWithNoRadii ( p, pStart ) ; } }
+                /* . AND test. */
+                if ( QAND1[i] )
+                {
+                    /* . Get some information for the point. */
+                    Coordinates3_GetRow ( coordinates31, i, xi, yi, zi ) ;
+                    QORI = QOR1[i] ;
+
+                    /* . Flag excluded points for i. */
+                    if ( hasExclusions ) FlagNonSelfExclusions ;
+                    if ( excludeSelf && QAND2[i] ) isIncluded[i] = False ;
+
+                    /* . Set the cutOff. */
+                    ri = cutOff ;
+                    if ( hasRadii1 ) ri += Array1D_Item ( radii1, i ) ;
+
+                    /* . Find all cells that are within the cutOff of the current point. */
+                    numberOfCells = RegularGrid_FindConformingCellsWithinRangeOfPoint ( work[t].grid1, Array1D_Item ( occupancy1->pointCells, i ) ,
+                                                                                                       Coordinates3_RowPointer ( coordinates31, i ) ,
+                                                                                        work[t].grid2, offSet, gridSearchRange, NULL ) ;
+
+                    /* . Loop over cells. */
+                    for ( m = n = 0 ; m < numberOfCells ; m++ )
+                    {
+                        /* . Set some information for the cell. */
+                        GetCellInformation ( m, occupancy2, c, includeAll, pStart, pTotal ) ;
+
+                        /* . Generate interactions. */
+                             if ( hasRadii2  ) { for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridCrossInteractionWithRadii   ( p, pStart ) ; } }
+                        else if ( includeAll ) { for ( p = 0 ; p < pTotal ; p++ ) { IncludeAllCellCrossInteractions         ( p, pStart ) ; } }
+                        else                   { cutOffSquared = ri * ri ;
+                                                 for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridCrossInteractionWithNoRadii ( p, pStart ) ; } }
+                    }
+
+                    /* . Save the interactions. */
+                    isBlockOK = SaveInteractions ( blockList, i, n, indices, sortIndices ) ;
+                    if ( ! isBlockOK ) break ;
+
+                    /* . Unflag excluded points for i. */
+                    if ( hasExclusions ) UnflagNonSelfExclusions ( QAND2 ) ;
+                    if ( excludeSelf && QAND2[i] ) isIncluded[i] = True ;
+                }
             }
-
-            /* . Save the interactions. */
-            isOK = SaveInteractions ( pairList, i, n, indices, sortIndices ) ;
-            if ( ! isOK ) break ;
-
-            /* . Unflag excluded points for i. */
-            if ( hasExclusions ) UnflagNonSelfExclusions ( QAND2 ) ;
-            if ( excludeSelf && QAND2[i] ) isIncluded[i] = True ;
+            if ( ! isBlockOK ) numberOfErrors += 1 ;
         }
     }
-    return isOK ;
+
+    /* . Finish up. */
+    isOK = MergeBlockPairLists ( pairList, numberOfBlocks, blocks, numberOfThreads ) ;
+    return ( isOK && ( numberOfErrors == 0 ) ) ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -1102,16 +1297,18 @@ static PairList *MakeSelfPairListFromCoordinates3 ( const PairListGenerator    *
     PairList *pairList = NULL ;
     if ( ( self != NULL ) && ( coordinates3 != NULL ) && Status_IsOK ( status ) )
     {
-        auto Boolean   emptyList, isOK, useGridSearch ;
-        auto Integer   numberOfPoints ;
-        auto Real      maximumCutOff, maximumRadius, minimumRadius ;
-        auto Status    localStatus ;
-        auto Boolean  *QAND = NULL, *isIncluded = NULL, *QOR = NULL ;
-        auto Integer  *indices = NULL ;
-        auto RegularGridSearchRange *gridSearchRange = NULL ;
+        auto Boolean     emptyList, isOK, useGridSearch ;
+        auto Integer     numberOfPoints, numberOfThreads = 1 ;
+        auto Real        maximumCutOff, maximumRadius, minimumRadius ;
+        auto Status      localStatus ;
+        auto Boolean    *QAND = NULL, *QOR = NULL ;
+        auto ThreadWork *work = NULL ;
 
         /* . Initialization. */
         localStatus = Status_OK ;
+# ifdef USEOPENMP
+        numberOfThreads = omp_get_max_threads ( ) ;
+# endif
 
         /* . Get the dimension of the problem. */
         numberOfPoints = coordinates3->extent0 ;
@@ -1126,11 +1323,11 @@ static PairList *MakeSelfPairListFromCoordinates3 ( const PairListGenerator    *
 
         /* . Set up for a grid search. */
         useGridSearch = ( grid != NULL ) && ( occupancy != NULL ) ;
-        if ( useGridSearch ) gridSearchRange = RegularGrid_MakeSearchRange ( grid, maximumCutOff, &localStatus ) ;
 
-        /* . Create the pairlist and allocate some temporary space. */
+        /* . Create the pairlist and allocate the thread workspace. */
         pairList = PairList_Allocate ( numberOfPoints, &localStatus ) ;
-        AllocateTemporarySpace ( numberOfPoints, &indices, &isIncluded, &localStatus ) ;
+        if ( useGridSearch ) work = AllocateThreadWork ( numberOfThreads, numberOfPoints, QAND, grid, NULL, maximumCutOff, &localStatus ) ;
+        else                 work = AllocateThreadWork ( numberOfThreads, numberOfPoints, QAND, NULL, NULL, maximumCutOff, &localStatus ) ;
 
         /* . Check for a memory error. */
         isOK = ( pairList != NULL ) && ( localStatus == Status_OK ) ;
@@ -1152,9 +1349,8 @@ static PairList *MakeSelfPairListFromCoordinates3 ( const PairListGenerator    *
                                                                                               QOR               ,
                                                                                               grid              ,
                                                                                               occupancy         ,
-                                                                                              gridSearchRange   ,
-                                                                                              isIncluded        ,
-                                                                                              indices           ) ;
+                                                                                              numberOfThreads   ,
+                                                                                              work              ) ;
                 else                       isOK = MakeSelfPairListFromCoordinates3PointCell ( pairList          ,
                                                                                               self->sortIndices ,
                                                                                               self->cutOff      ,
@@ -1163,11 +1359,9 @@ static PairList *MakeSelfPairListFromCoordinates3 ( const PairListGenerator    *
                                                                                               exclusions        ,
                                                                                               QAND              ,
                                                                                               QOR               ,
-                                                                                              grid              ,
                                                                                               occupancy         ,
-                                                                                              gridSearchRange   ,
-                                                                                              isIncluded        ,
-                                                                                              indices           ) ;
+                                                                                              numberOfThreads   ,
+                                                                                              work              ) ;
             }
             else                           isOK = MakeSelfPairListFromCoordinates3Direct    ( pairList          ,
                                                                                               self->cutOff      ,
@@ -1176,16 +1370,14 @@ static PairList *MakeSelfPairListFromCoordinates3 ( const PairListGenerator    *
                                                                                               exclusions        ,
                                                                                               QAND              ,
                                                                                               QOR               ,
-                                                                                              isIncluded        ,
-                                                                                              indices           ) ;
+                                                                                              numberOfThreads   ,
+                                                                                              work              ) ;
         }
 
         /* . Finish up. */
-        Memory_Deallocate ( isIncluded ) ;
-        Memory_Deallocate ( indices    ) ;
+        DeallocateThreadWork ( &work, numberOfThreads ) ;
         if ( andSelection == NULL ) Memory_Deallocate ( QAND ) ;
         if ( orSelection  == NULL ) Memory_Deallocate ( QOR  ) ;
-        RegularGridSearchRange_Deallocate ( &gridSearchRange ) ;
         if ( ! isOK ) PairList_Deallocate ( &pairList ) ;
         Status_Set ( status, localStatus ) ;
     }
@@ -1204,127 +1396,192 @@ static Boolean MakeSelfPairListFromCoordinates3CellCell ( PairList *pairList, co
                                                                               const Boolean                *QOR             ,
                                                                               const RegularGrid            *grid            ,
                                                                               const RegularGridOccupancy   *occupancy       ,
-                                                                                    RegularGridSearchRange *gridSearchRange ,
-                                                                                    Boolean                *isIncluded      ,
-                                                                                    Integer                *indices         )
+                                                                              const Integer                 numberOfThreads ,
+                                                                                    ThreadWork             *work            )
 {
-    Boolean  hasExclusions, hasRadii, includeAll, isOK = True, QORI ;
-    Integer  c1, c2, i, j, m2, n, numberOfCells, numberOfPoints, p1, p1Start, p1Total, p2, p2Start, p2Total, p2Upper, x, xFirst = 0, xLast = 0 ;
-    Real     cutOffSquared, ri = 0.0e+00, rij, xij, yij, zij ;
+    Boolean    hasExclusions, hasRadii, isOK ;
+    Integer    b, numberOfBlocks, numberOfErrors = 0, numberOfGridPoints ;
+    PairList **blocks ;
 
     /* . Initialization. */
-    cutOffSquared  = cutOff * cutOff ;
-    hasExclusions  = ( exclusions != NULL ) ;
-    hasRadii       = ( radii      != NULL ) ;
-    numberOfPoints = coordinates3->extent0  ;
-    InitializeIsIncluded ( numberOfPoints, QAND ) ;
-
-    /* . Outer loop over occupied cells in grid. */
-    for ( c1 = 0 ; c1 < RegularGrid_NumberOfGridPoints ( grid ); c1++ )
+    hasExclusions      = ( exclusions != NULL ) ;
+    hasRadii           = ( radii      != NULL ) ;
+    numberOfGridPoints = RegularGrid_NumberOfGridPoints ( grid ) ;
+    blocks             = AllocateBlockPairLists ( pairList, numberOfGridPoints, numberOfThreads, &numberOfBlocks ) ;
+
+    /* . Loop over blocks of cells in grid. */
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : numberOfErrors )
+# endif
     {
-        /* . Set some information for the cell. */
-        p1Start = Array1D_Item ( occupancy->cellFirstPoints, c1 ) ;
-        p1Total = Array1D_Item ( occupancy->cellTotalPoints, c1 ) ;
-
-        /* . Find all cells that are within the cutOff of the current cell. */
-        numberOfCells = RegularGrid_FindCellsWithinRangeOfCell ( grid, c1, gridSearchRange, NULL ) ;
-
-        /* . Outer loop over indices. */
-        for ( p1 = 0 ; p1 < p1Total ; p1++ )
+        auto Boolean                 includeAll, isBlockOK, QORI ;
+        auto Boolean                *isIncluded ;
+        auto Integer                 c1, c1Last, c2, i, j, m2, n, numberOfCells, p1, p1Start, p1Total, p2, p2Start, p2Total, p2Upper, t = 0, x, xFirst = 0, xLast = 0 ;
+        auto Integer                *indices ;
+        auto Real                    cutOffSquared, ri = 0.0e+00, rij, xij, yij, zij ;
+        auto PairList               *blockList ;
+        auto RegularGridSearchRange *gridSearchRange ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        cutOffSquared   = cutOff * cutOff ;
+        gridSearchRange = work[t].gridSearchRange ;
+        indices         = work[t].indices ;
+        isIncluded      = work[t].isIncluded ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < numberOfBlocks ; b++ )
         {
-            /* . Get the point index. */
-            i = Array1D_Item ( occupancy->cellPoints, p1+p1Start ) ;
+            blockList = ( blocks == NULL ) ? pairList : blocks[b] ;
+            c1Last    = BlockFirst ( b+1, numberOfBlocks, numberOfGridPoints ) ;
+            isBlockOK = True ;
 
-            /* . AND test. */
-            if ( QAND[i] )
+            /* . Outer loop over occupied cells in the block. */
+            for ( c1 = BlockFirst ( b, numberOfBlocks, numberOfGridPoints ) ; c1 < c1Last ; c1++ )
             {
-                /* . Get some information for the point. */
-                QORI = QOR[i] ;
-                if ( hasRadii ) ri = cutOff + Array1D_Item ( radii, i ) ;
+                /* . Set some information for the cell. */
+                p1Start = Array1D_Item ( occupancy->cellFirstPoints, c1 ) ;
+                p1Total = Array1D_Item ( occupancy->cellTotalPoints, c1 ) ;
+                if ( p1Total <= 0 ) continue ;
 
-                /* . Flag excluded points for i. */
-                if ( hasExclusions ) FlagNonSelfExclusions ;
+                /* . Find all cells that are within the cutOff of the current cell. */
+                numberOfCells = RegularGrid_FindCellsWithinRangeOfCell ( work[t].grid1, c1, gridSearchRange, NULL ) ;
 
-                /* . Loop over cells. */
-                for ( m2 = n = 0 ; m2 < numberOfCells ; m2++ )
+                /* . Outer loop over indices. */
+                for ( p1 = 0 ; p1 < p1Total ; p1++ )
                 {
-                    /* . Set some information for the cell. */
-                    GetCellInformation ( m2, occupancy, c2, includeAll, p2Start, p2Total ) ;
-
-                    /* . Skip interactions with a cell of higher index. */
-                    if ( c2 > c1 ) continue ;
-
-                    /* . Set the upper limit for interactions within the same cell. */
-                    if ( c1 == c2 ) p2Upper = p1      ;
-                    else            p2Upper = p2Total ;
-
-                    /* . Generate interactions. */
-                         if ( hasRadii   ) { for ( p2 = 0 ; p2 < p2Upper ; p2++ ) { CheckForGridNonSelfInteractionWithRadii   ( p2, p2Start ) ; } }
-                    else if ( includeAll ) { for ( p2 = 0 ; p2 < p2Upper ; p2++ ) { IncludeAllCellNonSelfInteractions         ( p2, p2Start ) ; } }
-                    else                   { for ( p2 = 0 ; p2 < p2Upper ; p2++ ) { CheckForGridNonSelfInteractionWithNoRadii ( p2, p2Start ) ; } }
+                    /* . Get the point index. */
+                    i = Array1D_Item ( occupancy->cellPoints, p1+p1Start ) ;
+
+                    /* . AND test. */
+                    if ( QAND[i] )
+                    {
+                        /* . Get some information for the point. */
+                        QORI = QOR[i] ;
+                        if ( hasRadii ) ri = cutOff + Array1D_Item ( radii, i ) ;
+
+                        /* . Flag excluded points for i. */
+                        if ( hasExclusions ) FlagNonSelfExclusions ;
+
+                        /* . Loop over cells. */
+                        for ( m2 = n = 0 ; m2 < numberOfCells ; m2++ )
+                        {
+                            /* . Set some information for the cell. */
+                            GetCellInformation ( m2, occupancy, c2, includeAll, p2Start, p2Total ) ;
+
+                            /* . Skip interactions with a cell of higher index. */
+                            if ( c2 > c1 ) continue ;
+
+                            /* . Set the upper limit for interactions within the same cell. */
+                            if ( c1 == c2 ) p2Upper = p1      ;
+                            else            p2Upper = p2Total ;
+
+                            /* . Generate interactions. */
+                                 if ( hasRadii   ) { for ( p2 = 0 ; p2 < p2Upper ; p2++ ) { CheckForGridNonSelfInteractionWithRadii   ( p2, p2Start ) ; } }
+                            else if ( includeAll ) { for ( p2 = 0 ; p2 < p2Upper ; p2++ ) { IncludeAllCellNonSelfInteractions         ( p2, p2Start ) ; } }
+                            else                   { for ( p2 = 0 ; p2 < p2Upper ; p2++ ) { CheckForGridNonSelfInteractionWithNoRadii ( p2, p2Start ) ; } }
+                        }
+
+                        /* . Save the interactions. */
+                        isBlockOK = SaveInteractions ( blockList, i, n, indices, sortIndices ) ;
+                        if ( ! isBlockOK ) break ;
+
+                        /* . Unflag excluded points for i. */
+                        if ( hasExclusions ) UnflagNonSelfExclusions ( QAND ) ;
+                    }
                 }
-
-                /* . Save the interactions. */
-                isOK = SaveInteractions ( pairList, i, n, indices, sortIndices ) ;
-                if ( ! isOK ) break ;
-
-                /* . Unflag excluded points for i. */
-                if ( hasExclusions ) UnflagNonSelfExclusions ( QAND ) ;
+                if ( ! isBlockOK ) break ;
             }
+            if ( ! isBlockOK ) numberOfErrors += 1 ;
         }
     }
-    return isOK ;
+
+    /* . Finish up. */
+    isOK = MergeBlockPairLists ( pairList, numberOfBlocks, blocks, numberOfThreads ) ;
+    return ( isOK && ( numberOfErrors == 0 ) ) ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Self-pairlist generation using a direct method.
 !---------------------------------------------------------------------------------------------------------------------------------*/
-static Boolean MakeSelfPairListFromCoordinates3Direct ( PairList *pairList, const Real             cutOff       ,
-                                                                            const Coordinates3    *coordinates3 ,
-                                                                            const RealArray1D     *radii        ,
-                                                                            const PairConnections *exclusions   ,
-                                                                            const Boolean         *QAND         ,
-                                                                            const Boolean         *QOR          ,
-                                                                                  Boolean         *isIncluded   ,
-                                                                                  Integer         *indices      )
+static Boolean MakeSelfPairListFromCoordinates3Direct ( PairList *pairList, const Real             cutOff          ,
+                                                                            const Coordinates3    *coordinates3    ,
+                                                                            const RealArray1D     *radii           ,
+                                                                            const PairConnections *exclusions      ,
+                                                                            const Boolean         *QAND            ,
+                                                                            const Boolean         *QOR             ,
+                                                                            const Integer          numberOfThreads ,
+                                                                                  ThreadWork      *work            )
 {
-    Boolean  hasExclusions, hasRadii, isOK = True, QORI ;
-    Integer  i, j, n, numberOfPoints, x, xFirst = 0, xLast = 0 ;
-    Real     cutOffSquared, ri = 0.0e+00, rij, xij, yij, zij ;
+    Boolean    hasExclusions, hasRadii, isOK ;
+    Integer    b, numberOfBlocks, numberOfErrors = 0, numberOfPoints ;
+    PairList **blocks ;
 
     /* . Initialization. */
-    cutOffSquared  = cutOff * cutOff ;
     hasExclusions  = ( exclusions != NULL ) ;
     hasRadii       = ( radii      != NULL ) ;
     numberOfPoints = coordinates3->extent0  ;
-    InitializeIsIncluded ( numberOfPoints, QAND ) ;
+    blocks         = AllocateBlockPairLists ( pairList, numberOfPoints, numberOfThreads, &numberOfBlocks ) ;
 
-    /* . Outer loop over indices. */
-    for ( i = 1 ; i < numberOfPoints ; i++ )
+    /* . Loop over blocks of indices. */
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : numberOfErrors )
+# endif
     {
-        /* . AND test. */
-        if ( QAND[i] )
+        auto Boolean   isBlockOK, QORI ;
+        auto Boolean  *isIncluded ;
+        auto Integer   i, iLast, j, n, t = 0, x, xFirst = 0, xLast = 0 ;
+        auto Integer  *indices ;
+        auto Real      cutOffSquared, ri = 0.0e+00, rij, xij, yij, zij ;
+        auto PairList *blockList ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        cutOffSquared = cutOff * cutOff ;
+        indices       = work[t].indices ;
+        isIncluded    = work[t].isIncluded ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < numberOfBlocks ; b++ )
         {
-            /* . Get some information for the point. */
-            QORI = QOR[i] ;
-            if ( hasRadii ) ri = cutOff + Array1D_Item ( radii, i ) ;
+            blockList = ( blocks == NULL ) ? pairList : blocks[b] ;
+            iLast     = BlockFirst ( b+1, numberOfBlocks, numberOfPoints ) ;
+            isBlockOK = True ;
 
-            /* . Flag excluded points for i. */
-            if ( hasExclusions ) FlagSelfExclusions ;
+            /* . Outer loop over indices. */
+            for ( i = Maximum ( BlockFirst ( b, numberOfBlocks, numberOfPoints ), 1 ) ; i < iLast ; i++ )
+            {
+                /* . AND test. */
+                if ( QAND[i] )
+                {
+                    /* . Get some information for the point. */
+                    QORI = QOR[i] ;
+                    if ( hasRadii ) ri = cutOff + Array1D_Item ( radii, i ) ;
 
-            /* . Generate interactions. */
-            if ( hasRadii ) { for ( j = n = 0 ; j < i ; j++ ) { CheckForDirectSelfInteractionWithRadii   ; } }
-            else            { for ( j = n = 0 ; j < i ; j++ ) { CheckForDirectSelfInteractionWithNoRadii ; } }
+                    /* . Flag excluded points for i. */
+                    if ( hasExclusions ) FlagSelfExclusions ;
 
-            /* . Save the interactions. */
-            isOK = SaveInteractions ( pairList, i, n, indices, False ) ;
-            if ( ! isOK ) break ;
+                    /* . Generate interactions. */
+                    if ( hasRadii ) { for ( j = n = 0 ; j < i ; j++ ) { CheckForDirectSelfInteractionWithRadii   ; } }
+                    else            { for ( j = n = 0 ; j < i ; j++ ) { CheckForDirectSelfInteractionWithNoRadii ; } }
 
-            /* . Unflag excluded points for i. */
-            if ( hasExclusions ) UnflagSelfExclusions ;
+                    /* . Save the interactions. */
+                    isBlockOK = SaveInteractions ( blockList, i, n, indices, False ) ;
+                    if ( ! isBlockOK ) break ;
+
+                    /* . Unflag excluded points for i. */
+                    if ( hasExclusions ) UnflagSelfExclusions ;
+                }
+            }
+            if ( ! isBlockOK ) numberOfErrors += 1 ;
         }
     }
-    return isOK ;
+
+    /* . Finish up. */
+    isOK = MergeBlockPairLists ( pairList, numberOfBlocks, blocks, numberOfThreads ) ;
+    return ( isOK && ( numberOfErrors == 0 ) ) ;
 }
 
 /*----------------------------------------------------------------------------------------------------------------------------------
@@ -1337,60 +1594,150 @@ static Boolean MakeSelfPairListFromCoordinates3PointCell ( PairList *pairList, c
                                                                                const PairConnections        *exclusions      ,
                                                                                const Boolean                *QAND            ,
                                                                                const Boolean                *QOR             ,
-                                                                               const RegularGrid            *grid            ,
                                                                                const RegularGridOccupancy   *occupancy       ,
-                                                                                     RegularGridSearchRange *gridSearchRange ,
-                                                                                     Boolean                *isIncluded      ,
-                                                                                     Integer                *indices         )
+                                                                               const Integer                 numberOfThreads ,
+                                                                                     ThreadWork             *work            )
 {
-    Boolean  hasExclusions, hasRadii, includeAll, isOK = True, QORI ;
-    Integer  c, i, j, m, n, numberOfCells, numberOfPoints, p, pStart, pTotal, x, xFirst = 0, xLast = 0 ;
-    Real     cutOffSquared, ri, rij, xij, yij, zij ;
+    Boolean    hasExclusions, hasRadii, isOK ;
+    Integer    b, numberOfBlocks, numberOfErrors = 0, numberOfPoints ;
+    PairList **blocks ;
 
     /* . Initialization. */
-    cutOffSquared  = cutOff * cutOff ;
     hasExclusions  = ( exclusions != NULL ) ;
     hasRadii       = ( radii      != NULL ) ;
     numberOfPoints = coordinates3->extent0  ;
-    InitializeIsIncluded ( numberOfPoints, QAND ) ;
+    blocks         = AllocateBlockPairLists ( pairList, numberOfPoints, numberOfThreads, &numberOfBlocks ) ;
 
-    /* . Outer loop over indices. */
-    for ( i = 1 ; i < numberOfPoints ; i++ )
+    /* . Loop over blocks of indices. */
+# ifdef USEOPENMP
+    #pragma omp parallel num_threads ( numberOfThreads ) reduction ( + : numberOfErrors )
+# endif
     {
-        /* . AND test. */
-        if ( QAND[i] )
+        auto Boolean                 includeAll, isBlockOK, QORI ;
+        auto Boolean                *isIncluded ;
+        auto Integer                 c, i, iLast, j, m, n, numberOfCells, p, pStart, pTotal, t = 0, x, xFirst = 0, xLast = 0 ;
+        auto Integer                *indices ;
+        auto Real                    cutOffSquared, ri = 0.0e+00, rij, xij, yij, zij ;
+        auto PairList               *blockList ;
+        auto RegularGridSearchRange *gridSearchRange ;
+# ifdef USEOPENMP
+        t = omp_get_thread_num ( ) ;
+# endif
+        cutOffSquared   = cutOff * cutOff ;
+        gridSearchRange = work[t].gridSearchRange ;
+        indices         = work[t].indices ;
+        isIncluded      = work[t].isIncluded ;
+# ifdef USEOPENMP
+        #pragma omp for schedule ( dynamic )
+# endif
+        for ( b = 0 ; b < numberOfBlocks ; b++ )
         {
-            /* . Get some information for the point. */
-            QORI = QOR[i] ;
-            if ( hasRadii ) ri = cutOff + Array1D_Item ( radii, i ) ;
+            blockList = ( blocks == NULL ) ? pairList : blocks[b] ;
+            iLast     = BlockFirst ( b+1, numberOfBlocks, numberOfPoints ) ;
+            isBlockOK = True ;
 
-            /* . Flag excluded points for i. */
-            if ( hasExclusions ) FlagSelfExclusions ;
+            /* . Outer loop over indices. */
+            for ( i = Maximum ( BlockFirst ( b, numberOfBlocks, numberOfPoints ), 1 ) ; i < iLast ; i++ )
+            {
+                /* . AND test. */
+                if ( QAND[i] )
+                {
+                    /* . Get some information for the point. */
+                    QORI = QOR[i] ;
+                    if ( hasRadii ) ri = cutOff + Array1D_Item ( radii, i ) ;
+
+                    /* . Flag excluded points for i. */
+                    if ( hasExclusions ) FlagSelfExclusions ;
+
+                    /* . Find all cells that are within the cutOff of the cell of the current point. */
+                    numberOfCells = RegularGrid_FindCellsWithinRangeOfPoint ( work[t].grid1, Array1D_Item ( occupancy->pointCells, i ) ,
+                                                                                             Coordinates3_RowPointer ( coordinates3, i ) ,
+                                                                                                                 gridSearchRange, NULL ) ;
+
+                    /* . Loop over cells. */
+                    for ( m = n = 0 ; m < numberOfCells ; m++ )
+                    {
+                        /* . Set some information for the cell. */
+                        GetCellInformation ( m, occupancy, c, includeAll, pStart, pTotal ) ;
+
+                        /* . Generate interactions. */
+                             if ( hasRadii   ) { for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridSelfInteractionWithRadii   ( p, pStart ) ; } }
+                        else if ( includeAll ) { for ( p = 0 ; p < pTotal ; p++ ) { IncludeAllCellSelfInteractions         ( p, pStart ) ; } }
+                        else                   { for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridSelfInteractionWithNoRadii ( p, pStart ) ; } }
+                    }
+
+                    /* . Save the interactions. */
+                    isBlockOK = SaveInteractions ( blockList, i, n, indices, sortIndices ) ;
+                    if ( ! isBlockOK ) break ;
+
+                    /* . Unflag excluded points for i. */
+                    if ( hasExclusions ) UnflagSelfExclusions ;
+                }
+            }
+            if ( ! isBlockOK ) numberOfErrors += 1 ;
+        }
+    }
 
-            /* . Find all cells that are within the cutOff of the cell of the current point. */
-            numberOfCells = RegularGrid_FindCellsWithinRangeOfPoint ( grid, Array1D_Item ( occupancy->pointCells, i ) ,
-                                                                                 Coordinates3_RowPointer ( coordinates3, i ) ,
-                                                                                                     gridSearchRange, NULL ) ;
+    /* . Finish up. */
+    isOK = MergeBlockPairLists ( pairList, numberOfBlocks, blocks, numberOfThreads ) ;
+    return ( isOK && ( numberOfErrors == 0 ) ) ;
+}
 
-            /* . Loop over cells. */
-            for ( m = n = 0 ; m < numberOfCells ; m++ )
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Merge the block pairlists into the final pairlist.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+/* . The starting record and pair of each block are found by prefix sums after which the blocks are copied independently. */
+static Boolean MergeBlockPairLists (       PairList  *pairList        ,
+                                     const Integer    numberOfBlocks  ,
+                                           PairList **blocks          ,
+                                     const Integer    numberOfThreads )
+{
+    Boolean isOK = True ;
+    if ( blocks != NULL )
+    {
+        auto Integer  b, numberOfPairs, numberOfRecords, *starts ;
+        starts = Integer_Allocate ( 2 * ( numberOfBlocks + 1 ), NULL ) ;
+        isOK   = ( starts != NULL ) ;
+        if ( isOK )
+        {
+            /* . Prefix sums. */
+            for ( b = numberOfPairs = numberOfRecords = 0 ; b < numberOfBlocks ; b++ )
             {
-                /* . Set some information for the cell. */
-                GetCellInformation ( m, occupancy, c, includeAll, pStart, pTotal ) ;
-
-                /* . Generate interactions. */
-                     if ( hasRadii   ) { for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridSelfInteractionWithRadii   ( p, pStart ) ; } }
-                else if ( includeAll ) { for ( p = 0 ; p < pTotal ; p++ ) { IncludeAllCellSelfInteractions         ( p, pStart ) ; } }
-                else                   { for ( p = 0 ; p < pTotal ; p++ ) { CheckForGridSelfInteractionWithNoRadii ( p, pStart ) ; } }
+                starts[2*b  ]    = numberOfRecords ;
+                starts[2*b+1]    = numberOfPairs   ;
+                numberOfRecords += blocks[b]->count         ;
+                numberOfPairs   += blocks[b]->numberOfPairs ;
             }
 
-            /* . Save the interactions. */
-            isOK = SaveInteractions ( pairList, i, n, indices, sortIndices ) ;
-            if ( ! isOK ) break ;
+            /* . Make sure there is enough space. */
+            if ( numberOfRecords > pairList->capacity        ) isOK = PairList_Reallocate         ( pairList, numberOfRecords, NULL ) ;
+            if ( numberOfPairs   > pairList->partnerCapacity ) isOK = isOK && PairList_ReallocatePartners ( pairList, numberOfPairs, NULL ) ;
 
-            /* . Unflag excluded points for i. */
-            if ( hasExclusions ) UnflagSelfExclusions ;
+            /* . Copy the blocks. */
+            if ( isOK )
+            {
+# ifdef USEOPENMP
+                #pragma omp parallel for num_threads ( numberOfThreads ) schedule ( dynamic )
+# endif
+                for ( b = 0 ; b < numberOfBlocks ; b++ )
+                {
+                    auto Integer   p0, r, r0 ;
+                    auto PairList *block = blocks[b] ;
+                    r0 = starts[2*b  ] ;
+                    p0 = starts[2*b+1] ;
+                    Integer_CopyTo ( block->indices , block->count        , &(pairList->indices [r0]), NULL ) ;
+                    Integer_CopyTo ( block->partners, block->numberOfPairs, &(pairList->partners[p0]), NULL ) ;
+                    for ( r = 0 ; r < block->count ; r++ ) pairList->offsets[r0+r+1] = p0 + block->offsets[r+1] ;
+                }
+                pairList->count         = numberOfRecords ;
+                pairList->numberOfPairs = numberOfPairs   ;
+            }
         }
+
+        /* . Finish up. */
+        for ( b = 0 ; b < numberOfBlocks ; b++ ) PairList_Deallocate ( &(blocks[b]) ) ;
+        Memory_Deallocate ( blocks ) ;
+        Memory_Deallocate ( starts ) ;
     }
     return isOK ;
 }
@@ -1403,12 +1750,10 @@ static Boolean SaveInteractions ( PairList *pairList, const Integer  i, const In
     Boolean isOK = True ;
     if ( n > 0 )
     {
-        auto PairRecord *record ;
-        auto Status      localStatus = Status_OK ;
-        record = PairRecord_FromIndices ( i, n, indices, &localStatus ) ;
-        if ( sortIndices ) PairRecord_Sort ( record ) ;
-        PairList_Append ( pairList, record, &localStatus ) ;
+        auto Status localStatus = Status_OK ;
+        PairList_Append ( pairList, i, n, indices, &localStatus ) ;
         isOK = ( localStatus == Status_OK ) ;
+        if ( isOK && sortIndices ) Integer_Sort ( PairList_RecordPartners ( pairList, pairList->count - 1 ), n ) ;
     }
     return isOK ;
 }
@@ -5,10 +5,20 @@
 # include <stdio.h>
 
 # include "Memory.h"
+# include "NumericalMacros.h"
 # include "RegularGridOccupancy.h"
 
+# ifdef USEOPENMP
+# include <omp.h>
+# endif
+
 /*# define DEBUGPRINTING*/
 
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Local declarations.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void FillCellPoints ( RegularGridOccupancy *self ) ;
+
 /*----------------------------------------------------------------------------------------------------------------------------------
 ! . Allocation.
 !---------------------------------------------------------------------------------------------------------------------------------*/
@@ -85,41 +95,58 @@ printf ( "Number Of Points     = %6d (%6d)\n", self->numberOfPoints , View2D_Row
              ( self->numberOfPoints == View2D_Rows                    ( points ) ) &&
              ( grid->ndimensions    == View2D_Columns                 ( points ) ) )
         {
-            auto Integer c, n, p ;
+            auto Integer       c, numberOfThreads = 1, p ;
+            auto RegularGrid **grids = NULL ;
 
-            /* . Determine the cell position of each point and the total number of points in each cell. */
-            for ( p = totalOffGrid = 0 ; p < self->numberOfPoints ; p++ )
+            /* . Determine the cell position of each point. */
+            /* . Threads have their own grid clones as the cell search uses the grid's work arrays. */
+# ifdef USEOPENMP
+            numberOfThreads = omp_get_max_threads ( ) ;
+            if ( numberOfThreads > 1 )
             {
-                c = RegularGrid_FindCellIDOfPoint ( grid, Array2D_RowPointer ( points, p ) ) ;
-                if ( c >= 0 )
+                grids = Memory_AllocateArrayOfReferences ( numberOfThreads, RegularGrid ) ;
+                if ( grids != NULL )
                 {
-                    Array1D_Item ( self->cellTotalPoints , c ) += 1 ;
-                    Array1D_Item ( self->pointCells      , p )  = c ;
+                    auto Integer t ;
+                    auto Status  localStatus = Status_OK ;
+                    for ( t = 0 ; t < numberOfThreads ; t++ ) grids[t] = RegularGrid_Clone ( grid, &localStatus ) ;
+                    if ( localStatus != Status_OK )
+                    {
+                        for ( t = 0 ; t < numberOfThreads ; t++ ) RegularGrid_Deallocate ( &(grids[t]) ) ;
+                        Memory_Deallocate ( grids ) ;
+                    }
                 }
-                else totalOffGrid++ ;
             }
-
-            /* . Determine the index of the first point for each cell. */
-            for ( c = n = 0 ; c < self->numberOfCells ; c++ )
+            if ( grids == NULL ) numberOfThreads = 1 ;
+            #pragma omp parallel for num_threads ( numberOfThreads ) schedule ( static )
+# endif
+            for ( p = 0 ; p < self->numberOfPoints ; p++ )
+            {
+                auto       Integer      cP ;
+                auto const RegularGrid *pGrid = grid ;
+# ifdef USEOPENMP
+                if ( grids != NULL ) pGrid = grids[omp_get_thread_num ( )] ;
+# endif
+                cP = RegularGrid_FindCellIDOfPoint ( pGrid, Array2D_RowPointer ( points, p ) ) ;
+                Array1D_Item ( self->pointCells, p ) = Maximum ( cP, -1 ) ;
+            }
+            if ( grids != NULL )
             {
-                Array1D_Item ( self->cellFirstPoints, c ) = n ;
-                n += Array1D_Item ( self->cellTotalPoints, c ) ;
+                auto Integer t ;
+                for ( t = 0 ; t < numberOfThreads ; t++ ) RegularGrid_Deallocate ( &(grids[t]) ) ;
+                Memory_Deallocate ( grids ) ;
             }
 
-            /* . Fill the cell points index array. */
-            for ( p = 0 ; p < self->numberOfPoints ; p++ )
+            /* . Determine the total number of points in each cell. */
+            for ( p = totalOffGrid = 0 ; p < self->numberOfPoints ; p++ )
             {
-                c = Array1D_Item ( self->pointCells , p ) ;
-                if ( c >= 0 )
-                {
-                    n = Array1D_Item ( self->cellFirstPoints , c ) ;
-                    Array1D_Item ( self->cellPoints          , n )  = p ;
-                    Array1D_Item ( self->cellFirstPoints     , c ) += 1 ;
-                }
+                c = Array1D_Item ( self->pointCells, p ) ;
+                if ( c >= 0 ) Array1D_Item ( self->cellTotalPoints, c ) += 1 ;
+                else          totalOffGrid++ ;
             }
 
-            /* . Reset cellFirstPoints. */
-            IntegerArray1D_Add ( self->cellFirstPoints, -1, self->cellTotalPoints, NULL ) ;
+            /* . Fill the cell arrays. */
+            FillCellPoints ( self ) ;
 # ifdef DEBUGPRINTING
 printf ( "\nRegular Grid Occupancy Fill Stop:\n" ) ;
 printf ( "Number Of Cells      = %6d\n", self->numberOfCells  ) ;
@@ -169,3 +196,80 @@ void RegularGridOccupancy_Initialize ( RegularGridOccupancy *self )
         IntegerArray1D_Set ( self->pointCells      , -1 ) ;
     }
 }
+
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Update the cells of a subset of points whose coordinates have changed.
+! . Only the cell totals of the points that have changed cell are modified. The cell points array is refilled if there are any
+!   such points, which is cheaper than a full fill as no cell searches are needed for the remaining points.
+! . Points that are no longer on the grid are ignored.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+Integer RegularGridOccupancy_UpdatePoints (       RegularGridOccupancy *self            ,
+                                            const RegularGrid          *grid            ,
+                                            const RealArray2D          *points          ,
+                                            const Integer               numberOfIndices ,
+                                            const Integer              *indices         ,
+                                                  Status               *status          )
+{
+    Integer totalOffGrid = -1 ;
+    if ( ( self != NULL ) && ( grid != NULL ) && ( points != NULL ) && ( ( numberOfIndices <= 0 ) || ( indices != NULL ) ) )
+    {
+        if ( ( self->numberOfCells  == RegularGrid_NumberOfGridPoints ( grid   ) ) &&
+             ( self->numberOfPoints == View2D_Rows                    ( points ) ) &&
+             ( grid->ndimensions    == View2D_Columns                 ( points ) ) )
+        {
+            auto Boolean hasChanged = False ;
+            auto Integer c, cOld, p, q ;
+            for ( q = totalOffGrid = 0 ; q < numberOfIndices ; q++ )
+            {
+                p    = indices[q] ;
+                c    = Maximum ( RegularGrid_FindCellIDOfPoint ( grid, Array2D_RowPointer ( points, p ) ), -1 ) ;
+                cOld = Array1D_Item ( self->pointCells, p ) ;
+                if ( c < 0 ) totalOffGrid++ ;
+                if ( c != cOld )
+                {
+                    if ( cOld >= 0 ) Array1D_Item ( self->cellTotalPoints, cOld ) -= 1 ;
+                    if ( c    >= 0 ) Array1D_Item ( self->cellTotalPoints, c    ) += 1 ;
+                    Array1D_Item ( self->pointCells, p ) = c ;
+                    hasChanged = True ;
+                }
+            }
+            if ( hasChanged ) FillCellPoints ( self ) ;
+        }
+        else Status_Set ( status, Status_InvalidArgument ) ;
+    }
+    return totalOffGrid ;
+}
+
+/*==================================================================================================================================
+! . Local procedures.
+!=================================================================================================================================*/
+/*----------------------------------------------------------------------------------------------------------------------------------
+! . Fill the cell first points and cell points arrays given the point cells and cell totals.
+! . The points of each cell are in increasing order.
+!---------------------------------------------------------------------------------------------------------------------------------*/
+static void FillCellPoints ( RegularGridOccupancy *self )
+{
+    auto Integer c, n, p ;
+
+    /* . Determine the index of the first point for each cell. */
+    for ( c = n = 0 ; c < self->numberOfCells ; c++ )
+    {
+        Array1D_Item ( self->cellFirstPoints, c ) = n ;
+        n += Array1D_Item ( self->cellTotalPoints, c ) ;
+    }
+
+    /* . Fill the cell points index array. */
+    for ( p = 0 ; p < self->numberOfPoints ; p++ )
+    {
+        c = Array1D_Item ( self->pointCells , p ) ;
+        if ( c >= 0 )
+        {
+            n = Array1D_Item ( self->cellFirstPoints , c ) ;
+            Array1D_Item ( self->cellPoints          , n )  = p ;
+            Array1D_Item ( self->cellFirstPoints     , c ) += 1 ;
+        }
+    }
+
+    /* . Reset cellFirstPoints. */
+    IntegerArray1D_Add ( self->cellFirstPoints, -1, self->cellTotalPoints, NULL ) ;
+}
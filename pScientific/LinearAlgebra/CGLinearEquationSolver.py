@@ -2,9 +2,16 @@
 
 # . Basic no-frills implementation.
 
-from pCore              import AttributableObject , \
-                               SummarizableObject
-from pScientific.Arrays import Array
+from  pCore              import AttributableObject , \
+                                SummarizableObject
+from  pScientific.Arrays import Array
+from .DenseLinearAlgebra import LinearEquations
+
+#===================================================================================================================================
+# . Parameters.
+#===================================================================================================================================
+# . The relative norm below which a block search direction is taken to be linearly dependent on the others.
+_BlockDependenceTolerance = 1.0e-10
 
 #==================================================================================================================================
 # . Solver state.
@@ -35,6 +42,40 @@ class CGLinearEquationSolverState ( AttributableObject ):
         self.r                 = Array.WithExtent ( n ) 
         return self
 
+class CGLinearEquationSolverBlockState ( AttributableObject ):
+    """State for the simultaneous solution of several linear equations with the same matrix.
+
+    The right-hand sides and solutions are stored as the rows of two-dimensional arrays. The leading rows of p and q
+    hold the block of search directions and the matrix applied to them.
+    """
+
+    _attributable = dict ( AttributableObject._attributable )
+    _attributable.update ( { "b"                 : None  ,
+                             "doPreconditioning" : False ,
+                             "h"                 : None  ,
+                             "p"                 : None  ,
+                             "q"                 : None  ,
+                             "r"                 : None  ,
+                             "x"                 : None  ,
+                             "target"            : None  } )
+
+    @classmethod
+    def FromTarget ( selfClass, target, rhs, solution, doPreconditioning = False ):
+        """Constructor from target."""
+        self                   = selfClass ( )
+        self.doPreconditioning = doPreconditioning
+        self.target            = target
+        # . Aliases.
+        self.b                 = rhs
+        self.x                 = solution
+        # . Allocate space.
+        ( m, n )               = self.b.shape
+        self.h                 = Array.WithExtents ( m, n )
+        self.p                 = Array.WithExtents ( m, n )
+        self.q                 = Array.WithExtents ( m, n )
+        self.r                 = Array.WithExtents ( m, n )
+        return self
+
 #==================================================================================================================================
 # . Solver.
 #=================================================================================================================================*/
@@ -129,6 +170,130 @@ class CGLinearEquationSolver ( SummarizableObject ):
                    "RHS Norm2"        : bNorm2      }
         return report
 
+    def SolveBlock ( self, state ):
+        """Block solver for several systems with the same SPD matrix given a block state.
+
+        The search directions of all the systems form a single block so that each solution is improved with the
+        directions that come from the other right-hand sides as well as with its own. The block is orthonormalized
+        at each iteration and directions that are linearly dependent on the others, or that come from systems which
+        have already converged, are dropped as this avoids the breakdown of the unmodified block method. The matrix
+        is applied to the whole block at once with the target's ApplyMatrices method and the iteration stops when
+        all the systems have converged.
+        """
+        # . Initialization.
+        doPreconditioning = state.doPreconditioning
+        target            = state.target
+        b                 = state.b
+        h                 = state.h
+        p                 = state.p
+        q                 = state.q
+        r                 = state.r
+        x                 = state.x
+        m                 = b.shape[0]
+        # . RHS norm2s and the denominators for convergence checks.
+        bNorm2s      = [ b[i,:].Norm2 ( ) for i in range ( m ) ]
+        denominators = [ 1.0 for i in range ( m ) ]
+        if   self.convergenceMode == 2: denominators = list ( bNorm2s )
+        elif self.convergenceMode == 4:
+            for i in range ( m ):
+                if doPreconditioning:
+                    target.ApplyPreconditioner ( b[i,:], h[i,:] )
+                    denominators[i] = h[i,:].Norm2 ( )
+                else:
+                    denominators[i] = bNorm2s[i]
+        # . Compute the initial residuals r = b - A*x.
+        target.ApplyMatrices ( x, r )
+        for i in range ( m ):
+            r[i,:].Add   ( b[i,:], scale = -1.0 )
+            r[i,:].Scale ( -1.0 )
+        ( converged, rNorm2s ) = self._BlockResiduals ( state, denominators )
+        r0Norm2s = list ( rNorm2s )
+        # . Iterate.
+        iterations = 0
+        products   = m
+        s          = self._BlockDirections ( state, converged )
+        while ( s > 0 ) and ( iterations < self.maximumIterations ):
+            iterations += 1
+            # . Apply the matrix to the directions.
+            target.ApplyMatrices ( p[0:s,:], q[0:s,:] )
+            products += s
+            pAp = Array.WithExtents ( s, s )
+            for k in range ( s ):
+                for l in range ( k + 1 ):
+                    pAp[k,l] = pAp[l,k] = p[k,:].Dot ( q[l,:] )
+            # . New x and r with alpha = ( P^T A P )^-1 P^T r.
+            for i in range ( m ):
+                alpha = self._BlockSolve ( pAp, [ p[k,:].Dot ( r[i,:] ) for k in range ( s ) ] )
+                for k in range ( s ):
+                    x[i,:].Add ( p[k,:], scale =  alpha[k] )
+                    r[i,:].Add ( q[k,:], scale = -alpha[k] )
+            # . New h and check for termination.
+            ( converged, rNorm2s ) = self._BlockResiduals ( state, denominators )
+            if all ( converged ): break
+            # . New directions h + P beta with beta = - ( P^T A P )^-1 ( A P )^T h.
+            for i in range ( m ):
+                if not converged[i]:
+                    beta = self._BlockSolve ( pAp, [ - q[k,:].Dot ( h[i,:] ) for k in range ( s ) ] )
+                    for k in range ( s ): h[i,:].Add ( p[k,:], scale = beta[k] )
+            s = self._BlockDirections ( state, converged )
+        # . Finish up.
+        report = { "Final Residual"   : max ( rNorm2s  , default = 0.0 ) ,
+                   "Initial Residual" : max ( r0Norm2s , default = 0.0 ) ,
+                   "Is Converged"     : all ( converged )                ,
+                   "Iterations"       : iterations                       ,
+                   "Matrix Products"  : products                         ,
+                   "RHS Norm2"        : max ( bNorm2s  , default = 0.0 ) }
+        return report
+
+    def _BlockDirections ( self, state, converged ):
+        """Orthonormalize the rows of h of the unconverged systems into the leading rows of p.
+
+        Rows that are linearly dependent on those already accepted are dropped. The number of directions is returned.
+        """
+        h = state.h
+        p = state.p
+        s = 0
+        for ( i, isConverged ) in enumerate ( converged ):
+            if not isConverged:
+                d = p[s,:]
+                h[i,:].CopyTo ( d )
+                dNorm2 = d.Norm2 ( )
+                # . Two passes of Gram-Schmidt.
+                for g in range ( 2 ):
+                    for k in range ( s ): d.Add ( p[k,:], scale = - p[k,:].Dot ( d ) )
+                norm2 = d.Norm2 ( )
+                if ( dNorm2 > 0.0 ) and ( norm2 > _BlockDependenceTolerance * dNorm2 ):
+                    d.Scale ( 1.0 / norm2 )
+                    s += 1
+        return s
+
+    def _BlockResiduals ( self, state, denominators ):
+        """Find the residual norm2s and the preconditioned residuals h of all the systems and check for convergence."""
+        h         = state.h
+        r         = state.r
+        converged = []
+        rNorm2s   = []
+        for i in range ( r.shape[0] ):
+            ( hI, rI ) = ( h[i,:], r[i,:] )
+            rNorm2     = rI.Norm2 ( )
+            if state.doPreconditioning:
+                state.target.ApplyPreconditioner ( rI, hI )
+                hNorm2 = hI.Norm2 ( )
+            else:
+                rI.CopyTo ( hI )
+                hNorm2 = rNorm2
+            converged.append ( self.IsConverged ( rNorm2, hNorm2, denominators[i] ) )
+            rNorm2s.append   ( rNorm2 )
+        return ( converged, rNorm2s )
+
+    def _BlockSolve ( self, a, values ):
+        """Solve the small dense equations a * x = values."""
+        rhs      = Array.WithExtent ( len ( values ) )
+        solution = Array.WithExtent ( len ( values ) )
+        for ( i, v ) in enumerate ( values ): rhs[i] = v
+        LinearEquations ( a, rhs, preserveInput = True, solution = solution )
+        return [ solution[i] for i in range ( len ( values ) ) ]
+
 #===================================================================================================================================
 # . Testing.
 #===================================================================================================================================
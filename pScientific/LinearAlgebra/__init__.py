@@ -1,6 +1,7 @@
 """A sub-package for dense and sparse linear algebra."""
 
 from .CGLinearEquationSolver        import CGLinearEquationSolver             , \
+                                           CGLinearEquationSolverBlockState   , \
                                            CGLinearEquationSolverState
 from .DenseLinearAlgebra            import Determinant                        , \
                                            EigenPairs                         , \
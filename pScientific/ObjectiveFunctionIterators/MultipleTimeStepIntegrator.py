@@ -0,0 +1,113 @@
+"""Define classes for multiple-time-step (r-RESPA) velocity Verlet dynamics."""
+
+import math
+
+from  .ObjectiveFunctionIteratorError import ObjectiveFunctionIteratorError
+from  .VelocityVerletIntegrator       import VelocityVerletIntegrator      , \
+                                             VelocityVerletIntegratorState
+from ..Arrays                         import Array
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+class MultipleTimeStepIntegratorState ( VelocityVerletIntegratorState ):
+    """State for the multiple-time-step integrator."""
+
+    _attributable = dict ( VelocityVerletIntegratorState._attributable )
+    _attributable.update ( { "aFast" : None ,
+                             "aSlow" : None } )
+
+    def SetUp ( self ):
+        """Set up the state."""
+        super ( MultipleTimeStepIntegratorState, self ).SetUp ( )
+        n = self.numberOfVariables
+        if self.aFast is None: self.aFast = Array.WithExtent ( n ) ; self.aFast.Set ( 0.0 )
+        if self.aSlow is None: self.aSlow = Array.WithExtent ( n ) ; self.aSlow.Set ( 0.0 )
+
+#===================================================================================================================================
+# . Class.
+#===================================================================================================================================
+class MultipleTimeStepIntegrator ( VelocityVerletIntegrator ):
+    """Class for multiple-time-step velocity Verlet dynamics using the r-RESPA scheme of Tuckerman, Berne and Martyna, JCP 97 p1990 (1992).
+
+    The objective function must be able to evaluate the fast part of its accelerations. The fast accelerations are
+    evaluated on each of the inner steps whereas the slow accelerations, which are the difference between the full
+    and fast accelerations, are evaluated once per time step. The time step is that of the slow accelerations.
+    """
+
+    _attributable = dict ( VelocityVerletIntegrator._attributable )
+    _classLabel   = "Multiple Time Step Integrator"
+    _stateObject  = MultipleTimeStepIntegratorState
+    _summarizable = dict ( VelocityVerletIntegrator._summarizable )
+    _attributable.update ( { "facInnerV"          : 0.0            ,
+                             "facInnerX"          : 0.0            ,
+                             "numberOfInnerSteps" : 2              } )
+    _summarizable.update ( { "numberOfInnerSteps" : "Inner Steps"  } )
+
+    def _CheckOptions ( self ):
+        """Check the attributes."""
+        super ( MultipleTimeStepIntegrator, self )._CheckOptions ( )
+        if self.numberOfInnerSteps < 1: raise ObjectiveFunctionIteratorError ( "Invalid number of inner steps." )
+
+    def CalculateIntegrationConstants ( self, state ):
+        """Calculate constants for the integration."""
+        innerTimeStep  = self.timeStep / float ( self.numberOfInnerSteps )
+        self.facInnerV = 0.5 * innerTimeStep
+        self.facInnerX =       innerTimeStep
+        self.facV      = 0.5 * self.timeStep
+
+    def Initialize ( self, state ):
+        """Initialization before iteration."""
+        if not hasattr ( state.objectiveFunction, "FastAccelerations" ): raise ObjectiveFunctionIteratorError ( "Objective function has no fast accelerations evaluator." )
+        # . Calculate integration constants.
+        self.CalculateIntegrationConstants ( state )
+        # . Get velocities.
+        state.v = state.objectiveFunction.VelocitiesAllocate ( )
+        # . First function evaluations.
+        state.objectiveFunction.VariablesGet ( state.x )
+        self.SlowAccelerations ( state )
+        # . Initialize the data at zero time.
+        state.time = 0.0
+        ( state.kineticEnergy, state.temperature  ) = state.objectiveFunction.Temperature ( state.v )
+        state.totalEnergy = state.f + state.kineticEnergy
+
+    def Iteration ( self, state ):
+        """Perform one dynamics step."""
+        state.numberOfIterations += 1
+        state.time               += self.timeStep
+        # . Slow half-kick.
+        state.v.Add ( state.aSlow, scale = self.facV )
+        # . Inner velocity Verlet steps with the fast accelerations only.
+        for i in range ( self.numberOfInnerSteps ):
+            state.v.Add ( state.aFast, scale = self.facInnerV )
+            state.x.Add ( state.v    , scale = self.facInnerX )
+            state.objectiveFunction.FastAccelerations ( state.x, state.aFast )
+            state.v.Add ( state.aFast, scale = self.facInnerV )
+        # . Slow accelerations at the new point and the second slow half-kick.
+        self.SlowAccelerations ( state, fastIsCurrent = True )
+        state.v.Add ( state.aSlow, scale = self.facV )
+        # . Calculate other quantities and perform temperature scaling if necessary.
+        ( state.kineticEnergy, state.temperature ) = state.objectiveFunction.Temperature ( state.v )
+        if ( self.temperatureScaleOption is not None ) and ( state.numberOfIterations % self.temperatureScaleFrequency == 0 ):
+            scale = self.TargetTemperature ( state.time ) / state.temperature
+            state.v.Scale ( math.sqrt ( scale ) )
+            state.kineticEnergy *= scale
+            state.temperature   *= scale
+        # . Finish up.
+        state.totalEnergy = state.f + state.kineticEnergy
+
+    def SlowAccelerations ( self, state, fastIsCurrent = False ):
+        """Calculate the full and slow accelerations at the current point.
+
+        The full evaluation is done last so that the function and any quantities stored by the objective function are complete.
+        """
+        if not fastIsCurrent: state.objectiveFunction.FastAccelerations ( state.x, state.aFast )
+        state.f = state.objectiveFunction.Accelerations ( state.x, state.a )
+        state.a.CopyTo ( state.aSlow )
+        state.aSlow.Add ( state.aFast, scale = -1.0 )
+
+#===================================================================================================================================
+# . Testing.
+#===================================================================================================================================
+if __name__ == "__main__" :
+    pass
@@ -13,6 +13,7 @@ from .MoreThuenteLineSearch            import MoreThuenteLineSearcher         ,
                                               MoreThuenteLineSearcherState
 from .MultiDimensionalMinimizer        import MultiDimensionalMinimizer       , \
                                               MultiDimensionalMinimizerState
+from .MultipleTimeStepIntegrator       import MultipleTimeStepIntegrator
 from .ObjectiveFunction                import ObjectiveFunction               , \
                                               UniDimensionalObjectiveFunction
 from .ObjectiveFunctionIterator        import ObjectiveFunctionIterator       , \
@@ -4,6 +4,7 @@ from pCore                                  import logFile
 from pMolecule                              import SystemGeometryObjectiveFunction
 from pScientific.ObjectiveFunctionIterators import LangevinVelocityVerletIntegrator , \
                                                    LeapFrogIntegrator               , \
+                                                   MultipleTimeStepIntegrator       , \
                                                    VelocityVerletIntegrator
 from pScientific.Symmetry                   import CrystalSystemCubic
 
@@ -67,6 +68,19 @@ def LeapFrogDynamics_SystemGeometry ( system, **options ):
     optimizer.Summary ( log = log )
     return optimizer.Iterate ( of, log = log )
 
+#===================================================================================================================================
+# . Molecular dynamics using the multiple-time-step velocity Verlet algorithm.
+#===================================================================================================================================
+# . Keyword arguments are those from MultipleTimeStepIntegrator._attributable along with "log", "normalDeviateGenerator", "removeRotationTranslation" and "trajectories".
+# . The time step is that of the slow energy terms and is divided by numberOfInnerSteps for the fast terms.
+def MultipleTimeStepDynamics_SystemGeometry ( system, **options ):
+    """Molecular dynamics using the multiple-time-step (r-RESPA) velocity Verlet algorithm."""
+    ( of, options, log ) = _SetUpSimulation ( system, MultipleTimeStepIntegrator._attributable, {}, options )
+    of.VelocitiesAssign ( options["temperatureStart"], normalDeviateGenerator = options.pop ( "normalDeviateGenerator", None ) )
+    optimizer = MultipleTimeStepIntegrator.WithOptions ( **options )
+    optimizer.Summary ( log = log )
+    return optimizer.Iterate ( of, log = log )
+
 #===================================================================================================================================
 # . Molecular dynamics using the velocity Verlet algorithm.
 #===================================================================================================================================
@@ -41,6 +41,7 @@ from .MonteCarloSystemGeometry       import MonteCarlo_IsolateInteractionEnergy
                                             MonteCarlo_SystemGeometry
 from .MolecularDynamics              import LangevinDynamics_SystemGeometry              , \
                                             LeapFrogDynamics_SystemGeometry              , \
+                                            MultipleTimeStepDynamics_SystemGeometry      , \
                                             VelocityVerletDynamics_SystemGeometry
 from .NormalModes                    import ModifyOption                                 , \
                                             NormalModes_InfraredIntensities              , \